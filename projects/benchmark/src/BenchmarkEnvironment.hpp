@@ -0,0 +1,25 @@
+#pragma once
+
+namespace nex
+{
+	class Window;
+
+	/**
+	 * Shared state of the engine benchmarks. It is set up once by the benchmark main function: 
+	 * The headless window system is initialized and the shader sources are resolvable, so benchmarks 
+	 * can create resource loaders and render resources of the null backend.
+	 */
+	class BenchmarkEnvironment
+	{
+	public:
+		/**
+		 * Provides a (hidden) headless window, that can be shared with resource loader workers.
+		 */
+		static Window* getWindow();
+
+		static void setWindow(Window* window);
+
+	private:
+		static Window* mWindow;
+	};
+}
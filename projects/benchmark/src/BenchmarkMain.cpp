@@ -0,0 +1,68 @@
+#include <BenchmarkEnvironment.hpp>
+#include <nex/common/Log.hpp>
+#include <nex/platform/headless/SubSystemProviderHeadless.hpp>
+#include <nex/resource/FileSystem.hpp>
+#include <nex/shader_generator/ShaderSourceFileGenerator.hpp>
+#include <nex/texture/Image.hpp>
+#include <nex/texture/TextureManager.hpp>
+#include <nex/renderer/RenderBackend.hpp>
+#include <benchmark/benchmark.h>
+#include <iostream>
+
+/**
+ * Runs the engine micro benchmarks headless with the null render backend.
+ * Usage: EngineBenchmark [google benchmark options], e.g. --benchmark_filter=ResourceLoader
+ */
+
+nex::Window* nex::BenchmarkEnvironment::mWindow = nullptr;
+
+nex::Window* nex::BenchmarkEnvironment::getWindow()
+{
+	return mWindow;
+}
+
+void nex::BenchmarkEnvironment::setWindow(Window* window)
+{
+	mWindow = window;
+}
+
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) return EXIT_FAILURE;
+
+	nex::LogSink::get()->registerStream(&std::cout);
+	nex::LogSink::get()->startAsync();
+	nex::LoggerManager::get()->setMinLogLevel(nex::Warning);
+
+	auto* provider = nex::SubSystemProviderHeadless::get();
+	if (!provider->init())
+	{
+		std::cerr << "Couldn't initialize window system!" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	nex::Window::WindowStruct desc;
+	desc.title = "EngineBenchmark";
+	desc.frameBufferWidth = desc.virtualScreenWidth = 800;
+	desc.frameBufferHeight = desc.virtualScreenHeight = 600;
+	desc.visible = false;
+	nex::BenchmarkEnvironment::setWindow(provider->createWindow(desc));
+
+	nex::ImageFactory::init(true);
+
+	// the null backend still resolves the shader sources of the effect library
+	nex::FileSystem shaderFileSystem(std::vector<std::filesystem::path>{ 
+		std::string(EUCLID_BUILD_PATH) + "shaders/opengl/", 
+		std::string(EUCLID_BUILD_PATH) + "shaders/interface/"}, "", "");
+	nex::ShaderSourceFileGenerator::get()->init(&shaderFileSystem);
+
+	benchmark::RunSpecifiedBenchmarks();
+
+	nex::TextureManager::get()->release();
+	nex::RenderBackend::get()->release();
+	provider->terminate();
+	nex::LogSink::get()->stopAsync();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+#include <nex/anim/BonePalette.hpp>
+#include <nex/buffer/ShaderBuffer.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+
+/**
+ * Bone transformation submission for 500 skinned vobs (64 bones each) per frame.
+ *
+ * PerVob: The previous approach; each vob uploads its pose to its own buffer and binds it before its draw.
+ * Palette: The poses are written directly into the streaming buffer range of one BonePalette; each draw binds the
+ * palette range.
+ *
+ * The counters report the buffer uploads (palette: the allocated range) and uploaded bytes per frame
+ * (null backend; the data is copied to host memory).
+ */
+
+namespace
+{
+	constexpr size_t VOB_COUNT = 500;
+	constexpr size_t BONE_COUNT = 64;
+
+	void reportUploads(benchmark::State& state, uint64_t uploads, uint64_t uploadBytes)
+	{
+		const auto frames = static_cast<double>(state.iterations());
+		state.counters["uploadsPerFrame"] = uploads / frames;
+		state.counters["bytesPerFrame"] = uploadBytes / frames;
+	}
+}
+
+static void BM_Bones_PerVob(benchmark::State& state)
+{
+	std::vector<std::vector<glm::mat4>> poses(VOB_COUNT, std::vector<glm::mat4>(BONE_COUNT, glm::mat4(1.0f)));
+	std::vector<std::unique_ptr<nex::ShaderStorageBuffer>> buffers;
+	for (size_t i = 0; i < VOB_COUNT; ++i) {
+		buffers.emplace_back(std::make_unique<nex::ShaderStorageBuffer>(0, BONE_COUNT * sizeof(glm::mat4), nullptr,
+			nex::GpuBuffer::UsageHint::STREAM_DRAW));
+	}
+
+	nex::NullStatistics::get()->reset();
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < VOB_COUNT; ++i) {
+			buffers[i]->update(BONE_COUNT * sizeof(glm::mat4), poses[i].data());
+			buffers[i]->bindToTarget();
+		}
+	}
+
+	auto* statistics = nex::NullStatistics::get();
+	reportUploads(state, statistics->getValue(nex::NullStatistics::Counter::BUFFER_UPLOADS),
+		statistics->getValue(nex::NullStatistics::Counter::BUFFER_UPLOAD_BYTES));
+}
+
+static void BM_Bones_Palette(benchmark::State& state)
+{
+	std::vector<std::vector<glm::mat4>> poses(VOB_COUNT, std::vector<glm::mat4>(BONE_COUNT, glm::mat4(1.0f)));
+	nex::StreamingBuffer buffer(VOB_COUNT * BONE_COUNT * sizeof(glm::mat4));
+	nex::BonePalette palette(VOB_COUNT * BONE_COUNT);
+	unsigned offset;
+
+	uint64_t uploads = 0;
+	uint64_t uploadBytes = 0;
+
+	for (auto _ : state) {
+		palette.begin(buffer);
+
+		// collecting render commands
+		for (size_t i = 0; i < VOB_COUNT; ++i) {
+			benchmark::DoNotOptimize(palette.add(&poses[i], poses[i], offset));
+		}
+
+		// drawing
+		for (size_t i = 0; i < VOB_COUNT; ++i) {
+			palette.bind(buffer, 0);
+		}
+
+		++uploads;
+		uploadBytes += palette.getTrafoCount() * sizeof(glm::mat4);
+
+		buffer.markFrame();
+		palette.clear();
+	}
+
+	reportUploads(state, uploads, uploadBytes);
+}
+
+BENCHMARK(BM_Bones_PerVob)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Bones_Palette)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,208 @@
+#include <nex/common/File.hpp>
+#include <nex/anim/KeyFrameAnimation.hpp>
+#include <nex/anim/Rig.hpp>
+#include <benchmark/benchmark.h>
+
+/**
+ * Round trip (write + read) of an animation and its rig through BinStream files:
+ *  - element wise: the vectors of the animation are written and read with one call per element, as before bulk io.
+ *  - bulk: the regular serialization; vectors of trivially copyable elements are written and read with one call.
+ * Both encodings are identical. The stream buffer size is varied between the former (1 KiB) and the current default.
+ * BM_BinStream_AnimationReadMapped reads the same file from a mapping.
+ *
+ * Note: The animation has 64 bones and 2000 frames (~5 MB); it is a KeyFrameAnimation, as a BoneAnimation resolves
+ * its rig through the AnimationManager.
+ */
+
+namespace
+{
+	constexpr unsigned BONE_COUNT = 64;
+	constexpr unsigned FRAME_COUNT = 2000;
+
+	/**
+	 * Serializes the key frame data element by element, with the same encoding as KeyFrameAnimation.
+	 */
+	class ElementWiseAnimation : public nex::KeyFrameAnimation
+	{
+	public:
+		ElementWiseAnimation() = default;
+
+		ElementWiseAnimation(const nex::KeyFrameAnimationData& data, const ChannelIDGenerator& generator) :
+			KeyFrameAnimation(data, generator)
+		{
+		}
+
+		void write(nex::BinStream& out) const override
+		{
+			out << mName;
+			out << mTickCount;
+			out << mChannelCount;
+			out << mTicksPerSecond;
+			writeElements(out, mPositions);
+			writeElements(out, mRotations);
+			writeElements(out, mScales);
+		}
+
+		void load(nex::BinStream& in) override
+		{
+			in >> mName;
+			in >> mTickCount;
+			in >> mChannelCount;
+			in >> mTicksPerSecond;
+			readElements(in, mPositions);
+			readElements(in, mRotations);
+			readElements(in, mScales);
+		}
+
+	private:
+		template<class T>
+		static void writeElements(nex::BinStream& out, const std::vector<T>& vec)
+		{
+			out << vec.size();
+			for (const auto& element : vec) out << element;
+		}
+
+		template<class T>
+		static void readElements(nex::BinStream& in, std::vector<T>& vec)
+		{
+			size_t count = 0;
+			in >> count;
+			vec.resize(count);
+			for (auto& element : vec) in >> element;
+		}
+	};
+
+	struct IdentityChannels : public nex::KeyFrameAnimation::ChannelIDGenerator
+	{
+		nex::ChannelID operator()(nex::Sid keyFrameSID) const override
+		{
+			return keyFrameSID;
+		}
+	};
+
+	nex::KeyFrameAnimationData createAnimationData()
+	{
+		nex::KeyFrameAnimationData data;
+		data.setName("benchmark_animation");
+		data.setChannelCount(BONE_COUNT);
+		data.setTickCount(FRAME_COUNT - 1.0f);
+		data.setTicksPerSecond(30.0f);
+
+		for (unsigned bone = 0; bone < BONE_COUNT; ++bone) {
+			for (int frame = 0; frame < static_cast<int>(FRAME_COUNT); ++frame) {
+				const auto value = static_cast<float>(bone * FRAME_COUNT + frame);
+				data.addPositionKey({ bone, frame, glm::vec3(value, 0.0f, 1.0f) });
+				data.addRotationKey({ bone, frame, glm::quat(1.0f, 0.0f, value, 0.0f) });
+				data.addScaleKey({ bone, frame, glm::vec3(1.0f) });
+			}
+		}
+
+		return data;
+	}
+
+	nex::Rig createRig()
+	{
+		nex::RigData data;
+		data.setRoot(std::make_unique<nex::BoneData>("bone_0"));
+
+		// a tree with 4 children per bone
+		for (unsigned i = 1; i < BONE_COUNT; ++i) {
+			data.addBone(std::make_unique<nex::BoneData>("bone_" + std::to_string(i)), "bone_" + std::to_string((i - 1) / 4));
+		}
+
+		data.optimize();
+		return nex::Rig(data);
+	}
+
+	struct Content
+	{
+		ElementWiseAnimation animation;
+		nex::Rig rig;
+		std::filesystem::path path;
+
+		Content() : animation(createAnimationData(), IdentityChannels()), rig(createRig()),
+			path(std::filesystem::temp_directory_path() / "EngineBenchmark" / "animation.CANI")
+		{
+			std::filesystem::create_directories(path.parent_path());
+		}
+
+		~Content()
+		{
+			std::error_code error;
+			std::filesystem::remove(path, error);
+		}
+	};
+
+	Content& getContent()
+	{
+		static Content content;
+		return content;
+	}
+
+	void writeFile(const Content& content, size_t bufferSize, bool bulk)
+	{
+		nex::BinStream file(bufferSize);
+		file.open(content.path, std::ios::out | std::ios::trunc);
+		if (bulk) {
+			content.animation.KeyFrameAnimation::write(file);
+		}
+		else {
+			content.animation.write(file);
+		}
+		file << content.rig;
+		file.close();
+	}
+}
+
+static void BM_BinStream_AnimationRoundTrip(benchmark::State& state)
+{
+	const auto bufferSize = static_cast<size_t>(state.range(0));
+	const bool bulk = state.range(1) != 0;
+	auto& content = getContent();
+
+	ElementWiseAnimation animation;
+	auto rig = nex::Rig::createUninitialized();
+
+	for (auto _ : state) {
+		writeFile(content, bufferSize, bulk);
+
+		nex::BinStream file(bufferSize);
+		file.open(content.path, std::ios::in);
+		if (bulk) {
+			animation.KeyFrameAnimation::load(file);
+		}
+		else {
+			animation.load(file);
+		}
+		file >> rig;
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["fileBytes"] = static_cast<double>(std::filesystem::file_size(content.path));
+}
+
+static void BM_BinStream_AnimationReadMapped(benchmark::State& state)
+{
+	auto& content = getContent();
+	writeFile(content, nex::BinStream::DEFAULT_BUFFER_SIZE, true);
+
+	nex::KeyFrameAnimation animation;
+	auto rig = nex::Rig::createUninitialized();
+
+	for (auto _ : state) {
+		nex::BinStream file;
+		file.openMapped(content.path);
+		file >> animation;
+		file >> rig;
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["fileBytes"] = static_cast<double>(std::filesystem::file_size(content.path));
+}
+
+BENCHMARK(BM_BinStream_AnimationRoundTrip)->ArgNames({ "bufferSize", "bulk" })
+	->Args({ 1024, 0 })->Args({ 1024, 1 })
+	->Args({ nex::BinStream::DEFAULT_BUFFER_SIZE, 0 })->Args({ nex::BinStream::DEFAULT_BUFFER_SIZE, 1 })
+	->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_BinStream_AnimationReadMapped)->Unit(benchmark::kMillisecond);
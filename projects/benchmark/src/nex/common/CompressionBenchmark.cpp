@@ -0,0 +1,165 @@
+#include <nex/common/Compression.hpp>
+#include <nex/common/File.hpp>
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+/**
+ * Compression of compiled resources (see nex::Compression) on synthetic content:
+ *  - mesh: interleaved vertices (position, normal, uv) of a displaced 512x512 grid and its triangle indices (~14 MB)
+ *  - texture: a 1024x1024 RGBA8 image with gradients, noise and an opaque alpha channel (4 MB)
+ *
+ * BM_Compression_Decompress measures the decoder on the calling thread.
+ * BM_Compression_Load reads mesh and texture through BinStream, as FileSystem::load does, from an uncompressed and
+ * from a compressed file. The files are in the page cache, i.e. this is the warm load time.
+ */
+
+namespace
+{
+	enum Content
+	{
+		MESH = 0,
+		TEXTURE = 1,
+	};
+
+	std::vector<char> createMesh()
+	{
+		constexpr int size = 512;
+
+		struct Vertex
+		{
+			glm::vec3 position;
+			glm::vec3 normal;
+			glm::vec2 uv;
+		};
+
+		std::vector<Vertex> vertices;
+		vertices.reserve(size * size);
+		for (int z = 0; z < size; ++z) {
+			for (int x = 0; x < size; ++x) {
+				const auto height = 4.0f * std::sin(x * 0.05f) * std::cos(z * 0.03f);
+				const auto normal = glm::normalize(glm::vec3(-std::cos(x * 0.05f), 1.0f, std::sin(z * 0.03f)));
+				vertices.push_back({ glm::vec3(x, height, z), normal, glm::vec2(x, z) / float(size) });
+			}
+		}
+
+		std::vector<uint32_t> indices;
+		indices.reserve((size - 1) * (size - 1) * 6);
+		for (uint32_t z = 0; z < size - 1; ++z) {
+			for (uint32_t x = 0; x < size - 1; ++x) {
+				const auto i = z * size + x;
+				for (auto index : { i, i + size, i + 1, i + 1, i + size, i + size + 1 }) indices.push_back(index);
+			}
+		}
+
+		std::vector<char> data(vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t));
+		std::memcpy(data.data(), vertices.data(), vertices.size() * sizeof(Vertex));
+		std::memcpy(data.data() + vertices.size() * sizeof(Vertex), indices.data(), indices.size() * sizeof(uint32_t));
+		return data;
+	}
+
+	std::vector<char> createTexture()
+	{
+		constexpr int size = 1024;
+		std::mt19937 random(42);
+		std::uniform_int_distribution<int> noise(0, 3);
+
+		std::vector<char> data(size * size * 4);
+		for (int y = 0; y < size; ++y) {
+			for (int x = 0; x < size; ++x) {
+				auto* pixel = &data[(y * size + x) * 4];
+				pixel[0] = static_cast<char>(x / 4 + noise(random));
+				pixel[1] = static_cast<char>(y / 4);
+				pixel[2] = static_cast<char>((x + y) / 16);
+				pixel[3] = static_cast<char>(255);
+			}
+		}
+
+		return data;
+	}
+
+	const std::vector<char>& getContent(Content content)
+	{
+		static const std::vector<char> mesh = createMesh();
+		static const std::vector<char> texture = createTexture();
+		return content == MESH ? mesh : texture;
+	}
+
+	/**
+	 * Writes mesh and texture to a file in the temporary directory.
+	 */
+	class ContentFile
+	{
+	public:
+		ContentFile(bool compress) :
+			mPath(std::filesystem::temp_directory_path() / "EngineBenchmark" / (compress ? "compressed.bin" : "uncompressed.bin"))
+		{
+			std::filesystem::create_directories(mPath.parent_path());
+
+			nex::BinStream file;
+			if (compress) {
+				file.openCompressed(mPath);
+			}
+			else {
+				file.open(mPath, std::ios::out | std::ios::trunc);
+			}
+
+			file << getContent(MESH);
+			file << getContent(TEXTURE);
+			file.close();
+		}
+
+		~ContentFile()
+		{
+			std::error_code error;
+			std::filesystem::remove(mPath, error);
+		}
+
+		const std::filesystem::path& getPath() const
+		{
+			return mPath;
+		}
+
+	private:
+		std::filesystem::path mPath;
+	};
+}
+
+static void BM_Compression_Decompress(benchmark::State& state)
+{
+	const auto& content = getContent(static_cast<Content>(state.range(0)));
+	const auto compressed = nex::Compression::compress(content.data(), content.size());
+	std::vector<char> decompressed;
+
+	for (auto _ : state) {
+		nex::Compression::decompress(compressed.data(), compressed.size(), decompressed);
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["ratio"] = static_cast<double>(compressed.size()) / content.size();
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * content.size()));
+}
+
+static void BM_Compression_Load(benchmark::State& state)
+{
+	const bool compressed = state.range(0) != 0;
+	ContentFile file(compressed);
+	std::vector<char> mesh;
+	std::vector<char> texture;
+
+	for (auto _ : state) {
+		nex::BinStream in;
+		in.open(file.getPath(), std::ios::in);
+		in >> mesh;
+		in >> texture;
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["fileBytes"] = static_cast<double>(std::filesystem::file_size(file.getPath()));
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (mesh.size() + texture.size())));
+}
+
+BENCHMARK(BM_Compression_Decompress)->ArgName("content")->Arg(MESH)->Arg(TEXTURE)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Compression_Load)->ArgName("compressed")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
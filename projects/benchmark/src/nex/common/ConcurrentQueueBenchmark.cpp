@@ -0,0 +1,72 @@
+#include <nex/common/ConcurrentQueue.hpp>
+#include <nex/util/concurrent/ConcurrentQueue.hpp>
+#include <benchmark/benchmark.h>
+#include <thread>
+
+/**
+ * Contention of the command/job queues: Producer threads push small elements while one consumer pops them.
+ * Compares nex::ConcurrentQueue (lock-free ring buffer with locked overflow) with the mutex based queue
+ * it replaced. The ring capacity variants show the cost of the overflow path if the consumer falls behind.
+ */
+
+namespace
+{
+	constexpr int ELEMENTS_PER_PRODUCER = 100000;
+
+	template<class Queue, class PopFunc>
+	void runContention(Queue& queue, int producerCount, PopFunc&& pop)
+	{
+		std::vector<std::thread> producers;
+		for (int p = 0; p < producerCount; ++p) {
+			producers.emplace_back([&queue] {
+				for (int i = 0; i < ELEMENTS_PER_PRODUCER; ++i) queue.push(i);
+			});
+		}
+
+		const int total = producerCount * ELEMENTS_PER_PRODUCER;
+		long long sum = 0;
+		for (int i = 0; i < total; ++i) sum += pop(queue);
+		benchmark::DoNotOptimize(sum);
+
+		for (auto& producer : producers) producer.join();
+	}
+}
+
+static void BM_ConcurrentQueue_Contention(benchmark::State& state)
+{
+	const auto producerCount = static_cast<int>(state.range(0));
+	const auto capacity = static_cast<size_t>(state.range(1));
+
+	for (auto _ : state)
+	{
+		nex::ConcurrentQueue<int> queue(capacity);
+		runContention(queue, producerCount, [](nex::ConcurrentQueue<int>& q) { return q.pop(); });
+	}
+
+	state.SetItemsProcessed(state.iterations() * producerCount * ELEMENTS_PER_PRODUCER);
+}
+
+BENCHMARK(BM_ConcurrentQueue_Contention)
+	->ArgNames({"producers", "capacity"})
+	->ArgsProduct({ {1, 2, 4, 8}, {64, 8192} })
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
+
+static void BM_MutexQueue_Contention(benchmark::State& state)
+{
+	const auto producerCount = static_cast<int>(state.range(0));
+
+	for (auto _ : state)
+	{
+		::ConcurrentQueue<int> queue;
+		runContention(queue, producerCount, [](::ConcurrentQueue<int>& q) { return q.wait_pop(); });
+	}
+
+	state.SetItemsProcessed(state.iterations() * producerCount * ELEMENTS_PER_PRODUCER);
+}
+
+BENCHMARK(BM_MutexQueue_Contention)
+	->ArgNames({"producers"})
+	->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
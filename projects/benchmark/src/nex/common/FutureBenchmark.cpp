@@ -0,0 +1,66 @@
+#include <nex/common/Future.hpp>
+#include <benchmark/benchmark.h>
+
+/**
+ * Overhead of the future continuation machinery: 
+ *  - a single promise with one inline continuation
+ *  - a chain of inline continuations (trampolined, see InlineExecutor) of varying length
+ *  - continuations dispatched by a queueing executor (as the resource loader executor does, minus the workers)
+ */
+
+static void BM_Future_ThenInline(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		nex::Promise<int> promise;
+		auto future = promise.get_future().then([](nex::Future<int> f) { return f.get() + 1; });
+		promise.set_value(1);
+		benchmark::DoNotOptimize(future.get());
+	}
+}
+
+BENCHMARK(BM_Future_ThenInline);
+
+static void BM_Future_InlineChain(benchmark::State& state)
+{
+	const auto chainLength = state.range(0);
+
+	for (auto _ : state)
+	{
+		nex::Promise<int> promise;
+		auto future = promise.get_future();
+
+		for (int64_t i = 0; i < chainLength; ++i) {
+			future = future.then([](nex::Future<int> f) { return f.get() + 1; });
+		}
+
+		promise.set_value(0);
+		benchmark::DoNotOptimize(future.get());
+	}
+
+	state.SetItemsProcessed(state.iterations() * chainLength);
+}
+
+BENCHMARK(BM_Future_InlineChain)->RangeMultiplier(10)->Range(10, 100000);
+
+static void BM_Future_ThenQueuedExecutor(benchmark::State& state)
+{
+	std::vector<nex::Continuation> continuations;
+	nex::Executor executor = [&](nex::Continuation continuation) {
+		continuations.emplace_back(std::move(continuation));
+	};
+
+	for (auto _ : state)
+	{
+		nex::Promise<int> promise;
+		auto future = promise.get_future().then(executor, [](nex::Future<int> f) { return f.get() + 1; });
+		promise.set_value(1);
+
+		for (auto& continuation : continuations) continuation();
+		continuations.clear();
+
+		benchmark::DoNotOptimize(future.get());
+	}
+}
+
+BENCHMARK(BM_Future_ThenQueuedExecutor);
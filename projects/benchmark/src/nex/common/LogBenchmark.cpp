@@ -0,0 +1,86 @@
+#include <nex/common/Log.hpp>
+#include <benchmark/benchmark.h>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+/**
+ * Throughput of the log sink: Threads write pre-formatted messages to a stream that discards its input.
+ * Compares synchronous writing (stream mutex on the calling thread) with the asynchronous ring buffers.
+ * The messages per second include writing by the background thread, since the sink is stopped in each iteration.
+ */
+
+namespace
+{
+	constexpr int MESSAGES_PER_THREAD = 20000;
+	const char* MESSAGE = "[Benchmark] [INFO](LogBenchmark.cpp, runThreads, 42): a typical log message of moderate length";
+
+	class NullBuffer : public std::streambuf
+	{
+	protected:
+		int_type overflow(int_type c) override { return c; }
+		std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+	};
+
+	void runThreads(nex::LogSink& sink, int threadCount)
+	{
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&sink] {
+				for (int i = 0; i < MESSAGES_PER_THREAD; ++i) sink.write(MESSAGE, nex::Info);
+			});
+		}
+
+		for (auto& thread : threads) thread.join();
+	}
+}
+
+static void BM_LogSink_Sync(benchmark::State& state)
+{
+	const auto threadCount = static_cast<int>(state.range(0));
+	NullBuffer buffer;
+	std::ostream stream(&buffer);
+
+	for (auto _ : state)
+	{
+		nex::LogSink sink;
+		sink.registerStream(&stream);
+		runThreads(sink, threadCount);
+		sink.flush();
+	}
+
+	state.SetItemsProcessed(state.iterations() * threadCount * MESSAGES_PER_THREAD);
+}
+
+BENCHMARK(BM_LogSink_Sync)
+	->ArgName("threads")
+	->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
+
+static void BM_LogSink_Async(benchmark::State& state)
+{
+	const auto threadCount = static_cast<int>(state.range(0));
+	NullBuffer buffer;
+	std::ostream stream(&buffer);
+
+	nex::LogSink::AsyncConfig config;
+	config.overflowPolicy = nex::LogSink::OverflowPolicy::BLOCK;
+
+	for (auto _ : state)
+	{
+		nex::LogSink sink;
+		sink.registerStream(&stream);
+		sink.startAsync(config);
+		runThreads(sink, threadCount);
+		sink.stopAsync();
+	}
+
+	state.SetItemsProcessed(state.iterations() * threadCount * MESSAGES_PER_THREAD);
+}
+
+BENCHMARK(BM_LogSink_Async)
+	->ArgName("threads")
+	->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
@@ -0,0 +1,192 @@
+#include <nex/math/DynamicAABBTree.hpp>
+#include <benchmark/benchmark.h>
+#include <random>
+
+/**
+ * Spatial queries of the dynamic AABB tree compared with a linear scan over all boxes, for 1k, 10k and 100k random
+ * boxes (sizes 0.4 - 4, density independent of the count). The query volumes cover about 1% of the world.
+ */
+
+namespace
+{
+	struct Boxes
+	{
+		std::vector<nex::AABB> boxes;
+		std::vector<int32_t> proxies;
+		nex::DynamicAABBTree tree;
+		std::mt19937 random;
+		float worldSize;
+
+		explicit Boxes(int count) : random(count), worldSize(std::cbrt(static_cast<float>(count)) * 10.0f)
+		{
+			std::uniform_real_distribution<float> position(0.0f, worldSize);
+			std::uniform_real_distribution<float> size(0.2f, 2.0f);
+
+			for (int i = 0; i < count; ++i) {
+				const glm::vec3 center(position(random), position(random), position(random));
+				const glm::vec3 extent(size(random));
+				boxes.emplace_back(center - extent, center + extent);
+				proxies.push_back(tree.createProxy(boxes.back(), nullptr));
+			}
+		}
+
+		nex::AABB getQueryBox() const
+		{
+			return nex::AABB(glm::vec3(worldSize * 0.4f), glm::vec3(worldSize * 0.6f));
+		}
+
+		nex::Frustum getQueryFrustum() const
+		{
+			const auto box = getQueryBox();
+			nex::Frustum frustum;
+			frustum.planes[0] = nex::Plane(glm::vec3(0, 0, 1), -box.min.z);
+			frustum.planes[1] = nex::Plane(glm::vec3(0, 0, -1), box.max.z);
+			frustum.planes[2] = nex::Plane(glm::vec3(1, 0, 0), -box.min.x);
+			frustum.planes[3] = nex::Plane(glm::vec3(-1, 0, 0), box.max.x);
+			frustum.planes[4] = nex::Plane(glm::vec3(0, 1, 0), -box.min.y);
+			frustum.planes[5] = nex::Plane(glm::vec3(0, -1, 0), box.max.y);
+			return frustum;
+		}
+	};
+
+	bool isOutside(const nex::Frustum& frustum, const nex::AABB& box)
+	{
+		for (const auto& plane : frustum.planes) {
+			const auto& n = plane.mNormal;
+			const glm::vec3 positive(n.x >= 0 ? box.max.x : box.min.x, n.y >= 0 ? box.max.y : box.min.y, n.z >= 0 ? box.max.z : box.min.z);
+			if (glm::dot(n, positive) + plane.mSignedDistance < 0) return true;
+		}
+		return false;
+	}
+}
+
+static void BM_DynamicAABBTree_Frustum(benchmark::State& state)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const auto frustum = boxes.getQueryFrustum();
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		boxes.tree.queryFrustum(frustum, [&](int32_t) { ++count; });
+		benchmark::DoNotOptimize(count);
+	}
+}
+
+static void BM_LinearScan_Frustum(benchmark::State& state)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const auto frustum = boxes.getQueryFrustum();
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		for (const auto& box : boxes.boxes) count += !isOutside(frustum, box);
+		benchmark::DoNotOptimize(count);
+	}
+}
+
+static void BM_DynamicAABBTree_Sphere(benchmark::State& state)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const nex::Sphere sphere(glm::vec3(boxes.worldSize * 0.5f), boxes.worldSize * 0.1f);
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		boxes.tree.querySphere(sphere, [&](int32_t) { ++count; });
+		benchmark::DoNotOptimize(count);
+	}
+}
+
+static void BM_LinearScan_Sphere(benchmark::State& state)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const nex::Sphere sphere(glm::vec3(boxes.worldSize * 0.5f), boxes.worldSize * 0.1f);
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		for (const auto& box : boxes.boxes) count += sphere.intersects(box);
+		benchmark::DoNotOptimize(count);
+	}
+}
+
+static void BM_DynamicAABBTree_Ray(benchmark::State& state)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const nex::Ray ray(glm::vec3(0.0f), glm::normalize(glm::vec3(1.0f, 0.9f, 1.1f)));
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		boxes.tree.queryRay(ray, 1e30f, [&](int32_t) { ++count; });
+		benchmark::DoNotOptimize(count);
+	}
+}
+
+static void BM_LinearScan_Ray(benchmark::State& state)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const nex::Ray ray(glm::vec3(0.0f), glm::normalize(glm::vec3(1.0f, 0.9f, 1.1f)));
+
+	for (auto _ : state)
+	{
+		size_t count = 0;
+		for (const auto& box : boxes.boxes) {
+			const auto result = box.testRayIntersection(ray);
+			count += result.intersected && result.secondIntersection >= 0;
+		}
+		benchmark::DoNotOptimize(count);
+	}
+}
+
+static void BM_DynamicAABBTree_Nearest(benchmark::State& state)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const glm::vec3 point(boxes.worldSize * 0.4f);
+	std::vector<int32_t> result;
+
+	for (auto _ : state)
+	{
+		boxes.tree.queryNearest(point, 4, [](int32_t) { return true; }, result);
+		benchmark::DoNotOptimize(result.data());
+	}
+}
+
+/**
+ * Moves 10% of the boxes per iteration to a random position near their initial one. With a jitter of 0.05 the boxes
+ * stay within their fattened box (margin 0.1), with a jitter of 1 nearly every move reinserts the leaf.
+ */
+static void BM_DynamicAABBTree_Move(benchmark::State& state, float jitter)
+{
+	Boxes boxes(static_cast<int>(state.range(0)));
+	const auto initial = boxes.boxes;
+	std::uniform_real_distribution<float> offset(-jitter, jitter);
+	size_t next = 0;
+
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < boxes.boxes.size() / 10; ++i) {
+			const auto index = (next++ * 7919) % boxes.boxes.size();
+			const glm::vec3 delta(offset(boxes.random), offset(boxes.random), offset(boxes.random));
+			boxes.boxes[index].min = initial[index].min + delta;
+			boxes.boxes[index].max = initial[index].max + delta;
+			boxes.tree.moveProxy(boxes.proxies[index], boxes.boxes[index]);
+		}
+	}
+}
+
+#define NEX_AABB_TREE_ARGS ->ArgName("boxes")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond)
+#define NEX_AABB_TREE_BENCHMARK(func) BENCHMARK(func) NEX_AABB_TREE_ARGS
+#define NEX_AABB_TREE_BENCHMARK_CAPTURE(func, name, jitter) BENCHMARK_CAPTURE(func, name, jitter) NEX_AABB_TREE_ARGS
+
+NEX_AABB_TREE_BENCHMARK(BM_DynamicAABBTree_Frustum);
+NEX_AABB_TREE_BENCHMARK(BM_LinearScan_Frustum);
+NEX_AABB_TREE_BENCHMARK(BM_DynamicAABBTree_Sphere);
+NEX_AABB_TREE_BENCHMARK(BM_LinearScan_Sphere);
+NEX_AABB_TREE_BENCHMARK(BM_DynamicAABBTree_Ray);
+NEX_AABB_TREE_BENCHMARK(BM_LinearScan_Ray);
+NEX_AABB_TREE_BENCHMARK(BM_DynamicAABBTree_Nearest);
+NEX_AABB_TREE_BENCHMARK_CAPTURE(BM_DynamicAABBTree_Move, small, 0.05f);
+NEX_AABB_TREE_BENCHMARK_CAPTURE(BM_DynamicAABBTree_Move, reinsert, 1.0f);
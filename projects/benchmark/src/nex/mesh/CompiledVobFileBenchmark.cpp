@@ -0,0 +1,145 @@
+#include <nex/mesh/CompiledVobFile.hpp>
+#include <nex/common/File.hpp>
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+/**
+ * Load time of compiled vob files of Sponza size (103 meshes, ~184k vertices, ~786k indices; synthetic data):
+ *  - version 1: the store is decoded with BinStream, vertex and index data is copied into vectors of the mesh stores.
+ *  - version 2: the file is mapped, the mesh stores reference the mapping.
+ * Each load is followed by a copy of all vertex and index data, that stands in for the upload to the gpu.
+ *
+ * The heapBytes counter is the vertex and index data held by the mesh stores after loading. Peak RSS can't be
+ * separated per benchmark in one process (and mapped pages count towards RSS as reclaimable page cache), so it
+ * isn't reported. The files are in the page cache, i.e. this is the warm load time.
+ */
+
+namespace
+{
+	constexpr size_t MESH_COUNT = 103;
+	constexpr size_t VERTEX_COUNT = 184000;
+	constexpr size_t INDEX_COUNT = 786000;
+
+	// position, normal, tangent, bitangent and uv
+	constexpr size_t VERTEX_STRIDE = 4 * sizeof(glm::vec3) + sizeof(glm::vec2);
+
+	nex::VobBaseStore createStore(size_t scale)
+	{
+		nex::VobBaseStore store;
+		store.localToParentTrafo = glm::mat4(1.0f);
+		store.nodeName = "sponza";
+		store.meshes.resize(MESH_COUNT * scale);
+
+		const auto vertexCount = VERTEX_COUNT / MESH_COUNT;
+		const auto indexCount = INDEX_COUNT / MESH_COUNT;
+
+		for (auto& mesh : store.meshes) {
+			mesh.indexType = nex::IndexElementType::BIT_32;
+			for (int i = 0; i < 4; ++i) mesh.layout.push<glm::vec3>(1, nullptr, false, false, true);
+			mesh.layout.push<glm::vec2>(1, nullptr, false, false, true);
+			mesh.boundingBox.min = glm::vec3(-1.0f);
+			mesh.boundingBox.max = glm::vec3(1.0f);
+			mesh.topology = nex::Topology::TRIANGLES;
+			mesh.indices.resize(indexCount * sizeof(uint32_t), 1);
+			mesh.verticesMap[nullptr].resize(vertexCount * VERTEX_STRIDE, 2);
+			mesh.useIndexBuffer = true;
+			mesh.arrayOffset = 0;
+			mesh.vertexCount = vertexCount;
+			mesh.isSkinned = false;
+		}
+
+		return store;
+	}
+
+	/**
+	 * Creates a version 1 and a version 2 file of the same store in a temporary directory.
+	 */
+	class VobFiles
+	{
+	public:
+		VobFiles(size_t scale) : mRoot(std::filesystem::temp_directory_path() / "EngineBenchmark" / "vobs")
+		{
+			std::filesystem::create_directories(mRoot);
+			const auto store = createStore(scale);
+
+			mVersion1 = mRoot / ("sponza_v1_" + std::to_string(scale) + ".CVOB");
+			mVersion2 = mRoot / ("sponza_v2_" + std::to_string(scale) + ".CVOB");
+
+			nex::BinStream file;
+			file.open(mVersion1, std::ios::out | std::ios::trunc);
+			file << store;
+			file.close();
+
+			nex::CompiledVobFile::write(mVersion2, store);
+		}
+
+		~VobFiles()
+		{
+			std::error_code error;
+			std::filesystem::remove(mVersion1, error);
+			std::filesystem::remove(mVersion2, error);
+		}
+
+		const std::filesystem::path& getPath(uint32_t version) const
+		{
+			return version == 1 ? mVersion1 : mVersion2;
+		}
+
+	private:
+		std::filesystem::path mRoot;
+		std::filesystem::path mVersion1;
+		std::filesystem::path mVersion2;
+	};
+
+	/**
+	 * Copies all vertex and index data to the upload buffer and provides the number of bytes held by the stores.
+	 */
+	size_t upload(const nex::VobBaseStore& store, std::vector<char>& uploadBuffer)
+	{
+		size_t offset = 0;
+		size_t heapBytes = 0;
+
+		const auto copy = [&](const nex::MeshDataView& view) {
+			std::memcpy(uploadBuffer.data() + offset, view.data, view.size);
+			offset += view.size;
+		};
+
+		for (const auto& mesh : store.meshes) {
+			copy(mesh.getIndexData());
+			for (const auto& it : mesh.getVertexData()) copy(it.second);
+
+			heapBytes += mesh.indices.size();
+			for (const auto& it : mesh.verticesMap) heapBytes += it.second.size();
+		}
+
+		return heapBytes;
+	}
+}
+
+static void BM_LoadCompiledVob(benchmark::State& state)
+{
+	const auto version = static_cast<uint32_t>(state.range(0));
+	const auto scale = static_cast<size_t>(state.range(1));
+
+	VobFiles files(scale);
+	const auto& path = files.getPath(version);
+	std::vector<char> uploadBuffer(scale * (INDEX_COUNT * sizeof(uint32_t) + VERTEX_COUNT * VERTEX_STRIDE));
+	size_t heapBytes = 0;
+
+	for (auto _ : state) {
+		nex::VobBaseStore store;
+		nex::CompiledVobFile file;
+		file.read(path, store);
+		heapBytes = upload(store, uploadBuffer);
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["fileBytes"] = static_cast<double>(std::filesystem::file_size(path));
+	state.counters["heapBytes"] = static_cast<double>(heapBytes);
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * uploadBuffer.size()));
+}
+
+BENCHMARK(BM_LoadCompiledVob)->ArgNames({ "version", "scale" })
+	->Args({ 1, 1 })->Args({ 2, 1 })
+	->Args({ 1, 8 })->Args({ 2, 8 })
+	->Unit(benchmark::kMillisecond);
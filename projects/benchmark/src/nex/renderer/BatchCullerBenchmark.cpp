@@ -0,0 +1,135 @@
+#include <nex/renderer/BatchCuller.hpp>
+#include <nex/camera/Camera.hpp>
+#include <nex/math/Sphere.hpp>
+#include <benchmark/benchmark.h>
+#include <random>
+
+/**
+ * Frustum culling of 1k, 10k and 100k random boxes: the per box test, that RenderCommandQueue used before, compared
+ * with BatchCuller using the scalar, SSE and AVX paths. Instruction sets the CPU doesn't support are skipped.
+ */
+
+namespace
+{
+	using InstructionSet = nex::BatchCuller::InstructionSet;
+
+	bool boxInFrustum(const nex::Frustum& frustum, const nex::AABB& box)
+	{
+		const unsigned char ALL_CORNERS = 8;
+		unsigned char out = 0;
+
+		for (const auto& plane : frustum.planes) {
+			const glm::vec4 planeAsVec(plane.mNormal, plane.mSignedDistance);
+			out = 0;
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.min.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.min.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.max.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.min.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.max.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.min.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.max.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.max.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			if (out == ALL_CORNERS) return false;
+		}
+
+		out = 0; for (const auto& c : frustum.corners) out += ((c.x > box.max.x) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.x < box.min.x) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.y > box.max.y) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.y < box.min.y) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.z > box.max.z) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.z < box.min.z) ? 1 : 0); if (out == ALL_CORNERS) return false;
+
+		return true;
+	}
+
+	/**
+	 * A frustum at the origin looking along -z (90 degrees, aspect 16:9, near 0.1, far 100) and random boxes around it.
+	 */
+	struct CullingScene
+	{
+		nex::Frustum frustum;
+		std::vector<nex::AABB> boxes;
+		nex::AABBBatch batch;
+
+		explicit CullingScene(size_t count)
+		{
+			const float aspect = 16.0f / 9.0f;
+			auto corner = [&](float d, float sx, float sy) {
+				return glm::vec3(sx * d * aspect, sy * d, -d);
+			};
+
+			frustum.corners[0] = corner(100.0f, -1, -1);
+			frustum.corners[1] = corner(100.0f, -1, 1);
+			frustum.corners[2] = corner(100.0f, 1, -1);
+			frustum.corners[3] = corner(100.0f, 1, 1);
+			frustum.corners[4] = corner(0.1f, -1, -1);
+			frustum.corners[5] = corner(0.1f, -1, 1);
+			frustum.corners[6] = corner(0.1f, 1, -1);
+			frustum.corners[7] = corner(0.1f, 1, 1);
+
+			const auto center = glm::vec3(0, 0, -50.0f);
+			auto plane = [&](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+				auto normal = glm::normalize(glm::cross(b - a, c - a));
+				if (glm::dot(normal, center - a) < 0) normal = -normal;
+				return nex::Plane(normal, -glm::dot(normal, a));
+			};
+
+			const auto& c = frustum.corners;
+			frustum.planes[0] = plane(c[4], c[5], c[6]);
+			frustum.planes[1] = plane(c[0], c[1], c[2]);
+			frustum.planes[2] = plane(c[0], c[1], c[4]);
+			frustum.planes[3] = plane(c[2], c[3], c[6]);
+			frustum.planes[4] = plane(c[0], c[2], c[4]);
+			frustum.planes[5] = plane(c[1], c[3], c[5]);
+
+			std::mt19937 random(static_cast<unsigned>(count));
+			std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+			std::uniform_real_distribution<float> extent(0.0f, 5.0f);
+
+			for (size_t i = 0; i < count; ++i) {
+				const glm::vec3 center(position(random), position(random), position(random));
+				const glm::vec3 e(extent(random), extent(random), extent(random));
+				boxes.emplace_back(center - e, center + e);
+				batch.push(boxes.back());
+			}
+		}
+	};
+}
+
+static void BM_Culling_PerBox(benchmark::State& state)
+{
+	CullingScene scene(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state)
+	{
+		size_t visible = 0;
+		for (const auto& box : scene.boxes) visible += boxInFrustum(scene.frustum, box);
+		benchmark::DoNotOptimize(visible);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Culling_Batch(benchmark::State& state, InstructionSet set)
+{
+	if (set > nex::BatchCuller::getSupportedInstructionSet()) {
+		state.SkipWithError("instruction set not supported");
+		return;
+	}
+
+	CullingScene scene(static_cast<size_t>(state.range(0)));
+	std::vector<uint32_t> visibility(nex::BatchCuller::getMaskWordCount(scene.boxes.size()));
+
+	for (auto _ : state)
+	{
+		nex::BatchCuller::cullFrustum(scene.frustum, scene.batch, visibility.data(), set);
+		benchmark::DoNotOptimize(visibility.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Culling_PerBox)->ArgName("boxes")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Culling_Batch, scalar, InstructionSet::SCALAR)->ArgName("boxes")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Culling_Batch, sse, InstructionSet::SSE)->ArgName("boxes")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Culling_Batch, avx, InstructionSet::AVX)->ArgName("boxes")->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,157 @@
+#include <nex/renderer/MultiViewCollector.hpp>
+#include <nex/material/Material.hpp>
+#include <nex/mesh/Mesh.hpp>
+#include <nex/mesh/MeshGroup.hpp>
+#include <nex/shader/Shader.hpp>
+#include <nex/shader/ShaderProvider.hpp>
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+/**
+ * Collecting the render commands of 20k objects (2 commands each) for 9 views: the camera frustum, 4 shadow cascade
+ * frustums and 4 probe spheres. One traversal per view is compared with a single traversal for all views.
+ * The traversal visits every object and pushes its commands with culling enabled, like Vob::collectRenderCommands.
+ *
+ * The counters report the visible commands per view; 'shadowCommands' is the sum over the cascades
+ * (without per cascade culling every caster is drawn into every cascade: 4 x 40k).
+ */
+
+namespace
+{
+	constexpr size_t OBJECT_COUNT = 20000;
+	constexpr size_t CASCADE_COUNT = 4;
+	constexpr size_t PROBE_COUNT = 4;
+
+	struct Object
+	{
+		glm::mat4 trafo;
+		nex::AABB boxes[2];
+	};
+
+	struct MultiViewScene
+	{
+		nex::Shader shader; // without a shader program; only used for sorting
+		nex::Mesh mesh;
+		nex::PbrMaterial material;
+		nex::MeshBatch batch;
+		std::vector<Object> objects;
+		std::vector<nex::Frustum> frustums;
+		std::vector<nex::Sphere> spheres;
+
+		MultiViewScene() :
+			material(std::make_shared<nex::ShaderProvider>(&shader)),
+			batch(&material)
+		{
+			batch.add(&mesh, &material);
+
+			std::mt19937 random(5);
+			std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+			std::uniform_real_distribution<float> height(0.0f, 10.0f);
+
+			objects.resize(OBJECT_COUNT);
+			for (auto& object : objects) {
+				const glm::vec3 center(position(random), height(random), position(random));
+				object.trafo = glm::translate(glm::mat4(1.0f), center);
+				object.boxes[0] = nex::AABB(center - glm::vec3(1.0f, 0.0f, 1.0f), center + glm::vec3(1.0f, 6.0f, 1.0f));
+				object.boxes[1] = nex::AABB(center + glm::vec3(-3.0f, 4.0f, -3.0f), center + glm::vec3(3.0f, 10.0f, 3.0f));
+			}
+
+			// camera at the origin looking along -z
+			const auto view = glm::lookAt(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(0.0f, 5.0f, -1.0f), glm::vec3(0, 1, 0));
+			frustums.push_back(nex::extractFrustum(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f) * view));
+
+			// cascades: orthographic light frustums around the camera frustum splits
+			const float splits[CASCADE_COUNT + 1] = { 0.1f, 10.0f, 30.0f, 80.0f, 200.0f };
+			const auto lightDir = glm::normalize(glm::vec3(-1.0f, -1.0f, -0.5f));
+
+			for (size_t i = 0; i < CASCADE_COUNT; ++i) {
+				const auto center = glm::vec3(0.0f, 5.0f, -(splits[i] + splits[i + 1]) * 0.5f);
+				const float radius = (splits[i + 1] - splits[i]) * 0.5f + splits[i + 1] * 0.6f;
+				const auto lightView = glm::lookAt(center - lightDir * 400.0f, center, glm::vec3(0, 1, 0));
+				const auto lightProj = glm::ortho(-radius, radius, -radius, radius, 0.0f, 800.0f);
+				frustums.push_back(nex::extractFrustum(lightProj * lightView));
+			}
+
+			for (size_t i = 0; i < PROBE_COUNT; ++i) {
+				spheres.emplace_back(glm::vec3(-150.0f + 100.0f * i, 5.0f, -50.0f), 40.0f);
+			}
+		}
+
+		void traverse(nex::RenderCommandQueue& queue) const
+		{
+			for (const auto& object : objects) {
+				for (const auto& box : object.boxes) {
+					nex::RenderCommand command;
+					command.batch = &batch;
+					command.worldTrafo = &object.trafo;
+					command.prevWorldTrafo = &object.trafo;
+					command.boundingBox = &box;
+					queue.push(command, true);
+				}
+			}
+		}
+
+		void addViews(nex::MultiViewCollector& collector) const
+		{
+			for (const auto& frustum : frustums) collector.addView(frustum);
+			for (const auto& sphere : spheres) collector.addView(sphere);
+		}
+	};
+
+	void reportViewCounts(benchmark::State& state, const std::vector<size_t>& counts)
+	{
+		state.counters["camera"] = static_cast<double>(counts[0]);
+		size_t shadowCommands = 0;
+
+		for (size_t i = 0; i < CASCADE_COUNT; ++i) {
+			state.counters["cascade" + std::to_string(i)] = static_cast<double>(counts[1 + i]);
+			shadowCommands += counts[1 + i];
+		}
+
+		for (size_t i = 0; i < PROBE_COUNT; ++i) {
+			state.counters["probe" + std::to_string(i)] = static_cast<double>(counts[1 + CASCADE_COUNT + i]);
+		}
+
+		state.counters["shadowCommands"] = static_cast<double>(shadowCommands);
+	}
+}
+
+static void BM_MultiViewCollector_TraversalPerView(benchmark::State& state)
+{
+	MultiViewScene scene;
+	std::vector<nex::MultiViewCollector> collectors(scene.frustums.size() + scene.spheres.size());
+
+	for (size_t i = 0; i < scene.frustums.size(); ++i) collectors[i].addView(scene.frustums[i]);
+	for (size_t i = 0; i < scene.spheres.size(); ++i) collectors[scene.frustums.size() + i].addView(scene.spheres[i]);
+
+	for (auto _ : state)
+	{
+		for (auto& collector : collectors) {
+			collector.collect([&](nex::RenderCommandQueue& queue) { scene.traverse(queue); });
+		}
+	}
+
+	std::vector<size_t> counts;
+	for (const auto& collector : collectors) counts.push_back(collector.getVisibleCount(0));
+	reportViewCounts(state, counts);
+}
+
+static void BM_MultiViewCollector_SingleTraversal(benchmark::State& state)
+{
+	MultiViewScene scene;
+	nex::MultiViewCollector collector;
+	scene.addViews(collector);
+
+	for (auto _ : state)
+	{
+		collector.collect([&](nex::RenderCommandQueue& queue) { scene.traverse(queue); });
+	}
+
+	std::vector<size_t> counts;
+	for (size_t i = 0; i < collector.getViewCount(); ++i) counts.push_back(collector.getVisibleCount(i));
+	reportViewCounts(state, counts);
+}
+
+BENCHMARK(BM_MultiViewCollector_TraversalPerView)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MultiViewCollector_SingleTraversal)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,111 @@
+#include <nex/renderer/RenderCommandBuffer.hpp>
+#include <nex/renderer/RenderCommand.hpp>
+#include <nex/renderer/RenderContext.hpp>
+#include <nex/camera/Camera.hpp>
+#include <nex/material/Material.hpp>
+#include <nex/mesh/Mesh.hpp>
+#include <nex/mesh/MeshGroup.hpp>
+#include <nex/shader/ShaderProvider.hpp>
+#include <nex/util/concurrent/ThreadPool.hpp>
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+/**
+ * Recording of 20k sorted draw commands (16 transform shaders, 2 meshes per batch) into RenderCommandBuffers with
+ * 1 to N recording threads. Recording includes the per object transform calculations, the part of the submission that
+ * runs on worker threads.
+ *
+ * Note: Replay calls into the render backend and isn't measured here. The recording threads are limited by the
+ * engine's thread pool (see the poolThreads counter).
+ */
+
+namespace
+{
+	constexpr size_t COMMAND_COUNT = 20000;
+	constexpr size_t SHADER_COUNT = 16;
+	constexpr size_t BATCH_COUNT = 256;
+	constexpr size_t MESHES_PER_BATCH = 2;
+
+	struct Scene
+	{
+		// transform shaders without shader program; recording doesn't call into the render backend
+		std::vector<std::unique_ptr<nex::TransformShader>> shaders;
+		nex::Mesh meshes[MESHES_PER_BATCH];
+		std::vector<std::unique_ptr<nex::PbrMaterial>> materials;
+		std::vector<nex::MeshBatch> batches;
+		std::vector<glm::mat4> trafos;
+		std::vector<nex::RenderCommand> commands;
+		nex::PerspectiveCamera camera;
+		nex::RenderContext context;
+
+		Scene() : camera(1920.0f, 1080.0f, glm::radians(60.0f), 0.1f, 1000.0f)
+		{
+			std::mt19937 random(42);
+			std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+
+			for (size_t i = 0; i < SHADER_COUNT; ++i) {
+				shaders.emplace_back(std::make_unique<nex::TransformShader>());
+			}
+
+			batches.reserve(BATCH_COUNT);
+			for (size_t i = 0; i < BATCH_COUNT; ++i) {
+				// consecutive batches share a shader, as in a sorted command buffer
+				auto* shader = shaders[i * SHADER_COUNT / BATCH_COUNT].get();
+				materials.emplace_back(std::make_unique<nex::PbrMaterial>(std::make_shared<nex::ShaderProvider>(shader)));
+				auto* material = materials.back().get();
+
+				batches.emplace_back(material);
+				for (auto& mesh : meshes) batches.back().add(&mesh, material);
+			}
+
+			trafos.reserve(COMMAND_COUNT);
+			commands.resize(COMMAND_COUNT);
+			for (size_t i = 0; i < COMMAND_COUNT; ++i) {
+				trafos.emplace_back(glm::translate(glm::mat4(1.0f), glm::vec3(position(random), 0.0f, position(random))));
+
+				auto& command = commands[i];
+				command.batch = &batches[i * BATCH_COUNT / COMMAND_COUNT];
+				command.worldTrafo = &trafos.back();
+				command.prevWorldTrafo = &trafos.back();
+			}
+
+			camera.setPosition(glm::vec3(0.0f, 10.0f, 0.0f), true);
+			camera.lookAt(glm::vec3(0.0f, 0.0f, 100.0f));
+			camera.update();
+			context.camera = &camera;
+		}
+	};
+
+	const Scene& getScene()
+	{
+		static const Scene scene;
+		return scene;
+	}
+}
+
+static void BM_RecordCommands(benchmark::State& state)
+{
+	const auto& scene = getScene();
+	const auto maxThreads = static_cast<unsigned>(state.range(0));
+	std::vector<nex::RenderCommandBuffer> buffers;
+
+	for (auto _ : state) {
+		nex::RenderCommandBuffer::recordParallel(buffers, scene.commands, scene.context, nex::ShaderOverride<nex::Shader>(),
+			nullptr, maxThreads);
+		benchmark::ClobberMemory();
+	}
+
+	size_t operationCount = 0;
+	size_t usedBuffers = 0;
+	for (const auto& buffer : buffers) {
+		operationCount += buffer.getOperationCount();
+		if (!buffer.empty()) ++usedBuffers;
+	}
+
+	state.counters["operations"] = static_cast<double>(operationCount);
+	state.counters["slices"] = static_cast<double>(usedBuffers);
+	state.counters["poolThreads"] = nex::util::ThreadPool::get()->getThreadCount();
+}
+
+BENCHMARK(BM_RecordCommands)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
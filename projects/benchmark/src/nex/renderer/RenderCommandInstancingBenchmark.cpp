@@ -0,0 +1,90 @@
+#include <nex/renderer/RenderCommandQueue.hpp>
+#include <nex/material/Material.hpp>
+#include <nex/mesh/Mesh.hpp>
+#include <nex/mesh/MeshGroup.hpp>
+#include <nex/shader/Shader.hpp>
+#include <nex/shader/ShaderProvider.hpp>
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+/**
+ * A forest of 10k vobs created from 4 blue prints (2 meshes per batch) with 8 per object material ids, pushed into a
+ * RenderCommandQueue and sorted with and without instancing.
+ *
+ * The counters report the resulting draw commands (one per-object/instance buffer upload each) and mesh draw calls.
+ * Note: The GPU side submit time needs a render backend and isn't measured here.
+ */
+
+namespace
+{
+	constexpr size_t VOB_COUNT = 10000;
+	constexpr size_t BLUE_PRINT_COUNT = 4;
+	constexpr size_t MESHES_PER_BATCH = 2;
+	constexpr unsigned MATERIAL_ID_COUNT = 8;
+
+	struct Forest
+	{
+		nex::Shader shader; // without a shader program; only used for sorting
+		nex::Mesh meshes[MESHES_PER_BATCH];
+		std::vector<std::unique_ptr<nex::PbrMaterial>> materials;
+		std::vector<nex::MeshBatch> batches;
+		std::vector<glm::mat4> trafos;
+		std::vector<nex::AABB> boxes;
+		std::vector<nex::RenderCommand> commands;
+
+		Forest()
+		{
+			std::mt19937 random(42);
+			std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+
+			batches.reserve(BLUE_PRINT_COUNT);
+			for (size_t i = 0; i < BLUE_PRINT_COUNT; ++i) {
+				materials.emplace_back(std::make_unique<nex::PbrMaterial>(std::make_shared<nex::ShaderProvider>(&shader)));
+				batches.emplace_back(materials.back().get());
+				for (auto& mesh : meshes) batches.back().add(&mesh, materials.back().get());
+			}
+
+			trafos.reserve(VOB_COUNT);
+			boxes.reserve(VOB_COUNT);
+
+			for (size_t i = 0; i < VOB_COUNT; ++i) {
+				const glm::vec3 center(position(random), 0.0f, position(random));
+				trafos.emplace_back(glm::translate(glm::mat4(1.0f), center));
+				boxes.emplace_back(center - glm::vec3(1.0f, 0.0f, 1.0f), center + glm::vec3(1.0f, 8.0f, 1.0f));
+
+				nex::RenderCommand command;
+				command.batch = &batches[random() % BLUE_PRINT_COUNT];
+				command.worldTrafo = &trafos.back();
+				command.prevWorldTrafo = &trafos.back();
+				command.boundingBox = &boxes.back();
+				command.perObjectMaterialID = random() % MATERIAL_ID_COUNT;
+				commands.emplace_back(command);
+			}
+		}
+	};
+}
+
+static void BM_RenderCommandQueue_Forest(benchmark::State& state)
+{
+	Forest forest;
+	nex::RenderCommandQueue queue;
+	queue.useSphereCulling(glm::vec3(0.0f), 1000.0f);
+	queue.useInstancing(state.range(0) != 0);
+
+	for (auto _ : state)
+	{
+		queue.clear();
+		for (const auto& command : forest.commands) queue.push(command);
+		queue.sort();
+		benchmark::DoNotOptimize(queue.getDeferrablePbrCommands().data());
+	}
+
+	size_t meshDrawCalls = 0;
+	for (const auto& command : queue.getDeferrablePbrCommands()) meshDrawCalls += command.batch->getEntries().size();
+
+	state.counters["commands"] = static_cast<double>(queue.getDeferrablePbrCommands().size());
+	state.counters["meshDrawCalls"] = static_cast<double>(meshDrawCalls);
+}
+
+BENCHMARK(BM_RenderCommandQueue_Forest)->ArgName("instancing")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,211 @@
+#include <nex/renderer/RenderCommandQueue.hpp>
+#include <nex/material/Material.hpp>
+#include <nex/mesh/Mesh.hpp>
+#include <nex/mesh/MeshGroup.hpp>
+#include <nex/shader/Shader.hpp>
+#include <nex/shader/ShaderProvider.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+
+/**
+ * Sorting 50k render commands (64 shaders, 600 materials, 3000 mesh batches, 5% bone animated):
+ * RenderCommandQueue::sort (sort keys computed on push, radix sort) compared with the comparator sorts the queue used
+ * before (opaque: by shader pointer, then batch pointer; transparent: by distance). Both variants include pushing the
+ * commands; the opaque variants sort the deferred pbr and the shadow buffer.
+ *
+ * The counters report the state changes Drawer::drawCommand does for the sorted order: shader binds and material
+ * changes for the deferred pbr pass (batch shaders) and shader binds for the shadow pass (shader overrides).
+ */
+
+namespace
+{
+	constexpr size_t COMMAND_COUNT = 50000;
+	constexpr size_t SHADER_COUNT = 64;
+	constexpr size_t MATERIAL_COUNT = 600;
+	constexpr size_t BATCH_COUNT = 3000;
+
+	/**
+	 * Shaders without a shader program; they are only used for sorting and never bound.
+	 */
+	struct FakeShaders
+	{
+		std::vector<nex::Shader> storage = std::vector<nex::Shader>(SHADER_COUNT + 2);
+
+		nex::Shader* get(size_t index)
+		{
+			return &storage[index];
+		}
+
+		nex::Shader* getDefaultOverride() { return get(SHADER_COUNT); }
+		nex::Shader* getRiggedOverride() { return get(SHADER_COUNT + 1); }
+	};
+
+	struct SortScene
+	{
+		FakeShaders shaders;
+		nex::Mesh mesh;
+		std::vector<std::unique_ptr<nex::PbrMaterial>> materials;
+		std::vector<nex::MeshBatch> batches;
+		std::vector<nex::AABB> boxes;
+		std::vector<nex::RenderCommand> commands;
+
+		explicit SortScene(bool transparent)
+		{
+			std::mt19937 random(42);
+			std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+			for (size_t i = 0; i < MATERIAL_COUNT; ++i) {
+				auto provider = std::make_shared<nex::ShaderProvider>(shaders.get(random() % SHADER_COUNT));
+				materials.emplace_back(std::make_unique<nex::PbrMaterial>(std::move(provider)));
+				materials.back()->getRenderState().doBlend = transparent;
+			}
+
+			batches.reserve(BATCH_COUNT);
+			for (size_t i = 0; i < BATCH_COUNT; ++i) {
+				auto* material = materials[random() % MATERIAL_COUNT].get();
+				batches.emplace_back(material);
+				batches.back().add(&mesh, material);
+			}
+
+			boxes.reserve(COMMAND_COUNT);
+			for (size_t i = 0; i < COMMAND_COUNT; ++i) {
+				const glm::vec3 center(position(random), position(random), position(random));
+				boxes.emplace_back(center - glm::vec3(1.0f), center + glm::vec3(1.0f));
+
+				nex::RenderCommand command;
+				command.batch = &batches[random() % BATCH_COUNT];
+				command.boundingBox = &boxes.back();
+				command.isBoneAnimated = random() % 20 == 0;
+				commands.emplace_back(command);
+			}
+		}
+	};
+
+	bool defaultCompare(const nex::RenderCommand& a, const nex::RenderCommand& b)
+	{
+		auto* aShader = a.batch->getShader();
+		auto* bShader = b.batch->getShader();
+		if (aShader != bShader) return aShader < bShader;
+		return a.batch < b.batch;
+	}
+
+	void countStateChanges(benchmark::State& state, const nex::RenderCommandQueue::Buffer& pbr,
+		const nex::RenderCommandQueue::Buffer& shadow, FakeShaders& shaders)
+	{
+		size_t shaderBinds = 0;
+		size_t materialChanges = 0;
+		const nex::Shader* lastShader = nullptr;
+		const nex::Material* lastMaterial = nullptr;
+
+		for (const auto& command : pbr) {
+			if (command.batch->getShader() != lastShader) ++shaderBinds;
+			if (command.batch->getReferenceMaterial() != lastMaterial) ++materialChanges;
+			lastShader = command.batch->getShader();
+			lastMaterial = command.batch->getReferenceMaterial();
+		}
+
+		size_t shadowShaderBinds = 0;
+		lastShader = nullptr;
+
+		for (const auto& command : shadow) {
+			auto* shader = command.isBoneAnimated ? shaders.getRiggedOverride() : shaders.getDefaultOverride();
+			if (shader != lastShader) ++shadowShaderBinds;
+			lastShader = shader;
+		}
+
+		state.counters["shaderBinds"] = static_cast<double>(shaderBinds);
+		state.counters["materialChanges"] = static_cast<double>(materialChanges);
+		state.counters["shadowShaderBinds"] = static_cast<double>(shadowShaderBinds);
+	}
+}
+
+static void BM_RenderCommandSort_Comparator(benchmark::State& state)
+{
+	SortScene scene(false);
+	nex::RenderCommandQueue queue;
+	queue.useSphereCulling(glm::vec3(0.0f), 1000.0f);
+
+	for (auto _ : state)
+	{
+		queue.clear();
+		for (const auto& command : scene.commands) queue.push(command);
+		std::sort(queue.getDeferrablePbrCommands().begin(), queue.getDeferrablePbrCommands().end(), defaultCompare);
+		std::sort(queue.getShadowCommands().begin(), queue.getShadowCommands().end(), defaultCompare);
+		benchmark::DoNotOptimize(queue.getDeferrablePbrCommands().data());
+	}
+
+	countStateChanges(state, queue.getDeferrablePbrCommands(), queue.getShadowCommands(), scene.shaders);
+}
+
+static void BM_RenderCommandSort_Queue(benchmark::State& state)
+{
+	SortScene scene(false);
+	nex::RenderCommandQueue queue;
+	queue.useSphereCulling(glm::vec3(0.0f), 1000.0f);
+
+	for (auto _ : state)
+	{
+		queue.clear();
+		for (const auto& command : scene.commands) queue.push(command);
+		queue.sort();
+		benchmark::DoNotOptimize(queue.getDeferrablePbrCommands().data());
+	}
+
+	countStateChanges(state, queue.getDeferrablePbrCommands(), queue.getShadowCommands(), scene.shaders);
+}
+
+static void BM_RenderCommandSort_TransparentComparator(benchmark::State& state)
+{
+	SortScene scene(true);
+	nex::RenderCommandQueue queue;
+	queue.useSphereCulling(glm::vec3(0.0f), 1000.0f);
+	const glm::vec3 cullPosition(0.0f);
+
+	// the distance metric of the old transparentCompare
+	auto getDistance = [&](const nex::RenderCommand& c) {
+		float minDistance = std::numeric_limits<float>::max();
+		const auto& min = c.boundingBox->min;
+		const auto& max = c.boundingBox->max;
+		const glm::vec3 corners[8] = {
+			min, glm::vec3(min.x, min.y, max.z), glm::vec3(min.x, max.y, min.z), glm::vec3(min.x, max.y, max.z),
+			glm::vec3(max.x, min.y, min.z), glm::vec3(max.x, min.y, max.z), glm::vec3(max.x, max.y, min.z), max
+		};
+		for (const auto& corner : corners) {
+			const auto diff = cullPosition - corner;
+			minDistance = std::min<float>(minDistance, diff.x + diff.y + diff.z);
+		}
+		return minDistance;
+	};
+
+	for (auto _ : state)
+	{
+		queue.clear();
+		for (const auto& command : scene.commands) queue.push(command);
+		auto& buffer = queue.getTransparentCommands();
+		std::sort(buffer.begin(), buffer.end(), [&](const auto& a, const auto& b) {
+			return getDistance(a) > getDistance(b);
+		});
+		benchmark::DoNotOptimize(buffer.data());
+	}
+}
+
+static void BM_RenderCommandSort_TransparentQueue(benchmark::State& state)
+{
+	SortScene scene(true);
+	nex::RenderCommandQueue queue;
+	queue.useSphereCulling(glm::vec3(0.0f), 1000.0f);
+
+	for (auto _ : state)
+	{
+		queue.clear();
+		for (const auto& command : scene.commands) queue.push(command);
+		queue.sort();
+		benchmark::DoNotOptimize(queue.getTransparentCommands().data());
+	}
+}
+
+BENCHMARK(BM_RenderCommandSort_Comparator)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RenderCommandSort_Queue)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RenderCommandSort_TransparentComparator)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RenderCommandSort_TransparentQueue)->Unit(benchmark::kMillisecond);
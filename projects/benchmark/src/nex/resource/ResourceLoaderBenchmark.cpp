@@ -0,0 +1,117 @@
+#include <BenchmarkEnvironment.hpp>
+#include <nex/resource/ResourceLoader.hpp>
+#include <nex/resource/FileSystem.hpp>
+#include <nex/texture/Image.hpp>
+#include <nex/texture/TextureManager.hpp>
+#include <benchmark/benchmark.h>
+#include <thread>
+
+/**
+ * Load scaling of the resource loader: A batch of compiled textures is loaded with a varying number of workers.
+ *  - serial mode: Each texture is loaded by one RenderContext job (read + decode + upload), as all loads did before.
+ *  - split mode: The cpu stage (read + decode) runs as an Any job, only the upload is continued on the render context worker.
+ * The serial mode can't profit from additional workers, the split mode should scale until the upload dominates.
+ */
+
+namespace
+{
+	constexpr unsigned TEXTURE_COUNT = 32;
+	constexpr unsigned TEXTURE_SIZE = 512;
+
+	std::filesystem::path getTextureName(unsigned index)
+	{
+		return "benchmark_texture_" + std::to_string(index) + ".png";
+	}
+
+	/**
+	 * Creates a temporary resource directory with compiled textures and initializes the texture manager with it.
+	 */
+	class TextureDirectory
+	{
+	public:
+		TextureDirectory() : mRoot(std::filesystem::temp_directory_path() / "EngineBenchmark")
+		{
+			const auto resources = mRoot / "resources";
+			const auto compiled = mRoot / "compiled";
+			std::filesystem::create_directories(resources);
+			std::filesystem::create_directories(compiled);
+
+			auto* textureManager = nex::TextureManager::get();
+			textureManager->init(resources, compiled, ".CTEX", ".META", ".EMBEDDED");
+
+			for (unsigned i = 0; i < TEXTURE_COUNT; ++i)
+			{
+				nex::StoreImage image;
+				nex::StoreImage::create(&image, 1, 1, nex::TextureTarget::TEXTURE2D, glm::uvec2(1));
+				auto& genericImage = image.images[0][0];
+				genericImage.desc.width = TEXTURE_SIZE;
+				genericImage.desc.height = TEXTURE_SIZE;
+				genericImage.desc.colorspace = nex::ColorSpace::RGBA;
+				genericImage.desc.pixelDataType = nex::PixelDataType::UBYTE;
+				genericImage.pixels = std::vector<char>(TEXTURE_SIZE * TEXTURE_SIZE * 4, static_cast<char>(i));
+
+				nex::FileSystem::store(textureManager->getFileSystem()->getCompiledPath(getTextureName(i)).path, image,
+					nex::FileSystem::CompiledType::TEXTURE);
+			}
+		}
+
+		~TextureDirectory()
+		{
+			std::error_code error;
+			std::filesystem::remove_all(mRoot, error);
+		}
+
+	private:
+		std::filesystem::path mRoot;
+	};
+}
+
+static void BM_ResourceLoader_TextureLoadScaling(benchmark::State& state)
+{
+	const auto workerCount = static_cast<unsigned>(state.range(0));
+	const bool splitStages = state.range(1) != 0;
+
+	TextureDirectory directory;
+	auto* textureManager = nex::TextureManager::get();
+	nex::ResourceLoader loader(nex::BenchmarkEnvironment::getWindow(), nex::RenderEngine(), workerCount);
+
+	for (auto _ : state)
+	{
+		for (unsigned i = 0; i < TEXTURE_COUNT; ++i)
+		{
+			const auto name = getTextureName(i);
+
+			if (splitStages)
+			{
+				loader.enqueue<void>([=]() {
+					textureManager->prefetchImage(name);
+				}, nex::ResourceLoader::JobPriority::Normal, nex::ResourceLoader::JobAffinity::Any)
+				.then(loader.getExecutor(nex::ResourceLoader::JobPriority::Normal, nex::ResourceLoader::JobAffinity::RenderContext), 
+					[=](nex::Future<void>) {
+					return textureManager->getImage(name);
+				});
+			}
+			else
+			{
+				loader.enqueue<nex::Texture2D*>([=]() {
+					return textureManager->getImage(name);
+				});
+			}
+		}
+
+		loader.waitTillAllJobsFinished();
+
+		state.PauseTiming();
+		textureManager->release();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * TEXTURE_COUNT);
+	state.SetBytesProcessed(state.iterations() * TEXTURE_COUNT * TEXTURE_SIZE * TEXTURE_SIZE * 4);
+}
+
+BENCHMARK(BM_ResourceLoader_TextureLoadScaling)
+	->ArgNames({"workers", "split"})
+	->ArgsProduct({ {1, 2, 4, 8}, {0, 1} })
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
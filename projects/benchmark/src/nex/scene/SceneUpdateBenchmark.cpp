@@ -0,0 +1,78 @@
+#include <nex/scene/Scene.hpp>
+#include <nex/util/concurrent/ThreadPool.hpp>
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+/**
+ * Scaling of Scene::frameUpdate with the number of update threads: 1000 vob trees (10 vobs each) with a fixed amount
+ * of per vob work, comparable to evaluating a small key frame animation.
+ * A thread count of 1 is the serial update; higher counts are limited by the threads of the engine thread pool.
+ */
+
+namespace
+{
+	constexpr int TREE_COUNT = 1000;
+	constexpr int CHILD_COUNT = 9;
+	constexpr int CHANNEL_COUNT = 16;
+
+	/**
+	 * A vob that only updates its own animation trafos; parallel update safe.
+	 */
+	class AnimatedVob : public nex::Vob
+	{
+	public:
+
+		void frameUpdate(const nex::RenderContext& constants) override
+		{
+			mTime += constants.frameTime;
+
+			for (int i = 0; i < CHANNEL_COUNT; ++i) {
+				const auto angle = mTime + static_cast<float>(i);
+				const auto rotation = glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f));
+				mChannelTrafos[i] = glm::translate(glm::mat4(1.0f), glm::vec3(angle)) * glm::toMat4(rotation);
+			}
+
+			setPositionLocalToParent(glm::vec3(mChannelTrafos[0][3]));
+		}
+
+		bool isParallelUpdateSafe() const override
+		{
+			return true;
+		}
+
+	private:
+		float mTime = 0.0f;
+		glm::mat4 mChannelTrafos[CHANNEL_COUNT];
+	};
+}
+
+static void BM_Scene_FrameUpdate(benchmark::State& state)
+{
+	const auto threadCount = static_cast<unsigned>(state.range(0));
+
+	nex::Scene scene;
+	scene.setMaxUpdateThreads(threadCount);
+
+	for (int i = 0; i < TREE_COUNT; ++i) {
+		std::unique_ptr<nex::Vob> root = std::make_unique<AnimatedVob>();
+		for (int j = 0; j < CHILD_COUNT; ++j) root->addChild(std::unique_ptr<nex::Vob>(std::make_unique<AnimatedVob>()));
+		scene.addVobUnsafe(std::move(root));
+	}
+
+	nex::RenderContext context;
+	context.frameTime = 1.0f / 60.0f;
+
+	for (auto _ : state)
+	{
+		scene.frameUpdate(context);
+	}
+
+	state.counters["poolThreads"] = nex::util::ThreadPool::get()->getThreadCount();
+	state.SetItemsProcessed(state.iterations() * TREE_COUNT * (CHILD_COUNT + 1));
+}
+
+BENCHMARK(BM_Scene_FrameUpdate)
+	->ArgName("threads")
+	->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
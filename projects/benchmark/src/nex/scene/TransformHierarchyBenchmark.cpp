@@ -0,0 +1,119 @@
+#include <nex/scene/TransformHierarchy.hpp>
+#include <nex/scene/Vob.hpp>
+#include <benchmark/benchmark.h>
+#include <glm/gtc/quaternion.hpp>
+#include <random>
+
+/**
+ * Scene transformation update for 100k vobs (2500 trees with 40 nodes each, depth 4) and a varying share of moving vobs.
+ * Compares the transform hierarchy (dirty nodes and their descendants only) with the recursive Vob::updateTrafo
+ * that updates every vob in every frame.
+ */
+
+namespace
+{
+	constexpr int TREE_COUNT = 2500;
+	constexpr int TREE_DEPTH = 3; // 1 + 3 + 9 + 27 = 40 nodes
+	constexpr int CHILD_COUNT = 3;
+
+	struct Forest
+	{
+		std::vector<std::unique_ptr<nex::Vob>> roots;
+		std::vector<nex::Vob*> rootPtrs;
+		std::vector<nex::Vob*> vobs;
+		std::mt19937 random{ 42 };
+
+		Forest()
+		{
+			for (int i = 0; i < TREE_COUNT; ++i) {
+				roots.emplace_back(createTree(TREE_DEPTH));
+				rootPtrs.push_back(roots.back().get());
+			}
+		}
+
+		float next()
+		{
+			return std::uniform_real_distribution<float>(-10.0f, 10.0f)(random);
+		}
+
+		glm::vec3 nextPosition()
+		{
+			return glm::vec3(next(), next(), next());
+		}
+
+		std::unique_ptr<nex::Vob> createTree(int depth)
+		{
+			auto vob = std::make_unique<nex::Vob>();
+			vobs.push_back(vob.get());
+			vob->setPositionLocalToParent(nextPosition());
+			vob->setRotationLocalToParent(glm::normalize(glm::quat(next(), next(), next(), next())));
+
+			if (depth > 0) {
+				for (int i = 0; i < CHILD_COUNT; ++i) vob->addChild(createTree(depth - 1));
+			}
+
+			return vob;
+		}
+
+		/**
+		 * Moves a share of the vobs; a share of 1 moves all of them.
+		 */
+		void move(double share)
+		{
+			const auto count = static_cast<size_t>(share * vobs.size());
+			const bool all = count == vobs.size();
+
+			for (size_t i = 0; i < count; ++i) {
+				auto* vob = all ? vobs[i] : vobs[random() % vobs.size()];
+				vob->setPositionLocalToParent(nextPosition());
+			}
+		}
+	};
+
+	double getShare(const benchmark::State& state)
+	{
+		return static_cast<double>(state.range(0)) / 100.0;
+	}
+}
+
+static void BM_TransformHierarchy_Update(benchmark::State& state)
+{
+	Forest forest;
+	nex::TransformHierarchy hierarchy;
+	hierarchy.update(forest.rootPtrs);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		forest.move(getShare(state));
+		state.ResumeTiming();
+
+		hierarchy.update(forest.rootPtrs);
+	}
+
+	state.counters["updated"] = static_cast<double>(hierarchy.getStats().updatedCount);
+}
+
+BENCHMARK(BM_TransformHierarchy_Update)
+	->ArgName("moving%")
+	->Arg(0)->Arg(1)->Arg(10)->Arg(100)
+	->Unit(benchmark::kMillisecond);
+
+static void BM_Vob_RecursiveUpdateTrafo(benchmark::State& state)
+{
+	Forest forest;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		forest.move(getShare(state));
+		state.ResumeTiming();
+
+		for (auto* root : forest.rootPtrs) root->updateTrafo();
+	}
+}
+
+BENCHMARK(BM_Vob_RecursiveUpdateTrafo)
+	->ArgName("moving%")
+	->Arg(0)->Arg(1)->Arg(10)->Arg(100)
+	->Unit(benchmark::kMillisecond);
@@ -138,7 +138,7 @@ void nex::ProbeFactory::init(const std::filesystem::path & compiledResourceDirec
 	// we use the sprite only as a polygon model
 	brdfSprite.setTexture(nullptr);
 
-	if (std::filesystem::exists(brdfMapPath))
+	if (FileSystem::fileExists(brdfMapPath))
 	{
 		StoreImage readImage;
 		FileSystem::load(brdfMapPath, readImage);
@@ -149,7 +149,7 @@ void nex::ProbeFactory::init(const std::filesystem::path & compiledResourceDirec
 	{
 		mBrdfLookupTexture = createBRDFlookupTexture(&brdfPrecomputePass);
 		const StoreImage brdfLUTImage = StoreImage::create(mBrdfLookupTexture.get(), PixelDataType::FLOAT);
-		FileSystem::store(brdfMapPath, brdfLUTImage);
+		FileSystem::store(brdfMapPath, brdfLUTImage, FileSystem::CompiledType::PROBE);
 	}
 
 	mSamplerIrradiance = std::make_unique<Sampler>();
@@ -349,7 +349,7 @@ bool nex::ProbeFactory::isProbeStored(const Probe& probe) const
 
 	auto fileName = STORE_FILE_BASE_SOURCE + std::to_string(storeID) + std::string(ProbeFactory::STORE_FILE_EXTENSION);
 	auto resolvedPath = mFileSystem->resolvePath(fileName, "./",true);
-	return std::filesystem::exists(resolvedPath);
+	return FileSystem::fileExists(resolvedPath);
 }
 
 Probe::Probe(Type type, const glm::vec3& position, std::optional<Texture*> source, unsigned storeID) :
@@ -644,7 +644,7 @@ StoreImage nex::ProbeFactory::loadCubeMap(const std::filesystem::path & probeRoo
 
 	StoreImage readImage;
 
-	if (std::filesystem::exists(storeFile) && useCache && validStoreID)
+	if (FileSystem::fileExists(storeFile) && useCache && validStoreID)
 	{
 		FileSystem::load(storeFile, readImage);
 	}
@@ -654,7 +654,7 @@ StoreImage nex::ProbeFactory::loadCubeMap(const std::filesystem::path & probeRoo
 		readImage = StoreImage::create(texture.get(), PixelDataType::FLOAT);
 
 		if (storeRenderedResult && validStoreID) {
-			FileSystem::store(storeFile, readImage);
+			FileSystem::store(storeFile, readImage, FileSystem::CompiledType::PROBE);
 		}
 	}
 
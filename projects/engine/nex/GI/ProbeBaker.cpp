@@ -13,7 +13,9 @@
 #include <nex/GI/Probe.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <nex/renderer/RenderCommandQueue.hpp>
+#include <nex/renderer/MultiViewCollector.hpp>
 #include <list>
+#include <unordered_map>
 #include <nex/scene/Vob.hpp>
 
 class nex::ProbeBaker::ProbeBakePass : public PbrGeometryShader
@@ -221,6 +223,22 @@ void nex::ProbeBaker::bakeProbes(Scene& scene, const DirLight& light, ProbeFacto
 
 	auto lock = scene.acquireLock();
 
+	// Collect the commands of all probes to render with a single scene traversal
+	MultiViewCollector collector;
+	std::unordered_map<const ProbeVob*, size_t> probeViews;
+
+	for (auto* probeVob : scene.getActiveProbeVobsUnsafe()) {
+		const auto& probe = *probeVob->getProbe();
+		if (probe.isInitialized() || factory.isProbeStored(probe) || probe.getSource()) continue;
+		probeViews[probeVob] = collector.addView(Sphere(probe.getPosition(), camera.getFarDistance()));
+	}
+
+	if (!probeViews.empty()) {
+		collector.collect([&](RenderCommandQueue& queue) {
+			collectBakeCommands(queue, scene, true);
+		});
+	}
+
 	for (auto* probeVob : scene.getActiveProbeVobsUnsafe()) { //const auto& spatial : mProbeSpatials
 
 		auto& probe = *probeVob->getProbe();
@@ -239,7 +257,7 @@ void nex::ProbeBaker::bakeProbes(Scene& scene, const DirLight& light, ProbeFacto
 		else {
 			RenderCommandQueue commandQueue;
 			commandQueue.useSphereCulling(position, camera.getFarDistance());
-			collectBakeCommands(commandQueue, scene, false);
+			collector.fillQueue(probeViews[probeVob], commandQueue);
 			commandQueue.getProbeCommands().clear();
 			commandQueue.getToolCommands().clear();
 			commandQueue.sort();
@@ -1,4 +1,5 @@
 ﻿#include <nex/GI/ProbeSelector.hpp>
+#include <cstring>
 
 nex::ProbeSelector::Selector* nex::ProbeSelector::getSelector(ProbeSelectionAlgorithm alg)
 {
@@ -23,20 +24,14 @@ nex::ProbeSelector::Selection nex::ProbeSelector::selectNearest(const Vob* vob,
 	Selection selection;
 
 	const auto& vobPos = vob->getPositionLocalToWorld();
-	float selectedDistanceSquared = std::numeric_limits<float>::infinity();
 
-	for (auto* probeVob : scene.getActiveProbeVobsUnsafe()) {
+	std::vector<ProbeVob*> probeVobs;
+	scene.queryNearestProbesUnsafe(vobPos, 1, [=](const ProbeVob* probeVob) {
+		return probeVob->getProbe()->getType() == type;
+	}, probeVobs);
 
-		auto* probe = probeVob->getProbe();
-		if (probe->getType() != type) continue;
-
-		auto diff = vobPos - probeVob->getPositionLocalToWorld();
-
-		auto currentDistSquared = glm::dot(diff, diff);
-		if (currentDistSquared < selectedDistanceSquared) {
-			selectedDistanceSquared = currentDistSquared;
-			selection.probes[0] = probe;
-		}
+	if (!probeVobs.empty()) {
+		selection.probes[0] = probeVobs[0]->getProbe();
 	}
 
 	if (selection.probes[0]) {
@@ -66,24 +61,12 @@ nex::ProbeSelector::Selection nex::ProbeSelector::selectFourNearest(const Vob* v
 	}
 
 	const auto& vobPos = vob->getPositionLocalToWorld();
-	auto probeVobs = scene.getActiveProbeVobsUnsafe();
-
-	// TODO: very slow -> use spatial acceleration data structure (tetrahedilization) 
 
-	// delete not needed probe vobs
-	auto it = std::remove_if(probeVobs.begin(), probeVobs.end(), [=](const ProbeVob* a) {
-		return a->getProbe()->getType() != type;
-	});
-	probeVobs.erase(it, probeVobs.end());
-
-	// sort by distance
-	std::sort(probeVobs.begin(), probeVobs.end(), [=](const ProbeVob* a, const ProbeVob* b) {
-
-		auto diffA = vobPos - a->getPositionLocalToWorld();
-		auto diffB = vobPos - b->getPositionLocalToWorld();
-
-		return dot(diffA, diffA) < dot(diffB, diffB);
-	});
+	// the k nearest probe vobs, sorted by distance
+	std::vector<ProbeVob*> probeVobs;
+	scene.queryNearestProbesUnsafe(vobPos, k, [=](const ProbeVob* probeVob) {
+		return probeVob->getProbe()->getType() == type;
+	}, probeVobs);
 
 	//collect probes and distances
 	for (auto* probeVob : probeVobs) {
@@ -157,14 +140,15 @@ void nex::ProbeSelector::assignProbes(const Scene& scene, Selector* selector, Pr
 	for (auto* vob : scene.getActiveVobsUnsafe()) {
 
 		if (!vob->usesPerObjectMaterialData()) continue;
-		auto& perObjectMaterialData = vob->getPerObjectMaterialData();
-		if (!perObjectMaterialData.probesUsed) continue;
+		const auto& current = static_cast<const Vob*>(vob)->getPerObjectMaterialData();
+		if (!current.probesUsed) continue;
 
 		const auto selection = selector(vob, scene, type);
 		if (!selection.count) continue;
 
 		const auto* probe = selection.probes[0];
 		const auto& index = probe->getArrayIndex();
+		auto perObjectMaterialData = current;
 
 		switch (type) {
 		case Probe::Type::Irradiance:
@@ -184,6 +168,11 @@ void nex::ProbeSelector::assignProbes(const Scene& scene, Selector* selector, Pr
 
 			break;
 		}
+
+		// Only changed material data has to be uploaded
+		if (memcmp(&perObjectMaterialData, &current, sizeof(PerObjectMaterialData)) != 0) {
+			vob->setPerObjectMaterialData(perObjectMaterialData);
+		}
 	}
 }
 
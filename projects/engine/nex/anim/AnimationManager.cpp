@@ -15,6 +15,7 @@ nex::AnimationManager::~AnimationManager() = default;
 
 void nex::AnimationManager::add(std::unique_ptr<Rig> rig)
 {
+	std::lock_guard<std::recursive_mutex> lock(mRigMutex);
 	auto* rigPtr = rig.get();
 	const auto& strID = rig->getID();
 	auto result = mRigs.insert(std::pair<unsigned, std::unique_ptr<Rig>>(SID(strID), std::move(rig)));
@@ -24,10 +25,12 @@ void nex::AnimationManager::add(std::unique_ptr<Rig> rig)
 	}
 
 	//create a new entry for linking bone animations to the rig
+	std::unique_lock<std::shared_mutex> boneAnimationLock(mBoneAnimationMutex);
 	mRigToBoneAnimations.insert({ rigPtr, {} });
 }
 
 const nex::Rig* nex::AnimationManager::load(const nex::ImportScene& importScene) {
+	std::lock_guard<std::recursive_mutex> lock(mRigMutex);
 
 	//get rig candidates
 	auto* root = importScene.getFirstRootBone();
@@ -46,7 +49,7 @@ const nex::Rig* nex::AnimationManager::load(const nex::ImportScene& importScene)
 
 
 		auto path = mRigFileSystem->getCompiledPath(rigID).path;
-		FileSystem::store(path, *rig);
+		FileSystem::store(path, *rig, FileSystem::CompiledType::RIG);
 	}
 
 	return rig;
@@ -54,6 +57,7 @@ const nex::Rig* nex::AnimationManager::load(const nex::ImportScene& importScene)
 
 const nex::Rig* nex::AnimationManager::load(const std::string& rigID)
 {
+	std::lock_guard<std::recursive_mutex> lock(mRigMutex);
 	auto* rig = getBySID(SID(rigID));
 	if (!rig) {
 		rig = loadRigFromCompiled(rigID);
@@ -63,6 +67,7 @@ const nex::Rig* nex::AnimationManager::load(const std::string& rigID)
 
 const nex::Rig* nex::AnimationManager::load(const ImportScene& importScene, const aiNode* root)
 {
+	std::lock_guard<std::recursive_mutex> lock(mRigMutex);
 	const std::string rigID = root->mName.C_Str();
 	const auto sid = SID(rigID);
 
@@ -76,7 +81,7 @@ const nex::Rig* nex::AnimationManager::load(const ImportScene& importScene, cons
 
 
 		auto path = mRigFileSystem->getCompiledPath(rigID).path;
-		FileSystem::store(path, *rig);
+		FileSystem::store(path, *rig, FileSystem::CompiledType::RIG);
 	}
 
 	return rig;
@@ -84,6 +89,7 @@ const nex::Rig* nex::AnimationManager::load(const ImportScene& importScene, cons
 
 const nex::Rig* nex::AnimationManager::loadRigFromCompiled(const std::string& rigID)
 {
+	std::lock_guard<std::recursive_mutex> lock(mRigMutex);
 	//check if rig is already loaded
 	auto sid = SID(rigID);
 	auto* storedRig = getBySID(sid);
@@ -177,6 +183,7 @@ unsigned nex::AnimationManager::getKeyFrameAniIndex(const aiAnimation* aiKeyFram
 
 const nex::Rig* nex::AnimationManager::getBySID(unsigned sid) const
 {
+	std::lock_guard<std::recursive_mutex> lock(mRigMutex);
 	auto it = mRigs.find(sid);
 
 	if (it != mRigs.end())
@@ -196,7 +203,7 @@ std::vector<const nex::BoneAnimation*> nex::AnimationManager::loadBoneAnimations
 
 	std::vector<std::unique_ptr<BoneAnimation>> boneAnis;
 
-	if (!std::filesystem::exists(compiledPath))
+	if (!FileSystem::fileExists(compiledPath))
 	{
 		auto importScene = nex::ImportScene::read(resolvedPath, false);
 		if (!importScene.hasBoneAnimations()) {
@@ -228,6 +235,7 @@ std::vector<const nex::BoneAnimation*> nex::AnimationManager::loadBoneAnimations
 
 	// add loaded anis to the manager
 	std::vector<const BoneAnimation*> result;
+	std::unique_lock<std::shared_mutex> lock(mBoneAnimationMutex);
 
 	while (!boneAnis.empty()) {
 
@@ -243,6 +251,7 @@ std::vector<const nex::BoneAnimation*> nex::AnimationManager::loadBoneAnimations
 			auto* oldAniPtr = it->second.get();
 			mRigToBoneAnimations[oldAniPtr->getRig()].erase(oldAniPtr);
 
+			mReplacedBoneAnimations.emplace_back(std::move(it->second));
 			it->second = std::move(ani);
 			mSidToBoneAnimation[sid] = aniPtr;
 			mRigToBoneAnimations[aniPtr->getRig()].insert(aniPtr);
@@ -270,7 +279,7 @@ std::vector<std::unique_ptr<nex::KeyFrameAnimation>> nex::AnimationManager::load
 
 	std::vector<std::unique_ptr<KeyFrameAnimation>> keyFrameAnis;
 
-	if (!std::filesystem::exists(compiledPath))
+	if (!FileSystem::fileExists(compiledPath))
 	{
 		auto importScene = nex::ImportScene::read(resolvedPath, false);
 		if (!importScene.hasBoneAnimations()) {
@@ -302,14 +311,16 @@ std::vector<std::unique_ptr<nex::KeyFrameAnimation>> nex::AnimationManager::load
 
 const nex::BoneAnimation* nex::AnimationManager::getBoneAnimation(unsigned sid)
 {
+	std::shared_lock<std::shared_mutex> lock(mBoneAnimationMutex);
 	auto it = mSidToBoneAnimation.find(sid);
 	if (it == mSidToBoneAnimation.end()) return nullptr;
 
 	return it->second;
 }
 
-const std::set<const nex::BoneAnimation*>& nex::AnimationManager::getBoneAnimationsByRig(const Rig* rig)
+std::set<const nex::BoneAnimation*> nex::AnimationManager::getBoneAnimationsByRig(const Rig* rig)
 {
+	std::shared_lock<std::shared_mutex> lock(mBoneAnimationMutex);
 	auto it = mRigToBoneAnimations.find(rig);
 
 	if (it == mRigToBoneAnimations.end()) {
@@ -2,6 +2,8 @@
 #include <nex/anim/Rig.hpp>
 #include <nex/mesh/MeshLoader.hpp>
 #include <filesystem>
+#include <mutex>
+#include <shared_mutex>
 #include <nex/anim/BoneAnimation.hpp>
 
 
@@ -12,6 +14,8 @@ namespace nex {
 	
 	/**
 	 * Management class for animations and rigs.
+	 * Note: Rigs can be loaded and queried concurrently (meshes are imported on resource loader workers).
+	 * Bone animations can be queried concurrently to loading (rigged vobs query them in parallel frame updates).
 	 */
 	class AnimationManager {
 	public:
@@ -43,6 +47,7 @@ namespace nex {
 
 		/**
 		 * Provides a bone animation by its name SID.
+		 * Note: The animation stays valid if it gets replaced by a reloaded version.
 		 */
 		const BoneAnimation* getBoneAnimation(unsigned sid);
 
@@ -50,7 +55,7 @@ namespace nex {
 		 * Provies the list of loaded bone animations for a specific rig.
 		 * @throws std::runtime_error : if rig parameter isn't a rig registered on the animation manager.
 		 */
-		const std::set<const BoneAnimation*>& getBoneAnimationsByRig(const Rig* rig);
+		std::set<const BoneAnimation*> getBoneAnimationsByRig(const Rig* rig);
 
 		/**
 		 * Provides the rig the mesh container is associated with.
@@ -110,7 +115,13 @@ namespace nex {
 		static unsigned getKeyFrameAniIndex(const aiAnimation* aiKeyFrameAni, const aiScene* scene);
 
 		std::unordered_map<unsigned, std::unique_ptr<Rig>> mRigs;
+		// guards the rig registration (recursive, since the rig loading functions call each other)
+		mutable std::recursive_mutex mRigMutex;
+		// guards the bone animation maps
+		mutable std::shared_mutex mBoneAnimationMutex;
 		std::unordered_map<unsigned, std::unique_ptr<BoneAnimation>> mBoneAnimations;
+		// animations replaced by a reload; kept alive since vobs might still use them
+		std::vector<std::unique_ptr<BoneAnimation>> mReplacedBoneAnimations;
 		std::unordered_map<const Rig*, std::set<const BoneAnimation*>> mRigToBoneAnimations;
 		std::unordered_map<unsigned, const BoneAnimation*> mSidToBoneAnimation;
 		
@@ -10,7 +10,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <nex/anim/AnimationManager.hpp>
-#include <functional>
+#include <nex/util/FrameArena.hpp>
 
 void nex::BoneAnimationData::setRig(const Rig* rig)
 {
@@ -59,24 +59,36 @@ void nex::BoneAnimation::applyParentHierarchyTrafos(std::vector<glm::mat4>& vec)
 			"nex::BoneAnimation::applyParentHierarchyTrafos : Matrix vector argument has to have the same size like there are bones!"));
 	}
 
-	const std::function<void(const Bone*, const glm::mat4&)> recursive = [&](const Bone* bone, const glm::mat4& parentTrafo) {
+	struct PendingBone {
+		const Bone* bone;
+		glm::mat4 parentTrafo;
+	};
+
+	// Note: Called per frame for every animated vob; the traversal stack is frame memory, so the evaluation doesn't 
+	// allocate from the heap.
+	FrameVector<PendingBone> pending;
+	pending.reserve(bones.size());
+	pending.push_back({ rig->getRoot(), rootTrafo });// glm::mat4(1.0f));
+
+	while (!pending.empty()) {
+		const auto current = pending.back();
+		pending.pop_back();
 
+		const auto* bone = current.bone;
 		auto id = bone->getID();
 		const auto& nodeTrafo = vec[id];
 		const auto& offset = bone->getOffsetMatrix();
 
-		auto trafo = parentTrafo * nodeTrafo;
+		auto trafo = current.parentTrafo * nodeTrafo;
 		vec[id] = invRootTrafo * trafo * offset;
 		
-		// recursive propagation
+		// propagate to the children
 		const auto& children = bone->getChildrenIDs();
 		for (int i = 0; i < bone->getChildrenCount(); ++i) {
 			const auto childID = children[i];
-			recursive(&bones[childID], trafo);
+			pending.push_back({ &bones[childID], trafo });
 		}
-	};
-
-	recursive(rig->getRoot(), rootTrafo);// glm::mat4(1.0f));
+	}
 }
 
 const nex::Rig* nex::BoneAnimation::getRig() const
@@ -0,0 +1,88 @@
+#include <nex/anim/BonePalette.hpp>
+#include <algorithm>
+
+nex::BonePalette::BonePalette(size_t capacity) : mCapacity(capacity)
+{
+}
+
+bool nex::BonePalette::add(const void* owner, const std::vector<glm::mat4>& trafos, unsigned& offset)
+{
+	glm::mat4* target = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto it = mOffsets.find(owner);
+		if (it != mOffsets.end()) {
+			offset = it->second;
+			return true;
+		}
+
+		if (!mAllocation.data || mTrafoCount + trafos.size() > mCapacity) {
+			++mRejectedPoseCount;
+			return false;
+		}
+
+		offset = static_cast<unsigned>(mTrafoCount);
+		mOffsets.emplace(owner, offset);
+		mTrafoCount += trafos.size();
+		target = static_cast<glm::mat4*>(mAllocation.data) + offset;
+	}
+
+	// the range is reserved; the pose can be written without holding the lock
+	std::copy(trafos.begin(), trafos.end(), target);
+	return true;
+}
+
+void nex::BonePalette::begin(StreamingBuffer& buffer)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mOffsets.clear();
+	mTrafoCount = 0;
+	mRejectedPoseCount = 0;
+	mAllocation = buffer.allocate(mCapacity * sizeof(glm::mat4));
+}
+
+void nex::BonePalette::bind(StreamingBuffer& buffer, unsigned binding) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mTrafoCount == 0) return;
+	buffer.bindToTarget(mAllocation, StreamingBuffer::Target::SHADER_STORAGE_BUFFER, binding);
+}
+
+void nex::BonePalette::clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mOffsets.clear();
+	mTrafoCount = 0;
+	mRejectedPoseCount = 0;
+	mAllocation = StreamingBuffer::Allocation();
+}
+
+size_t nex::BonePalette::getCapacity() const
+{
+	return mCapacity;
+}
+
+size_t nex::BonePalette::getPoseCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mOffsets.size();
+}
+
+size_t nex::BonePalette::getRejectedPoseCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mRejectedPoseCount;
+}
+
+size_t nex::BonePalette::getTrafoCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mTrafoCount;
+}
+
+const glm::mat4* nex::BonePalette::getTrafos() const
+{
+	return static_cast<const glm::mat4*>(mAllocation.data);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <nex/buffer/StreamingBuffer.hpp>
+
+namespace nex
+{
+	/**
+	 * Collects the bone transformations (poses) of all bone animated vobs of a frame contiguously in one streaming buffer range.
+	 * Render commands only reference a pose by the offset of its first bone transformation (see RenderCommand::boneOffset),
+	 * so that all bone animated draws share one buffer binding and can be batched and instanced.
+	 *
+	 * The range is allocated once per frame by begin(); poses are written directly into it, there is no intermediate copy.
+	 * Poses are added by render command queues for the commands that aren't culled (see RenderCommandQueue::useBonePalette),
+	 * possibly by several threads and for several views; a pose is only added once per frame.
+	 * If the range is full, add() fails and the command has to upload its bone transformations itself.
+	 */
+	class BonePalette
+	{
+	public:
+
+		// 8192 bone transformations (512 KiB) per frame
+		static constexpr size_t DEFAULT_CAPACITY = 8192;
+
+		/**
+		 * @param capacity : The maximum number of bone transformations per frame.
+		 */
+		explicit BonePalette(size_t capacity = DEFAULT_CAPACITY);
+
+		/**
+		 * Adds the pose of an owner, if it hasn't been added since the last begin() call.
+		 * Can be called concurrently.
+		 * @param offset : Receives the offset of the first bone transformation of the pose in the palette.
+		 * @return false, if the pose doesn't fit into the palette or begin() hasn't been called.
+		 */
+		bool add(const void* owner, const std::vector<glm::mat4>& trafos, unsigned& offset);
+
+		/**
+		 * Removes all poses and allocates the palette range for the current frame.
+		 * Has to be called on the render thread once per frame before poses are added.
+		 */
+		void begin(StreamingBuffer& buffer);
+
+		/**
+		 * Binds the palette to a shader storage buffer binding point.
+		 * Has to be called on the render thread with the buffer passed to begin().
+		 */
+		void bind(StreamingBuffer& buffer, unsigned binding) const;
+
+		/**
+		 * Removes all poses and releases the palette range. Has to be called once per frame after all draw calls of the frame
+		 * have been issued.
+		 */
+		void clear();
+
+		/**
+		 * Provides the maximum number of bone transformations per frame.
+		 */
+		size_t getCapacity() const;
+
+		/**
+		 * Provides the number of poses added since the last begin() call.
+		 */
+		size_t getPoseCount() const;
+
+		/**
+		 * Provides the number of poses that didn't fit into the palette since the last begin() call.
+		 */
+		size_t getRejectedPoseCount() const;
+
+		/**
+		 * Provides the number of bone transformations of all poses.
+		 */
+		size_t getTrafoCount() const;
+
+		/**
+		 * Provides the bone transformations of all poses (the mapped memory of the palette range).
+		 */
+		const glm::mat4* getTrafos() const;
+
+	private:
+		std::unordered_map<const void*, unsigned> mOffsets;
+		mutable std::mutex mMutex;
+
+		StreamingBuffer::Allocation mAllocation;
+		size_t mCapacity;
+		size_t mTrafoCount = 0;
+		size_t mRejectedPoseCount = 0;
+	};
+}
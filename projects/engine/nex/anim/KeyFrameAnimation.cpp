@@ -88,6 +88,12 @@ nex::MixData<int> nex::KeyFrameAnimation::calcFrameMix(float animationTime) cons
 }
 
 void nex::KeyFrameAnimation::calcChannelTrafos(float animationTime, std::vector<glm::mat4>& vec) const
+{
+	vec.resize(mChannelCount);
+	calcChannelTrafos(animationTime, vec.data());
+}
+
+void nex::KeyFrameAnimation::calcChannelTrafos(float animationTime, glm::mat4* trafos) const
 {
 	
 	const auto floatingFrame = getTick(animationTime);
@@ -101,9 +107,8 @@ void nex::KeyFrameAnimation::calcChannelTrafos(float animationTime, std::vector<
 
 
 	const glm::mat4 unit(1.0f);
-	if (vec.size() != mChannelCount) vec = mDefaultMatrices;
 
-	for (int i = 0; i < vec.size(); ++i) {
+	for (unsigned i = 0; i < mChannelCount; ++i) {
 
 		const auto minIndex = minFrame * mChannelCount + i;
 		//const auto maxIndex = maxFrame * mChannelCount + i;
@@ -115,7 +120,7 @@ void nex::KeyFrameAnimation::calcChannelTrafos(float animationTime, std::vector<
 		const auto rotation = glm::toMat4(rotationData);
 		const auto scale = glm::scale(unit, scaleData);
 		const auto trans = glm::translate(unit, positionData);
-		vec[i] = trans * rotation * scale * unit;
+		trafos[i] = trans * rotation * scale * unit;
 	}
 }
 
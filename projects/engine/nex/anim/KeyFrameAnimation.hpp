@@ -3,6 +3,7 @@
 #include <nex/anim/KeyFrame.hpp>
 #include <nex/common/File.hpp>
 #include <functional>
+#include <unordered_set>
 
 namespace nex
 {
@@ -41,6 +42,12 @@ namespace nex
 		 */
 		void calcChannelTrafos(float animationTime, std::vector<glm::mat4>& vec) const;
 
+		/**
+		 * Calculates transformation matrices from interpolated keyframe data (in bone space).
+		 * @param trafos : Output array; has to have at least channel count elements.
+		 */
+		void calcChannelTrafos(float animationTime, glm::mat4* trafos) const;
+
 		unsigned getChannelCount() const;
 
 		/**
@@ -0,0 +1,96 @@
+#include <nex/buffer/StreamingBuffer.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <cstring>
+#include <string>
+
+nex::StreamingBuffer::Allocation nex::StreamingBuffer::allocate(size_t size)
+{
+	const auto alignedSize = (size + mAlignment - 1) / mAlignment * mAlignment;
+
+	if (alignedSize > mCapacity) {
+		throw_with_trace(std::runtime_error("nex::StreamingBuffer::allocate : Requested size " + std::to_string(size)
+			+ " exceeds the capacity " + std::to_string(mCapacity)));
+	}
+
+	if (mHead + alignedSize > mCapacity) {
+		// The ranges written since the last fence might still be in use, so they have to be fenced before wrapping around.
+		fenceCurrentRange();
+		mHead = 0;
+		mFenceBegin = 0;
+	}
+
+	retireRanges(mHead, mHead + alignedSize);
+
+	Allocation allocation;
+	allocation.data = mMapped + mHead;
+	allocation.offset = mHead;
+	allocation.size = size;
+
+	mHead += alignedSize;
+	mFrameAllocatedBytes += alignedSize;
+
+	return allocation;
+}
+
+nex::StreamingBuffer::Allocation nex::StreamingBuffer::upload(const void* data, size_t size)
+{
+	auto allocation = allocate(size);
+	memcpy(allocation.data, data, size);
+	return allocation;
+}
+
+void nex::StreamingBuffer::markFrame()
+{
+	fenceCurrentRange();
+	mLastFrameAllocatedBytes = mFrameAllocatedBytes;
+	mFrameAllocatedBytes = 0;
+}
+
+size_t nex::StreamingBuffer::getAlignment() const
+{
+	return mAlignment;
+}
+
+size_t nex::StreamingBuffer::getCapacity() const
+{
+	return mCapacity;
+}
+
+size_t nex::StreamingBuffer::getHead() const
+{
+	return mHead;
+}
+
+size_t nex::StreamingBuffer::getLastFrameAllocatedBytes() const
+{
+	return mLastFrameAllocatedBytes;
+}
+
+size_t nex::StreamingBuffer::getStallCount() const
+{
+	return mStallCount;
+}
+
+size_t nex::StreamingBuffer::getPendingRangeCount() const
+{
+	return mPendingRanges.size();
+}
+
+void nex::StreamingBuffer::fenceCurrentRange()
+{
+	if (mFenceBegin == mHead) return;
+	mPendingRanges.push_back({ mFenceBegin, mHead, insertFence() });
+	mFenceBegin = mHead;
+}
+
+void nex::StreamingBuffer::retireRanges(size_t begin, size_t end)
+{
+	// The ranges are written in ring order. Thus, the oldest pending range is the first one in front of the head and
+	// only the oldest ranges can overlap the range to be written.
+	while (!mPendingRanges.empty()) {
+		const auto& range = mPendingRanges.front();
+		if (range.begin >= end || range.end <= begin) break;
+		if (waitFence(range.fence)) ++mStallCount;
+		mPendingRanges.pop_front();
+	}
+}
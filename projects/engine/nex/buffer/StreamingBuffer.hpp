@@ -0,0 +1,152 @@
+#pragma once
+#include <deque>
+#include <memory>
+
+namespace nex
+{
+	/**
+	 * A persistently mapped ring buffer for streaming per frame shader data (uniform and shader storage buffer ranges).
+	 *
+	 * Data is written with an allocate-then-write api: allocate() hands back a pointer into the mapped memory together with
+	 * the offset and size of the range, that can be bound afterwards by bindToTarget(). No data store is
+	 * (re)specified per upload.
+	 *
+	 * The written ranges are guarded by fences (one per frame and one on each wrap around of the ring). Before a range
+	 * gets overwritten, the fences of the ranges overlapping it are waited for. With a capacity of several frames
+	 * (triple buffering by default) the cpu normally doesn't have to wait for the gpu.
+	 *
+	 * The allocation logic is backend agnostic; the render backend only provides the mapped memory, the fences and the
+	 * range binding. Thus, the allocator can be used with the null render backend, too.
+	 *
+	 * Note: The constructor, destructor, bindToTarget() and the fence functions have to be implemented by the render backend!
+	 */
+	class StreamingBuffer
+	{
+	public:
+
+		class Impl;
+
+		enum class Target
+		{
+			UNIFORM_BUFFER,
+			SHADER_STORAGE_BUFFER,
+		};
+
+		/**
+		 * A range of the ring buffer that is valid for the current frame.
+		 */
+		struct Allocation
+		{
+			void* data = nullptr;
+			size_t offset = 0;
+			size_t size = 0;
+		};
+
+		/**
+		 * @param frameSize : The (byte) size of the data streamed per frame.
+		 * @param frameCount : The number of frames the ring buffer can hold.
+		 */
+		StreamingBuffer(size_t frameSize, unsigned frameCount = 3);
+
+		StreamingBuffer(const StreamingBuffer&) = delete;
+		StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+		~StreamingBuffer();
+
+		/**
+		 * Allocates a range for writing. The returned memory is valid until the range is fenced by markFrame() (or a wrap
+		 * around), i.e. it has to be written before binding it and the next frame.
+		 * Throws, if the requested size exceeds the capacity of the buffer.
+		 */
+		Allocation allocate(size_t size);
+
+		/**
+		 * Allocates a range and copies the data into it.
+		 */
+		Allocation upload(const void* data, size_t size);
+
+		/**
+		 * Binds an allocated range to an indexed buffer target.
+		 */
+		void bindToTarget(const Allocation& allocation, Target target, unsigned binding) const;
+
+		/**
+		 * Fences the ranges allocated since the last call. Has to be called once per frame after all draw calls using the
+		 * allocated ranges have been issued.
+		 */
+		void markFrame();
+
+		/**
+		 * Provides the alignment of allocated ranges (in bytes). The alignment satisfies the offset alignment of all targets.
+		 */
+		size_t getAlignment() const;
+
+		/**
+		 * Provides the total (byte) size of the ring buffer.
+		 */
+		size_t getCapacity() const;
+
+		/**
+		 * Provides the offset of the next allocation.
+		 */
+		size_t getHead() const;
+
+		/**
+		 * Provides the number of allocated bytes (including alignment padding) of the last frame.
+		 */
+		size_t getLastFrameAllocatedBytes() const;
+
+		/**
+		 * Provides the number of times the cpu had to wait for the gpu, since the buffer was created.
+		 */
+		size_t getStallCount() const;
+
+		/**
+		 * Provides the number of fenced ranges that aren't retired, yet.
+		 */
+		size_t getPendingRangeCount() const;
+
+	private:
+
+		struct FencedRange
+		{
+			size_t begin;
+			size_t end;
+			void* fence;
+		};
+
+		/**
+		 * Fences the range [mFenceBegin, mHead) if it isn't empty.
+		 */
+		void fenceCurrentRange();
+
+		/**
+		 * Waits for all pending ranges overlapping [begin, end).
+		 */
+		void retireRanges(size_t begin, size_t end);
+
+		/**
+		 * Creates a fence for all gpu commands issued so far.
+		 * Note: Has to be implemented by the render backend!
+		 */
+		void* insertFence();
+
+		/**
+		 * Waits for a fence and releases it.
+		 * Note: Has to be implemented by the render backend!
+		 * @return true, if the cpu had to wait for the gpu.
+		 */
+		bool waitFence(void* fence);
+
+		std::unique_ptr<Impl> mImpl;
+		char* mMapped;
+		size_t mAlignment;
+		size_t mCapacity;
+		size_t mHead;
+		size_t mFenceBegin;
+		size_t mFrameAllocatedBytes;
+		size_t mLastFrameAllocatedBytes;
+		size_t mStallCount;
+		std::deque<FencedRange> mPendingRanges;
+	};
+}
@@ -4,6 +4,7 @@
 #define GLM_ENABLE_EXPERIMENTAL 1
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_access.hpp>
 #include <glm/gtx/compatibility.hpp>
 #include "nex/util/ExceptionHandling.hpp"
 #include "nex/math/Ray.hpp"
@@ -728,6 +729,53 @@ namespace nex
 
 		return f;
 	}
+
+	Frustum extractFrustum(const glm::mat4& m)
+	{
+		Frustum f;
+
+		// planes: see Gribb, Hartmann, "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix"
+		const auto row0 = glm::row(m, 0);
+		const auto row1 = glm::row(m, 1);
+		const auto row2 = glm::row(m, 2);
+		const auto row3 = glm::row(m, 3);
+
+		auto toPlane = [](const glm::vec4& v) {
+			return Plane(v.x, v.y, v.z, v.w);
+		};
+
+#ifdef USE_CLIP_SPACE_ZERO_TO_ONE
+		const float nearZ = 0.0f;
+		f.planes[(unsigned)FrustumPlane::Near] = toPlane(row2);
+#else
+		const float nearZ = -1.0f;
+		f.planes[(unsigned)FrustumPlane::Near] = toPlane(row3 + row2);
+#endif
+		f.planes[(unsigned)FrustumPlane::Far] = toPlane(row3 - row2);
+		f.planes[(unsigned)FrustumPlane::Left] = toPlane(row3 + row0);
+		f.planes[(unsigned)FrustumPlane::Right] = toPlane(row3 - row0);
+		f.planes[(unsigned)FrustumPlane::Bottom] = toPlane(row3 + row1);
+		f.planes[(unsigned)FrustumPlane::Top] = toPlane(row3 - row1);
+
+		// corners: unproject the corners of the clip space cube
+		const auto inverseMatrix = inverse(m);
+		auto unproject = [&](float x, float y, float z) {
+			const auto v = inverseMatrix * glm::vec4(x, y, z, 1.0f);
+			return glm::vec3(v) / v.w;
+		};
+
+		f.corners[(unsigned)FrustumCorners::FarLeftBottom] = unproject(-1.0f, -1.0f, 1.0f);
+		f.corners[(unsigned)FrustumCorners::FarLeftTop] = unproject(-1.0f, 1.0f, 1.0f);
+		f.corners[(unsigned)FrustumCorners::FarRightBottom] = unproject(1.0f, -1.0f, 1.0f);
+		f.corners[(unsigned)FrustumCorners::FarRightTop] = unproject(1.0f, 1.0f, 1.0f);
+		f.corners[(unsigned)FrustumCorners::NearLeftBottom] = unproject(-1.0f, -1.0f, nearZ);
+		f.corners[(unsigned)FrustumCorners::NearLeftTop] = unproject(-1.0f, 1.0f, nearZ);
+		f.corners[(unsigned)FrustumCorners::NearRightBottom] = unproject(1.0f, -1.0f, nearZ);
+		f.corners[(unsigned)FrustumCorners::NearRightTop] = unproject(1.0f, 1.0f, nearZ);
+
+		return f;
+	}
+
 	nex::AABB Frustum::calcAABB() const
 	{
 		AABB box;
@@ -66,6 +66,12 @@ namespace nex
 	Frustum operator*(const Frustum& frustum, const glm::mat4& mat);
 	Frustum operator*(const glm::mat4& mat, const Frustum& frustum);
 
+	/**
+	 * Extracts the frustum of a (view) projection matrix.
+	 * If the matrix maps from world space to clip space, the world space frustum is extracted.
+	 */
+	Frustum extractFrustum(const glm::mat4& viewProjection);
+
 	/**
 	 * Defines a coordinate system by a position and a up and look vector. The right vector is indirectly defined by the cross product of up and look vector:
 	 * right = cross(look, up)
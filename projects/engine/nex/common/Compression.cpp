@@ -0,0 +1,425 @@
+#include <nex/common/Compression.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <nex/util/Profiler.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+	constexpr char MAGIC[4] = { 'N', 'E', 'X', 'Z' };
+	constexpr uint32_t STORED_FLAG = 1u << 31;
+
+	// LZ4 block format constants
+	constexpr size_t MIN_MATCH = 4;
+	constexpr size_t MIN_ENCODED_MATCH = 8; // shorter matches are emitted as literals (decoding speed over ratio)
+	constexpr size_t LAST_LITERALS = 5; // the last bytes of a block are always literals
+	constexpr size_t MATCH_FIND_LIMIT = 12; // no match starts within the last bytes of a block
+	constexpr size_t MAX_OFFSET = 65535;
+	constexpr unsigned HASH_LOG = 14;
+	constexpr unsigned RUN_MASK = 15;
+
+	uint32_t read32(const uint8_t* ptr)
+	{
+		uint32_t value;
+		std::memcpy(&value, ptr, sizeof(value));
+		return value;
+	}
+
+	uint64_t read64(const uint8_t* ptr)
+	{
+		uint64_t value;
+		std::memcpy(&value, ptr, sizeof(value));
+		return value;
+	}
+
+	/**
+	 * Provides the number of equal leading bytes of two 64 bit words (read little endian).
+	 */
+	unsigned countEqualBytes(uint64_t diff)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, diff);
+		return index / 8;
+#else
+		return __builtin_ctzll(diff) / 8;
+#endif
+	}
+
+	// Source adjustments for matches with an offset below 8 (see decompressBlock)
+	constexpr unsigned SHORT_OFFSET_INC[8] = { 0, 1, 2, 1, 0, 4, 4, 4 };
+	constexpr int SHORT_OFFSET_DEC[8] = { 0, 0, 0, -1, -4, 1, 2, 3 };
+
+	/**
+	 * Copies in chunks of 8 bytes; may write up to 7 bytes past dst + size.
+	 */
+	void wildCopy(uint8_t* dst, const uint8_t* src, size_t size)
+	{
+		const auto* end = dst + size;
+		do {
+			std::memcpy(dst, src, 8);
+			dst += 8;
+			src += 8;
+		} while (dst < end);
+	}
+
+	uint32_t hash(uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - HASH_LOG);
+	}
+
+	void writeLength(uint8_t*& out, size_t length)
+	{
+		for (; length >= 255; length -= 255) *out++ = 255;
+		*out++ = static_cast<uint8_t>(length);
+	}
+
+	void corrupt()
+	{
+		nex::throw_with_trace(std::runtime_error("nex::Compression : corrupt data"));
+	}
+
+	size_t readLength(const uint8_t*& in, const uint8_t* inEnd)
+	{
+		size_t length = 0;
+		uint8_t byte;
+		do {
+			if (in >= inEnd) corrupt();
+			byte = *in++;
+			length += byte;
+		} while (byte == 255);
+		return length;
+	}
+
+	/**
+	 * Offsets of the blocks of a compressed file relative to the beginning of the file.
+	 */
+	std::vector<size_t> getBlockOffsets(const nex::Compression::Header& header, const uint32_t* table, size_t size)
+	{
+		std::vector<size_t> offsets(header.blockCount + 1);
+		offsets[0] = sizeof(nex::Compression::Header) + size_t(header.blockCount) * sizeof(uint32_t);
+
+		for (uint32_t i = 0; i < header.blockCount; ++i) {
+			const size_t blockSize = table[i] & ~STORED_FLAG;
+			if (blockSize > size - offsets[i]) corrupt();
+			offsets[i + 1] = offsets[i] + blockSize;
+		}
+
+		return offsets;
+	}
+}
+
+size_t nex::Compression::getBlockBound(size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+size_t nex::Compression::compressBlock(const char* src, size_t srcSize, char* dst, size_t dstCapacity)
+{
+	const auto* const in = reinterpret_cast<const uint8_t*>(src);
+	const auto* const inEnd = in + srcSize;
+	auto* out = reinterpret_cast<uint8_t*>(dst);
+	const auto* const outEnd = out + dstCapacity;
+
+	const uint8_t* anchor = in;
+
+	if (srcSize > MATCH_FIND_LIMIT) {
+		// Positions are relative to the block begin; stale entries are rejected by comparing the sequences.
+		thread_local std::vector<uint32_t> table;
+		table.assign(size_t(1) << HASH_LOG, 0);
+
+		const auto* const matchLimit = inEnd - LAST_LITERALS;
+		const auto* const findLimit = inEnd - MATCH_FIND_LIMIT;
+		const uint8_t* ip = in;
+
+		while (ip < findLimit) {
+			const auto sequence = read32(ip);
+			auto& entry = table[hash(sequence)];
+			const uint8_t* match = in + entry;
+			entry = static_cast<uint32_t>(ip - in);
+
+			if (match >= ip || size_t(ip - match) > MAX_OFFSET || read32(match) != sequence) {
+				// skip faster through incompressible data
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+
+			const uint8_t* matchEnd = ip + MIN_MATCH;
+			const uint8_t* ref = match + MIN_MATCH;
+			bool mismatch = false;
+			while (!mismatch && matchEnd + sizeof(uint64_t) <= matchLimit) {
+				const auto diff = read64(matchEnd) ^ read64(ref);
+				if (diff != 0) {
+					matchEnd += countEqualBytes(diff);
+					mismatch = true;
+				}
+				else {
+					matchEnd += sizeof(uint64_t);
+					ref += sizeof(uint64_t);
+				}
+			}
+			if (!mismatch) {
+				while (matchEnd < matchLimit && *matchEnd == *ref) {
+					++matchEnd;
+					++ref;
+				}
+			}
+
+			const uint8_t* matchBegin = ip;
+			const uint8_t* matchSource = match;
+			while (matchBegin > anchor && matchSource > in && matchBegin[-1] == matchSource[-1]) {
+				--matchBegin;
+				--matchSource;
+			}
+
+			// each sequence costs decoding time, so short matches aren't worth it
+			if (size_t(matchEnd - matchBegin) < MIN_ENCODED_MATCH) {
+				++ip;
+				continue;
+			}
+
+			ip = matchBegin;
+			match = matchSource;
+
+			const size_t literals = ip - anchor;
+			const size_t matchLength = matchEnd - ip - MIN_MATCH;
+			const size_t required = 1 + literals + literals / 255 + 1 + 2 + matchLength / 255 + 1;
+			if (required > size_t(outEnd - out)) return 0;
+
+			auto* token = out++;
+			if (literals >= RUN_MASK) {
+				*token = RUN_MASK << 4;
+				writeLength(out, literals - RUN_MASK);
+			}
+			else {
+				*token = static_cast<uint8_t>(literals << 4);
+			}
+
+			std::memcpy(out, anchor, literals);
+			out += literals;
+
+			const auto offset = static_cast<uint16_t>(ip - match);
+			*out++ = static_cast<uint8_t>(offset);
+			*out++ = static_cast<uint8_t>(offset >> 8);
+
+			if (matchLength >= RUN_MASK) {
+				*token |= RUN_MASK;
+				writeLength(out, matchLength - RUN_MASK);
+			}
+			else {
+				*token |= static_cast<uint8_t>(matchLength);
+			}
+
+			ip = anchor = matchEnd;
+		}
+	}
+
+	const size_t literals = inEnd - anchor;
+	if (1 + literals + literals / 255 + 1 > size_t(outEnd - out)) return 0;
+
+	if (literals >= RUN_MASK) {
+		*out++ = RUN_MASK << 4;
+		writeLength(out, literals - RUN_MASK);
+	}
+	else {
+		*out++ = static_cast<uint8_t>(literals << 4);
+	}
+
+	std::memcpy(out, anchor, literals);
+	out += literals;
+
+	return out - reinterpret_cast<uint8_t*>(dst);
+}
+
+void nex::Compression::decompressBlock(const char* src, size_t srcSize, char* dst, size_t dstSize)
+{
+	const auto* in = reinterpret_cast<const uint8_t*>(src);
+	const auto* const inEnd = in + srcSize;
+	auto* const outBegin = reinterpret_cast<uint8_t*>(dst);
+	auto* out = outBegin;
+	const auto* const outEnd = out + dstSize;
+
+	while (in < inEnd) {
+		const auto token = *in++;
+
+		size_t literals = token >> 4;
+
+		// Most sequences are short, so short literal runs away from the end of the buffers are copied in one chunk,
+		// without further checks. Copies near the end of the buffers have to be exact.
+		if (literals != RUN_MASK && inEnd - in >= 32 && outEnd - out >= 32) {
+			std::memcpy(out, in, 16);
+		}
+		else {
+			if (literals == RUN_MASK) literals += readLength(in, inEnd);
+			if (literals > size_t(inEnd - in) || literals > size_t(outEnd - out)) corrupt();
+
+			if (literals <= 16 && inEnd - in >= 16 && outEnd - out >= 16) {
+				std::memcpy(out, in, 16);
+			}
+			else {
+				std::memcpy(out, in, literals);
+			}
+		}
+		out += literals;
+		in += literals;
+
+		// the last sequence has no match
+		if (in == inEnd) break;
+
+		if (inEnd - in < 2) corrupt();
+		const size_t offset = in[0] | (size_t(in[1]) << 8);
+		in += 2;
+		if (offset == 0 || offset > size_t(out - outBegin)) corrupt();
+
+		size_t matchLength = token & RUN_MASK;
+
+		// Short matches (at most 18 bytes) are copied in chunks of fixed size, that don't overlap for offsets of at
+		// least 8. Bytes written past the match are overwritten by the next sequence.
+		if (matchLength != RUN_MASK && offset >= 8 && outEnd - out >= 18) {
+			const uint8_t* match = out - offset;
+			std::memcpy(out, match, 8);
+			std::memcpy(out + 8, match + 8, 8);
+			std::memcpy(out + 16, match + 16, 2);
+			out += matchLength + MIN_MATCH;
+			continue;
+		}
+
+		if (matchLength == RUN_MASK) matchLength += readLength(in, inEnd);
+		matchLength += MIN_MATCH;
+		if (matchLength > size_t(outEnd - out)) corrupt();
+
+		const uint8_t* match = out - offset;
+		auto* const matchEnd = out + matchLength;
+
+		if (size_t(outEnd - out) >= matchLength + 8) {
+			// Copies 8 bytes first. For offsets below 8 the first bytes are copied one by one and the source is adjusted,
+			// so that it is at least 8 bytes behind the output and the remaining match can be copied in chunks.
+			if (offset < 8) {
+				out[0] = match[0];
+				out[1] = match[1];
+				out[2] = match[2];
+				out[3] = match[3];
+				match += SHORT_OFFSET_INC[offset];
+				std::memcpy(out + 4, match, 4);
+				match -= SHORT_OFFSET_DEC[offset];
+			}
+			else {
+				std::memcpy(out, match, 8);
+				match += 8;
+			}
+			out += 8;
+
+			if (out < matchEnd) wildCopy(out, match, matchEnd - out);
+			out = matchEnd;
+		}
+		else if (offset >= matchLength) {
+			std::memcpy(out, match, matchLength);
+			out += matchLength;
+		}
+		else {
+			// overlapping match near the end of the block: repeats the last offset bytes
+			for (size_t i = 0; i < matchLength; ++i) *out++ = *match++;
+		}
+	}
+
+	if (out != outEnd) corrupt();
+}
+
+bool nex::Compression::isCompressed(const char* data, size_t size)
+{
+	return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::vector<char> nex::Compression::compress(const char* data, size_t size, uint32_t blockSize)
+{
+	NEX_PROFILE_SCOPE("Compression::compress");
+
+	if (blockSize == 0 || blockSize >= STORED_FLAG) {
+		throw_with_trace(std::invalid_argument("nex::Compression::compress : invalid block size"));
+	}
+
+	Header header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.blockSize = blockSize;
+	header.blockCount = static_cast<uint32_t>((size + blockSize - 1) / blockSize);
+	header.size = size;
+
+	// Each block is compressed into its own slot of the scratch buffer; blocks that don't get smaller are stored.
+	const auto slotSize = getBlockBound(blockSize);
+	std::vector<char> scratch(header.blockCount * slotSize);
+	std::vector<uint32_t> table(header.blockCount);
+
+	for (size_t i = 0; i < table.size(); ++i) {
+		const auto offset = i * blockSize;
+		const auto uncompressedSize = std::min<size_t>(blockSize, size - offset);
+		const auto compressedSize = compressBlock(data + offset, uncompressedSize,
+			scratch.data() + i * slotSize, uncompressedSize - 1);
+
+		table[i] = compressedSize == 0 ? static_cast<uint32_t>(uncompressedSize) | STORED_FLAG
+			: static_cast<uint32_t>(compressedSize);
+	}
+
+	size_t compressedSize = sizeof(Header) + table.size() * sizeof(uint32_t);
+	for (auto entry : table) compressedSize += entry & ~STORED_FLAG;
+
+	std::vector<char> result(compressedSize);
+	auto* out = result.data();
+	std::memcpy(out, &header, sizeof(Header));
+	out += sizeof(Header);
+	out = std::copy_n(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(uint32_t), out);
+
+	for (size_t i = 0; i < table.size(); ++i) {
+		const auto blockBytes = table[i] & ~STORED_FLAG;
+		const auto* block = (table[i] & STORED_FLAG) ? data + i * blockSize : scratch.data() + i * slotSize;
+		std::memcpy(out, block, blockBytes);
+		out += blockBytes;
+	}
+
+	return result;
+}
+
+void nex::Compression::decompress(const char* data, size_t size, std::vector<char>& out)
+{
+	NEX_PROFILE_SCOPE("Compression::decompress");
+
+	if (size < sizeof(Header) || !isCompressed(data, size)) corrupt();
+
+	Header header;
+	std::memcpy(&header, data, sizeof(Header));
+
+	if (header.version != VERSION) {
+		throw_with_trace(std::runtime_error("nex::Compression : unsupported version " + std::to_string(header.version)));
+	}
+
+	const auto expectedBlocks = header.blockSize == 0 ? 0 : (header.size + header.blockSize - 1) / header.blockSize;
+	if (header.blockSize == 0 && header.size != 0) corrupt();
+	if (header.blockCount != expectedBlocks
+		|| size_t(header.blockCount) * sizeof(uint32_t) > size - sizeof(Header)) corrupt();
+
+	std::vector<uint32_t> table(header.blockCount);
+	std::copy_n(data + sizeof(Header), table.size() * sizeof(uint32_t), reinterpret_cast<char*>(table.data()));
+	const auto offsets = getBlockOffsets(header, table.data(), size);
+
+	out.resize(header.size);
+
+	for (size_t i = 0; i < table.size(); ++i) {
+		const auto offset = i * header.blockSize;
+		const auto uncompressedSize = std::min<size_t>(header.blockSize, header.size - offset);
+		const auto* block = data + offsets[i];
+		const auto blockBytes = offsets[i + 1] - offsets[i];
+
+		if (table[i] & STORED_FLAG) {
+			if (blockBytes != uncompressedSize) corrupt();
+			std::memcpy(out.data() + offset, block, blockBytes);
+		}
+		else {
+			decompressBlock(block, blockBytes, out.data() + offset, uncompressedSize);
+		}
+	}
+}
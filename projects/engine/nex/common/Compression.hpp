@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nex
+{
+	/**
+	 * A fast lossless block compressor (LZ4 block format) and a container format for compressed files.
+	 *
+	 * Container layout:
+	 *  - header: magic "NEXZ", version, block size, block count and uncompressed size
+	 *  - block table: compressed size of each block; the highest bit marks blocks stored uncompressed
+	 *  - the blocks
+	 *
+	 * Blocks are independent of each other. They are decompressed on the calling thread (usually a worker of the
+	 * resource loader), the engine's thread pool is reserved for short frame tasks. Matches shorter than 8 bytes
+	 * aren't encoded, which costs some ratio on float data, but keeps decoding fast.
+	 * Files without the magic are not compressed, so old files stay readable.
+	 */
+	class Compression
+	{
+	public:
+
+		static constexpr uint32_t VERSION = 1;
+		static constexpr uint32_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t blockSize;
+			uint32_t blockCount;
+			uint64_t size;
+		};
+
+		/**
+		 * Provides the maximum compressed size of a block of a given size.
+		 */
+		static size_t getBlockBound(size_t size);
+
+		/**
+		 * Compresses a block.
+		 * @return The compressed size or 0, if the compressed block doesn't fit into dstCapacity bytes.
+		 */
+		static size_t compressBlock(const char* src, size_t srcSize, char* dst, size_t dstCapacity);
+
+		/**
+		 * Decompresses a block.
+		 * @param dstSize : The exact uncompressed size of the block.
+		 * @throws std::runtime_error : if the block is corrupt.
+		 */
+		static void decompressBlock(const char* src, size_t srcSize, char* dst, size_t dstSize);
+
+		/**
+		 * Checks if data starts with the header of a compressed file.
+		 */
+		static bool isCompressed(const char* data, size_t size);
+
+		/**
+		 * Compresses data into the container format.
+		 */
+		static std::vector<char> compress(const char* data, size_t size, uint32_t blockSize = DEFAULT_BLOCK_SIZE);
+
+		/**
+		 * Decompresses data in the container format.
+		 * @throws std::runtime_error : if the data is corrupt.
+		 */
+		static void decompress(const char* data, size_t size, std::vector<char>& out);
+	};
+}
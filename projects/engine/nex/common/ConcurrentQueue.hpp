@@ -1,48 +1,333 @@
 #pragma once
-#include <queue>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace nex
 {
+	/**
+	 * A multi-producer/multi-consumer queue backed by a lock-free ring buffer.
+	 * Each slot carries a sequence number that tells producers and consumers whether the slot is free or filled;
+	 * the enqueue and dequeue positions are claimed with a single CAS. So push and pop don't take a lock as long as
+	 * the ring buffer has free slots.
+	 *
+	 * If the ring buffer is full, push() appends to a mutex guarded overflow list instead of waiting. Thus push never 
+	 * blocks and a thread can safely push to a queue it consumes itself (e.g. the main thread pushing render commands
+	 * while it waits for the resource loader). As long as the overflow list isn't empty, new elements are appended to it, 
+	 * too; consumers drain the ring buffer before the overflow list. So the FIFO order of each producer is preserved.
+	 *
+	 * Elements only need to be move constructible (move-only types like std::unique_ptr are supported).
+	 *
+	 * pop() spins for a short while and afterwards sleeps on a condition variable.
+	 * The mutex for the condition variable is only touched if a thread actually has to wait.
+	 */
 	template <class T>
 	class ConcurrentQueue
 	{
 	public:
 
-		void clear() {
-			std::unique_lock<std::mutex> lock(mMutex);
-			mQueue.clear();
+		static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+		/**
+		 * @param capacity : The number of elements the lock-free ring buffer can hold. Will be rounded up to the next power of two.
+		 */
+		explicit ConcurrentQueue(size_t capacity = DEFAULT_CAPACITY) :
+			mCells(roundUpPowerOfTwo(capacity < 2 ? 2 : capacity)),
+			mMask(mCells.size() - 1)
+		{
+			for (size_t i = 0; i < mCells.size(); ++i) {
+				mCells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		ConcurrentQueue(const ConcurrentQueue&) = delete;
+		ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+		~ConcurrentQueue()
+		{
+			clear();
+		}
+
+		/**
+		 * Provides the number of elements the lock-free ring buffer can hold. 
+		 * Note: The queue can hold more elements (see push).
+		 */
+		size_t capacity() const
+		{
+			return mCells.size();
+		}
+
+		/**
+		 * Removes all elements.
+		 */
+		void clear()
+		{
+			while (consumeAny([](T&&) {}));
 		}
 
+		/**
+		 * Checks if the queue is empty.
+		 * Note: The result is only a snapshot if other threads access the queue concurrently.
+		 */
 		bool empty() const
 		{
-			std::unique_lock<std::mutex> lock(mMutex);
-			return mQueue.empty();
+			return size() == 0;
 		}
 
+		/**
+		 * Removes the front element. Blocks until an element is available.
+		 */
 		T pop()
 		{
-			std::unique_lock<std::mutex> lock(mMutex);
-			T t = std::move(mQueue.front());
-			mQueue.pop();
-			return t;
+			std::optional<T> result;
+			waitFor(mNotEmpty, [&] {
+				return consumeAny([&](T&& value) { result.emplace(std::move(value)); });
+			});
+			return std::move(*result);
+		}
+
+		/**
+		 * Removes up to maxCount elements and writes them to an output iterator. Doesn't block.
+		 * @return the number of removed elements.
+		 */
+		template<class OutputIt>
+		size_t pop_bulk(OutputIt out, size_t maxCount)
+		{
+			size_t count = 0;
+			while (count < maxCount && consumeAny([&](T&& value) { *out = std::move(value); ++out; })) {
+				++count;
+			}
+
+			return count;
 		}
 
+		/**
+		 * Adds an element to the back of the queue. Never blocks: If the ring buffer is full, the element is 
+		 * appended to the overflow list.
+		 */
 		void push(T t)
 		{
-			std::unique_lock<std::mutex> lock(mMutex);
-			mQueue.push(t);
+			// keep the order: as long as elements wait in the overflow list, new elements have to be appended there, too
+			if (mOverflowSize.load(std::memory_order_acquire) != 0 || !produce(std::move(t))) {
+				std::lock_guard<std::mutex> lock(mOverflowMutex);
+				mOverflow.emplace_back(std::move(t));
+				mOverflowSize.fetch_add(1, std::memory_order_release);
+			}
+
+			notify(mNotEmpty);
 		}
 
+		/**
+		 * Provides the number of elements in the queue.
+		 * Note: The result is only a snapshot if other threads access the queue concurrently.
+		 */
 		size_t size() const
 		{
-			std::unique_lock<std::mutex> lock(mMutex);
-			return mQueue.size();
+			const auto dequeuePos = mDequeuePos.load(std::memory_order_acquire);
+			const auto enqueuePos = mEnqueuePos.load(std::memory_order_acquire);
+			const auto ringSize = enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+			return ringSize + mOverflowSize.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * Removes the front element, if the queue isn't empty. Doesn't block.
+		 * @return true, if an element was removed.
+		 */
+		bool try_pop(T& t)
+		{
+			return consumeAny([&](T&& value) { t = std::move(value); });
+		}
+
+		/**
+		 * Adds an element to the back of the queue, if the ring buffer isn't full. Doesn't block and never uses the overflow list.
+		 * Note: If the element couldn't be added, t is not moved from.
+		 * @return true, if the element was added.
+		 */
+		template<class U>
+		bool try_push(U&& t)
+		{
+			// elements in the overflow list are older; adding to the ring buffer would break the order
+			if (mOverflowSize.load(std::memory_order_acquire) != 0) return false;
+			if (!produce(std::forward<U>(t))) return false;
+			notify(mNotEmpty);
+			return true;
 		}
 
 	private:
-		
-		mutable std::mutex mMutex;
-		std::queue<T> mQueue;
+
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+		static constexpr unsigned SPIN_COUNT = 64;
+
+		struct alignas(CACHE_LINE_SIZE) Cell {
+			std::atomic<size_t> sequence;
+			std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+			T* get() {
+				return std::launder(reinterpret_cast<T*>(&storage));
+			}
+		};
+
+		static size_t roundUpPowerOfTwo(size_t value)
+		{
+			size_t result = 1;
+			while (result < value) result <<= 1;
+			return result;
+		}
+
+		template<class U>
+		bool produce(U&& value)
+		{
+			auto pos = mEnqueuePos.load(std::memory_order_relaxed);
+			Cell* cell;
+
+			for (;;) {
+				cell = &mCells[pos & mMask];
+				const auto sequence = cell->sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+				if (diff == 0) {
+					if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+				}
+				else if (diff < 0) {
+					// queue is full
+					return false;
+				}
+				else {
+					pos = mEnqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+
+			new (&cell->storage) T(std::forward<U>(value));
+			cell->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * Removes the front element of the ring buffer and passes it to a consumer function.
+		 * Note: The slot is released before the consumer function is called. So an exception thrown by the consumer 
+		 * function can't leave the ring buffer in an inconsistent state.
+		 * @return false, if the ring buffer was empty.
+		 */
+		template<class Func>
+		bool consume(Func&& func)
+		{
+			auto pos = mDequeuePos.load(std::memory_order_relaxed);
+			Cell* cell;
+
+			for (;;) {
+				cell = &mCells[pos & mMask];
+				const auto sequence = cell->sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+				if (diff == 0) {
+					if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+				}
+				else if (diff < 0) {
+					// queue is empty
+					return false;
+				}
+				else {
+					pos = mDequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+
+			T* element = cell->get();
+			T value(std::move(*element));
+			element->~T();
+			cell->sequence.store(pos + mMask + 1, std::memory_order_release);
+
+			func(std::move(value));
+			return true;
+		}
+
+		/**
+		 * Removes the front element of the overflow list and passes it to a consumer function.
+		 * @return false, if the overflow list was empty.
+		 */
+		template<class Func>
+		bool consumeOverflow(Func&& func)
+		{
+			if (mOverflowSize.load(std::memory_order_acquire) == 0) return false;
+
+			std::optional<T> value;
+			{
+				std::lock_guard<std::mutex> lock(mOverflowMutex);
+				if (mOverflow.empty()) return false;
+				value.emplace(std::move(mOverflow.front()));
+				mOverflow.pop_front();
+				mOverflowSize.fetch_sub(1, std::memory_order_release);
+			}
+
+			func(std::move(*value));
+			return true;
+		}
+
+		/**
+		 * Removes the front element of the queue: The ring buffer holds the older elements, so it is drained first.
+		 * @return false, if the queue was empty.
+		 */
+		template<class Func>
+		bool consumeAny(Func&& func)
+		{
+			return consume(func) || consumeOverflow(func);
+		}
+
+		/**
+		 * Waits until a predicate is fulfilled. Spins first and sleeps on a condition variable afterwards.
+		 */
+		template<class Predicate>
+		void waitFor(std::condition_variable& condition, Predicate&& predicate)
+		{
+			for (unsigned i = 0; i < SPIN_COUNT; ++i) {
+				if (predicate()) return;
+				std::this_thread::yield();
+			}
+
+			mWaiters.fetch_add(1, std::memory_order_seq_cst);
+			{
+				std::unique_lock<std::mutex> lock(mWaitMutex);
+				condition.wait(lock, predicate);
+			}
+			mWaiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Wakes up waiting threads, if there are any.
+		 */
+		void notify(std::condition_variable& condition)
+		{
+			// Pairs with the increment of mWaiters in waitFor: Either the waiter sees our change or we see the waiter.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (mWaiters.load(std::memory_order_relaxed) == 0) return;
+
+			{
+				std::unique_lock<std::mutex> lock(mWaitMutex);
+			}
+			condition.notify_all();
+		}
+
+		std::vector<Cell> mCells;
+		const size_t mMask;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> mEnqueuePos = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> mDequeuePos = 0;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<unsigned> mWaiters = 0;
+		std::mutex mWaitMutex;
+		std::condition_variable mNotEmpty;
+
+		// elements that didn't fit into the ring buffer; guarded by mOverflowMutex
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> mOverflowSize = 0;
+		std::mutex mOverflowMutex;
+		std::deque<T> mOverflow;
 	};
-}
\ No newline at end of file
+}
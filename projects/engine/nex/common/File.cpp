@@ -1,23 +1,173 @@
 #include <nex/common/File.hpp>
+#include <nex/common/Compression.hpp>
+#include <nex/common/MappedFile.hpp>
 #include "nex/util/ExceptionHandling.hpp"
 #include "Log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+/**
+ * A read only stream buffer over a memory range.
+ */
+class nex::BinStream::MemoryBuffer : public std::streambuf
+{
+public:
+	MemoryBuffer(const char* data, size_t size)
+	{
+		auto* begin = const_cast<char*>(data);
+		setg(begin, begin, begin + size);
+	}
+
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+
+		off_type base = 0;
+		if (dir == std::ios_base::cur) base = gptr() - eback();
+		else if (dir == std::ios_base::end) base = egptr() - eback();
+
+		return seekpos(pos_type(base + off), which);
+	}
+
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+	{
+		const off_type offset = pos;
+		if (!(which & std::ios_base::in) || offset < 0 || offset > egptr() - eback()) return pos_type(off_type(-1));
+
+		setg(eback(), eback() + offset, egptr());
+		return pos;
+	}
+
+	std::streamsize showmanyc() override
+	{
+		return egptr() - gptr();
+	}
+};
+
+/**
+ * A growable in-memory output stream buffer.
+ */
+class nex::BinStream::OutputBuffer : public std::streambuf
+{
+public:
+	OutputBuffer() : mData(INITIAL_CAPACITY), mSize(0)
+	{
+		setPosition(0);
+	}
+
+	const char* getData() const
+	{
+		return mData.data();
+	}
+
+	size_t getSize() const
+	{
+		return std::max<size_t>(mSize, pptr() - pbase());
+	}
+
+protected:
+	int_type overflow(int_type c) override
+	{
+		reserve(mData.size() + 1);
+
+		if (!traits_type::eq_int_type(c, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+
+		return traits_type::not_eof(c);
+	}
+
+	std::streamsize xsputn(const char* s, std::streamsize count) override
+	{
+		reserve(static_cast<size_t>(pptr() - pbase()) + count);
+		std::memcpy(pptr(), s, count);
+		advance(count);
+		return count;
+	}
+
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		off_type base = 0;
+		if (dir == std::ios_base::cur) base = pptr() - pbase();
+		else if (dir == std::ios_base::end) base = getSize();
+
+		return seekpos(pos_type(base + off), which);
+	}
+
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+	{
+		const off_type offset = pos;
+		if (!(which & std::ios_base::out) || offset < 0 || size_t(offset) > getSize()) return pos_type(off_type(-1));
+
+		mSize = getSize();
+		setPosition(offset);
+		return pos;
+	}
+
+private:
+	static constexpr size_t INITIAL_CAPACITY = 64 * 1024;
+
+	void reserve(size_t capacity)
+	{
+		if (capacity <= mData.size()) return;
+
+		const size_t position = pptr() - pbase();
+		mSize = getSize();
+		mData.resize(std::max(capacity, 2 * mData.size()));
+		setPosition(position);
+	}
+
+	void setPosition(size_t position)
+	{
+		setp(mData.data(), mData.data() + mData.size());
+		advance(position);
+	}
+
+	void advance(size_t count)
+	{
+		constexpr size_t maxStep = std::numeric_limits<int>::max();
+		for (; count > maxStep; count -= maxStep) pbump(static_cast<int>(maxStep));
+		pbump(static_cast<int>(count));
+	}
+
+	std::vector<char> mData;
+	size_t mSize;
+};
 
 nex::BinStream::BinStream(size_t bufferSize) : std::fstream(), mBuffer(bufferSize)
 {
-	rdbuf()->pubsetbuf(mBuffer.data(), mBuffer.size());
+	std::fstream::rdbuf()->pubsetbuf(mBuffer.data(), mBuffer.size());
 	exceptions(std::ofstream::failbit | std::ofstream::badbit);
 }
 
-nex::BinStream::~BinStream() noexcept = default;
+nex::BinStream::~BinStream() noexcept
+{
+	// The file buffer has to be flushed while mBuffer is still alive (members are destroyed before the base class).
+	try
+	{
+		useFileBuffer();
+		if (is_open()) std::fstream::close();
+	}
+	catch (std::exception& e)
+	{
+		LOG(Logger(), Error) << "Couldn't close BinStream " << mFile.generic_string() << " : " << e.what();
+	}
+}
 
 void nex::BinStream::open(const char* filePath, std::ios_base::openmode mode)
 {
 	try
 	{
+		useFileBuffer();
 		mFile = filePath;
 		Logger logger;
 		LOG(logger, Info) << "open BinStream : " << mFile.generic_string();
 		std::fstream::open(filePath, mode | std::ios::binary);
+		decompressFile(mode);
 		LOG(logger, Info) << "opened BinStream : " << mFile.generic_string();
 	}
 	catch (std::exception& e)
@@ -30,10 +180,12 @@ void nex::BinStream::open(const std::filesystem::path& path, std::ios_base::open
 {
 	try
 	{
+		useFileBuffer();
 		mFile = path;
 		Logger logger;
 		LOG(logger, Info) << "open BinStream : " << mFile.generic_string();
 		std::fstream::open(path, mode | std::ios::binary);
+		decompressFile(mode);
 		LOG(logger, Info) << "opened BinStream : " << mFile.generic_string();
 	}
 	catch (std::exception& e)
@@ -42,6 +194,118 @@ void nex::BinStream::open(const std::filesystem::path& path, std::ios_base::open
 	}
 }
 
+void nex::BinStream::openCompressed(const std::filesystem::path& path)
+{
+	try
+	{
+		useFileBuffer();
+		mFile = path;
+		Logger logger;
+		LOG(logger, Info) << "open compressed BinStream : " << mFile.generic_string();
+		// the file is opened now in order to report errors early
+		std::fstream::open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+		mOutputBuffer = std::make_unique<OutputBuffer>();
+		std::basic_ios<char>::rdbuf(mOutputBuffer.get());
+	}
+	catch (std::exception& e)
+	{
+		throw_with_trace(e);
+	}
+}
+
+void nex::BinStream::openMemory(const char* data, size_t size, bool decompress)
+{
+	useFileBuffer();
+	if (is_open()) std::fstream::close();
+
+	if (decompress) {
+		std::vector<char> decompressed;
+		Compression::decompress(data, size, decompressed);
+		mMemoryBuffer = std::make_unique<MemoryBuffer>(decompressed.data(), decompressed.size());
+		mDecompressed = std::move(decompressed);
+		mFile.clear();
+		std::basic_ios<char>::rdbuf(mMemoryBuffer.get());
+		return;
+	}
+
+	mMemoryBuffer = std::make_unique<MemoryBuffer>(data, size);
+	mFile.clear();
+	std::basic_ios<char>::rdbuf(mMemoryBuffer.get());
+}
+
+void nex::BinStream::openMapped(const std::filesystem::path& path)
+{
+	try
+	{
+		Logger logger;
+		LOG(logger, Info) << "map BinStream : " << path.generic_string();
+		auto mappedFile = std::make_unique<MappedFile>(path);
+
+		const bool compressed = Compression::isCompressed(mappedFile->getData(), mappedFile->getSize());
+		openMemory(mappedFile->getData(), mappedFile->getSize(), compressed);
+
+		// compressed files are decompressed into memory, so the mapping isn't needed anymore
+		if (!compressed) mMappedFile = std::move(mappedFile);
+
+		mFile = path;
+	}
+	catch (std::exception& e)
+	{
+		throw_with_trace(e);
+	}
+}
+
+void nex::BinStream::close()
+{
+	if (mMemoryBuffer || mOutputBuffer) {
+		useFileBuffer();
+		return;
+	}
+
+	std::fstream::close();
+}
+
+void nex::BinStream::useFileBuffer()
+{
+	if (mOutputBuffer) writeCompressed();
+	if (!mMemoryBuffer) return;
+
+	std::basic_ios<char>::rdbuf(std::fstream::rdbuf());
+	mMemoryBuffer.reset();
+	mMappedFile.reset();
+	mDecompressed = std::vector<char>();
+}
+
+void nex::BinStream::decompressFile(std::ios_base::openmode mode)
+{
+	if (!(mode & std::ios::in) || (mode & std::ios::out)) return;
+
+	auto* file = std::fstream::rdbuf();
+	Compression::Header header;
+	const auto headerSize = file->sgetn(reinterpret_cast<char*>(&header), sizeof(header));
+	file->pubseekpos(0, std::ios::in);
+
+	if (!Compression::isCompressed(header.magic, static_cast<size_t>(headerSize))) return;
+
+	// the compressed data is decompressed straight from a mapping of the file
+	std::fstream::close();
+	const auto path = mFile;
+	MappedFile compressed(path);
+	openMemory(compressed.getData(), compressed.getSize(), true);
+	mFile = path;
+}
+
+void nex::BinStream::writeCompressed()
+{
+	// the output buffer is released first, so that a failed write isn't repeated by the destructor
+	auto output = std::move(mOutputBuffer);
+	std::basic_ios<char>::rdbuf(std::fstream::rdbuf());
+
+	const auto compressed = Compression::compress(output->getData(), output->getSize());
+	write(compressed.data(), compressed.size());
+	std::fstream::close();
+}
+
 void nex::BinStream::test()
 {
 	size_t bytes = 8192;
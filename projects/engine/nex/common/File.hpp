@@ -1,14 +1,39 @@
 #pragma once
 
+#include <filesystem>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace nex
 {
+	class MappedFile;
+
+	/**
+	 * Types whose objects are serialized by their object representation; contiguous ranges of them are read and
+	 * written with one call.
+	 */
+	template<class T>
+	constexpr bool isBulkSerializable = std::is_trivially_copyable<T>::value && !std::is_same<T, bool>::value;
+
+	/**
+	 * A binary stream. By default it reads and writes files; for reading it can also be backed by a mapped file or
+	 * a memory range.
+	 * Files compressed with nex::Compression are detected when they are opened for reading and are decompressed
+	 * transparently.
+	 */
 	class BinStream : public std::fstream
 	{
 	public:
-		BinStream(size_t bufferSize = 1024);
+
+		static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+		/**
+		 * @param bufferSize : The size of the buffer used for file io.
+		 */
+		BinStream(size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		BinStream(const BinStream&) = delete;
 		BinStream& operator=(const BinStream&) = delete;
 
@@ -17,14 +42,73 @@ namespace nex
 
 		virtual ~BinStream() noexcept;
 
+		/**
+		 * Opens a file. If the file is opened only for reading and is compressed, it is decompressed into memory.
+		 */
 		void open(const char* filePath, std::ios_base::openmode mode);
 		void open(const std::filesystem::path& path, std::ios_base::openmode mode);
 
+		/**
+		 * Opens (and truncates) a file for compressed writing: The written data is collected in memory and
+		 * written compressed on close(). Seeking within the written data is supported.
+		 * Note: Call close() explicitly in order to get notified about errors; the destructor only logs them.
+		 */
+		void openCompressed(const std::filesystem::path& path);
+
+		/**
+		 * Reads from a memory range. The memory has to stay valid until the stream is closed or opened again.
+		 * @param decompress : The memory holds compressed data (see nex::Compression), which is decompressed into
+		 *                     memory owned by the stream first.
+		 */
+		void openMemory(const char* data, size_t size, bool decompress = false);
+
+		/**
+		 * Maps a file and reads from the mapping. Compressed files are decompressed into memory instead.
+		 */
+		void openMapped(const std::filesystem::path& path);
+
+		/**
+		 * Closes the stream, regardless whether it reads a file, a mapped file or memory.
+		 * Compressed data opened with openCompressed() is written to the file.
+		 */
+		void close();
+
+		/**
+		 * Reads a contiguous range of bulk serializable elements with one read call.
+		 */
+		template<class T>
+		void readRange(T* data, size_t count)
+		{
+			static_assert(isBulkSerializable<T>, "Type has to be trivially copyable!");
+			read(reinterpret_cast<char*>(data), count * sizeof(T));
+		}
+
+		/**
+		 * Writes a contiguous range of bulk serializable elements with one write call.
+		 */
+		template<class T>
+		void writeRange(const T* data, size_t count)
+		{
+			static_assert(isBulkSerializable<T>, "Type has to be trivially copyable!");
+			write(reinterpret_cast<const char*>(data), count * sizeof(T));
+		}
+
 		static void test();
 
 	private:
+		class MemoryBuffer;
+		class OutputBuffer;
+
+		void useFileBuffer();
+		void decompressFile(std::ios_base::openmode mode);
+		void writeCompressed();
+
 		std::vector<char> mBuffer;
 		std::filesystem::path mFile;
+		std::unique_ptr<MemoryBuffer> mMemoryBuffer;
+		std::unique_ptr<MappedFile> mMappedFile;
+		std::vector<char> mDecompressed;
+		std::unique_ptr<OutputBuffer> mOutputBuffer;
 	};
 
 	//class = std::enable_if<std::is_trivially_copyable<T>::value>::type* 
@@ -85,13 +169,16 @@ namespace nex
 	{
 		size_t count = 0;
 		in >> count;
-		
-		if (count > 0)
-			vec.resize(count);
+		vec.resize(count);
 
-		for (size_t i = 0; i < count; ++i)
-		{
-			in >> vec[i];
+		if constexpr (isBulkSerializable<T>) {
+			in.readRange(vec.data(), count);
+		}
+		else {
+			for (size_t i = 0; i < count; ++i)
+			{
+				in >> vec[i];
+			}
 		}
 
 		return in;
@@ -102,9 +189,15 @@ namespace nex
 	{
 		const size_t count = vec.size();
 		out << count;
-		for (const auto& item : vec)
-		{
-			out << item;
+
+		if constexpr (isBulkSerializable<T>) {
+			out.writeRange(vec.data(), count);
+		}
+		else {
+			for (const auto& item : vec)
+			{
+				out << item;
+			}
 		}
 
 		return out;
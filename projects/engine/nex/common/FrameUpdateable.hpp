@@ -19,5 +19,13 @@ namespace nex
 		 * Updates the object for the current frame.
 		 */
 		virtual void frameUpdate(const RenderContext& constants) = 0;
+
+		/**
+		 * Specifies whether frameUpdate can be called from a worker thread, concurrently to updates of other objects.
+		 * An object that is parallel update safe only modifies itself and objects it exclusively owns (e.g. vob children).
+		 * It doesn't modify shared state, doesn't change the structure of the scene and doesn't call the render backend.
+		 * It may read immutable shared data (e.g. animations) and allocate frame memory (see FrameArena).
+		 */
+		virtual bool isParallelUpdateSafe() const { return false; }
 	};
 }
\ No newline at end of file
@@ -5,7 +5,13 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <mutex>
+#include <stdexcept>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace nex
 {
@@ -24,6 +30,55 @@ namespace nex
 	template<class T> using Promise = _PromiseBase<T>;
 	template<class Ret, class... ArgsTypes> using PackagedTask = _PackagedTask<Ret, ArgsTypes...>;
 
+	/**
+	 * A continuation is a function that is executed after a future got ready.
+	 */
+	using Continuation = std::function<void()>;
+
+	/**
+	 * An executor decides where (on which thread) a continuation is executed.
+	 */
+	using Executor = std::function<void(Continuation)>;
+
+	/**
+	 * Executes a continuation directly on the thread that completes the future.
+	 * Should only be used for cheap continuations.
+	 * 
+	 * Note: A continuation that is scheduled while another inline continuation runs on the same thread
+	 * is queued and executed after the running one returned (trampolining). So long continuation chains
+	 * don't nest on the call stack. As a consequence, an inline continuation mustn't block on a future 
+	 * that is completed by another inline continuation of the same thread.
+	 */
+	inline void InlineExecutor(Continuation continuation)
+	{
+		struct Trampoline {
+			std::deque<Continuation> pending;
+			bool active = false;
+		};
+
+		thread_local Trampoline trampoline;
+
+		if (trampoline.active) {
+			trampoline.pending.emplace_back(std::move(continuation));
+			return;
+		}
+
+		// resets the trampoline if a continuation throws; queued continuations are run by the next outermost call
+		struct ActiveGuard {
+			Trampoline& trampoline;
+			ActiveGuard(Trampoline& trampoline) : trampoline(trampoline) { trampoline.active = true; }
+			~ActiveGuard() { trampoline.active = false; }
+		} guard(trampoline);
+
+		continuation();
+
+		while (!trampoline.pending.empty()) {
+			auto next = std::move(trampoline.pending.front());
+			trampoline.pending.pop_front();
+			next();
+		}
+	}
+
 	template<class _Fret>
 	struct _P_ArgType
 	{	// type for functions returning T
@@ -72,46 +127,84 @@ namespace nex
 			return mFinished;
 		}
 
+		/**
+		 * Registers a continuation that is called after the state got ready. 
+		 * If the state is already ready, the continuation is called immediately on the calling thread.
+		 */
+		void add_continuation(Continuation continuation)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				if (!mFinished) {
+					mContinuations.emplace_back(std::move(continuation));
+					return;
+				}
+			}
+
+			continuation();
+		}
+
+		/**
+		 * Provides the exception of the state or nullptr, if no exception was set.
+		 * Note: Should only be called if the state is ready.
+		 */
+		const std::shared_ptr<std::exception>& get_exception() const
+		{
+			return mException;
+		}
+
 		void set_exception(const std::shared_ptr<std::exception>& e) {
+			std::vector<Continuation> continuations;
 			{
 				std::unique_lock<std::mutex> lock(mMutex);
 				mException = e;
 				mFinished = true;
+				continuations.swap(mContinuations);
 			}
 
 			mCondition.notify_all();
+			runContinuations(continuations);
 		}
 
 		void set_exception(std::shared_ptr<std::exception>&& e) {
+			std::vector<Continuation> continuations;
 			{
 				std::unique_lock<std::mutex> lock(mMutex);
 				mException = std::forward<std::shared_ptr<std::exception>>(e);
 				mFinished = true;
+				continuations.swap(mContinuations);
 			}
 
 			mCondition.notify_all();
+			runContinuations(continuations);
 		}
 
 		void set_value(const T& elem)
 		{
+			std::vector<Continuation> continuations;
 			{
 				std::unique_lock<std::mutex> lock(mMutex);
 				mElem = elem;
 				mFinished = true;
+				continuations.swap(mContinuations);
 			}
 
 			mCondition.notify_all();
+			runContinuations(continuations);
 		}
 
 		void set_value(T&& elem)
 		{
+			std::vector<Continuation> continuations;
 			{
 				std::unique_lock<std::mutex> lock(mMutex);
 				mElem = std::forward<T>(elem);
 				mFinished = true;
+				continuations.swap(mContinuations);
 			}
 
 			mCondition.notify_all();
+			runContinuations(continuations);
 		}
 
 		void retain() {
@@ -129,8 +222,16 @@ namespace nex
 		friend Future<T>;
 		friend Promise<T>;
 
+		static void runContinuations(std::vector<Continuation>& continuations)
+		{
+			for (auto& continuation : continuations) {
+				continuation();
+			}
+		}
+
 		T mElem;
 		std::shared_ptr<std::exception> mException;
+		std::vector<Continuation> mContinuations;
 		std::condition_variable mCondition;
 		std::mutex mMutex;
 		std::atomic<bool> mFinished = false;
@@ -242,7 +343,34 @@ namespace nex
 			return mState;
 		}
 
+		/**
+		 * Checks if the future is ready and holds an exception.
+		 */
+		bool has_exception() const
+		{
+			return is_ready() && mState->get_exception() != nullptr;
+		}
+
+		/**
+		 * Provides the exception of a ready future or nullptr, if no exception was set.
+		 */
+		std::shared_ptr<std::exception> get_exception() const
+		{
+			if (!is_ready()) return nullptr;
+			return mState->get_exception();
+		}
+
+		/**
+		 * Registers a low level continuation, that is called (on the completing thread) after the future got ready.
+		 * Note: Prefer then(), when_all() and when_any() in user code.
+		 */
+		void add_continuation(Continuation continuation) const
+		{
+			mState->add_continuation(std::move(continuation));
+		}
+
 	protected:
+
 		T& get_intern() {
 
 			return mState->get();
@@ -286,7 +414,7 @@ namespace nex
 			return (*this);
 		}
 
-		_Future(const _FutureStateManager& state, Nil nil)
+		_Future(const MyBase& state, Nil nil)
 			: MyBase(state)
 		{	// construct from associated asynchronous state object
 		}
@@ -297,9 +425,25 @@ namespace nex
 
 		T get() const
 		{
-			return get_intern();
+			return this->get_intern();
+		}
+
+		/**
+		 * Creates a continuation that is called with this future after it got ready.
+		 * The continuation is executed by the given executor. 
+		 * @return a future holding the result of the continuation.
+		 */
+		template<class Func>
+		auto then(const Executor& executor, Func&& func) const -> _Future<std::invoke_result_t<Func, _Future<T>>>;
+
+		/**
+		 * Creates a continuation that is executed on the thread that completes this future.
+		 */
+		template<class Func>
+		auto then(Func&& func) const -> _Future<std::invoke_result_t<Func, _Future<T>>>
+		{
+			return then(InlineExecutor, std::forward<Func>(func));
 		}
-
 	};
 
 	template<>
@@ -330,7 +474,7 @@ namespace nex
 			return (*this);
 		}
 
-		_Future(const _FutureStateManager& state, Nil nil)
+		_Future(const MyBase& state, Nil nil)
 			: MyBase(state)
 		{	// construct from associated asynchronous state object
 		}
@@ -341,7 +485,24 @@ namespace nex
 
 		void get() const
 		{
-			get_intern();
+			this->get_intern();
+		}
+
+		/**
+		 * Creates a continuation that is called with this future after it got ready.
+		 * The continuation is executed by the given executor.
+		 * @return a future holding the result of the continuation.
+		 */
+		template<class Func>
+		auto then(const Executor& executor, Func&& func) const -> _Future<std::invoke_result_t<Func, _Future<void>>>;
+
+		/**
+		 * Creates a continuation that is executed on the thread that completes this future.
+		 */
+		template<class Func>
+		auto then(Func&& func) const -> _Future<std::invoke_result_t<Func, _Future<void>>>
+		{
+			return then(InlineExecutor, std::forward<Func>(func));
 		}
 	};
 
@@ -446,6 +607,145 @@ namespace nex
 	};
 
 
+	/**
+	 * Helper for fulfilling a promise with the result of a continuation.
+	 */
+	template<class R>
+	struct _ContinuationInvoker
+	{
+		template<class Func, class FutureType>
+		static void invoke(_PromiseBase<R>& promise, Func& func, FutureType& future)
+		{
+			promise.set_value(func(future));
+		}
+	};
+
+	template<>
+	struct _ContinuationInvoker<void>
+	{
+		template<class Func, class FutureType>
+		static void invoke(_PromiseBase<void>& promise, Func& func, FutureType& future)
+		{
+			func(future);
+			promise.set();
+		}
+	};
+
+	template<class R, class Func, class FutureType>
+	void _invokeContinuation(_PromiseBase<R>& promise, Func& func, FutureType& future)
+	{
+		try {
+			_ContinuationInvoker<R>::invoke(promise, func, future);
+		}
+		catch (const std::exception& e) {
+			promise.set_exception(std::make_shared<std::exception>(e));
+		}
+		catch (...) {
+			// the promise has to get ready in any case, otherwise dependent futures would wait forever
+			promise.set_exception(std::make_shared<std::runtime_error>("Unknown exception in future continuation"));
+		}
+	}
+
+	template<class T>
+	template<class Func>
+	auto _Future<T>::then(const Executor& executor, Func&& func) const -> _Future<std::invoke_result_t<Func, _Future<T>>>
+	{
+		using R = std::invoke_result_t<Func, _Future<T>>;
+		_PromiseBase<R> promise;
+		auto result = promise.get_future();
+
+		this->add_continuation([executor, promise, self = *this, func = std::forward<Func>(func)]() mutable {
+			executor([promise, self, func = std::move(func)]() mutable {
+				_invokeContinuation(promise, func, self);
+			});
+		});
+
+		return result;
+	}
+
+	template<class Func>
+	auto _Future<void>::then(const Executor& executor, Func&& func) const -> _Future<std::invoke_result_t<Func, _Future<void>>>
+	{
+		using R = std::invoke_result_t<Func, _Future<void>>;
+		_PromiseBase<R> promise;
+		auto result = promise.get_future();
+
+		this->add_continuation([executor, promise, self = *this, func = std::forward<Func>(func)]() mutable {
+			executor([promise, self, func = std::move(func)]() mutable {
+				_invokeContinuation(promise, func, self);
+			});
+		});
+
+		return result;
+	}
+
+	/**
+	 * Creates a future that gets ready after all given futures are ready.
+	 * The result holds the (ready) input futures.
+	 */
+	template<class T>
+	Future<std::vector<Future<T>>> when_all(std::vector<Future<T>> futures)
+	{
+		struct Context {
+			std::atomic<size_t> remaining;
+			std::vector<Future<T>> futures;
+			Promise<std::vector<Future<T>>> promise;
+		};
+
+		auto context = std::make_shared<Context>();
+		auto result = context->promise.get_future();
+
+		if (futures.empty()) {
+			context->promise.set_value({});
+			return result;
+		}
+
+		context->remaining = futures.size();
+		context->futures = std::move(futures);
+
+		for (const auto& future : context->futures) {
+			future.add_continuation([context]() {
+				if (--context->remaining == 0) {
+					context->promise.set_value(std::move(context->futures));
+				}
+			});
+		}
+
+		return result;
+	}
+
+	/**
+	 * Creates a future that gets ready as soon as one of the given futures is ready.
+	 * The result is the index of the first ready future.
+	 * @throws std::invalid_argument : if futures is empty (the result would never get ready).
+	 */
+	template<class T>
+	Future<size_t> when_any(const std::vector<Future<T>>& futures)
+	{
+		if (futures.empty()) {
+			throw std::invalid_argument("nex::when_any : futures mustn't be empty!");
+		}
+
+		struct Context {
+			std::atomic<bool> finished = false;
+			Promise<size_t> promise;
+		};
+
+		auto context = std::make_shared<Context>();
+		auto result = context->promise.get_future();
+
+		for (size_t i = 0; i < futures.size(); ++i) {
+			futures[i].add_continuation([context, i]() {
+				if (!context->finished.exchange(true)) {
+					context->promise.set_value(i);
+				}
+			});
+		}
+
+		return result;
+	}
+
+
 	template<class> class _PackagedTaskState;
 
 	template<class Func, class... ArgsType>
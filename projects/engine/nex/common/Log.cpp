@@ -1,5 +1,10 @@
 #include "Log.hpp"
 #include <nex/util/StringUtils.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <thread>
 
 using namespace nex;
 
@@ -174,11 +179,7 @@ void Logger::log(const char* msg, LogLevel level) const
 
 	if (!sink) return;
 
-	for (auto stream : sink->getLogStreams()) {
-		if (!stream) continue;
-		*stream << msg << std::endl;
-	}
-		
+	sink->write(msg, level);
 }
 
 void Logger::setPrefix(const char* prefix)
@@ -255,8 +256,102 @@ LoggerManager::LoggerManager() : mLogMask(Always)
 {
 }
 
-LogSink::LogSink()
+/**
+ * Lock-free single producer/single consumer ring buffer for the log messages of one thread.
+ * The owning thread is the producer; the consumer is the thread that drains the log sink (guarded by a mutex).
+ */
+struct LogThreadBuffer
+{
+	static constexpr uint64_t IDLE = std::numeric_limits<uint64_t>::max();
+
+	struct Record {
+		uint64_t sequence;
+		std::string text; // keeps its capacity, so that steady state logging doesn't allocate
+	};
+
+	explicit LogThreadBuffer(size_t capacity) : records(capacity)
+	{
+	}
+
+	std::vector<Record> records;
+	alignas(64) std::atomic<size_t> head = 0; // next write position; modified by the producer only
+	alignas(64) std::atomic<size_t> tail = 0; // next read position; modified by the consumer only
+	std::atomic<uint64_t> writing = IDLE; // lower bound of the sequence number of the record that is currently written
+	std::atomic<bool> orphaned = false; // the owning thread has exited
+};
+
+struct LogSink::AsyncState
+{
+	/**
+	 * Range of records of one thread buffer that is written by the current drain.
+	 */
+	struct Cursor {
+		LogThreadBuffer* buffer;
+		size_t next;
+		size_t end;
+	};
+
+	AsyncConfig config;
+	std::atomic<bool> enabled = false;
+	std::atomic<int> writers = 0; // threads that are in LogSink::write
+	std::atomic<uint64_t> sequence = 0;
+	std::atomic<size_t> dropped = 0;
+	size_t reportedDropped = 0;
+
+	std::mutex registryMutex;
+	std::vector<std::shared_ptr<LogThreadBuffer>> buffers;
+
+	std::mutex drainMutex;
+	std::vector<std::shared_ptr<LogThreadBuffer>> drainBuffers;
+	std::vector<Cursor> cursors;
+	std::vector<const std::string*> ordered;
+
+	std::thread flusher;
+	std::mutex flusherMutex;
+	std::condition_variable flusherCondition;
+	bool running = false;
+};
+
+namespace
 {
+	/**
+	 * Marks the buffer of a thread as orphaned if the thread exits, so that the buffer can be released after it got drained.
+	 */
+	struct LogThreadBufferHandle
+	{
+		std::shared_ptr<LogThreadBuffer> buffer;
+
+		~LogThreadBufferHandle()
+		{
+			if (buffer) buffer->orphaned = true;
+		}
+	};
+
+	thread_local LogThreadBufferHandle gLogThreadBuffer;
+
+	bool isDroppable(LogLevel level)
+	{
+		return level != Error && level != Fault;
+	}
+
+	struct WriterGuard
+	{
+		std::atomic<int>& writers;
+
+		~WriterGuard()
+		{
+			writers.fetch_sub(1);
+		}
+	};
+}
+
+LogSink::LogSink() : mAsync(std::make_unique<AsyncState>())
+{
+}
+
+LogSink::~LogSink()
+{
+	stopAsync();
 }
 
 LogSink* LogSink::get()
@@ -265,12 +360,240 @@ LogSink* LogSink::get()
 	return &sink;
 }
 
-void LogSink::registerStream(std::ostream* stream)
+void LogSink::flush()
 {
-	mStreams.push_back(stream);
+	if (isAsync()) {
+		drain();
+	}
+
+	std::unique_lock<std::mutex> lock(mStreamMutex);
+	for (auto* stream : mStreams) {
+		if (stream) stream->flush();
+	}
+}
+
+size_t LogSink::getDroppedCount() const
+{
+	return mAsync->dropped;
 }
 
 const std::vector<std::ostream*>& LogSink::getLogStreams() const
 {
 	return mStreams;
-}
\ No newline at end of file
+}
+
+bool LogSink::isAsync() const
+{
+	return mAsync->enabled.load(std::memory_order_acquire);
+}
+
+void LogSink::registerStream(std::ostream* stream)
+{
+	std::unique_lock<std::mutex> lock(mStreamMutex);
+	mStreams.push_back(stream);
+}
+
+void LogSink::startAsync()
+{
+	startAsync(AsyncConfig());
+}
+
+void LogSink::startAsync(const AsyncConfig& config)
+{
+	if (isAsync()) return;
+
+	mAsync->config = config;
+	if (mAsync->config.bufferCapacity < 2) mAsync->config.bufferCapacity = 2;
+
+	{
+		std::unique_lock<std::mutex> lock(mAsync->flusherMutex);
+		mAsync->running = true;
+	}
+
+	mAsync->flusher = std::thread([this]() { runFlusher(); });
+	mAsync->enabled.store(true, std::memory_order_release);
+}
+
+void LogSink::stopAsync()
+{
+	if (!isAsync()) return;
+
+	mAsync->enabled.store(false);
+
+	// Wait for threads that have seen the asynchronous mode before; the flusher still runs, so that blocked writers can proceed.
+	while (mAsync->writers.load() != 0) {
+		mAsync->flusherCondition.notify_one();
+		std::this_thread::yield();
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mAsync->flusherMutex);
+		mAsync->running = false;
+	}
+	mAsync->flusherCondition.notify_all();
+
+	if (mAsync->flusher.joinable()) mAsync->flusher.join();
+
+	// Write messages that have been pushed while stopping
+	drain();
+	flush();
+}
+
+void LogSink::write(const char* msg, LogLevel level)
+{
+	auto& state = *mAsync;
+
+	// Register as writer before checking the mode, so that stopAsync can't miss messages that are pushed to the ring buffers.
+	state.writers.fetch_add(1);
+
+	if (!state.enabled.load()) {
+		state.writers.fetch_sub(1);
+
+		std::unique_lock<std::mutex> lock(mStreamMutex);
+		for (auto* stream : mStreams) {
+			if (!stream) continue;
+			*stream << msg << std::endl;
+		}
+		return;
+	}
+
+	WriterGuard guard{ state.writers };
+	auto& handle = gLogThreadBuffer;
+
+	if (!handle.buffer) {
+		handle.buffer = std::make_shared<LogThreadBuffer>(state.config.bufferCapacity);
+		std::unique_lock<std::mutex> lock(state.registryMutex);
+		state.buffers.push_back(handle.buffer);
+	}
+
+	auto& buffer = *handle.buffer;
+	const size_t capacity = buffer.records.size();
+	const size_t head = buffer.head.load(std::memory_order_relaxed);
+
+	while (head - buffer.tail.load(std::memory_order_acquire) >= capacity) {
+		if (state.config.overflowPolicy == OverflowPolicy::DROP && isDroppable(level)) {
+			state.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		state.flusherCondition.notify_one();
+		std::this_thread::yield();
+	}
+
+	// Announce a lower bound of the sequence number before taking it, so that drain() holds back later messages of
+	// other threads until this one is published.
+	buffer.writing.store(state.sequence.load());
+
+	auto& record = buffer.records[head % capacity];
+	record.sequence = state.sequence.fetch_add(1);
+	record.text.assign(msg);
+	buffer.head.store(head + 1, std::memory_order_release);
+	buffer.writing.store(LogThreadBuffer::IDLE, std::memory_order_release);
+
+	// Errors should be visible as soon as possible
+	if (!isDroppable(level)) state.flusherCondition.notify_one();
+}
+
+void LogSink::drain()
+{
+	auto& state = *mAsync;
+	std::unique_lock<std::mutex> drainLock(state.drainMutex);
+
+	auto& buffers = state.drainBuffers;
+	auto& cursors = state.cursors;
+	auto& ordered = state.ordered;
+
+	{
+		std::unique_lock<std::mutex> lock(state.registryMutex);
+		buffers.assign(state.buffers.begin(), state.buffers.end());
+	}
+
+	// All messages with a lower sequence number than the watermark are published.
+	uint64_t watermark = state.sequence.load();
+	for (const auto& buffer : buffers) {
+		watermark = std::min(watermark, buffer->writing.load());
+	}
+
+	cursors.clear();
+	for (const auto& buffer : buffers) {
+		const size_t capacity = buffer->records.size();
+		const size_t head = buffer->head.load(std::memory_order_acquire);
+		const size_t tail = buffer->tail.load(std::memory_order_relaxed);
+		size_t end = tail;
+
+		while (end != head && buffer->records[end % capacity].sequence < watermark) ++end;
+		if (end != tail) cursors.push_back({ buffer.get(), tail, end });
+	}
+
+	// The records of a thread are sorted by their sequence number, so merging the buffers keeps the chronological order.
+	ordered.clear();
+	for (;;) {
+		AsyncState::Cursor* next = nullptr;
+		uint64_t nextSequence = LogThreadBuffer::IDLE;
+
+		for (auto& cursor : cursors) {
+			if (cursor.next == cursor.end) continue;
+			const auto sequence = cursor.buffer->records[cursor.next % cursor.buffer->records.size()].sequence;
+			if (sequence < nextSequence) {
+				next = &cursor;
+				nextSequence = sequence;
+			}
+		}
+
+		if (!next) break;
+		ordered.push_back(&next->buffer->records[next->next % next->buffer->records.size()].text);
+		++next->next;
+	}
+
+	const size_t dropped = state.dropped.load(std::memory_order_relaxed);
+	const size_t newDropped = dropped - state.reportedDropped;
+	state.reportedDropped = dropped;
+
+	if (!ordered.empty() || newDropped > 0) {
+		std::unique_lock<std::mutex> lock(mStreamMutex);
+		for (auto* stream : mStreams) {
+			if (!stream) continue;
+
+			for (const auto* text : ordered) {
+				*stream << *text << '\n';
+			}
+
+			if (newDropped > 0) {
+				*stream << "[LogSink] [" << Warning << "]: " << newDropped << " log messages dropped due to full buffers" << '\n';
+			}
+
+			stream->flush();
+		}
+	}
+
+	// The records have been written; the producers may reuse them now.
+	for (const auto& cursor : cursors) {
+		cursor.buffer->tail.store(cursor.end, std::memory_order_release);
+	}
+
+	buffers.clear();
+
+	{
+		// release buffers of exited threads
+		std::unique_lock<std::mutex> lock(state.registryMutex);
+		state.buffers.erase(std::remove_if(state.buffers.begin(), state.buffers.end(), [](const auto& buffer) {
+			return buffer->orphaned && buffer->head.load(std::memory_order_acquire) == buffer->tail.load(std::memory_order_relaxed);
+		}), state.buffers.end());
+	}
+}
+
+void LogSink::runFlusher()
+{
+	auto& state = *mAsync;
+	const auto interval = std::chrono::milliseconds(state.config.flushIntervalMillis);
+
+	std::unique_lock<std::mutex> lock(state.flusherMutex);
+
+	while (state.running) {
+		state.flusherCondition.wait_for(lock, interval);
+
+		lock.unlock();
+		drain();
+		lock.lock();
+	}
+}
@@ -2,6 +2,8 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <memory>
+#include <mutex>
 #include <boost/optional/optional.hpp>
 
 
@@ -118,16 +120,88 @@ namespace nex
 		unsigned char mLogMask;
 	};
 
+	/**
+	 * The log sink writes log messages to the registered streams.
+	 * 
+	 * By default, messages are written synchronously on the calling thread. In asynchronous mode (see startAsync) 
+	 * each thread pushes its (pre-formatted) messages to its own lock-free ring buffer and a background thread 
+	 * writes them to the streams. Messages of different threads keep their chronological order: The background thread
+	 * merges the ring buffers by sequence number and holds back messages until all earlier messages are published.
+	 */
 	class LogSink
 	{
 	public:
 
+		/**
+		 * Specifies what happens if the ring buffer of a thread is full.
+		 */
+		enum class OverflowPolicy {
+			DROP, // Message is discarded (and counted). Note: Messages with level Error or Fault are never dropped.
+			BLOCK, // Thread waits until the background thread has made room.
+		};
+
+		struct AsyncConfig {
+			size_t bufferCapacity = 4096; // Maximum number of pending messages per thread
+			OverflowPolicy overflowPolicy = OverflowPolicy::DROP;
+			unsigned flushIntervalMillis = 10; // Maximum time a message waits till it gets written
+		};
+
 		LogSink();
+		~LogSink();
 
 		static LogSink* get();
-		void registerStream(std::ostream* stream);
+
+		/**
+		 * Writes all pending messages and flushes the registered streams. 
+		 * Should be called on crash paths, so that no log message gets lost.
+		 */
+		void flush();
+
+		/**
+		 * Provides the number of messages that have been dropped due to full ring buffers.
+		 */
+		size_t getDroppedCount() const;
+
 		const std::vector<std::ostream*>& getLogStreams() const;
+
+		bool isAsync() const;
+
+		/**
+		 * Note: Streams should be registered before the asynchronous mode is started.
+		 */
+		void registerStream(std::ostream* stream);
+
+		/**
+		 * Starts writing log messages on a background thread.
+		 */
+		void startAsync();
+		void startAsync(const AsyncConfig& config);
+
+		/**
+		 * Writes all pending messages, stops the background thread and switches back to synchronous mode.
+		 * Has to be called before a registered stream gets destroyed.
+		 */
+		void stopAsync();
+
+		/**
+		 * Writes a formatted log message (either synchronously or asynchronously).
+		 */
+		void write(const char* msg, LogLevel level);
+
 		std::vector<std::ostream*> mStreams;
+
+	private:
+		struct AsyncState;
+
+		/**
+		 * Writes pending messages of all threads to the streams.
+		 */
+		void drain();
+
+		void runFlusher();
+
+		std::unique_ptr<AsyncState> mAsync;
+		std::mutex mStreamMutex;
 	};
 
 	template <typename T>
@@ -0,0 +1,111 @@
+#include <nex/common/MappedFile.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+nex::MappedFile::MappedFile(const std::filesystem::path& path) :
+	mPath(path),
+	mData(nullptr),
+	mSize(0),
+	mFileHandle(nullptr),
+	mMappingHandle(nullptr)
+{
+	const auto error = [&](const char* what) {
+		return std::runtime_error("nex::MappedFile : " + std::string(what) + ": " + path.generic_string());
+	};
+
+#ifdef _WIN32
+	auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) throw_with_trace(error("Couldn't open file"));
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		throw_with_trace(error("Couldn't query file size"));
+	}
+
+	mFileHandle = file;
+	mSize = static_cast<size_t>(size.QuadPart);
+
+	// empty files cannot be mapped
+	if (mSize == 0) return;
+
+	auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		throw_with_trace(error("Couldn't create file mapping"));
+	}
+
+	mMappingHandle = mapping;
+	mData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+	if (!mData) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw_with_trace(error("Couldn't map file"));
+	}
+#else
+	const auto fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw_with_trace(error("Couldn't open file"));
+
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		::close(fd);
+		throw_with_trace(error("Couldn't query file size"));
+	}
+
+	mSize = static_cast<size_t>(info.st_size);
+
+	if (mSize > 0) {
+		auto* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			::close(fd);
+			throw_with_trace(error("Couldn't map file"));
+		}
+
+		// the data is read front to back once
+		madvise(data, mSize, MADV_SEQUENTIAL);
+		mData = static_cast<const char*>(data);
+	}
+
+	// the mapping stays valid after the descriptor is closed
+	::close(fd);
+#endif
+}
+
+nex::MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (mData) UnmapViewOfFile(mData);
+	if (mMappingHandle) CloseHandle(mMappingHandle);
+	if (mFileHandle) CloseHandle(mFileHandle);
+#else
+	if (mData) munmap(const_cast<char*>(mData), mSize);
+#endif
+}
+
+const char* nex::MappedFile::getData() const
+{
+	return mData;
+}
+
+size_t nex::MappedFile::getSize() const
+{
+	return mSize;
+}
+
+const std::filesystem::path& nex::MappedFile::getPath() const
+{
+	return mPath;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+
+namespace nex
+{
+	/**
+	 * A file mapped read only into the address space of the process.
+	 * The content is paged in on demand by the operating system; no copy is made.
+	 */
+	class MappedFile
+	{
+	public:
+
+		/**
+		 * Maps a file.
+		 * @throws std::runtime_error : if the file couldn't be opened or mapped.
+		 */
+		explicit MappedFile(const std::filesystem::path& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		const char* getData() const;
+		size_t getSize() const;
+
+		const std::filesystem::path& getPath() const;
+
+	private:
+		std::filesystem::path mPath;
+		const char* mData;
+		size_t mSize;
+
+		// platform handles
+		void* mFileHandle;
+		void* mMappingHandle;
+	};
+}
@@ -8,6 +8,7 @@
 #include "nex/math/Ray.hpp"
 #include <nex/math/Math.hpp>
 #include <nex/mesh/MeshManager.hpp>
+#include <nex/renderer/RenderEngine.hpp>
 #include "nex/camera/Camera.hpp"
 #include <nex/math/Math.hpp>
 #include <nex/math/Constant.hpp>
@@ -424,6 +425,9 @@ void nex::gui::Gizmo::initSceneNode(Vob* vob, const char* debugName)
 	vob->getName() = debugName;
 	vob->setSelectable(false);
 	vob->updateTrafo(true);
+
+	// the gizmo owns its vobs, so it is responsible for finalizing their meshes
+	RenderEngine::getFinalizeScheduler()->submitStepped(vob->createStepwiseMeshFinalizer());
 }
 
 bool nex::gui::Gizmo::isHovering(const Ray& screenRayWorld, const Camera& camera, bool fillActive)
@@ -177,9 +177,10 @@ nex::Vob* nex::gui::Picker::pick(Scene& scene, const Ray& screenRayWorld, bool p
 		selected.vob = nullptr;
 	}
 
-	for (const auto& root : scene.getActiveVobsUnsafe())
+	// only vobs whose world bounding box is hit by the ray can be picked
+	scene.queryRayUnsafe(screenRayWorld, std::numeric_limits<float>::max(), [&](Vob* root)
 	{
-		if (!root->getSelectable() || !root->isVisible()) continue;
+		if (!root->getSelectable() || !root->isVisible()) return;
 
 		const auto invModel = inverse(root->getTrafoLocalToWorld());
 		const auto origin = glm::vec3(invModel * glm::vec4(screenRayWorld.getOrigin(), 1.0f));
@@ -211,7 +212,7 @@ nex::Vob* nex::gui::Picker::pick(Scene& scene, const Ray& screenRayWorld, bool p
 					selected = current;
 			}
 		}
-	}
+	});
 
 	deselect(scene);
 
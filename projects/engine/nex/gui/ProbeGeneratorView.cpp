@@ -65,6 +65,6 @@ void nex::gui::ProbeGeneratorView::drawSelf()
 				});
 
 			return nullptr;
-			});
+			}, ResourceLoader::JobPriority::VisibleNow, ResourceLoader::JobAffinity::Any); // only schedules render work for the main thread
 	}
 }
\ No newline at end of file
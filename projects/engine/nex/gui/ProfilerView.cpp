@@ -0,0 +1,117 @@
+#include <nex/gui/ProfilerView.hpp>
+#include <nex/util/Profiler.hpp>
+#include <nex/util/AllocationCounter.hpp>
+#include <nex/util/FrameArena.hpp>
+#include <nex/renderer/StateChangeStatistics.hpp>
+#include <imgui/imgui.h>
+#include <nex/gui/ImGUI_Extension.hpp>
+#include <algorithm>
+#include <cstring>
+
+nex::gui::ProfilerView::ProfilerView(std::string title, MainMenuBar* menuBar, Menu* menu) :
+	MenuWindow(std::move(title), menuBar, menu, COMMON_FLAGS),
+	mFrameTimes(HISTORY_SIZE, 0.0f),
+	mHistoryOffset(0),
+	mExportPath("profile.json"),
+	mPaused(false)
+{
+}
+
+nex::gui::ProfilerView::~ProfilerView() = default;
+
+void nex::gui::ProfilerView::drawSelf()
+{
+#ifndef EUCLID_PROFILING
+	ImGui::Text("Profiling is disabled. Build with USE_EUCLID_PROFILING to enable it.");
+#endif
+
+	auto* profiler = Profiler::get();
+	const auto& frame = profiler->getLastFrame();
+	const float frameMillis = (frame.end - frame.start) / 1000000.0f;
+
+	if (!mPaused) {
+		mFrameTimes[mHistoryOffset] = frameMillis;
+		mHistoryOffset = (mHistoryOffset + 1) % mFrameTimes.size();
+	}
+
+	ImGui::Checkbox("Pause", &mPaused);
+	ImGui::PlotLines("Frame time (ms)", mFrameTimes.data(), static_cast<int>(mFrameTimes.size()), 
+		static_cast<int>(mHistoryOffset), nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+
+	nex::gui::Separator(2.0f);
+
+	bool capturing = profiler->isCapturing();
+	if (ImGui::Checkbox("Capture frames", &capturing)) {
+		profiler->setCapturing(capturing);
+	}
+	ImGui::SameLine();
+	ImGui::Text("%zu frames captured", profiler->getCapturedFrameCount());
+
+	char pathBuffer[256];
+	const size_t length = std::min(mExportPath.size(), sizeof(pathBuffer) - 1);
+	memcpy(pathBuffer, mExportPath.data(), length);
+	pathBuffer[length] = '\0';
+
+	if (ImGui::InputText("Export path", pathBuffer, sizeof(pathBuffer))) {
+		mExportPath = pathBuffer;
+	}
+
+	if (ImGui::Button("Export chrome trace")) {
+		mExportStatus = profiler->exportChromeTrace(mExportPath) ? "Exported to " + mExportPath : "Couldn't write " + mExportPath;
+	}
+	if (!mExportStatus.empty()) {
+		ImGui::SameLine();
+		ImGui::Text("%s", mExportStatus.c_str());
+	}
+
+	nex::gui::Separator(2.0f);
+
+	if (AllocationCounter::isEnabled()) {
+		ImGui::Text("Heap allocations (last frame): %llu total, %llu main thread", 
+			static_cast<unsigned long long>(AllocationCounter::getLastFrameCount()),
+			static_cast<unsigned long long>(AllocationCounter::getLastFrameThreadCount()));
+	}
+	else {
+		ImGui::Text("Allocation counting is disabled. Build with USE_EUCLID_ALLOCATION_COUNTING to enable it.");
+	}
+
+	auto* arena = FrameArena::get();
+	ImGui::Text("Frame arena: %.2f / %.2f MB used, %.2f MB overflow", arena->getUsedBytes() / (1024.0f * 1024.0f),
+		arena->getCapacity() / (1024.0f * 1024.0f), arena->getOverflowBytes() / (1024.0f * 1024.0f));
+
+	const auto stateChanges = StateChangeStatistics::getLastFrameTotal();
+	if (ImGui::TreeNode("State changes", "State changes (last frame): %llu issued, %llu filtered",
+		static_cast<unsigned long long>(stateChanges.issued), static_cast<unsigned long long>(stateChanges.filtered))) {
+		for (size_t i = 0; i < static_cast<size_t>(StateChangeStatistics::Category::COUNT); ++i) {
+			const auto category = static_cast<StateChangeStatistics::Category>(i);
+			const auto& counts = StateChangeStatistics::getLastFrameCounts(category);
+			ImGui::Text("%s: %llu issued, %llu filtered", StateChangeStatistics::getName(category),
+				static_cast<unsigned long long>(counts.issued), static_cast<unsigned long long>(counts.filtered));
+		}
+		ImGui::TreePop();
+	}
+
+	nex::gui::Separator(2.0f);
+
+	ImGui::Text("Last frame: %.3f ms", frameMillis);
+
+	for (const auto& thread : frame.threads) {
+
+		if (thread.zones.empty()) continue;
+
+		ImGui::PushID(thread.threadID);
+
+		if (ImGui::CollapsingHeader(thread.threadName.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
+			for (const auto& zone : thread.zones) {
+				const float millis = (zone.end - zone.start) / 1000000.0f;
+				ImGui::Text("%*s%s: %.3f ms", static_cast<int>(zone.depth * 2), "", zone.name, millis);
+			}
+
+			if (thread.droppedZones > 0) {
+				ImGui::Text("%u zones dropped (limit: %zu per frame)", thread.droppedZones, Profiler::MAX_ZONES_PER_FRAME);
+			}
+		}
+
+		ImGui::PopID();
+	}
+}
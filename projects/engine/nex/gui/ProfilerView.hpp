@@ -0,0 +1,34 @@
+#pragma once
+
+#include <nex/gui/MenuWindow.hpp>
+#include <string>
+#include <vector>
+
+namespace nex::gui
+{
+	/**
+	 * Live view of the cpu profiler: Shows the frame time history and the zones of the last frame per thread.
+	 * Frames can be captured and exported to the chrome trace format.
+	 */
+	class ProfilerView : public nex::gui::MenuWindow
+	{
+	public:
+		ProfilerView(std::string title,
+			nex::gui::MainMenuBar* menuBar,
+			nex::gui::Menu* menu);
+
+		virtual ~ProfilerView();
+
+	protected:
+
+		void drawSelf() override;
+
+		static constexpr size_t HISTORY_SIZE = 120;
+
+		std::vector<float> mFrameTimes;
+		size_t mHistoryOffset;
+		std::string mExportPath;
+		std::string mExportStatus;
+		bool mPaused;
+	};
+}
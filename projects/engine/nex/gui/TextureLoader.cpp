@@ -59,5 +59,5 @@ nex::Future<nex::Resource*> nex::gui::TextureLoader::selectTexture()
 		}
 
 		return nullptr;
-	});
+	}, nex::ResourceLoader::JobPriority::VisibleNow);
 }
\ No newline at end of file
@@ -35,7 +35,7 @@ nex::VisualizationSphere::VisualizationSphere(Scene* scene) :
 		});
 
 		return &mVisualizationMG;
-	});
+	}, nex::ResourceLoader::JobPriority::Normal, nex::ResourceLoader::JobAffinity::Any); // only schedules render work for the main thread
 }
 
 nex::VisualizationSphere::~VisualizationSphere() = default;
@@ -39,7 +39,7 @@ bool nex::gui::RiggedVobView::draw(Vob* vob, Scene* scene, Picker* picker, Camer
 
 
 	auto* animationManager = nex::AnimationManager::get();
-	const auto& aniSet = animationManager->getBoneAnimationsByRig(rig);
+	const auto aniSet = animationManager->getBoneAnimationsByRig(rig);
 	auto animations =  std::vector<const nex::BoneAnimation*>(begin(aniSet), end(aniSet));
 	std::sort(begin(animations), end(animations), [](const auto* a, const auto* b) {
 		return std::lexicographical_compare(begin(a->getName()), end(a->getName()), 
@@ -150,7 +150,7 @@ nex::Future<nex::Resource*> nex::gui::RiggedVobView::loadAnimation()
 		}
 
 		return nullptr;
-		});
+		}, nex::ResourceLoader::JobPriority::VisibleNow);
 }
 
 
@@ -91,9 +91,7 @@ namespace nex::gui
 			//std::cout << "Selected file: " << result.path << std::endl;
 
 
-			mFuture = ResourceLoader::get()->enqueue<nex::Vob*>([=]()->Vob* {
-				nex::flexible_ptr<Vob> vob = nullptr;
-
+			auto loadFuture = ResourceLoader::get()->enqueue<nex::VobBluePrint*>([=]()->VobBluePrint* {
 				try {
 					auto* deferred = mPbrTechnique->getDeferred();
 					auto* forward = mPbrTechnique->getForward();
@@ -104,9 +102,7 @@ namespace nex::gui
 						forward->getBoneShaderProvider(),
 						TextureManager::get());
 
-					vob = loadVob(result.path.u8string(),
-						RenderEngine::getCommandQueue(),
-						materialLoader);
+					return loadBluePrint(result.path.u8string(), materialLoader);
 				}
 				catch (std::exception & e) {
 					void* nativeWindow = mWindow->getNativeWindow();
@@ -119,16 +115,27 @@ namespace nex::gui
 					boxer::show(msg.c_str(), "", boxer::Style::Error, boxer::Buttons::OK, nativeWindow);
 					return nullptr;
 				}
+			}, ResourceLoader::JobPriority::VisibleNow);
+
+			// Finalization and adding to the scene has to be done on the main thread. The finalization is time sliced
+			// by the finalize scheduler; mFuture gets ready when the vob is added to the scene.
+			auto promise = std::make_shared<Promise<Vob*>>();
+			mFuture = promise->get_future();
 
-				// TODO: Until the task is excuted, the vob's memory isn't managed.
-				// It is unlikely but this could result into a memory leak if the task is not executed (e.g. due a thrown exception)
+			loadFuture.then([=](Future<VobBluePrint*> future) {
+
+				auto* bluePrint = future.has_exception() ? nullptr : future.get();
+				if (!bluePrint) {
+					promise->set_value(nullptr);
+					return;
+				}
 
-				RenderEngine::getCommandQueue()->push([=, ptr = vob.get()]() {
+				// The blue-print finalizes its meshes only once; the vob shares them and mustn't be rendered before.
+				bluePrint->finalizeAsync(FinalizeScheduler::Priority::VisibleNow).then([=](Future<void>) {
 
-					//Note: flex is const
-					nex::flexible_ptr<Vob> vob = nex::make_owning(ptr);
+					auto vob = bluePrint->createBluePrint();
+					auto* ptr = vob.get();
 
-					vob->finalizeMeshes();
 					auto lock = mScene->acquireLock();
 
 					//auto rescaleMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(mUseRescale ? mDefaultScale : 1.0f));
@@ -140,17 +147,15 @@ namespace nex::gui
 					vob->setScaleLocalToParent(vob->getScaleLocalToParent() * glm::vec3(mUseRescale ? mDefaultScale : 1.0f));
 					vob->updateWorldTrafoHierarchy(true);
 
-					mScene->addVobUnsafe(std::unique_ptr<Vob>(vob.release()));
+					mScene->addVobUnsafe(std::move(vob));
 
-					});
-
-				return vob.release();
+					promise->set_value(ptr);
+				});
 			});
 		}
 	}
 
-	std::unique_ptr<nex::Vob> nex::gui::VobLoader::loadVob(const std::filesystem::path& p,
-		nex::RenderEngine::CommandQueue* commandQueue,
+	nex::VobBluePrint* nex::gui::VobLoader::loadBluePrint(const std::filesystem::path& p,
 		const AbstractMaterialLoader& materialLoader,
 		const nex::FileSystem* fileSystem)
 	{
@@ -162,17 +167,12 @@ namespace nex::gui
 
 		if (!bluePrintPtr) {
 			auto vob = MeshManager::get()->loadVobHierarchy(path, materialLoader, 1.0f);
-
-			commandQueue->push([vobPtr = vob.get()]() {
-				vobPtr->finalizeMeshes();
-			});
-
 			auto bluePrint = std::make_unique<VobBluePrint>(std::move(vob));
 			bluePrintPtr = bluePrint.get();
 
 			mBluePrints->insert(id, std::move(bluePrint));
 		}
 
-		return bluePrintPtr->createBluePrint();
+		return bluePrintPtr;
 	}
 }
\ No newline at end of file
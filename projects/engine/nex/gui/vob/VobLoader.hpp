@@ -46,8 +46,11 @@ namespace nex::gui
 
 		void selectAndLoadVob();
 
-		std::unique_ptr<Vob> loadVob(const std::filesystem::path& p,
-			nex::RenderEngine::CommandQueue* commandQueue,
+		/**
+		 * Provides the (cached) blue-print of a vob file. Has to be called from the render context worker.
+		 * Note: The meshes of the blue-print might not be finalized yet (see VobBluePrint::finalizeAsync).
+		 */
+		VobBluePrint* loadBluePrint(const std::filesystem::path& p,
 			const AbstractMaterialLoader& materialLoader,
 			const nex::FileSystem* fileSystem = nullptr);
 
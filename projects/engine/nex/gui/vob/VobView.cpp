@@ -295,6 +295,6 @@ namespace nex::gui
 			}
 
 			return nullptr;
-			});
+			}, ResourceLoader::JobPriority::VisibleNow);
 	}
 }
\ No newline at end of file
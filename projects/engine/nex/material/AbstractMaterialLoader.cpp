@@ -26,8 +26,13 @@ void nex::AbstractMaterialLoader::loadEmbeddedTexture(const std::filesystem::pat
 
 	auto texPath = createEmbeddedTexturePath(meshPathAbsolute, index);
 
-	auto embeddedTex = textureManager->loadEmbeddedImage(texPath, (const unsigned char*)tex->pcData, sizeof(glm::vec4) * tex->mWidth, true, data, detectColorSpace);
-	textureManager->addToCache(std::move(embeddedTex), texPath);
+	// Only decode the texture, as materials are loaded during mesh import (which doesn't need the render context).
+	// The texture is created by createMaterial.
+	textureManager->prefetchEmbeddedImage(texPath, (const unsigned char*)tex->pcData, sizeof(glm::vec4) * tex->mWidth, true, data, detectColorSpace);
+}
+
+void nex::AbstractMaterialLoader::prefetchTextures(const MaterialStore& store) const
+{
 }
 
 vector<string> AbstractMaterialLoader::loadMaterialTextures(const aiScene* scene, const std::filesystem::path& meshPathAbsolute, aiMaterial* mat, aiTextureType type) const
@@ -25,6 +25,12 @@ namespace nex
 
 		virtual std::unique_ptr<Material> createMaterial(const MaterialStore& store) const = 0;
 
+		/**
+		 * Decodes the textures used by a material store (see TextureManager::prefetchImage), so that createMaterial only 
+		 * has to upload them. Doesn't use the render backend and can be called from any resource loader worker.
+		 */
+		virtual void prefetchTextures(const MaterialStore& store) const;
+
 
 	protected:
 		std::vector<std::string> loadMaterialTextures(const aiScene* scene, const std::filesystem::path& meshPathAbsolute, aiMaterial* mat, aiTextureType type) const;
@@ -47,6 +47,12 @@ void nex::Material::setShaderProvider(std::shared_ptr<ShaderProvider> provider)
 {
 	mShaderProvider = std::move(provider);
 }
+
+uint32_t nex::Material::getSortID() const
+{
+	return mSortID.get();
+}
+
 std::ostream& nex::operator<<(std::ostream& os, nex::MaterialType type)
 {
 	os << enumToString(type, materialEnumConversion);
@@ -2,6 +2,7 @@
 #include "nex/util/StringUtils.hpp"
 #include <nex/shader/ShaderType.hpp>
 #include <nex/renderer/RenderTypes.hpp>
+#include <nex/util/SortID.hpp>
 #include <string>
 
 namespace nex
@@ -44,9 +45,15 @@ namespace nex
 
 		void setShaderProvider(std::shared_ptr<ShaderProvider> provider);
 
+		/**
+		 * Provides a small id of this material for sort keys (see SortID).
+		 */
+		uint32_t getSortID() const;
+
 	protected:
 		std::shared_ptr<ShaderProvider> mShaderProvider;
 		RenderState mRenderState;
+		SortID<Material> mSortID;
 	};
 
 	/**
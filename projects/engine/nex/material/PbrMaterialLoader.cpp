@@ -172,6 +172,17 @@ std::unique_ptr<Material> PbrMaterialLoader::createMaterial(const MaterialStore&
 	return material;
 }
 
+void PbrMaterialLoader::prefetchTextures(const MaterialStore& store) const
+{
+	// Note: Has to use the same texture descriptions as createMaterial
+	if (store.albedoMap != "") textureManager->prefetchImage(store.albedoMap, true, SRGB_DESC, true);
+	if (store.emissionMap != "") textureManager->prefetchImage(store.emissionMap, true, SRGB_DESC, true);
+	if (store.aoMap != "") textureManager->prefetchImage(store.aoMap, true, RGB_DESC, true);
+	if (store.metallicMap != "") textureManager->prefetchImage(store.metallicMap, true, RGB_DESC, true);
+	if (store.roughnessMap != "") textureManager->prefetchImage(store.roughnessMap, true, RGB_DESC, true);
+	if (store.normalMap != "") textureManager->prefetchImage(store.normalMap, true, RGB_DESC, true);
+}
+
 nex::AlphaMode nex::PbrMaterialLoader::getAlphaMode(const std::string& name) const
 {
 	if (name == "OPAQUE") return AlphaMode::Opaque;
@@ -25,6 +25,7 @@ namespace nex
 
 		void loadShadingMaterial(const std::filesystem::path& meshPath, const aiScene* scene, MaterialStore& store, unsigned materialIndex, bool isSkinned) const override;
 		std::unique_ptr<Material> createMaterial(const MaterialStore& store) const override;
+		void prefetchTextures(const MaterialStore& store) const override;
 	
 	private:
 		std::shared_ptr<PbrShaderProvider> mStaticDeferredMeshShaderProvider;
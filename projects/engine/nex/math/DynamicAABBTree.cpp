@@ -0,0 +1,368 @@
+#include <nex/math/DynamicAABBTree.hpp>
+#include <cassert>
+#include <limits>
+
+nex::DynamicAABBTree::DynamicAABBTree(float margin) : mRoot(NULL_NODE), mFreeList(NULL_NODE), mProxyCount(0), mMargin(margin)
+{
+}
+
+void nex::DynamicAABBTree::clear()
+{
+	mNodes.clear();
+	mRoot = NULL_NODE;
+	mFreeList = NULL_NODE;
+	mProxyCount = 0;
+}
+
+int32_t nex::DynamicAABBTree::createProxy(const AABB& box, void* userData)
+{
+	const auto proxy = allocateNode();
+	auto& node = mNodes[proxy];
+	node.box = AABB(box.min - mMargin, box.max + mMargin);
+	node.userData = userData;
+	node.height = 0;
+
+	insertLeaf(proxy);
+	++mProxyCount;
+
+	return proxy;
+}
+
+void nex::DynamicAABBTree::destroyProxy(int32_t proxy)
+{
+	assert(mNodes[proxy].isLeaf());
+
+	removeLeaf(proxy);
+	freeNode(proxy);
+	--mProxyCount;
+}
+
+const nex::AABB& nex::DynamicAABBTree::getFatAABB(int32_t proxy) const
+{
+	return mNodes[proxy].box;
+}
+
+nex::DynamicAABBTree::Stats nex::DynamicAABBTree::getStats() const
+{
+	Stats stats;
+	stats.proxyCount = mProxyCount;
+	if (mRoot == NULL_NODE) return stats;
+
+	stats.height = mNodes[mRoot].height;
+
+	float areaSum = 0.0f;
+	for (const auto& node : mNodes) {
+		if (node.height < 0) continue;
+		++stats.nodeCount;
+		if (!node.isLeaf()) areaSum += calcArea(node.box);
+	}
+
+	const auto rootArea = calcArea(mNodes[mRoot].box);
+	stats.areaRatio = rootArea > 0.0f ? areaSum / rootArea : 0.0f;
+
+	return stats;
+}
+
+void* nex::DynamicAABBTree::getUserData(int32_t proxy) const
+{
+	return mNodes[proxy].userData;
+}
+
+bool nex::DynamicAABBTree::moveProxy(int32_t proxy, const AABB& box)
+{
+	auto& node = mNodes[proxy];
+	assert(node.isLeaf());
+
+	if (contains(node.box, box)) {
+		// Shrink the fattened box, if the object got much smaller (e.g. a particle system); otherwise queries would
+		// report the proxy for a much larger area.
+		const auto fatArea = calcArea(node.box);
+		const auto area = calcArea(AABB(box.min - mMargin, box.max + mMargin));
+		if (fatArea <= 4.0f * area) return false;
+	}
+
+	const AABB fatBox(box.min - mMargin, box.max + mMargin);
+
+	// Incremental refit: If the parent still encloses the proxy, the tree structure needn't change.
+	const auto parent = node.parent;
+	if (parent != NULL_NODE && contains(mNodes[parent].box, fatBox)) {
+		node.box = fatBox;
+		return false;
+	}
+
+	removeLeaf(proxy);
+	mNodes[proxy].box = fatBox;
+	insertLeaf(proxy);
+
+	return true;
+}
+
+bool nex::DynamicAABBTree::validate() const
+{
+	if (mRoot == NULL_NODE) return mProxyCount == 0;
+	if (mNodes[mRoot].parent != NULL_NODE) return false;
+
+	size_t leafCount = 0;
+	std::vector<int32_t> stack = {mRoot};
+
+	while (!stack.empty()) {
+		const auto index = stack.back();
+		stack.pop_back();
+		const auto& node = mNodes[index];
+
+		if (node.isLeaf()) {
+			if (node.height != 0 || node.child2 != NULL_NODE) return false;
+			++leafCount;
+			continue;
+		}
+
+		const auto& child1 = mNodes[node.child1];
+		const auto& child2 = mNodes[node.child2];
+		if (child1.parent != index || child2.parent != index) return false;
+		if (node.height != 1 + std::max(child1.height, child2.height)) return false;
+		if (!contains(node.box, child1.box) || !contains(node.box, child2.box)) return false;
+
+		stack.push_back(node.child1);
+		stack.push_back(node.child2);
+	}
+
+	return leafCount == mProxyCount;
+}
+
+int32_t nex::DynamicAABBTree::allocateNode()
+{
+	if (mFreeList == NULL_NODE) {
+		mNodes.emplace_back();
+		return static_cast<int32_t>(mNodes.size() - 1);
+	}
+
+	const auto index = mFreeList;
+	mFreeList = mNodes[index].parent;
+	mNodes[index] = Node();
+	return index;
+}
+
+void nex::DynamicAABBTree::freeNode(int32_t index)
+{
+	auto& node = mNodes[index];
+	node.parent = mFreeList;
+	node.child1 = NULL_NODE;
+	node.child2 = NULL_NODE;
+	node.height = -1;
+	node.userData = nullptr;
+	mFreeList = index;
+}
+
+int32_t nex::DynamicAABBTree::findBestSibling(const AABB& box) const
+{
+	// Descends the tree towards the sibling that minimizes the total surface area increase of the tree:
+	// The cost of choosing a node as sibling is the area of the new parent node plus the area increase of all ancestors.
+	// The search stops if no child can lead to a cheaper sibling (lower bound of the cost of the child's subtree).
+	// See Erin Catto, "Dynamic Bounding Volume Hierarchies" (GDC 2019).
+	const auto boxArea = calcArea(box);
+
+	auto index = mRoot;
+	auto directCost = calcArea(maxAABB(mNodes[index].box, box));
+	float inheritedCost = 0.0f;
+
+	auto bestSibling = index;
+	auto bestCost = directCost;
+
+	while (!mNodes[index].isLeaf()) {
+		const auto& node = mNodes[index];
+
+		const auto cost = directCost + inheritedCost;
+		if (cost < bestCost) {
+			bestSibling = index;
+			bestCost = cost;
+		}
+
+		// the area increase of this node is inherited by its descendants
+		inheritedCost += directCost - calcArea(node.box);
+
+		int32_t children[2] = {node.child1, node.child2};
+		float childDirectCosts[2];
+		float lowerCosts[2];
+
+		for (int i = 0; i < 2; ++i) {
+			const auto& child = mNodes[children[i]];
+			childDirectCosts[i] = calcArea(maxAABB(child.box, box));
+			lowerCosts[i] = std::numeric_limits<float>::max();
+
+			if (child.isLeaf()) {
+				const auto childCost = childDirectCosts[i] + inheritedCost;
+				if (childCost < bestCost) {
+					bestSibling = children[i];
+					bestCost = childCost;
+				}
+			}
+			else {
+				// the cheapest possible sibling in the child's subtree: a node having the same size as the box
+				lowerCosts[i] = inheritedCost + childDirectCosts[i] + std::min(boxArea - calcArea(child.box), 0.0f);
+			}
+		}
+
+		if (bestCost <= lowerCosts[0] && bestCost <= lowerCosts[1]) break;
+
+		const auto next = lowerCosts[0] <= lowerCosts[1] ? 0 : 1;
+		index = children[next];
+		directCost = childDirectCosts[next];
+	}
+
+	return bestSibling;
+}
+
+void nex::DynamicAABBTree::insertLeaf(int32_t leaf)
+{
+	if (mRoot == NULL_NODE) {
+		mRoot = leaf;
+		mNodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	const auto sibling = findBestSibling(mNodes[leaf].box);
+	const auto oldParent = mNodes[sibling].parent;
+
+	const auto newParent = allocateNode();
+	auto& parentNode = mNodes[newParent];
+	parentNode.parent = oldParent;
+	parentNode.box = maxAABB(mNodes[leaf].box, mNodes[sibling].box);
+	parentNode.height = mNodes[sibling].height + 1;
+	parentNode.child1 = sibling;
+	parentNode.child2 = leaf;
+
+	mNodes[sibling].parent = newParent;
+	mNodes[leaf].parent = newParent;
+
+	if (oldParent == NULL_NODE) {
+		mRoot = newParent;
+	}
+	else if (mNodes[oldParent].child1 == sibling) {
+		mNodes[oldParent].child1 = newParent;
+	}
+	else {
+		mNodes[oldParent].child2 = newParent;
+	}
+
+	refitAncestors(oldParent);
+}
+
+void nex::DynamicAABBTree::removeLeaf(int32_t leaf)
+{
+	if (leaf == mRoot) {
+		mRoot = NULL_NODE;
+		return;
+	}
+
+	const auto parent = mNodes[leaf].parent;
+	const auto grandParent = mNodes[parent].parent;
+	const auto sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+	// the sibling replaces the parent
+	mNodes[sibling].parent = grandParent;
+	freeNode(parent);
+
+	if (grandParent == NULL_NODE) {
+		mRoot = sibling;
+	}
+	else {
+		if (mNodes[grandParent].child1 == parent) mNodes[grandParent].child1 = sibling;
+		else mNodes[grandParent].child2 = sibling;
+
+		refitAncestors(grandParent);
+	}
+
+	mNodes[leaf].parent = NULL_NODE;
+}
+
+void nex::DynamicAABBTree::refitAncestors(int32_t index)
+{
+	while (index != NULL_NODE) {
+		refit(index);
+		rotate(index);
+		index = mNodes[index].parent;
+	}
+}
+
+void nex::DynamicAABBTree::rotate(int32_t index)
+{
+	// Swaps a child of the node with a grandchild (the child of the other child), if that reduces the area of the
+	// affected child node. See Erin Catto, "Dynamic Bounding Volume Hierarchies" (GDC 2019).
+	auto& node = mNodes[index];
+	if (node.height < 2) return;
+
+	const auto b = node.child1;
+	const auto c = node.child2;
+
+	float bestReduction = 0.0f;
+	int32_t swapChild = NULL_NODE; // the child to move down
+	int32_t swapGrandChild = NULL_NODE; // the grandchild to move up
+
+	auto evaluate = [&](int32_t child, int32_t other) {
+		const auto& otherNode = mNodes[other];
+		if (otherNode.isLeaf()) return;
+
+		const auto otherArea = calcArea(otherNode.box);
+		const auto& childBox = mNodes[child].box;
+
+		// moving child down and grandchild f up leaves other = union(child, g)
+		const auto f = otherNode.child1;
+		const auto g = otherNode.child2;
+
+		const auto reductionF = otherArea - calcArea(maxAABB(childBox, mNodes[g].box));
+		if (reductionF > bestReduction) {
+			bestReduction = reductionF;
+			swapChild = child;
+			swapGrandChild = f;
+		}
+
+		const auto reductionG = otherArea - calcArea(maxAABB(childBox, mNodes[f].box));
+		if (reductionG > bestReduction) {
+			bestReduction = reductionG;
+			swapChild = child;
+			swapGrandChild = g;
+		}
+	};
+
+	evaluate(b, c);
+	evaluate(c, b);
+
+	if (swapChild == NULL_NODE) return;
+
+	const auto other = mNodes[swapGrandChild].parent;
+
+	// swap child and grandchild
+	if (node.child1 == swapChild) node.child1 = swapGrandChild;
+	else node.child2 = swapGrandChild;
+
+	auto& otherNode = mNodes[other];
+	if (otherNode.child1 == swapGrandChild) otherNode.child1 = swapChild;
+	else otherNode.child2 = swapChild;
+
+	mNodes[swapGrandChild].parent = index;
+	mNodes[swapChild].parent = other;
+
+	refit(other);
+	refit(index);
+}
+
+void nex::DynamicAABBTree::refit(int32_t index)
+{
+	auto& node = mNodes[index];
+	const auto& child1 = mNodes[node.child1];
+	const auto& child2 = mNodes[node.child2];
+	node.box = maxAABB(child1.box, child2.box);
+	node.height = 1 + std::max(child1.height, child2.height);
+}
+
+float nex::DynamicAABBTree::calcArea(const AABB& box)
+{
+	const auto d = box.max - box.min;
+	return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+bool nex::DynamicAABBTree::contains(const AABB& outer, const AABB& inner)
+{
+	return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+		&& inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
@@ -0,0 +1,368 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <nex/math/BoundingBox.hpp>
+#include <nex/math/Ray.hpp>
+#include <nex/math/Sphere.hpp>
+#include <nex/camera/Camera.hpp>
+
+namespace nex
+{
+	/**
+	 * A dynamic bounding volume hierarchy of axis aligned bounding boxes.
+	 *
+	 * Each object is represented by a proxy (a leaf of the tree) that stores a fattened bounding box of the object.
+	 * Moving an object only restructures the tree if the new bounding box leaves the fattened box.
+	 * Leaves are inserted at the position that increases the surface area of the tree the least (surface area heuristic)
+	 * and tree rotations are applied on the insertion path to keep the tree balanced.
+	 *
+	 * Queries report proxies whose fattened box passes the query test, so results are conservative: The caller has to
+	 * test the actual object bounds, if exact results are needed.
+	 * Queries don't modify the tree, so they can be executed concurrently.
+	 */
+	class DynamicAABBTree
+	{
+	public:
+
+		static constexpr int32_t NULL_NODE = -1;
+
+		struct Stats {
+			size_t proxyCount = 0;
+			size_t nodeCount = 0;
+			int32_t height = 0;
+			/**
+			 * Sum of the surface areas of all internal nodes divided by the surface area of the root.
+			 * Lower is better.
+			 */
+			float areaRatio = 0.0f;
+		};
+
+		/**
+		 * @param margin : Specifies how much the proxy boxes are enlarged (in each direction).
+		 */
+		explicit DynamicAABBTree(float margin = 0.1f);
+
+		void clear();
+
+		/**
+		 * Creates a new proxy.
+		 * @param box : A valid bounding box.
+		 * @return the id of the proxy.
+		 */
+		int32_t createProxy(const AABB& box, void* userData);
+
+		void destroyProxy(int32_t proxy);
+
+		/**
+		 * Provides the fattened bounding box of a proxy.
+		 */
+		const AABB& getFatAABB(int32_t proxy) const;
+
+		Stats getStats() const;
+
+		void* getUserData(int32_t proxy) const;
+
+		/**
+		 * Updates the bounding box of a proxy.
+		 * @param box : A valid bounding box.
+		 * @return true, if the proxy has been reinserted (i.e. the box has left the fattened box).
+		 */
+		bool moveProxy(int32_t proxy, const AABB& box);
+
+		/**
+		 * Calls callback(proxy) for all proxies overlapping a bounding box.
+		 */
+		template<class Callback>
+		void queryAABB(const AABB& box, Callback&& callback) const;
+
+		/**
+		 * Calls callback(proxy) for all proxies intersecting a frustum.
+		 */
+		template<class Callback>
+		void queryFrustum(const Frustum& frustum, Callback&& callback) const;
+
+		/**
+		 * Calls callback(proxy) for all proxies whose box is hit by a ray within the multiplier range [0, maxMultiplier].
+		 */
+		template<class Callback>
+		void queryRay(const Ray& ray, float maxMultiplier, Callback&& callback) const;
+
+		/**
+		 * Calls callback(proxy) for all proxies intersecting a sphere.
+		 */
+		template<class Callback>
+		void querySphere(const Sphere& sphere, Callback&& callback) const;
+
+		/**
+		 * Finds the k proxies nearest to a point, measured by the squared distance between point and proxy box.
+		 * Note: Fattened boxes are used, so the result is exact only for margin 0. Use a separate tree with margin 0
+		 * for exact nearest neighbour queries.
+		 * @param filter : filter(proxy) specifies whether a proxy is a valid candidate.
+		 * @param result : Receives the found proxies, sorted by distance (nearest first).
+		 */
+		template<class Filter>
+		void queryNearest(const glm::vec3& point, size_t k, Filter&& filter, std::vector<int32_t>& result) const;
+
+		/**
+		 * Checks the structural integrity of the tree (for debugging purposes).
+		 */
+		bool validate() const;
+
+	private:
+
+		struct Node {
+			AABB box;
+			void* userData = nullptr;
+			// Note: Used as next pointer of the free list for unused nodes.
+			int32_t parent = NULL_NODE;
+			int32_t child1 = NULL_NODE;
+			int32_t child2 = NULL_NODE;
+			// leaf = 0, free node = -1
+			int32_t height = -1;
+
+			bool isLeaf() const { return child1 == NULL_NODE; }
+		};
+
+		int32_t allocateNode();
+		void freeNode(int32_t node);
+
+		int32_t findBestSibling(const AABB& box) const;
+		void insertLeaf(int32_t leaf);
+		void removeLeaf(int32_t leaf);
+
+		/**
+		 * Recalculates the bounding boxes and heights of the ancestors of a node and applies tree rotations.
+		 */
+		void refitAncestors(int32_t node);
+		void rotate(int32_t node);
+		void refit(int32_t node);
+
+		/**
+		 * Traversal stack of the queries. Uses heap memory only for very deep trees.
+		 */
+		class Stack {
+		public:
+			void push(int32_t value) {
+				if (mSize < LOCAL_CAPACITY) mLocal[mSize] = value;
+				else mOverflow.push_back(value);
+				++mSize;
+			}
+
+			int32_t pop() {
+				--mSize;
+				if (mSize < LOCAL_CAPACITY) return mLocal[mSize];
+				const auto value = mOverflow.back();
+				mOverflow.pop_back();
+				return value;
+			}
+
+			bool empty() const { return mSize == 0; }
+
+		private:
+			static constexpr size_t LOCAL_CAPACITY = 256;
+			int32_t mLocal[LOCAL_CAPACITY];
+			std::vector<int32_t> mOverflow;
+			size_t mSize = 0;
+		};
+
+		static float calcArea(const AABB& box);
+		static bool contains(const AABB& outer, const AABB& inner);
+		static bool overlaps(const AABB& a, const AABB& b);
+		static float calcDistanceSquared(const AABB& box, const glm::vec3& point);
+
+		std::vector<Node> mNodes;
+		int32_t mRoot;
+		int32_t mFreeList;
+		size_t mProxyCount;
+		float mMargin;
+	};
+}
+
+inline bool nex::DynamicAABBTree::overlaps(const AABB& a, const AABB& b)
+{
+	return a.min.x <= b.max.x && a.max.x >= b.min.x
+		&& a.min.y <= b.max.y && a.max.y >= b.min.y
+		&& a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+inline float nex::DynamicAABBTree::calcDistanceSquared(const AABB& box, const glm::vec3& point)
+{
+	const auto diff = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+	return glm::dot(diff, diff);
+}
+
+template<class Callback>
+void nex::DynamicAABBTree::queryAABB(const AABB& box, Callback&& callback) const
+{
+	if (mRoot == NULL_NODE) return;
+
+	Stack stack;
+	stack.push(mRoot);
+
+	while (!stack.empty()) {
+		const auto index = stack.pop();
+		const auto& node = mNodes[index];
+
+		if (!overlaps(node.box, box)) continue;
+
+		if (node.isLeaf()) {
+			callback(index);
+		}
+		else {
+			stack.push(node.child1);
+			stack.push(node.child2);
+		}
+	}
+}
+
+template<class Callback>
+void nex::DynamicAABBTree::queryFrustum(const Frustum& frustum, Callback&& callback) const
+{
+	if (mRoot == NULL_NODE) return;
+
+	// The stack stores pairs of node index and a mask of the planes the node has still to be tested against.
+	// If a node lies completely inside a plane, its children needn't be tested against that plane.
+	constexpr int32_t ALL_PLANES = (1 << 6) - 1;
+
+	Stack stack;
+	stack.push(mRoot);
+	stack.push(ALL_PLANES);
+
+	while (!stack.empty()) {
+		auto planeMask = stack.pop();
+		const auto index = stack.pop();
+		const auto& node = mNodes[index];
+
+		bool outside = false;
+
+		for (int i = 0; i < 6 && planeMask; ++i) {
+			const int32_t bit = 1 << i;
+			if (!(planeMask & bit)) continue;
+
+			const auto& plane = frustum.planes[i];
+			const auto& n = plane.mNormal;
+			const auto& box = node.box;
+
+			// the corner farthest along the plane normal (p-vertex) and the nearest one (n-vertex)
+			const glm::vec3 p(n.x >= 0 ? box.max.x : box.min.x, n.y >= 0 ? box.max.y : box.min.y, n.z >= 0 ? box.max.z : box.min.z);
+			if (glm::dot(n, p) + plane.mSignedDistance < 0.0f) {
+				outside = true;
+				break;
+			}
+
+			const glm::vec3 nv(n.x >= 0 ? box.min.x : box.max.x, n.y >= 0 ? box.min.y : box.max.y, n.z >= 0 ? box.min.z : box.max.z);
+			if (glm::dot(n, nv) + plane.mSignedDistance >= 0.0f) {
+				planeMask &= ~bit;
+			}
+		}
+
+		if (outside) continue;
+
+		if (node.isLeaf()) {
+			callback(index);
+		}
+		else {
+			stack.push(node.child1);
+			stack.push(planeMask);
+			stack.push(node.child2);
+			stack.push(planeMask);
+		}
+	}
+}
+
+template<class Callback>
+void nex::DynamicAABBTree::queryRay(const Ray& ray, float maxMultiplier, Callback&& callback) const
+{
+	if (mRoot == NULL_NODE) return;
+
+	const auto& origin = ray.getOrigin();
+	const auto& invDir = ray.getInvDir();
+
+	Stack stack;
+	stack.push(mRoot);
+
+	while (!stack.empty()) {
+		const auto index = stack.pop();
+		const auto& node = mNodes[index];
+
+		// slab test; NaNs (0 * INF) are handled by the min/max order of the comparisons
+		const auto t1 = (node.box.min - origin) * invDir;
+		const auto t2 = (node.box.max - origin) * invDir;
+		const auto tmin = glm::min(t1, t2);
+		const auto tmax = glm::max(t1, t2);
+		const auto enter = std::max(std::max(tmin.x, tmin.y), std::max(tmin.z, 0.0f));
+		const auto exit = std::min(std::min(tmax.x, tmax.y), std::min(tmax.z, maxMultiplier));
+		if (enter > exit) continue;
+
+		if (node.isLeaf()) {
+			callback(index);
+		}
+		else {
+			stack.push(node.child1);
+			stack.push(node.child2);
+		}
+	}
+}
+
+template<class Callback>
+void nex::DynamicAABBTree::querySphere(const Sphere& sphere, Callback&& callback) const
+{
+	if (mRoot == NULL_NODE) return;
+
+	const auto radiusSquared = sphere.radius * sphere.radius;
+
+	Stack stack;
+	stack.push(mRoot);
+
+	while (!stack.empty()) {
+		const auto index = stack.pop();
+		const auto& node = mNodes[index];
+
+		if (calcDistanceSquared(node.box, sphere.origin) > radiusSquared) continue;
+
+		if (node.isLeaf()) {
+			callback(index);
+		}
+		else {
+			stack.push(node.child1);
+			stack.push(node.child2);
+		}
+	}
+}
+
+template<class Filter>
+void nex::DynamicAABBTree::queryNearest(const glm::vec3& point, size_t k, Filter&& filter, std::vector<int32_t>& result) const
+{
+	result.clear();
+	if (mRoot == NULL_NODE || k == 0) return;
+
+	struct Candidate {
+		float distance;
+		int32_t node;
+		bool operator<(const Candidate& o) const { return distance > o.distance; } // min heap
+	};
+
+	// best first search: nodes are visited by increasing distance; the first k accepted leaves are the nearest ones.
+	std::vector<Candidate> queue;
+	queue.push_back({calcDistanceSquared(mNodes[mRoot].box, point), mRoot});
+
+	while (!queue.empty() && result.size() < k) {
+		std::pop_heap(queue.begin(), queue.end());
+		const auto candidate = queue.back();
+		queue.pop_back();
+
+		const auto& node = mNodes[candidate.node];
+
+		if (node.isLeaf()) {
+			if (filter(candidate.node)) result.push_back(candidate.node);
+			continue;
+		}
+
+		for (auto child : {node.child1, node.child2}) {
+			queue.push_back({calcDistanceSquared(mNodes[child].box, point), child});
+			std::push_heap(queue.begin(), queue.end());
+		}
+	}
+}
@@ -0,0 +1,336 @@
+#include <nex/mesh/CompiledVobFile.hpp>
+#include <nex/common/Compression.hpp>
+#include <nex/common/File.hpp>
+#include <nex/common/MappedFile.hpp>
+#include <nex/resource/FileSystem.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <nex/util/Profiler.hpp>
+#include <cstring>
+
+namespace
+{
+	constexpr char MAGIC[4] = { 'C', 'V', 'O', 'B' };
+
+	using Section = nex::CompiledVobFile::Section;
+	using SectionType = nex::CompiledVobFile::SectionType;
+
+	void pad(nex::BinStream& out)
+	{
+		static const char zeros[nex::CompiledVobFile::ALIGNMENT] = {};
+		const auto position = static_cast<size_t>(out.tellp());
+		const auto padding = (nex::CompiledVobFile::ALIGNMENT - position % nex::CompiledVobFile::ALIGNMENT) % nex::CompiledVobFile::ALIGNMENT;
+		out.write(zeros, padding);
+	}
+
+	/**
+	 * Collects the mesh data in the order the hierarchy references it (see writeHierarchy).
+	 */
+	void collectMeshData(const nex::VobBaseStore& vob, std::vector<nex::MeshDataView>& data)
+	{
+		for (const auto& mesh : vob.meshes) {
+			data.push_back(mesh.getIndexData());
+			for (const auto& it : mesh.getVertexData()) {
+				data.push_back(it.second);
+			}
+		}
+
+		for (const auto& child : vob.children) {
+			collectMeshData(child, data);
+		}
+	}
+
+	void writeMesh(nex::BinStream& out, const nex::MeshStore& mesh, uint32_t& nextSection)
+	{
+		out << mesh.indexType;
+		out << mesh.layout;
+		out << mesh.boundingBox;
+		out << mesh.topology;
+		out << mesh.material;
+
+		out << nextSection++;
+
+		const auto vertices = mesh.getVertexData();
+		out << vertices.size();
+		for (const auto& it : vertices) {
+			out << it.first;
+			out << nextSection++;
+		}
+
+		out << mesh.useIndexBuffer;
+		out << mesh.arrayOffset;
+		out << mesh.vertexCount;
+		out << mesh.isSkinned;
+		out << mesh.rigID;
+	}
+
+	void writeHierarchy(nex::BinStream& out, const nex::VobBaseStore& vob, uint32_t& nextSection)
+	{
+		out << vob.localToParentTrafo;
+
+		out << vob.meshes.size();
+		for (const auto& mesh : vob.meshes) {
+			writeMesh(out, mesh, nextSection);
+		}
+
+		out << vob.nodeName;
+
+		out << vob.children.size();
+		for (const auto& child : vob.children) {
+			writeHierarchy(out, child, nextSection);
+		}
+	}
+
+	class HierarchyReader
+	{
+	public:
+		HierarchyReader(nex::BinStream& in, const std::filesystem::path& path, const char* data, const Section* sections,
+			uint32_t sectionCount) :
+			mIn(in), mPath(path), mData(data), mSections(sections), mSectionCount(sectionCount)
+		{
+		}
+
+		void read(nex::VobBaseStore& vob)
+		{
+			mIn >> vob.localToParentTrafo;
+
+			size_t meshCount = 0;
+			mIn >> meshCount;
+			vob.meshes.resize(meshCount);
+			for (auto& mesh : vob.meshes) {
+				readMesh(mesh);
+			}
+
+			mIn >> vob.nodeName;
+
+			size_t childCount = 0;
+			mIn >> childCount;
+			vob.children.resize(childCount);
+			for (auto& child : vob.children) {
+				read(child);
+			}
+		}
+
+	private:
+
+		void readMesh(nex::MeshStore& mesh)
+		{
+			mIn >> mesh.indexType;
+			mIn >> mesh.layout;
+			mIn >> mesh.boundingBox;
+			mIn >> mesh.topology;
+			mIn >> mesh.material;
+
+			mesh.usesDataViews = true;
+			mesh.indices.clear();
+			mesh.verticesMap.clear();
+			mesh.verticesViewMap.clear();
+			mesh.indicesView = readView();
+
+			size_t vertexBufferCount = 0;
+			mIn >> vertexBufferCount;
+			for (size_t i = 0; i < vertexBufferCount; ++i) {
+				const nex::GpuBuffer* key = nullptr;
+				mIn >> key;
+				mesh.verticesViewMap[key] = readView();
+			}
+
+			mIn >> mesh.useIndexBuffer;
+			mIn >> mesh.arrayOffset;
+			mIn >> mesh.vertexCount;
+			mIn >> mesh.isSkinned;
+			mIn >> mesh.rigID;
+		}
+
+		nex::MeshDataView readView()
+		{
+			uint32_t index = 0;
+			mIn >> index;
+
+			if (index >= mSectionCount || mSections[index].type != SectionType::MESH_DATA) {
+				nex::throw_with_trace(std::runtime_error("nex::CompiledVobFile : invalid mesh data section in " + mPath.generic_string()));
+			}
+
+			const auto& section = mSections[index];
+			return { mData + section.offset, static_cast<size_t>(section.size) };
+		}
+
+		nex::BinStream& mIn;
+		const std::filesystem::path& mPath;
+		const char* mData;
+		const Section* mSections;
+		uint32_t mSectionCount;
+	};
+}
+
+nex::CompiledVobFile::CompiledVobFile() : mVersion(0), mCompressed(false)
+{
+}
+
+nex::CompiledVobFile::~CompiledVobFile() = default;
+
+void nex::CompiledVobFile::write(const std::filesystem::path& path, const VobBaseStore& store, bool compress)
+{
+	NEX_PROFILE_SCOPE("CompiledVobFile::write");
+
+	std::vector<MeshDataView> meshData;
+	collectMeshData(store, meshData);
+
+	std::filesystem::create_directories(path.parent_path());
+
+	BinStream file;
+	if (compress) {
+		file.openCompressed(path);
+	}
+	else {
+		file.open(path, std::ios::out | std::ios::trunc);
+	}
+
+	Header header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	file << header; // patched at the end
+
+	// section 0 is the hierarchy; it is written last, as it is encoded while the mesh data sections are known
+	std::vector<Section> sections(meshData.size() + 1, Section());
+
+	for (size_t i = 0; i < meshData.size(); ++i) {
+		pad(file);
+		auto& section = sections[i + 1];
+		section.type = SectionType::MESH_DATA;
+		section.offset = static_cast<uint64_t>(file.tellp());
+		section.size = meshData[i].size;
+		file.write(meshData[i].data, meshData[i].size);
+	}
+
+	pad(file);
+	sections[0].type = SectionType::HIERARCHY;
+	sections[0].offset = static_cast<uint64_t>(file.tellp());
+	uint32_t nextSection = 1;
+	writeHierarchy(file, store, nextSection);
+	sections[0].size = static_cast<uint64_t>(file.tellp()) - sections[0].offset;
+
+	pad(file);
+	header.sectionCount = static_cast<uint32_t>(sections.size());
+	header.sectionTableOffset = static_cast<uint64_t>(file.tellp());
+	file.write(reinterpret_cast<const char*>(sections.data()), sections.size() * sizeof(Section));
+	header.fileSize = static_cast<uint64_t>(file.tellp());
+
+	file.seekp(0);
+	file << header;
+	file.close();
+}
+
+void nex::CompiledVobFile::convert(const std::filesystem::path& source, const std::filesystem::path& destination)
+{
+	VobBaseStore store;
+	CompiledVobFile file;
+	file.read(source, store);
+
+	// Note: only version 1 files, which aren't mapped, can be overwritten in place
+	if (file.getVersion() == VERSION && source == destination) return;
+
+	write(destination, store, file.isCompressed());
+}
+
+void nex::CompiledVobFile::read(const std::filesystem::path& path, VobBaseStore& store)
+{
+	NEX_PROFILE_SCOPE("CompiledVobFile::read");
+
+	mFile.reset();
+	mDecompressed = std::vector<char>();
+	mCompressed = false;
+
+	const char* data = nullptr;
+	size_t size = 0;
+
+	// packaged files are used in place from the mapping of the package
+	const auto packaged = FileSystem::findPackaged(path);
+
+	if (packaged.data) {
+		data = packaged.data;
+		size = packaged.size;
+	}
+	else {
+		mFile = std::make_unique<MappedFile>(path);
+		data = mFile->getData();
+		size = mFile->getSize();
+	}
+
+	if (Compression::isCompressed(data, size)) {
+		// compressed files can't be used in place; the mesh stores reference the decompressed data instead
+		Compression::decompress(data, size, mDecompressed);
+		mFile.reset();
+		mCompressed = true;
+		data = mDecompressed.data();
+		size = mDecompressed.size();
+	}
+
+	const auto* header = reinterpret_cast<const Header*>(data);
+
+	const bool isVersion2 = size >= sizeof(Header)
+		&& std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+		&& header->version == VERSION;
+
+	if (!isVersion2) {
+		// version 1 files are plain BinStream encoded stores without a header
+		mVersion = 1;
+
+		{
+			BinStream file;
+			file.openMemory(data, size);
+			file >> store;
+		}
+
+		mFile.reset();
+		mDecompressed = std::vector<char>();
+		return;
+	}
+
+	const auto corrupt = [&]() {
+		return std::runtime_error("nex::CompiledVobFile : corrupt file " + path.generic_string());
+	};
+
+	const auto tableSize = uint64_t(header->sectionCount) * sizeof(Section);
+
+	if (header->fileSize != size || header->sectionCount == 0
+		|| header->sectionTableOffset % alignof(Section) != 0
+		|| header->sectionTableOffset > size || tableSize > size - header->sectionTableOffset) {
+		throw_with_trace(corrupt());
+	}
+
+	const auto* sections = reinterpret_cast<const Section*>(data + header->sectionTableOffset);
+
+	for (uint32_t i = 0; i < header->sectionCount; ++i) {
+		const auto& section = sections[i];
+		if (section.offset % ALIGNMENT != 0 || section.offset > size || section.size > size - section.offset) {
+			throw_with_trace(corrupt());
+		}
+	}
+
+	if (sections[0].type != SectionType::HIERARCHY) throw_with_trace(corrupt());
+
+	mVersion = VERSION;
+
+	// The hierarchy is small compared to the mesh data, so it is decoded with the regular BinStream operators
+	// directly from the mapping.
+	BinStream file;
+	file.openMemory(data + sections[0].offset, sections[0].size);
+
+	HierarchyReader reader(file, path, data, sections, header->sectionCount);
+	reader.read(store);
+}
+
+uint32_t nex::CompiledVobFile::getVersion() const
+{
+	return mVersion;
+}
+
+size_t nex::CompiledVobFile::getMappedSize() const
+{
+	return mFile ? mFile->getSize() : 0;
+}
+
+bool nex::CompiledVobFile::isCompressed() const
+{
+	return mCompressed;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <nex/scene/VobStore.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace nex
+{
+	class MappedFile;
+
+	/**
+	 * Compiled vob file (.CVOB), version 2.
+	 *
+	 * Layout:
+	 *  - header: magic "CVOB", version, section count, offset of the section table and file size
+	 *  - sections, each starting at a 16 byte aligned offset:
+	 *     - mesh data sections holding the raw vertex and index data of the meshes
+	 *     - a hierarchy section holding the vob hierarchy without vertex and index data (BinStream encoded);
+	 *       meshes reference their data by section index
+	 *  - section table: type, offset and size of each section
+	 *
+	 * Reading maps the file and the mesh stores get views into the mapping (see MeshStore::usesDataViews), so that
+	 * vertex and index data is uploaded to the gpu straight from the page cache without being copied first.
+	 *
+	 * Version 1 files (a BinStream encoded VobBaseStore) are still readable and can be converted to version 2.
+	 *
+	 * Files can optionally be compressed as a whole (see nex::Compression). Compressed files are decompressed into
+	 * memory owned by this object, so the mesh stores reference that memory instead of a mapping.
+	 */
+	class CompiledVobFile
+	{
+	public:
+
+		static constexpr uint32_t VERSION = 2;
+		static constexpr size_t ALIGNMENT = 16;
+
+		enum class SectionType : uint32_t
+		{
+			HIERARCHY = 0,
+			MESH_DATA = 1,
+		};
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t sectionCount;
+			uint32_t reserved;
+			uint64_t sectionTableOffset;
+			uint64_t fileSize;
+		};
+
+		struct Section
+		{
+			SectionType type;
+			uint32_t reserved;
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		CompiledVobFile();
+		~CompiledVobFile();
+
+		CompiledVobFile(const CompiledVobFile&) = delete;
+		CompiledVobFile& operator=(const CompiledVobFile&) = delete;
+
+		/**
+		 * Writes a vob hierarchy in the current version.
+		 * @param compress : Specifies whether the file is compressed.
+		 */
+		static void write(const std::filesystem::path& path, const VobBaseStore& store, bool compress = false);
+
+		/**
+		 * Converts a compiled vob file of an older version to the current version.
+		 * Source and destination can be the same file. The compression of the source is kept.
+		 */
+		static void convert(const std::filesystem::path& source, const std::filesystem::path& destination);
+
+		/**
+		 * Reads a compiled vob file. Files of the current version are mapped and the mesh stores of the vob hierarchy
+		 * reference the mapping; such stores mustn't be used after this object is destroyed or read() is called again.
+		 * Files of version 1 and compressed files are read into memory.
+		 * Files contained in a mounted package (see FileSystem::mountPackage) are used in place from the package's
+		 * mapping; the package has to stay mounted as long as the stores are used.
+		 * @throws std::runtime_error : if the file is corrupt.
+		 */
+		void read(const std::filesystem::path& path, VobBaseStore& store);
+
+		/**
+		 * Provides the version of the last read file.
+		 */
+		uint32_t getVersion() const;
+
+		/**
+		 * Provides the size of the currently mapped file (0, if no file is mapped).
+		 */
+		size_t getMappedSize() const;
+
+		/**
+		 * Checks if the last read file was compressed.
+		 */
+		bool isCompressed() const;
+
+	private:
+		std::unique_ptr<MappedFile> mFile;
+		std::vector<char> mDecompressed;
+		uint32_t mVersion;
+		bool mCompressed;
+	};
+}
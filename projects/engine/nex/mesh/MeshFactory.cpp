@@ -153,12 +153,13 @@ namespace nex
 		layout = store.layout;
 		auto& map = layout.getBufferLayoutMap();
 
-		for (const auto& it : store.verticesMap) {
+		// the data might be referenced from a mapped file; it is uploaded without an intermediate copy
+		for (const auto& it : store.getVertexData()) {
 			const auto& vertices = it.second;
 			const auto* invalidGpuBuffer = it.first;
 
 			auto vertexBuffer = std::make_unique<VertexBuffer>();
-			vertexBuffer->resize(vertices.size(), vertices.data(), GpuBuffer::UsageHint::STATIC_DRAW);
+			vertexBuffer->resize(vertices.size, vertices.data, GpuBuffer::UsageHint::STATIC_DRAW);
 
 			auto it = map.extract(map.find(invalidGpuBuffer));
 			it.key() = vertexBuffer.get();
@@ -168,8 +169,9 @@ namespace nex
 		}
 
 		if (store.useIndexBuffer) {
-			IndexBuffer indexBuffer(store.indexType, store.indices.size() / getIndexElementTypeByteSize(store.indexType),
-				store.indices.data());
+			const auto indices = store.getIndexData();
+			IndexBuffer indexBuffer(store.indexType, indices.size / getIndexElementTypeByteSize(store.indexType),
+				indices.data);
 			indexBuffer.unbind();
 			mesh.setIndexBuffer(std::move(indexBuffer));
 		}
@@ -357,6 +357,11 @@ namespace nex
 		return mMaterial->getRenderState();
 	}
 
+	uint32_t MeshBatch::getSortID() const
+	{
+		return mSortID.get();
+	}
+
 	void MeshBatch::setReferenceMaterial(Material* referenceMaterial)
 	{
 		mMaterial = referenceMaterial;
@@ -54,12 +54,18 @@ namespace nex
 		Shader* getShader() const;
 		const RenderState& getState() const;
 
+		/**
+		 * Provides a small id of this batch for sort keys (see SortID).
+		 */
+		uint32_t getSortID() const;
+
 		void setReferenceMaterial(Material* referenceMaterial);
 
 	private:
 		std::vector<Entry> mMeshes;
 		Material* mMaterial;
 		AABB mBoundingBox;
+		SortID<MeshBatch> mSortID;
 	};
 
 	class MeshGroup : public nex::Resource
@@ -22,6 +22,7 @@
 #include <nex/import/ImportScene.hpp>
 #include <nex/anim/AnimationManager.hpp>
 #include <nex/anim/RigLoader.hpp>
+#include <nex/mesh/CompiledVobFile.hpp>
 
 std::unique_ptr<nex::MeshManager> nex::MeshManager::mInstance;
 
@@ -152,6 +153,16 @@ std::unique_ptr<nex::Vob> nex::MeshManager::loadVobHierarchy(const std::filesyst
 	bool forceLoad, 
 	const FileSystem* fileSystem)
 {
+	auto store = loadVobHierarchyStore(meshPath, materialLoader, rescale, forceLoad, fileSystem);
+	return createVobHierarchy(*store, materialLoader);
+}
+
+std::shared_ptr<nex::VobHierarchyStore> nex::MeshManager::loadVobHierarchyStore(const std::filesystem::path& meshPath,
+	const nex::AbstractMaterialLoader& materialLoader,
+	float rescale,
+	bool forceLoad,
+	const FileSystem* fileSystem) const
+{
 
 	// else case: assume the model name is a 3d model that can be load from file.
 	if (!mInitialized) throw std::runtime_error("MeshManager isn't initialized!");
@@ -160,9 +171,11 @@ std::unique_ptr<nex::Vob> nex::MeshManager::loadVobHierarchy(const std::filesyst
 
 	const auto resolvedPath = fileSystem->resolvePath(meshPath);
 
-	VobBaseStore store;
+	auto result = std::make_shared<VobHierarchyStore>();
+	auto& compiledFile = result->compiledFile;
+	auto& store = result->store;
 	auto compiledPath = constructCompiledPath(resolvedPath, fileSystem, rescale, ".CVOB");
-	const bool compiledPathExists = std::filesystem::exists(compiledPath);
+	const bool compiledPathExists = FileSystem::fileExists(compiledPath);
 
 	ImportScene importScene;
 
@@ -179,31 +192,27 @@ std::unique_ptr<nex::Vob> nex::MeshManager::loadVobHierarchy(const std::filesyst
 	}
 	else
 	{
-		BinStream file;
-		file.open(compiledPath, std::ios::in);
-		file >> store;
+		compiledFile.read(compiledPath, store);
 	}
 
-	// Write compilation if it doesn't exist already
-	if (!compiledPathExists) {
-		BinStream file;
-		auto directory = compiledPath.parent_path();
-		std::filesystem::create_directories(directory);
-
-		std::ios_base::openmode mode = std::ios::out | std::ios::trunc;
-
-		file.open(compiledPath, mode);
-
-		file << store;
+	// Write compilation if it doesn't exist already; compilations of older versions are converted.
+	// Note: Only older versions are read into memory, so the file isn't mapped when it is overwritten.
+	// Packaged compilations are never converted, as the loose file would be shadowed by the package.
+	if (!compiledPathExists || (compiledFile.getVersion() < CompiledVobFile::VERSION && !forceLoad
+		&& !FileSystem::isPackaged(compiledPath))) {
+		CompiledVobFile::write(compiledPath, store, FileSystem::isCompressionEnabled(FileSystem::CompiledType::MESH));
 	}
 
-	auto vob = createVob(store, materialLoader);
-	vob->updateTrafo(true, true);
+	prefetch(store, materialLoader);
 
-	nex::RenderEngine::getCommandQueue()->push([vob =vob.get()]() {
-		vob->finalizeMeshes();
-	});
+	return result;
+}
 
+std::unique_ptr<nex::Vob> nex::MeshManager::createVobHierarchy(const VobHierarchyStore& store, 
+	const nex::AbstractMaterialLoader& materialLoader) const
+{
+	auto vob = createVob(store.store, materialLoader);
+	vob->updateTrafo(true, true);
 	return vob;
 }
 
@@ -241,7 +250,7 @@ std::filesystem::path nex::MeshManager::constructCompiledPath(const std::filesys
 	const FileSystem* filesystem, 
 	float rescale, 
 	const char* extension
-	)
+	) const
 {
 	auto compiledPath = filesystem->getCompiledPath(absolutePath, extension).path;;
 
@@ -291,6 +300,18 @@ std::unique_ptr<nex::Vob> nex::MeshManager::createVob(const VobBaseStore& store,
 	return vob;
 }
 
+void nex::MeshManager::prefetch(const VobBaseStore& store, const AbstractMaterialLoader& materialLoader) const
+{
+	for (const auto& mesh : store.meshes) {
+		materialLoader.prefetchTextures(mesh.material);
+		if (mesh.isSkinned) AnimationManager::get()->load(mesh.rigID);
+	}
+
+	for (const auto& childStore : store.children) {
+		prefetch(childStore, materialLoader);
+	}
+}
+
 bool nex::MeshManager::checkIsSkinned(const VobBaseStore& store, std::string& rigIDOut) const
 {
 	for (const auto& mesh : store.meshes) {
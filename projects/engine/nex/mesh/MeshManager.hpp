@@ -6,6 +6,7 @@
 #include <memory>
 #include <nex/material/Material.hpp>
 #include <nex/scene/Vob.hpp>
+#include <nex/mesh/CompiledVobFile.hpp>
 
 
 namespace nex
@@ -23,6 +24,15 @@ namespace nex
 		Vob* root = nullptr;
 	};
 
+	/**
+	 * The cpu side of a loaded vob hierarchy (see MeshManager::loadVobHierarchyStore).
+	 */
+	struct VobHierarchyStore {
+		// Keeps the mapped mesh data of the store alive until the meshes are created.
+		CompiledVobFile compiledFile;
+		VobBaseStore store;
+	};
+
 
 	/**
 	 * A mesh manager provides a central access point for creating and receiving
@@ -54,16 +64,33 @@ namespace nex
 		 *						mesh path.
 		 * @meshLoader : (Optional). If not null, the meshLoader will be used if the mesh isn't compiled yet.
 		 * @materialLoader: Used to create materials from the mesh.
+		 * Note: The meshes of the vob hierarchy aren't finalized. The owner of the vob has to finalize them, 
+		 * before the vob is rendered (e.g. with Vob::createStepwiseMeshFinalizer or VobBluePrint::finalizeAsync).
 		 */
-
-
-
 		std::unique_ptr<Vob> loadVobHierarchy(const std::filesystem::path& meshPath,
 			const nex::AbstractMaterialLoader& materialLoader,
 			float rescale = 1.0f,
 			bool forceLoad = false,
 			const FileSystem* fileSystem = nullptr);
 
+		/**
+		 * The cpu part of loadVobHierarchy: Reads (or imports and compiles) the stores of a vob hierarchy 
+		 * and prefetches the textures and rigs it uses. No render backend objects are created, so this function 
+		 * can be executed on any resource loader worker (see ResourceLoader::JobAffinity::Any).
+		 * Thread safe.
+		 */
+		std::shared_ptr<VobHierarchyStore> loadVobHierarchyStore(const std::filesystem::path& meshPath,
+			const nex::AbstractMaterialLoader& materialLoader,
+			float rescale = 1.0f,
+			bool forceLoad = false,
+			const FileSystem* fileSystem = nullptr) const;
+
+		/**
+		 * The render part of loadVobHierarchy: Creates the vob hierarchy of a loaded store.
+		 * Has to be called from a thread owning a render context.
+		 */
+		std::unique_ptr<Vob> createVobHierarchy(const VobHierarchyStore& store, const nex::AbstractMaterialLoader& materialLoader) const;
+
 
 		const FileSystem& getFileSystem() const;
 
@@ -117,7 +144,9 @@ namespace nex
 		std::filesystem::path constructCompiledPath(const std::filesystem::path& absolutePath, 
 			const FileSystem* filesystem, 
 			float rescale, 
-			const char* extension = nullptr);
+			const char* extension = nullptr) const;
+
+		void prefetch(const VobBaseStore& store, const AbstractMaterialLoader& materialLoader) const;
 
 		
 		bool checkIsSkinned(const VobBaseStore& store, std::string& rigIDOut) const;
@@ -20,6 +20,23 @@ void nex::MeshStore::read(nex::BinStream& in)
 	in >> rigID;
 }
 
+nex::MeshDataView nex::MeshStore::getIndexData() const
+{
+	if (usesDataViews) return indicesView;
+	return { indices.data(), indices.size() };
+}
+
+std::map<const nex::GpuBuffer*, nex::MeshDataView> nex::MeshStore::getVertexData() const
+{
+	if (usesDataViews) return verticesViewMap;
+
+	std::map<const nex::GpuBuffer*, MeshDataView> result;
+	for (const auto& it : verticesMap) {
+		result[it.first] = { it.second.data(), it.second.size() };
+	}
+	return result;
+}
+
 void nex::MeshStore::write(nex::BinStream& out) const
 {
 	out << indexType;
@@ -9,6 +9,15 @@
 
 namespace nex
 {
+	/**
+	 * A read only view of vertex or index data owned by someone else.
+	 */
+	struct MeshDataView
+	{
+		const char* data = nullptr;
+		size_t size = 0;
+	};
+
 	struct MeshStore
 	{
 		IndexElementType indexType;
@@ -27,6 +36,22 @@ namespace nex
 		bool isSkinned;
 		std::string rigID; // only used by skinned meshes
 
+		// If set, the vertex and index data isn't held by indices and verticesMap, but referenced by the views
+		// (e.g. into a mapped compiled vob file, see CompiledVobFile). The referenced memory has to outlive the store.
+		bool usesDataViews = false;
+		MeshDataView indicesView;
+		std::map<const nex::GpuBuffer*, MeshDataView> verticesViewMap;
+
+		/**
+		 * Provides the index data, regardless of whether it is held or referenced.
+		 */
+		MeshDataView getIndexData() const;
+
+		/**
+		 * Provides the vertex data of each vertex buffer, regardless of whether it is held or referenced.
+		 */
+		std::map<const nex::GpuBuffer*, MeshDataView> getVertexData() const;
+
 		void read(nex::BinStream& in);
 		void write(nex::BinStream& out) const;
 
@@ -209,7 +209,10 @@ void nex::ParticleShader::updateMaterial(const nex::Material& m) {
 	}
 
 	auto* instanceBuffer = material->instanceBuffer;
-	if (instanceBuffer) {
+	if (material->streamingBuffer) {
+		material->streamingBuffer->bindToTarget(material->instanceAllocation, StreamingBuffer::Target::SHADER_STORAGE_BUFFER, 0);
+	}
+	else if (instanceBuffer) {
 		bindParticlesBuffer(instanceBuffer);
 	}
 	
@@ -458,6 +461,7 @@ void nex::VarianceParticleSystem::frameUpdate(const RenderContext& constants)
 
 	mManager.frameUpdate(psVelocity, frameTime);
 	recalculateLocalBoundingBox();
+	markTrafoDirty();
 
 	emit(position, psVelocity, count);
 
@@ -468,22 +472,39 @@ void nex::VarianceParticleSystem::frameUpdate(const RenderContext& constants)
 	mManager.updateParticleTrafos(invViewWithoutPosition);
 
 
+	mMaterial->streamingBuffer = nullptr;
+
 	if (mManager.getActiveParticleCount() > 0) {
 
 		const auto* particles = mManager.getParticles();
+		const auto size = mManager.getActiveParticleCount() * sizeof(ParticleShader::ParticleData);
+		auto* streamingBuffer = constants.streamingBuffer.get();
+
+		// Write the particle data directly into the mapped streaming buffer, if available.
+		auto* shaderParticles = mShaderParticles.data();
+		if (streamingBuffer) {
+			mMaterial->instanceAllocation = streamingBuffer->allocate(size);
+			mMaterial->streamingBuffer = streamingBuffer;
+			shaderParticles = static_cast<ParticleShader::ParticleData*>(mMaterial->instanceAllocation.data);
+		}
 
 		for (int i = 0; i < mManager.getActiveParticleCount(); ++i) {
-			auto& data = mShaderParticles[i];
+			auto& data = shaderParticles[i];
 			const auto& particle = particles[i];
 
 			data.worldTrafo = particle.getWorldTrafo();
 			data.lifeTimePercentage = particle.getElapsedTime() / particle.getLifeTime();
 		}
 
-		mInstanceBuffer->update(mManager.getActiveParticleCount() * sizeof(ParticleShader::ParticleData), mShaderParticles.data(), 0);
+		if (!streamingBuffer) mInstanceBuffer->update(size, mShaderParticles.data(), 0);
 	}	
 }
 
+bool nex::VarianceParticleSystem::isParallelUpdateSafe() const
+{
+	return false;
+}
+
 void nex::VarianceParticleSystem::setDirection(const glm::vec3& direction, float directionDeviation)
 {
 	mDirectionDeviation = directionDeviation;
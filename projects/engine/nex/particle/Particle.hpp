@@ -9,6 +9,7 @@
 #include <nex/material/Material.hpp>
 #include <nex/mesh/MeshGroup.hpp>
 #include <nex/scene/Vob.hpp>
+#include <nex/buffer/StreamingBuffer.hpp>
 
 
 namespace nex {
@@ -100,6 +101,10 @@ namespace nex {
 			Texture* texture = nullptr;
 			glm::vec4 color;
 			ShaderStorageBuffer* instanceBuffer = nullptr;
+
+			// If set, the particle data of the current frame is bound from the streaming buffer instead of the instance buffer.
+			const StreamingBuffer* streamingBuffer = nullptr;
+			StreamingBuffer::Allocation instanceAllocation;
 		};
 
 		struct ParticleData {
@@ -228,6 +233,12 @@ namespace nex {
 
 		void frameUpdate(const RenderContext& constants) override;
 
+		/**
+		 * Note: The particle system uses the global random generator and updates its instance buffer, so it has to be updated
+		 * on the main thread.
+		 */
+		bool isParallelUpdateSafe() const override;
+
 		void setDirection(const glm::vec3& direction, float directionDeviation);
 
 		/**
@@ -0,0 +1,44 @@
+#include <nex/platform/headless/SubSystemProviderHeadless.hpp>
+
+nex::SubSystemProviderHeadless::SubSystemProviderHeadless() : mIsInitialized(false)
+{
+}
+
+nex::Window* nex::SubSystemProviderHeadless::createWindow(Window::WindowStruct& desc)
+{
+	if (!mIsInitialized) return nullptr;
+
+	mWindows.emplace_back(desc);
+	return &mWindows.back();
+}
+
+nex::SubSystemProviderHeadless* nex::SubSystemProviderHeadless::get()
+{
+	static SubSystemProviderHeadless instance;
+	return &instance;
+}
+
+bool nex::SubSystemProviderHeadless::init()
+{
+	mIsInitialized = true;
+	return true;
+}
+
+bool nex::SubSystemProviderHeadless::isTerminated() const
+{
+	return !mIsInitialized;
+}
+
+void nex::SubSystemProviderHeadless::pollEvents()
+{
+}
+
+void nex::SubSystemProviderHeadless::terminate()
+{
+	mWindows.clear();
+	mIsInitialized = false;
+}
+
+void nex::SubSystemProviderHeadless::waitForEvents()
+{
+}
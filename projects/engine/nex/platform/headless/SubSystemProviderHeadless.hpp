@@ -0,0 +1,35 @@
+#pragma once
+#include <nex/platform/SubSystemProvider.hpp>
+#include <nex/platform/headless/WindowHeadless.hpp>
+#include <list>
+
+namespace nex
+{
+	/**
+	 * Provides windows that aren't backed by any windowing system. Events are never received.
+	 */
+	class SubSystemProviderHeadless : public SubSystemProvider
+	{
+	public:
+
+		Window* createWindow(Window::WindowStruct& desc) override;
+
+		static SubSystemProviderHeadless* get();
+
+		bool init() override;
+
+		bool isTerminated() const override;
+
+		void pollEvents() override;
+
+		void terminate() override;
+
+		void waitForEvents() override;
+
+	private:
+		SubSystemProviderHeadless();
+
+		bool mIsInitialized;
+		std::list<WindowHeadless> mWindows;
+	};
+}
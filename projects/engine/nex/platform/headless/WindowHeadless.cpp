@@ -0,0 +1,154 @@
+#include <nex/platform/headless/WindowHeadless.hpp>
+
+nex::InputHeadless::InputHeadless(WindowHeadless* window, KeyMapLanguage language) : Input(language), mWindow(window)
+{
+}
+
+nex::Input::Button nex::InputHeadless::getAnyPressedButton() const
+{
+	return InvalidButton;
+}
+
+nex::Input::Key nex::InputHeadless::getAnyPressedKey() const
+{
+	return KEY_UNKNOWN;
+}
+
+void nex::InputHeadless::setClipBoardText(const char* text)
+{
+	mClipBoardText = text;
+}
+
+const char* nex::InputHeadless::getClipBoardText() const
+{
+	return mClipBoardText.c_str();
+}
+
+nex::Window* nex::InputHeadless::getWindow()
+{
+	return mWindow;
+}
+
+bool nex::InputHeadless::isDown(Button button) const
+{
+	return false;
+}
+
+bool nex::InputHeadless::isDown(Key key) const
+{
+	return false;
+}
+
+bool nex::InputHeadless::isPressed(Button button) const
+{
+	return false;
+}
+
+bool nex::InputHeadless::isPressed(Key key) const
+{
+	return false;
+}
+
+bool nex::InputHeadless::isReleased(Button button) const
+{
+	return false;
+}
+
+bool nex::InputHeadless::isReleased(Key key) const
+{
+	return false;
+}
+
+
+nex::WindowHeadless::WindowHeadless(const WindowStruct& desc) : Window(desc),
+	mInput(this, desc.language),
+	mCursorState(CursorState::Normal),
+	mIsOpen(true)
+{
+	mHasFocus = true;
+}
+
+void nex::WindowHeadless::activate(bool deactivate)
+{
+}
+
+void nex::WindowHeadless::close(bool silent)
+{
+	mIsOpen = false;
+	if (!silent) mInput.informWindowCloseListeners();
+}
+
+const nex::Cursor* nex::WindowHeadless::getCursor() const
+{
+	return nullptr;
+}
+
+nex::CursorState nex::WindowHeadless::getCursorState() const
+{
+	return mCursorState;
+}
+
+nex::Input* nex::WindowHeadless::getInputDevice()
+{
+	return &mInput;
+}
+
+bool nex::WindowHeadless::hasFocus() const
+{
+	return mHasFocus;
+}
+
+bool nex::WindowHeadless::isOpen() const
+{
+	return mIsOpen;
+}
+
+void nex::WindowHeadless::minimize()
+{
+}
+
+void nex::WindowHeadless::reopen()
+{
+	mIsOpen = true;
+}
+
+void nex::WindowHeadless::resize(unsigned newWidth, unsigned newHeight)
+{
+	mConfig.frameBufferWidth = mConfig.virtualScreenWidth = newWidth;
+	mConfig.frameBufferHeight = mConfig.virtualScreenHeight = newHeight;
+	mInput.informVirtualDimensionResizeListeners(newWidth, newHeight);
+	mInput.informFrameBufferResizeListeners(newWidth, newHeight);
+}
+
+void nex::WindowHeadless::setCursor(Cursor* cursor)
+{
+}
+
+void nex::WindowHeadless::setCursorPosition(int xPos, int yPos)
+{
+	mInput.setMousePosition(xPos, yPos);
+}
+
+void nex::WindowHeadless::setFullscreen()
+{
+	mConfig.fullscreen = true;
+}
+
+void nex::WindowHeadless::setVisible(bool visible)
+{
+	mConfig.visible = visible;
+}
+
+void nex::WindowHeadless::setWindowed()
+{
+	mConfig.fullscreen = false;
+}
+
+void nex::WindowHeadless::showCursor(CursorState state)
+{
+	mCursorState = state;
+}
+
+void nex::WindowHeadless::swapBuffers()
+{
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <nex/platform/Window.hpp>
+
+namespace nex
+{
+	class WindowHeadless;
+
+	/**
+	 * An input device that never receives any user input.
+	 */
+	class InputHeadless : public Input
+	{
+	public:
+
+		InputHeadless(WindowHeadless* window, KeyMapLanguage language);
+
+		Button getAnyPressedButton() const override;
+
+		Key getAnyPressedKey() const override;
+
+		void setClipBoardText(const char* text) override;
+
+		const char* getClipBoardText() const override;
+
+		Window* getWindow() override;
+
+		bool isDown(Button button) const override;
+
+		bool isDown(Key key) const override;
+
+		bool isPressed(Button button) const override;
+
+		bool isPressed(Key key) const override;
+
+		bool isReleased(Button button) const override;
+
+		bool isReleased(Key key) const override;
+
+	private:
+		WindowHeadless* mWindow;
+		std::string mClipBoardText;
+	};
+
+	/**
+	 * A window that is never shown on screen. It is used for running the engine without a display (e.g. for benchmarks).
+	 */
+	class WindowHeadless : public Window
+	{
+	public:
+
+		WindowHeadless(const WindowStruct& desc);
+
+		void activate(bool deactivate = false) override;
+
+		void close(bool silent = false) override;
+
+		const Cursor* getCursor() const override;
+
+		CursorState getCursorState() const override;
+
+		Input* getInputDevice() override;
+
+		bool hasFocus() const override;
+
+		bool isOpen() const override;
+
+		void minimize() override;
+
+		void reopen() override;
+
+		void resize(unsigned newWidth, unsigned newHeight) override;
+
+		void setCursor(Cursor* cursor) override;
+
+		void setCursorPosition(int xPos, int yPos) override;
+
+		void setFullscreen() override;
+
+		void setVisible(bool visible) override;
+
+		void setWindowed() override;
+
+		void showCursor(CursorState state) override;
+
+		void swapBuffers() override;
+
+	private:
+		InputHeadless mInput;
+		CursorState mCursorState;
+		bool mIsOpen;
+	};
+}
@@ -0,0 +1,328 @@
+#include <nex/renderer/BatchCuller.hpp>
+#include <nex/camera/Camera.hpp>
+#include <nex/math/Sphere.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define NEX_BATCH_CULLER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NEX_TARGET_AVX __attribute__((target("avx")))
+#else
+#define NEX_TARGET_AVX
+#endif
+
+namespace
+{
+	/**
+	 * Frustum data prepared for culling.
+	 */
+	struct FrustumPlanes {
+		float nx[6];
+		float ny[6];
+		float nz[6];
+		float d[6];
+		// specifies for each plane and axis, whether the box maximum is the corner farthest along the normal (p-vertex)
+		bool useMaxX[6];
+		bool useMaxY[6];
+		bool useMaxZ[6];
+		// bounding box of the frustum corners
+		glm::vec3 cornerMin;
+		glm::vec3 cornerMax;
+
+		explicit FrustumPlanes(const nex::Frustum& frustum)
+		{
+			for (int i = 0; i < 6; ++i) {
+				const auto& plane = frustum.planes[i];
+				nx[i] = plane.mNormal.x;
+				ny[i] = plane.mNormal.y;
+				nz[i] = plane.mNormal.z;
+				d[i] = plane.mSignedDistance;
+				useMaxX[i] = nx[i] >= 0.0f;
+				useMaxY[i] = ny[i] >= 0.0f;
+				useMaxZ[i] = nz[i] >= 0.0f;
+			}
+
+			cornerMin = cornerMax = frustum.corners[0];
+			for (const auto& corner : frustum.corners) {
+				cornerMin = glm::min(cornerMin, corner);
+				cornerMax = glm::max(cornerMax, corner);
+			}
+		}
+	};
+
+	// Note: The plane distances are calculated in the same order as glm::dot(vec4(normal, d), vec4(corner, 1)),
+	// so that the results match RenderCommandQueue::boxInFrustum exactly. All 8 corners lie outside of a plane if the
+	// p-vertex does; all frustum corners lie beyond a box side if the bounding box of the corners does.
+
+	// The SIMD variants process complete blocks of boxes and return the number of processed boxes; the remaining boxes
+	// are processed by the scalar variants.
+
+	void cullFrustumScalar(const FrustumPlanes& f, const nex::AABBBatch& boxes, size_t begin, uint32_t* visibility)
+	{
+		const auto* minX = boxes.minX(); const auto* maxX = boxes.maxX();
+		const auto* minY = boxes.minY(); const auto* maxY = boxes.maxY();
+		const auto* minZ = boxes.minZ(); const auto* maxZ = boxes.maxZ();
+
+		for (size_t i = begin; i < boxes.size(); ++i) {
+			bool outside = f.cornerMin.x > maxX[i] || f.cornerMax.x < minX[i]
+				|| f.cornerMin.y > maxY[i] || f.cornerMax.y < minY[i]
+				|| f.cornerMin.z > maxZ[i] || f.cornerMax.z < minZ[i];
+
+			for (int p = 0; p < 6 && !outside; ++p) {
+				const auto x = f.useMaxX[p] ? maxX[i] : minX[i];
+				const auto y = f.useMaxY[p] ? maxY[i] : minY[i];
+				const auto z = f.useMaxZ[p] ? maxZ[i] : minZ[i];
+				outside = (f.nx[p] * x + f.ny[p] * y) + (f.nz[p] * z + f.d[p] * 1.0f) < 0.0f;
+			}
+
+			if (!outside) visibility[i / 32] |= 1u << (i % 32);
+		}
+	}
+
+	void cullSphereScalar(const nex::Sphere& sphere, const nex::AABBBatch& boxes, size_t begin, uint32_t* visibility)
+	{
+		for (size_t i = begin; i < boxes.size(); ++i) {
+			const nex::AABB box(glm::vec3(boxes.minX()[i], boxes.minY()[i], boxes.minZ()[i]),
+				glm::vec3(boxes.maxX()[i], boxes.maxY()[i], boxes.maxZ()[i]));
+
+			if (sphere.intersects(box)) visibility[i / 32] |= 1u << (i % 32);
+		}
+	}
+
+#ifdef NEX_BATCH_CULLER_X86
+
+	size_t cullFrustumSSE(const FrustumPlanes& f, const nex::AABBBatch& boxes, uint32_t* visibility)
+	{
+		const float* mins[3] = {boxes.minX(), boxes.minY(), boxes.minZ()};
+		const float* maxs[3] = {boxes.maxX(), boxes.maxY(), boxes.maxZ()};
+		const auto zero = _mm_setzero_ps();
+		const auto count = boxes.size() / 4 * 4;
+
+		for (size_t i = 0; i < count; i += 4) {
+			const auto minX = _mm_loadu_ps(mins[0] + i);
+			const auto minY = _mm_loadu_ps(mins[1] + i);
+			const auto minZ = _mm_loadu_ps(mins[2] + i);
+			const auto maxX = _mm_loadu_ps(maxs[0] + i);
+			const auto maxY = _mm_loadu_ps(maxs[1] + i);
+			const auto maxZ = _mm_loadu_ps(maxs[2] + i);
+
+			auto outside = _mm_or_ps(_mm_cmpgt_ps(_mm_set1_ps(f.cornerMin.x), maxX), _mm_cmplt_ps(_mm_set1_ps(f.cornerMax.x), minX));
+			outside = _mm_or_ps(outside, _mm_or_ps(_mm_cmpgt_ps(_mm_set1_ps(f.cornerMin.y), maxY), _mm_cmplt_ps(_mm_set1_ps(f.cornerMax.y), minY)));
+			outside = _mm_or_ps(outside, _mm_or_ps(_mm_cmpgt_ps(_mm_set1_ps(f.cornerMin.z), maxZ), _mm_cmplt_ps(_mm_set1_ps(f.cornerMax.z), minZ)));
+
+			for (int p = 0; p < 6; ++p) {
+				const auto x = f.useMaxX[p] ? maxX : minX;
+				const auto y = f.useMaxY[p] ? maxY : minY;
+				const auto z = f.useMaxZ[p] ? maxZ : minZ;
+				const auto xy = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.nx[p]), x), _mm_mul_ps(_mm_set1_ps(f.ny[p]), y));
+				const auto zw = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.nz[p]), z), _mm_set1_ps(f.d[p]));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(xy, zw), zero));
+			}
+
+			const auto visible = ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+			visibility[i / 32] |= visible << (i % 32);
+		}
+
+		return count;
+	}
+
+	NEX_TARGET_AVX size_t cullFrustumAVX(const FrustumPlanes& f, const nex::AABBBatch& boxes, uint32_t* visibility)
+	{
+		const float* mins[3] = {boxes.minX(), boxes.minY(), boxes.minZ()};
+		const float* maxs[3] = {boxes.maxX(), boxes.maxY(), boxes.maxZ()};
+		const auto zero = _mm256_setzero_ps();
+		const auto count = boxes.size() / 8 * 8;
+
+		for (size_t i = 0; i < count; i += 8) {
+			const auto minX = _mm256_loadu_ps(mins[0] + i);
+			const auto minY = _mm256_loadu_ps(mins[1] + i);
+			const auto minZ = _mm256_loadu_ps(mins[2] + i);
+			const auto maxX = _mm256_loadu_ps(maxs[0] + i);
+			const auto maxY = _mm256_loadu_ps(maxs[1] + i);
+			const auto maxZ = _mm256_loadu_ps(maxs[2] + i);
+
+			auto outside = _mm256_or_ps(_mm256_cmp_ps(_mm256_set1_ps(f.cornerMin.x), maxX, _CMP_GT_OQ), _mm256_cmp_ps(_mm256_set1_ps(f.cornerMax.x), minX, _CMP_LT_OQ));
+			outside = _mm256_or_ps(outside, _mm256_or_ps(_mm256_cmp_ps(_mm256_set1_ps(f.cornerMin.y), maxY, _CMP_GT_OQ), _mm256_cmp_ps(_mm256_set1_ps(f.cornerMax.y), minY, _CMP_LT_OQ)));
+			outside = _mm256_or_ps(outside, _mm256_or_ps(_mm256_cmp_ps(_mm256_set1_ps(f.cornerMin.z), maxZ, _CMP_GT_OQ), _mm256_cmp_ps(_mm256_set1_ps(f.cornerMax.z), minZ, _CMP_LT_OQ)));
+
+			for (int p = 0; p < 6; ++p) {
+				const auto x = f.useMaxX[p] ? maxX : minX;
+				const auto y = f.useMaxY[p] ? maxY : minY;
+				const auto z = f.useMaxZ[p] ? maxZ : minZ;
+				const auto xy = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(f.nx[p]), x), _mm256_mul_ps(_mm256_set1_ps(f.ny[p]), y));
+				const auto zw = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(f.nz[p]), z), _mm256_set1_ps(f.d[p]));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(xy, zw), zero, _CMP_LT_OQ));
+			}
+
+			const auto visible = ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+			visibility[i / 32] |= visible << (i % 32);
+		}
+
+		return count;
+	}
+
+	/**
+	 * Squared distance of the sphere origin to the box along one axis (see Sphere::intersects).
+	 */
+	inline __m128 calcAxisDistanceSSE(__m128 origin, __m128 min, __m128 max)
+	{
+		const auto belowMin = _mm_cmple_ps(origin, min);
+		const auto aboveMax = _mm_andnot_ps(belowMin, _mm_cmpgt_ps(origin, max));
+		const auto diff = _mm_or_ps(_mm_and_ps(belowMin, _mm_sub_ps(origin, min)), _mm_and_ps(aboveMax, _mm_sub_ps(origin, max)));
+		return _mm_mul_ps(diff, diff);
+	}
+
+	size_t cullSphereSSE(const nex::Sphere& sphere, const nex::AABBBatch& boxes, uint32_t* visibility)
+	{
+		const auto originX = _mm_set1_ps(sphere.origin.x);
+		const auto originY = _mm_set1_ps(sphere.origin.y);
+		const auto originZ = _mm_set1_ps(sphere.origin.z);
+		const auto radiusSquared = _mm_set1_ps(sphere.radius * sphere.radius);
+		const auto half = _mm_set1_ps(0.5f);
+		const auto eps = _mm_set1_ps(0.000001f);
+		const auto count = boxes.size() / 4 * 4;
+
+		for (size_t i = 0; i < count; i += 4) {
+			const auto minX = _mm_loadu_ps(boxes.minX() + i);
+			const auto minY = _mm_loadu_ps(boxes.minY() + i);
+			const auto minZ = _mm_loadu_ps(boxes.minZ() + i);
+			const auto maxX = _mm_loadu_ps(boxes.maxX() + i);
+			const auto maxY = _mm_loadu_ps(boxes.maxY() + i);
+			const auto maxZ = _mm_loadu_ps(boxes.maxZ() + i);
+
+			const auto distance = _mm_add_ps(_mm_add_ps(calcAxisDistanceSSE(originX, minX, maxX), calcAxisDistanceSSE(originY, minY, maxY)),
+				calcAxisDistanceSSE(originZ, minZ, maxZ));
+			auto visible = _mm_cmple_ps(distance, radiusSquared);
+
+			// the box center lies inside the sphere
+			const auto dx = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(maxX, minX), half), originX);
+			const auto dy = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(maxY, minY), half), originY);
+			const auto dz = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(maxZ, minZ), half), originZ);
+			const auto centerDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			visible = _mm_or_ps(visible, _mm_cmplt_ps(_mm_sub_ps(centerDistance, radiusSquared), eps));
+
+			visibility[i / 32] |= static_cast<uint32_t>(_mm_movemask_ps(visible)) << (i % 32);
+		}
+
+		return count;
+	}
+
+	bool isAVXSupported()
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		// the OS has to save the AVX registers
+		return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+		return __builtin_cpu_supports("avx");
+#endif
+	}
+
+#endif
+
+	nex::BatchCuller::InstructionSet clampInstructionSet(nex::BatchCuller::InstructionSet set)
+	{
+		return std::min(set, nex::BatchCuller::getSupportedInstructionSet());
+	}
+}
+
+void nex::AABBBatch::clear()
+{
+	mSize = 0;
+	mMinX.clear();
+	mMinY.clear();
+	mMinZ.clear();
+	mMaxX.clear();
+	mMaxY.clear();
+	mMaxZ.clear();
+}
+
+void nex::AABBBatch::push(const AABB& box)
+{
+	mMinX.push_back(box.min.x);
+	mMinY.push_back(box.min.y);
+	mMinZ.push_back(box.min.z);
+	mMaxX.push_back(box.max.x);
+	mMaxY.push_back(box.max.y);
+	mMaxZ.push_back(box.max.z);
+	++mSize;
+}
+
+size_t nex::AABBBatch::size() const
+{
+	return mSize;
+}
+
+nex::BatchCuller::InstructionSet nex::BatchCuller::getSupportedInstructionSet()
+{
+#ifdef NEX_BATCH_CULLER_X86
+	static const auto set = isAVXSupported() ? InstructionSet::AVX : InstructionSet::SSE;
+	return set;
+#else
+	return InstructionSet::SCALAR;
+#endif
+}
+
+size_t nex::BatchCuller::getMaskWordCount(size_t boxCount)
+{
+	return (boxCount + 31) / 32;
+}
+
+void nex::BatchCuller::cullFrustum(const Frustum& frustum, const AABBBatch& boxes, uint32_t* visibility)
+{
+	cullFrustum(frustum, boxes, visibility, getSupportedInstructionSet());
+}
+
+void nex::BatchCuller::cullFrustum(const Frustum& frustum, const AABBBatch& boxes, uint32_t* visibility, InstructionSet set)
+{
+	std::memset(visibility, 0, getMaskWordCount(boxes.size()) * sizeof(uint32_t));
+
+	const FrustumPlanes planes(frustum);
+	size_t processed = 0;
+
+#ifdef NEX_BATCH_CULLER_X86
+	switch (clampInstructionSet(set)) {
+	case InstructionSet::AVX:
+		processed = cullFrustumAVX(planes, boxes, visibility);
+		break;
+	case InstructionSet::SSE:
+		processed = cullFrustumSSE(planes, boxes, visibility);
+		break;
+	default:
+		break;
+	}
+#endif
+
+	cullFrustumScalar(planes, boxes, processed, visibility);
+}
+
+void nex::BatchCuller::cullSphere(const Sphere& sphere, const AABBBatch& boxes, uint32_t* visibility)
+{
+	cullSphere(sphere, boxes, visibility, getSupportedInstructionSet());
+}
+
+void nex::BatchCuller::cullSphere(const Sphere& sphere, const AABBBatch& boxes, uint32_t* visibility, InstructionSet set)
+{
+	std::memset(visibility, 0, getMaskWordCount(boxes.size()) * sizeof(uint32_t));
+
+	size_t processed = 0;
+
+#ifdef NEX_BATCH_CULLER_X86
+	// Note: The sphere test has only a few operations per box, so AVX doesn't pay off.
+	if (clampInstructionSet(set) != InstructionSet::SCALAR) {
+		processed = cullSphereSSE(sphere, boxes, visibility);
+	}
+#endif
+
+	cullSphereScalar(sphere, boxes, processed, visibility);
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <nex/math/BoundingBox.hpp>
+
+namespace nex
+{
+	struct Frustum;
+	struct Sphere;
+
+	/**
+	 * Bounding boxes in structure of arrays layout, as consumed by BatchCuller.
+	 * Note: Clearing the batch keeps the memory, so that refilling it doesn't allocate in the steady state.
+	 */
+	class AABBBatch
+	{
+	public:
+
+		void clear();
+
+		void push(const AABB& box);
+
+		size_t size() const;
+
+		const float* minX() const { return mMinX.data(); }
+		const float* minY() const { return mMinY.data(); }
+		const float* minZ() const { return mMinZ.data(); }
+		const float* maxX() const { return mMaxX.data(); }
+		const float* maxY() const { return mMaxY.data(); }
+		const float* maxZ() const { return mMaxZ.data(); }
+
+	private:
+		std::vector<float> mMinX;
+		std::vector<float> mMinY;
+		std::vector<float> mMinZ;
+		std::vector<float> mMaxX;
+		std::vector<float> mMaxY;
+		std::vector<float> mMaxZ;
+		size_t mSize = 0;
+	};
+
+	/**
+	 * Culls batches of bounding boxes against a frustum or a sphere, 4 (SSE) or 8 (AVX) boxes at once.
+	 * The instruction set is chosen at runtime; a scalar fallback is used on other platforms.
+	 * The results are the same as the results of culling single boxes with RenderCommandQueue.
+	 *
+	 * The result is a visibility bit mask: bit (i % 32) of word (i / 32) is set, if box i is visible.
+	 */
+	class BatchCuller
+	{
+	public:
+
+		enum class InstructionSet {
+			SCALAR,
+			SSE,
+			AVX,
+		};
+
+		/**
+		 * Provides the best instruction set supported by the CPU.
+		 */
+		static InstructionSet getSupportedInstructionSet();
+
+		/**
+		 * Provides the number of words of a visibility mask for a given number of boxes.
+		 */
+		static size_t getMaskWordCount(size_t boxCount);
+
+		/**
+		 * Culls boxes against a frustum.
+		 * A box is culled, if it lies completely outside of one of the frustum planes or if it is separated from the
+		 * bounding box of the frustum corners.
+		 * @param visibility : Receives the visibility mask (getMaskWordCount(boxes.size()) words).
+		 */
+		static void cullFrustum(const Frustum& frustum, const AABBBatch& boxes, uint32_t* visibility);
+		static void cullFrustum(const Frustum& frustum, const AABBBatch& boxes, uint32_t* visibility, InstructionSet set);
+
+		/**
+		 * Culls boxes against a sphere (see Sphere::intersects).
+		 * @param visibility : Receives the visibility mask (getMaskWordCount(boxes.size()) words).
+		 */
+		static void cullSphere(const Sphere& sphere, const AABBBatch& boxes, uint32_t* visibility);
+		static void cullSphere(const Sphere& sphere, const AABBBatch& boxes, uint32_t* visibility, InstructionSet set);
+	};
+}
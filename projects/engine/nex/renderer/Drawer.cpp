@@ -5,6 +5,13 @@
 #include <nex/material/Material.hpp>
 #include <nex/camera/Camera.hpp>
 #include <nex/renderer/RenderCommand.hpp>
+#include <nex/renderer/RenderCommandBuffer.hpp>
+
+namespace nex
+{
+	static unsigned maxRecordingThreads = 0;
+	static bool isReplaying = false;
+}
 
 void nex::Drawer::draw(
 	const std::vector<RenderCommand>& commands, 
@@ -12,6 +19,24 @@ void nex::Drawer::draw(
 	const ShaderOverride<nex::Shader>& overrides,
 	const RenderState* overwriteState)
 {
+	// Large command lists are recorded in parallel and replayed on this thread.
+	// Note: Render functions of the replayed commands might draw command lists on their own; these are drawn directly.
+	if (maxRecordingThreads != 1 && !isReplaying && commands.size() >= 2 * RenderCommandBuffer::MIN_SLICE_SIZE) {
+		static std::vector<RenderCommandBuffer> buffers;
+
+		RenderCommandBuffer::recordParallel(buffers, commands, constants, overrides, overwriteState, maxRecordingThreads);
+
+		isReplaying = true;
+		try {
+			RenderCommandBuffer::replay(buffers, constants, overrides, overwriteState);
+		}
+		catch (...) {
+			isReplaying = false;
+			throw;
+		}
+		isReplaying = false;
+		return;
+	}
 
 	Shader* lastShader = nullptr;
 
@@ -21,7 +46,7 @@ void nex::Drawer::draw(
 	}
 }
 
-void nex::Drawer::draw(const std::multimap<unsigned, RenderCommand>& commands,
+void nex::Drawer::draw(const std::vector<std::pair<unsigned, RenderCommand>>& commands,
 	const RenderContext& constants,
 	const ShaderOverride<nex::Shader>& overrides,
 	const RenderState* overwriteState)
@@ -35,6 +60,16 @@ void nex::Drawer::draw(const std::multimap<unsigned, RenderCommand>& commands,
 	}
 }
 
+void nex::Drawer::setMaxRecordingThreads(unsigned threadCount)
+{
+	maxRecordingThreads = threadCount;
+}
+
+unsigned nex::Drawer::getMaxRecordingThreads()
+{
+	return maxRecordingThreads;
+}
+
 void nex::Drawer::draw(Shader* shader, 
 	const Mesh* mesh, 
 	const Material* material, 
@@ -172,10 +207,7 @@ void nex::Drawer::drawCommand(const RenderCommand& command,
 
 	if (command.isBoneAnimated) {
 
-		auto* buffer = command.boneBuffer;
-		auto* data = command.bones;
-		buffer->update(data->size() * sizeof(glm::mat4), data->data());
-		currentShader->bindBoneTrafoBuffer(buffer);
+		currentShader->uploadBoneTrafos(constants, command.boneBuffer, command.bones);
 	}
 
 	for (auto& pair : command.batch->getEntries()) {
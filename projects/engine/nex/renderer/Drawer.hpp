@@ -32,13 +32,22 @@ namespace nex
 
 		/**
 		 * Draws a list of render commands with a specific transform pass and an optional render state (overwrites the render state of the mesh materials);
+		 * Large lists are recorded in parallel (see RenderCommandBuffer) and replayed on the calling thread.
+		 * Note: Has to be called on the render thread.
 		 */
 		static void draw(const std::vector<RenderCommand>& commands, 
 			const RenderContext& constants,
 			const ShaderOverride<nex::Shader>& overrides,
 			const RenderState* overwriteState = nullptr);
 
-		static void draw(const std::multimap<unsigned, RenderCommand>& commands,
+		/**
+		 * Sets the maximum number of threads used for recording render command lists (see draw).
+		 * 0 uses all threads of the engine's thread pool; 1 disables parallel recording.
+		 */
+		static void setMaxRecordingThreads(unsigned threadCount);
+		static unsigned getMaxRecordingThreads();
+
+		static void draw(const std::vector<std::pair<unsigned, RenderCommand>>& commands,
 			const RenderContext& constants,
 			const ShaderOverride<nex::Shader>& overrides,
 			const RenderState* overwriteState = nullptr);
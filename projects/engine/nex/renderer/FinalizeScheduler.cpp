@@ -0,0 +1,142 @@
+#include <nex/renderer/FinalizeScheduler.hpp>
+#include <chrono>
+
+nex::FinalizeScheduler::FinalizeScheduler(float budgetMillis, size_t queueCapacity) :
+	mIncoming(queueCapacity),
+	mBudgetMillis(budgetMillis),
+	mLogger("FinalizeScheduler")
+{
+}
+
+void nex::FinalizeScheduler::execute(TaskQueue* commandQueue)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto start = Clock::now();
+	const auto budget = std::chrono::duration<float, std::milli>(mBudgetMillis);
+
+	mStats = FrameStats();
+	mStats.budgetMillis = mBudgetMillis;
+
+	collect(commandQueue);
+
+	// Note: The first step is always executed, so that we don't starve if a single step exceeds the budget.
+	while (executeStep()) {
+		if (Clock::now() - start >= budget) break;
+	}
+
+	mStats.usedMillis = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+	for (const auto& pending : mPending) {
+		mStats.deferredTasks += pending.size();
+	}
+}
+
+void nex::FinalizeScheduler::executeAll(TaskQueue* commandQueue)
+{
+	collect(commandQueue);
+
+	while (executeStep() || !mIncoming.empty() || (commandQueue && !commandQueue->empty())) {
+		collect(commandQueue);
+	}
+}
+
+float nex::FinalizeScheduler::getBudget() const
+{
+	return mBudgetMillis;
+}
+
+nex::Executor nex::FinalizeScheduler::getExecutor(Priority priority)
+{
+	return [this, priority](Continuation continuation) {
+		submit(std::move(continuation), priority);
+	};
+}
+
+const nex::FinalizeScheduler::FrameStats& nex::FinalizeScheduler::getFrameStats() const
+{
+	return mStats;
+}
+
+bool nex::FinalizeScheduler::isIdle() const
+{
+	for (const auto& pending : mPending) {
+		if (!pending.empty()) return false;
+	}
+	return mIncoming.empty();
+}
+
+void nex::FinalizeScheduler::setBudget(float millis)
+{
+	mBudgetMillis = millis;
+}
+
+void nex::FinalizeScheduler::submit(Task task, Priority priority)
+{
+	submitStepped([task = std::move(task)]() {
+		task();
+		return true;
+	}, priority);
+}
+
+void nex::FinalizeScheduler::submitStepped(SteppedTask task, Priority priority)
+{
+	mIncoming.push(Entry{ std::move(task), priority });
+}
+
+void nex::FinalizeScheduler::collect(TaskQueue* commandQueue)
+{
+	Entry entry;
+	while (mIncoming.try_pop(entry)) {
+		mPending[static_cast<size_t>(entry.priority)].emplace_back(std::move(entry.task));
+	}
+
+	if (!commandQueue) return;
+
+	Task task;
+	auto& normal = mPending[static_cast<size_t>(Priority::Normal)];
+
+	while (commandQueue->try_pop(task)) {
+		normal.emplace_back([task = std::move(task)]() {
+			task();
+			return true;
+		});
+	}
+}
+
+bool nex::FinalizeScheduler::executeStep()
+{
+	for (auto& pending : mPending) {
+		if (pending.empty()) continue;
+
+		++mStats.executedSteps;
+
+		// Note: The task might submit new tasks; thus the task mustn't be referenced from the deque while executing it.
+		auto task = std::move(pending.front());
+		pending.pop_front();
+
+		bool completed = true;
+
+		try {
+			completed = task();
+		}
+		catch (const std::exception& e) {
+			// Note: the task is already popped; executing it again would most likely throw again.
+			LOG(mLogger, nex::Error) << "Finalization task failed: " << e.what();
+		}
+		catch (...) {
+			LOG(mLogger, nex::Error) << "Finalization task failed with an unknown exception";
+		}
+
+		if (completed) {
+			++mStats.completedTasks;
+		}
+		else {
+			// not finished yet; continue with this task in the next step
+			pending.emplace_front(std::move(task));
+		}
+
+		return true;
+	}
+
+	return false;
+}
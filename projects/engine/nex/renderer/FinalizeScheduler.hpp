@@ -0,0 +1,127 @@
+#pragma once
+#include <deque>
+#include <functional>
+#include <nex/common/ConcurrentQueue.hpp>
+#include <nex/common/Future.hpp>
+#include <nex/common/Log.hpp>
+
+namespace nex
+{
+	/**
+	 * Executes finalization tasks (render backend work that has to be done on the main thread) within a per-frame time budget.
+	 * Tasks are processed by priority class and in FIFO order within the same class.
+	 *
+	 * Large tasks can be split into steps: A stepped task is called repeatedly - as long as the budget permits - until it reports
+	 * completion. So e.g. the finalization of a big model can be spread over several frames instead of causing a hitch.
+	 *
+	 * Submitting tasks is thread-safe; executing them must only be done by the main thread.
+	 *
+	 * A task that throws an exception is logged and counted as completed; it isn't executed again. Tasks that complete a promise
+	 * have to forward the exception to it (see VobBluePrint::finalizeAsync), otherwise dependent futures would wait forever.
+	 */
+	class FinalizeScheduler
+	{
+	public:
+
+		using Task = std::function<void()>;
+
+		/**
+		 * Executes one step of a task.
+		 * @return true, if the task is completed.
+		 */
+		using SteppedTask = std::function<bool()>;
+
+		using TaskQueue = nex::ConcurrentQueue<Task>;
+
+		/**
+		 * Specifies the order, tasks are processed. Tasks with a lower value are processed first.
+		 */
+		enum class Priority {
+			VisibleNow, FIRST = VisibleNow, // Resource is needed for the current frame
+			Normal,
+			Prefetch, LAST = Prefetch, // Resource might be needed in the future
+		};
+
+		/**
+		 * Statistics of the last call of execute()
+		 */
+		struct FrameStats {
+			size_t completedTasks = 0;
+			size_t executedSteps = 0;
+			size_t deferredTasks = 0; // Tasks that are pending after the execution
+			float usedMillis = 0.0f;
+			float budgetMillis = 0.0f;
+		};
+
+		static constexpr float DEFAULT_BUDGET_MILLIS = 4.0f;
+		static constexpr size_t DEFAULT_QUEUE_CAPACITY = 8192;
+
+		explicit FinalizeScheduler(float budgetMillis = DEFAULT_BUDGET_MILLIS, size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+		/**
+		 * Executes pending tasks until the time budget is exhausted.
+		 * At least one step is executed (if any task is pending), so that progress is guaranteed.
+		 * @param commandQueue : (Optional) Tasks of this queue are collected with normal priority before the execution starts.
+		 */
+		void execute(TaskQueue* commandQueue = nullptr);
+
+		/**
+		 * Executes all pending tasks regardless of the time budget.
+		 * Tasks submitted while executing are executed as well.
+		 * @param commandQueue : (Optional) Tasks of this queue are executed with normal priority, too.
+		 */
+		void executeAll(TaskQueue* commandQueue = nullptr);
+
+		float getBudget() const;
+
+		/**
+		 * Provides an executor that submits continuations as tasks to this scheduler (see Future::then).
+		 */
+		Executor getExecutor(Priority priority = Priority::Normal);
+
+		const FrameStats& getFrameStats() const;
+
+		/**
+		 * Checks if no task is pending. Only valid if called from the main thread.
+		 */
+		bool isIdle() const;
+
+		/**
+		 * Sets the time budget (in milliseconds) that is used for executing tasks per frame.
+		 */
+		void setBudget(float millis);
+
+		/**
+		 * Submits a task, that is executed at once.
+		 */
+		void submit(Task task, Priority priority = Priority::Normal);
+
+		/**
+		 * Submits a task that is executed step by step.
+		 */
+		void submitStepped(SteppedTask task, Priority priority = Priority::Normal);
+
+	private:
+
+		static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(Priority::LAST) + 1;
+
+		struct Entry {
+			SteppedTask task;
+			Priority priority;
+		};
+
+		void collect(TaskQueue* commandQueue);
+
+		/**
+		 * Executes one step of the next pending task.
+		 * @return false, if no task is pending.
+		 */
+		bool executeStep();
+
+		nex::ConcurrentQueue<Entry> mIncoming;
+		std::deque<SteppedTask> mPending[PRIORITY_COUNT];
+		FrameStats mStats;
+		float mBudgetMillis;
+		nex::Logger mLogger;
+	};
+}
@@ -1,37 +1,190 @@
 #include <nex/renderer/MaterialDataUpdater.hpp>
+#include <nex/buffer/ShaderBuffer.hpp>
 #include <nex/scene/Scene.hpp>
 #include <nex/scene/Vob.hpp>
 #include <nex/common/Log.hpp>
+#include <nex/util/Profiler.hpp>
 
-void nex::MaterialDataUpdater::updateMaterialData(Scene* scene, ShaderBuffer* materialBuffer)
+nex::MaterialDataUpdater::MaterialDataUpdater(unsigned capacity) :
+	mCapacity(capacity),
+	mData(capacity),
+	mDirty((capacity + 63) / 64, 0),
+	mUsedSlots(0),
+	mUploadedBuffer(nullptr),
+	mCapacityWarned(false)
 {
-	auto lock = scene->acquireLock();
-	const auto& vobs = scene->getActiveVobsUnsafe();
-	const unsigned size = std::min<unsigned>(vobs.size(), MAX_PER_OBJECT_MATERIAL_DATA);
+}
 
+nex::MaterialDataUpdater::~MaterialDataUpdater()
+{
+	clear();
+}
 
-#ifndef EUCLID_ALL_OPTIMIZATIONS
-	if (vobs.size() > MAX_PER_OBJECT_MATERIAL_DATA) {
-		LOG(Logger("nex::MaterialDataUpdater::updateMaterialData"), Warning) << "Not all objects can be mapped to a material data object!";
+void nex::MaterialDataUpdater::attach(Vob* vob)
+{
+	vob->mMaterialDataUpdater = this;
+
+	const bool slotAssigned = hasSlot(vob);
+
+	if (vob->usesPerObjectMaterialData() && !slotAssigned) {
+		allocateSlot(vob);
 	}
-#endif
+	else if (!vob->usesPerObjectMaterialData() && slotAssigned) {
+		releaseSlot(vob);
+	}
+}
+
+void nex::MaterialDataUpdater::detach(Vob* vob)
+{
+	if (vob->mMaterialDataUpdater != this) return;
+	if (hasSlot(vob)) releaseSlot(vob);
+	vob->mMaterialDataUpdater = nullptr;
+}
+
+void nex::MaterialDataUpdater::clear()
+{
+	for (auto* vob : mSlotVobs) {
+		if (!vob) continue;
+		vob->mMaterialDataUpdater = nullptr;
+		vob->setPerObjectMaterialDataID(0);
+	}
+
+	mSlotVobs.clear();
+	mFreeSlots.clear();
+	std::fill(mDirty.begin(), mDirty.end(), 0);
+	mUsedSlots = 0;
+	mUploadedBuffer = nullptr;
+	mCapacityWarned = false;
+}
+
+unsigned nex::MaterialDataUpdater::getCapacity() const
+{
+	return mCapacity;
+}
+
+unsigned nex::MaterialDataUpdater::getUsedSlotCount() const
+{
+	return mUsedSlots;
+}
+
+const nex::MaterialDataUpdater::Stats& nex::MaterialDataUpdater::getStats() const
+{
+	return mStats;
+}
+
+void nex::MaterialDataUpdater::markDirty(const Vob* vob)
+{
+	if (!hasSlot(vob)) return;
+	const auto slot = vob->getPerObjectMaterialDataID();
+	mDirty[slot / 64] |= uint64_t(1) << (slot % 64);
+}
+
+void nex::MaterialDataUpdater::upload(ShaderBuffer* materialBuffer)
+{
+	NEX_PROFILE_SCOPE("MaterialDataUpdater::upload");
 
-	static PerObjectMaterialData data[MAX_PER_OBJECT_MATERIAL_DATA];
+	mStats = Stats();
+	const auto bufferSize = sizeof(PerObjectMaterialData) * mCapacity;
+	const bool fullUpload = materialBuffer != mUploadedBuffer || materialBuffer->getSize() != bufferSize;
 
-	for (unsigned dataID = 0, vobID = 0; 
-		dataID < size && vobID < vobs.size(); 
-		++vobID) 
-	{
-		auto* vob = vobs[vobID];
+	// The host copy is fetched for dirty slots only; runs of consecutive dirty slots are uploaded by one buffer update.
+	unsigned runBegin = 0;
+	unsigned runEnd = 0;
 
-		if (!vob->usesPerObjectMaterialData()) continue;
+	for (size_t i = 0; i < mDirty.size(); ++i) {
+		const auto word = mDirty[i];
+		if (word == 0) continue;
+		mDirty[i] = 0;
 
-		vob->setPerObjectMaterialDataID(dataID);
-		data[dataID] = vob->getPerObjectMaterialData();
-		++dataID;
+		for (unsigned bit = 0; bit < 64; ++bit) {
+			if (!(word & (uint64_t(1) << bit))) continue;
+
+			const auto slot = static_cast<unsigned>(i * 64 + bit);
+			// Note: the non-const getter would mark the slot dirty again
+			if (const auto* vob = mSlotVobs[slot]) {
+				mData[slot] = vob->getPerObjectMaterialData();
+			}
+
+			++mStats.dirtySlots;
+
+			if (slot == runEnd) {
+				++runEnd;
+				continue;
+			}
+
+			if (!fullUpload && runBegin != runEnd) uploadRange(materialBuffer, runBegin, runEnd);
+			runBegin = slot;
+			runEnd = slot + 1;
+		}
 	}
 
-	materialBuffer->resize(sizeof(PerObjectMaterialData) * MAX_PER_OBJECT_MATERIAL_DATA, 
-		data,
-		nex::GpuBuffer::UsageHint::STREAM_DRAW);
-}
\ No newline at end of file
+	if (fullUpload) {
+		materialBuffer->resize(bufferSize, mData.data(), GpuBuffer::UsageHint::DYNAMIC_DRAW);
+		mUploadedBuffer = materialBuffer;
+		mStats.fullUpload = true;
+		mStats.uploads = 1;
+		mStats.uploadedBytes = bufferSize;
+		return;
+	}
+
+	if (runBegin != runEnd) uploadRange(materialBuffer, runBegin, runEnd);
+}
+
+void nex::MaterialDataUpdater::updateMaterialData(Scene* scene, ShaderBuffer* materialBuffer)
+{
+	auto lock = scene->acquireLock();
+	scene->getMaterialDataUpdaterUnsafe().upload(materialBuffer);
+}
+
+bool nex::MaterialDataUpdater::hasSlot(const Vob* vob) const
+{
+	const auto slot = vob->getPerObjectMaterialDataID();
+	return slot < mSlotVobs.size() && mSlotVobs[slot] == vob;
+}
+
+void nex::MaterialDataUpdater::allocateSlot(Vob* vob)
+{
+	unsigned slot;
+
+	if (!mFreeSlots.empty()) {
+		slot = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	}
+	else if (mSlotVobs.size() < mCapacity) {
+		slot = static_cast<unsigned>(mSlotVobs.size());
+		mSlotVobs.push_back(nullptr);
+	}
+	else {
+#ifndef EUCLID_ALL_OPTIMIZATIONS
+		if (!mCapacityWarned) {
+			LOG(Logger("nex::MaterialDataUpdater::allocateSlot"), Warning) << "Not all objects can be mapped to a material data object!";
+			mCapacityWarned = true;
+		}
+#endif
+		vob->setPerObjectMaterialDataID(0);
+		return;
+	}
+
+	mSlotVobs[slot] = vob;
+	vob->setPerObjectMaterialDataID(slot);
+	++mUsedSlots;
+	markDirty(vob);
+}
+
+void nex::MaterialDataUpdater::releaseSlot(Vob* vob)
+{
+	const auto slot = vob->getPerObjectMaterialDataID();
+	mSlotVobs[slot] = nullptr;
+	mFreeSlots.push_back(slot);
+	mDirty[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+	vob->setPerObjectMaterialDataID(0);
+	--mUsedSlots;
+}
+
+void nex::MaterialDataUpdater::uploadRange(ShaderBuffer* materialBuffer, unsigned begin, unsigned end)
+{
+	const auto size = (end - begin) * sizeof(PerObjectMaterialData);
+	materialBuffer->update(size, mData.data() + begin, begin * sizeof(PerObjectMaterialData));
+	++mStats.uploads;
+	mStats.uploadedBytes += size;
+}
@@ -2,17 +2,105 @@
 
 #include <glm/glm.hpp>
 #include <interface/buffers.h>
-#include <nex/renderer/RenderCommandQueue.hpp>
+#include <cstdint>
+#include <vector>
 
 namespace nex
 {
 	class ShaderBuffer;
 	class Scene;
+	class Vob;
 
-
+	/**
+	 * Manages the per object material data of the active vobs of a scene.
+	 *
+	 * Each vob using per object material data gets a stable slot (its per object material data ID); slots of removed vobs
+	 * are reused via a free list. Changes are tracked by a dirty bitset (see Vob::markPerObjectMaterialDataDirty), so that
+	 * an update only uploads the dirty slots, coalesced into contiguous ranges.
+	 */
 	class MaterialDataUpdater
 	{
 	public:
+
+		/**
+		 * Statistics of the last upload.
+		 */
+		struct Stats {
+			size_t dirtySlots = 0;
+			size_t uploads = 0; // number of buffer updates
+			size_t uploadedBytes = 0;
+			bool fullUpload = false;
+		};
+
+		/**
+		 * @param capacity : The maximum number of slots. Vobs exceeding the capacity use slot 0.
+		 */
+		MaterialDataUpdater(unsigned capacity = MAX_PER_OBJECT_MATERIAL_DATA);
+		~MaterialDataUpdater();
+
+		MaterialDataUpdater(const MaterialDataUpdater&) = delete;
+		MaterialDataUpdater& operator=(const MaterialDataUpdater&) = delete;
+
+		/**
+		 * Registers a vob. The vob gets a slot if it uses per object material data; otherwise an assigned slot is released.
+		 * Can be called again when the vob changes whether it uses per object material data.
+		 */
+		void attach(Vob* vob);
+
+		/**
+		 * Releases the slot of a vob and unregisters it.
+		 */
+		void detach(Vob* vob);
+
+		/**
+		 * Releases all slots and unregisters all vobs.
+		 */
+		void clear();
+
+		unsigned getCapacity() const;
+
+		/**
+		 * Provides the number of slots currently assigned to vobs.
+		 */
+		unsigned getUsedSlotCount() const;
+
+		const Stats& getStats() const;
+
+		/**
+		 * Marks the material data of a vob as changed. Does nothing if the vob has no slot.
+		 */
+		void markDirty(const Vob* vob);
+
+		/**
+		 * Uploads the material data of all dirty slots to a material buffer.
+		 * The first upload to a buffer uploads all slots.
+		 */
+		void upload(ShaderBuffer* materialBuffer);
+
+		/**
+		 * Uploads the changed per object material data of a scene.
+		 */
 		static void updateMaterialData(Scene* scene, ShaderBuffer* materialBuffer);
+
+	private:
+
+		bool hasSlot(const Vob* vob) const;
+		void allocateSlot(Vob* vob);
+		void releaseSlot(Vob* vob);
+		void uploadRange(ShaderBuffer* materialBuffer, unsigned begin, unsigned end);
+
+		unsigned mCapacity;
+
+		// host copy of the uploaded data
+		std::vector<PerObjectMaterialData> mData;
+		// owner of each slot (nullptr for free slots)
+		std::vector<Vob*> mSlotVobs;
+		std::vector<unsigned> mFreeSlots;
+		std::vector<uint64_t> mDirty;
+		unsigned mUsedSlots;
+
+		const ShaderBuffer* mUploadedBuffer;
+		bool mCapacityWarned;
+		Stats mStats;
 	};
-}
\ No newline at end of file
+}
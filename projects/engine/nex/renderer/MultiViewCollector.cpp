@@ -0,0 +1,130 @@
+#include <nex/renderer/MultiViewCollector.hpp>
+#include <nex/scene/Scene.hpp>
+#include <nex/scene/Vob.hpp>
+#include <nex/util/Profiler.hpp>
+#include <bitset>
+
+size_t nex::MultiViewCollector::addView(const Frustum& frustum)
+{
+	View view;
+	view.isFrustum = true;
+	view.frustum = frustum;
+	mViews.emplace_back(view);
+	return mViews.size() - 1;
+}
+
+size_t nex::MultiViewCollector::addView(const Sphere& sphere)
+{
+	View view;
+	view.isFrustum = false;
+	view.sphere = sphere;
+	mViews.emplace_back(view);
+	return mViews.size() - 1;
+}
+
+void nex::MultiViewCollector::clear()
+{
+	mViews.clear();
+	mCommands.clear();
+	mVisibility.clear();
+	mMaskWordCount = 0;
+}
+
+void nex::MultiViewCollector::collect(const Scene& scene, const RenderContext& context, const Filter& filter)
+{
+	collect([&](RenderCommandQueue& queue) {
+		auto guard = scene.acquireLock();
+
+		// One query with the union of all views; the commands are culled per view afterwards.
+		scene.queryAABBUnsafe(calcViewsBoundingBox(), [&](Vob* vob) {
+			if (!vob->isVisible()) return;
+			if (!filter || filter(vob)) vob->collectRenderCommands(queue, true, context);
+		});
+	});
+}
+
+void nex::MultiViewCollector::collect(const Traversal& traversal)
+{
+	NEX_PROFILE_SCOPE("MultiViewCollector::collect");
+
+	mRecorder.clear();
+	traversal(mRecorder);
+	mCommands.swap(mRecorder.getCullCandidates());
+	mRecorder.clear();
+
+	cullViews();
+}
+
+void nex::MultiViewCollector::fillQueue(size_t view, RenderCommandQueue& queue) const
+{
+	const auto* visibility = getVisibility(view);
+
+	for (size_t i = 0; i < mCommands.size(); ++i) {
+		if (visibility[i / 32] & (1u << (i % 32))) queue.push(mCommands[i], false);
+	}
+}
+
+const nex::MultiViewCollector::Buffer& nex::MultiViewCollector::getCommands() const
+{
+	return mCommands;
+}
+
+size_t nex::MultiViewCollector::getViewCount() const
+{
+	return mViews.size();
+}
+
+size_t nex::MultiViewCollector::getVisibleCount(size_t view) const
+{
+	return mViews[view].visibleCount;
+}
+
+const uint32_t* nex::MultiViewCollector::getVisibility(size_t view) const
+{
+	return mVisibility.data() + view * mMaskWordCount;
+}
+
+nex::AABB nex::MultiViewCollector::calcViewsBoundingBox() const
+{
+	AABB box;
+
+	for (const auto& view : mViews) {
+		if (view.isFrustum) {
+			box = maxAABB(box, view.frustum.calcAABB());
+		}
+		else {
+			const glm::vec3 radius(view.sphere.radius);
+			box = maxAABB(box, AABB(view.sphere.origin - radius, view.sphere.origin + radius));
+		}
+	}
+
+	return box;
+}
+
+void nex::MultiViewCollector::cullViews()
+{
+	mBoxes.clear();
+	for (const auto& command : mCommands) {
+		mBoxes.push(*command.boundingBox);
+	}
+
+	mMaskWordCount = BatchCuller::getMaskWordCount(mCommands.size());
+	mVisibility.resize(mMaskWordCount * mViews.size());
+
+	for (size_t i = 0; i < mViews.size(); ++i) {
+		auto& view = mViews[i];
+		auto* visibility = mVisibility.data() + i * mMaskWordCount;
+
+		if (view.isFrustum) {
+			BatchCuller::cullFrustum(view.frustum, mBoxes, visibility);
+		}
+		else {
+			BatchCuller::cullSphere(view.sphere, mBoxes, visibility);
+		}
+
+		view.visibleCount = 0;
+		for (size_t w = 0; w < mMaskWordCount; ++w) {
+			view.visibleCount += std::bitset<32>(visibility[w]).count();
+		}
+	}
+}
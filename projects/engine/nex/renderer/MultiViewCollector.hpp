@@ -0,0 +1,100 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include <nex/camera/Camera.hpp>
+#include <nex/math/Sphere.hpp>
+#include <nex/renderer/BatchCuller.hpp>
+#include <nex/renderer/RenderCommandQueue.hpp>
+
+namespace nex
+{
+	class Scene;
+	class Vob;
+	struct RenderContext;
+
+	/**
+	 * Collects the render commands for multiple views (e.g. camera frustums, shadow cascade frustums, probe spheres)
+	 * with a single scene traversal. The collected commands are culled against each view (see BatchCuller) and
+	 * the result is stored as a visibility bit mask per view (bit (i % 32) of word (i / 32) is set, if command i is visible).
+	 *
+	 * Usage: add the views, collect the commands and fill the render command queues of the views.
+	 */
+	class MultiViewCollector
+	{
+	public:
+
+		using Buffer = RenderCommandQueue::Buffer;
+		using Filter = std::function<bool(Vob*)>;
+
+		/**
+		 * A traversal has to push the render commands to the queue with culling enabled.
+		 */
+		using Traversal = std::function<void(RenderCommandQueue& queue)>;
+
+		/**
+		 * Adds a view.
+		 * @return the index of the view.
+		 */
+		size_t addView(const Frustum& frustum);
+		size_t addView(const Sphere& sphere);
+
+		/**
+		 * Removes all views and commands.
+		 */
+		void clear();
+
+		/**
+		 * Collects the render commands of all active vobs of a scene that (potentially) overlap one of the views
+		 * and culls them against the views.
+		 * Note: Acquires the lock of the scene.
+		 */
+		void collect(const Scene& scene, const RenderContext& context, const Filter& filter = nullptr);
+
+		/**
+		 * Collects the render commands of a custom traversal and culls them against the views.
+		 */
+		void collect(const Traversal& traversal);
+
+		/**
+		 * Pushes the visible commands of a view to a queue (without further culling).
+		 * Note: The culling volume of the queue should be set before (it is used for sorting).
+		 */
+		void fillQueue(size_t view, RenderCommandQueue& queue) const;
+
+		/**
+		 * Provides all commands collected by the last traversal.
+		 */
+		const Buffer& getCommands() const;
+
+		size_t getViewCount() const;
+
+		/**
+		 * Provides the number of visible commands of a view.
+		 */
+		size_t getVisibleCount(size_t view) const;
+
+		/**
+		 * Provides the visibility bit mask of a view (BatchCuller::getMaskWordCount(getCommands().size()) words).
+		 */
+		const uint32_t* getVisibility(size_t view) const;
+
+	private:
+
+		struct View {
+			bool isFrustum;
+			Frustum frustum;
+			Sphere sphere;
+			size_t visibleCount = 0;
+		};
+
+		AABB calcViewsBoundingBox() const;
+		void cullViews();
+
+		std::vector<View> mViews;
+		RenderCommandQueue mRecorder;
+		Buffer mCommands;
+		AABBBatch mBoxes;
+		std::vector<uint32_t> mVisibility;
+		size_t mMaskWordCount = 0;
+	};
+}
@@ -42,7 +42,8 @@ namespace nex
 	{
 		INVALID,   // use this to specify that no renderer will be used 
 		OPENGL,
-		DIRECTX
+		DIRECTX,
+		HEADLESS   // records the calls without rendering anything (see engine_null)
 	};
 
 	/**
@@ -54,6 +55,7 @@ namespace nex
 		{
 		case OPENGL: return os << "OpenGL";
 		case DIRECTX: return os << "DirectX";
+		case HEADLESS: return os << "Headless";
 			// omit default case to trigger compiler warning for missing cases
 		};
 		return os << static_cast<uint16_t>(type);
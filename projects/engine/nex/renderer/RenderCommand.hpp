@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <glm/mat4x4.hpp>
 #include <nex/math/BoundingBox.hpp>
 #include <nex/shader/Shader.hpp>
@@ -48,21 +49,40 @@ namespace nex
 		 */
 		size_t instanceCount = 0;
 
+		/**
+		 * For instanced commands created by the RenderCommandQueue: 
+		 * The world and previous world transformation matrices of the instances (instanceCount each).
+		 */
+		const glm::mat4* instanceWorldTrafos = nullptr;
+		const glm::mat4* instancePrevWorldTrafos = nullptr;
+
+		/**
+		 * For instanced bone animated commands: The bone palette offsets of the instances (instanceCount).
+		 */
+		const unsigned* instanceBoneOffsets = nullptr;
+
 		/** 
 		 * Indicates that the shader of the batch needs a bone trafo upload
 		 */
 		bool isBoneAnimated = false;
 		
 		/** 
-		 * Has to point to a valid vector if isBoneAnimated is set to true
+		 * The bone transformations to upload for a bone animated command.
+		 * If null, the bone transformations are read from the bone palette of the render context (see boneOffset).
+		 * Render command queues using a bone palette move the bone transformations of visible commands to the palette.
 		 */
 		const std::vector<glm::mat4>* bones = nullptr;
 		
 		/** 
-		 * Has to point to a valid buffer if isBoneAnimated is set to true 
+		 * Has to point to a valid buffer if bones is set
 		 */
 		ShaderBuffer* boneBuffer = nullptr;
 
+		/**
+		 * The offset of the first bone transformation in the bone palette.
+		 */
+		unsigned boneOffset = 0;
+
 		/**
 		 * The render function used for rendering the command. 
 		 */
@@ -94,5 +114,11 @@ namespace nex
 		 * For transform shader objects. Specifies the id for material data.
 		 */
 		unsigned perObjectMaterialID = 0;
+
+		/**
+		 * Key for sorting the command within its command buffer. 
+		 * Note: Is set by the RenderCommandQueue when the command is pushed.
+		 */
+		uint64_t sortKey = 0;
 	};
 }
\ No newline at end of file
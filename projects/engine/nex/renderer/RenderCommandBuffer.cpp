@@ -0,0 +1,373 @@
+#include <nex/renderer/RenderCommandBuffer.hpp>
+#include <nex/renderer/RenderCommand.hpp>
+#include <nex/renderer/RenderContext.hpp>
+#include <nex/renderer/RenderBackend.hpp>
+#include <nex/camera/Camera.hpp>
+#include <nex/material/Material.hpp>
+#include <nex/mesh/MeshGroup.hpp>
+#include <nex/mesh/Mesh.hpp>
+#include <nex/buffer/ShaderBuffer.hpp>
+#include <nex/util/concurrent/ThreadPool.hpp>
+#include <nex/util/Profiler.hpp>
+#include <algorithm>
+
+namespace nex
+{
+	namespace
+	{
+		struct BindShaderOp
+		{
+			Shader* shader;
+		};
+
+		struct UploadTransformsOp
+		{
+			uint64_t instanceCount;
+			// followed by PerObjectData and instanceCount InstanceData
+		};
+
+		struct UpdateInstanceOp
+		{
+			Shader* shader;
+			const RenderCommand* command;
+		};
+
+		struct UpdateMaterialOp
+		{
+			Shader* shader;
+			const Material* material;
+		};
+
+		struct UploadBonesOp
+		{
+			Shader* shader;
+			ShaderBuffer* buffer;
+			const std::vector<glm::mat4>* bones;
+		};
+
+		struct BindVertexArrayOp
+		{
+			const VertexArray* vertexArray;
+		};
+
+		struct BindIndexBufferOp
+		{
+			const IndexBuffer* indexBuffer;
+		};
+
+		struct DrawIndexedOp
+		{
+			const RenderState* state;
+			uint64_t count;
+			uint64_t instanceCount;
+			Topology topology;
+			IndexElementType type;
+		};
+
+		struct DrawArrayOp
+		{
+			const RenderState* state;
+			uint64_t offset;
+			uint64_t count;
+			uint64_t instanceCount;
+			Topology topology;
+		};
+
+		struct CallOp
+		{
+			const RenderCommand* command;
+		};
+
+		constexpr size_t toWords(size_t byteSize)
+		{
+			return (byteSize + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+		}
+	}
+}
+
+void nex::RenderCommandBuffer::clear()
+{
+	mSize = 0;
+	mOperationCount = 0;
+	mRecordedShader = nullptr;
+}
+
+bool nex::RenderCommandBuffer::empty() const
+{
+	return mOperationCount == 0;
+}
+
+size_t nex::RenderCommandBuffer::getOperationCount() const
+{
+	return mOperationCount;
+}
+
+size_t nex::RenderCommandBuffer::getSize() const
+{
+	return mSize;
+}
+
+void nex::RenderCommandBuffer::record(const RenderCommand* begin,
+	const RenderCommand* end,
+	const RenderContext& constants,
+	const ShaderOverride<nex::Shader>& overrides,
+	const RenderState* overwriteState)
+{
+	// The bound shader is unknown at the start of a slice; replay skips the bind if the previous slice ended with it.
+	mRecordedShader = nullptr;
+
+	for (auto* command = begin; command != end; ++command) {
+		recordCommand(*command, constants, overrides, overwriteState);
+	}
+}
+
+void nex::RenderCommandBuffer::replay(ReplayState& state,
+	const RenderContext& constants,
+	const ShaderOverride<nex::Shader>& overrides,
+	const RenderState* overwriteState) const
+{
+	thread_local auto* backend = RenderBackend::get();
+
+	const auto* current = mData.data();
+	const auto* end = current + toWords(mSize);
+
+	while (current != end) {
+		const auto& header = *reinterpret_cast<const Header*>(current);
+		const auto* payload = current + toWords(sizeof(Header));
+		current = payload + toWords(header.size);
+
+		switch (header.opcode) {
+		case Opcode::BIND_SHADER: {
+			auto* shader = read<BindShaderOp>(payload).shader;
+			if (state.shader == shader) break;
+			state.shader = shader;
+			shader->bind();
+			shader->updateConstants(constants);
+			break;
+		}
+		case Opcode::UPLOAD_TRANSFORMS: {
+			const auto instanceCount = read<UploadTransformsOp>(payload).instanceCount;
+			const auto* perObjectData = reinterpret_cast<const PerObjectData*>(payload + toWords(sizeof(UploadTransformsOp)));
+			const auto* instances = reinterpret_cast<const InstanceData*>(
+				reinterpret_cast<const char*>(perObjectData) + sizeof(PerObjectData));
+			TransformShader::uploadTransforms(constants, *perObjectData, instances, instanceCount);
+			break;
+		}
+		case Opcode::UPDATE_INSTANCE: {
+			const auto& op = read<UpdateInstanceOp>(payload);
+			op.shader->updateInstance(constants, *op.command);
+			// custom instance updates might bind vertex arrays
+			state.vertexArray = nullptr;
+			state.indexBuffer = nullptr;
+			break;
+		}
+		case Opcode::UPDATE_MATERIAL: {
+			const auto& op = read<UpdateMaterialOp>(payload);
+			op.shader->updateMaterial(*op.material);
+			break;
+		}
+		case Opcode::UPLOAD_BONES: {
+			const auto& op = read<UploadBonesOp>(payload);
+			op.shader->uploadBoneTrafos(constants, op.buffer, op.bones);
+			break;
+		}
+		case Opcode::BIND_VERTEX_ARRAY: {
+			const auto* vertexArray = read<BindVertexArrayOp>(payload).vertexArray;
+			if (state.vertexArray == vertexArray) break;
+			state.vertexArray = vertexArray;
+			// the index buffer binding is part of the vertex array state
+			state.indexBuffer = nullptr;
+			vertexArray->bind();
+			break;
+		}
+		case Opcode::BIND_INDEX_BUFFER: {
+			const auto* indexBuffer = read<BindIndexBufferOp>(payload).indexBuffer;
+			if (state.indexBuffer == indexBuffer) break;
+			state.indexBuffer = indexBuffer;
+			indexBuffer->bind();
+			break;
+		}
+		case Opcode::DRAW_INDEXED: {
+			const auto& op = read<DrawIndexedOp>(payload);
+			if (op.instanceCount) {
+				backend->drawWithIndicesInstanced(op.instanceCount, *op.state, op.topology, op.count, op.type);
+			}
+			else {
+				backend->drawWithIndices(*op.state, op.topology, op.count, op.type);
+			}
+			break;
+		}
+		case Opcode::DRAW_ARRAY: {
+			const auto& op = read<DrawArrayOp>(payload);
+			if (op.instanceCount) {
+				backend->drawArrayInstanced(*op.state, op.topology, op.offset, op.count, op.instanceCount);
+			}
+			else {
+				backend->drawArray(*op.state, op.topology, op.offset, op.count);
+			}
+			break;
+		}
+		case Opcode::CALL: {
+			const auto& command = *read<CallOp>(payload).command;
+			command.renderFunc(command, &state.shader, constants, overrides, overwriteState);
+			// the render function might bind anything
+			state.vertexArray = nullptr;
+			state.indexBuffer = nullptr;
+			break;
+		}
+		}
+	}
+}
+
+void nex::RenderCommandBuffer::recordParallel(std::vector<RenderCommandBuffer>& buffers,
+	const std::vector<RenderCommand>& commands,
+	const RenderContext& constants,
+	const ShaderOverride<nex::Shader>& overrides,
+	const RenderState* overwriteState,
+	unsigned maxThreads)
+{
+	NEX_PROFILE_SCOPE("RenderCommandBuffer::recordParallel");
+
+	auto* pool = util::ThreadPool::get();
+	const size_t threadCount = maxThreads == 0 ? pool->getThreadCount() : std::min(maxThreads, pool->getThreadCount());
+	const size_t maxSliceCount = std::max<size_t>((commands.size() + MIN_SLICE_SIZE - 1) / MIN_SLICE_SIZE, 1);
+	const size_t sliceCount = std::min(std::max<size_t>(threadCount, 1), maxSliceCount);
+	const size_t sliceSize = (commands.size() + sliceCount - 1) / sliceCount;
+
+	if (buffers.size() < sliceCount) buffers.resize(sliceCount);
+	for (auto& buffer : buffers) buffer.clear();
+
+	const auto* data = commands.data();
+	const auto* dataEnd = data + commands.size();
+
+	pool->parallelFor(sliceCount, 1, [&](size_t begin, size_t end) {
+		for (auto slice = begin; slice < end; ++slice) {
+			const auto* sliceBegin = std::min(data + slice * sliceSize, dataEnd);
+			const auto* sliceEnd = std::min(sliceBegin + sliceSize, dataEnd);
+			buffers[slice].record(sliceBegin, sliceEnd, constants, overrides, overwriteState);
+		}
+	}, static_cast<unsigned>(threadCount));
+}
+
+void nex::RenderCommandBuffer::replay(const std::vector<RenderCommandBuffer>& buffers,
+	const RenderContext& constants,
+	const ShaderOverride<nex::Shader>& overrides,
+	const RenderState* overwriteState)
+{
+	NEX_PROFILE_SCOPE("RenderCommandBuffer::replay");
+
+	ReplayState state;
+
+	for (const auto& buffer : buffers) {
+		if (buffer.empty()) continue;
+		buffer.replay(state, constants, overrides, overwriteState);
+	}
+}
+
+void* nex::RenderCommandBuffer::push(Opcode opcode, size_t payloadSize)
+{
+	const auto offset = toWords(mSize);
+	const auto payloadOffset = offset + toWords(sizeof(Header));
+	const auto requiredWords = payloadOffset + toWords(payloadSize);
+
+	// never shrinks, so a buffer reused each frame stops allocating after the first frames
+	if (requiredWords > mData.size()) {
+		mData.resize(std::max(requiredWords, mData.size() * 2));
+	}
+
+	auto& header = *reinterpret_cast<Header*>(mData.data() + offset);
+	header.opcode = opcode;
+	header.size = static_cast<uint32_t>(payloadSize);
+
+	mSize = requiredWords * sizeof(uint64_t);
+	++mOperationCount;
+
+	return mData.data() + payloadOffset;
+}
+
+template<typename T>
+void nex::RenderCommandBuffer::push(Opcode opcode, const T& payload)
+{
+	new (push(opcode, sizeof(T))) T(payload);
+}
+
+template<typename T>
+const T& nex::RenderCommandBuffer::read(const uint64_t* payload)
+{
+	return *reinterpret_cast<const T*>(payload);
+}
+
+void nex::RenderCommandBuffer::recordCommand(const RenderCommand& command,
+	const RenderContext& constants,
+	const ShaderOverride<nex::Shader>& overrides,
+	const RenderState* overwriteState)
+{
+	if (command.renderFunc != Drawer::drawCommand) {
+		push(Opcode::CALL, CallOp{ &command });
+		// the custom render function might bind any shader
+		mRecordedShader = nullptr;
+		return;
+	}
+
+	// Note: the following mirrors Drawer::drawCommand
+	auto* shader = command.isBoneAnimated ? overrides.rigged : overrides.default;
+	if (!shader) shader = command.batch->getShader();
+
+	if (mRecordedShader != shader) {
+		mRecordedShader = shader;
+		push(Opcode::BIND_SHADER, BindShaderOp{ shader });
+	}
+
+	if (shader->usesTransformInstanceData() && constants.camera) {
+		const bool instanced = command.instanceWorldTrafos != nullptr;
+		const size_t instanceCount = instanced ? command.instanceCount : 0;
+		const auto transformsSize = sizeof(UploadTransformsOp) + sizeof(PerObjectData) + instanceCount * sizeof(InstanceData);
+
+		auto* payload = static_cast<uint64_t*>(push(Opcode::UPLOAD_TRANSFORMS, transformsSize));
+		reinterpret_cast<UploadTransformsOp*>(payload)->instanceCount = instanceCount;
+		auto* perObjectData = reinterpret_cast<PerObjectData*>(payload + toWords(sizeof(UploadTransformsOp)));
+		auto* instances = reinterpret_cast<InstanceData*>(reinterpret_cast<char*>(perObjectData) + sizeof(PerObjectData));
+
+		// TransformShader::updateConstants takes the matrices from the camera
+		const auto* camera = constants.camera;
+		TransformShader::calcTransforms(camera->getProjectionMatrix(), camera->getView(), camera->getViewProjPrev(),
+			command, *perObjectData, instances);
+	}
+	else {
+		push(Opcode::UPDATE_INSTANCE, UpdateInstanceOp{ shader, &command });
+	}
+
+	if (command.isBoneAnimated) {
+		push(Opcode::UPLOAD_BONES, UploadBonesOp{ shader, command.boneBuffer, command.bones });
+	}
+
+	static const RenderState defaultState;
+
+	for (const auto& pair : command.batch->getEntries()) {
+		const auto* material = pair.second;
+
+		if (material) push(Opcode::UPDATE_MATERIAL, UpdateMaterialOp{ shader, material });
+
+		const RenderState* state = &defaultState;
+		if (overwriteState) state = overwriteState;
+		else if (material) state = &material->getRenderState();
+
+		recordDraw(pair.first, state, command.instanceCount);
+	}
+}
+
+void nex::RenderCommandBuffer::recordDraw(const Mesh* mesh, const RenderState* state, size_t instanceCount)
+{
+	push(Opcode::BIND_VERTEX_ARRAY, BindVertexArrayOp{ &mesh->getVertexArray() });
+
+	if (mesh->getUseIndexBuffer()) {
+		const auto* indexBuffer = mesh->getIndexBuffer();
+		push(Opcode::BIND_INDEX_BUFFER, BindIndexBufferOp{ indexBuffer });
+		push(Opcode::DRAW_INDEXED, DrawIndexedOp{ state, indexBuffer->getCount(), instanceCount,
+			mesh->getTopology(), indexBuffer->getType() });
+	}
+	else {
+		push(Opcode::DRAW_ARRAY, DrawArrayOp{ state, mesh->getArrayOffset(), mesh->getVertexCount(), instanceCount,
+			mesh->getTopology() });
+	}
+}
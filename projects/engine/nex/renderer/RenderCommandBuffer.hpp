@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <nex/shader/Shader.hpp>
+
+namespace nex
+{
+	struct RenderCommand;
+	struct RenderState;
+	class IndexBuffer;
+	class Mesh;
+	class VertexArray;
+
+	/**
+	 * A backend agnostic buffer of recorded draw operations.
+	 * Recording resolves everything Drawer::drawCommand would do on the render thread, that doesn't need the render backend
+	 * (shader selection, transform calculations, render states, draw parameters). Thus, slices of a sorted command buffer
+	 * can be recorded on worker threads in parallel and replayed in order on the render thread.
+	 *
+	 * The operations are stored as a compact stream: An 8 byte header (opcode and payload size) followed by the payload
+	 * (padded to 8 bytes).
+	 */
+	class RenderCommandBuffer
+	{
+	public:
+
+		enum class Opcode : uint32_t
+		{
+			BIND_SHADER,		// binds a shader and updates its constants
+			UPLOAD_TRANSFORMS,	// uploads precalculated per object (and instance) data of a transform shader
+			UPDATE_INSTANCE,	// calls Shader::updateInstance on the render thread
+			UPDATE_MATERIAL,	// applies material uniforms and textures
+			UPLOAD_BONES,		// uploads and binds the bone transformations
+			BIND_VERTEX_ARRAY,
+			BIND_INDEX_BUFFER,
+			DRAW_INDEXED,
+			DRAW_ARRAY,
+			CALL,				// executes the render function of a command with a custom render function
+		};
+
+		/**
+		 * The bound state while replaying; used for skipping redundant binds.
+		 * Has to be shared by all buffers replayed for one command list.
+		 */
+		struct ReplayState
+		{
+			Shader* shader = nullptr;
+			const VertexArray* vertexArray = nullptr;
+			const IndexBuffer* indexBuffer = nullptr;
+		};
+
+		/**
+		 * Removes all recorded operations. Note: The buffer keeps its memory.
+		 */
+		void clear();
+
+		bool empty() const;
+
+		/**
+		 * Provides the number of recorded operations.
+		 */
+		size_t getOperationCount() const;
+
+		/**
+		 * Provides the size (in bytes) of the recorded operations.
+		 */
+		size_t getSize() const;
+
+		/**
+		 * Records the commands [begin, end). Doesn't call into the render backend, so it can be called from worker threads
+		 * (one buffer per thread). The commands and the render context mustn't change until the buffer is replayed.
+		 */
+		void record(const RenderCommand* begin,
+			const RenderCommand* end,
+			const RenderContext& constants,
+			const ShaderOverride<nex::Shader>& overrides,
+			const RenderState* overwriteState);
+
+		/**
+		 * Executes the recorded operations. Has to be called on the render thread.
+		 * Shaders, vertex arrays and index buffers are only bound if they differ from the bound ones in the replay state.
+		 */
+		void replay(ReplayState& state,
+			const RenderContext& constants,
+			const ShaderOverride<nex::Shader>& overrides,
+			const RenderState* overwriteState) const;
+
+		/**
+		 * Records a command list in parallel into the given buffers (one slice per buffer) using the engine's thread pool.
+		 * The buffers are only grown and keep their memory for subsequent frames. Replaying them in order is equivalent to
+		 * drawing the commands one after another with their render functions.
+		 * @param maxThreads : The maximum number of recording threads (including the calling thread). 0 uses all threads.
+		 */
+		static void recordParallel(std::vector<RenderCommandBuffer>& buffers,
+			const std::vector<RenderCommand>& commands,
+			const RenderContext& constants,
+			const ShaderOverride<nex::Shader>& overrides,
+			const RenderState* overwriteState,
+			unsigned maxThreads = 0);
+
+		/**
+		 * Replays buffers in order. Unused (empty) buffers are skipped.
+		 */
+		static void replay(const std::vector<RenderCommandBuffer>& buffers,
+			const RenderContext& constants,
+			const ShaderOverride<nex::Shader>& overrides,
+			const RenderState* overwriteState);
+
+		/**
+		 * The minimum number of commands recorded by one thread.
+		 */
+		static constexpr size_t MIN_SLICE_SIZE = 256;
+
+	private:
+
+		struct Header
+		{
+			Opcode opcode;
+			uint32_t size;
+		};
+
+		/**
+		 * Appends an operation and provides the memory for its payload.
+		 */
+		void* push(Opcode opcode, size_t payloadSize);
+
+		template<typename T>
+		void push(Opcode opcode, const T& payload);
+
+		void recordCommand(const RenderCommand& command,
+			const RenderContext& constants,
+			const ShaderOverride<nex::Shader>& overrides,
+			const RenderState* overwriteState);
+
+		void recordDraw(const Mesh* mesh, const RenderState* state, size_t instanceCount);
+
+		template<typename T>
+		static const T& read(const uint64_t* payload);
+
+		std::vector<uint64_t> mData;
+		size_t mSize = 0;
+		size_t mOperationCount = 0;
+		Shader* mRecordedShader = nullptr;
+	};
+}
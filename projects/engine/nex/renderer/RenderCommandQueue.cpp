@@ -1,11 +1,15 @@
 #include <nex/renderer/RenderCommandQueue.hpp>
+#include <nex/anim/BonePalette.hpp>
 #include <nex/camera/Camera.hpp>
 #include "nex/material/Material.hpp"
 #include <algorithm>
+#include <cstring>
 #include "nex/scene/Scene.hpp"
 #include <nex/math/Sphere.hpp>
 #include <nex/GI/Probe.hpp>
 #include <nex/mesh/MeshGroup.hpp>
+#include <nex/shader/Shader.hpp>
+#include <nex/util/Profiler.hpp>
 
 #undef max
 
@@ -25,6 +29,40 @@ void nex::RenderCommandQueue::clear()
 	mShadowCommands.clear();
 	mToolCommands.clear();
 	mTransparentCommands.clear();
+	mCullCandidates.clear();
+	mUsedInstanceGroups = 0;
+}
+
+void nex::RenderCommandQueue::cull()
+{
+	if (mCullCandidates.empty()) return;
+
+	NEX_PROFILE_SCOPE("RenderCommandQueue::cull");
+
+	mCullBoxes.clear();
+	for (const auto& command : mCullCandidates) {
+		mCullBoxes.push(*command.boundingBox);
+	}
+
+	mVisibility.resize(BatchCuller::getMaskWordCount(mCullBoxes.size()));
+
+	if (mCullingMethod == CullingMethod::FRUSTUM) {
+		if (mCamera) {
+			BatchCuller::cullFrustum(mCamera->getFrustumWorld(), mCullBoxes, mVisibility.data());
+		}
+		else {
+			std::fill(mVisibility.begin(), mVisibility.end(), 0u);
+		}
+	}
+	else {
+		BatchCuller::cullSphere(mSphereCuller, mCullBoxes, mVisibility.data());
+	}
+
+	for (size_t i = 0; i < mCullCandidates.size(); ++i) {
+		if (mVisibility[i / 32] & (1u << (i % 32))) addVisible(mCullCandidates[i]);
+	}
+
+	mCullCandidates.clear();
 }
 
 nex::AABB nex::RenderCommandQueue::calcBoundingBox(const Buffer& buffer)
@@ -123,12 +161,12 @@ const nex::RenderCommandQueue::Buffer & nex::RenderCommandQueue::getProbeCommand
 	return mProbeCommands;
 }
 
-std::multimap<unsigned, nex::RenderCommand>& nex::RenderCommandQueue::getToolCommands() 
+nex::RenderCommandQueue::ToolBuffer& nex::RenderCommandQueue::getToolCommands() 
 {
 	return mToolCommands;
 }
 
-const std::multimap<unsigned, nex::RenderCommand>& nex::RenderCommandQueue::getToolCommands() const
+const nex::RenderCommandQueue::ToolBuffer& nex::RenderCommandQueue::getToolCommands() const
 {
 	return mToolCommands;
 }
@@ -153,10 +191,23 @@ const nex::RenderCommandQueue::Buffer & nex::RenderCommandQueue::getShadowComman
 	return mShadowCommands;
 }
 
+nex::RenderCommandQueue::Buffer& nex::RenderCommandQueue::getCullCandidates()
+{
+	return mCullCandidates;
+}
+
 void nex::RenderCommandQueue::push(const RenderCommand& command, bool doCulling)
 {
-	if (!isInRange(doCulling, command)) return;
+	if (doCulling) {
+		mCullCandidates.emplace_back(command);
+		return;
+	}
+
+	addVisible(command);
+}
 
+void nex::RenderCommandQueue::add(const RenderCommand& command)
+{
 	bool hasBatch = command.batch;
 
 	bool isPbr = false;
@@ -197,6 +248,7 @@ void nex::RenderCommandQueue::push(const RenderCommand& command, bool doCulling)
 	{
 		//command.material->getRenderState().doDepthWrite = false;
 		mTransparentCommands.emplace_back(command);
+		mTransparentCommands.back().sortKey = calcTransparentSortKey(command);
 	}
 	else if (isProbe)
 	{
@@ -205,12 +257,18 @@ void nex::RenderCommandQueue::push(const RenderCommand& command, bool doCulling)
 	}
 	else if (isTool)
 	{
-		mToolCommands.insert(std::pair<unsigned, RenderCommand>(state->toolDrawIndex, command));
+		// insert after all commands with the same draw index; there are only a few tool commands, so the linear insertion is cheap
+		const auto drawIndex = state->toolDrawIndex;
+		auto it = std::upper_bound(mToolCommands.begin(), mToolCommands.end(), drawIndex, [](unsigned index, const auto& pair) {
+			return index < pair.first;
+		});
+		mToolCommands.emplace(it, drawIndex, command);
 	}
 
 	else if (isPbr)
 	{
 		mDeferredPbrCommands.emplace_back(command);
+		mDeferredPbrCommands.back().sortKey = calcOpaqueSortKey(command, false);
 	} 
 	else
 	{
@@ -220,105 +278,101 @@ void nex::RenderCommandQueue::push(const RenderCommand& command, bool doCulling)
 	if (castsShadow)
 	{
 		mShadowCommands.emplace_back(command);
+		mShadowCommands.back().sortKey = calcOpaqueSortKey(command, true);
 	}
 }
 
-void nex::RenderCommandQueue::useCameraCulling(Camera* camera)
+void nex::RenderCommandQueue::addVisible(const RenderCommand& command)
 {
-	mCullingMethod = CullingMethod::FRUSTUM;
-	mCamera = camera;
+	if (!mBonePalette || !command.bones) {
+		add(command);
+		return;
+	}
+
+	// Note: The pose has the bone transformations as owner; it is shared by all batches of a vob and by all views.
+	unsigned boneOffset;
+	if (!mBonePalette->add(command.bones, *command.bones, boneOffset)) {
+		add(command);
+		return;
+	}
+
+	RenderCommand paletteCommand = command;
+	paletteCommand.bones = nullptr;
+	paletteCommand.boneBuffer = nullptr;
+	paletteCommand.boneOffset = boneOffset;
+	add(paletteCommand);
 }
 
-void nex::RenderCommandQueue::useSphereCulling(const glm::vec3 & position, float radius)
+const nex::Camera* nex::RenderCommandQueue::getCullingCamera() const
 {
-	mCamera = nullptr;
-	mCullingMethod = CullingMethod::FRUSTUM_SPHERE;
-	mSphereCuller = Sphere(position, radius);
+	return mCamera;
 }
 
-void nex::RenderCommandQueue::sort()
+nex::RenderCommandQueue::CullingMethod nex::RenderCommandQueue::getCullingMethod() const
 {
-	std::sort(mDeferredPbrCommands.begin(), mDeferredPbrCommands.end(), defaultCompare);
-	std::sort(mShadowCommands.begin(), mShadowCommands.end(), defaultCompare);
+	return mCullingMethod;
+}
 
-	auto compareBind = std::bind(&nex::RenderCommandQueue::transparentCompare, this, std::placeholders::_1, std::placeholders::_2);
-	std::sort(mTransparentCommands.begin(), mTransparentCommands.end(), compareBind);
+const nex::Sphere& nex::RenderCommandQueue::getCullingSphere() const
+{
+	return mSphereCuller;
 }
 
+void nex::RenderCommandQueue::useBonePalette(BonePalette* palette)
+{
+	mBonePalette = palette;
+}
 
-// false if fully outside, true if inside or intersects
-bool nex::RenderCommandQueue::boxInFrustum(const nex::Frustum& frustum, const nex::AABB& boxOriginal) const
+void nex::RenderCommandQueue::useCameraCulling(Camera* camera)
 {
-	auto box = boxOriginal;//mCamera->getView() * boxOriginal;
+	mCullingMethod = CullingMethod::FRUSTUM;
+	mCamera = camera;
+}
 
-	const byte ALL_CORNERS = 8;
-	byte out = 0;
+void nex::RenderCommandQueue::useInstancing(bool enable)
+{
+	mUseInstancing = enable;
+}
 
-	// check box outside/inside of frustum
-	for (int i = 0; i < 6; i++)
-	{
+void nex::RenderCommandQueue::useSphereCulling(const glm::vec3 & position, float radius)
+{
+	mCamera = nullptr;
+	mCullingMethod = CullingMethod::FRUSTUM_SPHERE;
+	mSphereCuller = Sphere(position, radius);
+}
 
-		const auto& plane = frustum.planes[i];
-		glm::vec4 planeAsVec(plane.mNormal, plane.mSignedDistance);
+void nex::RenderCommandQueue::sort()
+{
+	cull();
 
-		// check all corners against the plane;
-		out = 0;
-		out += ((dot(planeAsVec, glm::vec4(box.min.x, box.min.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
-		out += ((dot(planeAsVec, glm::vec4(box.max.x, box.min.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
-		out += ((dot(planeAsVec, glm::vec4(box.min.x, box.max.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
-		out += ((dot(planeAsVec, glm::vec4(box.min.x, box.min.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
-		out += ((dot(planeAsVec, glm::vec4(box.max.x, box.max.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
-		out += ((dot(planeAsVec, glm::vec4(box.max.x, box.min.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
-		out += ((dot(planeAsVec, glm::vec4(box.min.x, box.max.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
-		out += ((dot(planeAsVec, glm::vec4(box.max.x, box.max.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
-		if (out == ALL_CORNERS) return false;
+	if (mUseInstancing) {
+		NEX_PROFILE_SCOPE("RenderCommandQueue::createInstances");
+		createInstances(mDeferredPbrCommands);
+		createInstances(mShadowCommands);
 	}
 
-	// check frustum outside/inside box
-	out = 0; for (const auto& corner : frustum.corners) out += ((corner.x > box.max.x) ? 1 : 0); if (out == ALL_CORNERS) return false;
-	out = 0; for (const auto& corner : frustum.corners) out += ((corner.x < box.min.x) ? 1 : 0); if (out == ALL_CORNERS) return false;
-	out = 0; for (const auto& corner : frustum.corners) out += ((corner.y > box.max.y) ? 1 : 0); if (out == ALL_CORNERS) return false;
-	out = 0; for (const auto& corner : frustum.corners) out += ((corner.y < box.min.y) ? 1 : 0); if (out == ALL_CORNERS) return false;
-	out = 0; for (const auto& corner : frustum.corners) out += ((corner.z > box.max.z) ? 1 : 0); if (out == ALL_CORNERS) return false;
-	out = 0; for (const auto& corner : frustum.corners) out += ((corner.z < box.min.z) ? 1 : 0); if (out == ALL_CORNERS) return false;
+	NEX_PROFILE_SCOPE("RenderCommandQueue::sort");
 
-	return true;
-}
- 
-bool nex::RenderCommandQueue::isInRange(bool doCulling, const RenderCommand& command) const
-{
-	if (!doCulling) return true;
-	if (mCullingMethod == CullingMethod::FRUSTUM) {
-		if (!mCamera) return false;
-		// TODO use world space frustum!
-		return boxInFrustum(mCamera->getFrustumWorld(), *command.boundingBox);
-	}
-	else {
-		return mSphereCuller.intersects(*command.boundingBox);
-	}
+	sortBuffer(mDeferredPbrCommands);
+	sortBuffer(mShadowCommands);
+	sortBuffer(mTransparentCommands);
 }
 
-bool nex::RenderCommandQueue::defaultCompare(const RenderCommand& a, const RenderCommand& b)
+// Maps a float to an unsigned integer with the same order.
+static uint32_t toOrderedBits(float value)
 {
-	auto* aShader = a.batch->getShader();
-	auto* bShader = b.batch->getShader();
-
-	// At first we sort by shader 
-	// We assume that there exists only one instance of each technique. Thus we compare raw pointers.
-	if (aShader != bShader) return aShader < bShader;
-
-	// now we sort by mesh batch
-	return a.batch < b.batch;
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(float));
+	return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
 }
 
-
-glm::vec3 getTransparentComparePosition(const nex::RenderCommand& c) {
+static glm::vec3 getComparePosition(const nex::RenderCommand& c) {
 	if (c.boundingBox) return (c.boundingBox->max + c.boundingBox->min) * 0.5f;
-	return (*c.worldTrafo)[3];
+	if (c.worldTrafo) return (*c.worldTrafo)[3];
+	return glm::vec3(0.0f);
 }
 
-
-float getTransparentCompareDistance(const nex::RenderCommand& c, const glm::vec3& cullPosition) {
+static float getTransparentCompareDistance(const nex::RenderCommand& c, const glm::vec3& cullPosition) {
 	if (c.boundingBox) {
 
 		float minDistance = std::numeric_limits<float>::max();
@@ -347,30 +401,217 @@ float getTransparentCompareDistance(const nex::RenderCommand& c, const glm::vec3
 		return minDistance;
 	}
 
+	if (!c.worldTrafo) return 0.0f;
 
 	glm::vec3 position = (*c.worldTrafo)[3];
 	return glm::length(position - cullPosition);
 }
 
-bool nex::RenderCommandQueue::transparentCompare(const RenderCommand& a, const RenderCommand& b)
+template<class T>
+uint32_t nex::RenderCommandQueue::getSortID(const T* object, uint32_t maxID)
+{
+	// Sort ids are reused and dense, so they only exceed the bit range if more objects are alive than the range can hold.
+	// Masked ids only reduce the quality of the sort order.
+	return object ? object->getSortID() & maxID : 0;
+}
+
+uint64_t nex::RenderCommandQueue::calcOpaqueSortKey(const RenderCommand& command, bool separateBoneAnimated)
+{
+	// bits (msb to lsb): layer (2) | shader (14) | material (14) | mesh batch (18) | depth (16)
+	constexpr uint32_t SHADER_BITS = 14;
+	constexpr uint32_t MATERIAL_BITS = 14;
+	constexpr uint32_t BATCH_BITS = 18;
+	constexpr uint32_t DEPTH_BITS = 16;
+
+	uint64_t layer = separateBoneAnimated && command.isBoneAnimated ? 1 : 0;
+	uint64_t shader = 0;
+	uint64_t material = 0;
+	uint64_t batch = 0;
+
+	if (command.batch) {
+		shader = getSortID(command.batch->getShader(), (1u << SHADER_BITS) - 1);
+		material = getSortID(command.batch->getReferenceMaterial(), (1u << MATERIAL_BITS) - 1);
+		batch = getSortID(command.batch, (1u << BATCH_BITS) - 1);
+	}
+
+	// front to back; distances are positive, so the upper bits of the float are a monotonic (logarithmic) quantization
+	const auto distance = glm::length(getComparePosition(command) - getCullPosition());
+	const uint64_t depth = toOrderedBits(distance) >> (32 - DEPTH_BITS);
+
+	return (layer << (SHADER_BITS + MATERIAL_BITS + BATCH_BITS + DEPTH_BITS))
+		| (shader << (MATERIAL_BITS + BATCH_BITS + DEPTH_BITS))
+		| (material << (BATCH_BITS + DEPTH_BITS))
+		| (batch << DEPTH_BITS)
+		| depth;
+}
+
+uint64_t nex::RenderCommandQueue::calcTransparentSortKey(const RenderCommand& command)
+{
+	// bits (msb to lsb): inverted distance (32) | shader (16) | mesh batch (16)
+	// We want to render objects further to the camera at first.
+	constexpr uint32_t SHADER_BITS = 16;
+	constexpr uint32_t BATCH_BITS = 16;
+
+	uint64_t shader = 0;
+	uint64_t batch = 0;
+
+	if (command.batch) {
+		shader = getSortID(command.batch->getShader(), (1u << SHADER_BITS) - 1);
+		batch = getSortID(command.batch, (1u << BATCH_BITS) - 1);
+	}
+
+	const uint64_t distance = ~toOrderedBits(getTransparentCompareDistance(command, getCullPosition()));
+
+	return (distance << (SHADER_BITS + BATCH_BITS)) | (shader << BATCH_BITS) | batch;
+}
+
+void nex::RenderCommandQueue::sortBuffer(Buffer& buffer)
+{
+	const auto count = buffer.size();
+	if (count < 2) return;
+
+	mSortEntries.resize(count);
+	mSortScratch.resize(count);
+
+	for (size_t i = 0; i < count; ++i) {
+		mSortEntries[i] = { buffer[i].sortKey, static_cast<uint32_t>(i) };
+	}
+
+	// LSD radix sort with 8 bit digits; the histograms of all digits are computed in one pass.
+	// Passes whose digit is the same for all keys (e.g. unused id bits) are skipped.
+	constexpr size_t DIGIT_COUNT = sizeof(uint64_t);
+	uint32_t histograms[DIGIT_COUNT][256] = {};
+
+	for (const auto& entry : mSortEntries) {
+		for (size_t d = 0; d < DIGIT_COUNT; ++d) {
+			++histograms[d][(entry.key >> (d * 8)) & 0xFF];
+		}
+	}
+
+	for (size_t d = 0; d < DIGIT_COUNT; ++d) {
+		auto& histogram = histograms[d];
+		const auto shift = d * 8;
+		if (histogram[(mSortEntries[0].key >> shift) & 0xFF] == count) continue;
+
+		uint32_t offset = 0;
+		for (auto& bucket : histogram) {
+			const auto bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+
+		for (const auto& entry : mSortEntries) {
+			mSortScratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+		}
+
+		mSortEntries.swap(mSortScratch);
+	}
+
+	mCommandScratch.clear();
+	mCommandScratch.reserve(count);
+	for (const auto& entry : mSortEntries) {
+		mCommandScratch.emplace_back(buffer[entry.index]);
+	}
+
+	buffer.swap(mCommandScratch);
+}
+
+size_t nex::RenderCommandQueue::InstanceKeyHash::operator()(const InstanceKey& key) const
 {
-	// we want to render objects further to the camera at first. 
+	return std::hash<const void*>()(key.batch) ^ (std::hash<unsigned>()(key.perObjectMaterialID) * 31)
+		^ (std::hash<bool>()(key.isBoneAnimated) * 131);
+}
+
+bool nex::RenderCommandQueue::isInstanceable(const RenderCommand& command)
+{
+	// Commands with custom render functions or custom data might not support instancing;
+	// bone animated commands are only instanceable if their bone transformations are in the bone palette.
+	return command.batch
+		&& command.renderFunc == Drawer::drawCommand
+		&& !command.data
+		&& !command.bones
+		&& command.instanceCount == 0
+		&& command.worldTrafo
+		&& command.prevWorldTrafo
+		&& command.boundingBox;
+}
+
+void nex::RenderCommandQueue::createInstances(Buffer& buffer)
+{
+	constexpr auto NO_GROUP = std::numeric_limits<uint32_t>::max();
+
+	// assign the commands to groups
+	mInstanceLookup.clear();
+	mGroupSizes.clear();
+	mCommandGroups.resize(buffer.size());
+	size_t instanceableCount = 0;
+
+	for (size_t i = 0; i < buffer.size(); ++i) {
+		const auto& command = buffer[i];
+		if (!isInstanceable(command)) {
+			mCommandGroups[i] = NO_GROUP;
+			continue;
+		}
 
-	/*const glm::vec3& positionA = getTransparentComparePosition(a);
-	const glm::vec3& positionB = getTransparentComparePosition(b);
+		const auto result = mInstanceLookup.emplace(InstanceKey{ command.batch, command.perObjectMaterialID, command.isBoneAnimated }, 
+			static_cast<uint32_t>(mGroupSizes.size()));
+		if (result.second) mGroupSizes.push_back(0);
 
+		const auto group = result.first->second;
+		++mGroupSizes[group];
+		mCommandGroups[i] = group;
+		++instanceableCount;
+	}
+
+	// nothing to merge?
+	if (mGroupSizes.size() == instanceableCount) return;
 
-	const auto& cullPosition = getCullPosition();
+	// Each group having more than one command is replaced by an instanced command at the position of its first command.
+	mGroupStorages.assign(mGroupSizes.size(), nullptr);
+	mCommandScratch.clear();
 
-	auto aDist = length(positionA - cullPosition);
-	auto bDist = length(positionB - cullPosition);
+	for (size_t i = 0; i < buffer.size(); ++i) {
+		const auto& command = buffer[i];
+		const auto group = mCommandGroups[i];
+
+		if (group == NO_GROUP || mGroupSizes[group] == 1) {
+			mCommandScratch.emplace_back(command);
+			continue;
+		}
 
-	return aDist > bDist;*/
+		auto* storage = mGroupStorages[group];
+
+		if (!storage) {
+			if (mUsedInstanceGroups == mInstanceGroups.size()) mInstanceGroups.emplace_back();
+			storage = &mInstanceGroups[mUsedInstanceGroups++];
+			mGroupStorages[group] = storage;
+
+			// Note: The matrices mustn't be reallocated after the command references them.
+			const auto size = mGroupSizes[group];
+			storage->worldTrafos.clear();
+			storage->worldTrafos.reserve(size);
+			storage->prevWorldTrafos.clear();
+			storage->prevWorldTrafos.reserve(size);
+			storage->boneOffsets.clear();
+			if (command.isBoneAnimated) storage->boneOffsets.reserve(size);
+			storage->box = *command.boundingBox;
+
+			mCommandScratch.emplace_back(command);
+			auto& instanced = mCommandScratch.back();
+			instanced.instanceCount = size;
+			instanced.instanceWorldTrafos = storage->worldTrafos.data();
+			instanced.instancePrevWorldTrafos = storage->prevWorldTrafos.data();
+			instanced.instanceBoneOffsets = command.isBoneAnimated ? storage->boneOffsets.data() : nullptr;
+			instanced.boundingBox = &storage->box;
+		}
+
+		storage->worldTrafos.push_back(*command.worldTrafo);
+		storage->prevWorldTrafos.push_back(*command.prevWorldTrafo);
+		if (command.isBoneAnimated) storage->boneOffsets.push_back(command.boneOffset);
+		storage->box = maxAABB(storage->box, *command.boundingBox);
+	}
 
-	const auto& cullPosition = getCullPosition();
-	const auto aDist = getTransparentCompareDistance(a, cullPosition);
-	const auto bDist = getTransparentCompareDistance(b, cullPosition);
-	return aDist > bDist;
+	buffer.swap(mCommandScratch);
 }
 
 const glm::vec3 & nex::RenderCommandQueue::getCullPosition() const
@@ -2,12 +2,17 @@
 #include <nex/renderer/RenderCommand.hpp>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
+#include <deque>
 #include <nex/math/Sphere.hpp>
+#include <nex/util/FrameArena.hpp>
+#include <nex/renderer/BatchCuller.hpp>
 
 
 namespace nex
 {
 
+	class BonePalette;
 	class Camera;
 	struct Frustum;
 	class Shader;
@@ -16,10 +21,15 @@ namespace nex
 	{
 	public:
 
-		using BufferCollection = std::vector<std::vector<RenderCommand>*>;
-		using ConstBufferCollection = std::vector<const std::vector<RenderCommand>*>;
+		using BufferCollection = nex::FrameVector<std::vector<RenderCommand>*>;
+		using ConstBufferCollection = nex::FrameVector<const std::vector<RenderCommand>*>;
 		using Buffer = std::vector<RenderCommand>;
 
+		/**
+		 * Tool commands together with their draw index; sorted by draw index (stable, i.e. in push order for equal indices).
+		 */
+		using ToolBuffer = std::vector<std::pair<unsigned, RenderCommand>>;
+
 		enum class CullingMethod {
 			FRUSTUM,
 			FRUSTUM_SPHERE
@@ -37,16 +47,42 @@ namespace nex
 
 		RenderCommandQueue(Camera* camera = nullptr);
 
+		/**
+		 * Removes all commands. Note: The buffers keep their memory, so that refilling the queue doesn't allocate in the steady state.
+		 */
 		void clear();
 
+		/**
+		 * Culls all commands that have been pushed with culling enabled (in one batch, see BatchCuller) and adds
+		 * the visible ones to the command buffers.
+		 * Note: Is called by sort().
+		 */
+		void cull();
+
 
 		/**
 		 * Computes the bounding box of objects specified by a render command buffer
 		 */
 		static AABB calcBoundingBox(const Buffer& buffer);
 
+		/**
+		 * Provides the command buffers of the specified buffer types.
+		 * Note: The collection is allocated from the frame arena; it mustn't be kept longer than the next frame.
+		 */
 		ConstBufferCollection getCommands(int types) const;
 
+		/**
+		 * Provides the camera used for frustum culling. Is null, if no camera is used.
+		 */
+		const Camera* getCullingCamera() const;
+
+		CullingMethod getCullingMethod() const;
+
+		/**
+		 * Provides the sphere used for sphere culling.
+		 */
+		const Sphere& getCullingSphere() const;
+
 		/**
 		 * Provides render commands that are not deferrable
 		 * and should be rendered before transparent commands
@@ -63,6 +99,11 @@ namespace nex
 		Buffer& getBeforeTransparentCommands();
 		const Buffer& getBeforeTransparentCommands() const;
 
+		/**
+		 * Provides the commands that have been pushed with culling enabled and that haven't been culled yet (see cull()).
+		 */
+		Buffer& getCullCandidates();
+
 		/**
 		 * Provides pbr render commands that can be rendered in a deferred way.
 		 */
@@ -81,27 +122,116 @@ namespace nex
 		Buffer& getShadowCommands();
 		const Buffer& getShadowCommands() const;
 
-		std::multimap<unsigned, nex::RenderCommand>& getToolCommands();
-		const std::multimap<unsigned, nex::RenderCommand>& getToolCommands() const;
+		ToolBuffer& getToolCommands();
+		const ToolBuffer& getToolCommands() const;
 
 		Buffer& getTransparentCommands();
 		const Buffer& getTransparentCommands() const;
 
+		/**
+		 * Adds a command to the queue.
+		 * @param cull : If true, the command is culled against the culling volume of this queue. Such commands are
+		 *               added to the command buffers by cull().
+		 */
 		void push(const RenderCommand& command, bool cull = false);
 
+		/**
+		 * Specifies a bone palette for the bone animated commands of this queue. Commands with bone transformations
+		 * (RenderCommand::bones) add their pose to the palette when they are added to the command buffers, i.e. only if
+		 * they aren't culled. They then reference the pose by their bone offset and can be instanced.
+		 * If the palette is full or no palette is set (default), the commands upload their bone transformations themselves.
+		 * Note: The render context has to provide the same palette.
+		 */
+		void useBonePalette(BonePalette* palette);
+
 		void useCameraCulling(Camera* camera);
 		void useSphereCulling(const glm::vec3& position, float radius);
 
+		/**
+		 * Specifies whether deferrable pbr and shadow commands using the same mesh batch (and per object material id) 
+		 * are merged into instanced commands when the queue is sorted.
+		 * Note: The shaders used for rendering these commands have to support instancing (see InstanceData in interface/buffers.h) 
+		 * and the render context needs an instance data buffer. 
+		 * Default: false
+		 */
+		void useInstancing(bool enable);
+
+		/**
+		 * Sorts the deferrable pbr, shadow and transparent commands by their sort keys:
+		 * Opaque commands are sorted by layer, shader, material, mesh batch and (front to back) depth;
+		 * transparent commands are sorted back to front.
+		 * Note: The sort keys are computed when a command is pushed, so the culling volume (camera or sphere) has to be set before.
+		 */
 		void sort();
 
 
 	private:
 
-		bool isInRange(bool doCulling, const RenderCommand& command) const;
-		bool boxInFrustum(const nex::Frustum& frustum, const nex::AABB& box) const;
+		/**
+		 * Adds a command to the matching command buffers.
+		 */
+		void add(const RenderCommand& command);
+
+		/**
+		 * Adds a visible command to the matching command buffers. Moves the pose of a bone animated command to the
+		 * bone palette, if possible.
+		 */
+		void addVisible(const RenderCommand& command);
+
+		struct SortEntry {
+			uint64_t key;
+			uint32_t index;
+		};
+
+		/**
+		 * @param separateBoneAnimated : Puts bone animated commands into their own layer. Only useful for buffers rendered
+		 * with shader overrides (shadow pass), where bone animated commands use another shader than static ones. Without
+		 * overrides the shader is the batch shader, so a layer would only split commands sharing a shader.
+		 */
+		uint64_t calcOpaqueSortKey(const RenderCommand& command, bool separateBoneAnimated);
+		uint64_t calcTransparentSortKey(const RenderCommand& command);
+
+		/**
+		 * Provides the sort id of an object (see SortID) restricted to a bit range or 0 for null objects.
+		 */
+		template<class T>
+		static uint32_t getSortID(const T* object, uint32_t maxID);
 
-		static bool defaultCompare(const RenderCommand& a, const RenderCommand& b);
-		bool transparentCompare(const RenderCommand& a, const RenderCommand& b);
+		/**
+		 * Sorts a buffer by the sort keys of the commands (LSD radix sort).
+		 */
+		void sortBuffer(Buffer& buffer);
+
+		/**
+		 * Storage of the instance data of an instanced command.
+		 */
+		struct InstanceGroup {
+			std::vector<glm::mat4> worldTrafos;
+			std::vector<glm::mat4> prevWorldTrafos;
+			std::vector<unsigned> boneOffsets;
+			AABB box;
+		};
+
+		struct InstanceKey {
+			const MeshBatch* batch;
+			unsigned perObjectMaterialID;
+			bool isBoneAnimated;
+
+			bool operator==(const InstanceKey& o) const { 
+				return batch == o.batch && perObjectMaterialID == o.perObjectMaterialID && isBoneAnimated == o.isBoneAnimated; 
+			}
+		};
+
+		struct InstanceKeyHash {
+			size_t operator()(const InstanceKey& key) const;
+		};
+
+		static bool isInstanceable(const RenderCommand& command);
+
+		/**
+		 * Replaces commands of a buffer using the same mesh batch by an instanced command.
+		 */
+		void createInstances(Buffer& buffer);
 
 		const glm::vec3& getCullPosition() const;
 
@@ -110,9 +240,30 @@ namespace nex
 		Buffer mDeferredPbrCommands;
 		Buffer mForwardCommands;
 		Buffer mShadowCommands;
-		std::multimap<unsigned, RenderCommand> mToolCommands;
+		ToolBuffer mToolCommands;
 		Buffer mTransparentCommands;
 		Buffer mProbeCommands;
+
+		// commands to be culled and the data of the culling pass
+		Buffer mCullCandidates;
+		AABBBatch mCullBoxes;
+		std::vector<uint32_t> mVisibility;
+
+		// sorting data; reused, so that sorting doesn't allocate in the steady state
+		std::vector<SortEntry> mSortEntries;
+		std::vector<SortEntry> mSortScratch;
+		Buffer mCommandScratch;
+
+		// instancing data; Note: a deque keeps the groups at their memory location, so that commands can reference them.
+		bool mUseInstancing = false;
+		std::deque<InstanceGroup> mInstanceGroups;
+		size_t mUsedInstanceGroups = 0;
+		std::unordered_map<InstanceKey, uint32_t, InstanceKeyHash> mInstanceLookup;
+		std::vector<uint32_t> mCommandGroups;
+		std::vector<uint32_t> mGroupSizes;
+		std::vector<InstanceGroup*> mGroupStorages;
+
+		BonePalette* mBonePalette = nullptr;
 		Camera* mCamera;
 		CullingMethod mCullingMethod;
 		nex::Sphere mSphereCuller;
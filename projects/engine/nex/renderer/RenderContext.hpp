@@ -1,6 +1,8 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <memory>
+#include <vector>
 #include <interface/buffers.h>
 
 namespace nex
@@ -14,6 +16,8 @@ namespace nex
 	class GlobalIllumination;
 	class StencilTest;
 	class ShaderBuffer;
+	class StreamingBuffer;
+	class BonePalette;
 
 
 	struct RenderContext
@@ -29,10 +33,23 @@ namespace nex
 		mutable std::shared_ptr<ShaderBuffer> perObjectDataBuffer = nullptr;
 		mutable PerObjectData perObjectData;
 
+		// For instanced render commands
+		mutable std::shared_ptr<ShaderBuffer> instanceDataBuffer = nullptr;
+		mutable std::vector<InstanceData> instanceData;
+
 		std::shared_ptr<ShaderBuffer> materialBuffer = nullptr;
 
 		std::shared_ptr<ShaderBuffer> boneTransformBuffer = nullptr;
 
+		// Ring buffer for per frame data (transforms, instance data, bones, particles).
+		// If not set, the data is uploaded to the dedicated buffers above.
+		std::shared_ptr<StreamingBuffer> streamingBuffer = nullptr;
+
+		// Collects the bone transformations of the visible bone animated vobs of the frame. Requires the streaming buffer.
+		// Filled by render command queues using the palette (see RenderCommandQueue::useBonePalette); commands of other
+		// queues upload their bone transformations to the bone transform buffer.
+		std::shared_ptr<BonePalette> bonePalette = nullptr;
+
 		CascadedShadow* csm = nullptr;
 		GlobalIllumination* gi = nullptr;
 		RenderTarget* irradianceAmbientReflection = nullptr;
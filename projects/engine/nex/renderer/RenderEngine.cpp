@@ -8,6 +8,19 @@ nex::RenderEngine::~RenderEngine() = default;
 
 nex::RenderEngine::CommandQueue* nex::RenderEngine::getCommandQueue()
 	{
-		static CommandQueue commandQueue;
+		static CommandQueue commandQueue(COMMAND_QUEUE_CAPACITY);
 		return &commandQueue;
-	}
\ No newline at end of file
+	}
+
+nex::FinalizeScheduler* nex::RenderEngine::getFinalizeScheduler()
+{
+	static FinalizeScheduler scheduler;
+	return &scheduler;
+}
+
+nex::Executor nex::RenderEngine::getMainThreadExecutor()
+{
+	return [](Continuation continuation) {
+		getCommandQueue()->push(std::move(continuation));
+	};
+}
\ No newline at end of file
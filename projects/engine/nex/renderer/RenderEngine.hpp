@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
 #include <nex/common/ConcurrentQueue.hpp>
+#include <nex/common/Future.hpp>
+#include <nex/renderer/FinalizeScheduler.hpp>
 
 namespace nex
 {
@@ -10,6 +12,12 @@ namespace nex
 
 		using CommandQueue = nex::ConcurrentQueue<std::function<void()>>;
 
+		/**
+		 * Capacity of the lock-free part of the command queue. If the render thread doesn't keep up, 
+		 * further commands go to the (locked) overflow list of the queue; pushing never blocks.
+		 */
+		static constexpr size_t COMMAND_QUEUE_CAPACITY = 8192;
+
 		RenderEngine();
 
 		RenderEngine(const RenderEngine&) = delete;
@@ -22,6 +30,17 @@ namespace nex
 
 		static CommandQueue* getCommandQueue();
 
+		/**
+		 * Provides an executor that pushes continuations to the command queue. 
+		 * Thus the continuations are executed on the main (render) thread.
+		 */
+		static Executor getMainThreadExecutor();
+
+		/**
+		 * Provides the scheduler for time sliced finalization of loaded resources on the main thread.
+		 */
+		static FinalizeScheduler* getFinalizeScheduler();
+
 	protected:
 	};
 }
\ No newline at end of file
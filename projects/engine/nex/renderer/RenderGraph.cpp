@@ -0,0 +1,404 @@
+#include <nex/renderer/RenderGraph.hpp>
+#include <nex/renderer/TransientTargetPool.hpp>
+#include <nex/texture/RenderTarget.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <nex/util/Profiler.hpp>
+#include <algorithm>
+#include <iomanip>
+
+bool nex::RenderGraph::TargetDesc::operator==(const TargetDesc& o) const
+{
+	return width == o.width
+		&& height == o.height
+		&& format == o.format
+		&& samples == o.samples
+		&& layers == o.layers;
+}
+
+bool nex::RenderGraph::TargetDesc::operator!=(const TargetDesc& o) const
+{
+	return !(*this == o);
+}
+
+size_t nex::RenderGraph::TargetDesc::getByteSize() const
+{
+	return size_t(width) * height * layers * samples * getPixelByteSize(format);
+}
+
+nex::RenderGraph::PassBuilder::PassBuilder(RenderGraph* graph, PassID pass) : mGraph(graph), mPass(pass)
+{
+}
+
+nex::RenderGraph::PassBuilder& nex::RenderGraph::PassBuilder::read(ResourceID resource)
+{
+	mGraph->getResource(resource);
+	mGraph->mPasses[mPass].reads.push_back(resource);
+	return *this;
+}
+
+nex::RenderGraph::PassBuilder& nex::RenderGraph::PassBuilder::write(ResourceID resource)
+{
+	mGraph->getResource(resource);
+	mGraph->mPasses[mPass].writes.push_back(resource);
+	return *this;
+}
+
+nex::RenderGraph::PassBuilder& nex::RenderGraph::PassBuilder::sideEffect()
+{
+	mGraph->mPasses[mPass].sideEffect = true;
+	return *this;
+}
+
+nex::RenderGraph::PassID nex::RenderGraph::PassBuilder::getID() const
+{
+	return mPass;
+}
+
+nex::RenderGraph::ResourceID nex::RenderGraph::createTarget(std::string name, const TargetDesc& desc)
+{
+	Resource resource;
+	resource.name = std::move(name);
+	resource.desc = desc;
+	mResources.emplace_back(std::move(resource));
+	mCompiled = false;
+	return static_cast<ResourceID>(mResources.size() - 1);
+}
+
+nex::RenderGraph::ResourceID nex::RenderGraph::importTarget(std::string name, RenderTarget* target)
+{
+	Resource resource;
+	resource.name = std::move(name);
+	resource.imported = target;
+	resource.isImported = true;
+	mResources.emplace_back(std::move(resource));
+	mCompiled = false;
+	return static_cast<ResourceID>(mResources.size() - 1);
+}
+
+nex::RenderGraph::PassBuilder nex::RenderGraph::addPass(std::string name, ExecuteFunc execute)
+{
+	Pass pass;
+	pass.name = std::move(name);
+	pass.execute = std::move(execute);
+	mPasses.emplace_back(std::move(pass));
+	mCompiled = false;
+	return PassBuilder(this, static_cast<PassID>(mPasses.size() - 1));
+}
+
+void nex::RenderGraph::markOutput(ResourceID resource)
+{
+	getResource(resource).isOutput = true;
+	mCompiled = false;
+}
+
+void nex::RenderGraph::clear()
+{
+	mResources.clear();
+	mPasses.clear();
+	mPhysicalTargets.clear();
+	mPhysicalInstances.clear();
+	mStats = Stats();
+	mCompiled = false;
+}
+
+void nex::RenderGraph::compile()
+{
+	NEX_PROFILE_SCOPE("RenderGraph::compile");
+
+	// A transient target has to be written before it can be read.
+	std::vector<bool> written(mResources.size(), false);
+
+	for (const auto& pass : mPasses) {
+		for (auto id : pass.reads) {
+			const auto& resource = mResources[id];
+			if (!resource.isImported && !written[id]) {
+				throw_with_trace(std::runtime_error("nex::RenderGraph::compile : pass '" + pass.name
+					+ "' reads '" + resource.name + "' before it is written!"));
+			}
+		}
+
+		for (auto id : pass.writes) {
+			written[id] = true;
+		}
+	}
+
+	mStats = Stats();
+	mStats.passes = mPasses.size();
+
+	cullPasses();
+	computeLifetimes();
+	aliasTargets();
+	computeBarriers();
+
+	mCompiled = true;
+}
+
+void nex::RenderGraph::execute(TransientTargetPool& pool)
+{
+	NEX_PROFILE_SCOPE("RenderGraph::execute");
+
+	if (!mCompiled) {
+		throw_with_trace(std::runtime_error("nex::RenderGraph::execute : graph isn't compiled!"));
+	}
+
+	pool.beginFrame();
+
+	mPhysicalInstances.resize(mPhysicalTargets.size());
+	for (size_t i = 0; i < mPhysicalTargets.size(); ++i) {
+		mPhysicalInstances[i] = pool.acquire(mPhysicalTargets[i]);
+	}
+
+	// Note: The OpenGL backend orders render target writes and subsequent texture fetches implicitly,
+	// so the computed barriers need no explicit synchronization here.
+	for (const auto& pass : mPasses) {
+		if (pass.culled || !pass.execute) continue;
+		pass.execute(*this);
+	}
+
+	std::fill(mPhysicalInstances.begin(), mPhysicalInstances.end(), nullptr);
+
+	pool.endFrame();
+}
+
+nex::RenderTarget* nex::RenderGraph::getTarget(ResourceID id) const
+{
+	const auto& resource = getResource(id);
+	if (resource.isImported) return resource.imported;
+	if (resource.physical >= mPhysicalInstances.size()) return nullptr;
+	return mPhysicalInstances[resource.physical];
+}
+
+bool nex::RenderGraph::isCulled(PassID pass) const
+{
+	return mPasses[pass].culled;
+}
+
+unsigned nex::RenderGraph::getPhysicalIndex(ResourceID resource) const
+{
+	return getResource(resource).physical;
+}
+
+const std::vector<nex::RenderGraph::TargetDesc>& nex::RenderGraph::getPhysicalTargets() const
+{
+	return mPhysicalTargets;
+}
+
+nex::RenderGraph::PassID nex::RenderGraph::getFirstUse(ResourceID resource) const
+{
+	return getResource(resource).firstUse;
+}
+
+nex::RenderGraph::PassID nex::RenderGraph::getLastUse(ResourceID resource) const
+{
+	return getResource(resource).lastUse;
+}
+
+const std::vector<nex::RenderGraph::Barrier>& nex::RenderGraph::getBarriers(PassID pass) const
+{
+	return mPasses[pass].barriers;
+}
+
+const nex::RenderGraph::Stats& nex::RenderGraph::getStats() const
+{
+	return mStats;
+}
+
+void nex::RenderGraph::writeReport(std::ostream& out) const
+{
+	const auto toMiB = [](size_t bytes) {
+		return bytes / (1024.0 * 1024.0);
+	};
+
+	const auto saved = mStats.declaredBytes == 0 ? 0.0 :
+		100.0 * (1.0 - double(mStats.aliasedBytes) / double(mStats.declaredBytes));
+
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+	out << std::fixed << std::setprecision(1);
+
+	out << "RenderGraph: " << mStats.passes << " passes (" << mStats.culledPasses << " culled), "
+		<< mStats.transientTargets << " of " << mStats.declaredTargets << " transient targets used, on "
+		<< mStats.physicalTargets << " physical targets\n";
+	out << "  transient memory: all declared: " << toMiB(mStats.declaredBytes) << " MiB, used without aliasing: "
+		<< toMiB(mStats.unaliasedBytes) << " MiB, aliased: " << toMiB(mStats.aliasedBytes) << " MiB ("
+		<< saved << "% saved)\n";
+
+	out << "passes:\n";
+	for (size_t i = 0; i < mPasses.size(); ++i) {
+		out << "  [" << std::setw(2) << i << "] " << mPasses[i].name;
+		if (mPasses[i].culled) out << " (culled)";
+		out << "\n";
+	}
+
+	out << "targets:\n";
+	for (const auto& resource : mResources) {
+		const auto& desc = resource.desc;
+		out << "  " << resource.name;
+
+		if (resource.isImported) {
+			out << " (imported)\n";
+			continue;
+		}
+
+		out << " " << desc.width << "x" << desc.height;
+		if (desc.layers > 1) out << "x" << desc.layers;
+		out << " " << getPixelByteSize(desc.format) << "B/px";
+		if (desc.samples > 1) out << " " << desc.samples << "x msaa";
+
+		if (resource.physical == INVALID_ID) {
+			out << " (unused)\n";
+			continue;
+		}
+
+		out << " passes " << resource.firstUse << "-" << resource.lastUse << " -> #" << resource.physical << "\n";
+	}
+
+	out.flags(flags);
+	out.precision(precision);
+}
+
+nex::RenderGraph::Resource& nex::RenderGraph::getResource(ResourceID resource)
+{
+	if (resource >= mResources.size()) {
+		throw_with_trace(std::out_of_range("nex::RenderGraph::getResource : invalid resource id!"));
+	}
+	return mResources[resource];
+}
+
+const nex::RenderGraph::Resource& nex::RenderGraph::getResource(ResourceID resource) const
+{
+	if (resource >= mResources.size()) {
+		throw_with_trace(std::out_of_range("nex::RenderGraph::getResource : invalid resource id!"));
+	}
+	return mResources[resource];
+}
+
+void nex::RenderGraph::cullPasses()
+{
+	// Passes read only targets written by earlier passes, so one backward sweep finds all needed passes.
+	std::vector<bool> needed(mResources.size(), false);
+
+	for (size_t i = 0; i < mResources.size(); ++i) {
+		needed[i] = mResources[i].isOutput;
+	}
+
+	for (auto it = mPasses.rbegin(); it != mPasses.rend(); ++it) {
+		auto& pass = *it;
+
+		bool keep = pass.sideEffect;
+		for (auto id : pass.writes) {
+			keep |= needed[id] || mResources[id].isImported;
+		}
+
+		pass.culled = !keep;
+		if (pass.culled) {
+			++mStats.culledPasses;
+			continue;
+		}
+
+		for (auto id : pass.reads) {
+			needed[id] = true;
+		}
+	}
+}
+
+void nex::RenderGraph::computeLifetimes()
+{
+	for (auto& resource : mResources) {
+		resource.firstUse = INVALID_ID;
+		resource.lastUse = INVALID_ID;
+		resource.physical = INVALID_ID;
+		resource.previous = INVALID_ID;
+	}
+
+	const auto use = [&](ResourceID id, PassID pass) {
+		auto& resource = mResources[id];
+		if (resource.firstUse == INVALID_ID) resource.firstUse = pass;
+		resource.lastUse = pass;
+	};
+
+	for (PassID i = 0; i < mPasses.size(); ++i) {
+		const auto& pass = mPasses[i];
+		if (pass.culled) continue;
+		for (auto id : pass.reads) use(id, i);
+		for (auto id : pass.writes) use(id, i);
+	}
+}
+
+void nex::RenderGraph::aliasTargets()
+{
+	mPhysicalTargets.clear();
+	mPhysicalInstances.clear();
+
+	std::vector<ResourceID> transients;
+	for (ResourceID i = 0; i < mResources.size(); ++i) {
+		const auto& resource = mResources[i];
+		if (resource.isImported) continue;
+
+		++mStats.declaredTargets;
+		mStats.declaredBytes += resource.desc.getByteSize();
+
+		if (resource.firstUse != INVALID_ID) transients.push_back(i);
+	}
+
+	std::stable_sort(transients.begin(), transients.end(), [&](ResourceID a, ResourceID b) {
+		return mResources[a].firstUse < mResources[b].firstUse;
+	});
+
+	// the target currently occupying each physical target
+	std::vector<ResourceID> occupants;
+
+	// Targets are visited by their first use; a physical target can be reused as soon as its current occupant isn't
+	// used anymore. For exactly matching descriptions this greedy assignment needs the minimal number of targets.
+	for (auto id : transients) {
+		auto& resource = mResources[id];
+
+		for (unsigned p = 0; p < mPhysicalTargets.size(); ++p) {
+			const auto& occupant = mResources[occupants[p]];
+			if (mPhysicalTargets[p] != resource.desc || occupant.lastUse >= resource.firstUse) continue;
+			resource.physical = p;
+			resource.previous = occupants[p];
+			occupants[p] = id;
+			break;
+		}
+
+		if (resource.physical == INVALID_ID) {
+			resource.physical = static_cast<unsigned>(mPhysicalTargets.size());
+			mPhysicalTargets.push_back(resource.desc);
+			occupants.push_back(id);
+			mStats.aliasedBytes += resource.desc.getByteSize();
+		}
+
+		++mStats.transientTargets;
+		mStats.unaliasedBytes += resource.desc.getByteSize();
+	}
+
+	mStats.physicalTargets = mPhysicalTargets.size();
+}
+
+void nex::RenderGraph::computeBarriers()
+{
+	std::vector<PassID> lastWriter(mResources.size(), INVALID_ID);
+
+	for (PassID i = 0; i < mPasses.size(); ++i) {
+		auto& pass = mPasses[i];
+		pass.barriers.clear();
+		if (pass.culled) continue;
+
+		for (auto id : pass.reads) {
+			const auto writer = lastWriter[id];
+			if (writer == INVALID_ID || writer == i) continue;
+			pass.barriers.push_back({ Barrier::Type::READ_AFTER_WRITE, id, writer });
+		}
+
+		for (auto id : pass.writes) {
+			const auto& resource = mResources[id];
+			if (resource.firstUse == i && resource.previous != INVALID_ID) {
+				const auto& previous = mResources[resource.previous];
+				pass.barriers.push_back({ Barrier::Type::ALIASING, resource.previous, previous.lastUse });
+			}
+
+			lastWriter[id] = i;
+		}
+	}
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <nex/texture/TextureSamplerData.hpp>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace nex
+{
+	class RenderTarget;
+	class TransientTargetPool;
+
+	/**
+	 * Describes the render passes of a frame by the render targets they read and write.
+	 *
+	 * Passes are added in execution order. compile() then
+	 *  - culls passes whose results are never used (a pass is kept if it has side effects, writes an imported target or
+	 *    an output, or writes a target read by a kept pass),
+	 *  - computes the lifetime (first and last kept pass) of each transient target,
+	 *  - aliases transient targets with equal descriptions and disjoint lifetimes onto the same physical target and
+	 *  - computes the barriers each pass has to wait for.
+	 *
+	 * Planning is pure cpu code; only execute() touches the render backend (via a TransientTargetPool).
+	 * A graph is meant to be declared once per frame (or once per resize) and cleared before it is declared again.
+	 */
+	class RenderGraph
+	{
+	public:
+
+		using ResourceID = unsigned;
+		using PassID = unsigned;
+
+		static constexpr unsigned INVALID_ID = std::numeric_limits<unsigned>::max();
+
+		/**
+		 * Description of a transient 2D render target. Targets with equal descriptions can share memory.
+		 */
+		struct TargetDesc {
+			unsigned width = 0;
+			unsigned height = 0;
+			InternalFormat format = InternalFormat::RGBA8;
+			unsigned samples = 1;
+			unsigned layers = 1;
+
+			bool operator==(const TargetDesc& o) const;
+			bool operator!=(const TargetDesc& o) const;
+
+			/**
+			 * Provides the (nominal) video memory size of a target with this description.
+			 */
+			size_t getByteSize() const;
+		};
+
+		/**
+		 * A dependency a pass has to wait for before it is executed.
+		 */
+		struct Barrier {
+			enum class Type {
+				READ_AFTER_WRITE, // the pass reads a target written by an earlier pass
+				ALIASING, // the pass is the first user of a physical target previously used by another target
+			};
+
+			Type type;
+			ResourceID resource;
+			// For READ_AFTER_WRITE the resource is the read target and 'after' its last writer.
+			// For ALIASING the resource is the previous user of the physical target and 'after' its last pass.
+			PassID after;
+		};
+
+		/**
+		 * Results of the last compile() call.
+		 */
+		struct Stats {
+			size_t passes = 0;
+			size_t culledPasses = 0;
+			size_t declaredTargets = 0; // all transient targets
+			size_t transientTargets = 0; // transient targets used by kept passes
+			size_t physicalTargets = 0;
+			size_t declaredBytes = 0; // memory if all transient targets were allocated up front
+			size_t unaliasedBytes = 0; // memory if each used transient target had its own allocation
+			size_t aliasedBytes = 0; // memory of the physical targets
+		};
+
+		using ExecuteFunc = std::function<void(const RenderGraph& graph)>;
+
+		/**
+		 * Declares the accesses of a pass.
+		 */
+		class PassBuilder
+		{
+		public:
+			PassBuilder& read(ResourceID resource);
+			PassBuilder& write(ResourceID resource);
+
+			/**
+			 * Marks the pass as having effects outside of the graph. Such passes are never culled.
+			 */
+			PassBuilder& sideEffect();
+
+			PassID getID() const;
+
+		private:
+			friend class RenderGraph;
+			PassBuilder(RenderGraph* graph, PassID pass);
+
+			RenderGraph* mGraph;
+			PassID mPass;
+		};
+
+		/**
+		 * Declares a transient render target. Its memory is managed by the graph.
+		 */
+		ResourceID createTarget(std::string name, const TargetDesc& desc);
+
+		/**
+		 * Declares an externally owned render target (e.g. a history buffer or the screen).
+		 * Imported targets are never aliased and passes writing them are never culled.
+		 */
+		ResourceID importTarget(std::string name, RenderTarget* target);
+
+		/**
+		 * Adds a pass. Passes are executed in the order they are added.
+		 */
+		PassBuilder addPass(std::string name, ExecuteFunc execute = nullptr);
+
+		/**
+		 * Marks a target as a result of the graph. Passes contributing to it are not culled.
+		 */
+		void markOutput(ResourceID resource);
+
+		/**
+		 * Removes all passes and targets.
+		 */
+		void clear();
+
+		/**
+		 * Culls passes, computes lifetimes, aliasing and barriers.
+		 * Throws a std::runtime_error if a pass reads a transient target before any pass has written it.
+		 */
+		void compile();
+
+		/**
+		 * Acquires the physical targets from a pool and executes the kept passes.
+		 * The graph has to be compiled.
+		 */
+		void execute(TransientTargetPool& pool);
+
+		/**
+		 * Provides the render target of a resource. Transient targets are only available during execute().
+		 */
+		RenderTarget* getTarget(ResourceID resource) const;
+
+		bool isCulled(PassID pass) const;
+
+		/**
+		 * Provides the index of the physical target a transient target is aliased onto
+		 * or INVALID_ID for imported and unused targets.
+		 */
+		unsigned getPhysicalIndex(ResourceID resource) const;
+
+		const std::vector<TargetDesc>& getPhysicalTargets() const;
+
+		/**
+		 * Provides the first and last kept pass using a target (INVALID_ID if the target is unused).
+		 */
+		PassID getFirstUse(ResourceID resource) const;
+		PassID getLastUse(ResourceID resource) const;
+
+		const std::vector<Barrier>& getBarriers(PassID pass) const;
+
+		const Stats& getStats() const;
+
+		/**
+		 * Writes a human readable summary of the compiled graph: passes, target lifetimes and aliasing, and the memory
+		 * needed with and without aliasing.
+		 */
+		void writeReport(std::ostream& out) const;
+
+	private:
+
+		struct Resource {
+			std::string name;
+			TargetDesc desc;
+			RenderTarget* imported = nullptr;
+			bool isImported = false;
+			bool isOutput = false;
+
+			PassID firstUse = INVALID_ID;
+			PassID lastUse = INVALID_ID;
+			unsigned physical = INVALID_ID;
+			// the target that used the physical target before this one
+			ResourceID previous = INVALID_ID;
+		};
+
+		struct Pass {
+			std::string name;
+			ExecuteFunc execute;
+			std::vector<ResourceID> reads;
+			std::vector<ResourceID> writes;
+			bool sideEffect = false;
+
+			bool culled = false;
+			std::vector<Barrier> barriers;
+		};
+
+		Resource& getResource(ResourceID resource);
+		const Resource& getResource(ResourceID resource) const;
+
+		void cullPasses();
+		void computeLifetimes();
+		void aliasTargets();
+		void computeBarriers();
+
+		std::vector<Resource> mResources;
+		std::vector<Pass> mPasses;
+		std::vector<TargetDesc> mPhysicalTargets;
+		std::vector<RenderTarget*> mPhysicalInstances;
+		Stats mStats;
+		bool mCompiled = false;
+	};
+}
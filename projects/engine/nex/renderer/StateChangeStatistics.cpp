@@ -0,0 +1,52 @@
+#include <nex/renderer/StateChangeStatistics.hpp>
+
+namespace
+{
+	constexpr auto CATEGORY_COUNT = static_cast<size_t>(nex::StateChangeStatistics::Category::COUNT);
+
+	nex::StateChangeStatistics::Counts currentFrame[CATEGORY_COUNT];
+	nex::StateChangeStatistics::Counts lastFrame[CATEGORY_COUNT];
+}
+
+void nex::StateChangeStatistics::add(Category category, bool issued)
+{
+	auto& counts = currentFrame[static_cast<size_t>(category)];
+	if (issued) ++counts.issued;
+	else ++counts.filtered;
+}
+
+const nex::StateChangeStatistics::Counts& nex::StateChangeStatistics::getLastFrameCounts(Category category)
+{
+	return lastFrame[static_cast<size_t>(category)];
+}
+
+nex::StateChangeStatistics::Counts nex::StateChangeStatistics::getLastFrameTotal()
+{
+	Counts total;
+	for (const auto& counts : lastFrame) {
+		total.issued += counts.issued;
+		total.filtered += counts.filtered;
+	}
+	return total;
+}
+
+const char* nex::StateChangeStatistics::getName(Category category)
+{
+	switch (category) {
+	case Category::PROGRAM: return "program";
+	case Category::VERTEX_ARRAY: return "vertex array";
+	case Category::TEXTURE: return "texture";
+	case Category::SAMPLER: return "sampler";
+	case Category::RENDER_STATE: return "render state";
+	case Category::UNIFORM: return "uniform";
+	default: return "unknown";
+	}
+}
+
+void nex::StateChangeStatistics::markFrame()
+{
+	for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+		lastFrame[i] = currentFrame[i];
+		currentFrame[i] = Counts();
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+namespace nex
+{
+	/**
+	 * Counts the state changes (bound objects, fixed function state, uniforms) requested from the render backend and
+	 * how many of them were filtered as redundant by the backend's state cache.
+	 *
+	 * Note: State changes are only requested by the render thread; the counters aren't synchronized.
+	 */
+	class StateChangeStatistics
+	{
+	public:
+
+		enum class Category
+		{
+			PROGRAM,
+			VERTEX_ARRAY,
+			TEXTURE,
+			SAMPLER,
+			RENDER_STATE,
+			UNIFORM,
+
+			COUNT, // not a category
+		};
+
+		struct Counts
+		{
+			uint64_t issued = 0;
+			uint64_t filtered = 0;
+		};
+
+		/**
+		 * Counts a requested state change.
+		 * @param issued : true if the change was passed to the graphics api; false if it was filtered.
+		 */
+		static void add(Category category, bool issued);
+
+		/**
+		 * Provides the counts of a category during the last frame.
+		 */
+		static const Counts& getLastFrameCounts(Category category);
+
+		/**
+		 * Provides the counts of all categories during the last frame.
+		 */
+		static Counts getLastFrameTotal();
+
+		static const char* getName(Category category);
+
+		/**
+		 * Finishes the current frame. Should be called once per frame by the render thread.
+		 */
+		static void markFrame();
+	};
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+
+namespace nex
+{
+	/**
+	 * Shadows a single state value. The value is unknown until it is updated the first time.
+	 * Independent of the render backend, so the filtering logic can be tested without a graphics context.
+	 */
+	template<typename T>
+	class ShadowValue
+	{
+	public:
+
+		explicit ShadowValue(const T& value = T(), bool known = false) : mValue(value), mKnown(known)
+		{
+		}
+
+		/**
+		 * Updates the shadowed value.
+		 * @return true, if the value has changed (or was unknown) and the state change has to be issued.
+		 */
+		bool update(const T& value)
+		{
+			if (mKnown && mValue == value) return false;
+			mValue = value;
+			mKnown = true;
+			return true;
+		}
+
+		/**
+		 * Marks the value as unknown (e.g. if the state was changed bypassing the cache).
+		 */
+		void invalidate()
+		{
+			mKnown = false;
+		}
+
+		const T& get() const
+		{
+			return mValue;
+		}
+
+	private:
+		T mValue;
+		bool mKnown;
+	};
+
+	/**
+	 * Shadows state values indexed by a location or unit in a flat array (grows on demand).
+	 * Independent of the render backend, so the filtering logic can be tested without a graphics context.
+	 */
+	template<typename T>
+	class ShadowArray
+	{
+	public:
+
+		/**
+		 * Updates the shadowed value at the given index.
+		 * @return true, if the value has changed (or was unknown) and the state change has to be issued.
+		 */
+		bool update(size_t index, const T& value)
+		{
+			if (index >= mEntries.size()) mEntries.resize(index + 1);
+			return mEntries[index].update(value);
+		}
+
+		/**
+		 * Marks all values as unknown.
+		 */
+		void invalidate()
+		{
+			for (auto& entry : mEntries) entry.invalidate();
+		}
+
+		/**
+		 * Marks all entries having the given value as unknown (e.g. the name of a deleted object).
+		 */
+		void invalidateValue(const T& value)
+		{
+			for (auto& entry : mEntries) {
+				if (entry.get() == value) entry.invalidate();
+			}
+		}
+
+	private:
+		std::vector<ShadowValue<T>> mEntries;
+	};
+}
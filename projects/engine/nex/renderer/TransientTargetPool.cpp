@@ -0,0 +1,69 @@
+#include <nex/renderer/TransientTargetPool.hpp>
+#include <nex/texture/RenderTarget.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <algorithm>
+
+nex::TransientTargetPool::TransientTargetPool(unsigned maxUnusedFrames) : mFrame(0), mMaxUnusedFrames(maxUnusedFrames)
+{
+}
+
+nex::TransientTargetPool::~TransientTargetPool() = default;
+
+void nex::TransientTargetPool::beginFrame()
+{
+	++mFrame;
+}
+
+nex::RenderTarget2D* nex::TransientTargetPool::acquire(const RenderGraph::TargetDesc& desc)
+{
+	for (auto& entry : mEntries) {
+		if (entry.lastUsedFrame == mFrame || entry.desc != desc) continue;
+		entry.lastUsedFrame = mFrame;
+		return entry.target.get();
+	}
+
+	// depth and stencil formats are the last internal formats
+	const bool isColor = (unsigned)desc.format < (unsigned)InternalFormat::DEPTH24_STENCIL8;
+
+	if (desc.layers != 1 || !isColor) {
+		throw_with_trace(std::runtime_error("nex::TransientTargetPool::acquire : Only single layered color targets are supported!"));
+	}
+
+	Entry entry;
+	entry.desc = desc;
+	entry.target = std::make_unique<RenderTarget2D>(desc.width, desc.height,
+		TextureDesc::createRenderTargetRGBAHDR(desc.format), desc.samples);
+	entry.lastUsedFrame = mFrame;
+	mEntries.emplace_back(std::move(entry));
+
+	return mEntries.back().target.get();
+}
+
+void nex::TransientTargetPool::endFrame()
+{
+	const auto frame = mFrame;
+	const auto maxUnusedFrames = mMaxUnusedFrames;
+
+	mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(), [&](const Entry& entry) {
+		return frame - entry.lastUsedFrame > maxUnusedFrames;
+	}), mEntries.end());
+}
+
+void nex::TransientTargetPool::clear()
+{
+	mEntries.clear();
+}
+
+size_t nex::TransientTargetPool::getTargetCount() const
+{
+	return mEntries.size();
+}
+
+size_t nex::TransientTargetPool::getByteSize() const
+{
+	size_t size = 0;
+	for (const auto& entry : mEntries) {
+		size += entry.desc.getByteSize();
+	}
+	return size;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <nex/renderer/RenderGraph.hpp>
+#include <memory>
+#include <vector>
+
+namespace nex
+{
+	class RenderTarget2D;
+
+	/**
+	 * Owns the render targets backing the physical targets of render graphs.
+	 * Targets are recycled by description across frames; targets that haven't been acquired for some frames
+	 * (e.g. after a resize) are released.
+	 * Only single layered color targets are supported.
+	 */
+	class TransientTargetPool
+	{
+	public:
+
+		/**
+		 * @param maxUnusedFrames : The number of frames a target is kept without being acquired.
+		 */
+		TransientTargetPool(unsigned maxUnusedFrames = 2);
+		~TransientTargetPool();
+
+		TransientTargetPool(const TransientTargetPool&) = delete;
+		TransientTargetPool& operator=(const TransientTargetPool&) = delete;
+
+		void beginFrame();
+
+		/**
+		 * Provides a render target matching a description that hasn't been acquired in the current frame yet.
+		 */
+		RenderTarget2D* acquire(const RenderGraph::TargetDesc& desc);
+
+		/**
+		 * Releases targets that haven't been acquired for more than maxUnusedFrames frames.
+		 */
+		void endFrame();
+
+		/**
+		 * Releases all targets.
+		 */
+		void clear();
+
+		size_t getTargetCount() const;
+
+		/**
+		 * Provides the (nominal) video memory size of all targets of the pool.
+		 */
+		size_t getByteSize() const;
+
+	private:
+
+		struct Entry {
+			RenderGraph::TargetDesc desc;
+			std::unique_ptr<RenderTarget2D> target;
+			unsigned long long lastUsedFrame;
+		};
+
+		std::vector<Entry> mEntries;
+		unsigned long long mFrame;
+		unsigned mMaxUnusedFrames;
+	};
+}
@@ -6,8 +6,40 @@
 #include <nex/util/ExceptionHandling.hpp>
 #include <regex>
 #include <nex/util/StringUtils.hpp>
+#include <nex/resource/PackageFile.hpp>
+#include <shared_mutex>
 using namespace nex;
 
+std::atomic<bool> nex::FileSystem::mCompression[static_cast<unsigned>(CompiledType::LAST) + 1] = {};
+
+namespace
+{
+	struct Mount
+	{
+		std::unique_ptr<nex::PackageFile> package;
+		std::filesystem::path root;
+		std::filesystem::path absoluteRoot;
+	};
+
+	std::vector<Mount> mounts;
+	std::shared_mutex mountMutex;
+
+	std::filesystem::path normalizeDirectory(const std::filesystem::path& path)
+	{
+		auto result = path.lexically_normal();
+		// remove a trailing separator, so that lexically_relative works as expected
+		if (!result.has_filename() && result.has_parent_path() && result != result.root_path())
+			result = result.parent_path();
+		return result;
+	}
+
+	bool isRelativeTo(const std::filesystem::path& path, const std::filesystem::path& root, std::filesystem::path& relative)
+	{
+		relative = path.lexically_relative(root);
+		return !relative.empty() && *relative.begin() != "..";
+	}
+}
+
 FileSystem::FileSystem(const std::vector<std::filesystem::path>& includeDirectories, 
 	const std::filesystem::path& compiledRootDirectory, 
 	const std::string& compiledFileExtension) :
@@ -60,6 +92,8 @@ std::filesystem::path FileSystem::resolvePath(const std::filesystem::path& path,
 	if (isAbsolute) {
 		auto compiledResource = getCompiledPath(path).path;
 
+		if (isPackaged(compiledResource)) return path;
+
 		if (!exists(path) && !exists(compiledResource))
 		{
 			if (noException) return {};
@@ -74,14 +108,16 @@ std::filesystem::path FileSystem::resolvePath(const std::filesystem::path& path,
 	auto current = root / path;	 
 	auto compiledResult = getCompiledPath(current);
 
-	if (exists(current) || (exists(compiledResult.path) && !compiledResult.fromIncludeDirectory)) return current;
+	// mounted packages are checked first, as they don't need to access the file system
+	if (!compiledResult.fromIncludeDirectory && isPackaged(compiledResult.path)) return current;
+	if (exists(current) || (!compiledResult.fromIncludeDirectory && exists(compiledResult.path))) return current;
 
 	// try to match the path wih a registered include directory
 	for (const auto& item : mIncludeDirectories)
 	{
 		std::filesystem::path p = item / path;
 		auto compiledResource = getCompiledPath(p).path;
-		if (exists(p) || exists(compiledResource)) return p;
+		if (isPackaged(compiledResource) || exists(p) || exists(compiledResource)) return p;
 	}
 
 	if (!noException)
@@ -107,6 +143,85 @@ std::filesystem::path FileSystem::getCurrentPath_Relative()
 	return makeRelative(std::filesystem::current_path());
 }
 
+void nex::FileSystem::setCompression(CompiledType type, bool enable)
+{
+	mCompression[static_cast<unsigned>(type)] = enable;
+}
+
+bool nex::FileSystem::isCompressionEnabled(CompiledType type)
+{
+	return mCompression[static_cast<unsigned>(type)];
+}
+
+void nex::FileSystem::mountPackage(const std::filesystem::path& packageFile, const std::filesystem::path& mountPoint)
+{
+	Mount mount;
+	mount.package = std::make_unique<PackageFile>(packageFile);
+	mount.root = normalizeDirectory(mountPoint);
+	mount.absoluteRoot = normalizeDirectory(std::filesystem::absolute(mountPoint));
+
+	Logger logger("FileSystem");
+	LOG(logger, Info) << "mounted package " << packageFile.generic_string() << " (" << mount.package->getEntryCount()
+		<< " files) at " << mount.root.generic_string();
+
+	std::unique_lock<std::shared_mutex> lock(mountMutex);
+	mounts.emplace_back(std::move(mount));
+}
+
+void nex::FileSystem::unmountPackages()
+{
+	std::unique_lock<std::shared_mutex> lock(mountMutex);
+	mounts.clear();
+}
+
+nex::FileSystem::PackagedFile nex::FileSystem::findPackaged(const std::filesystem::path& path)
+{
+	PackagedFile result;
+
+	std::shared_lock<std::shared_mutex> lock(mountMutex);
+	if (mounts.empty()) return result;
+
+	const auto normalized = path.lexically_normal();
+	std::filesystem::path relative;
+
+	for (const auto& mount : mounts) {
+		const auto& root = normalized.is_absolute() ? mount.absoluteRoot : mount.root;
+		if (!isRelativeTo(normalized, root, relative)) continue;
+
+		const auto* entry = mount.package->find(relative);
+		if (!entry) continue;
+
+		result.data = mount.package->getData(*entry);
+		result.size = entry->size;
+		result.compressed = (entry->flags & PackageFile::FLAG_COMPRESSED) != 0;
+		return result;
+	}
+
+	return result;
+}
+
+bool nex::FileSystem::isPackaged(const std::filesystem::path& path)
+{
+	return findPackaged(path).data != nullptr;
+}
+
+bool nex::FileSystem::fileExists(const std::filesystem::path& path)
+{
+	return isPackaged(path) || std::filesystem::exists(path);
+}
+
+void nex::FileSystem::openForReading(BinStream& file, const std::filesystem::path& path)
+{
+	const auto packaged = findPackaged(path);
+
+	if (packaged.data) {
+		file.openMemory(packaged.data, packaged.size, packaged.compressed);
+	}
+	else {
+		file.open(path, std::ios::in);
+	}
+}
+
 const std::string& nex::FileSystem::getCompiledExtension() const
 {
 	return mCompiledFileExtension;
@@ -123,7 +238,9 @@ nex::FileSystem::CompiledPathResult nex::FileSystem::getCompiledPath(const std::
 		for (const auto& item : mIncludeDirectories)
 		{
 			if (isContained(relativePath, item)) {
-				relativePath = makeRelative(relativePath, item);
+				// isContained is a lexical check; std::filesystem::relative would stat every path component
+				const auto root = absolute(item / "").parent_path();
+				relativePath = absolute(relativePath).lexically_relative(root);
 				break;
 			}
 		}
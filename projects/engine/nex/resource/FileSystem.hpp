@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -17,6 +18,16 @@ namespace nex
 			std::filesystem::path path;
 		};
 
+		/**
+		 * A file contained in a mounted package (see nex::PackageFile).
+		 * data is nullptr, if the file isn't packaged.
+		 */
+		struct PackagedFile {
+			const char* data = nullptr;
+			size_t size = 0;
+			bool compressed = false;
+		};
+
 		/**
 		 * Creates a new file system with a vector of include directories.
 		 * @param includeDirectories : the include directories. Has to contain minimal one entry!
@@ -43,6 +54,50 @@ namespace nex
 
 		static std::filesystem::path getCurrentPath_Relative();
 
+		/**
+		 * Types of compiled resources. Compression is enabled per type (see setCompression).
+		 */
+		enum class CompiledType {
+			MESH, FIRST = MESH,
+			TEXTURE,
+			PROBE,
+			RIG, LAST = RIG,
+		};
+
+		/**
+		 * Specifies whether compiled resources of a type are written compressed (see nex::Compression). Disabled
+		 * by default for all types: decompression costs load time, which only pays off for resources that compress
+		 * well on slow drives. Loading detects compressed files regardless of this setting.
+		 */
+		static void setCompression(CompiledType type, bool enable);
+		static bool isCompressionEnabled(CompiledType type);
+
+		/**
+		 * Mounts a package (see nex::PackageFile): files of the package are treated as if they were located in
+		 * the mount point directory. Packages are consulted before the loose files and mounted packages are
+		 * searched in the order they were mounted. Packages should be mounted before resources are loaded and
+		 * have to stay mounted as long as resources loaded from them are used.
+		 * @throws std::runtime_error : if the package couldn't be opened or is corrupt.
+		 */
+		static void mountPackage(const std::filesystem::path& packageFile, const std::filesystem::path& mountPoint);
+		static void unmountPackages();
+
+		/**
+		 * Looks up a file in the mounted packages. Doesn't access the file system.
+		 */
+		static PackagedFile findPackaged(const std::filesystem::path& path);
+		static bool isPackaged(const std::filesystem::path& path);
+
+		/**
+		 * Checks if a file exists either in a mounted package or on disk.
+		 */
+		static bool fileExists(const std::filesystem::path& path);
+
+		/**
+		 * Opens a file for reading, preferring mounted packages over loose files.
+		 */
+		static void openForReading(BinStream& file, const std::filesystem::path& path);
+
 		/**
 		 * Provides the file extension for compiled resources.
 		 */
@@ -89,7 +144,7 @@ namespace nex
 		static void load(const std::filesystem::path& root, const std::filesystem::path& relative, T& out)
 		{
 			BinStream file;
-			file.open(root / relative, std::ios::in);
+			openForReading(file, root / relative);
 			file >> out;
 		}
 
@@ -97,26 +152,26 @@ namespace nex
 		static void load(const std::filesystem::path& filePath, T& out)
 		{
 			BinStream file;
-			file.open(filePath, std::ios::in);
+			openForReading(file, filePath);
 			file >> out;
 		}
 
 		template<typename T>
 		void loadFromCompiled(const std::filesystem::path& resourcePath, 
-			const std::function<void(T&)>& resourceLoader,T& resource, bool forceLoad = false) const
+			const std::function<void(T&)>& resourceLoader,T& resource, CompiledType type, bool forceLoad = false) const
 		{
 			auto compiledPath = getCompiledPath(resourcePath).path;
 
-			if (!std::filesystem::exists(compiledPath) || forceLoad)
+			if (!fileExists(compiledPath) || forceLoad)
 			{
 				//const auto resolvedPath = resolvePath(resourcePath);
 				resourceLoader(resource);
-				FileSystem::store(compiledPath, resource);
+				FileSystem::store(compiledPath, resource, type);
 			}
 			else
 			{
 				BinStream file;
-				file.open(compiledPath, std::ios::in);
+				openForReading(file, compiledPath);
 				file >> resource;
 			}
 		}
@@ -144,18 +199,28 @@ namespace nex
 		std::filesystem::path resolveRelative(const std::filesystem::path& path,
 			const std::filesystem::path& base = std::filesystem::current_path()) const;
 
+		/**
+		 * Stores a compiled resource. If compression is enabled for the type, the file is written compressed and
+		 * always truncated.
+		 */
 		template<typename T>
-		static void store(const std::filesystem::path& path, const T& input, bool trunc = true)
+		static void store(const std::filesystem::path& path, const T& input, CompiledType type, bool trunc = true)
 		{
 			BinStream file;
 			auto directory = path.parent_path();
 			std::filesystem::create_directories(directory);
 
-			std::ios_base::openmode mode = std::ios::out;
-			if (trunc) mode |= std::ios::trunc;
+			if (isCompressionEnabled(type)) {
+				file.openCompressed(path);
+			}
+			else {
+				std::ios_base::openmode mode = std::ios::out;
+				if (trunc) mode |= std::ios::trunc;
+				file.open(path, mode);
+			}
 
-			file.open(path, mode);
 			file << input;
+			file.close();
 		}
 
 
@@ -173,5 +238,7 @@ namespace nex
 		std::vector<std::filesystem::path> mIncludeDirectories;
 		std::filesystem::path mCompiledRootDirectory;
 		std::string mCompiledFileExtension;
+
+		static std::atomic<bool> mCompression[static_cast<unsigned>(CompiledType::LAST) + 1];
 	};
 }
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include <nex/resource/PackageFile.hpp>
+#include <nex/common/Compression.hpp>
+#include <nex/common/File.hpp>
+#include <nex/common/MappedFile.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <nex/util/Profiler.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	constexpr char MAGIC[4] = { 'N', 'P', 'A', 'K' };
+
+	using Entry = nex::PackageFile::Entry;
+
+	bool isLess(const Entry& a, std::string_view nameA, const Entry& b, std::string_view nameB)
+	{
+		if (a.hash != b.hash) return a.hash < b.hash;
+		return nameA < nameB;
+	}
+
+	void pad(nex::BinStream& out)
+	{
+		static const char zeros[nex::PackageFile::ALIGNMENT] = {};
+		const auto position = static_cast<size_t>(out.tellp());
+		const auto padding = (nex::PackageFile::ALIGNMENT - position % nex::PackageFile::ALIGNMENT) % nex::PackageFile::ALIGNMENT;
+		out.write(zeros, padding);
+	}
+}
+
+nex::PackageFile::PackageFile(const std::filesystem::path& path) :
+	mFile(std::make_unique<MappedFile>(path)),
+	mEntries(nullptr),
+	mNames(nullptr),
+	mEntryCount(0)
+{
+	const auto* data = mFile->getData();
+	const auto size = mFile->getSize();
+
+	const auto corrupt = [&]() {
+		return std::runtime_error("nex::PackageFile : corrupt package " + path.generic_string());
+	};
+
+	if (size < sizeof(Header)) throw_with_trace(corrupt());
+
+	const auto* header = reinterpret_cast<const Header*>(data);
+
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+		throw_with_trace(std::runtime_error("nex::PackageFile : not a package of version " + std::to_string(VERSION)
+			+ ": " + path.generic_string()));
+	}
+
+	const auto tocSize = uint64_t(header->entryCount) * sizeof(Entry);
+
+	if (header->fileSize != size
+		|| header->tocOffset % alignof(Entry) != 0
+		|| header->tocOffset > size || tocSize > size - header->tocOffset
+		|| header->namesOffset > size) {
+		throw_with_trace(corrupt());
+	}
+
+	mEntries = reinterpret_cast<const Entry*>(data + header->tocOffset);
+	mNames = data + header->namesOffset;
+	mEntryCount = header->entryCount;
+
+	const auto namesSize = size - header->namesOffset;
+
+	for (size_t i = 0; i < mEntryCount; ++i) {
+		const auto& entry = mEntries[i];
+		if (entry.offset > size || entry.size > size - entry.offset
+			|| entry.nameOffset > namesSize || entry.nameSize > namesSize - entry.nameOffset) {
+			throw_with_trace(corrupt());
+		}
+	}
+}
+
+nex::PackageFile::~PackageFile() = default;
+
+nex::PackageFile::WriteStats nex::PackageFile::write(const std::filesystem::path& path, const std::vector<Source>& sources)
+{
+	NEX_PROFILE_SCOPE("PackageFile::write");
+
+	WriteStats stats;
+	std::vector<Entry> entries(sources.size());
+	std::vector<std::string> names(sources.size());
+
+	if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path());
+
+	BinStream file;
+	file.open(path, std::ios::out | std::ios::trunc);
+
+	Header header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.entryCount = static_cast<uint32_t>(sources.size());
+	file << header;
+
+	for (size_t i = 0; i < sources.size(); ++i) {
+		const auto& source = sources[i];
+		auto& entry = entries[i];
+
+		names[i] = normalize(source.name);
+		entry.hash = hash(names[i]);
+
+		MappedFile input(source.file);
+		const char* data = input.getData();
+		size_t size = input.getSize();
+		entry.uncompressedSize = size;
+
+		std::vector<char> compressed;
+		if (Compression::isCompressed(data, size)) {
+			// the file is stored as is, its uncompressed size is recorded in the compression header
+			if (size < sizeof(Compression::Header)) {
+				throw_with_trace(std::runtime_error("nex::PackageFile::write : corrupt compressed file "
+					+ source.file.generic_string()));
+			}
+
+			Compression::Header compressionHeader;
+			std::memcpy(&compressionHeader, data, sizeof(compressionHeader));
+			entry.uncompressedSize = compressionHeader.size;
+			entry.flags |= FLAG_COMPRESSED;
+		}
+		else if (source.compress) {
+			compressed = Compression::compress(data, size);
+			if (compressed.size() < size) {
+				data = compressed.data();
+				size = compressed.size();
+				entry.flags |= FLAG_COMPRESSED;
+			}
+		}
+
+		if (entry.flags & FLAG_COMPRESSED) ++stats.compressedEntries;
+
+		pad(file);
+		entry.offset = static_cast<uint64_t>(file.tellp());
+		entry.size = size;
+		file.write(data, size);
+
+		stats.sourceBytes += input.getSize();
+	}
+
+	// the table of contents is sorted for binary search
+	std::vector<size_t> order(sources.size());
+	for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		return isLess(entries[a], names[a], entries[b], names[b]);
+	});
+
+	for (size_t i = 1; i < order.size(); ++i) {
+		if (names[order[i - 1]] == names[order[i]]) {
+			throw_with_trace(std::runtime_error("nex::PackageFile::write : duplicate file " + names[order[i]]));
+		}
+	}
+
+	uint32_t nameOffset = 0;
+	for (auto index : order) {
+		entries[index].nameOffset = nameOffset;
+		entries[index].nameSize = static_cast<uint32_t>(names[index].size());
+		nameOffset += entries[index].nameSize;
+	}
+
+	pad(file);
+	header.tocOffset = static_cast<uint64_t>(file.tellp());
+	for (auto index : order) {
+		file << entries[index];
+	}
+
+	header.namesOffset = static_cast<uint64_t>(file.tellp());
+	for (auto index : order) {
+		file.write(names[index].data(), names[index].size());
+	}
+
+	header.fileSize = static_cast<uint64_t>(file.tellp());
+	file.seekp(0);
+	file << header;
+	file.close();
+
+	stats.entries = entries.size();
+	stats.packageBytes = header.fileSize;
+	return stats;
+}
+
+std::string nex::PackageFile::normalize(const std::filesystem::path& name)
+{
+	auto result = name.lexically_normal().generic_string();
+	if (result.size() > 2 && result.compare(0, 2, "./") == 0) result.erase(0, 2);
+	return result;
+}
+
+uint64_t nex::PackageFile::hash(std::string_view name)
+{
+	uint64_t result = 14695981039346656037ull;
+	for (const auto c : name) {
+		result ^= static_cast<uint8_t>(c);
+		result *= 1099511628211ull;
+	}
+	return result;
+}
+
+const nex::PackageFile::Entry* nex::PackageFile::find(const std::filesystem::path& name) const
+{
+	const auto normalized = normalize(name);
+	Entry key = {};
+	key.hash = hash(normalized);
+
+	const auto* end = mEntries + mEntryCount;
+	const auto* it = std::lower_bound(mEntries, end, key, [&](const Entry& entry, const Entry& searched) {
+		return isLess(entry, getName(entry), searched, normalized);
+	});
+
+	if (it == end || it->hash != key.hash || getName(*it) != normalized) return nullptr;
+	return it;
+}
+
+const nex::PackageFile::Entry* nex::PackageFile::getEntries() const
+{
+	return mEntries;
+}
+
+size_t nex::PackageFile::getEntryCount() const
+{
+	return mEntryCount;
+}
+
+const char* nex::PackageFile::getData(const Entry& entry) const
+{
+	return mFile->getData() + entry.offset;
+}
+
+std::string_view nex::PackageFile::getName(const Entry& entry) const
+{
+	return std::string_view(mNames + entry.nameOffset, entry.nameSize);
+}
+
+const std::filesystem::path& nex::PackageFile::getPath() const
+{
+	return mFile->getPath();
+}
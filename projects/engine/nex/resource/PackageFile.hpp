@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nex
+{
+	class MappedFile;
+
+	/**
+	 * A package (.pak) bundling compiled resource files into one file.
+	 *
+	 * Layout:
+	 *  - header: magic "NPAK", version, entry count, offsets of the table of contents and the name table, file size
+	 *  - entry data, each entry starting at a 16 byte aligned offset
+	 *  - table of contents: one entry per file, sorted by the hash of the file name (and by name for equal hashes)
+	 *  - name table: the names of the files (normalized generic paths relative to the package root)
+	 *
+	 * Reading maps the package. Looking up a file is a binary search in the mapped table of contents and doesn't touch
+	 * the file system. Entries flagged as compressed hold data in the format of nex::Compression; all other entries
+	 * can be used in place (e.g. the mesh data of .CVOB files).
+	 */
+	class PackageFile
+	{
+	public:
+
+		static constexpr uint32_t VERSION = 1;
+		static constexpr size_t ALIGNMENT = 16;
+
+		/**
+		 * The entry data is compressed (see nex::Compression).
+		 */
+		static constexpr uint32_t FLAG_COMPRESSED = 1u << 0;
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t entryCount;
+			uint32_t reserved;
+			uint64_t tocOffset;
+			uint64_t namesOffset;
+			uint64_t fileSize;
+		};
+
+		struct Entry
+		{
+			uint64_t hash;
+			uint64_t offset;
+			uint64_t size; // stored size
+			uint64_t uncompressedSize;
+			uint32_t nameOffset;
+			uint32_t nameSize;
+			uint32_t flags;
+			uint32_t reserved;
+		};
+
+		/**
+		 * A file to be added to a package.
+		 */
+		struct Source
+		{
+			// name within the package (relative path)
+			std::filesystem::path name;
+			std::filesystem::path file;
+			// Compress the file if it gets smaller. Files that are already compressed are never compressed again.
+			bool compress = false;
+		};
+
+		struct WriteStats
+		{
+			size_t entries = 0;
+			size_t compressedEntries = 0;
+			size_t sourceBytes = 0;
+			size_t packageBytes = 0;
+		};
+
+		/**
+		 * Maps a package.
+		 * @throws std::runtime_error : if the package couldn't be opened or is corrupt.
+		 */
+		explicit PackageFile(const std::filesystem::path& path);
+		~PackageFile();
+
+		PackageFile(const PackageFile&) = delete;
+		PackageFile& operator=(const PackageFile&) = delete;
+
+		/**
+		 * Writes a package.
+		 * @throws std::runtime_error : if a source couldn't be read or two sources have the same name.
+		 */
+		static WriteStats write(const std::filesystem::path& path, const std::vector<Source>& sources);
+
+		/**
+		 * Provides the name of a file as it is stored in a package: the lexically normalized generic path.
+		 */
+		static std::string normalize(const std::filesystem::path& name);
+
+		/**
+		 * FNV-1a hash of a normalized name.
+		 */
+		static uint64_t hash(std::string_view name);
+
+		/**
+		 * Looks up a file by its path relative to the package root.
+		 * @return The entry of the file or nullptr, if the package doesn't contain the file.
+		 */
+		const Entry* find(const std::filesystem::path& name) const;
+
+		const Entry* getEntries() const;
+		size_t getEntryCount() const;
+
+		/**
+		 * Provides the stored data of an entry. The data is valid as long as this object exists.
+		 */
+		const char* getData(const Entry& entry) const;
+		std::string_view getName(const Entry& entry) const;
+
+		const std::filesystem::path& getPath() const;
+
+	private:
+		std::unique_ptr<MappedFile> mFile;
+		const Entry* mEntries;
+		const char* mNames;
+		size_t mEntryCount;
+	};
+}
@@ -7,6 +7,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <nex/util/ExceptionHandling.hpp>
 #include <nex/renderer/RenderEngine.hpp>
+#include <nex/util/Profiler.hpp>
 
 #include <eh.h>
 
@@ -33,29 +34,48 @@ public:
 
 std::unique_ptr<nex::ResourceLoader> nex::ResourceLoader::mInstance;
 
-nex::ResourceLoader::ResourceLoader(Window* shared, const nex::RenderEngine& renderEngine) : mWindow(shared)
+// Index of the worker running on the current thread; -1 for non worker threads.
+static thread_local int gWorkerIndex = -1;
+
+nex::ResourceLoader::ResourceLoader(Window* shared, const nex::RenderEngine& renderEngine, unsigned workerCount) : mWindow(shared)
 {
 	mLogger.setPrefix("ResourceLoader");
 
-	mWorker = std::thread([=]()
-	{
-			Logger logger("ResourceLoader - Worker");
+	if (workerCount == 0) {
+		const auto hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
 
-			_set_se_translator(SEH_HANDLER::my_trans_func);
+	mQueues.reserve(workerCount);
+	for (unsigned i = 0; i < workerCount; ++i) {
+		mQueues.emplace_back(std::make_unique<WorkerQueue>());
+	}
 
+	LOG(mLogger, Info) << "Using " << workerCount << " worker threads";
 
-			try {
-				run(mWindow);
-			}
-			catch (const std::exception & e)
-			{
-				nex::ExceptionHandling::logExceptionWithStackTrace(logger, e);
-			}
-			catch (...)
-			{
-				LOG(logger, nex::Fault) << "Unknown Exception occurred.";
-			}
-	});
+	mWorkers.reserve(workerCount);
+
+	for (unsigned i = 0; i < workerCount; ++i) {
+		mWorkers.emplace_back([=]()
+		{
+				Logger logger("ResourceLoader - Worker");
+
+				_set_se_translator(SEH_HANDLER::my_trans_func);
+
+
+				try {
+					run(i, mWindow);
+				}
+				catch (const std::exception & e)
+				{
+					nex::ExceptionHandling::logExceptionWithStackTrace(logger, e);
+				}
+				catch (...)
+				{
+					LOG(logger, nex::Fault) << "Unknown Exception occurred.";
+				}
+		});
+	}
 }
 
 nex::ResourceLoader::~ResourceLoader()
@@ -63,9 +83,9 @@ nex::ResourceLoader::~ResourceLoader()
 	shutdownSelf();
 }
 
-void nex::ResourceLoader::init(Window* shared, const RenderEngine& renderEngine)
+void nex::ResourceLoader::init(Window* shared, const RenderEngine& renderEngine, unsigned workerCount)
 {
-	mInstance = std::make_unique<ResourceLoader>(shared, renderEngine);
+	mInstance = std::make_unique<ResourceLoader>(shared, renderEngine, workerCount);
 }
 
 nex::ResourceLoader* nex::ResourceLoader::get()
@@ -97,6 +117,13 @@ nex::ConcurrentQueue<std::shared_ptr<std::exception>>& nex::ResourceLoader::getE
 	return mExceptions;
 }
 
+nex::Executor nex::ResourceLoader::getExecutor(JobPriority priority, JobAffinity affinity)
+{
+	return [this, priority, affinity](Continuation continuation) {
+		submit(createJob(std::make_shared<PackagedTask<void()>>(std::move(continuation))), priority, affinity);
+	};
+}
+
 unsigned long nex::ResourceLoader::getFinishedJobs() const
 {
 	return mFinishedJobs;
@@ -107,6 +134,11 @@ unsigned long nex::ResourceLoader::getRequestedJobs() const
 	return mRequestedJobs;
 }
 
+unsigned nex::ResourceLoader::getWorkerCount() const
+{
+	return static_cast<unsigned>(mWorkers.size());
+}
+
 void nex::ResourceLoader::waitTillAllJobsFinished()
 {
 	std::unique_lock<std::mutex>lock(mMutex);
@@ -131,39 +163,140 @@ void nex::ResourceLoader::shutdownSelf()
 
 	mCondition.notify_all();
 
-	mWorker.join();
+	for (auto& worker : mWorkers) {
+		worker.join();
+	}
 }
 
-void nex::ResourceLoader::run(Window* window)
+void nex::ResourceLoader::submit(Job job, JobPriority priority, JobAffinity affinity)
 {
-	LOG(mLogger, Info) << "Started";
+	const auto priorityIndex = static_cast<size_t>(priority);
+	const bool pinned = affinity == JobAffinity::RenderContext;
+
+	// The pending counters are incremented before the job gets visible to other workers, 
+	// otherwise a worker could fetch (and uncount) the job before it is counted.
+	{
+		std::unique_lock<std::mutex>lock(mMutex);
+		if (!mIsRunning) throw std::runtime_error("nex::ResourceLoader::enqueue: Already shutdown!");
+		++mRequestedJobs;
+		if (pinned) ++mPendingPinnedJobs;
+		else ++mPendingJobs;
+	}
+
+	// Context bound jobs always go to the first worker. Other jobs stay on the current worker (if any) 
+	// and are distributed round-robin otherwise. Idle workers will steal them if needed.
+	size_t queueIndex = 0;
+	if (!pinned) {
+		queueIndex = gWorkerIndex >= 0 ? gWorkerIndex : mNextQueue++ % mQueues.size();
+	}
 
-	
-	window->activate(true);
-	window->activate();
-	auto* backend = RenderBackend::get();
-	backend->init({ 0, 0, 800, 600 }, 1);
-	backend->initEffectLibrary();
+	auto& queue = *mQueues[queueIndex];
 
-	while (true)
 	{
-		Job t;
+		std::unique_lock<std::mutex> lock(queue.mutex);
+		if (pinned) queue.pinnedJobs[priorityIndex].emplace_back(std::move(job));
+		else queue.jobs[priorityIndex].emplace_back(std::move(job));
+	}
+
+	mCondition.notify_all();
+}
+
+bool nex::ResourceLoader::fetchJob(unsigned workerIndex, Job& job)
+{
+	const auto queueCount = mQueues.size();
+	auto& ownQueue = *mQueues[workerIndex];
 
+	for (size_t priority = 0; priority < PRIORITY_COUNT; ++priority) {
+		
+		// own jobs
 		{
-			std::unique_lock<std::mutex> lock(mMutex);
+			std::unique_lock<std::mutex> lock(ownQueue.mutex);
+
+			auto& pinnedJobs = ownQueue.pinnedJobs[priority];
+			if (!pinnedJobs.empty()) {
+				job = std::move(pinnedJobs.front());
+				pinnedJobs.pop_front();
+				lock.unlock();
 
-			// Wait till there is a job to process or shutdown has been called
-			mCondition.wait(lock, [=] { return !mJobs.empty() || !mIsRunning; });
+				std::unique_lock<std::mutex> globalLock(mMutex);
+				--mPendingPinnedJobs;
+				return true;
+			}
 
-			if (!mIsRunning && mJobs.empty()) break;
+			auto& jobs = ownQueue.jobs[priority];
+			if (!jobs.empty()) {
+				job = std::move(jobs.back());
+				jobs.pop_back();
+				lock.unlock();
 
-			t = std::move(mJobs.front());
-			mJobs.pop();
+				std::unique_lock<std::mutex> globalLock(mMutex);
+				--mPendingJobs;
+				return true;
+			}
 		}
-		
-		t();
-		backend->flushPendingCommands();
+
+		// steal from other workers
+		for (size_t i = 1; i < queueCount; ++i) {
+			auto& victim = *mQueues[(workerIndex + i) % queueCount];
+			std::unique_lock<std::mutex> lock(victim.mutex);
+
+			auto& jobs = victim.jobs[priority];
+			if (jobs.empty()) continue;
+
+			job = std::move(jobs.front());
+			jobs.pop_front();
+			lock.unlock();
+
+			std::unique_lock<std::mutex> globalLock(mMutex);
+			--mPendingJobs;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void nex::ResourceLoader::run(unsigned workerIndex, Window* window)
+{
+	LOG(mLogger, Info) << "Started worker " << workerIndex;
+
+	gWorkerIndex = static_cast<int>(workerIndex);
+	NEX_PROFILE_THREAD("ResourceLoader worker " + std::to_string(workerIndex));
+
+	// Only the first worker uses the shared render context.
+	const bool hasRenderContext = workerIndex == 0;
+	RenderBackend* backend = nullptr;
+
+	if (hasRenderContext) {
+		window->activate(true);
+		window->activate();
+		backend = RenderBackend::get();
+		backend->init({ 0, 0, 800, 600 }, 1);
+		backend->initEffectLibrary();
+	}
+
+	while (true)
+	{
+		Job t;
+
+		if (fetchJob(workerIndex, t)) {
+			NEX_PROFILE_SCOPE("ResourceLoader::job");
+			t();
+			if (hasRenderContext) backend->flushPendingCommands();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mMutex);
+
+		auto hasWork = [&]() {
+			return mPendingJobs > 0 || (hasRenderContext && mPendingPinnedJobs > 0);
+		};
+
+		// Wait till there is a job to process or shutdown has been called
+		mCondition.wait(lock, [&] { return hasWork() || !mIsRunning; });
+
+		if (!mIsRunning && !hasWork()) break;
 	}
 
-	backend->release();
+	if (hasRenderContext) backend->release();
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <mutex>
-#include <queue>
+#include <deque>
+#include <thread>
+#include <atomic>
 #include <condition_variable>
 #include "nex/common/Log.hpp"
 #include <nex/common/Future.hpp>
@@ -34,16 +36,45 @@ namespace nex
 	class Window;
 	class Resource;
 
+	/**
+	 * Loads resources asynchronously on a pool of worker threads.
+	 * Each worker owns a job deque per priority. A worker processes its own deque from the back (newest job first) 
+	 * and steals from the front of the other workers' deques if it runs out of work.
+	 * 
+	 * Note: Only the first worker has access to the shared render context. Jobs that create render backend objects 
+	 * directly have to be enqueued with JobAffinity::RenderContext (the default). Jobs that only do cpu work 
+	 * (file reading, mesh import, image decoding) should use JobAffinity::Any, so that they can run on all workers.
+	 */
 	class ResourceLoader
 	{
 	public:
 		using Job = std::function<void()>;
 
-		ResourceLoader( Window* shared, const nex::RenderEngine& renderEngine);
+		/**
+		 * Specifies the order, jobs are processed. Jobs with a lower value are processed first.
+		 */
+		enum class JobPriority {
+			VisibleNow, FIRST = VisibleNow, // Resource is needed for the current frame
+			Normal,
+			Prefetch, LAST = Prefetch,	// Resource might be needed in the future
+		};
+
+		/**
+		 * Specifies on which workers a job is allowed to run.
+		 */
+		enum class JobAffinity {
+			RenderContext, // Job needs the shared render context; will only be executed by the first worker
+			Any, // Job can be executed by any worker
+		};
+
+		/**
+		 * @param workerCount : The number of worker threads. If 0, the number of hardware threads - 1 is used (minimal 1).
+		 */
+		ResourceLoader( Window* shared, const nex::RenderEngine& renderEngine, unsigned workerCount = 0);
 
 		virtual ~ResourceLoader();
 
-		static void init(Window* shared, const RenderEngine& renderEngine);
+		static void init(Window* shared, const RenderEngine& renderEngine, unsigned workerCount = 0);
 		static ResourceLoader* get();
 		static void shutdown();
 
@@ -57,31 +88,38 @@ namespace nex
 			//, class = std::enable_if_t<std::is_same<detail::deduce_type<decltype(&Func::operator())>::type, 
 			//			std::function< nex::Resource*(Args...)>>::value>
 		>
-		auto enqueue(std::function<ResourceType()>&& func) -> Future<ResourceType>
+		auto enqueue(std::function<ResourceType()>&& func, 
+			JobPriority priority = JobPriority::Normal, 
+			JobAffinity affinity = JobAffinity::RenderContext) -> Future<ResourceType>
 		{
 			auto wrapper = std::make_shared<PackagedTask<ResourceType()>>(
 				std::forward<std::function<ResourceType()>>(func)
 				);
 
-			{
-				std::unique_lock<std::mutex>lock(mMutex);
-				++mRequestedJobs;
-
-				if (!mIsRunning) throw std::runtime_error("nex::ResourceLoader::enqueue: Already shutdown!");
-				mJobs.push(std::move(createJob(wrapper)));
-			}
-
-			mCondition.notify_all();
+			submit(createJob(wrapper), priority, affinity);
 
 			return wrapper->get_future();
 		}
 
+		/**
+		 * Provides an executor that submits continuations as jobs to this resource loader.
+		 * Can be used to run the continuation of a future (see Future::then) on the worker pool.
+		 * Note: Like enqueue, continuations are bound to the render context by default. Use JobAffinity::Any 
+		 * for continuations that only do cpu work.
+		 */
+		Executor getExecutor(JobPriority priority = JobPriority::Normal, JobAffinity affinity = JobAffinity::RenderContext);
+
 		const nex::ConcurrentQueue<std::shared_ptr<std::exception>>& getExceptionQueue() const;
 		nex::ConcurrentQueue<std::shared_ptr<std::exception>>& getExceptionQueue();
 
 		
 		unsigned long getFinishedJobs() const;
 		unsigned long getRequestedJobs() const;
+
+		/**
+		 * Provides the number of worker threads.
+		 */
+		unsigned getWorkerCount() const;
 	
 		void resetJobCounter();
 
@@ -90,15 +128,33 @@ namespace nex
 		void waitTillAllJobsFinished();
 
 	private:
-		//tbb::concurrent_bounded_queue<Task> mTasks;
-		//std::atomic<bool> mIsRunning;
+
+		static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(JobPriority::LAST) + 1;
+
+		/**
+		 * Job deques of a worker. 
+		 */
+		struct WorkerQueue {
+			std::mutex mutex;
+			// jobs that can be stolen by other workers
+			std::deque<Job> jobs[PRIORITY_COUNT];
+			// jobs that have to be executed by this worker
+			std::deque<Job> pinnedJobs[PRIORITY_COUNT];
+		};
+
 		std::condition_variable mCondition;
-		unsigned long mFinishedJobs;
-		unsigned long mRequestedJobs;
+		unsigned long mFinishedJobs = 0;
+		unsigned long mRequestedJobs = 0;
 		std::mutex mMutex;
 		bool mIsRunning = true;
-		std::queue<Job> mJobs;
-		std::thread mWorker;
+
+		// Number of queued jobs, that haven't been picked up by a worker yet (guarded by mMutex)
+		size_t mPendingJobs = 0;
+		size_t mPendingPinnedJobs = 0;
+
+		std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+		std::vector<std::thread> mWorkers;
+		std::atomic<unsigned> mNextQueue = 0;
 		nex::Logger mLogger;
 
 		static std::unique_ptr<ResourceLoader> mInstance;
@@ -108,8 +164,21 @@ namespace nex
 		template<class ResourceType>
 		Job createJob(std::shared_ptr<PackagedTask<ResourceType()>> task);
 
-
-		void run(Window* window);
+		/**
+		 * Queues a job. 
+		 * If called from a worker thread and the job isn't bound to the render context, 
+		 * the job is pushed to the deque of the calling worker.
+		 */
+		void submit(Job job, JobPriority priority, JobAffinity affinity);
+
+		/**
+		 * Fetches the next job for a worker: Own (pinned) jobs first, afterwards jobs stolen from other workers.
+		 * Higher priority jobs are always preferred.
+		 * @return true, if a job could be fetched.
+		 */
+		bool fetchJob(unsigned workerIndex, Job& job);
+
+		void run(unsigned workerIndex, Window* window);
 	};
 
 
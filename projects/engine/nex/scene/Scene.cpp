@@ -10,10 +10,13 @@
 #include <nex/renderer/RenderCommandQueue.hpp>
 #include <nex/anim/AnimationManager.hpp>
 #include <nex/GI/Probe.hpp>
+#include <nex/util/Profiler.hpp>
+#include <nex/util/concurrent/ThreadPool.hpp>
+#include <unordered_map>
 
 namespace nex
 {
-	Scene::Scene() : mHasChanged(false) 
+	Scene::Scene() : mUpdateGroupsVersion(0), mUpdateGroupsDirty(true), mMaxUpdateThreads(0), mProbeIndex(0.0f), mHasChanged(false)
 	{
 	}
 
@@ -45,8 +48,13 @@ namespace nex
 
 		if (!vob->isStatic()) {
 			mActiveUpdateables.insert(vob);
+			mUpdateGroupsDirty = true;
 		}
 
+		addSpatialProxy(vob);
+		mMaterialDataUpdater.attach(vob);
+
+		mTransformHierarchy.invalidate();
 		mHasChanged = true;
 	}
 
@@ -55,9 +63,11 @@ namespace nex
 		mActiveRoots.erase(std::remove(mActiveRoots.begin(), mActiveRoots.end(), vob), mActiveRoots.end());
 		
 		mActiveProbeVobs.erase(std::remove(mActiveProbeVobs.begin(), mActiveProbeVobs.end(), dynamic_cast<ProbeVob*>(vob)), mActiveProbeVobs.end());
-		mActiveUpdateables.erase(vob);
+		if (mActiveUpdateables.erase(vob)) mUpdateGroupsDirty = true;
 
 		mActiveVobsFlat.erase(std::remove(mActiveVobsFlat.begin(), mActiveVobsFlat.end(), vob), mActiveVobsFlat.end());
+		removeSpatialProxy(vob);
+		mMaterialDataUpdater.detach(vob);
 
 		if (recursive) {
 			for (auto& child : vob->getChildren()) {
@@ -65,6 +75,7 @@ namespace nex
 			}
 		}
 
+		mTransformHierarchy.invalidate();
 		mHasChanged = true;
 	}
 
@@ -124,7 +135,28 @@ namespace nex
 
 	void Scene::frameUpdate(const RenderContext& constants)
 	{
-		for (auto* vob : mActiveUpdateables) {
+		NEX_PROFILE_SCOPE("Scene::frameUpdate");
+
+		if (mUpdateGroupsDirty || mUpdateGroupsVersion != mTransformHierarchy.getStructureVersion()) {
+			rebuildUpdateGroups();
+		}
+
+		auto* pool = util::ThreadPool::get();
+		const auto groupCount = mUpdateGroupOffsets.size() - 1;
+		const auto threadCount = mMaxUpdateThreads ? std::min(mMaxUpdateThreads, pool->getThreadCount()) : pool->getThreadCount();
+		// a few groups per thread balance the load without too much scheduling overhead
+		const auto grainSize = std::max<size_t>(groupCount / (threadCount * 8), 1);
+
+		pool->parallelFor(groupCount, grainSize, [&](size_t begin, size_t end) {
+			NEX_PROFILE_SCOPE("Scene::frameUpdate::groups");
+			for (auto i = mUpdateGroupOffsets[begin]; i < mUpdateGroupOffsets[end]; ++i) {
+				auto* vob = mParallelUpdateables[i];
+				if (vob->isVisible())
+					vob->frameUpdate(constants);
+			}
+		}, threadCount);
+
+		for (auto* vob : mSerialUpdateables) {
 			if (vob->isVisible())
 				vob->frameUpdate(constants);
 		}
@@ -157,8 +189,15 @@ namespace nex
 		mActiveRoots.clear();
 		mActiveVobsFlat.clear();
 		mActiveUpdateables.clear();
+		mUpdateGroupsDirty = true;
 		mResizables.clear();
 		mVobStore.clear();
+		mSpatialIndex.clear();
+		mSpatialProxies.clear();
+		mProbeIndex.clear();
+		mProbeProxies.clear();
+		mMaterialDataUpdater.clear();
+		mTransformHierarchy.invalidate();
 		mHasChanged = true;
 	}
 
@@ -194,12 +233,127 @@ namespace nex
 
 	void Scene::updateWorldTrafoHierarchyUnsafe(bool resetPrevWorldTrafo)
 	{
-		for (auto& vob : mActiveRoots)
-			vob->updateTrafo(resetPrevWorldTrafo);
+		mTransformHierarchy.update(mActiveRoots, resetPrevWorldTrafo);
+
+		{
+			NEX_PROFILE_SCOPE("Scene::updateSpatialIndex");
+			for (auto* vob : mTransformHierarchy.getBoundsChangedVobs()) {
+				updateSpatialProxy(vob);
+			}
+		}
 
 		mHasChanged = true;
 	}
 
+	void Scene::addSpatialProxy(Vob* vob)
+	{
+		if (mSpatialProxies.count(vob)) return;
+		mSpatialProxies.emplace(vob, mSpatialIndex.createProxy(getSpatialBounds(vob), vob));
+
+		if (auto* probeVob = dynamic_cast<ProbeVob*>(vob)) {
+			const auto& position = vob->getPositionLocalToWorld();
+			mProbeProxies.emplace(vob, mProbeIndex.createProxy(AABB(position, position), probeVob));
+		}
+	}
+
+	void Scene::removeSpatialProxy(Vob* vob)
+	{
+		auto it = mSpatialProxies.find(vob);
+		if (it == mSpatialProxies.end()) return;
+		mSpatialIndex.destroyProxy(it->second);
+		mSpatialProxies.erase(it);
+
+		auto probeIt = mProbeProxies.find(vob);
+		if (probeIt == mProbeProxies.end()) return;
+		mProbeIndex.destroyProxy(probeIt->second);
+		mProbeProxies.erase(probeIt);
+	}
+
+	void Scene::updateSpatialProxy(Vob* vob)
+	{
+		auto it = mSpatialProxies.find(vob);
+		if (it == mSpatialProxies.end()) return;
+		mSpatialIndex.moveProxy(it->second, getSpatialBounds(vob));
+
+		if (mProbeProxies.empty()) return;
+		auto probeIt = mProbeProxies.find(vob);
+		if (probeIt == mProbeProxies.end()) return;
+		const auto& position = vob->getPositionLocalToWorld();
+		mProbeIndex.moveProxy(probeIt->second, AABB(position, position));
+	}
+
+	AABB Scene::getSpatialBounds(const Vob* vob)
+	{
+		// vobs without bounds (e.g. without meshes) are represented by their position
+		const auto& box = vob->getBoundingBoxWorld();
+		if (box.isValid()) return box;
+		const auto& position = vob->getPositionLocalToWorld();
+		return AABB(position, position);
+	}
+
+	void Scene::rebuildUpdateGroups()
+	{
+		struct Entry {
+			uint32_t group;
+			uint32_t depth;
+			Vob* vob;
+		};
+
+		std::unordered_map<Vob*, uint32_t> groups;
+		std::vector<Entry> entries;
+		std::vector<bool> groupIsSafe;
+		entries.reserve(mActiveUpdateables.size());
+
+		// group order follows the root order, so that the update order doesn't depend on hashing
+		for (auto* root : mActiveRoots) {
+			if (groups.emplace(root, static_cast<uint32_t>(groupIsSafe.size())).second)
+				groupIsSafe.push_back(true);
+		}
+
+		for (auto* vob : mActiveUpdateables) {
+			uint32_t depth = 0;
+			auto* root = vob;
+			while (auto* parent = root->getParent()) {
+				root = parent;
+				++depth;
+			}
+
+			auto it = groups.emplace(root, static_cast<uint32_t>(groupIsSafe.size())).first;
+			if (it->second == groupIsSafe.size()) groupIsSafe.push_back(true);
+
+			const auto group = it->second;
+			if (!vob->isParallelUpdateSafe()) groupIsSafe[group] = false;
+			entries.push_back({group, depth, vob});
+		}
+
+		// parents have to be updated before their children
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+			if (a.group != b.group) return a.group < b.group;
+			return a.depth < b.depth;
+		});
+
+		mParallelUpdateables.clear();
+		mSerialUpdateables.clear();
+		mUpdateGroupOffsets.clear();
+		mUpdateGroupOffsets.push_back(0);
+
+		for (size_t i = 0; i < entries.size(); ++i) {
+			const auto& entry = entries[i];
+
+			if (groupIsSafe[entry.group]) {
+				mParallelUpdateables.push_back(entry.vob);
+				const bool groupEnds = i + 1 == entries.size() || entries[i + 1].group != entry.group;
+				if (groupEnds) mUpdateGroupOffsets.push_back(static_cast<uint32_t>(mParallelUpdateables.size()));
+			}
+			else {
+				mSerialUpdateables.push_back(entry.vob);
+			}
+		}
+
+		mUpdateGroupsVersion = mTransformHierarchy.getStructureVersion();
+		mUpdateGroupsDirty = false;
+	}
+
 	void Scene::deregister(Vob* vob)
 	{
 		try {
@@ -233,7 +387,8 @@ namespace nex
 	{
 		mBoundingBox = AABB();
 
-		for (const auto& root : getActiveVobsUnsafe())
+		// Note: The world bounding box of a root includes its descendants.
+		for (const auto& root : getActiveRootsUnsafe())
 		{
 			mBoundingBox = maxAABB(mBoundingBox, root->getBoundingBoxWorld());
 		}
@@ -249,26 +404,56 @@ namespace nex
 		return mBoundingBox;
 	}
 
-	void Scene::collectRenderCommands(RenderCommandQueue& queue, bool doCulling, const RenderContext& renderContext) const
+	MaterialDataUpdater& Scene::getMaterialDataUpdaterUnsafe()
 	{
-		auto guard = acquireLock();
+		return mMaterialDataUpdater;
+	}
 
-		for (auto* vob : getActiveVobsUnsafe())
-		{
-			if (!vob->isVisible()) continue;
-			vob->collectRenderCommands(queue, doCulling, renderContext);
-		}
+	const DynamicAABBTree& Scene::getSpatialIndexUnsafe() const
+	{
+		return mSpatialIndex;
+	}
+
+	const TransformHierarchy& Scene::getTransformHierarchy() const
+	{
+		return mTransformHierarchy;
+	}
+
+	void Scene::setMaxUpdateThreads(unsigned count)
+	{
+		mMaxUpdateThreads = count;
+	}
+
+	void Scene::collectRenderCommands(RenderCommandQueue& queue, bool doCulling, const RenderContext& renderContext) const
+	{
+		collectRenderCommands(queue, doCulling, renderContext, nullptr);
 	}
 
 	void Scene::collectRenderCommands(RenderCommandQueue& queue, bool doCulling, const RenderContext& renderContext, std::function<bool(Vob*)> filter) const
 	{
 		auto guard = acquireLock();
 
-		for (auto* vob : getActiveVobsUnsafe())
-		{
-			if (!vob->isVisible()) continue;
-			if (filter(vob)) vob->collectRenderCommands(queue, doCulling, renderContext);
+		auto collect = [&](Vob* vob) {
+			if (!vob->isVisible()) return;
+			if (!filter || filter(vob)) vob->collectRenderCommands(queue, doCulling, renderContext);
+		};
+
+		if (!doCulling) {
+			for (auto* vob : getActiveVobsUnsafe()) collect(vob);
+			return;
 		}
+
+		// Vobs outside of the culling volume cannot produce visible render commands.
+		// Note: The render command queue still culls the single commands (in one batch).
+		if (queue.getCullingMethod() == RenderCommandQueue::CullingMethod::FRUSTUM) {
+			if (const auto* camera = queue.getCullingCamera())
+				queryFrustumUnsafe(camera->getFrustumWorld(), collect);
+		}
+		else {
+			querySphereUnsafe(queue.getCullingSphere(), collect);
+		}
+
+		queue.cull();
 	}
 
 	void Scene::setHasChangedUnsafe(bool changed)
@@ -10,6 +10,10 @@
 #include <nex/common/Resizable.hpp>
 #include <nex/util/Memory.hpp>
 #include <nex/scene/Vob.hpp>
+#include <nex/scene/TransformHierarchy.hpp>
+#include <nex/renderer/MaterialDataUpdater.hpp>
+#include <nex/math/DynamicAABBTree.hpp>
+#include <unordered_map>
 
 
 #ifndef GLM_ENABLE_EXPERIMENTAL
@@ -69,6 +73,12 @@ namespace nex
 
 		Vob* createVobUnsafe(nex::MeshGroup* group, bool setActive = true);
 
+		/**
+		 * Updates all active non-static vobs.
+		 * Vobs of different trees are updated in parallel (see nex::util::ThreadPool). Trees containing a vob that isn't
+		 * parallel update safe (see FrameUpdateable::isParallelUpdateSafe) are updated afterwards on the calling thread.
+		 * Within a tree, parents are updated before their children.
+		 */
 		void frameUpdate(const RenderContext& constants) override;
 
 		/**
@@ -95,6 +105,24 @@ namespace nex
 
 		const AABB& getSceneBoundingBox() const;
 
+		/**
+		 * Provides the manager of the per object material data slots of the active vobs.
+		 */
+		MaterialDataUpdater& getMaterialDataUpdaterUnsafe();
+
+		/**
+		 * Provides the spatial index of the active vobs. The proxy user data is the vob.
+		 */
+		const DynamicAABBTree& getSpatialIndexUnsafe() const;
+
+		const TransformHierarchy& getTransformHierarchy() const;
+
+		/**
+		 * Limits the number of threads that update the vobs in frameUpdate (including the calling thread).
+		 * If 0 (default), all threads of the engine thread pool are used; 1 updates all vobs on the calling thread.
+		 */
+		void setMaxUpdateThreads(unsigned count);
+
 		/**
 		 * Provides all vobs of this scene.
 		 */
@@ -103,11 +131,49 @@ namespace nex
 
 		bool hasChangedUnsafe() const;
 
+		/**
+		 * Calls callback(Vob*) for all active vobs whose world bounding box (potentially) overlaps a bounding box.
+		 * Note: The queries are conservative (see DynamicAABBTree) and refer to the state of the last
+		 * updateWorldTrafoHierarchyUnsafe call.
+		 */
+		template<class Callback>
+		void queryAABBUnsafe(const AABB& box, Callback&& callback) const;
+
+		/**
+		 * Calls callback(Vob*) for all active vobs whose world bounding box (potentially) intersects a frustum.
+		 */
+		template<class Callback>
+		void queryFrustumUnsafe(const Frustum& frustum, Callback&& callback) const;
+
+		/**
+		 * Finds the k active probe vobs nearest to a position.
+		 * @param filter : filter(ProbeVob*) specifies whether a probe vob is a valid candidate.
+		 * @param result : Receives the probe vobs, sorted by distance (nearest first).
+		 */
+		template<class Filter>
+		void queryNearestProbesUnsafe(const glm::vec3& position, size_t k, Filter&& filter, std::vector<ProbeVob*>& result) const;
+
+		/**
+		 * Calls callback(Vob*) for all active vobs whose world bounding box (potentially) is hit by a ray.
+		 */
+		template<class Callback>
+		void queryRayUnsafe(const Ray& ray, float maxMultiplier, Callback&& callback) const;
+
+		/**
+		 * Calls callback(Vob*) for all active vobs whose world bounding box (potentially) intersects a sphere.
+		 */
+		template<class Callback>
+		void querySphereUnsafe(const Sphere& sphere, Callback&& callback) const;
+
 		void resize(unsigned width, unsigned height) override;
 
 		void setHasChangedUnsafe(bool changed);
 
-		
+		/**
+		 * Updates the world transformations and bounding boxes of all vobs that have changed (and of their descendants).
+		 * @param resetPrevWorldTrafo : If true, the previous world transformations of the updated vobs are set to the new
+		 * ones, so that their movement doesn't produce motion vectors (e.g. for vobs that have just been placed).
+		 */
 		void updateWorldTrafoHierarchyUnsafe(bool resetPrevWorldTrafo);
 
 	private:
@@ -116,14 +182,88 @@ namespace nex
 		void deregister(Vob* vob);
 		void deleteVobPrivate(Vob* vob, bool recursive);
 
+		/**
+		 * Groups the active updateables by their vob tree.
+		 */
+		void rebuildUpdateGroups();
+
+		void addSpatialProxy(Vob* vob);
+		void removeSpatialProxy(Vob* vob);
+		void updateSpatialProxy(Vob* vob);
+		static AABB getSpatialBounds(const Vob* vob);
+
 		VobRange mActiveRoots;
 		VobRange mActiveVobsFlat;
 		FrameUpdateableRange mActiveUpdateables;
+
+		// updateables of parallel update safe trees; the vobs of group i are in range [mUpdateGroupOffsets[i], mUpdateGroupOffsets[i+1])
+		VobRange mParallelUpdateables;
+		std::vector<uint32_t> mUpdateGroupOffsets;
+		// updateables of trees that have to be updated on the main thread
+		VobRange mSerialUpdateables;
+		uint64_t mUpdateGroupsVersion;
+		bool mUpdateGroupsDirty;
+		unsigned mMaxUpdateThreads;
 		ResizableRange mResizables;
 		ProbeRange mActiveProbeVobs;
+		// Note: Has to be declared before the vob store, since vobs detach from the hierarchy on destruction.
+		TransformHierarchy mTransformHierarchy;
+		// Note: Has to be declared before the vob store, too.
+		MaterialDataUpdater mMaterialDataUpdater;
+		DynamicAABBTree mSpatialIndex;
+		std::unordered_map<const Vob*, int32_t> mSpatialProxies;
+		// probe positions; margin 0 for exact nearest neighbour queries
+		DynamicAABBTree mProbeIndex;
+		std::unordered_map<const Vob*, int32_t> mProbeProxies;
 		VobStore mVobStore;
 		mutable std::recursive_mutex mMutex;
 		AABB mBoundingBox;
 		bool mHasChanged;
 	};
-}
\ No newline at end of file
+}
+
+template<class Callback>
+void nex::Scene::queryAABBUnsafe(const AABB& box, Callback&& callback) const
+{
+	mSpatialIndex.queryAABB(box, [&](int32_t proxy) {
+		callback(static_cast<Vob*>(mSpatialIndex.getUserData(proxy)));
+	});
+}
+
+template<class Callback>
+void nex::Scene::queryFrustumUnsafe(const Frustum& frustum, Callback&& callback) const
+{
+	mSpatialIndex.queryFrustum(frustum, [&](int32_t proxy) {
+		callback(static_cast<Vob*>(mSpatialIndex.getUserData(proxy)));
+	});
+}
+
+template<class Filter>
+void nex::Scene::queryNearestProbesUnsafe(const glm::vec3& position, size_t k, Filter&& filter, std::vector<ProbeVob*>& result) const
+{
+	std::vector<int32_t> proxies;
+	mProbeIndex.queryNearest(position, k, [&](int32_t proxy) {
+		return filter(static_cast<ProbeVob*>(mProbeIndex.getUserData(proxy)));
+	}, proxies);
+
+	result.clear();
+	for (auto proxy : proxies) {
+		result.push_back(static_cast<ProbeVob*>(mProbeIndex.getUserData(proxy)));
+	}
+}
+
+template<class Callback>
+void nex::Scene::queryRayUnsafe(const Ray& ray, float maxMultiplier, Callback&& callback) const
+{
+	mSpatialIndex.queryRay(ray, maxMultiplier, [&](int32_t proxy) {
+		callback(static_cast<Vob*>(mSpatialIndex.getUserData(proxy)));
+	});
+}
+
+template<class Callback>
+void nex::Scene::querySphereUnsafe(const Sphere& sphere, Callback&& callback) const
+{
+	mSpatialIndex.querySphere(sphere, [&](int32_t proxy) {
+		callback(static_cast<Vob*>(mSpatialIndex.getUserData(proxy)));
+	});
+}
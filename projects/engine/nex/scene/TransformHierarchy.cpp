@@ -0,0 +1,325 @@
+#include <nex/scene/TransformHierarchy.hpp>
+#include <nex/scene/Vob.hpp>
+#include <nex/util/Profiler.hpp>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define NEX_TRANSFORM_HIERARCHY_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+	/**
+	 * result = a * b
+	 * Note: result mustn't alias a or b.
+	 */
+	inline void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& result)
+	{
+#ifdef NEX_TRANSFORM_HIERARCHY_SSE
+		const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+		const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+		const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+		const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+		for (int i = 0; i < 4; ++i) {
+			const float* column = &b[i][0];
+			__m128 r = _mm_mul_ps(a0, _mm_set1_ps(column[0]));
+			r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(column[1])));
+			r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(column[2])));
+			r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(column[3])));
+			_mm_storeu_ps(&result[i][0], r);
+		}
+#else
+		result = a * b;
+#endif
+	}
+
+	/**
+	 * Transforms a bounding box by using its center/extent representation (same result as transforming all 8 corners).
+	 */
+	inline void transform(const glm::mat4& trafo, const nex::AABB& box, nex::AABB& result)
+	{
+		//just return the input if the bounding box isn't valid
+		if (!box.isValid()) {
+			result = box;
+			return;
+		}
+
+		const auto center = (box.max + box.min) * 0.5f;
+		const auto extent = (box.max - box.min) * 0.5f;
+
+#ifdef NEX_TRANSFORM_HIERARCHY_SSE
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		const __m128 c0 = _mm_loadu_ps(&trafo[0][0]);
+		const __m128 c1 = _mm_loadu_ps(&trafo[1][0]);
+		const __m128 c2 = _mm_loadu_ps(&trafo[2][0]);
+		const __m128 c3 = _mm_loadu_ps(&trafo[3][0]);
+
+		__m128 newCenter = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(center.x)));
+		newCenter = _mm_add_ps(newCenter, _mm_mul_ps(c1, _mm_set1_ps(center.y)));
+		newCenter = _mm_add_ps(newCenter, _mm_mul_ps(c2, _mm_set1_ps(center.z)));
+
+		__m128 newExtent = _mm_mul_ps(_mm_andnot_ps(signMask, c0), _mm_set1_ps(extent.x));
+		newExtent = _mm_add_ps(newExtent, _mm_mul_ps(_mm_andnot_ps(signMask, c1), _mm_set1_ps(extent.y)));
+		newExtent = _mm_add_ps(newExtent, _mm_mul_ps(_mm_andnot_ps(signMask, c2), _mm_set1_ps(extent.z)));
+
+		float min[4];
+		float max[4];
+		_mm_storeu_ps(min, _mm_sub_ps(newCenter, newExtent));
+		_mm_storeu_ps(max, _mm_add_ps(newCenter, newExtent));
+		result.min = glm::vec3(min[0], min[1], min[2]);
+		result.max = glm::vec3(max[0], max[1], max[2]);
+#else
+		const glm::mat3 absRotScale(glm::abs(glm::vec3(trafo[0])), glm::abs(glm::vec3(trafo[1])), glm::abs(glm::vec3(trafo[2])));
+		const auto newCenter = glm::vec3(trafo * glm::vec4(center, 1.0f));
+		const auto newExtent = absRotScale * extent;
+		result.min = newCenter - newExtent;
+		result.max = newCenter + newExtent;
+#endif
+	}
+}
+
+nex::TransformHierarchy::TransformHierarchy() : mAnyDirty(false), mNeedsRebuild(true), mStructureVersion(0)
+{
+}
+
+nex::TransformHierarchy::~TransformHierarchy()
+{
+	for (auto* vob : mVobs) {
+		if (vob) vob->mTransformHierarchy = nullptr;
+	}
+}
+
+void nex::TransformHierarchy::detach(Vob* vob)
+{
+	if (vob->mTransformHierarchy != this) return;
+	mVobs[vob->mTransformIndex] = nullptr;
+	vob->mTransformHierarchy = nullptr;
+	mNeedsRebuild = true;
+	++mStructureVersion;
+}
+
+const std::vector<nex::Vob*>& nex::TransformHierarchy::getBoundsChangedVobs() const
+{
+	return mBoundsChanged;
+}
+
+const nex::TransformHierarchy::Stats& nex::TransformHierarchy::getStats() const
+{
+	return mStats;
+}
+
+uint64_t nex::TransformHierarchy::getStructureVersion() const
+{
+	return mStructureVersion;
+}
+
+void nex::TransformHierarchy::invalidate()
+{
+	mNeedsRebuild = true;
+	++mStructureVersion;
+}
+
+void nex::TransformHierarchy::markDirty(uint32_t index)
+{
+	mDirty[index] = 1;
+	mAnyDirty.store(true, std::memory_order_relaxed);
+}
+
+void nex::TransformHierarchy::update(const std::vector<Vob*>& roots, bool resetPrevTrafos)
+{
+	NEX_PROFILE_SCOPE("TransformHierarchy::update");
+
+	mStats.rebuilt = false;
+	mStats.updatedCount = 0;
+	mBoundsChanged.clear();
+
+	std::swap(mUpdatedBefore, mUpdatedLastTime);
+	mUpdatedLastTime.clear();
+
+	if (mNeedsRebuild) {
+		// node indices get invalid
+		resetUnmovedPrevTrafos();
+		rebuild(roots);
+		mStats.rebuilt = true;
+	}
+
+	mStats.nodeCount = mVobs.size();
+	mStats.levelCount = mLevelOffsets.size() - 1;
+
+	if (mAnyDirty.exchange(false, std::memory_order_relaxed)) {
+		const auto levelCount = mStats.levelCount;
+
+		// top down: world transformations; the vob of a node is touched only once
+		for (size_t level = 0; level < levelCount; ++level) {
+			for (auto i = mLevelOffsets[level]; i < mLevelOffsets[level + 1]; ++i) {
+				const auto parent = mParents[i];
+
+				if (mDirty[i]) {
+					syncLocal(i);
+					mDirty[i] = 0;
+					mUpdated[i] = 1;
+				}
+				else if (parent >= 0 && mUpdated[parent]) {
+					mUpdated[i] = 1;
+				}
+
+				if (mUpdated[i]) updateNode(i);
+			}
+		}
+
+		// bottom up: bounding boxes of the subtrees (leaves are done by updateNode)
+		for (size_t level = levelCount; level-- > 0;) {
+			for (auto i = mLevelOffsets[level]; i < mLevelOffsets[level + 1]; ++i) {
+				if (mChildCount[i] == 0 || (!mUpdated[i] && !mBoundsDirty[i])) continue;
+
+				auto box = mBoundsWorld[i];
+				const auto childEnd = mFirstChild[i] + mChildCount[i];
+				for (auto child = mFirstChild[i]; child < childEnd; ++child) {
+					box = maxAABB(box, mBoundsSubtree[child]);
+				}
+				mBoundsSubtree[i] = box;
+				mBoundsDirty[i] = 0;
+
+				auto* vob = mVobs[i];
+				vob->mBoundingBoxWorld = box;
+				mBoundsChanged.push_back(vob);
+
+				const auto parent = mParents[i];
+				if (parent >= 0) mBoundsDirty[parent] = 1;
+			}
+		}
+	}
+
+	resetUnmovedPrevTrafos();
+
+	for (auto index : mUpdatedLastTime) {
+		// the movement of this update shouldn't be visible (e.g. the vobs have just been placed)
+		if (resetPrevTrafos) {
+			auto* vob = mVobs[index];
+			vob->mTrafoPrevMeshToWorld = vob->mTrafoMeshToWorld;
+		}
+
+		mUpdated[index] = 0;
+	}
+
+	mStats.updatedCount = mUpdatedLastTime.size();
+}
+
+void nex::TransformHierarchy::rebuild(const std::vector<Vob*>& roots)
+{
+	for (auto* vob : mVobs) {
+		if (vob) vob->mTransformHierarchy = nullptr;
+	}
+
+	mVobs.clear();
+	mParents.clear();
+	mFirstChild.clear();
+	mChildCount.clear();
+	mLevelOffsets.clear();
+
+	auto addNode = [&](Vob* vob, int32_t parent) {
+		// guard against vobs that are referenced more than once
+		if (vob->mTransformHierarchy == this) return;
+		vob->mTransformHierarchy = this;
+		vob->mTransformIndex = static_cast<uint32_t>(mVobs.size());
+		mVobs.push_back(vob);
+		mParents.push_back(parent);
+	};
+
+	for (auto* root : roots) {
+		if (root) addNode(root, -1);
+	}
+
+	// breadth first, so that the nodes are sorted by depth and children of a node are stored contiguously
+	mLevelOffsets.push_back(0);
+	size_t levelBegin = 0;
+
+	while (levelBegin < mVobs.size()) {
+		const auto levelEnd = mVobs.size();
+		mLevelOffsets.push_back(static_cast<uint32_t>(levelEnd));
+		mFirstChild.resize(levelEnd);
+		mChildCount.resize(levelEnd);
+
+		for (auto i = levelBegin; i < levelEnd; ++i) {
+			const auto firstChild = mVobs.size();
+			mFirstChild[i] = static_cast<uint32_t>(firstChild);
+
+			for (auto& child : mVobs[i]->getChildren()) {
+				addNode(child.get(), static_cast<int32_t>(i));
+			}
+
+			mChildCount[i] = static_cast<uint32_t>(mVobs.size() - firstChild);
+		}
+
+		levelBegin = levelEnd;
+	}
+
+	const auto count = mVobs.size();
+	mLocalToParent.resize(count);
+	mMeshToLocal.resize(count);
+	mLocalToWorld.resize(count);
+	mBoundsLocal.resize(count);
+	mBoundsWorld.resize(count);
+	mBoundsSubtree.resize(count);
+	mDirty.assign(count, 1);
+	mUpdated.assign(count, 0);
+	mBoundsDirty.assign(count, 0);
+
+	mAnyDirty.store(count > 0, std::memory_order_relaxed);
+	mNeedsRebuild = false;
+}
+
+void nex::TransformHierarchy::syncLocal(uint32_t index)
+{
+	auto* vob = mVobs[index];
+	vob->mLocalToParentSpace.update();
+	mLocalToParent[index] = vob->mTrafoBeforeLocalAnimationToLocal * vob->mLocalToParentSpace.getTrafo();
+
+	// Note: might update the mesh to local trafo, too (e.g. OceanVob)
+	vob->recalculateLocalBoundingBox();
+	mMeshToLocal[index] = vob->mTrafoMeshToLocal;
+	mBoundsLocal[index] = vob->mBoundingBoxLocal;
+}
+
+void nex::TransformHierarchy::updateNode(uint32_t index)
+{
+	const auto parent = mParents[index];
+
+	if (parent >= 0) {
+		multiply(mLocalToWorld[parent], mLocalToParent[index], mLocalToWorld[index]);
+	}
+	else {
+		mLocalToWorld[index] = mLocalToParent[index];
+	}
+
+	transform(mLocalToWorld[index], mBoundsLocal[index], mBoundsWorld[index]);
+
+	auto* vob = mVobs[index];
+	vob->mTrafoPrevMeshToWorld = vob->mTrafoMeshToWorld;
+	vob->mTrafoLocalToWorld = mLocalToWorld[index];
+	multiply(mLocalToWorld[index], mMeshToLocal[index], vob->mTrafoMeshToWorld);
+
+	// the subtree of a leaf is complete, so its bounding box is written while the vob is still in the cache
+	if (mChildCount[index] == 0) {
+		mBoundsSubtree[index] = mBoundsWorld[index];
+		vob->mBoundingBoxWorld = mBoundsWorld[index];
+		mBoundsChanged.push_back(vob);
+		if (parent >= 0) mBoundsDirty[parent] = 1;
+	}
+
+	mUpdatedLastTime.push_back(index);
+}
+
+void nex::TransformHierarchy::resetUnmovedPrevTrafos()
+{
+	// Nodes that have been updated the time before didn't move since then, if they aren't updated again.
+	for (auto index : mUpdatedBefore) {
+		if (mUpdated[index]) continue;
+		if (auto* vob = mVobs[index]) {
+			vob->mTrafoPrevMeshToWorld = vob->mTrafoMeshToWorld;
+		}
+	}
+
+	mUpdatedBefore.clear();
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <nex/math/BoundingBox.hpp>
+
+namespace nex
+{
+	class Vob;
+
+	/**
+	 * Computes the world transformations and world bounding boxes of vob trees.
+	 *
+	 * The node data is kept in parallel arrays (one array per attribute), sorted by depth (breadth first), so that
+	 * parents always precede their children and a single pass over the arrays visits the nodes top down.
+	 * Only nodes that have been marked dirty (see Vob::markTrafoDirty) and their descendants are updated; bounding boxes
+	 * are propagated up to the roots. If nothing is dirty, an update costs nearly nothing.
+	 * Nodes are processed one at a time; SSE is only used within a node (matrix product and bounding box transform).
+	 *
+	 * The results are written to the vobs while a node is processed, so that vob getters and render commands stay valid.
+	 */
+	class TransformHierarchy
+	{
+	public:
+
+		/**
+		 * Statistics of the last update.
+		 */
+		struct Stats {
+			size_t nodeCount = 0;
+			size_t levelCount = 0;
+			size_t updatedCount = 0; // nodes with recomputed world transformations
+			bool rebuilt = false;
+		};
+
+		TransformHierarchy();
+		~TransformHierarchy();
+
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+		/**
+		 * Removes a vob from the hierarchy. The hierarchy gets rebuilt on the next update.
+		 */
+		void detach(Vob* vob);
+
+		/**
+		 * Provides the vobs whose world bounding box has been recalculated by the last update.
+		 */
+		const std::vector<Vob*>& getBoundsChangedVobs() const;
+
+		const Stats& getStats() const;
+
+		/**
+		 * Provides a counter that is incremented whenever the tree structure changes (see invalidate and detach).
+		 * Can be used to find out whether data derived from the tree structure is outdated.
+		 */
+		uint64_t getStructureVersion() const;
+
+		/**
+		 * Notifies that the tree structure has changed (vobs added/removed, parent changes).
+		 * The hierarchy gets rebuilt on the next update.
+		 */
+		void invalidate();
+
+		/**
+		 * Marks the local data (transformation, bounding box) of a node as changed.
+		 * Nodes can be marked concurrently by different threads, but not while update is executed.
+		 */
+		void markDirty(uint32_t index);
+
+		/**
+		 * Updates all dirty nodes and their descendants.
+		 * @param roots : The root vobs of the trees. Only used if the hierarchy has to be rebuilt.
+		 * @param resetPrevTrafos : If true, the previous mesh to world transformations of the updated nodes are set to
+		 * the new ones, so that the movement of this update produces no motion vectors (e.g. for placed or teleported vobs).
+		 */
+		void update(const std::vector<Vob*>& roots, bool resetPrevTrafos = false);
+
+	private:
+
+		void rebuild(const std::vector<Vob*>& roots);
+
+		/**
+		 * Fetches the local transformation and bounding box of a node from its vob.
+		 */
+		void syncLocal(uint32_t index);
+
+		/**
+		 * Calculates the world transformation and bounding box of a node and writes them to its vob.
+		 * The parent has to be updated before.
+		 */
+		void updateNode(uint32_t index);
+
+		/**
+		 * Sets the previous mesh to world transformation of the nodes updated the time before to the current one,
+		 * if they haven't been updated again.
+		 */
+		void resetUnmovedPrevTrafos();
+
+		// node data
+		std::vector<Vob*> mVobs;
+		std::vector<int32_t> mParents; // -1 for roots
+		std::vector<uint32_t> mFirstChild;
+		std::vector<uint32_t> mChildCount;
+		std::vector<glm::mat4> mLocalToParent;
+		std::vector<glm::mat4> mMeshToLocal;
+		std::vector<glm::mat4> mLocalToWorld;
+		std::vector<AABB> mBoundsLocal;
+		std::vector<AABB> mBoundsWorld; // bounding box of the node itself
+		std::vector<AABB> mBoundsSubtree; // bounding box of the node and all its descendants
+		std::vector<uint8_t> mDirty;
+		std::vector<uint8_t> mUpdated;
+		std::vector<uint8_t> mBoundsDirty;
+
+		// nodes of depth level i are in range [mLevelOffsets[i], mLevelOffsets[i+1])
+		std::vector<uint32_t> mLevelOffsets;
+
+		std::vector<uint32_t> mUpdatedLastTime;
+		std::vector<uint32_t> mUpdatedBefore;
+		std::vector<Vob*> mBoundsChanged;
+
+		std::atomic<bool> mAnyDirty;
+		bool mNeedsRebuild;
+		uint64_t mStructureVersion;
+		Stats mStats;
+	};
+}
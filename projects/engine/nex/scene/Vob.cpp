@@ -12,6 +12,10 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/matrix_interpolation.hpp>
 #include <nex/scene/VobBluePrint.hpp>
+#include <nex/scene/TransformHierarchy.hpp>
+#include <nex/renderer/MaterialDataUpdater.hpp>
+#include <nex/util/FrameArena.hpp>
+#include <typeinfo>
 
 namespace nex
 {
@@ -29,12 +33,17 @@ namespace nex
 	{
 	}
 
-	Vob::~Vob() = default;
+	Vob::~Vob()
+	{
+		if (mTransformHierarchy) mTransformHierarchy->detach(this);
+		if (mMaterialDataUpdater) mMaterialDataUpdater->detach(this);
+	}
 
 	void Vob::addChild(ChildPtr child)
 	{
 		child->setParent(this);
 		mChildren.emplace_back(std::move(child));
+		if (mTransformHierarchy) mTransformHierarchy->invalidate();
 	}
 
 	void Vob::applyTrafoLocalToWorld(const glm::mat4& trafoLocalToWorld, const glm::vec3& origin)
@@ -57,6 +66,7 @@ namespace nex
 	{
 		mLocalToParentSpace.setShear(glm::vec3(0.0f));
 		mLocalToParentSpace.update();
+		markTrafoDirty();
 	}
 
 	void Vob::collectRenderCommands(RenderCommandQueue& queue, bool doCulling, const RenderContext& renderContext) const
@@ -85,18 +95,21 @@ namespace nex
 
 	nex::Vob::ChildPtr Vob::removeChild(Vob* child)
 	{
-		auto it = std::remove_if(mChildren.begin(), mChildren.end(), [child](const Vob::ChildPtr& current) 
+		auto it = std::find_if(mChildren.begin(), mChildren.end(), [child](const Vob::ChildPtr& current) 
 		{
 			return current.get() == child;
 		});
 
 		ChildPtr managedChild;
 
+		// Note: std::remove_if mustn't be used: Moving a flexible_ptr over the removed one destroys the child, 
+		// and the removed element is left in a moved-from state.
 		if (it != mChildren.end()) {
-			managedChild = *it;
+			managedChild = std::move(*it);
+			mChildren.erase(it);
 		}
 
-		mChildren.erase(it, mChildren.end());
+		if (mTransformHierarchy) mTransformHierarchy->invalidate();
 
 		return managedChild;
 	}
@@ -115,13 +128,61 @@ namespace nex
 		}
 	}
 
+	std::function<bool()> Vob::createStepwiseMeshFinalizer()
+	{
+		struct State {
+			std::vector<MeshGroup*> groups;
+			size_t groupIndex = 0;
+			size_t meshIndex = 0;
+		};
+
+		auto state = std::make_shared<State>();
+
+		std::vector<Vob*> queue;
+		queue.push_back(this);
+
+		while (!queue.empty()) {
+			auto* vob = queue.back();
+			queue.pop_back();
+
+			if (auto* group = vob->getMeshGroup()) {
+				state->groups.push_back(group);
+			}
+
+			for (auto& child : vob->getChildren()) {
+				queue.push_back(child.get());
+			}
+		}
+
+		return [state]() {
+			while (state->groupIndex < state->groups.size()) {
+				auto* group = state->groups[state->groupIndex];
+				const auto& meshes = group->getEntries();
+
+				if (state->meshIndex < meshes.size()) {
+					meshes[state->meshIndex]->finalize();
+					++state->meshIndex;
+					return false;
+				}
+
+				// all meshes are finalized; the group's finalize only sets its state now.
+				group->finalize();
+				++state->groupIndex;
+				state->meshIndex = 0;
+			}
+
+			return true;
+		};
+	}
+
 	void Vob::frameUpdate(const RenderContext& constants)
 	{
 
 		if (mAnimateRotationYAxis) {
 			auto rotationFactor = constants.frameTime * glm::radians(45.0f);
 			rotateGlobal(glm::vec3(0, 1, 0), rotationFactor);
-			updateTrafo();
+			// Note: Managed vobs are updated by the transform hierarchy of the scene
+			if (!mTransformHierarchy) updateTrafo();
 		}
 
 		// update key frame animation
@@ -133,14 +194,14 @@ namespace nex
 		}
 
 		const auto channelCount = ani->getChannelCount();
-		std::vector<glm::mat4> trafos;
-		ani->calcChannelTrafos(mActiveKeyFrameAniData.time, trafos);
+		FrameVector<glm::mat4> trafos(channelCount);
+		ani->calcChannelTrafos(mActiveKeyFrameAniData.time, trafos.data());
 
 		const auto& mapping = mBluePrint->getMapping();
 		const auto& usedChannelIds = ani->getUsedChannelIDs();
 		const auto& inverseLocalToParentTrafos = mBluePrint->getInverseLocalToParentTrafos();
 
-		std::queue<nex::Vob*> queue;
+		FrameQueue<nex::Vob*> queue;
 		queue.push(this);
 		while (!queue.empty()) {
 			auto* vob = queue.front();
@@ -178,7 +239,13 @@ namespace nex
 			}
 		}
 
-		updateTrafo();
+		if (!mTransformHierarchy) updateTrafo();
+	}
+
+	bool Vob::isParallelUpdateSafe() const
+	{
+		// Subclasses can change the update behaviour, so they have to opt in on their own.
+		return typeid(*this) == typeid(Vob);
 	}
 
 	const nex::VobBluePrint* Vob::getBluePrint() const
@@ -330,6 +397,16 @@ namespace nex
 		return false;
 	}
 
+	void Vob::markTrafoDirty()
+	{
+		if (mTransformHierarchy) mTransformHierarchy->markDirty(mTransformIndex);
+	}
+
+	void Vob::markPerObjectMaterialDataDirty()
+	{
+		if (mMaterialDataUpdater) mMaterialDataUpdater->markDirty(this);
+	}
+
 	bool Vob::isDeletable() const
 	{
 		return mIsDeletable;
@@ -360,6 +437,7 @@ namespace nex
 		auto rotation = mLocalToParentSpace.getRotation();
 		rotation = glm::normalize(glm::rotate(rotation, angle, inverse(rotation) * axisWorld));
 		mLocalToParentSpace.setRotation(rotation);
+		markTrafoDirty();
 	}
 
 	void Vob::rotateGlobal(const glm::vec3& eulerAngles)
@@ -369,6 +447,7 @@ namespace nex
 		rotation = glm::normalize(glm::rotate(rotation, eulerAngles.y, inverse(rotation) * glm::vec3(0, 1, 0)));
 		rotation = glm::normalize(glm::rotate(rotation, eulerAngles.z, inverse(rotation) * glm::vec3(0, 0, 1.0f)));
 		mLocalToParentSpace.setRotation(rotation);
+		markTrafoDirty();
 	}
 
 	void Vob::rotateLocal(const glm::vec3& eulerAngles)
@@ -431,6 +510,7 @@ namespace nex
 	void Vob::setAnimationTrafo(const glm::mat4& trafo)
 	{
 		mTrafoBeforeLocalAnimationToLocal = trafo;
+		markTrafoDirty();
 	}
 
 	void Vob::setBluePrint(const nex::VobBluePrint* bluePrint)
@@ -442,6 +522,7 @@ namespace nex
 	{
 		mMeshGroup = std::move(meshGroup);
 		recalculateLocalBoundingBox();
+		markTrafoDirty();
 	}
 
 	void Vob::setDeletable(bool deletable)
@@ -479,11 +560,13 @@ namespace nex
 	void Vob::setRotationLocalToParent(const glm::mat4& rotation)
 	{
 		mLocalToParentSpace.setRotation(glm::toQuat(rotation));
+		markTrafoDirty();
 	}
 
 	void Vob::setRotationLocalToParent(const glm::quat& rotation)
 	{
 		mLocalToParentSpace.setRotation(rotation);
+		markTrafoDirty();
 	}
 
 	void Vob::setRotationLocalToWorld(const glm::quat& rotation)
@@ -497,6 +580,7 @@ namespace nex
 	void Vob::setPositionLocalToParent(const glm::vec3& position)
 	{
 		mLocalToParentSpace.setPosition(position);
+		markTrafoDirty();
 	}
 
 	void Vob::setPositionLocalToWorld(const glm::vec3& position)
@@ -510,6 +594,7 @@ namespace nex
 	void Vob::setScaleLocalToParent(const glm::vec3& scale)
 	{
 		mLocalToParentSpace.setScale(scale);
+		markTrafoDirty();
 	}
 
 	void Vob::setScaleLocalToWorld(const glm::vec3& newScale, const glm::vec3& minOldScale)
@@ -543,11 +628,13 @@ namespace nex
 	void Vob::setTrafoLocalToParent(const glm::mat4& mat)
 	{
 		mLocalToParentSpace.setTrafo(mat);
+		markTrafoDirty();
 	}
 
 	void Vob::setTrafoMeshToLocal(const glm::mat4& mat)
 	{
 		mTrafoMeshToLocal = mat;
+		markTrafoDirty();
 	}
 
 	const PerObjectMaterialData& Vob::getPerObjectMaterialData() const
@@ -557,6 +644,7 @@ namespace nex
 
 	nex::PerObjectMaterialData& Vob::getPerObjectMaterialData()
 	{
+		markPerObjectMaterialDataDirty();
 		return mPerObjectMaterialData;
 	}
 
@@ -572,7 +660,9 @@ namespace nex
 
 	void Vob::usePerObjectMaterialData(bool val)
 	{
+		if (mUsesPerObjectMaterialData == val) return;
 		mUsesPerObjectMaterialData = val;
+		if (mMaterialDataUpdater) mMaterialDataUpdater->attach(this);
 	}
 
 	nex::Vob* Vob::getRoot() const
@@ -588,6 +678,7 @@ namespace nex
 	void Vob::setPerObjectMaterialData(const PerObjectMaterialData& data)
 	{
 		mPerObjectMaterialData = data;
+		markPerObjectMaterialDataDirty();
 	}
 
 	void Vob::setPerObjectMaterialDataID(unsigned id)
@@ -620,6 +711,7 @@ namespace nex
 	void Vob::recalculateBoundingBoxWorld()
 	{
 		recalculateLocalBoundingBox();
+		markTrafoDirty();
 		
 		mBoundingBoxWorld = mTrafoLocalToWorld * mBoundingBoxLocal;
 
@@ -669,6 +761,7 @@ namespace nex
 			mTrafoPrevMeshToWorld = mTrafoMeshToWorld;
 
 		mTrafoMeshToWorld = mTrafoLocalToWorld * mTrafoMeshToLocal;
+		markTrafoDirty();
 	}
 
 	void Vob::setRotationAnimationYAxis(bool rotate)
@@ -745,17 +838,17 @@ namespace nex
 		auto* batches = group->getBatches();
 		if (!batches) return;
 
+		// Note: queues using a bone palette move the bone transformations of visible commands to the palette
 		RenderCommand command;
+		command.isBoneAnimated = true;
+		command.bones = &mBoneTrafos;
+		command.boneBuffer = renderContext.boneTransformBuffer.get();
 
 		for (const auto& batch : *batches) {
 			command.batch = &batch;
 			command.worldTrafo = &mTrafoMeshToWorld;
 			command.prevWorldTrafo = &mTrafoPrevMeshToWorld;
 			command.boundingBox = &mBoundingBoxWorld;
-
-			command.isBoneAnimated = true;
-			command.bones = &mBoneTrafos;
-			command.boneBuffer = renderContext.boneTransformBuffer.get();
 			command.perObjectMaterialID = mPerObjectMaterialDataID;
 
 			queue.push(command, doCulling);
@@ -775,6 +868,11 @@ namespace nex
 		ani->applyParentHierarchyTrafos(mBoneTrafos);
 	}
 
+	bool RiggedVob::isParallelUpdateSafe() const
+	{
+		return typeid(*this) == typeid(RiggedVob);
+	}
+
 	const nex::BoneAnimation* RiggedVob::getActiveBoneAnimation() const
 	{
 		if (!mActiveBoneAnimationSID) return nullptr;
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <functional>
 #include <glm/glm.hpp>
 #include <nex/math/BoundingBox.hpp>
 #include <nex/common/FrameUpdateable.hpp>
@@ -22,6 +23,8 @@ namespace nex
 	class MeshBatch;
 	class Rig;
 	class BoneAnimation;
+	class TransformHierarchy;
+	class MaterialDataUpdater;
 	class VobBluePrint;
 
 	class Vob : public nex::RenderCommandFactory, public FrameUpdateable
@@ -48,8 +51,22 @@ namespace nex
 
 		void finalizeMeshes();
 
+		/**
+		 * Provides a function that finalizes the meshes of this vob and its children step by step (one mesh per call).
+		 * The function returns true, if all meshes are finalized.
+		 * Note: The vob hierarchy mustn't be changed until the finalization is completed.
+		 */
+		std::function<bool()> createStepwiseMeshFinalizer();
+
 		void frameUpdate(const RenderContext& constants) override;
 
+		/**
+		 * A vob only updates itself and its descendants (animations), so it can be updated in parallel to other vob trees.
+		 * Note: Only true for the classes that have been checked for it; derived classes are not safe unless they
+		 * override this function.
+		 */
+		bool isParallelUpdateSafe() const override;
+
 		/**
 		 * Removes a child by its pointer.
 		 * @return: the child. Managed pointer is null, if no child was found to remove
@@ -88,6 +105,11 @@ namespace nex
 		const Vob* getParent() const;
 
 		const PerObjectMaterialData& getPerObjectMaterialData() const;
+
+		/**
+		 * Note: Marks the per object material data as changed (see markPerObjectMaterialDataDirty).
+		 * Use the const version for read only access.
+		 */
 		PerObjectMaterialData& getPerObjectMaterialData();
 
 		unsigned getPerObjectMaterialDataID() const;
@@ -119,6 +141,20 @@ namespace nex
 		 */
 		bool hasChild(const Vob* vob) const;
 
+		/**
+		 * Notifies the transform hierarchy (if this vob is managed by one) that the local transformation or the local bounding box
+		 * has changed, so that the world transformation and bounding box get updated on the next hierarchy update.
+		 * Note: The setters of this class call this function automatically.
+		 */
+		void markTrafoDirty();
+
+		/**
+		 * Notifies the material data updater (if this vob is managed by one) that the per object material data has changed,
+		 * so that it gets uploaded on the next update.
+		 * Note: setPerObjectMaterialData and the non-const getPerObjectMaterialData call this function automatically.
+		 */
+		void markPerObjectMaterialDataDirty();
+
 		bool isDeletable() const;
 		bool isParentScaleInherited() const;
 		bool isRoot() const;
@@ -198,6 +234,8 @@ namespace nex
 	protected:
 		
 		friend VobBluePrint;
+		friend TransformHierarchy;
+		friend MaterialDataUpdater;
 
 
 		struct AnimationData {
@@ -240,7 +278,7 @@ namespace nex
 		bool mInheritParentScale;
 		bool mNoUpdate = false;
 
-		unsigned mPerObjectMaterialDataID;
+		unsigned mPerObjectMaterialDataID = 0;
 		PerObjectMaterialData mPerObjectMaterialData;
 		bool mUsesPerObjectMaterialData;
 
@@ -256,6 +294,13 @@ namespace nex
 		bool mIsVisible = true;
 
 		bool mAnimateRotationYAxis = false;
+
+		// The transform hierarchy managing this vob (can be nullptr)
+		TransformHierarchy* mTransformHierarchy = nullptr;
+		uint32_t mTransformIndex = 0;
+
+		// The material data updater managing the per object material data slot of this vob (can be nullptr)
+		MaterialDataUpdater* mMaterialDataUpdater = nullptr;
 	};
 
 
@@ -281,6 +326,11 @@ namespace nex
 
 		void frameUpdate(const RenderContext& constants) override;
 
+		/**
+		 * Besides its vob data a rigged vob only reads its bone animation, which is guarded by the animation manager.
+		 */
+		bool isParallelUpdateSafe() const override;
+
 		/**
 		 * Note: Result can be null, if no animation is active.
 		 */
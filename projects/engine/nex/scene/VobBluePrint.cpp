@@ -1,4 +1,5 @@
 #include <nex/scene/VobBluePrint.hpp>
+#include <nex/renderer/RenderEngine.hpp>
 
 nex::VobBluePrint::VobBluePrint(std::unique_ptr<Vob> bluePrint) : mVob(std::move(bluePrint))
 {
@@ -29,6 +30,30 @@ std::unique_ptr<nex::Vob> nex::VobBluePrint::createBluePrint() const
 	return copy;
 }
 
+nex::Future<void> nex::VobBluePrint::finalizeAsync(FinalizeScheduler::Priority priority)
+{
+	if (!mFinalizeSubmitted.exchange(true)) {
+		auto finalizeStep = mVob->createStepwiseMeshFinalizer();
+
+		RenderEngine::getFinalizeScheduler()->submitStepped([finalizeStep, promise = mFinalized]() mutable {
+			try {
+				if (!finalizeStep()) return false;
+				promise.set();
+			}
+			catch (const std::exception& e) {
+				// the promise has to get ready in any case, otherwise continuations of the future would wait forever
+				promise.set_exception(std::make_shared<std::runtime_error>(e.what()));
+			}
+			catch (...) {
+				promise.set_exception(std::make_shared<std::runtime_error>("Unknown exception while finalizing vob meshes"));
+			}
+			return true;
+		}, priority);
+	}
+
+	return mFinalized.get_future();
+}
+
 std::unique_ptr<nex::KeyFrameAnimation::ChannelIDGenerator> nex::VobBluePrint::createGenerator() const
 {
 	struct Generator : public nex::KeyFrameAnimation::ChannelIDGenerator {
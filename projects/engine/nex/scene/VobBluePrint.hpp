@@ -1,6 +1,9 @@
 #pragma once
 
 #include <nex/scene/Vob.hpp>
+#include <nex/common/Future.hpp>
+#include <nex/renderer/FinalizeScheduler.hpp>
+#include <atomic>
 
 
 namespace nex
@@ -22,9 +25,19 @@ namespace nex
 
 		/**
 		 * Creates a vob hierarchy using the blue-print. The resulting vob will be connected to this blue-print.
+		 * Note: The resulting vob shares the meshes of the blue-print. It mustn't be rendered (e.g. added to a scene)
+		 * before the meshes are finalized (see finalizeAsync).
 		 */
 		std::unique_ptr<Vob> createBluePrint() const;
 
+		/**
+		 * Finalizes the meshes of the blue-print step by step on the main thread (see FinalizeScheduler).
+		 * The finalization is submitted only by the first call; further calls just provide the status.
+		 * Thread safe.
+		 * @return a future that gets ready (on the main thread) after all meshes are finalized.
+		 */
+		Future<void> finalizeAsync(FinalizeScheduler::Priority priority = FinalizeScheduler::Priority::Normal);
+
 
 		/**
 		 * Creates a channel id generator needed for initializing a keyframe animation that should be usable by vobs of this blue-print.
@@ -82,6 +95,8 @@ namespace nex
 
 	private:
 		std::unique_ptr<Vob> mVob;
+		Promise<void> mFinalized;
+		std::atomic<bool> mFinalizeSubmitted = false;
 		std::unordered_map<nex::Sid, std::unique_ptr<KeyFrameAnimation>> mKeyFrameAnis;
 		std::vector<KeyFrameAnimation*> mKeyFrameAnisSorted;
 		nex::Sid mBluePrintRootNameSID;
@@ -1,5 +1,7 @@
 #include <nex/shader/Shader.hpp>
 #include <nex/buffer/ShaderBuffer.hpp>
+#include <nex/buffer/StreamingBuffer.hpp>
+#include <nex/anim/BonePalette.hpp>
 #include <nex/renderer/RenderBackend.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <nex/camera/Camera.hpp>
@@ -23,6 +25,16 @@ void nex::Shader::updateMaterial(const Material& material)
 {
 }
 
+bool nex::Shader::usesTransformInstanceData() const
+{
+	return false;
+}
+
+uint32_t nex::Shader::getSortID() const
+{
+	return mSortID.get();
+}
+
 void nex::Shader::bind()
 {
 	mProgram->bind();
@@ -33,6 +45,27 @@ void nex::Shader::bindBoneTrafoBuffer(ShaderBuffer* buffer) const
 	buffer->bindToTarget(DEFAULT_BONE_BUFFER_BINDING_POINT);
 }
 
+void nex::Shader::uploadBoneTrafos(const RenderContext& context, ShaderBuffer* buffer, const std::vector<glm::mat4>* bones) const
+{
+	auto* streamingBuffer = context.streamingBuffer.get();
+
+	if (!bones) {
+		context.bonePalette->bind(*streamingBuffer, DEFAULT_BONE_BUFFER_BINDING_POINT);
+		return;
+	}
+
+	const auto size = bones->size() * sizeof(glm::mat4);
+
+	if (streamingBuffer) {
+		const auto allocation = streamingBuffer->upload(bones->data(), size);
+		streamingBuffer->bindToTarget(allocation, StreamingBuffer::Target::SHADER_STORAGE_BUFFER, DEFAULT_BONE_BUFFER_BINDING_POINT);
+		return;
+	}
+
+	buffer->update(size, bones->data());
+	bindBoneTrafoBuffer(buffer);
+}
+
 nex::ShaderProgram* nex::Shader::getShader()
 {
 	return mProgram.get();
@@ -78,17 +111,68 @@ void nex::TransformShader::uploadTransformMatrices(
 	bind();
 	
 	auto& perObjectData = context.perObjectData;
+	auto& instanceData = context.instanceData;
+	const bool instanced = command.instanceWorldTrafos != nullptr;
+
+	if (instanced) instanceData.resize(command.instanceCount);
 
+	calcTransforms(mProjection, mView, mPrevViewProjection, command, perObjectData, instanceData.data());
+	uploadTransforms(context, perObjectData, instanceData.data(), instanced ? command.instanceCount : 0);
+}
+
+void nex::TransformShader::calcTransforms(const glm::mat4& projection,
+	const glm::mat4& view,
+	const glm::mat4& prevViewProjection,
+	const RenderCommand& command,
+	PerObjectData& perObjectData,
+	InstanceData* instances)
+{
 	perObjectData.model = *command.worldTrafo;
-	perObjectData.modelView = mView * perObjectData.model;
-	perObjectData.transform = mProjection * perObjectData.modelView;
-	perObjectData.prevTransform = mPrevViewProjection * (*command.prevWorldTrafo);
+	perObjectData.modelView = view * perObjectData.model;
+	perObjectData.transform = projection * perObjectData.modelView;
+	perObjectData.prevTransform = prevViewProjection * (*command.prevWorldTrafo);
 	perObjectData.normalMatrix = glm::inverseTranspose(perObjectData.modelView);
 	perObjectData.perObjectMaterialID = command.perObjectMaterialID;
+	perObjectData.instanced = command.instanceWorldTrafos != nullptr;
+	perObjectData.boneOffset = command.boneOffset;
 	//perObjectData.normalMatrix = glm::inverseTranspose(perObjectData.model);
 
+	if (!perObjectData.instanced) return;
+
+	for (size_t i = 0; i < command.instanceCount; ++i) {
+		auto& instance = instances[i];
+		instance.model = command.instanceWorldTrafos[i];
+		instance.modelView = view * instance.model;
+		instance.transform = projection * instance.modelView;
+		instance.prevTransform = prevViewProjection * command.instancePrevWorldTrafos[i];
+		instance.normalMatrix = glm::inverseTranspose(instance.modelView);
+		instance.boneOffset = command.instanceBoneOffsets ? command.instanceBoneOffsets[i] : command.boneOffset;
+	}
+}
+
+void nex::TransformShader::uploadTransforms(const RenderContext& context,
+	const PerObjectData& perObjectData,
+	const InstanceData* instances,
+	size_t instanceCount)
+{
+	if (auto* streamingBuffer = context.streamingBuffer.get()) {
+		const auto perObjectAllocation = streamingBuffer->upload(&perObjectData, sizeof(PerObjectData));
+		streamingBuffer->bindToTarget(perObjectAllocation, StreamingBuffer::Target::UNIFORM_BUFFER, OBJECT_SHADER_UNIFORM_BUFFER_BINDING_POINT);
+
+		if (instanceCount == 0) return;
+
+		const auto instanceAllocation = streamingBuffer->upload(instances, instanceCount * sizeof(InstanceData));
+		streamingBuffer->bindToTarget(instanceAllocation, StreamingBuffer::Target::SHADER_STORAGE_BUFFER, INSTANCE_DATA_BUFFER_BINDING_POINT);
+		return;
+	}
+
 	context.perObjectDataBuffer->resize(sizeof(PerObjectData), &perObjectData, nex::GpuBuffer::UsageHint::STREAM_DRAW); //nex::GpuBuffer::UsageHint::STREAM_DRAW
 	context.perObjectDataBuffer->bindToTarget();
+
+	if (instanceCount == 0) return;
+
+	context.instanceDataBuffer->resize(instanceCount * sizeof(InstanceData), instances, nex::GpuBuffer::UsageHint::STREAM_DRAW);
+	context.instanceDataBuffer->bindToTarget();
 }
 
 void nex::TransformShader::updateConstants(const nex::RenderContext& constants)
@@ -102,6 +186,11 @@ void nex::TransformShader::updateInstance(const RenderContext& constants, const
 	uploadTransformMatrices(constants, command);
 }
 
+bool nex::TransformShader::usesTransformInstanceData() const
+{
+	return true;
+}
+
 nex::SimpleTransformShader::SimpleTransformShader(std::unique_ptr<ShaderProgram> program, unsigned transformLocation) : Shader(std::move(program)), mTransformLocation(transformLocation)
 {
 }
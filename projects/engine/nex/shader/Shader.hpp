@@ -2,6 +2,7 @@
 #include <nex/shader/ShaderProgram.hpp>
 #include <nex/buffer/ShaderBuffer.hpp>
 #include <nex/renderer/RenderContext.hpp>
+#include <nex/util/SortID.hpp>
 #include <interface/buffers.h>
 
 namespace nex
@@ -39,6 +40,13 @@ namespace nex
 
 		virtual void bindBoneTrafoBuffer(ShaderBuffer* buffer) const;
 
+		/**
+		 * Uploads bone transformations and binds them to the bone buffer binding point.
+		 * If bones is null, the bone palette of the render context is bound instead.
+		 * Uses the streaming buffer of the render context, if available, otherwise the given buffer is updated.
+		 */
+		void uploadBoneTrafos(const RenderContext& context, ShaderBuffer* buffer, const std::vector<glm::mat4>* bones) const;
+
 		ShaderProgram* getShader();
 
 		/**
@@ -71,9 +79,22 @@ namespace nex
 		 */
 		virtual void updateMaterial(const Material& material);
 
+		/**
+		 * Checks, if updateInstance only uploads the transform data of a TransformShader.
+		 * The transform data of such shaders can be calculated while recording render commands on worker threads
+		 * (see RenderCommandBuffer). Shaders overriding updateInstance must return false.
+		 */
+		virtual bool usesTransformInstanceData() const;
+
+		/**
+		 * Provides a small id of this shader for sort keys (see SortID).
+		 */
+		uint32_t getSortID() const;
+
 	protected:
 
 		std::unique_ptr<ShaderProgram> mProgram;
+		SortID<Shader> mSortID;
 	};
 
 	/**
@@ -102,6 +123,29 @@ namespace nex
 			const RenderCommand& command,
 			const void* data = nullptr) override;
 
+		bool usesTransformInstanceData() const override;
+
+		/**
+		 * Calculates the per object data (and the instance data for instanced commands) of a render command.
+		 * Doesn't access any shader state, so it can be called from any thread.
+		 * @param instances : Has to provide space for command.instanceCount elements if the command uses instancing.
+		 */
+		static void calcTransforms(const glm::mat4& projection,
+			const glm::mat4& view,
+			const glm::mat4& prevViewProjection,
+			const RenderCommand& command,
+			PerObjectData& perObjectData,
+			InstanceData* instances);
+
+		/**
+		 * Uploads per object data (and optional instance data) to the buffers of the render context and binds them.
+		 * Uses the streaming buffer of the render context, if available.
+		 */
+		static void uploadTransforms(const RenderContext& context,
+			const PerObjectData& perObjectData,
+			const InstanceData* instances,
+			size_t instanceCount);
+
 	protected:
 
 		/**
@@ -707,11 +707,19 @@ void nex::CascadedShadow::render(const nex::RenderCommandQueue::Buffer& shadowCo
 
 	const auto& state = RenderState::getDefault();
 
+	// Note: The cascades are only known on the cpu, if they aren't computed by the gpu (tight near far planes)
+	const bool cullCommands = !mUseTightNearFarPlane;
+	if (cullCommands) cullCascadeCommands(shadowCommands);
+	mCascadeCommandCounts.resize(mNumCascades);
+
 	for (unsigned i = 0; i < mNumCascades; ++i)
 	{
 		begin(i);
+
+		const auto& commands = cullCommands ? mCascadeCommands[i] : shadowCommands;
+		mCascadeCommandCounts[i] = commands.size();
 		
-		Drawer::draw(shadowCommands, constants, overrides, &state);
+		Drawer::draw(commands, constants, overrides, &state);
 		/*for (const auto& command : shadowCommands)
 		{
 			mDepthPass->setModelMatrix(*command.worldTrafo, *command.prevWorldTrafo);
@@ -725,6 +733,44 @@ void nex::CascadedShadow::render(const nex::RenderCommandQueue::Buffer& shadowCo
 	}
 }
 
+size_t nex::CascadedShadow::getCascadeCommandCount(unsigned cascadeIndex) const
+{
+	if (cascadeIndex >= mCascadeCommandCounts.size()) return 0;
+	return mCascadeCommandCounts[cascadeIndex];
+}
+
+void nex::CascadedShadow::cullCascadeCommands(const nex::RenderCommandQueue::Buffer& shadowCommands)
+{
+	mCasterBoxes.clear();
+	for (const auto& command : shadowCommands) {
+		if (command.boundingBox) mCasterBoxes.push(*command.boundingBox);
+	}
+
+	mCasterVisibility.resize(BatchCuller::getMaskWordCount(mCasterBoxes.size()));
+	mCascadeCommands.resize(mNumCascades);
+
+	for (unsigned cascade = 0; cascade < mNumCascades; ++cascade) {
+		// Note: Geometry outside of the clip space of a cascade isn't rasterized, so culling against it is conservative.
+		const auto frustum = extractFrustum(mCascadeData.lightViewProjectionMatrices[cascade]);
+		BatchCuller::cullFrustum(frustum, mCasterBoxes, mCasterVisibility.data());
+
+		auto& commands = mCascadeCommands[cascade];
+		commands.clear();
+		size_t boxIndex = 0;
+
+		for (const auto& command : shadowCommands) {
+			// commands without bounding box cannot be culled
+			if (!command.boundingBox) {
+				commands.emplace_back(command);
+				continue;
+			}
+
+			if (mCasterVisibility[boxIndex / 32] & (1u << (boxIndex % 32))) commands.emplace_back(command);
+			++boxIndex;
+		}
+	}
+}
+
 void CascadedShadow::setAntiFlickering(bool enable)
 {
 	mAntiFlickerOn = enable;
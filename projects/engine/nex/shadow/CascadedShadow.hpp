@@ -6,6 +6,7 @@
 #include <nex/buffer/ShaderBuffer.hpp>
 #include <nex/shader/Shader.hpp>
 #include <nex/gui/TextureView.hpp>
+#include <nex/renderer/BatchCuller.hpp>
 #include <nex/renderer/RenderCommandQueue.hpp>
 #include <nex/shadow/ShadowCommon.hpp>
 #include <nex/util/CallbackContainer.hpp>
@@ -150,9 +151,20 @@ namespace nex
 
 		void frameReset();
 
+		/**
+		 * Renders shadow casting commands into the cascades.
+		 * If the cascades are calculated on the cpu (no tight near far planes), each cascade only renders the
+		 * commands intersecting the cascade.
+		 * Note: frameUpdate has to be called before.
+		 */
 		void render(const nex::RenderCommandQueue::Buffer& shadowCommands,
 			const RenderContext& constants);
 
+		/**
+		 * Provides the number of commands rendered into a cascade by the last render call.
+		 */
+		size_t getCascadeCommandCount(unsigned cascadeIndex) const;
+
 		void setAntiFlickering(bool enable);
 
 		void setBiasMultiplier(float bias, bool informObservers = true);
@@ -213,6 +225,11 @@ namespace nex
 
 		BoundingSphere extractFrustumBoundSphere(const Camera& camera, float nearSplitDistance, float farSplitDistance);
 
+		/**
+		 * Culls shadow casting commands against the cascades.
+		 */
+		void cullCascadeCommands(const nex::RenderCommandQueue::Buffer& shadowCommands);
+
 		void updateTextureArray();
 
 		void frameUpdateTightNearFarPlane(const Camera& camera, const glm::vec3& lightDirection, nex::ShaderStorageBuffer* minMaxOutputBuffer);
@@ -245,6 +262,12 @@ namespace nex
 		bool mUseTightNearFarPlane;
 		bool mUseLogarithmicSplits;
 		bool mVisualizeCascades = false;
+
+		// per cascade culling of the shadow casters
+		std::vector<nex::RenderCommandQueue::Buffer> mCascadeCommands;
+		std::vector<size_t> mCascadeCommandCounts;
+		AABBBatch mCasterBoxes;
+		std::vector<uint32_t> mCasterVisibility;
 	};
 
 	class CascadedShadow_ConfigurationView : public nex::gui::Drawable {
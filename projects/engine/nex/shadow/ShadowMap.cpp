@@ -124,7 +124,7 @@ void nex::ShadowMap::render(const nex::RenderCommandQueue::Buffer& shadowCommand
 		mDepthPass->uploadTransformMatrices(myContext, command);
 
 		for (const auto& pair : command.batch->getEntries()) {
-			Drawer::draw(mDepthPass.get(), pair.first, nullptr);
+			Drawer::draw(mDepthPass.get(), pair.first, nullptr, nullptr, command.instanceCount);
 		}
 	}
 }
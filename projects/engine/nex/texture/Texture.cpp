@@ -0,0 +1,40 @@
+#include <nex/texture/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace glm;
+
+std::vector<glm::mat4> nex::CubeMap::mViewLookAts = {
+	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f)), // right
+	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(-1.0f, 0.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f)), // left
+	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f), vec3(0.0f, 0.0f, 1.0f)), // top
+	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f), vec3(0.0f, 0.0f, -1.0f)), // bottom
+	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, 0.0f, 1.0f), vec3(0.0f, -1.0f, 0.0f)), // front
+	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, 0.0f, -1.0f), vec3(0.0f, -1.0f, 0.0f)) // back
+};
+
+const mat4& nex::CubeMap::getViewLookAtMatrix(CubeMapSide side)
+{
+	return mViewLookAts[(unsigned)side];
+}
+
+const std::vector<glm::mat4>& nex::CubeMap::getViewLookAts()
+{
+	return mViewLookAts;
+}
+
+unsigned nex::Texture::getLevelZeroMipMapTextureSize()
+{
+	return std::max<unsigned>(getWidth(), getHeight());
+}
+
+unsigned nex::Texture::calcMipMapCount(unsigned levelZeroMipMapTextureSize)
+{
+	return std::log2<>(levelZeroMipMapTextureSize) + 1;
+}
+
+unsigned nex::CubeMapArray::getLayerFaceIndex(unsigned arrayIndex)
+{
+	return arrayIndex * 6;
+}
@@ -17,8 +17,17 @@
 
 namespace nex {
 
+	struct TextureManager::PrefetchedImage
+	{
+		StoreImage image;
+		size_t bytes;
+		// prefetch order; the oldest images are evicted first
+		unsigned long long sequence;
+	};
+
 
-	TextureManager::TextureManager() : m_logger("TextureManagerGL")
+	TextureManager::TextureManager() : m_logger("TextureManagerGL"),
+		mPrefetchedBytes(0), mPrefetchBudget(DEFAULT_PREFETCH_BUDGET), mPrefetchSequence(0)
 	{
 	}
 
@@ -146,6 +155,9 @@ namespace nex {
 		// Don't create duplicate textures!
 		if (it != textureLookupTable.end())
 		{
+			std::lock_guard<std::mutex> lock(mPrefetchMutex);
+			auto prefetched = mPrefetchedImages.find(resolvedPath);
+			if (prefetched != mPrefetchedImages.end()) removePrefetchedImageUnsafe(prefetched);
 			return it->second;
 		}
 
@@ -166,9 +178,23 @@ namespace nex {
 	{
 		StoreImage storeImage;
 
+		// Don't read the compiled image while a prefetch job writes it; the job provides the image anyway.
+		waitForPrefetch(mFileSystem->getCompiledPath(file).path);
+
+		if (!takePrefetchedImage(mFileSystem->resolvePath(file), storeImage)) {
+			storeImage = loadStoreImage(file, flipY, data, detectColorSpace);
+		}
+
+		return createTexture(storeImage, data, detectColorSpace);
+	}
+
+	StoreImage TextureManager::loadStoreImage(const std::filesystem::path& file, bool flipY, const nex::TextureDesc& data, bool detectColorSpace)
+	{
+		StoreImage storeImage;
+
 		std::filesystem::path compiledResource = mFileSystem->getCompiledPath(file).path;
 
-		if (std::filesystem::exists(compiledResource))
+		if (FileSystem::fileExists(compiledResource))
 		{
 			FileSystem::load(compiledResource, storeImage);
 
@@ -197,10 +223,88 @@ namespace nex {
 
 			loadTextureMeta(resolvedPath, storeImage);
 
-			FileSystem::store(compiledResource, storeImage);
+			FileSystem::store(compiledResource, storeImage, FileSystem::CompiledType::TEXTURE);
 		}
 
-		return createTexture(storeImage, data, detectColorSpace);
+		return storeImage;
+	}
+
+	StoreImage TextureManager::loadEmbeddedStoreImage(const std::filesystem::path& file, const unsigned char* data,
+		int dataSize, bool flipY, const nex::TextureDesc& desc, bool detectColorSpace)
+	{
+		StoreImage storeImage;
+		std::filesystem::path compiledResource = mFileSystem->getCompiledPath(file).path;
+		storeImage.mipmapCount = 1;
+		storeImage.images.resize(1);
+		storeImage.images[0].resize(1);
+		storeImage.textureTarget = TextureTarget::TEXTURE2D;
+		storeImage.tileCount = glm::uvec2(1);
+
+		auto& genericImage = storeImage.images[0][0];
+		genericImage = ImageFactory::loadUByte(data, dataSize, isSRGB(desc.internalFormat), flipY, detectColorSpace ? 0 : getComponents(desc.internalFormat));
+
+		FileSystem::store(compiledResource, storeImage, FileSystem::CompiledType::TEXTURE);
+
+		return storeImage;
+	}
+
+	void TextureManager::addPrefetchedImage(const std::filesystem::path& resolvedPath, StoreImage&& storeImage)
+	{
+		size_t bytes = 0;
+		for (const auto& side : storeImage.images) {
+			for (const auto& image : side) bytes += image.pixels.getBufferSize();
+		}
+
+		std::lock_guard<std::mutex> lock(mPrefetchMutex);
+
+		auto it = mPrefetchedImages.find(resolvedPath);
+		if (it != mPrefetchedImages.end()) removePrefetchedImageUnsafe(it);
+
+		mPrefetchedImages.emplace(resolvedPath, PrefetchedImage{ std::move(storeImage), bytes, mPrefetchSequence++ });
+		mPrefetchedBytes += bytes;
+
+		// Images that nobody takes (e.g. textures of a canceled load) mustn't pile up. An evicted image is just 
+		// read again by getImage.
+		while (mPrefetchedBytes > mPrefetchBudget && mPrefetchedImages.size() > 1) {
+			auto oldest = std::min_element(mPrefetchedImages.begin(), mPrefetchedImages.end(), [](const auto& a, const auto& b) {
+				return a.second.sequence < b.second.sequence;
+			});
+			removePrefetchedImageUnsafe(oldest);
+		}
+	}
+
+	bool TextureManager::takePrefetchedImage(const std::filesystem::path& resolvedPath, StoreImage& result)
+	{
+		std::lock_guard<std::mutex> lock(mPrefetchMutex);
+		auto it = mPrefetchedImages.find(resolvedPath);
+		if (it == mPrefetchedImages.end()) return false;
+
+		result = std::move(it->second.image);
+		removePrefetchedImageUnsafe(it);
+		return true;
+	}
+
+	void TextureManager::endPrefetch(const std::filesystem::path& compiledPath)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mPrefetchMutex);
+			mPrefetchesInFlight.erase(compiledPath);
+		}
+		mPrefetchFinished.notify_all();
+	}
+
+	void TextureManager::waitForPrefetch(const std::filesystem::path& compiledPath)
+	{
+		std::unique_lock<std::mutex> lock(mPrefetchMutex);
+		mPrefetchFinished.wait(lock, [&]() {
+			return mPrefetchesInFlight.find(compiledPath) == mPrefetchesInFlight.end();
+		});
+	}
+
+	void TextureManager::removePrefetchedImageUnsafe(PrefetchedImages::iterator it)
+	{
+		mPrefetchedBytes -= it->second.bytes;
+		mPrefetchedImages.erase(it);
 	}
 
 	std::unique_ptr<nex::Texture2D> TextureManager::createTexture(const StoreImage& storeImage, const nex::TextureDesc& data, bool detectColorSpace)
@@ -344,18 +448,7 @@ namespace nex {
 		std::unique_ptr<nex::Texture2D> texture;
 
 		try {
-			StoreImage storeImage;
-			std::filesystem::path compiledResource = mFileSystem->getCompiledPath(file).path;
-			storeImage.mipmapCount = 1;
-			storeImage.images.resize(1);
-			storeImage.images[0].resize(1);
-			storeImage.textureTarget = TextureTarget::TEXTURE2D;
-			storeImage.tileCount = glm::uvec2(1);
-
-			auto& genericImage = storeImage.images[0][0];
-			genericImage = ImageFactory::loadUByte(data, dataSize, isSRGB(desc.internalFormat), flipY, detectColorSpace ? 0 : getComponents(desc.internalFormat));
-
-			FileSystem::store(compiledResource, storeImage);
+			auto storeImage = loadEmbeddedStoreImage(file, data, dataSize, flipY, desc, detectColorSpace);
 			texture = createTexture(storeImage, desc, detectColorSpace);
 		}
 		catch (std::exception & e) {
@@ -368,6 +461,67 @@ namespace nex {
 		return texture;
 	}
 
+	void TextureManager::prefetchImage(const std::filesystem::path& file, bool flipY, const nex::TextureDesc& data, bool detectColorSpace)
+	{
+		const auto resolvedPath = mFileSystem->resolvePath(file);
+		const auto compiledPath = mFileSystem->getCompiledPath(file).path;
+
+		{
+			// Note: textureLookupTable is only accessed on the render thread. Images prefetched for already uploaded 
+			// textures are discarded by getImage.
+			std::lock_guard<std::mutex> lock(mPrefetchMutex);
+			if (mPrefetchedImages.find(resolvedPath) != mPrefetchedImages.end()) return;
+
+			// Only one job decodes the image and stores its compiled version.
+			if (!mPrefetchesInFlight.insert(compiledPath).second) return;
+		}
+
+		try {
+			addPrefetchedImage(resolvedPath, loadStoreImage(file, flipY, data, detectColorSpace));
+			endPrefetch(compiledPath);
+		}
+		catch (std::exception & e) {
+			endPrefetch(compiledPath);
+			throw_with_trace(e);
+		}
+		catch (...) {
+			endPrefetch(compiledPath);
+			throw_with_trace(nex::ResourceLoadException("Unknown error occurred while prefetching texture " + file.generic_string()));
+		}
+	}
+
+	void TextureManager::prefetchEmbeddedImage(const std::filesystem::path& file, const unsigned char* data,
+		int dataSize, bool flipY, const nex::TextureDesc& desc, bool detectColorSpace)
+	{
+		const auto compiledPath = mFileSystem->getCompiledPath(file).path;
+
+		{
+			std::lock_guard<std::mutex> lock(mPrefetchMutex);
+			if (!mPrefetchesInFlight.insert(compiledPath).second) return;
+		}
+
+		try {
+			// Note: The path can only be resolved after the compiled image has been stored.
+			auto storeImage = loadEmbeddedStoreImage(file, data, dataSize, flipY, desc, detectColorSpace);
+			addPrefetchedImage(mFileSystem->resolvePath(file), std::move(storeImage));
+			endPrefetch(compiledPath);
+		}
+		catch (std::exception & e) {
+			endPrefetch(compiledPath);
+			throw_with_trace(e);
+		}
+		catch (...) {
+			endPrefetch(compiledPath);
+			throw_with_trace(nex::ResourceLoadException("Unknown error occurred while loading texture " + file.generic_string()));
+		}
+	}
+
+	void TextureManager::setPrefetchBudget(size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(mPrefetchMutex);
+		mPrefetchBudget = bytes;
+	}
+
 	TextureManager* TextureManager::get()
 	{
 		static TextureManager instance;
@@ -380,6 +534,10 @@ namespace nex {
 		cubeMaps.clear();
 
 		textureLookupTable.clear();
+
+		std::lock_guard<std::mutex> lock(mPrefetchMutex);
+		mPrefetchedImages.clear();
+		mPrefetchedBytes = 0;
 	}
 
 
@@ -1,6 +1,9 @@
 #pragma once
 #include <map>
+#include <set>
 #include <list>
+#include <mutex>
+#include <condition_variable>
 #include <nex/gui/Drawable.hpp>
 #include "nex/common/Log.hpp"
 #include <nex/texture/TextureSamplerData.hpp>
@@ -22,6 +25,8 @@ namespace nex {
 	{
 	public:
 
+		static constexpr size_t DEFAULT_PREFETCH_BUDGET = 512 * 1024 * 1024;
+
 		TextureManager();
 
 		TextureManager(const TextureManager&) = delete;
@@ -96,6 +101,49 @@ namespace nex {
 				true }, bool detectColorSpace = false
 				);
 
+		/**
+		 * Decodes an image (or reads its compiled version) without creating a texture.
+		 * A later getImage/loadImage call for the same file only has to upload the decoded image.
+		 * Doesn't use the render backend and is thread safe, so it can run on any resource loader worker.
+		 * Note: The arguments have to match the arguments of the later getImage call.
+		 * Concurrent prefetches of the same file decode and store it only once. Prefetched images that aren't taken by
+		 * getImage are evicted oldest first, once they exceed the prefetch budget (see setPrefetchBudget).
+		 */
+		void prefetchImage(const std::filesystem::path& file,
+			bool flipY = true,
+			const nex::TextureDesc& data = {
+				nex::TexFilter::Linear_Mipmap_Linear,
+				nex::TexFilter::Linear,
+				nex::UVTechnique::Repeat,
+				nex::UVTechnique::Repeat,
+				nex::UVTechnique::Repeat,
+				nex::InternalFormat::SRGBA8,
+				true }, bool detectColorSpace = false
+		);
+
+		/**
+		 * Decodes an embedded image and stores its compiled version, so that a later getImage call for the file 
+		 * only has to upload it. Thread safe; doesn't use the render backend.
+		 */
+		void prefetchEmbeddedImage(const std::filesystem::path& file,
+			const unsigned char* data,
+			int dataSize,
+			bool flipY = true,
+			const nex::TextureDesc& desc = {
+				nex::TexFilter::Linear_Mipmap_Linear,
+				nex::TexFilter::Linear,
+				nex::UVTechnique::Repeat,
+				nex::UVTechnique::Repeat,
+				nex::UVTechnique::Repeat,
+				nex::InternalFormat::SRGBA8,
+				true }, bool detectColorSpace = false
+				);
+
+
+		/**
+		 * Sets the maximum size (in bytes) of the decoded images that wait for their upload.
+		 */
+		void setPrefetchBudget(size_t bytes);
 
 		/**
 		 * Provides access the texture manager singleton.
@@ -120,6 +168,39 @@ namespace nex {
 
 		std::unique_ptr<nex::Texture2D> createTexture(const StoreImage& storeImage, const nex::TextureDesc& data, bool detectColorSpace);
 
+		/**
+		 * The cpu part of loading an image: Reads the compiled image or decodes the image file (and compiles it).
+		 */
+		StoreImage loadStoreImage(const std::filesystem::path& file, bool flipY, const nex::TextureDesc& data, bool detectColorSpace);
+		StoreImage loadEmbeddedStoreImage(const std::filesystem::path& file, const unsigned char* data,
+			int dataSize, bool flipY, const nex::TextureDesc& desc, bool detectColorSpace);
+
+		void addPrefetchedImage(const std::filesystem::path& resolvedPath, StoreImage&& storeImage);
+
+		/**
+		 * Removes a prefetched image from the prefetch cache.
+		 * @return true, if a prefetched image for the path was found.
+		 */
+		bool takePrefetchedImage(const std::filesystem::path& resolvedPath, StoreImage& result);
+
+		/**
+		 * Unregisters a prefetch job (see mPrefetchesInFlight) and wakes up loads waiting for it.
+		 */
+		void endPrefetch(const std::filesystem::path& compiledPath);
+
+		/**
+		 * Blocks until no prefetch job is writing the compiled image.
+		 */
+		void waitForPrefetch(const std::filesystem::path& compiledPath);
+
+		struct PrefetchedImage;
+		using PrefetchedImages = std::map<std::filesystem::path, PrefetchedImage>;
+
+		/**
+		 * Note: mPrefetchMutex has to be locked.
+		 */
+		void removePrefetchedImageUnsafe(PrefetchedImages::iterator it);
+
 
 		static ColorSpace getColorSpace(unsigned channels);
 
@@ -134,6 +215,15 @@ namespace nex {
 		std::list<std::unique_ptr<Texture2D>> textures;
 		std::list<CubeMap> cubeMaps;
 		std::map<std::filesystem::path, Texture2D*> textureLookupTable;
+		// decoded images that wait for their upload (see prefetchImage); guarded by mPrefetchMutex
+		PrefetchedImages mPrefetchedImages;
+		// compiled paths of the images that prefetch jobs currently decode and store; guarded by mPrefetchMutex
+		std::set<std::filesystem::path> mPrefetchesInFlight;
+		std::condition_variable mPrefetchFinished;
+		size_t mPrefetchedBytes;
+		size_t mPrefetchBudget;
+		unsigned long long mPrefetchSequence;
+		std::mutex mPrefetchMutex;
 		nex::Logger m_logger;
 		std::unique_ptr<nex::FileSystem> mFileSystem;
 		std::filesystem::path mResourceRootDirectory;
@@ -0,0 +1,329 @@
+#include <nex/texture/TextureSamplerData.hpp>
+
+nex::ColorSpace nex::getColorSpace(InternalFormat format)
+{
+	static ColorSpace const table[]
+	{
+		ColorSpace::R,
+		ColorSpace::RED_INTEGER,
+		ColorSpace::R,
+		ColorSpace::R,
+		ColorSpace::R,
+		ColorSpace::RED_INTEGER,
+		ColorSpace::RED_INTEGER,
+
+		ColorSpace::RG,
+		ColorSpace::RG_INTEGER,
+		ColorSpace::RG_INTEGER,
+		ColorSpace::RG,
+		ColorSpace::RG,
+		ColorSpace::RG,
+		ColorSpace::RG_INTEGER,
+		ColorSpace::RG_INTEGER,
+
+		ColorSpace::RGB,
+		ColorSpace::RGB,
+		ColorSpace::RGB,
+		ColorSpace::RGB,
+		ColorSpace::RGB,
+		ColorSpace::RGB,
+		ColorSpace::RGB,
+
+		ColorSpace::RGBA,
+		ColorSpace::RGBA,
+		ColorSpace::RGBA,
+		ColorSpace::RGBA,
+		ColorSpace::RGBA,
+		ColorSpace::RGBA,
+		ColorSpace::RGBA,
+
+		ColorSpace::RGBA,
+		ColorSpace::RGBA,
+
+		ColorSpace::RGB,
+		ColorSpace::RGBA,
+
+		ColorSpace::DEPTH_STENCIL,
+		ColorSpace::DEPTH_STENCIL,
+		ColorSpace::DEPTH,
+		ColorSpace::DEPTH,
+		ColorSpace::DEPTH,
+		ColorSpace::DEPTH,
+		ColorSpace::STENCIL
+	};
+
+	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
+	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: internal format to colorspace map doesn't match number of supported internal formats");
+
+	return table[(unsigned)format];
+}
+
+unsigned nex::getComponents(InternalFormat format)
+{
+	static unsigned const table[]
+	{
+		1,
+		1,
+		1,
+		1,
+		1,
+		1,
+		1,
+
+		2,
+		2,
+		2,
+		2,
+		2,
+		2,
+		2,
+		2,
+
+		3,
+		3,
+		3,
+		3,
+		3,
+		3,
+		3,
+
+		4,
+		4,
+		4,
+		4,
+		4,
+		4,
+		4,
+
+		4,
+		4,
+
+		3,
+		4,
+
+		2,
+		2,
+		1,
+		1,
+		1,
+		1,
+		1
+	};
+
+	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
+	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: internal format to pixel data type map doesn't match number of supported internal formats");
+
+	return table[(unsigned)format];
+}
+
+
+unsigned nex::getPixelByteSize(InternalFormat format)
+{
+	static unsigned const table[]
+	{
+		1,
+		1,
+		2,
+		2,
+		4,
+		4,
+		4,
+
+		2,
+		2,
+		2,
+		4,
+		4,
+		8,
+		8,
+		8,
+
+		2,
+		3,
+		6,
+		6,
+		12,
+		12,
+		12,
+
+		4,
+		8,
+		8,
+		8,
+		16,
+		16,
+		16,
+
+		4,
+		4,
+
+		3,
+		4,
+
+		4,
+		8,
+		2,
+		4, // depth24 is stored in 32 bit
+		4,
+		4,
+		1
+	};
+
+	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
+	static_assert(sizeof(table) / sizeof(table[0]) == size, "Error: internal format to pixel byte size map doesn't match number of supported internal formats");
+
+	return table[(unsigned)format];
+}
+
+unsigned nex::getComponents(const ColorSpace colorSpace)
+{
+	static unsigned const table[]
+	{
+		1,
+		1,
+
+		2,
+		2,
+		
+		3,
+		3,
+		3,
+		3,
+
+		4,
+		4,
+		4,
+		4,
+
+		3,
+		4,
+
+		1,
+		1,
+		2,
+	};
+
+	static const unsigned size = (unsigned)ColorSpace::LAST - (unsigned)ColorSpace::FIRST + 1;
+	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: target descriptor list doesn't match number of supported targets");
+
+	return table[(unsigned)colorSpace];
+}
+
+unsigned nex::getPixelDataTypeByteSize(const PixelDataType pixelDataType)
+{
+	static unsigned const table[]
+	{
+		4,
+		2,
+		4,
+		1,
+		4,
+
+		2,
+		
+		4,
+		8,
+		2,
+		4,
+		4,
+
+		4
+
+
+	};
+
+	static const unsigned size = (unsigned)PixelDataType::LAST - (unsigned)PixelDataType::FIRST + 1;
+	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: pixel data type descriptor list doesn't match number of supported pixel data types");
+
+	return table[(unsigned)pixelDataType];
+}
+
+unsigned nex::getPixelDataTypePackedComponentsCount(const PixelDataType pixelDataType)
+{
+	static unsigned const table[]
+	{
+		1, 
+		1, 
+		1,
+		1,
+		1,
+
+		1,
+
+		2,
+		2,
+		1,
+		1,
+		4,
+
+		4
+	};
+
+	static const unsigned size = (unsigned)PixelDataType::LAST - (unsigned)PixelDataType::FIRST + 1;
+	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: pixel data type descriptor list doesn't match number of supported pixel data types");
+
+	return table[(unsigned)pixelDataType];
+}
+
+nex::InternalFormatType nex::getType(InternalFormat format) {
+	static InternalFormatType const table[]
+	{
+		InternalFormatType::NORMAL,
+		InternalFormatType::UINT,
+		InternalFormatType::NORMAL,
+		InternalFormatType::FLOAT,
+		InternalFormatType::FLOAT,
+		InternalFormatType::INT,
+		InternalFormatType::UINT,
+
+		InternalFormatType::NORMAL,
+		InternalFormatType::UINT,
+		InternalFormatType::SNORM,
+		InternalFormatType::NORMAL,
+		InternalFormatType::FLOAT,
+		InternalFormatType::FLOAT,
+		InternalFormatType::INT,
+		InternalFormatType::UINT,
+
+		InternalFormatType::NORMAL,
+		InternalFormatType::NORMAL,
+		InternalFormatType::NORMAL,
+		InternalFormatType::FLOAT,
+		InternalFormatType::FLOAT,
+		InternalFormatType::INT,
+		InternalFormatType::UINT,
+
+		InternalFormatType::NORMAL,
+		InternalFormatType::NORMAL,
+		InternalFormatType::FLOAT,
+		InternalFormatType::SNORM,
+		InternalFormatType::FLOAT,
+		InternalFormatType::INT,
+		InternalFormatType::UINT,
+
+		InternalFormatType::NORMAL,
+		InternalFormatType::UINT,
+
+		InternalFormatType::NORMAL,
+		InternalFormatType::NORMAL,
+
+		InternalFormatType::COMBINED,
+		InternalFormatType::COMBINED,
+		InternalFormatType::NORMAL,
+		InternalFormatType::NORMAL,
+		InternalFormatType::NORMAL,
+		InternalFormatType::FLOAT,
+		InternalFormatType::NORMAL
+	};
+
+	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
+	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: internal format type map doesn't match number of supported internal formats");
+
+	return table[(unsigned)format];
+
+}
+
+bool nex::isSRGB(InternalFormat format) {
+	return format == InternalFormat::SRGB8
+		|| format == InternalFormat::SRGBA8;
+}
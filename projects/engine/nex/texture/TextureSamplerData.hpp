@@ -330,6 +330,11 @@ namespace nex
 	unsigned  getComponents(InternalFormat format);
 	unsigned getComponents(const ColorSpace colorspace);
 	unsigned getPixelDataTypeByteSize(const PixelDataType pixelDataType);
+
+	/**
+	 * Provides the (nominal) number of bytes a texel of the given internal format occupies in video memory.
+	 */
+	unsigned getPixelByteSize(InternalFormat format);
 	unsigned getPixelDataTypePackedComponentsCount(const PixelDataType pixelDataType);
 	InternalFormatType getType(InternalFormat format);
 	bool isSRGB(InternalFormat format);
@@ -0,0 +1,200 @@
+#include <nex/util/AllocationCounter.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// Note: Both are constant initialized, so they can be used by allocations that happen before main is entered.
+	std::atomic<uint64_t> totalCount(0);
+	thread_local uint64_t threadCount = 0;
+
+	uint64_t frameStartTotalCount = 0;
+	uint64_t frameStartThreadCount = 0;
+	uint64_t lastFrameCount = 0;
+	uint64_t lastFrameThreadCount = 0;
+}
+
+bool nex::AllocationCounter::isEnabled()
+{
+#ifdef EUCLID_ALLOCATION_COUNTING
+	return true;
+#else
+	return false;
+#endif
+}
+
+uint64_t nex::AllocationCounter::getTotalCount()
+{
+	return totalCount.load(std::memory_order_relaxed);
+}
+
+uint64_t nex::AllocationCounter::getThreadCount()
+{
+	return threadCount;
+}
+
+uint64_t nex::AllocationCounter::getLastFrameCount()
+{
+	return lastFrameCount;
+}
+
+uint64_t nex::AllocationCounter::getLastFrameThreadCount()
+{
+	return lastFrameThreadCount;
+}
+
+void nex::AllocationCounter::markFrame()
+{
+	const auto total = getTotalCount();
+	const auto thread = getThreadCount();
+
+	lastFrameCount = total - frameStartTotalCount;
+	lastFrameThreadCount = thread - frameStartThreadCount;
+	frameStartTotalCount = total;
+	frameStartThreadCount = thread;
+}
+
+#ifdef EUCLID_ALLOCATION_COUNTING
+
+// The build references this symbol (see engine/CMakeLists.txt), so that the replacements below are linked from the
+// static engine library even if no code uses AllocationCounter.
+extern "C" int nexAllocationCounterLinkAnchor = 0;
+
+namespace
+{
+	void* countedMalloc(size_t size) noexcept
+	{
+		totalCount.fetch_add(1, std::memory_order_relaxed);
+		++threadCount;
+		return std::malloc(size ? size : 1);
+	}
+
+	void* countedAlignedMalloc(size_t size, size_t alignment) noexcept
+	{
+		totalCount.fetch_add(1, std::memory_order_relaxed);
+		++threadCount;
+		if (size == 0) size = 1;
+#ifdef _MSC_VER
+		return _aligned_malloc(size, alignment);
+#else
+		// aligned_alloc requires the size to be a multiple of the alignment
+		return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	}
+
+	void alignedFree(void* ptr) noexcept
+	{
+#ifdef _MSC_VER
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+}
+
+void* operator new(size_t size)
+{
+	if (auto* ptr = countedMalloc(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (auto* ptr = countedMalloc(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return countedMalloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return countedMalloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	if (auto* ptr = countedAlignedMalloc(size, static_cast<size_t>(alignment))) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	if (auto* ptr = countedAlignedMalloc(size, static_cast<size_t>(alignment))) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return countedAlignedMalloc(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return countedAlignedMalloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	alignedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+	alignedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	alignedFree(ptr);
+}
+
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+namespace nex
+{
+	/**
+	 * Counts calls of the global operator new (all variants), in order to verify that the steady state of the
+	 * frame loop doesn't allocate from the heap.
+	 *
+	 * Note: The global allocation functions are only replaced if EUCLID_ALLOCATION_COUNTING is defined
+	 * (CMake option USE_EUCLID_ALLOCATION_COUNTING, off by default). Otherwise all counts stay zero.
+	 */
+	class AllocationCounter
+	{
+	public:
+
+		/**
+		 * Checks if allocations are counted at all.
+		 */
+		static bool isEnabled();
+
+		/**
+		 * Provides the number of heap allocations of all threads since program start.
+		 */
+		static uint64_t getTotalCount();
+
+		/**
+		 * Provides the number of heap allocations of the calling thread since program start.
+		 */
+		static uint64_t getThreadCount();
+
+		/**
+		 * Provides the number of heap allocations of all threads during the last frame.
+		 */
+		static uint64_t getLastFrameCount();
+
+		/**
+		 * Provides the number of heap allocations of the thread calling markFrame during the last frame.
+		 */
+		static uint64_t getLastFrameThreadCount();
+
+		/**
+		 * Finishes the current frame. Should be called once per frame by the main thread.
+		 */
+		static void markFrame();
+	};
+}
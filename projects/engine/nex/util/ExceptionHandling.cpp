@@ -10,4 +10,7 @@ void nex::ExceptionHandling::logExceptionWithStackTrace(nex::Logger & logger, co
 	}
 
 	LOG(logger, nex::Fault) << "Exception: " << typeid(e).name() << ": " << e.what();
+
+	// We might be on a crash path
+	LogSink::get()->flush();
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include <nex/util/FrameArena.hpp>
+#include <cstdint>
+
+namespace
+{
+	size_t alignOffset(const char* base, size_t offset, size_t alignment)
+	{
+		const auto address = reinterpret_cast<uintptr_t>(base) + offset;
+		const auto aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+		return static_cast<size_t>(aligned - reinterpret_cast<uintptr_t>(base));
+	}
+}
+
+nex::FrameArena::FrameArena(size_t capacity) : mCurrent(0)
+{
+	for (auto& buffer : mBuffers) {
+		buffer.memory = std::make_unique<char[]>(capacity);
+		buffer.capacity = capacity;
+	}
+}
+
+nex::FrameArena* nex::FrameArena::get()
+{
+	static FrameArena arena;
+	return &arena;
+}
+
+void* nex::FrameArena::allocate(size_t size, size_t alignment)
+{
+	auto& buffer = mBuffers[mCurrent.load(std::memory_order_relaxed)];
+	const char* base = buffer.memory.get();
+	auto offset = buffer.offset.load(std::memory_order_relaxed);
+
+	for (;;) {
+		const auto begin = alignOffset(base, offset, alignment);
+		const auto end = begin + size;
+		if (end > buffer.capacity) break;
+
+		if (buffer.offset.compare_exchange_weak(offset, end, std::memory_order_relaxed)) {
+			return buffer.memory.get() + begin;
+		}
+	}
+
+	return allocateOverflow(buffer, size, alignment);
+}
+
+void nex::FrameArena::beginFrame()
+{
+	const auto next = (mCurrent.load(std::memory_order_relaxed) + 1) % BUFFER_COUNT;
+	reset(mBuffers[next]);
+	mCurrent.store(next, std::memory_order_relaxed);
+}
+
+size_t nex::FrameArena::getCapacity() const
+{
+	return mBuffers[mCurrent.load(std::memory_order_relaxed)].capacity;
+}
+
+size_t nex::FrameArena::getOverflowBytes() const
+{
+	const auto& buffer = mBuffers[mCurrent.load(std::memory_order_relaxed)];
+	std::unique_lock<std::mutex> lock(buffer.overflowMutex);
+	return buffer.overflowBytes;
+}
+
+size_t nex::FrameArena::getUsedBytes() const
+{
+	const auto& buffer = mBuffers[mCurrent.load(std::memory_order_relaxed)];
+	return buffer.offset.load(std::memory_order_relaxed);
+}
+
+void* nex::FrameArena::allocateOverflow(Buffer& buffer, size_t size, size_t alignment)
+{
+	const auto totalSize = size + alignment;
+	auto memory = std::make_unique<char[]>(totalSize);
+	auto* result = memory.get() + alignOffset(memory.get(), 0, alignment);
+
+	std::unique_lock<std::mutex> lock(buffer.overflowMutex);
+	buffer.overflow.emplace_back(std::move(memory));
+	buffer.overflowBytes += totalSize;
+	return result;
+}
+
+void nex::FrameArena::reset(Buffer& buffer)
+{
+	if (buffer.overflowBytes > 0) {
+		// grow, so that the next frame fits into the buffer
+		buffer.capacity += buffer.overflowBytes;
+		buffer.memory = std::make_unique<char[]>(buffer.capacity);
+		buffer.overflow.clear();
+		buffer.overflowBytes = 0;
+	}
+
+	buffer.offset.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace nex
+{
+	/**
+	 * A double buffered linear allocator for transient (per frame) data.
+	 * Allocating is a pointer bump (lock-free, thread-safe); deallocating is a no-op. The memory of a buffer is released
+	 * all at once, when the buffer gets reused. Since two buffers are used alternately, memory allocated in frame N
+	 * stays valid until the start of frame N + 2 - so data produced in one frame can safely be consumed in the next one.
+	 *
+	 * If a buffer runs out of memory, additional memory is allocated from the heap. The next time the buffer is reset,
+	 * it grows by the overflow size, so that the steady state doesn't need any heap allocation.
+	 */
+	class FrameArena
+	{
+	public:
+
+		static constexpr size_t DEFAULT_CAPACITY = 4 * 1024 * 1024;
+		static constexpr size_t BUFFER_COUNT = 2;
+
+		explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		/**
+		 * Provides the frame arena of the engine.
+		 */
+		static FrameArena* get();
+
+		/**
+		 * Allocates memory from the current buffer. Thread-safe.
+		 */
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		/**
+		 * Switches to the other buffer and releases all memory allocated from it.
+		 * Must be called once per frame by the main thread. No other thread is allowed to allocate while this function is executed.
+		 */
+		void beginFrame();
+
+		/**
+		 * Provides the capacity (in bytes) of the current buffer (without overflow allocations).
+		 */
+		size_t getCapacity() const;
+
+		/**
+		 * Provides the number of bytes that had to be allocated from the heap since the current buffer was reset.
+		 */
+		size_t getOverflowBytes() const;
+
+		/**
+		 * Provides the number of bytes that have been allocated from the current buffer (without overflow allocations).
+		 */
+		size_t getUsedBytes() const;
+
+	private:
+
+		struct Buffer {
+			std::unique_ptr<char[]> memory;
+			size_t capacity = 0;
+			std::atomic<size_t> offset = 0;
+
+			mutable std::mutex overflowMutex;
+			std::vector<std::unique_ptr<char[]>> overflow;
+			size_t overflowBytes = 0;
+		};
+
+		void* allocateOverflow(Buffer& buffer, size_t size, size_t alignment);
+
+		static void reset(Buffer& buffer);
+
+		Buffer mBuffers[BUFFER_COUNT];
+		std::atomic<size_t> mCurrent;
+	};
+
+	/**
+	 * STL compatible allocator that allocates from a frame arena.
+	 * Containers using it must not live longer than the next frame (see FrameArena).
+	 */
+	template<class T>
+	class FrameAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameAllocator() noexcept : mArena(FrameArena::get())
+		{
+		}
+
+		explicit FrameAllocator(FrameArena* arena) noexcept : mArena(arena)
+		{
+		}
+
+		template<class U>
+		FrameAllocator(const FrameAllocator<U>& other) noexcept : mArena(other.getArena())
+		{
+		}
+
+		T* allocate(size_t n)
+		{
+			return static_cast<T*>(mArena->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T*, size_t) noexcept
+		{
+			// memory is released at once by the arena
+		}
+
+		FrameArena* getArena() const noexcept
+		{
+			return mArena;
+		}
+
+		template<class U>
+		bool operator==(const FrameAllocator<U>& other) const noexcept
+		{
+			return mArena == other.getArena();
+		}
+
+		template<class U>
+		bool operator!=(const FrameAllocator<U>& other) const noexcept
+		{
+			return mArena != other.getArena();
+		}
+
+	private:
+		FrameArena* mArena;
+	};
+
+	template<class T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+	template<class T>
+	using FrameDeque = std::deque<T, FrameAllocator<T>>;
+
+	template<class T>
+	using FrameQueue = std::queue<T, FrameDeque<T>>;
+}
@@ -0,0 +1,244 @@
+#include <nex/util/Profiler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+/**
+ * Zones of a thread. Begin/end is only called by the owning thread; the mutex is only contended when
+ * the main thread collects the finished zones at the end of a frame.
+ */
+struct nex::Profiler::ThreadBuffer
+{
+	uint32_t threadID;
+	std::string threadName;
+	std::vector<Zone> openZones;
+
+	std::mutex mutex;
+	std::vector<Zone> finishedZones;
+	uint32_t droppedZones = 0;
+	bool exited = false;
+};
+
+/**
+ * Flags the buffer of a thread as exited when the thread ends, so that the profiler can release it.
+ * Note: Holds a reference to the buffer, since the profiler might already have released it (or be destroyed).
+ */
+struct nex::Profiler::ThreadExitNotifier
+{
+	std::shared_ptr<ThreadBuffer> buffer;
+
+	~ThreadExitNotifier()
+	{
+		if (!buffer) return;
+		std::unique_lock<std::mutex> lock(buffer->mutex);
+		buffer->exited = true;
+	}
+};
+
+thread_local nex::Profiler::ThreadBuffer* nex::Profiler::mCurrentThreadBuffer = nullptr;
+thread_local nex::Profiler::ThreadExitNotifier nex::Profiler::mThreadExitNotifier;
+
+namespace
+{
+	void writeEscaped(std::ostream& out, const std::string& str)
+	{
+		for (char c : str) {
+			if (c == '"' || c == '\\') out << '\\';
+			out << c;
+		}
+	}
+}
+
+nex::Profiler::Profiler() : mNextThreadID(0), mCapturing(false), mMaxCapturedFrames(DEFAULT_MAX_CAPTURED_FRAMES)
+{
+	mStartTime = 0;
+	mStartTime = now();
+	mFrameStart = 0;
+	mLastFrame.start = mLastFrame.end = 0;
+}
+
+nex::Profiler* nex::Profiler::get()
+{
+	static Profiler profiler;
+	return &profiler;
+}
+
+void nex::Profiler::beginZone(const char* name)
+{
+	auto* buffer = getThreadBuffer();
+	buffer->openZones.push_back({ name, now(), 0, static_cast<uint32_t>(buffer->openZones.size()) });
+}
+
+void nex::Profiler::endZone()
+{
+	auto* buffer = getThreadBuffer();
+	if (buffer->openZones.empty()) return;
+
+	auto zone = buffer->openZones.back();
+	buffer->openZones.pop_back();
+	zone.end = now();
+
+	std::unique_lock<std::mutex> lock(buffer->mutex);
+	if (buffer->finishedZones.size() < MAX_ZONES_PER_FRAME) {
+		buffer->finishedZones.push_back(zone);
+	}
+	else {
+		++buffer->droppedZones;
+	}
+}
+
+bool nex::Profiler::exportChromeTrace(const std::filesystem::path& path) const
+{
+	std::ofstream out(path, std::ios::out | std::ios::trunc);
+	if (!out) return false;
+
+	std::unique_lock<std::mutex> lock(mCaptureMutex);
+
+	// chrome trace uses microseconds
+	auto micros = [](uint64_t nanos) {
+		return nanos / 1000.0;
+	};
+
+	out << "{\"traceEvents\":[\n";
+	bool first = true;
+
+	auto separate = [&]() {
+		if (!first) out << ",\n";
+		first = false;
+	};
+
+	std::vector<uint32_t> namedThreads;
+
+	for (const auto& frame : mCapturedFrames) {
+		separate();
+		out << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":" << micros(frame.start) << "}";
+
+		for (const auto& thread : frame.threads) {
+
+			if (std::find(namedThreads.begin(), namedThreads.end(), thread.threadID) == namedThreads.end()) {
+				namedThreads.push_back(thread.threadID);
+				separate();
+				out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread.threadID
+					<< ",\"args\":{\"name\":\"";
+				writeEscaped(out, thread.threadName);
+				out << "\"}}";
+			}
+
+			for (const auto& zone : thread.zones) {
+				separate();
+				out << "{\"name\":\"";
+				writeEscaped(out, zone.name);
+				out << "\",\"cat\":\"nex\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread.threadID
+					<< ",\"ts\":" << micros(zone.start) << ",\"dur\":" << micros(zone.end - zone.start) << "}";
+			}
+		}
+	}
+
+	out << "\n]}\n";
+	return out.good();
+}
+
+size_t nex::Profiler::getCapturedFrameCount() const
+{
+	std::unique_lock<std::mutex> lock(mCaptureMutex);
+	return mCapturedFrames.size();
+}
+
+const nex::Profiler::Frame& nex::Profiler::getLastFrame() const
+{
+	return mLastFrame;
+}
+
+bool nex::Profiler::isCapturing() const
+{
+	std::unique_lock<std::mutex> lock(mCaptureMutex);
+	return mCapturing;
+}
+
+void nex::Profiler::markFrame()
+{
+	const auto frameEnd = now();
+
+	mLastFrame.start = mFrameStart;
+	mLastFrame.end = frameEnd;
+	mFrameStart = frameEnd;
+
+	{
+		std::unique_lock<std::mutex> lock(mRegistryMutex);
+		mLastFrame.threads.resize(mThreadBuffers.size());
+
+		for (size_t i = 0; i < mThreadBuffers.size(); ++i) {
+			auto& buffer = *mThreadBuffers[i];
+			auto& thread = mLastFrame.threads[i];
+			thread.threadID = buffer.threadID;
+			thread.zones.clear();
+
+			std::unique_lock<std::mutex> bufferLock(buffer.mutex);
+			thread.threadName = buffer.threadName;
+			thread.droppedZones = buffer.droppedZones;
+			buffer.droppedZones = 0;
+			// Note: swap keeps the allocated memory of both vectors
+			std::swap(thread.zones, buffer.finishedZones);
+		}
+
+		// The zones of exited threads are collected now; they won't record any further zones.
+		mThreadBuffers.erase(std::remove_if(mThreadBuffers.begin(), mThreadBuffers.end(), [](const auto& buffer) {
+			std::unique_lock<std::mutex> bufferLock(buffer->mutex);
+			return buffer->exited;
+		}), mThreadBuffers.end());
+	}
+
+	// zones of a thread are finished in post order; sort them by start time for hierarchical display
+	for (auto& thread : mLastFrame.threads) {
+		std::sort(thread.zones.begin(), thread.zones.end(), [](const Zone& a, const Zone& b) {
+			return a.start < b.start || (a.start == b.start && a.depth < b.depth);
+		});
+	}
+
+	std::unique_lock<std::mutex> lock(mCaptureMutex);
+	if (!mCapturing) return;
+
+	mCapturedFrames.push_back(mLastFrame);
+	while (mCapturedFrames.size() > mMaxCapturedFrames) {
+		mCapturedFrames.pop_front();
+	}
+}
+
+void nex::Profiler::setCapturing(bool capture, size_t maxFrames)
+{
+	std::unique_lock<std::mutex> lock(mCaptureMutex);
+	if (capture && !mCapturing) mCapturedFrames.clear();
+	mCapturing = capture;
+	mMaxCapturedFrames = maxFrames;
+}
+
+void nex::Profiler::setThreadName(const std::string& name)
+{
+	auto* buffer = getThreadBuffer();
+	std::unique_lock<std::mutex> lock(buffer->mutex);
+	buffer->threadName = name;
+}
+
+nex::Profiler::ThreadBuffer* nex::Profiler::getThreadBuffer()
+{
+	if (mCurrentThreadBuffer) return mCurrentThreadBuffer;
+
+	auto buffer = std::make_shared<ThreadBuffer>();
+
+	std::unique_lock<std::mutex> lock(mRegistryMutex);
+	buffer->threadID = mNextThreadID++;
+	buffer->threadName = "Thread " + std::to_string(buffer->threadID);
+	mThreadBuffers.push_back(buffer);
+
+	// Note: The profiler keeps the buffer alive until the zones of the exited thread are collected by markFrame.
+	mThreadExitNotifier.buffer = buffer;
+	mCurrentThreadBuffer = buffer.get();
+	return mCurrentThreadBuffer;
+}
+
+uint64_t nex::Profiler::now() const
+{
+	const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+	return static_cast<uint64_t>(time) - mStartTime;
+}
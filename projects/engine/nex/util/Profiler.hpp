@@ -0,0 +1,172 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nex
+{
+	/**
+	 * A hierarchical cpu profiler.
+	 * Zones are recorded per thread (see NEX_PROFILE_SCOPE); nested zones get an increasing depth.
+	 * The main thread marks the frame boundaries (see NEX_PROFILE_FRAME). All zones that have been finished
+	 * since the last frame marker are collected into a frame. Optionally, frames are captured for an export
+	 * to the chrome trace format (chrome://tracing or https://ui.perfetto.dev).
+	 *
+	 * Note: The profiling macros compile to nothing if EUCLID_PROFILING isn't defined.
+	 */
+	class Profiler
+	{
+	public:
+
+		struct Zone {
+			const char* name; // Has to have static storage duration (e.g. a string literal)
+			uint64_t start; // nanoseconds since profiler start
+			uint64_t end; // nanoseconds since profiler start
+			uint32_t depth;
+		};
+
+		struct ThreadZones {
+			uint32_t threadID;
+			std::string threadName;
+			std::vector<Zone> zones;
+			uint32_t droppedZones; // zones that exceeded MAX_ZONES_PER_FRAME
+		};
+
+		struct Frame {
+			uint64_t start;
+			uint64_t end;
+			std::vector<ThreadZones> threads;
+		};
+
+		static constexpr size_t DEFAULT_MAX_CAPTURED_FRAMES = 600;
+
+		/**
+		 * Maximum number of zones that are recorded per thread between two frame markers. Further zones are dropped (and counted),
+		 * so that a missing frame marker (e.g. a tool that never calls markFrame) doesn't let the profiler grow without bounds.
+		 */
+		static constexpr size_t MAX_ZONES_PER_FRAME = 65536;
+
+		static Profiler* get();
+
+		/**
+		 * Starts a new zone on the calling thread.
+		 */
+		void beginZone(const char* name);
+
+		/**
+		 * Ends the most recently started zone of the calling thread.
+		 */
+		void endZone();
+
+		/**
+		 * Writes the captured frames to a file in chrome trace (json) format.
+		 * @return false, if the file couldn't be written.
+		 */
+		bool exportChromeTrace(const std::filesystem::path& path) const;
+
+		/**
+		 * Provides the number of captured frames.
+		 */
+		size_t getCapturedFrameCount() const;
+
+		/**
+		 * Provides the last completed frame.
+		 */
+		const Frame& getLastFrame() const;
+
+		bool isCapturing() const;
+
+		/**
+		 * Finishes the current frame and starts a new one. Should be called once per frame by the main thread.
+		 * Buffers of threads that have exited are released after their last zones have been collected.
+		 */
+		void markFrame();
+
+		/**
+		 * Enables/disables capturing of frames. Enabling the capture discards previously captured frames.
+		 * If more than maxFrames are captured, the oldest frames get discarded.
+		 */
+		void setCapturing(bool capture, size_t maxFrames = DEFAULT_MAX_CAPTURED_FRAMES);
+
+		/**
+		 * Sets the name of the calling thread (used for the export and the gui).
+		 */
+		void setThreadName(const std::string& name);
+
+	private:
+
+		struct ThreadBuffer;
+		struct ThreadExitNotifier;
+
+		Profiler();
+
+		ThreadBuffer* getThreadBuffer();
+
+		uint64_t now() const;
+
+		uint64_t mStartTime;
+		uint64_t mFrameStart;
+
+		mutable std::mutex mRegistryMutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> mThreadBuffers;
+		uint32_t mNextThreadID;
+
+		Frame mLastFrame;
+
+		mutable std::mutex mCaptureMutex;
+		bool mCapturing;
+		size_t mMaxCapturedFrames;
+		std::deque<Frame> mCapturedFrames;
+
+		static thread_local ThreadBuffer* mCurrentThreadBuffer;
+		static thread_local ThreadExitNotifier mThreadExitNotifier;
+	};
+
+	/**
+	 * RAII helper for a profiler zone.
+	 */
+	class ProfileZone
+	{
+	public:
+		explicit ProfileZone(const char* name)
+		{
+			Profiler::get()->beginZone(name);
+		}
+
+		~ProfileZone()
+		{
+			Profiler::get()->endZone();
+		}
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+	};
+}
+
+#ifdef EUCLID_PROFILING
+	#define NEX_PROFILE_CONCAT_INTERN(a, b) a##b
+	#define NEX_PROFILE_CONCAT(a, b) NEX_PROFILE_CONCAT_INTERN(a, b)
+
+	/**
+	 * Profiles the enclosing scope. Note: name has to be a string literal.
+	 */
+	#define NEX_PROFILE_SCOPE(name) nex::ProfileZone NEX_PROFILE_CONCAT(nexProfileZone, __LINE__)(name)
+
+	/**
+	 * Marks the beginning of a new frame.
+	 */
+	#define NEX_PROFILE_FRAME() nex::Profiler::get()->markFrame()
+
+	/**
+	 * Sets the name of the current thread.
+	 */
+	#define NEX_PROFILE_THREAD(name) nex::Profiler::get()->setThreadName(name)
+#else
+	#define NEX_PROFILE_SCOPE(name)
+	#define NEX_PROFILE_FRAME()
+	#define NEX_PROFILE_THREAD(name)
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nex
+{
+	/**
+	 * A small id for sort keys that is unique among all living objects having a SortID with the same tag.
+	 * Ids of destroyed objects are reused, so that the ids stay dense. Id 0 is never handed out and can be used for null objects.
+	 * Copies and moved-to objects get an own id; assignment keeps the id of the assigned object.
+	 */
+	template<class Tag>
+	class SortID
+	{
+	public:
+		SortID() : mID(acquire()) {}
+		SortID(const SortID&) : mID(acquire()) {}
+		SortID(SortID&&) noexcept : mID(acquire()) {}
+		SortID& operator=(const SortID&) { return *this; }
+		SortID& operator=(SortID&&) noexcept { return *this; }
+		~SortID() { release(mID); }
+
+		uint32_t get() const { return mID; }
+
+	private:
+
+		struct Pool {
+			std::mutex mutex;
+			std::vector<uint32_t> freeIDs;
+			uint32_t next = 1;
+		};
+
+		static Pool& getPool()
+		{
+			// Note: intentionally leaked, so that objects destroyed at static destruction time can still release their ids
+			static Pool* pool = new Pool;
+			return *pool;
+		}
+
+		static uint32_t acquire()
+		{
+			auto& pool = getPool();
+			std::lock_guard<std::mutex> lock(pool.mutex);
+			if (pool.freeIDs.empty()) return pool.next++;
+			const auto id = pool.freeIDs.back();
+			pool.freeIDs.pop_back();
+			return id;
+		}
+
+		static void release(uint32_t id)
+		{
+			auto& pool = getPool();
+			std::lock_guard<std::mutex> lock(pool.mutex);
+			pool.freeIDs.push_back(id);
+		}
+
+		uint32_t mID;
+	};
+}
@@ -0,0 +1,125 @@
+#include <nex/util/concurrent/ThreadPool.hpp>
+#include <nex/util/Profiler.hpp>
+#include <algorithm>
+#include <string>
+
+thread_local bool nex::util::ThreadPool::mIsWorker = false;
+
+nex::util::ThreadPool::ThreadPool(unsigned workerCount) : mGeneration(0), mShutdown(false)
+{
+	if (workerCount == 0) {
+		const auto hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	for (unsigned i = 0; i < workerCount; ++i) {
+		mWorkers.emplace_back(&ThreadPool::run, this, i);
+	}
+}
+
+nex::util::ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mShutdown = true;
+	}
+	mWakeUp.notify_all();
+
+	for (auto& worker : mWorkers) {
+		worker.join();
+	}
+}
+
+nex::util::ThreadPool* nex::util::ThreadPool::get()
+{
+	static ThreadPool pool;
+	return &pool;
+}
+
+unsigned nex::util::ThreadPool::getThreadCount() const
+{
+	return static_cast<unsigned>(mWorkers.size()) + 1;
+}
+
+void nex::util::ThreadPool::parallelFor(size_t count, size_t grainSize, const RangeFunc& func, unsigned maxThreads)
+{
+	if (count == 0) return;
+	grainSize = std::max<size_t>(grainSize, 1);
+
+	const auto chunkCount = (count + grainSize - 1) / grainSize;
+	auto workerCount = static_cast<unsigned>(std::min<size_t>(mWorkers.size(), chunkCount - 1));
+	if (maxThreads > 0) workerCount = std::min(workerCount, maxThreads - 1);
+
+	std::unique_lock<std::mutex> loopLock(mLoopMutex, std::defer_lock);
+
+	if (workerCount == 0 || mIsWorker || !loopLock.try_lock()) {
+		func(0, count);
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mJob.func = &func;
+		mJob.count = count;
+		mJob.grainSize = grainSize;
+		mJob.nextIndex.store(0, std::memory_order_relaxed);
+		mJob.activeWorkers = workerCount;
+		mJob.pendingWorkers = workerCount;
+		mJob.error = nullptr;
+		++mGeneration;
+	}
+	mWakeUp.notify_all();
+
+	process();
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	mDone.wait(lock, [&]() { return mJob.pendingWorkers == 0; });
+
+	if (mJob.error) std::rethrow_exception(mJob.error);
+}
+
+void nex::util::ThreadPool::process()
+{
+	const auto& job = mJob;
+
+	try {
+		for (;;) {
+			const auto begin = mJob.nextIndex.fetch_add(job.grainSize, std::memory_order_relaxed);
+			if (begin >= job.count) break;
+			(*job.func)(begin, std::min(begin + job.grainSize, job.count));
+		}
+	}
+	catch (...) {
+		// skip the remaining chunks
+		mJob.nextIndex.store(job.count, std::memory_order_relaxed);
+
+		std::unique_lock<std::mutex> lock(mMutex);
+		if (!mJob.error) mJob.error = std::current_exception();
+	}
+}
+
+void nex::util::ThreadPool::run(unsigned workerIndex)
+{
+	mIsWorker = true;
+	NEX_PROFILE_THREAD("Frame worker " + std::to_string(workerIndex));
+
+	uint64_t generation = 0;
+
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	for (;;) {
+		mWakeUp.wait(lock, [&]() { return mShutdown || mGeneration != generation; });
+		if (mShutdown) return;
+
+		generation = mGeneration;
+		if (workerIndex >= mJob.activeWorkers) continue;
+
+		lock.unlock();
+		process();
+		lock.lock();
+
+		if (--mJob.pendingWorkers == 0) {
+			mDone.notify_one();
+		}
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nex::util
+{
+	/**
+	 * A fork-join thread pool for data parallel work within a frame (e.g. updating scene objects).
+	 * In contrast to the resource loader, the workers of this pool never execute long running tasks, so the calling
+	 * thread can block until a parallel loop is finished.
+	 *
+	 * The calling thread participates in the work. Parallel loops are not nested: A loop started from a worker thread
+	 * or while another loop is running is executed serially by the calling thread.
+	 */
+	class ThreadPool
+	{
+	public:
+
+		/**
+		 * Processes the index range [begin, end).
+		 */
+		using RangeFunc = std::function<void(size_t begin, size_t end)>;
+
+		/**
+		 * @param workerCount : The number of worker threads. If 0, one worker less than the number of hardware threads is used.
+		 */
+		explicit ThreadPool(unsigned workerCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * Provides the thread pool of the engine.
+		 */
+		static ThreadPool* get();
+
+		/**
+		 * Provides the maximum number of threads processing a parallel loop (workers + calling thread).
+		 */
+		unsigned getThreadCount() const;
+
+		/**
+		 * Calls func for all indices in [0, count), split into chunks of grainSize indices.
+		 * Blocks until all chunks are processed. If func throws an exception, the first exception is rethrown
+		 * (remaining chunks might not be processed).
+		 * @param maxThreads : The maximum number of threads (including the calling thread) to use. If 0, all threads are used.
+		 */
+		void parallelFor(size_t count, size_t grainSize, const RangeFunc& func, unsigned maxThreads = 0);
+
+	private:
+
+		struct Job {
+			const RangeFunc* func = nullptr;
+			size_t count = 0;
+			size_t grainSize = 1;
+			std::atomic<size_t> nextIndex = 0;
+			unsigned activeWorkers = 0;
+			unsigned pendingWorkers = 0;
+			std::exception_ptr error;
+		};
+
+		void process();
+		void run(unsigned workerIndex);
+
+		std::vector<std::thread> mWorkers;
+
+		std::mutex mMutex;
+		std::condition_variable mWakeUp;
+		std::condition_variable mDone;
+		uint64_t mGeneration;
+		bool mShutdown;
+		Job mJob;
+
+		// Ensures that only one parallel loop is executed at a time
+		std::mutex mLoopMutex;
+
+		static thread_local bool mIsWorker;
+	};
+}
@@ -2174,6 +2174,14 @@ void nex::OceanVob::frameUpdate(const RenderContext& constants)
 	mSimulatedTime += constants.frameTime;
 	mOcean->simulate(mSimulatedTime);
 	mOcean->updateAnimationTime(mSimulatedTime);
+
+	// the height range of the waves and thus the bounding box might have changed
+	markTrafoDirty();
+}
+
+bool nex::OceanVob::isParallelUpdateSafe() const
+{
+	return false;
 }
 
 nex::Ocean* nex::OceanVob::getOcean()
@@ -2188,6 +2196,7 @@ void nex::OceanVob::setOcean(std::unique_ptr<Ocean> ocean)
 
 	mOcean = std::move(ocean);
 	recalculateLocalBoundingBox();
+	markTrafoDirty();
 }
 
 bool nex::OceanVob::getRenderUnderWater() const
@@ -2209,6 +2218,8 @@ void nex::OceanVob::updateTrafo(bool resetPrevWorldTrafo, bool recalculateBoundi
 
 void nex::OceanVob::recalculateLocalBoundingBox()
 {
+	if (!mOcean) return;
+
 	const auto& minMaxHeight = mOcean->getMinMaxHeight();
 	const auto& tileCount = mOcean->getTileCount();
 
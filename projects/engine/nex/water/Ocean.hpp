@@ -790,6 +790,11 @@ namespace nex
 		void collectRenderCommands(RenderCommandQueue& queue, bool doCulling, const RenderContext& context) const override;
 
 		void frameUpdate(const RenderContext& constants) override;
+
+		/**
+		 * Note: The ocean simulation uses the render backend, so the ocean has to be updated on the main thread.
+		 */
+		bool isParallelUpdateSafe() const override;
 		
 
 
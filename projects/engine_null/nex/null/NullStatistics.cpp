@@ -0,0 +1,71 @@
+#include <nex/null/NullStatistics.hpp>
+
+nex::NullStatistics::NullStatistics()
+{
+	reset();
+}
+
+nex::NullStatistics* nex::NullStatistics::get()
+{
+	static NullStatistics statistics;
+	return &statistics;
+}
+
+const char* nex::NullStatistics::getName(Counter counter)
+{
+	static const char* const table[] =
+	{
+		"draw calls",
+		"drawn indices",
+		"drawn instances",
+		"state changes",
+		"buffer creations",
+		"buffer uploads",
+		"buffer upload bytes",
+		"buffer maps",
+		"streamed ranges",
+		"streamed bytes",
+		"texture creations",
+		"texture uploads",
+		"texture upload bytes",
+		"texture readbacks",
+		"texture binds",
+		"shader binds",
+		"uniform updates",
+		"render target binds",
+		"render target clears",
+		"render target blits",
+		"compute dispatches",
+	};
+
+	static_assert(sizeof(table) / sizeof(table[0]) == COUNTER_COUNT, "NullStatistics::Counter and name table don't match!");
+
+	return table[(size_t)counter];
+}
+
+void nex::NullStatistics::add(Counter counter, uint64_t value)
+{
+	mCounters[(size_t)counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t nex::NullStatistics::getValue(Counter counter) const
+{
+	return mCounters[(size_t)counter].load(std::memory_order_relaxed);
+}
+
+void nex::NullStatistics::reset()
+{
+	for (auto& counter : mCounters) {
+		counter.store(0, std::memory_order_relaxed);
+	}
+}
+
+std::ostream& nex::operator<<(std::ostream& os, const NullStatistics& statistics)
+{
+	for (size_t i = 0; i < NullStatistics::COUNTER_COUNT; ++i) {
+		const auto counter = (NullStatistics::Counter)i;
+		os << NullStatistics::getName(counter) << ": " << statistics.getValue(counter) << "\n";
+	}
+
+	return os;
+}
\ No newline at end of file
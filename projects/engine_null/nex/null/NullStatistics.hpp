@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+namespace nex
+{
+	/**
+	 * Counts the calls (and transferred bytes) the null render backend receives.
+	 * The counters are atomic as resources are also created on the resource loader thread.
+	 */
+	class NullStatistics
+	{
+	public:
+
+		enum class Counter
+		{
+			DRAW_CALLS, FIRST = DRAW_CALLS,
+			DRAWN_INDICES,
+			DRAWN_INSTANCES,
+			STATE_CHANGES,
+			BUFFER_CREATIONS,
+			BUFFER_UPLOADS,
+			BUFFER_UPLOAD_BYTES,
+			BUFFER_MAPS,
+			STREAMED_RANGES,
+			STREAMED_BYTES,
+			TEXTURE_CREATIONS,
+			TEXTURE_UPLOADS,
+			TEXTURE_UPLOAD_BYTES,
+			TEXTURE_READBACKS,
+			TEXTURE_BINDS,
+			SHADER_BINDS,
+			UNIFORM_UPDATES,
+			RENDER_TARGET_BINDS,
+			RENDER_TARGET_CLEARS,
+			RENDER_TARGET_BLITS,
+			COMPUTE_DISPATCHES, LAST = COMPUTE_DISPATCHES,
+		};
+
+		static constexpr size_t COUNTER_COUNT = (size_t)Counter::LAST + 1;
+
+		static NullStatistics* get();
+
+		static const char* getName(Counter counter);
+
+		void add(Counter counter, uint64_t value = 1);
+
+		uint64_t getValue(Counter counter) const;
+
+		/**
+		 * Sets all counters to zero.
+		 */
+		void reset();
+
+	private:
+		NullStatistics();
+
+		std::atomic<uint64_t> mCounters[COUNTER_COUNT];
+	};
+
+	/**
+	 * Writes all counters (one per line) to an output stream.
+	 */
+	std::ostream& operator<<(std::ostream& os, const NullStatistics& statistics);
+}
\ No newline at end of file
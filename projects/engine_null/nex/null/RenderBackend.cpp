@@ -0,0 +1,487 @@
+#include <nex/renderer/RenderBackend.hpp>
+#include <nex/null/RenderBackendNull.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <nex/null/texture/RenderTargetNull.hpp>
+#include <nex/texture/Attachment.hpp>
+#include <nex/effects/EffectLibrary.hpp>
+
+using namespace std;
+using namespace nex;
+
+namespace nex
+{
+	void changeState(BlendDesc& current, const BlendDesc& desc)
+	{
+		changeState(current.source, desc.source);
+		changeState(current.destination, desc.destination);
+		changeState(current.operation, desc.operation);
+	}
+
+	Blender::Blender()
+	{
+		mImpl = make_unique<Blender::Impl>();
+		setState(BlendState());
+	}
+
+	void Blender::enableBlend(bool enable)
+	{
+		changeState(mImpl->mState.enableBlend, enable);
+	}
+
+	void Blender::enableAlphaToCoverage(bool enable)
+	{
+		changeState(mImpl->mState.enableAlphaToCoverage, enable);
+	}
+
+	void Blender::setSampleConverage(float sampleCoverage, bool invert)
+	{
+		changeState(mImpl->mState.sampleCoverage, sampleCoverage);
+		changeState(mImpl->mState.invertSampleConverage, invert);
+	}
+
+	void Blender::setConstantBlendColor(const glm::vec4& color)
+	{
+		changeState(mImpl->mState.constantBlendColor, color);
+	}
+
+	void Blender::setBlendDesc(const BlendDesc& desc)
+	{
+		changeState(mImpl->mState.globalBlendDesc, desc);
+	}
+
+	void Blender::setState(const BlendState& state)
+	{
+		enableBlend(state.enableBlend);
+		enableAlphaToCoverage(state.enableAlphaToCoverage);
+		setSampleConverage(state.sampleCoverage, state.invertSampleConverage);
+		setConstantBlendColor(state.constantBlendColor);
+		setBlendDesc(state.globalBlendDesc);
+	}
+
+	void Blender::setRenderTargetBlending(const RenderTargetBlendDesc& blendDesc)
+	{
+		auto& current = mImpl->mRenderTargetBlendings[blendDesc.colorAttachIndex];
+		current.colorAttachIndex = blendDesc.colorAttachIndex;
+		changeState(current.enableBlend, blendDesc.enableBlend);
+		changeState(current.blendDesc, blendDesc.blendDesc);
+	}
+
+
+	DepthBuffer::DepthBuffer() : mImpl(std::make_unique<DepthBuffer::Impl>())
+	{
+	}
+
+	void DepthBuffer::enableDepthBufferWriting(bool enable)
+	{
+		changeState(mImpl->mState.enableDepthBufferWriting, enable);
+	}
+
+	void DepthBuffer::enableDepthTest(bool enable)
+	{
+		changeState(mImpl->mState.enableDepthTest, enable);
+	}
+
+	void DepthBuffer::enableDepthClamp(bool enable)
+	{
+		changeState(mImpl->mState.enableDepthClamp, enable);
+	}
+
+	void DepthBuffer::setDefaultDepthFunc(CompFunc depthFunc)
+	{
+		changeState(mImpl->mState.depthFunc, depthFunc);
+	}
+
+	void DepthBuffer::setDepthRange(const Range& range)
+	{
+		changeState(mImpl->mState.depthRange.nearVal, range.nearVal);
+		changeState(mImpl->mState.depthRange.farVal, range.farVal);
+	}
+
+	void DepthBuffer::setState(const State& state)
+	{
+		enableDepthBufferWriting(state.enableDepthBufferWriting);
+		enableDepthTest(state.enableDepthTest);
+		enableDepthClamp(state.enableDepthClamp);
+		setDefaultDepthFunc(state.depthFunc);
+		setDepthRange(state.depthRange);
+	}
+
+
+	Rasterizer::Rasterizer() : mImpl(std::make_unique<Rasterizer::Impl>())
+	{
+	}
+
+	void Rasterizer::setFillMode(FillMode fillMode)
+	{
+		changeState(mImpl->mState.fillMode, fillMode);
+	}
+
+	void Rasterizer::setCullMode(PolygonSide faceSide)
+	{
+		changeState(mImpl->mState.cullMode, faceSide);
+	}
+
+	void Rasterizer::setWindingOrder(WindingOrder order)
+	{
+		changeState(mImpl->mState.windingOrder, order);
+	}
+
+	void Rasterizer::setDepthBias(float slopeScale, float unit, float clamp)
+	{
+		changeState(mImpl->mState.slopeScaledDepthBias, slopeScale);
+		changeState(mImpl->mState.depthBias, unit);
+		changeState(mImpl->mState.depthBiasClamp, clamp);
+	}
+
+	void Rasterizer::setState(const RasterizerState& state)
+	{
+		setFillMode(state.fillMode);
+		setCullMode(state.cullMode);
+		setWindingOrder(state.windingOrder);
+		setDepthBias(state.slopeScaledDepthBias, state.depthBias, state.depthBiasClamp);
+		enableFaceCulling(state.enableFaceCulling);
+		enableScissorTest(state.enableScissorTest);
+		enableMultisample(state.enableMultisample);
+		enableOffsetPolygonFill(state.enableOffsetPolygonFill);
+		enableOffsetLine(state.enableOffsetLine);
+		enableOffsetPoint(state.enableOffsetPoint);
+	}
+
+	void Rasterizer::enableFaceCulling(bool enable)
+	{
+		changeState(mImpl->mState.enableFaceCulling, enable);
+	}
+
+	void Rasterizer::enableScissorTest(bool enable)
+	{
+		changeState(mImpl->mState.enableScissorTest, enable);
+	}
+
+	void Rasterizer::enableMultisample(bool enable)
+	{
+		changeState(mImpl->mState.enableMultisample, enable);
+	}
+
+	void Rasterizer::enableOffsetPolygonFill(bool enable)
+	{
+		changeState(mImpl->mState.enableOffsetPolygonFill, enable);
+	}
+
+	void Rasterizer::enableOffsetLine(bool enable)
+	{
+		changeState(mImpl->mState.enableOffsetLine, enable);
+	}
+
+	void Rasterizer::enableOffsetPoint(bool enable)
+	{
+		changeState(mImpl->mState.enableOffsetPoint, enable);
+	}
+
+
+	StencilTest::StencilTest() : mImpl(std::make_unique<StencilTest::Impl>())
+	{
+	}
+
+	void StencilTest::enableStencilTest(bool enable)
+	{
+		changeState(mImpl->mState.enableStencilTest, enable);
+	}
+
+	void StencilTest::setCompareFunc(CompFunc func, int referenceValue, unsigned mask)
+	{
+		changeState(mImpl->mState.compareFunc, func);
+		changeState(mImpl->mState.compareReferenceValue, referenceValue);
+		changeState(mImpl->mState.compareMask, mask);
+	}
+
+	void StencilTest::setOperations(Operation stencilFail, Operation depthFail, Operation depthPass)
+	{
+		changeState(mImpl->mState.stencilTestFailOperation, stencilFail);
+		changeState(mImpl->mState.depthTestFailOperation, depthFail);
+		changeState(mImpl->mState.depthPassOperation, depthPass);
+	}
+
+	void StencilTest::setState(const State& state)
+	{
+		enableStencilTest(state.enableStencilTest);
+		setCompareFunc(state.compareFunc, state.compareReferenceValue, state.compareMask);
+		setOperations(state.stencilTestFailOperation, state.depthTestFailOperation, state.depthPassOperation);
+	}
+
+
+	RenderBackend::Impl::Impl() : backgroundColor(0.0f, 0.0f, 0.0f),
+		defaultRenderTarget(nullptr),
+		m_logger("RenderBackend - HEADLESS"),
+		msaaSamples(1),
+		mPatchVertexCount(3)
+	{
+	}
+
+	RenderBackend::RenderBackend()
+	{
+	}
+
+	RenderBackend::~RenderBackend()
+	{
+	}
+
+	void RenderBackend::init(const Rectangle& viewport, unsigned msaaSamples)
+	{
+		mPimpl = std::make_unique<Impl>();
+
+		mPimpl->mViewport = viewport;
+		mPimpl->msaaSamples = msaaSamples;
+
+		LOG(mPimpl->m_logger, Info) << "Initializing...";
+
+		getRasterizer()->enableScissorTest(true);
+		setViewPort(0, 0, mPimpl->mViewport.width, mPimpl->mViewport.height);
+		setScissor(0, 0, mPimpl->mViewport.width, mPimpl->mViewport.height);
+
+		// The default render target has no attachments (as the default framebuffer of a real backend)
+		mPimpl->defaultRenderTarget = make_unique<RenderTarget2D>(make_unique<RenderTarget::Impl>(mPimpl->mViewport.width, mPimpl->mViewport.height));
+		mPimpl->defaultRenderTarget->bind();
+		mPimpl->defaultRenderTarget->clear(RenderComponent::Color);
+
+		getDepthBuffer()->enableDepthTest(true);
+		getDepthBuffer()->setDefaultDepthFunc(CompFunc::LESS);
+		getDepthBuffer()->enableDepthBufferWriting(true);
+
+		getRasterizer()->setWindingOrder(WindingOrder::COUNTER_CLOCKWISE);
+		getStencilTest()->enableStencilTest(true);
+		getRasterizer()->enableFaceCulling(true);
+		getRasterizer()->setCullMode(PolygonSide::BACK);
+		getStencilTest()->setCompareFunc(CompFunc::LESS, 0, 0xFF);
+
+		getBlender()->enableBlend(true);
+
+		setPointThickness(3.0f);
+
+		mPimpl->mScreenSprite.setPosition({ 0,0 });
+	}
+
+	void RenderBackend::initEffectLibrary()
+	{
+		mPimpl->mEffectLibrary = make_unique<EffectLibrary>(mPimpl->mViewport.width, mPimpl->mViewport.height);
+	}
+
+	std::unique_ptr<CubeDepthMap> RenderBackend::createCubeDepthMap(int width, int height)
+	{
+		return std::unique_ptr<CubeDepthMap>(CubeDepthMap::create(width, height));
+	}
+
+	std::unique_ptr<CubeRenderTarget> RenderBackend::createCubeRenderTarget(int width, int height, const TextureDesc& data)
+	{
+		return make_unique<CubeRenderTarget>(width, height, data);
+	}
+
+	RenderTarget2D* RenderBackend::getDefaultRenderTarget()
+	{
+		return mPimpl->defaultRenderTarget.get();
+	}
+
+	DepthBuffer* RenderBackend::getDepthBuffer()
+	{
+		return &mPimpl->mDepthBuffer;
+	}
+
+	std::unique_ptr <RenderTarget2D> RenderBackend::create2DRenderTarget(int width, int height, const TextureDesc& data, const TextureDesc& depthData, int samples) {
+		RenderAttachment depth;
+		depth.type = RenderAttachment::translate(depthData.internalFormat);
+
+		if (samples > 1) {
+			depth.texture = make_shared<Texture2DMultisample>(width, height, depthData, samples);
+		}
+		else {
+			depth.texture = make_shared<Texture2D>(width, height, depthData, nullptr);
+		}
+
+		auto result = make_unique<RenderTarget2D>(width, height, data, samples);
+		result->useDepthAttachment(std::move(depth));
+		result->finalizeAttachments();
+		return result;
+	}
+
+	std::unique_ptr <RenderTarget2D> RenderBackend::createRenderTarget(int samples)
+	{
+		const unsigned width = mPimpl->mViewport.width;
+		const unsigned height = mPimpl->mViewport.height;
+
+		TextureDesc depthData = TextureDesc::createDepth(CompFunc::LESS, InternalFormat::DEPTH32F_STENCIL8);
+
+		return create2DRenderTarget(width, height, TextureDesc::createRenderTargetRGBAHDR(), depthData, samples);
+	}
+
+	void RenderBackend::drawWithIndices(const RenderState& state, Topology topology, size_t indexCount, IndexElementType indexType, size_t byteOffset)
+	{
+		drawWithIndicesInstanced(1, state, topology, indexCount, indexType, byteOffset);
+	}
+
+	void RenderBackend::drawWithIndicesInstanced(	size_t instanceCount,
+													const RenderState& state,
+													Topology topology,
+													size_t indexCount,
+													IndexElementType indexType,
+													size_t byteOffset)
+	{
+		setRenderState(state);
+
+		auto* statistics = NullStatistics::get();
+		statistics->add(NullStatistics::Counter::DRAW_CALLS);
+		statistics->add(NullStatistics::Counter::DRAWN_INDICES, indexCount * instanceCount);
+		statistics->add(NullStatistics::Counter::DRAWN_INSTANCES, instanceCount);
+	}
+
+	void RenderBackend::flushPendingCommands()
+	{
+	}
+
+	RenderBackend* RenderBackend::get()
+	{
+		static thread_local  RenderBackend backend;
+		return &backend;
+	}
+
+	Blender * RenderBackend::getBlender()
+	{
+		return &mPimpl->mBlender;
+	}
+
+	unsigned RenderBackend::getMaxPatchVertexCount() const
+	{
+		// the minimum maximum required by OpenGL 4
+		return 32;
+	}
+
+	Rasterizer * RenderBackend::getRasterizer()
+	{
+		return &mPimpl->mRasterizer;
+	}
+
+	nex::Sprite* RenderBackend::getScreenSprite()
+	{
+		return &mPimpl->mScreenSprite;
+	}
+
+	StencilTest* RenderBackend::getStencilTest()
+	{
+		return &mPimpl->mStencilTest;
+	}
+
+	RendererType RenderBackend::getType() const
+	{
+		return HEADLESS;
+	}
+
+	const Rectangle& RenderBackend::getViewport() const
+	{
+		return mPimpl->mViewport;
+	}
+
+	void RenderBackend::resize(int width, int height)
+	{
+		mPimpl->mViewport.width = width;
+		mPimpl->mViewport.height = height;
+		mPimpl->defaultRenderTarget = make_unique<RenderTarget2D>(make_unique<RenderTarget::Impl>(mPimpl->mViewport.width, mPimpl->mViewport.height));
+		setViewPort(0, 0, width, height);
+		mPimpl->mEffectLibrary->resize(width, height);
+
+		mPimpl->mScreenSprite.setWidth(width);
+		mPimpl->mScreenSprite.setHeight(height);
+	}
+
+	void RenderBackend::release()
+	{
+		mPimpl.reset(nullptr);
+	}
+
+	void RenderBackend::syncMemoryWithGPU(int flags)
+	{
+	}
+
+	void RenderBackend::setBackgroundColor(const glm::vec3& color)
+	{
+		mPimpl->backgroundColor = color;
+	}
+
+	void RenderBackend::setLineThickness(float thickness)
+	{
+		assert(thickness >= 0.0f);
+	}
+
+	void RenderBackend::setPointThickness(float thickness)
+	{
+		assert(thickness >= 0.0f);
+	}
+
+	void RenderBackend::setMSAASamples(unsigned int samples)
+	{
+		mPimpl->msaaSamples = samples == 0 ? 1 : samples;
+	}
+
+	void RenderBackend::setPatchVertexCount(unsigned number)
+	{
+		assert(number >= 3 && number <= getMaxPatchVertexCount());
+		changeState(mPimpl->mPatchVertexCount, number);
+	}
+
+	void RenderBackend::setScissor(int x, int y, unsigned width, unsigned height)
+	{
+		NullStatistics::get()->add(NullStatistics::Counter::STATE_CHANGES);
+	}
+
+	void RenderBackend::setViewPort(int x, int y, int width, int height)
+	{
+		mPimpl->mViewport.x = x;
+		mPimpl->mViewport.y = y;
+		mPimpl->mViewport.width = width;
+		mPimpl->mViewport.height = height;
+
+		NullStatistics::get()->add(NullStatistics::Counter::STATE_CHANGES);
+	}
+
+	void RenderBackend::setRenderState(const RenderState& state)
+	{
+		auto* blender = getBlender();
+		auto* rasterizer = getRasterizer();
+		auto* depthBuffer = getDepthBuffer();
+
+		blender->enableBlend(state.doBlend);
+		blender->setBlendDesc(state.blendDesc);
+
+		depthBuffer->enableDepthTest(state.doDepthTest);
+		depthBuffer->enableDepthBufferWriting(state.doDepthWrite);
+		depthBuffer->setDefaultDepthFunc(state.depthCompare);
+
+		rasterizer->enableFaceCulling(state.doCullFaces);
+		rasterizer->setCullMode(state.cullSide);
+		rasterizer->setWindingOrder(state.windingOrder);
+		rasterizer->setFillMode(state.fillMode);
+	}
+
+	void RenderBackend::wait()
+	{
+	}
+
+	EffectLibrary* RenderBackend::getEffectLibrary()
+	{
+		return mPimpl->mEffectLibrary.get();
+	}
+
+	void RenderBackend::drawArray(const RenderState& state, Topology primitiveType, size_t startingIndex,
+		size_t indexCount)
+	{
+		drawArrayInstanced(state, primitiveType, startingIndex, indexCount, 1);
+	}
+
+	void RenderBackend::drawArrayInstanced(const RenderState& state, Topology primitiveType, size_t startingIndex,
+		size_t indexCount, size_t instanceCount)
+	{
+		setRenderState(state);
+
+		auto* statistics = NullStatistics::get();
+		statistics->add(NullStatistics::Counter::DRAW_CALLS);
+		statistics->add(NullStatistics::Counter::DRAWN_INDICES, indexCount * instanceCount);
+		statistics->add(NullStatistics::Counter::DRAWN_INSTANCES, instanceCount);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include <nex/renderer/RenderBackend.hpp>
+#include <nex/texture/Sprite.hpp>
+#include <nex/common/Log.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <map>
+
+namespace nex {
+
+	class RenderBackend::Impl
+	{
+	public:
+
+		Impl();
+
+	private:
+
+		friend RenderBackend;
+
+		glm::vec3 backgroundColor;
+		std::unique_ptr<EffectLibrary> mEffectLibrary;
+		std::unique_ptr<RenderTarget2D> defaultRenderTarget;
+
+		nex::Logger m_logger{ "RenderBackend" };
+		Blender mBlender;
+		DepthBuffer mDepthBuffer;
+		Rasterizer mRasterizer;
+		StencilTest mStencilTest;
+		Sprite mScreenSprite;
+		Rectangle mViewport;
+		unsigned int msaaSamples;
+		unsigned mPatchVertexCount;
+	};
+
+	/**
+	 * The state classes only keep the state for filtering redundant changes;
+	 * only real changes are counted as state changes (as a state cache of a real backend would do).
+	 */
+	class Blender::Impl
+	{
+	public:
+		friend Blender;
+		BlendState mState;
+		std::map<unsigned, RenderTargetBlendDesc> mRenderTargetBlendings;
+	};
+
+	class DepthBuffer::Impl
+	{
+	public:
+		friend DepthBuffer;
+		State mState;
+	};
+
+	class Rasterizer::Impl
+	{
+	public:
+		friend Rasterizer;
+		RasterizerState mState;
+	};
+
+	class StencilTest::Impl
+	{
+	public:
+		friend StencilTest;
+		State mState;
+	};
+
+	/**
+	 * Assigns a state value and counts a state change if the value differs from the current one.
+	 */
+	template<typename T>
+	void changeState(T& current, const T& value)
+	{
+		if (current == value) return;
+		current = value;
+		NullStatistics::get()->add(NullStatistics::Counter::STATE_CHANGES);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <nex/buffer/GpuBuffer.hpp>
+#include <nex/null/buffer/GpuBufferNull.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <cstring>
+
+nex::GpuBuffer::Impl::Impl(BufferTargetNull target) : mTarget(target)
+{
+	NullStatistics::get()->add(NullStatistics::Counter::BUFFER_CREATIONS);
+}
+
+
+nex::GpuBuffer::GpuBuffer(void* internalBufferType, size_t size, const void* data, UsageHint usage) :
+	mSize(size),
+	mUsageHint(usage),
+	mImpl(new Impl((BufferTargetNull)reinterpret_cast<size_t>(internalBufferType)))
+{
+	resize(mSize, data, mUsageHint);
+}
+
+nex::GpuBuffer::GpuBuffer(GpuBuffer&& other) :
+	mSize(other.mSize),
+	mUsageHint(other.mUsageHint),
+	mImpl(other.mImpl)
+{
+	other.mImpl = nullptr;
+}
+
+nex::GpuBuffer& nex::GpuBuffer::operator=(GpuBuffer&& o) {
+
+	if (this == &o) return *this;
+
+	this->mSize = o.mSize;
+	mUsageHint = o.mUsageHint;
+	std::swap(mImpl, o.mImpl);
+	return *this;
+}
+
+nex::GpuBuffer::~GpuBuffer() {
+	if (mImpl) delete mImpl;
+	mImpl = nullptr;
+};
+
+void nex::GpuBuffer::bind() const
+{
+}
+
+nex::GpuBuffer::Impl* nex::GpuBuffer::getImpl()
+{
+	return mImpl;
+}
+
+const nex::GpuBuffer::Impl* nex::GpuBuffer::getImpl() const
+{
+	return mImpl;
+}
+
+size_t nex::GpuBuffer::getSize() const
+{
+	return mSize;
+}
+
+nex::GpuBuffer::UsageHint nex::GpuBuffer::getUsageHint() const
+{
+	return mUsageHint;
+}
+
+void* nex::GpuBuffer::map(GpuBuffer::Access usage) const
+{
+	NullStatistics::get()->add(NullStatistics::Counter::BUFFER_MAPS);
+	return mImpl->mData.data();
+}
+
+void nex::GpuBuffer::unbind() const
+{
+}
+
+void nex::GpuBuffer::unmap() const
+{
+}
+
+void nex::GpuBuffer::update(size_t size, const void* data, size_t offset)
+{
+	auto* statistics = NullStatistics::get();
+	statistics->add(NullStatistics::Counter::BUFFER_UPLOADS);
+	statistics->add(NullStatistics::Counter::BUFFER_UPLOAD_BYTES, size);
+
+	if (data) memcpy(mImpl->mData.data() + offset, data, size);
+}
+
+void nex::GpuBuffer::syncWithGPU()
+{
+}
+
+void nex::GpuBuffer::resize(size_t size, const void* data, GpuBuffer::UsageHint hint, bool allowOrphaning)
+{
+	mUsageHint = hint;
+	mSize = size;
+	mImpl->mData.resize(size);
+
+	if (data) {
+		auto* statistics = NullStatistics::get();
+		statistics->add(NullStatistics::Counter::BUFFER_UPLOADS);
+		statistics->add(NullStatistics::Counter::BUFFER_UPLOAD_BYTES, size);
+		memcpy(mImpl->mData.data(), data, size);
+	}
+}
+
+
+
+void nex::ShaderBuffer::bindToTarget() const
+{
+	bindToTarget(mBinding);
+}
+
+void nex::ShaderBuffer::bindToTarget(unsigned binding) const
+{
+}
+
+unsigned nex::ShaderBuffer::getDefaultBinding() const
+{
+	return mBinding;
+}
+
+nex::ShaderBuffer::ShaderBuffer(unsigned int binding, void* internalBufferType, size_t size, const void* data, UsageHint usage) :
+	GpuBuffer(internalBufferType, size, data, usage), mBinding(binding)
+{
+}
+
+nex::ShaderBuffer::~ShaderBuffer() = default;
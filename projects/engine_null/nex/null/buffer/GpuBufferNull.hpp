@@ -0,0 +1,27 @@
+#pragma once
+#include <nex/buffer/GpuBuffer.hpp>
+#include <vector>
+
+namespace nex
+{
+	enum class BufferTargetNull
+	{
+		ARRAY_BUFFER = 1, // zero is reserved (it is passed as a void pointer)
+		ELEMENT_ARRAY_BUFFER,
+		SHADER_STORAGE_BUFFER,
+		UNIFORM_BUFFER,
+	};
+
+	class GpuBuffer::Impl {
+	public:
+
+		Impl(BufferTargetNull target);
+
+		BufferTargetNull mTarget;
+
+		/**
+		 * Host copy of the buffer content; provides the memory for mapping the buffer.
+		 */
+		std::vector<char> mData;
+	};
+}
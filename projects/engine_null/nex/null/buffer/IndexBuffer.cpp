@@ -0,0 +1,28 @@
+#include <nex/buffer/IndexBuffer.hpp>
+#include <nex/null/buffer/GpuBufferNull.hpp>
+
+nex::IndexBuffer::IndexBuffer(IndexElementType type, size_t count, const void* data, UsageHint usage) : IndexBuffer(usage)
+{
+	fill(type, count, data, usage);
+}
+
+nex::IndexBuffer::IndexBuffer(UsageHint usage) : GpuBuffer((void*)BufferTargetNull::ELEMENT_ARRAY_BUFFER, 0, nullptr, usage)
+{
+}
+
+nex::IndexBuffer::~IndexBuffer() = default;
+
+void nex::IndexBuffer::fill(IndexElementType type, size_t count, const void* data, UsageHint usage)
+{
+	mCount = count;
+	mType = type;
+
+	auto byteSize = sizeof(unsigned);
+	if (mType == IndexElementType::BIT_16) byteSize = sizeof(unsigned short);
+
+	resize(mCount * byteSize, data, usage);
+}
+
+void nex::IndexBuffer::unbindAny()
+{
+}
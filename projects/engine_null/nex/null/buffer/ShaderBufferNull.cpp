@@ -0,0 +1,18 @@
+#include <nex/buffer/ShaderBuffer.hpp>
+#include <nex/null/buffer/GpuBufferNull.hpp>
+
+
+nex::ShaderStorageBuffer::ShaderStorageBuffer(unsigned int binding, size_t size, void* data, UsageHint usage) :
+	ShaderBuffer(binding, (void*)BufferTargetNull::SHADER_STORAGE_BUFFER, size, data, usage)
+{
+}
+
+nex::ShaderStorageBuffer::~ShaderStorageBuffer() = default;
+
+
+nex::UniformBuffer::UniformBuffer(unsigned int binding, size_t size, void* data, UsageHint usage) :
+	ShaderBuffer(binding, (void*)BufferTargetNull::UNIFORM_BUFFER, size, data, usage)
+{
+}
+
+nex::UniformBuffer::~UniformBuffer() = default;
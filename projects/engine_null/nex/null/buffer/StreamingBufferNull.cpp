@@ -0,0 +1,54 @@
+#include <nex/buffer/StreamingBuffer.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace nex
+{
+	class StreamingBuffer::Impl
+	{
+	public:
+		/**
+		 * Host memory standing in for the persistently mapped buffer.
+		 */
+		std::vector<char> mData;
+	};
+}
+
+nex::StreamingBuffer::StreamingBuffer(size_t frameSize, unsigned frameCount) :
+	mImpl(std::make_unique<Impl>()),
+	mMapped(nullptr),
+	mAlignment(256), // the largest offset alignment common gpus require
+	mHead(0),
+	mFenceBegin(0),
+	mFrameAllocatedBytes(0),
+	mLastFrameAllocatedBytes(0),
+	mStallCount(0)
+{
+	const auto alignedFrameSize = (frameSize + mAlignment - 1) / mAlignment * mAlignment;
+	mCapacity = alignedFrameSize * std::max(frameCount, 1u);
+
+	mImpl->mData.resize(mCapacity);
+	mMapped = mImpl->mData.data();
+	NullStatistics::get()->add(NullStatistics::Counter::BUFFER_CREATIONS);
+}
+
+nex::StreamingBuffer::~StreamingBuffer() = default;
+
+void nex::StreamingBuffer::bindToTarget(const Allocation& allocation, Target target, unsigned binding) const
+{
+	auto* statistics = NullStatistics::get();
+	statistics->add(NullStatistics::Counter::STREAMED_RANGES);
+	statistics->add(NullStatistics::Counter::STREAMED_BYTES, allocation.size);
+}
+
+void* nex::StreamingBuffer::insertFence()
+{
+	return nullptr;
+}
+
+bool nex::StreamingBuffer::waitFence(void* fence)
+{
+	// There is no gpu, so fences are signaled immediately.
+	return false;
+}
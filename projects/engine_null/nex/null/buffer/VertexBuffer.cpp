@@ -0,0 +1,16 @@
+#include <nex/buffer/VertexBuffer.hpp>
+#include <nex/null/buffer/GpuBufferNull.hpp>
+
+nex::VertexBuffer::VertexBuffer(size_t size, const void* data, UsageHint usage) :
+	GpuBuffer((void*)BufferTargetNull::ARRAY_BUFFER, size, data, usage)
+{
+}
+
+nex::VertexBuffer::VertexBuffer(UsageHint usage) : GpuBuffer((void*)BufferTargetNull::ARRAY_BUFFER, 0, nullptr, usage)
+{
+}
+
+nex::VertexBuffer::~VertexBuffer() = default;
+
+void nex::VertexBuffer::unbindAny() {
+}
@@ -0,0 +1,66 @@
+#include <nex/mesh/VertexArray.hpp>
+#include <nex/buffer/GpuBuffer.hpp>
+#include <nex/mesh/VertexLayout.hpp>
+#include <nex/null/NullStatistics.hpp>
+
+namespace nex
+{
+	VertexArray::VertexArray() : mRendererID(0)
+	{
+	}
+
+	VertexArray::VertexArray(VertexArray&& other) noexcept :
+		mLayout(std::move(other.mLayout)),
+		mRendererID(other.mRendererID)
+	{
+		other.mRendererID = 0;
+	}
+
+	VertexArray& VertexArray::operator=(VertexArray&& o) noexcept
+	{
+		if (this == &o) return *this;
+
+		mLayout = std::move(o.mLayout);
+		this->mRendererID = o.mRendererID;
+		o.mRendererID = 0;
+
+		return *this;
+	}
+
+	VertexArray::~VertexArray() = default;
+
+	void VertexArray::bind() const
+	{
+		NullStatistics::get()->add(NullStatistics::Counter::STATE_CHANGES);
+	}
+
+	VertexLayout& VertexArray::getLayout() {
+		return mLayout;
+	}
+	const VertexLayout& VertexArray::getLayout() const {
+		return mLayout;
+	}
+
+	void VertexArray::init()
+	{
+		// only a marker that the vertex array is initialized
+		mRendererID = 1;
+
+		for (const auto& it : mLayout.getBufferLayoutMap())
+		{
+			assign(it.first, mLayout);
+		}
+	}
+
+	void VertexArray::setLayout(const VertexLayout& layout) {
+		mLayout = layout;
+	}
+
+	void VertexArray::unbind() const
+	{
+	}
+
+	void VertexArray::assign(const GpuBuffer* buffer, const VertexLayout& layout) {
+		NullStatistics::get()->add(NullStatistics::Counter::STATE_CHANGES, layout.getLayout(buffer)->attributes.size());
+	}
+}
@@ -0,0 +1,8 @@
+#include <nex/platform/glfw/WindowGLFW.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+
+void nex::WindowGLFW::createWindowWithRenderContext()
+{
+	// The null backend has no render context; SubSystemProviderHeadless has to be used for creating windows.
+	throw_with_trace(std::runtime_error("(Null)WindowGLFW::createWindowWithRenderContext: Error: The null render backend doesn't support GLFW windows!"));
+}
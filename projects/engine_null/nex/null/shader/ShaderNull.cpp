@@ -0,0 +1,7 @@
+#include <nex/shader/Shader.hpp>
+#include <nex/null/NullStatistics.hpp>
+
+void nex::ComputeShader::dispatch(unsigned workGroupsX, unsigned workGroupsY, unsigned workGroupsZ)
+{
+	NullStatistics::get()->add(NullStatistics::Counter::COMPUTE_DISPATCHES);
+}
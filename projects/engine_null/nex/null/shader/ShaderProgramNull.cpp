@@ -0,0 +1,204 @@
+#include <nex/null/shader/ShaderProgramNull.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <nex/exception/ShaderException.hpp>
+#include <nex/shader_generator/ShaderSourceFileGenerator.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+
+namespace nex
+{
+	/**
+	 * The currently bound shader program of the calling thread.
+	 */
+	static thread_local const ShaderProgram::Impl* boundProgram = nullptr;
+
+	static void countUniformUpdate()
+	{
+		NullStatistics::get()->add(NullStatistics::Counter::UNIFORM_UPDATES);
+	}
+
+	UniformLocation ShaderProgram::Impl::getLocation(const char* name) const
+	{
+		auto it = mLocations.find(name);
+		if (it != mLocations.end()) return it->second;
+
+		const auto location = (UniformLocation)mLocations.size();
+		mLocations.emplace(name, location);
+		return location;
+	}
+
+
+	std::unique_ptr<ShaderStage> ShaderStage::compileShaderStage(const ResolvedShaderStageDesc& desc)
+	{
+		return std::make_unique<ShaderStageNull>(desc.type);
+	}
+
+
+	ShaderProgram::ShaderProgram(std::unique_ptr<Impl> impl) : mImpl(std::move(impl))
+	{
+	}
+
+	ShaderProgram::~ShaderProgram() = default;
+
+	void ShaderProgram::bind()
+	{
+		if (boundProgram == mImpl.get()) return;
+		boundProgram = mImpl.get();
+		NullStatistics::get()->add(NullStatistics::Counter::SHADER_BINDS);
+	}
+
+	UniformLocation ShaderProgram::getUniformLocation(const char* name) const
+	{
+		return mImpl->getLocation(name);
+	}
+
+	UniformLocation ShaderProgram::getUniformBufferLocation(const char* name) const
+	{
+		return mImpl->getLocation(name);
+	}
+
+	int ShaderProgram::getUniformBufferBindingPoint(const char* name) const
+	{
+		return mImpl->getLocation(name);
+	}
+
+	UniformLocation ShaderProgram::getShaderStorageBufferLocation(const char* name) const
+	{
+		return mImpl->getLocation(name);
+	}
+
+	std::unique_ptr<ShaderProgram> ShaderProgram::create(
+		const ShaderFilePath& vertexFile,
+		const ShaderFilePath& fragmentFile,
+		const ShaderFilePath& tesselationControlShaderFile,
+		const ShaderFilePath& tesselationEvaluationShader,
+		const ShaderFilePath& geometryShaderFile,
+		const std::vector<std::string>& defines)
+	{
+		const bool useControlShader = tesselationControlShaderFile != nullptr;
+		const bool useEvaluationShader = tesselationEvaluationShader != nullptr;
+
+		if (vertexFile == nullptr || fragmentFile == nullptr)
+		{
+			throw_with_trace(ShaderException("nex::ShaderProgram::create: No vertex or fragment shader specified!"));
+		}
+
+		if (useControlShader != useEvaluationShader)
+		{
+			throw_with_trace(ShaderException("nex::ShaderProgram::create: Specified only one of the tesselation shader stages!"));
+		}
+
+		// The sources are still resolved, so that missing files and include errors show up as with a real backend.
+		std::vector<UnresolvedShaderStageDesc> unresolved;
+		unresolved.push_back({ vertexFile, ShaderStageType::VERTEX, defines });
+		if (useControlShader) unresolved.push_back({ tesselationControlShaderFile, ShaderStageType::TESSELATION_CONTROL, defines });
+		if (useEvaluationShader) unresolved.push_back({ tesselationEvaluationShader, ShaderStageType::TESSELATION_EVALUATION, defines });
+		if (geometryShaderFile) unresolved.push_back({ geometryShaderFile, ShaderStageType::GEOMETRY, defines });
+		unresolved.push_back({ fragmentFile, ShaderStageType::FRAGMENT, defines });
+
+		const auto programSources = ShaderSourceFileGenerator::get()->generate(unresolved);
+
+		std::vector<std::unique_ptr<ShaderStage>> stages;
+		for (const auto& desc : programSources.descs)
+		{
+			stages.emplace_back(ShaderStage::compileShaderStage(desc));
+		}
+
+		return create(stages);
+	}
+
+	std::unique_ptr<ShaderProgram> ShaderProgram::create(const std::vector<std::unique_ptr<ShaderStage>>& stages)
+	{
+		return std::make_unique<ShaderProgram>(std::make_unique<Impl>());
+	}
+
+	bool ShaderProgram::isBound() const
+	{
+		return boundProgram == mImpl.get();
+	}
+
+	void ShaderProgram::setBinding(UniformLocation locationID, unsigned bindingSlot)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setImageLayerOfTexture(UniformLocation locationID, const Texture* data, unsigned bindingSlot,
+		TextureAccess accessType, InternalFormat format, unsigned level, bool textureIsArray, unsigned layer)
+	{
+		NullStatistics::get()->add(NullStatistics::Counter::TEXTURE_BINDS);
+	}
+
+	void ShaderProgram::setInt(UniformLocation locationID, int data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setFloat(UniformLocation locationID, float data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setUInt(UniformLocation locationID, unsigned data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setUVec2(UniformLocation locationID, const glm::uvec2& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setUVec3(UniformLocation locationID, const glm::uvec3& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setUVec4(UniformLocation locationID, const glm::uvec4& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setVec2(UniformLocation locationID, const glm::vec2& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setVec3(UniformLocation locationID, const glm::vec3& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setVec4(UniformLocation locationID, const glm::vec4& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setMat2(UniformLocation locationID, const glm::mat2& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setMat3(UniformLocation locationID, const glm::mat3& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setMat4(UniformLocation locationID, const glm::mat4& data)
+	{
+		countUniformUpdate();
+	}
+
+	void ShaderProgram::setTexture(const Texture* texture, const Sampler* sampler, unsigned bindingSlot)
+	{
+		NullStatistics::get()->add(NullStatistics::Counter::TEXTURE_BINDS);
+	}
+
+	void ShaderProgram::setDebugName(const char* name)
+	{
+		mImpl->mDebugName = name;
+	}
+
+	void ShaderProgram::unbind()
+	{
+		if (isBound()) boundProgram = nullptr;
+	}
+}
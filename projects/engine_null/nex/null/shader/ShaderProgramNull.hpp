@@ -0,0 +1,29 @@
+#pragma once
+#include <nex/shader/ShaderProgram.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace nex
+{
+	/**
+	 * Shader stages aren't compiled by the null backend; a stage only keeps its type.
+	 */
+	class ShaderStageNull : public ShaderStage
+	{
+	public:
+		ShaderStageNull(ShaderStageType type) : ShaderStage(type) {}
+	};
+
+	/**
+	 * A shader program of the null backend hands out a unique location for every requested name.
+	 */
+	class ShaderProgram::Impl
+	{
+	public:
+
+		UniformLocation getLocation(const char* name) const;
+
+		std::string mDebugName;
+		mutable std::unordered_map<std::string, UniformLocation> mLocations;
+	};
+}
@@ -0,0 +1,260 @@
+#include <nex/null/texture/RenderTargetNull.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <nex/texture/Texture.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <cassert>
+#include <cmath>
+
+nex::RenderTarget::Impl::Impl(unsigned width, unsigned height) :
+	mDepthAttachment(std::make_unique<RenderAttachment>()), mWidth(width), mHeight(height)
+{
+}
+
+bool nex::RenderTarget::Impl::isDepthType(RenderAttachmentType type)
+{
+	return type != RenderAttachmentType::COLOR;
+}
+
+
+nex::RenderTarget::RenderTarget(std::unique_ptr<Impl> impl) : mImpl(std::move(impl))
+{
+}
+
+nex::RenderTarget::RenderTarget(unsigned width, unsigned height) : mImpl(std::make_unique<Impl>(width, height))
+{
+}
+
+nex::RenderTarget::~RenderTarget() = default;
+
+void nex::RenderTarget::addColorAttachment(RenderAttachment attachment)
+{
+	mImpl->mColorAttachments.emplace_back(std::move(attachment));
+}
+
+void nex::RenderTarget::assertCompletion() const
+{
+	assert(isComplete());
+}
+
+void nex::RenderTarget::bind()
+{
+	NullStatistics::get()->add(NullStatistics::Counter::RENDER_TARGET_BINDS);
+}
+
+void nex::RenderTarget::blit(RenderTarget* dest, const Dimension& sourceDim, int components)
+{
+	NullStatistics::get()->add(NullStatistics::Counter::RENDER_TARGET_BLITS);
+}
+
+void nex::RenderTarget::clear(int components, glm::vec4 color, float depth, int stencil) const
+{
+	NullStatistics::get()->add(NullStatistics::Counter::RENDER_TARGET_CLEARS);
+}
+
+void nex::RenderTarget::enableDrawToColorAttachments(bool enable) const
+{
+}
+
+void nex::RenderTarget::enableDrawToColorAttachment(unsigned index, bool enable)
+{
+}
+
+void nex::RenderTarget::enableReadFromColorAttachments() const
+{
+}
+
+void nex::RenderTarget::finalizeAttachments() const
+{
+}
+
+std::vector<nex::RenderAttachment>& nex::RenderTarget::getColorAttachments()
+{
+	return mImpl->mColorAttachments;
+}
+
+const std::vector<nex::RenderAttachment>& nex::RenderTarget::getColorAttachments() const
+{
+	return mImpl->mColorAttachments;
+}
+
+nex::Texture* nex::RenderTarget::getColorAttachmentTexture(std::size_t attachmentIndex) const
+{
+	return getColorAttachments()[attachmentIndex].texture.get();
+}
+
+nex::RenderAttachment* nex::RenderTarget::getDepthAttachment() const
+{
+	return mImpl->mDepthAttachment.get();
+}
+
+nex::RenderTarget::Impl* nex::RenderTarget::getImpl() const
+{
+	return mImpl.get();
+}
+
+unsigned nex::RenderTarget::getWidth() const
+{
+	return mImpl->mWidth;
+}
+
+unsigned nex::RenderTarget::getHeight() const
+{
+	return mImpl->mHeight;
+}
+
+bool nex::RenderTarget::isComplete() const
+{
+	return true;
+}
+
+void nex::RenderTarget::setImpl(std::unique_ptr<Impl> impl)
+{
+	mImpl = std::move(impl);
+}
+
+void nex::RenderTarget::resetAttachments(const std::vector<RenderAttachment>& attachments)
+{
+	mImpl->mColorAttachments.clear();
+
+	for (const auto& attachment : attachments)
+	{
+		if (Impl::isDepthType(attachment.type))
+			useDepthAttachment(attachment);
+		else
+			addColorAttachment(attachment);
+	}
+
+	finalizeAttachments();
+}
+
+void nex::RenderTarget::updateColorAttachment(unsigned index) const
+{
+}
+
+void nex::RenderTarget::updateDepthAttachment() const
+{
+}
+
+void nex::RenderTarget::useDepthAttachment(RenderAttachment attachment) const
+{
+	if (!Impl::isDepthType(attachment.type))
+	{
+		throw_with_trace(std::runtime_error("nex::RenderTarget::useDepthAttachment(): attachment isn't a depth-stencil component!"));
+	}
+
+	*mImpl->mDepthAttachment = std::move(attachment);
+}
+
+
+nex::RenderTarget2D::RenderTarget2D(std::unique_ptr<Impl> impl) : RenderTarget(std::move(impl))
+{
+}
+
+nex::RenderTarget2D::RenderTarget2D(int width, int height, const TextureDesc& data, unsigned samples) :
+	RenderTarget(std::make_unique<Impl>(width, height))
+{
+	RenderAttachment color;
+
+	if (samples > 1)
+	{
+		color.target = TextureTarget::TEXTURE2D_MULTISAMPLE;
+		color.texture = std::make_unique<Texture2DMultisample>(width, height, data, samples);
+	}
+	else
+	{
+		color.target = TextureTarget::TEXTURE2D;
+		color.texture = std::make_unique<Texture2D>(width, height, data, nullptr);
+	}
+
+	addColorAttachment(std::move(color));
+	finalizeAttachments();
+	assertCompletion();
+}
+
+unsigned nex::RenderTarget2D::getWidth() const
+{
+	return getImpl()->mWidth;
+}
+
+unsigned nex::RenderTarget2D::getHeight() const
+{
+	return getImpl()->mHeight;
+}
+
+nex::Texture2D* nex::RenderTarget2D::getColor0AttachmentTexture()
+{
+	return static_cast<Texture2D*>(getColorAttachmentTexture(0));
+}
+
+
+nex::CubeRenderTarget::CubeRenderTarget(int width, int height, TextureDesc data) :
+	RenderTarget(std::make_unique<Impl>(width, height))
+{
+	RenderAttachment color;
+	color.target = TextureTarget::CUBE_MAP;
+	color.type = RenderAttachmentType::COLOR;
+	color.texture = std::make_unique<CubeMap>(width, height, data);
+	addColorAttachment(std::move(color));
+
+	finalizeAttachments();
+}
+
+void nex::CubeRenderTarget::useSide(CubeMapSide side, unsigned mipLevel)
+{
+	bind();
+
+	auto& attachment = getColorAttachments()[0];
+	attachment.mipmapLevel = mipLevel;
+	attachment.side = side;
+	updateColorAttachment(0);
+}
+
+unsigned nex::CubeRenderTarget::getHeightMipLevel(unsigned mipMapLevel) const
+{
+	return (unsigned)(getHeight() * std::pow(0.5, mipMapLevel));
+}
+
+unsigned nex::CubeRenderTarget::getWidthMipLevel(unsigned mipMapLevel) const
+{
+	return (unsigned)(getWidth() * std::pow(0.5, mipMapLevel));
+}
+
+void nex::CubeRenderTarget::resizeForMipMap(unsigned mipMapLevel)
+{
+	auto* texture = dynamic_cast<Texture2D*>(getDepthAttachment()->texture.get());
+	if (texture) texture->resize(getWidthMipLevel(mipMapLevel), getHeightMipLevel(mipMapLevel), 1, false);
+}
+
+unsigned nex::CubeRenderTarget::getWidth() const
+{
+	return getImpl()->mWidth;
+}
+
+unsigned nex::CubeRenderTarget::getHeight() const
+{
+	return getImpl()->mHeight;
+}
+
+
+nex::CubeDepthMap* nex::CubeDepthMap::create(unsigned width, unsigned height)
+{
+	return new CubeDepthMap(width, height);
+}
+
+nex::CubeDepthMap::CubeDepthMap(int width, int height) : RenderTarget(std::make_unique<Impl>(width, height))
+{
+	TextureDesc desc;
+	desc.minFilter = TexFilter::Nearest;
+	desc.magFilter = TexFilter::Nearest;
+	desc.wrapS = desc.wrapR = desc.wrapT = UVTechnique::ClampToEdge;
+	desc.internalFormat = InternalFormat::DEPTH_COMPONENT32F;
+
+	RenderAttachment depth;
+	depth.texture = std::make_unique<CubeMap>(width, height, desc);
+	depth.type = RenderAttachmentType::DEPTH;
+	depth.target = TextureTarget::CUBE_MAP;
+	depth.side = CubeMapSide::POSITIVE_X;
+
+	useDepthAttachment(std::move(depth));
+	assertCompletion();
+}
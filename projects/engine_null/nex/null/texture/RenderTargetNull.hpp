@@ -0,0 +1,24 @@
+#pragma once
+#include <nex/texture/RenderTarget.hpp>
+#include <nex/texture/Attachment.hpp>
+#include <vector>
+
+namespace nex
+{
+	/**
+	 * A render target of the null backend only keeps its attachments.
+	 */
+	class RenderTarget::Impl
+	{
+	public:
+
+		Impl(unsigned width, unsigned height);
+
+		static bool isDepthType(RenderAttachmentType type);
+
+		std::vector<RenderAttachment> mColorAttachments;
+		std::unique_ptr<RenderAttachment> mDepthAttachment;
+		unsigned mWidth;
+		unsigned mHeight;
+	};
+}
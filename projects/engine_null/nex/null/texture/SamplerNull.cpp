@@ -0,0 +1,100 @@
+#include <nex/null/texture/SamplerNull.hpp>
+#include <nex/null/NullStatistics.hpp>
+
+using namespace nex;
+
+Sampler::Sampler(const SamplerDesc& samplerState) : mImpl(std::make_unique<Impl>())
+{
+	setState(samplerState);
+}
+
+Sampler::~Sampler() = default;
+
+void Sampler::bind(unsigned textureBindingSlot) const
+{
+	NullStatistics::get()->add(NullStatistics::Counter::TEXTURE_BINDS);
+}
+
+const Sampler::Impl* Sampler::getImpl() const
+{
+	return mImpl.get();
+}
+
+Sampler::Impl* Sampler::getImpl()
+{
+	return mImpl.get();
+}
+
+const SamplerDesc& Sampler::getState() const
+{
+	return mImpl->mState;
+}
+
+void Sampler::setMinFilter(TexFilter filter)
+{
+	mImpl->mState.minFilter = filter;
+}
+
+void Sampler::setMagFilter(TexFilter filter)
+{
+	mImpl->mState.magFilter = filter;
+}
+
+void Sampler::setAnisotropy(float anisotropy)
+{
+	mImpl->mState.maxAnisotropy = anisotropy;
+}
+
+void Sampler::useDepthComparison(bool use)
+{
+	mImpl->mState.useDepthComparison = use;
+}
+
+void Sampler::setCompareFunction(CompFunc compareFunction)
+{
+	mImpl->mState.compareFunction = compareFunction;
+}
+
+void Sampler::setWrapS(UVTechnique wrap)
+{
+	mImpl->mState.wrapS = wrap;
+}
+
+void Sampler::setWrapT(UVTechnique wrap)
+{
+	mImpl->mState.wrapT = wrap;
+}
+
+void Sampler::setWrapR(UVTechnique wrap)
+{
+	mImpl->mState.wrapR = wrap;
+}
+
+void Sampler::setBorderColor(const glm::vec4& color)
+{
+	mImpl->mState.borderColor = color;
+}
+
+void Sampler::setMinLOD(float lod)
+{
+	mImpl->mState.minLOD = (int)lod;
+}
+
+void Sampler::setMaxLOD(float lod)
+{
+	mImpl->mState.maxLOD = (int)lod;
+}
+
+void Sampler::setLodBias(float bias)
+{
+	mImpl->mState.biasLOD = bias;
+}
+
+void Sampler::setState(const SamplerDesc& desc)
+{
+	mImpl->mState = desc;
+}
+
+void Sampler::unbind(unsigned textureBindingSlot)
+{
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <nex/texture/Sampler.hpp>
+
+namespace nex
+{
+	/**
+	 * A sampler of the null backend only keeps its state.
+	 */
+	class Sampler::Impl
+	{
+	public:
+		SamplerDesc mState;
+	};
+}
@@ -0,0 +1,348 @@
+#include <nex/null/texture/TextureNull.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <nex/texture/Image.hpp>
+#include <nex/texture/Sampler.hpp>
+#include <atomic>
+#include <cstring>
+#include <cmath>
+
+namespace nex
+{
+	static uint64_t nextHandle()
+	{
+		static std::atomic<uint64_t> handle(1);
+		return handle.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Texture::Impl::Impl(TextureTarget target, const TextureDesc& desc, unsigned width, unsigned height, unsigned depth,
+		unsigned samples) :
+		mTarget(target), mTextureData(desc), mWidth(width), mHeight(height), mDepth(depth), mSamples(samples),
+		mTileCount(1, 1), mHandle(0)
+	{
+	}
+
+	std::unique_ptr<Texture::Impl> Texture::Impl::create(TextureTarget target, const TextureDesc& desc, unsigned width,
+		unsigned height, unsigned depth, unsigned samples, const TextureTransferDesc* data)
+	{
+		auto impl = std::make_unique<Impl>(target, desc, width, height, depth, samples);
+		NullStatistics::get()->add(NullStatistics::Counter::TEXTURE_CREATIONS);
+
+		impl->resize(width, height, depth, 1, desc.generateMipMaps);
+		if (data) impl->upload(*data);
+
+		return impl;
+	}
+
+	size_t Texture::Impl::calcByteSize(const ImageDesc& desc)
+	{
+		const size_t depth = desc.depth == 0 ? 1 : desc.depth;
+		return (size_t)desc.width * desc.height * depth * desc.calcPixelByteSize();
+	}
+
+	void Texture::Impl::resize(unsigned width, unsigned height, unsigned depth, unsigned mipmapCount, bool autoMipMapCount)
+	{
+		mWidth = width;
+		mHeight = height;
+		mDepth = depth;
+
+		unsigned levels = mipmapCount;
+		if (autoMipMapCount) {
+			levels = (unsigned)std::log2(std::min<unsigned>(width, std::max<unsigned>(height, 1))) + 1;
+		}
+
+		mTextureData.lodBaseLevel = 0;
+		mTextureData.lodMaxLevel = levels - 1;
+		mTextureData.minLOD = 0;
+		mTextureData.maxLOD = levels - 1;
+	}
+
+	void Texture::Impl::upload(const TextureTransferDesc& desc)
+	{
+		const auto byteSize = desc.dataByteSize != 0 ? desc.dataByteSize : calcByteSize(desc.imageDesc);
+
+		auto* statistics = NullStatistics::get();
+		statistics->add(NullStatistics::Counter::TEXTURE_UPLOADS);
+		statistics->add(NullStatistics::Counter::TEXTURE_UPLOAD_BYTES, byteSize);
+	}
+
+
+	Texture::~Texture() = default;
+
+	Texture::Texture(std::unique_ptr<Impl> impl) : mImpl(std::move(impl))
+	{
+	}
+
+	Texture* Texture::createFromImage(const StoreImage& store, const TextureDesc& d)
+	{
+		TextureDesc data = d;
+		data.minLOD = 0;
+		data.maxLOD = store.mipmapCount - 1;
+		data.lodBaseLevel = 0;
+		data.lodMaxLevel = store.mipmapCount - 1;
+
+		const auto& baseImageDesc = store.images[0][0].desc;
+		const bool isCubeMap = store.textureTarget == TextureTarget::CUBE_MAP;
+		const unsigned depth = isCubeMap ? 6 : 1;
+
+		auto impl = std::make_unique<Impl>(store.textureTarget, data, baseImageDesc.width, baseImageDesc.height, depth, 1);
+		NullStatistics::get()->add(NullStatistics::Counter::TEXTURE_CREATIONS);
+
+		for (const auto& side : store.images) {
+			for (const auto& image : side) {
+				TextureTransferDesc transfer;
+				transfer.imageDesc = image.desc;
+				impl->upload(transfer);
+			}
+		}
+
+		std::unique_ptr<Texture> result;
+
+		if (isCubeMap) {
+			result = std::make_unique<CubeMap>(std::move(impl));
+		} else {
+			result = std::make_unique<Texture2D>(std::move(impl));
+		}
+
+		return result.release();
+	}
+
+	std::unique_ptr<Texture> Texture::createView(Texture* original, TextureTarget target, unsigned startLevel, unsigned numLevel,
+		unsigned startLayer, unsigned numLayers, const TextureDesc& data)
+	{
+		const auto* originalImpl = original->getImpl();
+		auto impl = std::make_unique<Impl>(target, data, originalImpl->mWidth, originalImpl->mHeight, originalImpl->mDepth,
+			originalImpl->mSamples);
+		return std::make_unique<Texture>(std::move(impl));
+	}
+
+	void Texture::generateMipMaps()
+	{
+	}
+
+	TextureTarget Texture::getTarget() const
+	{
+		return mImpl->mTarget;
+	}
+
+	unsigned Texture::getMipMapCount() const
+	{
+		const auto& data = mImpl->mTextureData;
+		return data.lodMaxLevel - data.lodBaseLevel + 1;
+	}
+
+	bool Texture::hasNonBaseLevelMipMaps() const
+	{
+		return getMipMapCount() > 1;
+	}
+
+	const TextureDesc& Texture::getTextureData() const
+	{
+		return mImpl->mTextureData;
+	}
+
+	unsigned Texture::getWidth() const
+	{
+		return mImpl->mWidth;
+	}
+
+	unsigned Texture::getHeight() const
+	{
+		return mImpl->mHeight;
+	}
+
+	unsigned Texture::getDepth() const
+	{
+		return mImpl->mDepth;
+	}
+
+	const glm::uvec2& Texture::getTileCount() const
+	{
+		return mImpl->mTileCount;
+	}
+
+	void Texture::setTileCount(glm::uvec2 tileCount)
+	{
+		mImpl->mTileCount = tileCount;
+	}
+
+	Texture::Impl* Texture::getImpl() const
+	{
+		return mImpl.get();
+	}
+
+	void Texture::readback(TextureTransferDesc& desc) const
+	{
+		if (desc.data) memset(desc.data, 0, desc.dataByteSize);
+		NullStatistics::get()->add(NullStatistics::Counter::TEXTURE_READBACKS);
+	}
+
+	void Texture::setImpl(std::unique_ptr<Impl> impl)
+	{
+		mImpl = std::move(impl);
+	}
+
+	uint64_t Texture::getHandle()
+	{
+		if (mImpl->mHandle == 0) mImpl->mHandle = nextHandle();
+		return mImpl->mHandle;
+	}
+
+	uint64_t Texture::getHandleWithSampler(const Sampler& sampler)
+	{
+		return nextHandle();
+	}
+
+	void Texture::residentHandle(uint64_t handle)
+	{
+	}
+
+	void Texture::makeHandleNonResident(uint64_t handle)
+	{
+	}
+
+	void Texture::upload(const TextureTransferDesc& desc)
+	{
+		mImpl->upload(desc);
+	}
+
+
+	Texture1D::Texture1D(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	Texture1D::Texture1D(unsigned width, const TextureDesc& textureData, const TextureTransferDesc* data) :
+		Texture(Impl::create(TextureTarget::TEXTURE1D, textureData, width, 1, 1, 1, data))
+	{
+	}
+
+	void Texture1D::resize(unsigned width, unsigned mipmapCount, bool autoMipMapCount)
+	{
+		mImpl->resize(width, 1, 1, mipmapCount, autoMipMapCount);
+	}
+
+
+	Texture1DArray::Texture1DArray(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	Texture1DArray::Texture1DArray(unsigned width, unsigned height, const TextureDesc& textureData,
+		const TextureTransferDesc* data) :
+		Texture(Impl::create(TextureTarget::TEXTURE1D_ARRAY, textureData, width, height, 1, 1, data))
+	{
+	}
+
+	void Texture1DArray::resize(unsigned width, unsigned height, unsigned mipmapCount, bool autoMipMapCount)
+	{
+		mImpl->resize(width, height, 1, mipmapCount, autoMipMapCount);
+	}
+
+
+	Texture2D::Texture2D(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	Texture2D::Texture2D(unsigned width, unsigned height, const TextureDesc& textureData, const TextureTransferDesc* data) :
+		Texture(Impl::create(TextureTarget::TEXTURE2D, textureData, width, height, 1, 1, data))
+	{
+	}
+
+	void Texture2D::resize(unsigned width, unsigned height, unsigned mipmapCount, bool autoMipMapCount)
+	{
+		mImpl->resize(width, height, 1, mipmapCount, autoMipMapCount);
+	}
+
+
+	Texture2DMultisample::Texture2DMultisample(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	Texture2DMultisample::Texture2DMultisample(unsigned width, unsigned height, const TextureDesc& textureData,
+		unsigned samples) :
+		Texture(Impl::create(TextureTarget::TEXTURE2D_MULTISAMPLE, textureData, width, height, 1, samples, nullptr))
+	{
+	}
+
+	void Texture2DMultisample::resize(unsigned width, unsigned height)
+	{
+		mImpl->resize(width, height, 1, 1, false);
+	}
+
+	unsigned Texture2DMultisample::getSamples() const
+	{
+		return mImpl->mSamples;
+	}
+
+
+	Texture2DArray::Texture2DArray(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	Texture2DArray::Texture2DArray(unsigned width, unsigned height, unsigned depth, const TextureDesc& textureData,
+		const TextureTransferDesc* data) :
+		Texture(Impl::create(TextureTarget::TEXTURE2D_ARRAY, textureData, width, height, depth, 1, data))
+	{
+	}
+
+	void Texture2DArray::resize(unsigned width, unsigned height, unsigned depth, unsigned mipmapCount, bool autoMipMapCount)
+	{
+		mImpl->resize(width, height, depth, mipmapCount, autoMipMapCount);
+	}
+
+
+	Texture3D::Texture3D(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	Texture3D::Texture3D(unsigned width, unsigned height, unsigned depth, const TextureDesc& textureData,
+		const TextureTransferDesc* data) :
+		Texture(Impl::create(TextureTarget::TEXTURE3D, textureData, width, height, depth, 1, data))
+	{
+	}
+
+	void Texture3D::resize(unsigned width, unsigned height, unsigned depth, unsigned mipmapCount, bool autoMipMapCount)
+	{
+		mImpl->resize(width, height, depth, mipmapCount, autoMipMapCount);
+	}
+
+
+	RenderBuffer::RenderBuffer(unsigned width, unsigned height, int samples, const TextureDesc& data) :
+		Texture(Impl::create(TextureTarget::RENDER_BUFFER, data, width, height, 1, samples, nullptr))
+	{
+	}
+
+	InternalFormat RenderBuffer::getFormat() const
+	{
+		return mImpl->mTextureData.internalFormat;
+	}
+
+
+	CubeMap::CubeMap(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	CubeMap::CubeMap(unsigned sideWidth, unsigned sideHeight, const TextureDesc& data) :
+		Texture(Impl::create(TextureTarget::CUBE_MAP, data, sideWidth, sideHeight, 6, 1, nullptr))
+	{
+	}
+
+
+	CubeMapArray::CubeMapArray(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
+	{
+	}
+
+	CubeMapArray::CubeMapArray(unsigned sideWidth, unsigned sideHeight, unsigned depth, const TextureDesc& textureData,
+		const TextureTransferDesc* data) :
+		Texture(Impl::create(TextureTarget::CUBE_MAP_ARRAY, textureData, sideWidth, sideHeight, depth, 1, data))
+	{
+	}
+
+	unsigned CubeMapArray::getLayerFaces()
+	{
+		return mImpl->mDepth * 6;
+	}
+
+	void CubeMapArray::resize(unsigned sideWidth, unsigned sideHeight, unsigned depth, unsigned mipmapCount, bool autoMipMapCount)
+	{
+		mImpl->resize(sideWidth, sideHeight, depth, mipmapCount, autoMipMapCount);
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <nex/texture/Texture.hpp>
+
+namespace nex
+{
+	/**
+	 * A texture of the null backend only keeps its description; there is no storage for the texel data.
+	 */
+	class Texture::Impl
+	{
+	public:
+
+		Impl(TextureTarget target, const TextureDesc& desc, unsigned width, unsigned height, unsigned depth, unsigned samples);
+
+		/**
+		 * Creates a texture and uploads the transfer data (if it isn't null).
+		 */
+		static std::unique_ptr<Impl> create(TextureTarget target, const TextureDesc& desc, unsigned width, unsigned height,
+			unsigned depth, unsigned samples, const TextureTransferDesc* data);
+
+		/**
+		 * Provides the number of bytes of a (tightly packed) image.
+		 */
+		static size_t calcByteSize(const ImageDesc& desc);
+
+		void resize(unsigned width, unsigned height, unsigned depth, unsigned mipmapCount, bool autoMipMapCount);
+
+		void upload(const TextureTransferDesc& desc);
+
+		TextureTarget mTarget;
+		TextureDesc mTextureData;
+		unsigned mWidth;
+		unsigned mHeight;
+		unsigned mDepth;
+		unsigned mSamples;
+		glm::uvec2 mTileCount;
+		uint64_t mHandle;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <locale>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <ratio>
+#include <set>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/any.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/function/function1.hpp>
+#include <boost/predef.h>
+#include <boost/property_tree/ptree.hpp>
+
+#include <glm/glm.hpp>
@@ -1,6 +1,9 @@
 #include <nex/opengl/CacheGL.hpp>
 #include <nex/util/Macro.hpp>
 #include <nex/opengl/opengl.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+using Category = nex::StateChangeStatistics::Category;
 
 nex::CacheError::CacheError(const std::string& _Message): runtime_error(_Message)
 {
@@ -124,25 +127,33 @@ void nex::GlobalCacheGL::BindReadFramebuffer(GLuint framebuffer, bool ignoreErro
 	}
 }
 
-void nex::GlobalCacheGL::BindTextureUnit(GLuint unit, GLuint texture)
+void nex::GlobalCacheGL::BindSampler(GLuint unit, GLuint sampler)
 {
-	GLCall(glBindTextureUnit(unit, texture));
-	return;
-
-	static std::unordered_map<GLuint, GLuint> cache;
-	const auto it = cache.find(unit);
+	const bool issue = mSamplerUnits.update(unit, sampler);
+	StateChangeStatistics::add(Category::SAMPLER, issue);
+	if (issue) {
+		GLCall(glBindSampler(unit, sampler));
+	}
+}
 
-	if (it == cache.end() || it->second != texture || true)
-	{
-		cache[unit] = texture;
-		static bool test = false;
-		if (test) {
-			std::cout << "unit = " << unit << ", texture = " << texture << std::endl;
-		}
+void nex::GlobalCacheGL::BindTextureUnit(GLuint unit, GLuint texture)
+{
+	const bool issue = mTextureUnits.update(unit, texture);
+	StateChangeStatistics::add(Category::TEXTURE, issue);
+	if (issue) {
 		GLCall(glBindTextureUnit(unit, texture));
 	}
 }
 
+void nex::GlobalCacheGL::BindVertexArray(GLuint vertexArray)
+{
+	const bool issue = mVertexArray.update(vertexArray);
+	StateChangeStatistics::add(Category::VERTEX_ARRAY, issue);
+	if (issue) {
+		GLCall(glBindVertexArray(vertexArray));
+	}
+}
+
 GLint nex::GlobalCacheGL::GetConstInteger(GLenum pname)
 {
 	GLint result;
@@ -166,22 +177,22 @@ nex::ShaderCacheGL::ShaderCacheGL(GLuint program) : mProgram(program)
 {
 }
 
-void nex::ShaderCacheGL::Uniform1f(GLint location, GLfloat value)
+template<typename T>
+bool nex::ShaderCacheGL::updateUniform(ShadowArray<T>& values, GLint location, const T& value)
 {
 	EUCLID_DEBUG(assertActiveProgram());
-	GLCall(glUniform1f(location, value));
-	return;
-
-	const auto it = mUniform1fValues.find(location);
+	const bool issue = values.update(location, value);
+	StateChangeStatistics::add(Category::UNIFORM, issue);
+	return issue;
+}
 
-	if (it == mUniform1fValues.end() || it->second != value)
-	{
-		mUniform1fValues[location] = value;
+void nex::ShaderCacheGL::Uniform1f(GLint location, GLfloat value)
+{
+	if (updateUniform(mUniform1fValues, location, value)) {
 		GLCall(glUniform1f(location, value));
 	}
 }
 
-
 void nex::ShaderCacheGL::UseProgram()
 {
 	nex::GlobalCacheGL::get()->UseProgram(mProgram);
@@ -194,31 +205,78 @@ void nex::ShaderCacheGL::Revalidate()
 
 void nex::ShaderCacheGL::Uniform1i(GLint location, GLint value)
 {
-	EUCLID_DEBUG(assertActiveProgram());
-	GLCall(glUniform1i(location, value));
-	return;
-
-	const auto it = mUniform1iValues.find(location);
-
-	if (it == mUniform1iValues.end() || it->second != value)
-	{
-		mUniform1iValues[location] = value;
+	if (updateUniform(mUniform1iValues, location, value)) {
 		GLCall(glUniform1i(location, value));
 	}
 }
 
 void nex::ShaderCacheGL::Uniform1ui(GLint location, GLuint value)
 {
-	EUCLID_DEBUG(assertActiveProgram());
-	GLCall(glUniform1ui(location, value));
-	return;
+	if (updateUniform(mUniform1uiValues, location, value)) {
+		GLCall(glUniform1ui(location, value));
+	}
+}
 
-	const auto it = mUniform1uiValues.find(location);
+void nex::ShaderCacheGL::Uniform2f(GLint location, const glm::vec2& value)
+{
+	if (updateUniform(mUniform2fValues, location, value)) {
+		GLCall(glUniform2f(location, value.x, value.y));
+	}
+}
 
-	if (it == mUniform1uiValues.end() || it->second != value)
-	{
-		mUniform1uiValues[location] = value;
-		GLCall(glUniform1ui(location, value));
+void nex::ShaderCacheGL::Uniform3f(GLint location, const glm::vec3& value)
+{
+	if (updateUniform(mUniform3fValues, location, value)) {
+		GLCall(glUniform3f(location, value.x, value.y, value.z));
+	}
+}
+
+void nex::ShaderCacheGL::Uniform4f(GLint location, const glm::vec4& value)
+{
+	if (updateUniform(mUniform4fValues, location, value)) {
+		GLCall(glUniform4f(location, value.x, value.y, value.z, value.w));
+	}
+}
+
+void nex::ShaderCacheGL::Uniform2ui(GLint location, const glm::uvec2& value)
+{
+	if (updateUniform(mUniform2uiValues, location, value)) {
+		GLCall(glUniform2ui(location, value.x, value.y));
+	}
+}
+
+void nex::ShaderCacheGL::Uniform3ui(GLint location, const glm::uvec3& value)
+{
+	if (updateUniform(mUniform3uiValues, location, value)) {
+		GLCall(glUniform3ui(location, value.x, value.y, value.z));
+	}
+}
+
+void nex::ShaderCacheGL::Uniform4ui(GLint location, const glm::uvec4& value)
+{
+	if (updateUniform(mUniform4uiValues, location, value)) {
+		GLCall(glUniform4ui(location, value.x, value.y, value.z, value.w));
+	}
+}
+
+void nex::ShaderCacheGL::UniformMatrix2fv(GLint location, const glm::mat2& value)
+{
+	if (updateUniform(mUniformMatrix2Values, location, value)) {
+		GLCall(glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value)));
+	}
+}
+
+void nex::ShaderCacheGL::UniformMatrix3fv(GLint location, const glm::mat3& value)
+{
+	if (updateUniform(mUniformMatrix3Values, location, value)) {
+		GLCall(glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value)));
+	}
+}
+
+void nex::ShaderCacheGL::UniformMatrix4fv(GLint location, const glm::mat4& value)
+{
+	if (updateUniform(mUniformMatrix4Values, location, value)) {
+		GLCall(glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value)));
 	}
 }
 
@@ -240,11 +298,14 @@ nex::GlobalCacheGL::GlobalCacheGL() : mActiveProgram(GL_FALSE), mActiveDrawFrame
 
 void nex::GlobalCacheGL::UseProgram(GLuint program)
 {
-	//if (program != mActiveProgram)
-	//{
+	const bool issue = program != mActiveProgram;
+	StateChangeStatistics::add(Category::PROGRAM, issue);
+
+	if (issue)
+	{
 		mActiveProgram = program;
 		GLCall(glUseProgram(mActiveProgram));
-	//}
+	}
 }
 
 void nex::GlobalCacheGL::RevalidateProgram(GLuint program)
@@ -254,6 +315,22 @@ void nex::GlobalCacheGL::RevalidateProgram(GLuint program)
 	}
 }
 
+void nex::GlobalCacheGL::InvalidateSampler(GLuint sampler)
+{
+	// Note: deleted samplers are unbound from all units, but their names might be reused
+	mSamplerUnits.invalidateValue(sampler);
+}
+
+void nex::GlobalCacheGL::InvalidateTexture(GLuint texture)
+{
+	mTextureUnits.invalidateValue(texture);
+}
+
+void nex::GlobalCacheGL::InvalidateVertexArray(GLuint vertexArray)
+{
+	if (mVertexArray.get() == vertexArray) mVertexArray.invalidate();
+}
+
 GLuint nex::GlobalCacheGL::getActiveProgram() const 
 {
 	return mActiveProgram;
@@ -1,5 +1,9 @@
 #pragma once
 #include "glad/glad.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <nex/renderer/StateChangeStatistics.hpp>
+#include <nex/renderer/StateShadow.hpp>
 
 /**
  * Classes that cache opengl state in order to minimize expensive state changes
@@ -7,7 +11,6 @@
 
 namespace nex
 {
-
 	class CacheError : public std::runtime_error
 	{
 	public:
@@ -16,6 +19,12 @@ namespace nex
 		explicit CacheError(const char* _Message);
 	};
 
+	/**
+	 * Caches the bound objects of the OpenGL context (the context is bound to the render thread).
+	 * Objects have to be bound through the cache and deleted objects have to be reported (InvalidateXXX functions),
+	 * otherwise the cache might filter a required bind.
+	 * Requested and filtered binds are counted in StateChangeStatistics.
+	 */
 	class GlobalCacheGL
 	{
 	public:
@@ -27,7 +36,9 @@ namespace nex
 		void BindFramebuffer(GLuint framebuffer, bool rebind = false);
 		void BindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format);
 		void BindReadFramebuffer(GLuint framebuffer, bool ignoreErrors = false);
+		void BindSampler(GLuint unit, GLuint sampler);
 		void BindTextureUnit(GLuint unit, GLuint texture);
+		void BindVertexArray(GLuint vertexArray);
 
 		/**
 		 * Queries an integer from the driver that is constant (won't change at runtime).
@@ -44,10 +55,28 @@ namespace nex
 
 		void RevalidateProgram(GLuint program);
 
+		/**
+		 * Has to be called before a sampler is deleted.
+		 */
+		void InvalidateSampler(GLuint sampler);
+
+		/**
+		 * Has to be called before a texture is deleted.
+		 */
+		void InvalidateTexture(GLuint texture);
+
+		/**
+		 * Has to be called before a vertex array is deleted.
+		 */
+		void InvalidateVertexArray(GLuint vertexArray);
+
 	private:
 		GLuint mActiveProgram;
 		GLuint mActiveDrawFrameBuffer;
 		GLuint mActiveReadFrameBuffer;
+		ShadowValue<GLuint> mVertexArray;
+		ShadowArray<GLuint> mTextureUnits;
+		ShadowArray<GLuint> mSamplerUnits;
 		std::unordered_map<GLenum, GLint> mConstIntegers;
 
 		GlobalCacheGL();
@@ -59,6 +88,8 @@ namespace nex
 	 *
 	 * If EUCLID_ALL_OPTIMIZATIONS is NOT defined:
 	 * All caching function will check if the specified shader program is currently active. If not, a CacheError exception is thrown.
+	 *
+	 * Uniform values are shadowed per location; a location must only be set with one uniform type.
 	 */
 	class ShaderCacheGL {
 	public:
@@ -68,6 +99,15 @@ namespace nex
 		void Uniform1f(GLint location, GLfloat value);
 		void Uniform1i(GLint location, GLint value);
 		void Uniform1ui(GLint location, GLuint value);
+		void Uniform2f(GLint location, const glm::vec2& value);
+		void Uniform3f(GLint location, const glm::vec3& value);
+		void Uniform4f(GLint location, const glm::vec4& value);
+		void Uniform2ui(GLint location, const glm::uvec2& value);
+		void Uniform3ui(GLint location, const glm::uvec3& value);
+		void Uniform4ui(GLint location, const glm::uvec4& value);
+		void UniformMatrix2fv(GLint location, const glm::mat2& value);
+		void UniformMatrix3fv(GLint location, const glm::mat3& value);
+		void UniformMatrix4fv(GLint location, const glm::mat4& value);
 		void UseProgram();
 		void Revalidate();
 		
@@ -75,10 +115,24 @@ namespace nex
 	private:
 
 		GLuint mProgram;
-		std::unordered_map<GLint, GLfloat> mUniform1fValues;
-		std::unordered_map<GLint, GLint> mUniform1iValues;
-		std::unordered_map<GLint, GLuint> mUniform1uiValues;
-		
+		ShadowArray<GLfloat> mUniform1fValues;
+		ShadowArray<GLint> mUniform1iValues;
+		ShadowArray<GLuint> mUniform1uiValues;
+		ShadowArray<glm::vec2> mUniform2fValues;
+		ShadowArray<glm::vec3> mUniform3fValues;
+		ShadowArray<glm::vec4> mUniform4fValues;
+		ShadowArray<glm::uvec2> mUniform2uiValues;
+		ShadowArray<glm::uvec3> mUniform3uiValues;
+		ShadowArray<glm::uvec4> mUniform4uiValues;
+		ShadowArray<glm::mat2> mUniformMatrix2Values;
+		ShadowArray<glm::mat3> mUniformMatrix3Values;
+		ShadowArray<glm::mat4> mUniformMatrix4Values;
+
+		/**
+		 * Checks if a uniform value has to be uploaded and counts the request.
+		 */
+		template<typename T>
+		bool updateUniform(ShadowArray<T>& values, GLint location, const T& value);
 
 		void assertActiveProgram();
 	};
@@ -19,6 +19,15 @@ using namespace glm;
 
 namespace nex
 {
+	/**
+	 * Counts a requested render state change and checks if it has to be issued.
+	 */
+	static bool issueStateChange(bool changed)
+	{
+		StateChangeStatistics::add(StateChangeStatistics::Category::RENDER_STATE, changed);
+		return changed;
+	}
+
 	BlendDescGL::BlendDescGL(const BlendDesc& desc) :
 		source(translate(desc.source)),
 		destination(translate(desc.destination)),
@@ -26,6 +35,11 @@ namespace nex
 	{
 	}
 
+	bool BlendDescGL::operator==(const BlendDescGL& other) const
+	{
+		return source == other.source && destination == other.destination && operation == other.operation;
+	}
+
 	RenderTargetBlendDescGL::RenderTargetBlendDescGL() : RenderTargetBlendDescGL(RenderTargetBlendDesc())
 	{
 	}
@@ -47,15 +61,15 @@ namespace nex
 	Blender::Impl::Impl() :
 		mBlendDesc(BlendDesc())
 	{
-		glGetBooleanv(GL_BLEND, &mEnableBlend);
+		GLboolean enableBlend;
+		glGetBooleanv(GL_BLEND, &enableBlend);
+		mEnableBlend = ShadowValue<bool>(enableBlend == GL_TRUE, true);
 		glGetBooleanv(GL_SAMPLE_COVERAGE, (GLboolean*)&mEnableAlphaToCoverage);
 	}
 
 	void Blender::enableBlend(bool enable)
 	{
-		if (mImpl->mEnableBlend == enable) return;
-
-		mImpl->mEnableBlend = enable;
+		if (!issueStateChange(mImpl->mEnableBlend.update(enable))) return;
 
 		if (enable)
 		{
@@ -69,7 +83,7 @@ namespace nex
 
 	void Blender::enableAlphaToCoverage(bool enable)
 	{
-		if (mImpl->mEnableAlphaToCoverage == enable) return;
+		if (!issueStateChange(mImpl->mEnableAlphaToCoverage != enable)) return;
 		mImpl->mEnableAlphaToCoverage = enable;
 
 		if (enable)
@@ -84,24 +98,25 @@ namespace nex
 
 	void Blender::setSampleConverage(float sampleCoverage, bool invert)
 	{
-		mImpl->mSampleCoverage = sampleCoverage;
-		mImpl->mInvertSampleConverage = translate(invert);
-		GLCall(glSampleCoverage(mImpl->mSampleCoverage, mImpl->mInvertSampleConverage));
+		const auto invertGL = static_cast<GLboolean>(translate(invert));
+		if (!issueStateChange(mImpl->mSampleCoverage.update({ sampleCoverage, invertGL }))) return;
+		GLCall(glSampleCoverage(sampleCoverage, invertGL));
 	}
 
 	void Blender::setConstantBlendColor(const glm::vec4& color)
 	{
-		mImpl->mConstantBlendColor = color;
+		if (!issueStateChange(mImpl->mConstantBlendColor.update(color))) return;
 		GLCall(glBlendColor(color.r, color.g, color.b, color.a));
 	}
 
 	void Blender::setBlendDesc(const BlendDesc& desc)
 	{
 		// Translate description
-		mImpl->mBlendDesc = desc;
+		if (!issueStateChange(mImpl->mBlendDesc.update(desc))) return;
 
-		GLCall(glBlendEquation((GLenum)mImpl->mBlendDesc.operation));
-		GLCall(glBlendFunc((GLenum)mImpl->mBlendDesc.source, (GLenum)mImpl->mBlendDesc.destination));
+		const auto& descGL = mImpl->mBlendDesc.get();
+		GLCall(glBlendEquation((GLenum)descGL.operation));
+		GLCall(glBlendFunc((GLenum)descGL.source, (GLenum)descGL.destination));
 	}
 
 	void Blender::setState(const BlendState& state)
@@ -117,6 +132,9 @@ namespace nex
 	{
 		RenderTargetBlendDescGL descGL(blendDesc);
 		mImpl->mRenderTargetBlendings[blendDesc.colorAttachIndex] = descGL;
+		mImpl->mEnableBlend.invalidate();
+		mImpl->mBlendDesc.invalidate();
+		StateChangeStatistics::add(StateChangeStatistics::Category::RENDER_STATE, true);
 
 		if (blendDesc.enableBlend)
 		{
@@ -146,7 +164,7 @@ namespace nex
 
 	void DepthBuffer::enableDepthBufferWriting(bool enable)
 	{
-		//if (mImpl->mEnableDepthBufferWriting == enable) return;
+		if (!issueStateChange(mImpl->mEnableDepthBufferWriting != enable)) return;
 
 		mImpl->mEnableDepthBufferWriting = enable;
 		GLCall(glDepthMask(translate(mImpl->mEnableDepthBufferWriting)));
@@ -154,7 +172,7 @@ namespace nex
 
 	void DepthBuffer::enableDepthTest(bool enable)
 	{
-		//if (mImpl->mEnableDepthTest == enable) return;
+		if (!issueStateChange(mImpl->mEnableDepthTest != enable)) return;
 
 		mImpl->mEnableDepthTest = enable;
 
@@ -170,7 +188,7 @@ namespace nex
 
 	void DepthBuffer::enableDepthClamp(bool enable)
 	{
-		//if (mImpl->mEnableDepthClamp == enable) return;
+		if (!issueStateChange(mImpl->mEnableDepthClamp != enable)) return;
 
 		mImpl->mEnableDepthClamp = enable;
 
@@ -188,7 +206,7 @@ namespace nex
 	{
 		const auto translated = translate(depthFunc);
 
-		//if (mImpl->mDepthFunc == translated) return;
+		if (!issueStateChange(mImpl->mDepthFunc != translated)) return;
 
 		mImpl->mDepthFunc = translated;
 		GLCall(glDepthFunc((GLenum)mImpl->mDepthFunc));
@@ -196,7 +214,7 @@ namespace nex
 
 	void DepthBuffer::setDepthRange(const Range& range)
 	{
-		mImpl->mDepthRange = range;
+		if (!issueStateChange(mImpl->mDepthRange.update({ range.nearVal, range.farVal }))) return;
 		GLCall(glDepthRange(range.nearVal, range.farVal));
 	}
 
@@ -230,7 +248,7 @@ namespace nex
 	{
 		const auto fillModeGL = translate(fillMode);
 
-		if (mImpl->mFillModeCache.mode == fillModeGL) return;
+		if (!issueStateChange(mImpl->mFillModeCache.mode != fillModeGL)) return;
 
 		mImpl->mFillModeCache.mode = fillModeGL;
 		mImpl->mFillModeCache.side = PolygonSideGL::FRONT_BACK;
@@ -240,22 +258,21 @@ namespace nex
 	void nex::Rasterizer::setCullMode(PolygonSide faceSide)
 	{
 		const auto translated = translate(faceSide);
-		if (mImpl->mCullMode == translated) return;
+		if (!issueStateChange(mImpl->mCullMode != translated)) return;
 		mImpl->mCullMode = translated;
 		GLCall(glCullFace((GLenum)mImpl->mCullMode));
 	}
 
 	void Rasterizer::setWindingOrder(WindingOrder order)
 	{
-		mImpl->mWindingOrder = translate(order);
-		GLCall(glFrontFace((GLenum)mImpl->mWindingOrder));
+		const auto translated = translate(order);
+		if (!issueStateChange(mImpl->mWindingOrder.update(translated))) return;
+		GLCall(glFrontFace((GLenum)translated));
 	}
 
 	void nex::Rasterizer::setDepthBias(float slopeScale, float unit, float clamp)
 	{
-		mImpl->mDepthBias = unit;
-		mImpl->mSlopeScaledDepthBias = slopeScale;
-		mImpl->mDepthBiasClamp = clamp;
+		if (!issueStateChange(mImpl->mDepthBias.update({ slopeScale, unit, clamp }))) return;
 
 		//TODO use clamp with EXT_polygon_offset_clamp !
 		GLCall(glPolygonOffset(slopeScale, unit));
@@ -277,7 +294,7 @@ namespace nex
 
 	void nex::Rasterizer::enableFaceCulling(bool enable)
 	{
-		if (mImpl->mEnableFaceCulling == enable) return;
+		if (!issueStateChange(mImpl->mEnableFaceCulling != enable)) return;
 
 		mImpl->mEnableFaceCulling = enable;
 		if (enable)
@@ -292,7 +309,7 @@ namespace nex
 
 	void nex::Rasterizer::enableScissorTest(bool enable)
 	{
-		if (mImpl->mEnableScissorTest == enable) return;
+		if (!issueStateChange(mImpl->mEnableScissorTest != enable)) return;
 		mImpl->mEnableScissorTest = enable;
 
 		if (enable)
@@ -307,7 +324,7 @@ namespace nex
 
 	void nex::Rasterizer::enableMultisample(bool enable)
 	{
-		if (mImpl->mEnableMultisample == enable) return;
+		if (!issueStateChange(mImpl->mEnableMultisample != enable)) return;
 		mImpl->mEnableMultisample = enable;
 
 		if (enable)
@@ -322,7 +339,7 @@ namespace nex
 
 	void nex::Rasterizer::enableOffsetPolygonFill(bool enable)
 	{
-		if (mImpl->mEnableOffsetPolygonFill == enable) return;
+		if (!issueStateChange(mImpl->mEnableOffsetPolygonFill != enable)) return;
 		mImpl->mEnableOffsetPolygonFill = enable;
 
 		if (enable)
@@ -337,7 +354,7 @@ namespace nex
 
 	void nex::Rasterizer::enableOffsetLine(bool enable)
 	{
-		if (mImpl->mEnableOffsetLine == enable) return;
+		if (!issueStateChange(mImpl->mEnableOffsetLine != enable)) return;
 		mImpl->mEnableOffsetLine = enable;
 
 		if (enable)
@@ -352,7 +369,7 @@ namespace nex
 
 	void nex::Rasterizer::enableOffsetPoint(bool enable)
 	{
-		if (mImpl->mEnableOffsetPoint == enable) return;
+		if (!issueStateChange(mImpl->mEnableOffsetPoint != enable)) return;
 		mImpl->mEnableOffsetPoint = enable;
 
 		if (enable)
@@ -385,7 +402,7 @@ namespace nex
 
 	void StencilTest::enableStencilTest(bool enable)
 	{
-		if (mImpl->mEnableStencilTest == enable) return;
+		if (!issueStateChange(mImpl->mEnableStencilTest != enable)) return;
 		mImpl->mEnableStencilTest = enable;
 
 		if (mImpl->mEnableStencilTest)
@@ -401,7 +418,9 @@ namespace nex
 	void StencilTest::setCompareFunc(CompFunc func, int referenceValue, unsigned mask)
 	{
 		const auto translated = translate(func);
-		if (mImpl->mCompareFunc == translated && mImpl->mCompareReferenceValue == referenceValue && mImpl->mCompareMask == mask) return;
+		const bool changed = mImpl->mCompareFunc != translated || mImpl->mCompareReferenceValue != referenceValue 
+			|| mImpl->mCompareMask != mask;
+		if (!issueStateChange(changed)) return;
 
 
 		mImpl->mCompareFunc = translated;
@@ -417,9 +436,10 @@ namespace nex
 		const auto depthFailTrans = translate(depthFail);
 		const auto depthPassTrans = translate(depthPass);
 
-		if (mImpl->mStencilTestFailOperation == stencilFailTrans
-			&& mImpl->mDepthTestFailOperation == depthFailTrans
-			&& mImpl->mDepthPassOperation == depthPassTrans) return;
+		const bool changed = mImpl->mStencilTestFailOperation != stencilFailTrans
+			|| mImpl->mDepthTestFailOperation != depthFailTrans
+			|| mImpl->mDepthPassOperation != depthPassTrans;
+		if (!issueStateChange(changed)) return;
 
 
 		mImpl->mStencilTestFailOperation = stencilFailTrans;
@@ -2,6 +2,7 @@
 #include <nex/opengl/opengl.hpp>
 #include "nex/renderer/RenderBackend.hpp"
 #include <nex/texture/Sprite.hpp>
+#include <nex/opengl/CacheGL.hpp>
 
 namespace nex {
 
@@ -135,6 +136,8 @@ namespace nex {
 		BlendOperationGL operation;
 
 		BlendDescGL(const BlendDesc& desc);
+
+		bool operator==(const BlendDescGL& other) const;
 	};
 
 	struct RenderTargetBlendDescGL
@@ -155,12 +158,12 @@ namespace nex {
 
 	private:
 		friend Blender;
-		GLboolean mEnableBlend;
+		// Note: Per render target blending (setRenderTargetBlending) invalidates the global blend state.
+		ShadowValue<bool> mEnableBlend;
 		bool mEnableAlphaToCoverage;
-		float mSampleCoverage;
-		GLuint mInvertSampleConverage;
-		glm::vec4 mConstantBlendColor;
-		BlendDescGL mBlendDesc;
+		ShadowValue<std::pair<float, GLboolean>> mSampleCoverage;
+		ShadowValue<glm::vec4> mConstantBlendColor;
+		ShadowValue<BlendDescGL> mBlendDesc;
 
 		std::map<unsigned, RenderTargetBlendDescGL> mRenderTargetBlendings;
 
@@ -178,7 +181,7 @@ namespace nex {
 		GLboolean mEnableDepthTest;
 		GLboolean mEnableDepthClamp;
 		CompareFunctionGL mDepthFunc;
-		Range mDepthRange;
+		ShadowValue<glm::dvec2> mDepthRange;
 	};
 
 
@@ -199,12 +202,11 @@ namespace nex {
 
 		FillModeCache mFillModeCache;
 		PolygonSideGL mCullMode;
-		WindingOrderGL mWindingOrder;
+		ShadowValue<WindingOrderGL> mWindingOrder;
 
 		bool mFrontCounterClockwise;
-		float mDepthBias;
-		float mDepthBiasClamp;
-		float mSlopeScaledDepthBias;
+		// slope scaled depth bias, depth bias, depth bias clamp
+		ShadowValue<glm::vec3> mDepthBias;
 		//bool enableDepthClipable = false; // not possible in opengl
 		bool mEnableFaceCulling;
 		bool mEnableScissorTest;
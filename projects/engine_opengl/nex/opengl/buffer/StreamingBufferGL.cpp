@@ -0,0 +1,80 @@
+#include <nex/buffer/StreamingBuffer.hpp>
+#include <nex/opengl/opengl.hpp>
+#include <nex/opengl/CacheGL.hpp>
+#include <algorithm>
+
+namespace nex
+{
+	class StreamingBuffer::Impl
+	{
+	public:
+		GLuint mRendererID = GL_FALSE;
+	};
+}
+
+nex::StreamingBuffer::StreamingBuffer(size_t frameSize, unsigned frameCount) :
+	mImpl(std::make_unique<Impl>()),
+	mMapped(nullptr),
+	mHead(0),
+	mFenceBegin(0),
+	mFrameAllocatedBytes(0),
+	mLastFrameAllocatedBytes(0),
+	mStallCount(0)
+{
+	auto* cache = GlobalCacheGL::get();
+	const auto uniformAlignment = cache->GetConstInteger(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+	const auto storageAlignment = cache->GetConstInteger(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT);
+	mAlignment = static_cast<size_t>(std::max<GLint>({ uniformAlignment, storageAlignment, 4 }));
+
+	const auto alignedFrameSize = (frameSize + mAlignment - 1) / mAlignment * mAlignment;
+	mCapacity = alignedFrameSize * std::max(frameCount, 1u);
+
+	// A coherent mapping makes the written data visible to the gpu without explicit flushes.
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	GLCall(glCreateBuffers(1, &mImpl->mRendererID));
+	GLCall(glNamedBufferStorage(mImpl->mRendererID, mCapacity, nullptr, flags));
+	GLCall(mMapped = static_cast<char*>(glMapNamedBufferRange(mImpl->mRendererID, 0, mCapacity, flags)));
+}
+
+nex::StreamingBuffer::~StreamingBuffer()
+{
+	for (auto& range : mPendingRanges) {
+		GLCall(glDeleteSync(static_cast<GLsync>(range.fence)));
+	}
+	mPendingRanges.clear();
+
+	if (mImpl->mRendererID != GL_FALSE) {
+		GLCall(glUnmapNamedBuffer(mImpl->mRendererID));
+		GLCall(glDeleteBuffers(1, &mImpl->mRendererID));
+		mImpl->mRendererID = GL_FALSE;
+	}
+}
+
+void nex::StreamingBuffer::bindToTarget(const Allocation& allocation, Target target, unsigned binding) const
+{
+	const GLenum targetGL = target == Target::UNIFORM_BUFFER ? GL_UNIFORM_BUFFER : GL_SHADER_STORAGE_BUFFER;
+	GLCall(glBindBufferRange(targetGL, binding, mImpl->mRendererID, allocation.offset, allocation.size));
+}
+
+void* nex::StreamingBuffer::insertFence()
+{
+	GLCall(GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	return fence;
+}
+
+bool nex::StreamingBuffer::waitFence(void* fence)
+{
+	auto sync = static_cast<GLsync>(fence);
+
+	// Check first without flushing; in the common case the gpu is already done.
+	GLCall(GLenum status = glClientWaitSync(sync, 0, 0));
+	const bool stalled = status == GL_TIMEOUT_EXPIRED;
+
+	while (status == GL_TIMEOUT_EXPIRED) {
+		GLCall(status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+	}
+
+	GLCall(glDeleteSync(sync));
+	return stalled;
+}
@@ -5,6 +5,7 @@
 #include <nex/buffer/VertexBuffer.hpp>
 #include <nex/mesh/VertexLayout.hpp>
 #include <nex/opengl/buffer/GpuBufferGL.hpp>
+#include <nex/opengl/CacheGL.hpp>
 #include <nex/util/ExceptionHandling.hpp>
 
 namespace nex
@@ -74,6 +75,7 @@ namespace nex
 	{
 		if (mRendererID != GL_FALSE)
 		{
+			GlobalCacheGL::get()->InvalidateVertexArray(mRendererID);
 			GLCall(glDeleteVertexArrays(1, &mRendererID));
 			mRendererID = GL_FALSE;
 		}
@@ -81,7 +83,7 @@ namespace nex
 
 	void VertexArray::bind() const
 	{
-		GLCall(glBindVertexArray(mRendererID));
+		GlobalCacheGL::get()->BindVertexArray(mRendererID);
 	}
 
 	VertexLayout& VertexArray::getLayout() {
@@ -110,7 +112,7 @@ namespace nex
 
 	void VertexArray::unbind() const
 	{
-		GLCall(glBindVertexArray(0));
+		GlobalCacheGL::get()->BindVertexArray(GL_FALSE);
 	}
 
 	void VertexArray::assign(const GpuBuffer* buffer, const VertexLayout& layout) {
@@ -378,21 +378,21 @@ void nex::ShaderProgram::Impl::setMat2(UniformLocation locationID, const glm::ma
 {
 	GLint glID = locationID;
 	if (glID < 0) return;
-	GLCall(glUniformMatrix2fv(glID, 1, GL_FALSE, value_ptr(data)));
+	mCache.UniformMatrix2fv(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setMat3(UniformLocation locationID, const glm::mat3& data)
 {
 	GLint glID = locationID;
 	if (glID < 0) return;
-	GLCall(glUniformMatrix3fv(glID, 1, GL_FALSE, value_ptr(data)));
+	mCache.UniformMatrix3fv(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setMat4(UniformLocation locationID, const glm::mat4 & data)
 {
 	GLint glID = locationID;
 	if (glID < 0) return;
-	GLCall(glUniformMatrix4fv(glID, 1, GL_FALSE, value_ptr(data)));
+	mCache.UniformMatrix4fv(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setVec2(UniformLocation locationID, const glm::vec2& data)
@@ -400,7 +400,7 @@ void nex::ShaderProgram::Impl::setVec2(UniformLocation locationID, const glm::ve
 	GLint glID = locationID;
 	if (glID < 0) return;
 
-	GLCall(glUniform2f(glID, data.x, data.y));
+	mCache.Uniform2f(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setVec3(UniformLocation locationID, const glm::vec3& data)
@@ -408,7 +408,7 @@ void nex::ShaderProgram::Impl::setVec3(UniformLocation locationID, const glm::ve
 	GLint glID = locationID;
 	if (glID < 0) return;
 
-	GLCall(glUniform3f(glID, data.x, data.y, data.z));
+	mCache.Uniform3f(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setVec4(UniformLocation locationID, const glm::vec4& data)
@@ -416,7 +416,7 @@ void nex::ShaderProgram::Impl::setVec4(UniformLocation locationID, const glm::ve
 	GLint glID = locationID;
 	if (glID < 0) return;
 
-	GLCall(glUniform4f(glID, data.x, data.y, data.z, data.w));
+	mCache.Uniform4f(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setUVec2(UniformLocation locationID, const glm::uvec2& data)
@@ -424,7 +424,7 @@ void nex::ShaderProgram::Impl::setUVec2(UniformLocation locationID, const glm::u
 	GLint glID = locationID;
 	if (glID < 0) return;
 
-	GLCall(glUniform2ui(glID, data.x, data.y));
+	mCache.Uniform2ui(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setUVec3(UniformLocation locationID, const glm::uvec3& data)
@@ -432,7 +432,7 @@ void nex::ShaderProgram::Impl::setUVec3(UniformLocation locationID, const glm::u
 	GLint glID = locationID;
 	if (glID < 0) return;
 
-	GLCall(glUniform3ui(glID, data.x, data.y, data.z));
+	mCache.Uniform3ui(glID, data);
 }
 
 void nex::ShaderProgram::Impl::setUVec4(UniformLocation locationID, const glm::uvec4& data)
@@ -440,7 +440,7 @@ void nex::ShaderProgram::Impl::setUVec4(UniformLocation locationID, const glm::u
 	GLint glID = locationID;
 	if (glID < 0) return;
 
-	GLCall(glUniform4ui(glID, data.x, data.y, data.z, data.w));
+	mCache.Uniform4ui(glID, data);
 }
 
 void nex::ShaderProgram::Impl::unbind()
@@ -127,67 +127,6 @@ void nex::CubeRenderTargetGL::resizeForMipMap(unsigned int mipMapLevel) {
 	}
 }
 
-nex::RenderAttachmentType nex::RenderAttachment::translate(InternalFormat format)
-{
-	static nex::RenderAttachmentType const table[]
-	{
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-
-		RenderAttachmentType::COLOR,
-		RenderAttachmentType::COLOR,
-		
-
-		RenderAttachmentType::DEPTH_STENCIL,
-		RenderAttachmentType::DEPTH_STENCIL,
-
-		RenderAttachmentType::DEPTH,
-		RenderAttachmentType::DEPTH,
-		RenderAttachmentType::DEPTH,
-		RenderAttachmentType::DEPTH,
-
-		RenderAttachmentType::STENCIL
-	};
-
-	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
-	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: InternFormat and nex::RenderAttachment::Type table don't match!");
-
-	return table[(unsigned)format];
-}
-
 nex::RenderTarget::RenderTarget(std::unique_ptr<Impl> impl) : mImpl(std::move(impl))
 {
 }
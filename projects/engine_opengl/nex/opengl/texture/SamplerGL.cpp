@@ -2,6 +2,7 @@
 #include <nex/opengl/opengl.hpp>
 #include <nex/opengl/RenderBackendGL.hpp>
 #include <nex/opengl/texture/TextureGL.hpp>
+#include <nex/opengl/CacheGL.hpp>
 
 using namespace nex;
 
@@ -36,6 +37,7 @@ Sampler::Impl::Impl() :  mSamplerID(GL_FALSE)
 Sampler::Impl::~Impl()
 {
 	if (mSamplerID != GL_FALSE) {
+		GlobalCacheGL::get()->InvalidateSampler(mSamplerID);
 		GLCall(glDeleteSamplers(1, &mSamplerID));
 		mSamplerID = GL_FALSE;
 	}
@@ -48,7 +50,7 @@ GLuint Sampler::Impl::getID() const
 
 void Sampler::bind(unsigned textureBindingSlot) const
 {
-	GLCall(glBindSampler(textureBindingSlot, mImpl->getID()));
+	GlobalCacheGL::get()->BindSampler(textureBindingSlot, mImpl->getID());
 }
 
 const SamplerDesc& Sampler::getState() const
@@ -179,5 +181,5 @@ void Sampler::setState(const SamplerDesc& desc)
 
 void Sampler::unbind(unsigned textureBindingSlot)
 {
-	GLCall(glBindSampler(textureBindingSlot, GL_FALSE));
+	GlobalCacheGL::get()->BindSampler(textureBindingSlot, GL_FALSE);
 }
\ No newline at end of file
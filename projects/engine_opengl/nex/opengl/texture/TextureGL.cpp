@@ -16,25 +16,6 @@
 using namespace std;
 using namespace glm;
 
-std::vector<glm::mat4> nex::CubeMap::mViewLookAts = {
-	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f)), // right
-	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(-1.0f, 0.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f)), // left
-	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f), vec3(0.0f, 0.0f, 1.0f)), // top
-	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f), vec3(0.0f, 0.0f, -1.0f)), // bottom
-	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, 0.0f, 1.0f), vec3(0.0f, -1.0f, 0.0f)), // front
-	lookAt(vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, 0.0f, -1.0f), vec3(0.0f, -1.0f, 0.0f)) // back
-};
-
-const mat4& nex::CubeMap::getViewLookAtMatrix(CubeMapSide side)
-{
-	return mViewLookAts[(unsigned)side];
-}
-
-const std::vector<glm::mat4>& nex::CubeMap::getViewLookAts()
-{
-	return mViewLookAts;
-}
-
 nex::CubeMap::CubeMap(std::unique_ptr<Impl> impl) : Texture(std::move(impl))
 {
 }
@@ -114,276 +95,6 @@ void nex::CubeMapGL::upload(const TextureTransferDesc& desc)
 }
 
 
-nex::ColorSpace nex::getColorSpace(InternalFormat format)
-{
-	static ColorSpace const table[]
-	{
-		ColorSpace::R,
-		ColorSpace::RED_INTEGER,
-		ColorSpace::R,
-		ColorSpace::R,
-		ColorSpace::R,
-		ColorSpace::RED_INTEGER,
-		ColorSpace::RED_INTEGER,
-
-		ColorSpace::RG,
-		ColorSpace::RG_INTEGER,
-		ColorSpace::RG_INTEGER,
-		ColorSpace::RG,
-		ColorSpace::RG,
-		ColorSpace::RG,
-		ColorSpace::RG_INTEGER,
-		ColorSpace::RG_INTEGER,
-
-		ColorSpace::RGB,
-		ColorSpace::RGB,
-		ColorSpace::RGB,
-		ColorSpace::RGB,
-		ColorSpace::RGB,
-		ColorSpace::RGB,
-		ColorSpace::RGB,
-
-		ColorSpace::RGBA,
-		ColorSpace::RGBA,
-		ColorSpace::RGBA,
-		ColorSpace::RGBA,
-		ColorSpace::RGBA,
-		ColorSpace::RGBA,
-		ColorSpace::RGBA,
-
-		ColorSpace::RGBA,
-		ColorSpace::RGBA,
-
-		ColorSpace::RGB,
-		ColorSpace::RGBA,
-
-		ColorSpace::DEPTH_STENCIL,
-		ColorSpace::DEPTH_STENCIL,
-		ColorSpace::DEPTH,
-		ColorSpace::DEPTH,
-		ColorSpace::DEPTH,
-		ColorSpace::DEPTH,
-		ColorSpace::STENCIL
-	};
-
-	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
-	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: internal format to colorspace map doesn't match number of supported internal formats");
-
-	return table[(unsigned)format];
-}
-
-unsigned nex::getComponents(InternalFormat format)
-{
-	static unsigned const table[]
-	{
-		1,
-		1,
-		1,
-		1,
-		1,
-		1,
-		1,
-
-		2,
-		2,
-		2,
-		2,
-		2,
-		2,
-		2,
-		2,
-
-		3,
-		3,
-		3,
-		3,
-		3,
-		3,
-		3,
-
-		4,
-		4,
-		4,
-		4,
-		4,
-		4,
-		4,
-
-		4,
-		4,
-
-		3,
-		4,
-
-		2,
-		2,
-		1,
-		1,
-		1,
-		1,
-		1
-	};
-
-	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
-	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: internal format to pixel data type map doesn't match number of supported internal formats");
-
-	return table[(unsigned)format];
-}
-
-
-unsigned nex::getComponents(const ColorSpace colorSpace)
-{
-	static unsigned const table[]
-	{
-		1,
-		1,
-
-		2,
-		2,
-		
-		3,
-		3,
-		3,
-		3,
-
-		4,
-		4,
-		4,
-		4,
-
-		3,
-		4,
-
-		1,
-		1,
-		2,
-	};
-
-	static const unsigned size = (unsigned)ColorSpace::LAST - (unsigned)ColorSpace::FIRST + 1;
-	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: target descriptor list doesn't match number of supported targets");
-
-	return table[(unsigned)colorSpace];
-}
-
-unsigned nex::getPixelDataTypeByteSize(const PixelDataType pixelDataType)
-{
-	static unsigned const table[]
-	{
-		4,
-		2,
-		4,
-		1,
-		4,
-
-		2,
-		
-		4,
-		8,
-		2,
-		4,
-		4,
-
-		4
-
-
-	};
-
-	static const unsigned size = (unsigned)PixelDataType::LAST - (unsigned)PixelDataType::FIRST + 1;
-	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: pixel data type descriptor list doesn't match number of supported pixel data types");
-
-	return table[(unsigned)pixelDataType];
-}
-
-unsigned nex::getPixelDataTypePackedComponentsCount(const PixelDataType pixelDataType)
-{
-	static unsigned const table[]
-	{
-		1, 
-		1, 
-		1,
-		1,
-		1,
-
-		1,
-
-		2,
-		2,
-		1,
-		1,
-		4,
-
-		4
-	};
-
-	static const unsigned size = (unsigned)PixelDataType::LAST - (unsigned)PixelDataType::FIRST + 1;
-	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: pixel data type descriptor list doesn't match number of supported pixel data types");
-
-	return table[(unsigned)pixelDataType];
-}
-
-nex::InternalFormatType nex::getType(InternalFormat format) {
-	static InternalFormatType const table[]
-	{
-		InternalFormatType::NORMAL,
-		InternalFormatType::UINT,
-		InternalFormatType::NORMAL,
-		InternalFormatType::FLOAT,
-		InternalFormatType::FLOAT,
-		InternalFormatType::INT,
-		InternalFormatType::UINT,
-
-		InternalFormatType::NORMAL,
-		InternalFormatType::UINT,
-		InternalFormatType::SNORM,
-		InternalFormatType::NORMAL,
-		InternalFormatType::FLOAT,
-		InternalFormatType::FLOAT,
-		InternalFormatType::INT,
-		InternalFormatType::UINT,
-
-		InternalFormatType::NORMAL,
-		InternalFormatType::NORMAL,
-		InternalFormatType::NORMAL,
-		InternalFormatType::FLOAT,
-		InternalFormatType::FLOAT,
-		InternalFormatType::INT,
-		InternalFormatType::UINT,
-
-		InternalFormatType::NORMAL,
-		InternalFormatType::NORMAL,
-		InternalFormatType::FLOAT,
-		InternalFormatType::SNORM,
-		InternalFormatType::FLOAT,
-		InternalFormatType::INT,
-		InternalFormatType::UINT,
-
-		InternalFormatType::NORMAL,
-		InternalFormatType::UINT,
-
-		InternalFormatType::NORMAL,
-		InternalFormatType::NORMAL,
-
-		InternalFormatType::COMBINED,
-		InternalFormatType::COMBINED,
-		InternalFormatType::NORMAL,
-		InternalFormatType::NORMAL,
-		InternalFormatType::NORMAL,
-		InternalFormatType::FLOAT,
-		InternalFormatType::NORMAL
-	};
-
-	static const unsigned size = (unsigned)InternalFormat::LAST - (unsigned)InternalFormat::FIRST + 1;
-	static_assert(sizeof(table) / sizeof(table[0]) == size, "GL error: internal format type map doesn't match number of supported internal formats");
-
-	return table[(unsigned)format];
-
-}
-
-bool nex::isSRGB(InternalFormat format) {
-	return format == InternalFormat::SRGB8
-		|| format == InternalFormat::SRGBA8;
-}
-
 nex::RenderBuffer::RenderBuffer(unsigned width, unsigned height, int samples, const TextureDesc& data) : 
 	Texture(make_unique<RenderBufferGL>(width, height, samples, data))
 {
@@ -590,16 +301,6 @@ nex::Texture::Impl* nex::Texture::getImpl() const
 	return mImpl.get();
 }
 
-unsigned nex::Texture::getLevelZeroMipMapTextureSize()
-{
-	return std::max<unsigned>(getWidth(), getHeight());
-}
-
-unsigned nex::Texture::calcMipMapCount(unsigned levelZeroMipMapTextureSize)
-{
-	return std::log2<>(levelZeroMipMapTextureSize) + 1;
-}
-
 void nex::Texture::readback(TextureTransferDesc& desc) const
 {
 	const auto& imageDesc = desc.imageDesc;
@@ -825,6 +526,7 @@ void nex::Texture::Impl::resizeTexImage3D(GLuint textureID, GLint levels, unsign
 void nex::Texture::Impl::release()
 {
 	if (mTextureID != GL_FALSE) {
+		GlobalCacheGL::get()->InvalidateTexture(mTextureID);
 		GLCall(glDeleteTextures(1, &mTextureID));
 		mTextureID = GL_FALSE;
 	}
@@ -1349,11 +1051,6 @@ unsigned nex::CubeMapArray::getLayerFaces()
 	return ((CubeMapArrayGL*)mImpl.get())->getLayerFaces();
 }
 
-unsigned nex::CubeMapArray::getLayerFaceIndex(unsigned arrayIndex)
-{
-	return arrayIndex * 6;
-}
-
 void nex::CubeMapArray::resize(unsigned sideWidth, unsigned sideHeight, unsigned depth, unsigned mipmapCount, bool autoMipMapCount)
 {
 	((CubeMapArrayGL*)mImpl.get())->resize(sideWidth, sideHeight, depth, mipmapCount, autoMipMapCount);
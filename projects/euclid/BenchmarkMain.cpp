@@ -0,0 +1,86 @@
+#include <Euclid.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <nex/platform/headless/SubSystemProviderHeadless.hpp>
+#include <nex/mesh/MeshManager.hpp>
+#include <nex/texture/TextureManager.hpp>
+#include <nex/renderer/RenderBackend.hpp>
+#include <nex/renderer/Drawer.hpp>
+#include <nex/gui/ImGUI.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+/**
+ * Runs the engine headless with the null render backend and reports the cpu frame times.
+ * Usage: EuclidBenchmark [frameCount] [configFile] [recordingThreads]
+ * recordingThreads: maximum number of threads recording render commands (0: all threads; 1: serial drawing)
+ */
+
+static float percentile(const std::vector<float>& sorted, float p)
+{
+	if (sorted.empty()) return 0.0f;
+	const auto index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5f);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char** argv)
+{
+	const unsigned frameCount = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : 300;
+	const float frameTime = 1.0f / 60.0f;
+
+	nex::LogSink::get()->registerStream(&std::cout);
+	nex::LogSink::get()->startAsync();
+	nex::LoggerManager::get()->setMinLogLevel(nex::Warning);
+
+	nex::Logger logger("Benchmark");
+	auto* provider = nex::SubSystemProviderHeadless::get();
+	int result = EXIT_SUCCESS;
+
+	try {
+		if (!provider->init())
+		{
+			nex::throw_with_trace(std::runtime_error("Couldn't initialize window system!"));
+		}
+
+		nex::Euclid euclid(provider);
+		if (argc > 2) euclid.setConfigFileName(argv[2]);
+		if (argc > 3) nex::Drawer::setMaxRecordingThreads(static_cast<unsigned>(std::stoul(argv[3])));
+		euclid.init();
+		euclid.initScene();
+
+		// Frames still finalizing resources aren't representative; the statistics only cover the measured frames.
+		euclid.runFrames(10, frameTime);
+		nex::NullStatistics::get()->reset();
+
+		auto frameMilliseconds = euclid.runFrames(frameCount, frameTime);
+		std::sort(frameMilliseconds.begin(), frameMilliseconds.end());
+
+		std::cout << "frames: " << frameMilliseconds.size() << "\n"
+			<< "cpu frame time p50 (ms): " << percentile(frameMilliseconds, 0.5f) << "\n"
+			<< "cpu frame time p90 (ms): " << percentile(frameMilliseconds, 0.9f) << "\n"
+			<< "cpu frame time p99 (ms): " << percentile(frameMilliseconds, 0.99f) << "\n"
+			<< "cpu frame time max (ms): " << (frameMilliseconds.empty() ? 0.0f : frameMilliseconds.back()) << "\n"
+			<< *nex::NullStatistics::get() << std::endl;
+
+	} catch (const std::exception& e)
+	{
+		nex::ExceptionHandling::logExceptionWithStackTrace(logger, e);
+		result = EXIT_FAILURE;
+	} catch (...)
+	{
+		LOG(logger, nex::Fault) << "Unknown Exception occurred.";
+		result = EXIT_FAILURE;
+	}
+
+	nex::gui::ImGUI_Impl::get()->release();
+	nex::MeshManager::release();
+	nex::TextureManager::get()->release();
+	nex::RenderBackend::get()->release();
+
+	provider->terminate();
+
+	nex::LogSink::get()->stopAsync();
+
+	return result;
+}
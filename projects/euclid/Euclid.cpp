@@ -27,6 +27,7 @@
 #include <nex/GI/GlobalIllumination.hpp>
 #include "nex/resource/ResourceLoader.hpp"
 #include <memory>
+#include <chrono>
 #include <nex/gui/ParticleSystemGenerator.hpp>
 #include <nex/gui/vob/VobEditor.hpp>
 #include <nex/gui/vob/VobLoader.hpp>
@@ -63,6 +64,16 @@
 #include <nex/import/ImportScene.hpp>
 #include <nex/scene/VobBluePrint.hpp>
 #include <nex/gui/Gizmo.hpp>
+#include <nex/gui/ProfilerView.hpp>
+#include <nex/util/Profiler.hpp>
+#include <nex/util/AllocationCounter.hpp>
+#include <nex/util/FrameArena.hpp>
+#include <nex/util/StringUtils.hpp>
+#include <sstream>
+#include <unordered_map>
+#include <nex/renderer/StateChangeStatistics.hpp>
+#include <nex/buffer/StreamingBuffer.hpp>
+#include <nex/anim/BonePalette.hpp>
 
 using namespace nex;
 
@@ -74,11 +85,15 @@ Euclid::Euclid(SubSystemProvider* provider) :
 	mInput(nullptr),
 	mIsRunning(false),
 	mConfigFileName("config.ini"),
-	mSystemLogLevel(nex::Debug)
+	mSystemLogLevel(nex::Debug),
+	mFinalizeBudgetMillis(FinalizeScheduler::DEFAULT_BUDGET_MILLIS)
 {
 	mConfig.addOption("Logging", "logLevel", &mSystemLogLevelStr, std::string(""));
 	mConfig.addOption("General", "rootDirectory", (std::string*)nullptr, std::string("./"));
 	mConfig.addOption("Input", "language", &mKeyMapLanguageStr, std::string("US"));
+	mConfig.addOption("General", "finalizeBudgetMillis", &mFinalizeBudgetMillis, FinalizeScheduler::DEFAULT_BUDGET_MILLIS);
+	mConfig.addOption("General", "compressedResources", &mCompressedResourcesStr, std::string(""));
+	mConfig.addOption("General", "packages", &mPackagesStr, std::string(""));
 }
 
 Euclid::~Euclid()
@@ -110,6 +125,7 @@ void Euclid::init()
 	
 	mGlobals.init(Configuration::getGlobalConfiguration());
 	LOG(mLogger, nex::Info) << "root Directory = " << mGlobals.getRootDirectory();
+	mountPackages();
 
 
 	mWindow = createWindow();
@@ -290,22 +306,45 @@ void nex::Euclid::initScene()
 		nullptr,
 		nex::GpuBuffer::UsageHint::STREAM_DRAW);
 
+	mContext.instanceDataBuffer = std::make_shared<ShaderStorageBuffer>(INSTANCE_DATA_BUFFER_BINDING_POINT,
+		sizeof(InstanceData),
+		nullptr,
+		nex::GpuBuffer::UsageHint::STREAM_DRAW);
+
 	mContext.materialBuffer = std::make_shared<UniformBuffer>(SHADER_CONSTANTS_MATERIAL_BUFFER_BINDING_POINT,
 		sizeof(PerObjectData) * MAX_PER_OBJECT_MATERIAL_DATA,
 		nullptr,
 		nex::GpuBuffer::UsageHint::STREAM_DRAW);
 
+	// 8MB per frame; triple buffered
+	mContext.streamingBuffer = std::make_shared<StreamingBuffer>(8 * 1024 * 1024);
+	mContext.bonePalette = std::make_shared<BonePalette>();
+
 	updateShaderConstants();
 
 
+	// The background images of the default probes aren't needed until the scene is loaded; 
+	// decoding them can overlap with the scene loading.
+	TextureDesc hdrDesc;
+	hdrDesc.internalFormat = InternalFormat::RGB32F;
+
+	for (const char* background : { "textures/hdr/HDR_040_Field.hdr", 
+		"textures/hdr/HDR_Free_City_Night_Lights_Ref.hdr",
+		"textures/hdr/newport_loft.hdr",
+		"textures/hdr/grace_cathedral.hdr" }) {
+		ResourceLoader::get()->enqueue<void>([=]() {
+			TextureManager::get()->prefetchImage(background, true, hdrDesc, true);
+		}, ResourceLoader::JobPriority::Prefetch, ResourceLoader::JobAffinity::Any);
+	}
+
 	auto future = ResourceLoader::get()->enqueue<void>([=]() {
 		createScene(RenderEngine::getCommandQueue());
-	});
+	}, ResourceLoader::JobPriority::VisibleNow);
 
 	//std::this_thread::sleep_for(std::chrono::seconds(5));
 
 	ResourceLoader::get()->waitTillAllJobsFinished();
-	executeTasks();
+	executeTasks(true);
 
 	//mRenderer->getPbrTechnique()->getActive()->getCascadedShadow()->enable(false);
 
@@ -388,24 +427,26 @@ void Euclid::run()
 	mIsRunning = mWindow->hasFocus();
 	mWindow->activate();
 
-	auto* voxelConeTracer = mGlobalIllumination->getVoxelConeTracer();
-	updateRenderContext(0.0f);
-	updateShaderConstants();
-	ResourceLoader::get()->waitTillAllJobsFinished();
-	mRenderCommandQueue.useCameraCulling(mCamera.get());
-
-	if (voxelConeTracer->isActive()){
-		createVoxels();
-	}
+	prepareRun();
 
 	mTimer.reset();
 	mTimer.pause(!isRunning());
 
+	NEX_PROFILE_THREAD("Main");
+
 	while (mWindow->isOpen())
 	{
+		NEX_PROFILE_FRAME();
+		nex::AllocationCounter::markFrame();
+		nex::StateChangeStatistics::markFrame();
+		nex::FrameArena::get()->beginFrame();
+
 		// Poll input events before checking if the app is running, otherwise 
 		// the window is likely to hang or crash (at least on windows platform)
-		mWindowSystem->pollEvents();
+		{
+			NEX_PROFILE_SCOPE("Euclid::pollEvents");
+			mWindowSystem->pollEvents();
+		}
 
 		mTimer.update();
 		float frameTime = mTimer.getTimeDiffInSeconds();
@@ -415,10 +456,19 @@ void Euclid::run()
 
 		if (isRunning())
 		{
-			mCamera->update();
-			mControllerSM->frameUpdate(frameTime);
+			{
+				NEX_PROFILE_SCOPE("Euclid::updateControllers");
+				mCamera->update();
+				mControllerSM->frameUpdate(frameTime);
+			}
+
+			mContext.bonePalette->begin(*mContext.streamingBuffer);
 			renderFrame(frameTime);
 			updateVoxelTexture();
+			mContext.streamingBuffer->markFrame();
+			mContext.bonePalette->clear();
+
+			NEX_PROFILE_SCOPE("Window::swapBuffers");
 			mWindow->swapBuffers();
 		}
 		else
@@ -428,6 +478,59 @@ void Euclid::run()
 	}
 }
 
+std::vector<float> Euclid::runFrames(unsigned frameCount, float frameTime)
+{
+	mWindow->activate();
+	prepareRun();
+
+	std::vector<float> frameMilliseconds;
+	frameMilliseconds.reserve(frameCount);
+
+	NEX_PROFILE_THREAD("Main");
+
+	for (unsigned i = 0; i < frameCount && mWindow->isOpen(); ++i)
+	{
+		NEX_PROFILE_FRAME();
+		const auto start = std::chrono::high_resolution_clock::now();
+
+		nex::AllocationCounter::markFrame();
+		nex::StateChangeStatistics::markFrame();
+		nex::FrameArena::get()->beginFrame();
+
+		mWindowSystem->pollEvents();
+		executeTasks();
+
+		mCamera->update();
+		mControllerSM->frameUpdate(frameTime);
+
+		mContext.bonePalette->begin(*mContext.streamingBuffer);
+		renderFrame(frameTime);
+		updateVoxelTexture();
+		mContext.streamingBuffer->markFrame();
+		mContext.bonePalette->clear();
+		mWindow->swapBuffers();
+
+		const std::chrono::duration<float, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+		frameMilliseconds.push_back(duration.count());
+	}
+
+	return frameMilliseconds;
+}
+
+void Euclid::prepareRun()
+{
+	auto* voxelConeTracer = mGlobalIllumination->getVoxelConeTracer();
+	updateRenderContext(0.0f);
+	updateShaderConstants();
+	ResourceLoader::get()->waitTillAllJobsFinished();
+	mRenderCommandQueue.useCameraCulling(mCamera.get());
+	mRenderCommandQueue.useInstancing(true);
+	mRenderCommandQueue.useBonePalette(mContext.bonePalette.get());
+
+	if (voxelConeTracer->isActive()) {
+		createVoxels();
+	}
+}
 
 void Euclid::setConfigFileName(const char*  fileName)
 {
@@ -441,14 +544,23 @@ void Euclid::setRunning(bool isRunning)
 
 void Euclid::collectCommands() 
 {
+	NEX_PROFILE_SCOPE("Euclid::collectCommands");
+
 	mScene.acquireLock();
 
 	mScene.frameUpdate(mContext);
-	mScene.updateWorldTrafoHierarchyUnsafe(false);
-	mScene.calcSceneBoundingBoxUnsafe();
 
-	mRenderCommandQueue.clear();
-	mScene.collectRenderCommands(mRenderCommandQueue, false, mContext);
+	{
+		NEX_PROFILE_SCOPE("Scene::updateWorldTrafoHierarchy");
+		mScene.updateWorldTrafoHierarchyUnsafe(false);
+		mScene.calcSceneBoundingBoxUnsafe();
+	}
+
+	{
+		NEX_PROFILE_SCOPE("Scene::collectRenderCommands");
+		mRenderCommandQueue.clear();
+		mScene.collectRenderCommands(mRenderCommandQueue, false, mContext);
+	}
 
 	mRenderCommandQueue.sort();
 	mScene.setHasChangedUnsafe(false);
@@ -458,7 +570,7 @@ void Euclid::collectCommands()
 void Euclid::createScene(nex::RenderEngine::CommandQueue* commandQueue)
 {
 	LOG(mLogger, Info) << "create scene...";
-	mScene.acquireLock();
+	auto lock = mScene.acquireLock();
 	mScene.clearUnsafe();
 
 	mVobBluePrintCache.clear();
@@ -470,7 +582,7 @@ void Euclid::createScene(nex::RenderEngine::CommandQueue* commandQueue)
 	nex::SamplerDesc flameStructureTexDesc;
 	flameStructureTexDesc.wrapS = flameStructureTexDesc.wrapT = flameStructureTexDesc.wrapR
 		= UVTechnique::Repeat;
-	FlameMaterialLoader flameMaterialLoader(mFlameShader.get(),
+	auto flameMaterialLoader = std::make_shared<FlameMaterialLoader>(mFlameShader.get(),
 		TextureManager::get()->getImage("textures/misc/Flame4.psd"),
 		flameStructureTexDesc,
 		1.0f * glm::vec4(1.0f, 0.5f, 0.1f, 1.0f));
@@ -481,11 +593,13 @@ void Euclid::createScene(nex::RenderEngine::CommandQueue* commandQueue)
 
 	//TODO
 
-	PbrMaterialLoader materialLoader(deferred->getGeometryShaderProvider(), 
+	// Shared with the asynchronous vob loads
+	auto sharedMaterialLoader = std::make_shared<PbrMaterialLoader>(deferred->getGeometryShaderProvider(), 
 		deferred->getGeometryBonesShaderProvider(), 
 		forward->getShaderProvider(),
 		forward->getBoneShaderProvider(),
 		TextureManager::get());
+	auto& materialLoader = *sharedMaterialLoader;
 
 	// vob hierarchy test
 	if (false) {
@@ -544,10 +658,14 @@ void Euclid::createScene(nex::RenderEngine::CommandQueue* commandQueue)
 	//cerberus
 	if (true) {
 
-		auto cerberus = loadVob("meshes/cerberus/Cerberus.obj", commandQueue, materialLoader);
-		cerberus->getName() = "cerberus";
-		cerberus->setPositionLocalToParent(glm::vec3(0.0f, 2.0f, 0.0f));
-		mScene.addVobUnsafe(std::move(cerberus));
+		loadVobAsync("meshes/cerberus/Cerberus.obj", sharedMaterialLoader, [this](std::unique_ptr<Vob> cerberus) {
+			cerberus->getName() = "cerberus";
+			cerberus->setPositionLocalToParent(glm::vec3(0.0f, 2.0f, 0.0f));
+
+			auto lock = mScene.acquireLock();
+			mScene.addVobUnsafe(std::move(cerberus));
+			mScene.updateWorldTrafoHierarchyUnsafe(true);
+		}, ResourceLoader::JobPriority::VisibleNow);
 	}
 
 	
@@ -555,17 +673,20 @@ void Euclid::createScene(nex::RenderEngine::CommandQueue* commandQueue)
 	
 	if (true) {
 
-		auto sponzaVob = loadVob("meshes/sponza/sponzaSimple7.obj", commandQueue, materialLoader);
-		sponzaVob->getName() = "sponzaSimple1";
-		sponzaVob->setPositionLocalToParent(glm::vec3(0.0f, 0.0f, 0.0f));
-		sponzaVob->setIsStatic(true);
+		loadVobAsync("meshes/sponza/sponzaSimple7.obj", sharedMaterialLoader, [this](std::unique_ptr<Vob> sponzaVob) {
+			sponzaVob->getName() = "sponzaSimple1";
+			sponzaVob->setPositionLocalToParent(glm::vec3(0.0f, 0.0f, 0.0f));
+			sponzaVob->setIsStatic(true);
 
-		auto& materialData = sponzaVob->getPerObjectMaterialData();
+			auto& materialData = sponzaVob->getPerObjectMaterialData();
 
-		materialData.probesUsed = 0;
-		materialData.coneTracingUsed = 1;
+			materialData.probesUsed = 0;
+			materialData.coneTracingUsed = 1;
 
-		mScene.addVobUnsafe(std::move(sponzaVob));
+			auto lock = mScene.acquireLock();
+			mScene.addVobUnsafe(std::move(sponzaVob));
+			mScene.updateWorldTrafoHierarchyUnsafe(true);
+		}, ResourceLoader::JobPriority::VisibleNow);
 	}
 	
 
@@ -598,24 +719,28 @@ void Euclid::createScene(nex::RenderEngine::CommandQueue* commandQueue)
 	if (false) {
 		//meshContainer = MeshManager::get()->getModel("transparent/transparent.obj");
 
-		auto transparentVob3 = loadVob("meshes/transparent/transparent_intersected_resolved.obj", commandQueue, materialLoader);
+		loadVobAsync("meshes/transparent/transparent_intersected_resolved.obj", sharedMaterialLoader, 
+			[this, bobVobPtr](std::unique_ptr<Vob> transparentVob3) {
+			transparentVob3->getName() = "transparent - 3";
+			transparentVob3->setPositionLocalToParent(glm::vec3(-12.0f, 2.0f, 0.0f));
 
-		transparentVob3->getName() = "transparent - 3";
-		transparentVob3->setPositionLocalToParent(glm::vec3(-12.0f, 2.0f, 0.0f));
-
-		if (bobVobPtr) bobVobPtr->addChild(nex::make_not_owning(transparentVob3.get()));
-		mScene.addVobUnsafe(std::move(transparentVob3));
+			auto lock = mScene.acquireLock();
+			if (bobVobPtr) bobVobPtr->addChild(nex::make_not_owning(transparentVob3.get()));
+			mScene.addVobUnsafe(std::move(transparentVob3));
+		});
 
 
 
 		// flame test
-		auto flameVobBluePrint = loadVob("misc/plane_simple.obj", commandQueue, flameMaterialLoader);
-
-		auto flameVob = std::make_unique<Billboard>();
-		flameVob->setMeshGroup(nex::make_not_owning(flameVobBluePrint->getMeshGroup()));
-		flameVob->setPositionLocalToParent(glm::vec3(1.0, 0.246f, 3 + 0.056f));
-		flameVob->setRotationLocalToParent(glm::vec3(glm::radians(0.0f), glm::radians(-90.0f), glm::radians(0.0f)));
-		mScene.addVobUnsafe(std::move((std::unique_ptr<Vob>&)flameVob));
+		loadVobAsync("misc/plane_simple.obj", flameMaterialLoader, [this](std::unique_ptr<Vob> flameVobBluePrint) {
+			auto flameVob = std::make_unique<Billboard>();
+			flameVob->setMeshGroup(nex::make_not_owning(flameVobBluePrint->getMeshGroup()));
+			flameVob->setPositionLocalToParent(glm::vec3(1.0, 0.246f, 3 + 0.056f));
+			flameVob->setRotationLocalToParent(glm::vec3(glm::radians(0.0f), glm::radians(-90.0f), glm::radians(0.0f)));
+
+			auto lock = mScene.acquireLock();
+			mScene.addVobUnsafe(std::move((std::unique_ptr<Vob>&)flameVob));
+		});
 	}
 
 
@@ -754,18 +879,23 @@ Window* Euclid::createWindow()
 	return mWindowSystem->createWindow(desc);
 }
 
-void nex::Euclid::executeTasks()
+void nex::Euclid::executeTasks(bool flush)
 {
+	NEX_PROFILE_SCOPE("Euclid::executeTasks");
+
 	auto* commandQueue = RenderEngine::getCommandQueue();
+	auto* scheduler = RenderEngine::getFinalizeScheduler();
 	auto& exceptionQueue = ResourceLoader::get()->getExceptionQueue();
 
-	while (!commandQueue->empty()) {
-		auto task = commandQueue->pop();
-		task();
+	if (flush) {
+		scheduler->executeAll(commandQueue);
+	}
+	else {
+		scheduler->execute(commandQueue);
 	}
 
-	while (!exceptionQueue.empty()) {
-		auto& exception = exceptionQueue.pop();
+	std::shared_ptr<std::exception> exception;
+	if (exceptionQueue.try_pop(exception)) {
 		throw_with_trace(*exception);
 	}
 }
@@ -796,6 +926,54 @@ void Euclid::initRenderBackend()
 }
 
 
+void Euclid::mountPackages()
+{
+	// comma separated list of package files relative to the root directory
+	std::stringstream ss(mPackagesStr);
+	std::string package;
+
+	while (std::getline(ss, package, ',')) {
+		nex::util::Trim::trim(package);
+		if (package.empty()) continue;
+
+		try {
+			FileSystem::mountPackage(mGlobals.getRootDirectory() + package, mGlobals.getCompiledResourceDirectoy());
+		}
+		catch (const std::exception& e) {
+			LOG(mLogger, nex::Error) << "Couldn't mount package " << package << " : " << e.what();
+		}
+	}
+}
+
+void Euclid::setupCompression()
+{
+	// comma separated list of compiled resource types, that are written compressed
+	const std::unordered_map<std::string, FileSystem::CompiledType> types = {
+		{ "meshes", FileSystem::CompiledType::MESH },
+		{ "textures", FileSystem::CompiledType::TEXTURE },
+		{ "probes", FileSystem::CompiledType::PROBE },
+		{ "rigs", FileSystem::CompiledType::RIG },
+	};
+
+	for (const auto& it : types) FileSystem::setCompression(it.second, false);
+
+	std::stringstream ss(mCompressedResourcesStr);
+	std::string type;
+
+	while (std::getline(ss, type, ',')) {
+		nex::util::Trim::trim(type);
+		if (type.empty()) continue;
+
+		auto it = types.find(type);
+		if (it == types.end()) {
+			LOG(mLogger, nex::Warning) << "Unknown compiled resource type for compression: " << type;
+			continue;
+		}
+
+		FileSystem::setCompression(it->second, true);
+	}
+}
+
 void Euclid::readConfig()
 {
 	LOG(mLogger, nex::Info) << "Loading configuration file...";
@@ -840,6 +1018,15 @@ void Euclid::readConfig()
 	}
 
 
+	if (mFinalizeBudgetMillis <= 0.0f) {
+		LOG(mLogger, nex::Warning) << "Invalid finalize budget: " << mFinalizeBudgetMillis << " ms. Default value is used.";
+		mFinalizeBudgetMillis = FinalizeScheduler::DEFAULT_BUDGET_MILLIS;
+	}
+
+	RenderEngine::getFinalizeScheduler()->setBudget(mFinalizeBudgetMillis);
+	setupCompression();
+
+
 	nex::LoggerManager::get()->setMinLogLevel(mSystemLogLevel);
 	mConfig.write(mConfigFileName);
 }
@@ -857,6 +1044,8 @@ void nex::Euclid::createVoxels()
 
 void nex::Euclid::renderFrame(float frameTime)
 {
+	NEX_PROFILE_SCOPE("Euclid::renderFrame");
+
 	auto* gui = nex::gui::ImGUI_Impl::get();
 	auto* backend = RenderBackend::get();
 	auto* screenSprite = backend->getScreenSprite();
@@ -905,6 +1094,7 @@ void nex::Euclid::renderFrame(float frameTime)
 	}
 	else
 	{
+		NEX_PROFILE_SCOPE("Renderer::render");
 		mRenderer->render(mRenderCommandQueue, mContext, false);
 		const auto& renderLayer = mRenderer->getRenderLayers()[mRenderer->getActiveRenderLayer()];
 		texture = renderLayer.textureProvider();
@@ -924,6 +1114,8 @@ void nex::Euclid::renderFrame(float frameTime)
 	}
 
 	mCurrentSunDir = mSun.directionWorld;
+
+	NEX_PROFILE_SCOPE("Euclid::renderGUI");
 	mControllerSM->getDrawable()->drawGUI();
 	ImGui::Render();
 	gui->renderDrawData(ImGui::GetDrawData());
@@ -1182,6 +1374,14 @@ void Euclid::setupGUI()
 	root->addChild(move(voxelConeTracerViewWindow));
 
 
+	auto profilerView = std::make_unique<nex::gui::ProfilerView>(
+		"Profiler",
+		root->getMainMenuBar(),
+		root->getToolsMenu());
+	profilerView->useStyleClass(std::make_shared<nex::gui::ConfigurationStyle>());
+	root->addChild(move(profilerView));
+
+
 
 	auto imguiDemoWindow = std::make_unique<nex::gui::MenuDrawable>(
 		"ImGui Demo",
@@ -1380,29 +1580,56 @@ nex::Texture* nex::Euclid::visualizeVoxels()
 	return tempRT->getColorAttachmentTexture(0);
 }
 
-std::unique_ptr<nex::Vob> nex::Euclid::loadVob(const std::filesystem::path& p,
-	nex::RenderEngine::CommandQueue* commandQueue, 
-	const AbstractMaterialLoader& materialLoader,
-	const nex::FileSystem* fileSystem)
+void nex::Euclid::loadVobAsync(const std::filesystem::path& p,
+	std::shared_ptr<const AbstractMaterialLoader> materialLoader,
+	std::function<void(std::unique_ptr<Vob>)> onLoaded,
+	ResourceLoader::JobPriority priority)
 {
-	if (!fileSystem) fileSystem = &MeshManager::get()->getFileSystem();
-
-	auto path = fileSystem->resolvePath(p);
+	auto* meshManager = MeshManager::get();
+	auto path = meshManager->getFileSystem().resolvePath(p);
 	auto id = SID(path.generic_string());
-	auto* bluePrintPtr = mVobBluePrintCache.getCachedPtr(id);
 
-	if (!bluePrintPtr) {
-		auto vob = MeshManager::get()->loadVobHierarchy(path, materialLoader, 1.0f);
+	const auto finalizePriority = priority == ResourceLoader::JobPriority::VisibleNow ? FinalizeScheduler::Priority::VisibleNow
+		: priority == ResourceLoader::JobPriority::Prefetch ? FinalizeScheduler::Priority::Prefetch 
+		: FinalizeScheduler::Priority::Normal;
 
-		commandQueue->push([vobPtr = vob.get()]() {
-			vobPtr->finalizeMeshes();
+	// Vobs of a blue-print share its meshes, so they are handed out after the meshes are finalized.
+	// Note: The blue-print submits the finalization only once, no matter how many vobs are requested.
+	auto onFinalized = [=](VobBluePrint* bluePrint) {
+		bluePrint->finalizeAsync(finalizePriority).then([=](Future<void>) {
+			onLoaded(bluePrint->createBluePrint());
 		});
+	};
 
-		auto bluePrint = std::make_unique<VobBluePrint>(std::move(vob));
-		bluePrintPtr = bluePrint.get();
-
-		mVobBluePrintCache.insert(id, std::move(bluePrint));
+	if (auto* bluePrintPtr = mVobBluePrintCache.getCachedPtr(id)) {
+		onFinalized(bluePrintPtr);
+		return;
 	}
 
-	return bluePrintPtr->createBluePrint();
+	auto* loader = ResourceLoader::get();
+
+	// Reading the mesh data and decoding the textures doesn't need the render context and runs on any worker.
+	auto storeFuture = loader->enqueue<std::shared_ptr<VobHierarchyStore>>([=]() {
+		return meshManager->loadVobHierarchyStore(path, *materialLoader);
+	}, priority, ResourceLoader::JobAffinity::Any);
+
+	storeFuture.then(loader->getExecutor(priority, ResourceLoader::JobAffinity::RenderContext), 
+		[=](Future<std::shared_ptr<VobHierarchyStore>> future) {
+
+		// the error has already been reported by the resource loader
+		if (future.has_exception()) return;
+
+		// The file might have been loaded by another request in the meantime
+		auto* bluePrintPtr = mVobBluePrintCache.getCachedPtr(id);
+
+		if (!bluePrintPtr) {
+			auto vob = meshManager->createVobHierarchy(*future.get(), *materialLoader);
+			auto bluePrint = std::make_unique<VobBluePrint>(std::move(vob));
+			bluePrintPtr = bluePrint.get();
+
+			mVobBluePrintCache.insert(id, std::move(bluePrint));
+		}
+
+		onFinalized(bluePrintPtr);
+	});
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <interface/buffers.h>
 #include <nex/renderer/RenderContext.hpp>
 #include <nex/common/Cache.hpp>
+#include <nex/resource/ResourceLoader.hpp>
 
 namespace nex
 {
@@ -22,7 +23,6 @@ namespace nex
 	class Cursor;
 	class Window;
 	class GlobalIllumination;
-	class ResourceLoader;
 	class ProbeGenerator;
 	class ProbeCluster;
 	class ShadowMap;
@@ -61,6 +61,13 @@ namespace nex
 
 		void run();
 
+		/**
+		 * Renders a fixed number of frames with a constant frame time and without waiting for window events.
+		 * Intended for benchmarks (e.g. with the null render backend).
+		 * @return the cpu time (in milliseconds) of each rendered frame.
+		 */
+		std::vector<float> runFrames(unsigned frameCount, float frameTime);
+
 		void setConfigFileName(const char* fileName);
 
 		void setRunning(bool isRunning);
@@ -71,13 +78,33 @@ namespace nex
 		void createScene(nex::RenderEngine::CommandQueue*);
 		Window* createWindow();
 
-		void executeTasks();
+		/**
+		 * Executes pending main thread tasks (e.g. finalization of loaded resources).
+		 * @param flush : If true, all pending tasks are executed regardless of the per-frame time budget.
+		 */
+		void executeTasks(bool flush = false);
 
 		void initLights();
 		void initPbr();
 		void initRenderBackend();
+
+		/**
+		 * Mounts the packages of the configuration option 'packages' (see nex::PackageFile).
+		 */
+		void mountPackages();
+
+		/**
+		 * Prepares the render context and pending resources before the first frame is rendered.
+		 */
+		void prepareRun();
 		void readConfig();
 
+		/**
+		 * Enables compression for the compiled resource types of the configuration option 'compressedResources'
+		 * (e.g. "textures, probes"; see nex::FileSystem::setCompression).
+		 */
+		void setupCompression();
+
 		void createVoxels();
 
 		void renderFrame(float frameTime);
@@ -92,10 +119,17 @@ namespace nex
 		void updateWindowTitle(float frameTime, float fps);
 		nex::Texture* visualizeVoxels();
 
-		std::unique_ptr<Vob> loadVob(const std::filesystem::path& p, 
-			nex::RenderEngine::CommandQueue* commandQueue, 
-			const AbstractMaterialLoader& materialLoader,
-			const nex::FileSystem* fileSystem = nullptr);
+		/**
+		 * Loads a vob asynchronously: The mesh and texture data is loaded on any resource loader worker, 
+		 * afterwards the vob is created on the render context worker and its meshes are finalized on the main thread.
+		 * Has to be called from the render context worker (the blue print cache isn't synchronized).
+		 * @param onLoaded : Receives the loaded vob as soon as it can be rendered. Called on the main thread 
+		 *					(or directly by the calling thread, if the vob's blue print is already finalized).
+		 */
+		void loadVobAsync(const std::filesystem::path& p,
+			std::shared_ptr<const AbstractMaterialLoader> materialLoader,
+			std::function<void(std::unique_ptr<Vob>)> onLoaded,
+			ResourceLoader::JobPriority priority = ResourceLoader::JobPriority::Normal);
 		
 
 	private:
@@ -123,6 +157,9 @@ namespace nex
 		nex::LogLevel mSystemLogLevel;
 		std::string mKeyMapLanguageStr;
 		nex::KeyMapLanguage mKeyMapLanguage;
+		float mFinalizeBudgetMillis;
+		std::string mCompressedResourcesStr;
+		std::string mPackagesStr;
 
 		std::unique_ptr<nex::FileSystem> mShaderFileSystem;
 
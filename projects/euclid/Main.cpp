@@ -101,6 +101,7 @@ int main(int argc, char** argv)
 
 	nex::LogSink::get()->registerStream(&std::cout);
 	nex::LogSink::get()->registerStream(&logFile);
+	nex::LogSink::get()->startAsync();
 
 	nex::LoggerManager* logManager = nex::LoggerManager::get();
 	logManager->setMinLogLevel(nex::Debug);
@@ -196,5 +197,8 @@ int main(int argc, char** argv)
 
 	provider->terminate();
 
+	// logFile is about to be destroyed
+	nex::LogSink::get()->stopAsync();
+
 	return EXIT_SUCCESS;
 }
\ No newline at end of file
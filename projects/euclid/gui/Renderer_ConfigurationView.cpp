@@ -1,6 +1,7 @@
 #include <gui/Renderer_ConfigurationView.hpp>
 #include <nex/post_processing/AmbientOcclusion.hpp>
 #include <nex/gui/ImGUI_Extension.hpp>
+#include <nex/renderer/RenderEngine.hpp>
 
 nex::gui::Renderer_ConfigurationView::Renderer_ConfigurationView(EuclidRenderer* renderer) : 
 	mRenderer(renderer)
@@ -102,6 +103,22 @@ void nex::gui::Renderer_ConfigurationView::drawSelf()
 	}
 	
 
+	nex::gui::Separator(2.0f);
+
+	ImGui::Text("Resource finalization:");
+
+	{
+		auto* scheduler = RenderEngine::getFinalizeScheduler();
+		float budget = scheduler->getBudget();
+		if (ImGui::DragFloat("Budget per frame (ms)", &budget, 0.1f, 0.1f, 100.0f)) {
+			scheduler->setBudget(budget);
+		}
+
+		const auto& stats = scheduler->getFrameStats();
+		ImGui::Text("Used: %.2f ms, steps: %zu, completed: %zu, deferred: %zu", 
+			stats.usedMillis, stats.executedSteps, stats.completedTasks, stats.deferredTasks);
+	}
+
 	nex::gui::Separator(2.0f);
 
 	ImGui::PopID();
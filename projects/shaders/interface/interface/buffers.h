@@ -17,6 +17,10 @@
 #define SHADER_CONSTANTS_MATERIAL_BUFFER_BINDING_POINT 9
 #endif
 
+#ifndef INSTANCE_DATA_BUFFER_BINDING_POINT
+#define INSTANCE_DATA_BUFFER_BINDING_POINT 11
+#endif
+
 
 #ifdef __cplusplus
 namespace nex {
@@ -85,8 +89,10 @@ layout(column_major, std140, binding = SHADER_CONSTANTS_UNIFORM_BUFFER_BINDING_P
 struct PerObjectData {
 	
 	NEX_UINT perObjectMaterialID;
+	NEX_UINT instanced; // bool has 32 bit in glsl; if set, the matrices are read from the instance data buffer
+	NEX_UINT boneOffset; // index of the first bone transformation in the bone palette (bone animated objects only)
 	#ifdef __cplusplus
-	float _pad1[3];
+	float _pad1;
 	#endif 
 	
 	// matrices
@@ -104,6 +110,23 @@ struct PerObjectData {
 };
 
 
+/**
+ * Per instance data of instanced draws (see PerObjectData).
+ * Alignment size: 5 * 64 + 16 = 336 bytes
+ */
+struct InstanceData {
+	NEX_MAT4 model;
+	NEX_MAT4 transform; //model view projection
+	NEX_MAT4 prevTransform;
+	NEX_MAT4 modelView;
+	NEX_MAT4 normalMatrix; //mat3 where each column vector is extended to a vec4
+	NEX_UINT boneOffset; // index of the first bone transformation in the bone palette (bone animated objects only)
+#ifdef __cplusplus
+	NEX_UINT _pad[3];
+#endif
+};
+
+
 /**
  * Alignment size: 8*4 + 9 * 4 * 4 + 2 * 16 = 32 + 144 + 32 = 208
  * Note: uniform buffer minimum max size: 16384 bytes
@@ -144,6 +167,10 @@ struct PerObjectMaterialData {
 
 #ifndef BUFFERS_DEFINE_MATERIAL_BUFFER 
 #define BUFFERS_DEFINE_MATERIAL_BUFFER 0
+#endif
+
+#ifndef BUFFERS_DEFINE_INSTANCE_BUFFER 
+#define BUFFERS_DEFINE_INSTANCE_BUFFER 0
 #endif
 
 	#if BUFFERS_DEFINE_OBJECT_BUFFER
@@ -157,6 +184,37 @@ struct PerObjectMaterialData {
 			PerObjectMaterialData materials[MAX_PER_OBJECT_MATERIAL_DATA];
 		};
 	#endif
+	
+	// Note: Vertex shaders only (gl_InstanceID)
+	#if BUFFERS_DEFINE_INSTANCE_BUFFER
+		layout(column_major, std430, binding = INSTANCE_DATA_BUFFER_BINDING_POINT) readonly buffer InstanceDataBuffer {
+			InstanceData instances[];
+		};
+		
+		mat4 getObjectModel() {
+			return objectData.instanced != 0u ? instances[gl_InstanceID].model : objectData.model;
+		}
+		
+		mat4 getObjectTransform() {
+			return objectData.instanced != 0u ? instances[gl_InstanceID].transform : objectData.transform;
+		}
+		
+		mat4 getObjectPrevTransform() {
+			return objectData.instanced != 0u ? instances[gl_InstanceID].prevTransform : objectData.prevTransform;
+		}
+		
+		mat4 getObjectModelView() {
+			return objectData.instanced != 0u ? instances[gl_InstanceID].modelView : objectData.modelView;
+		}
+		
+		mat3 getObjectNormalMatrix() {
+			return objectData.instanced != 0u ? mat3(instances[gl_InstanceID].normalMatrix) : objectData.normalMatrix;
+		}
+		
+		uint getObjectBoneOffset() {
+			return objectData.instanced != 0u ? instances[gl_InstanceID].boneOffset : objectData.boneOffset;
+		}
+	#endif
 
 #endif
 
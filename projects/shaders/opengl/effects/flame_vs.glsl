@@ -5,10 +5,11 @@ void main() {
     //commonVertexShader();
     
     #if BONE_ANIMATION
-    mat4 boneTrafo = boneTrafos.trafos[boneId[0]] * boneWeight[0];
-    boneTrafo += boneTrafos.trafos[boneId[1]] * boneWeight[1];
-    boneTrafo += boneTrafos.trafos[boneId[2]] * boneWeight[2];
-    boneTrafo += boneTrafos.trafos[boneId[3]] * boneWeight[3];
+    const uint boneOffset = getObjectBoneOffset();
+    mat4 boneTrafo = boneTrafos.trafos[boneOffset + boneId[0]] * boneWeight[0];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[1]] * boneWeight[1];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[2]] * boneWeight[2];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[3]] * boneWeight[3];
     
     /*boneTrafo = mat4(1.0) * boneWeight.x;
     boneTrafo += mat4(1.0) * boneWeight.y;
@@ -21,6 +21,7 @@ layout (location = 5) in vec4  boneWeight;
 #endif
 
 #define BUFFERS_DEFINE_OBJECT_BUFFER 1
+#define BUFFERS_DEFINE_INSTANCE_BUFFER 1
 #include "interface/buffers.h"
 
 
@@ -49,10 +50,11 @@ out VS_OUT {
 void commonVertexShader() {
     
 #if BONE_ANIMATION
-    mat4 boneTrafo = boneTrafos.trafos[boneId[0]] * boneWeight[0];
-    boneTrafo += boneTrafos.trafos[boneId[1]] * boneWeight[1];
-    boneTrafo += boneTrafos.trafos[boneId[2]] * boneWeight[2];
-    boneTrafo += boneTrafos.trafos[boneId[3]] * boneWeight[3];
+    const uint boneOffset = getObjectBoneOffset();
+    mat4 boneTrafo = boneTrafos.trafos[boneOffset + boneId[0]] * boneWeight[0];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[1]] * boneWeight[1];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[2]] * boneWeight[2];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[3]] * boneWeight[3];
     
     /*boneTrafo = mat4(1.0) * boneWeight.x;
     boneTrafo += mat4(1.0) * boneWeight.y;
@@ -83,21 +85,23 @@ void commonVertexShader() {
 #endif
     
     
+    const mat4 transform = getObjectTransform();
+    
     //constants.projectionGPass * constants.viewGPass * objectData.model 
-    gl_Position =  objectData.transform * positionLocal;
+    gl_Position =  transform * positionLocal;
 	
 
 	
-    vs_out.position_ndc = objectData.transform * vec4(positionLocal.xyz, 1.0);
-    vs_out.position_ndc_previous = objectData.prevTransform * vec4(positionLocal.xyz, 1.0);
+    vs_out.position_ndc = transform * vec4(positionLocal.xyz, 1.0);
+    vs_out.position_ndc_previous = getObjectPrevTransform() * vec4(positionLocal.xyz, 1.0);
     
     vs_out.tex_coords = texCoords;
     
-    vs_out.fragment_position_eye = objectData.modelView * positionLocal;
-	vs_out.fragment_position_world = objectData.model * positionLocal;
+    vs_out.fragment_position_eye = getObjectModelView() * positionLocal;
+	vs_out.fragment_position_world = getObjectModel() * positionLocal;
 	vs_out.camera_position_world =  constants.invViewGPass * vec4(0,0,0,1);
 	
-	mat3 normalMatrix = objectData.normalMatrix;
+	mat3 normalMatrix = getObjectNormalMatrix();
 	
 	vec3 normal_eye = normalize(normalMatrix * normalLocal);
 	vec3 tangent_eye = normalize(normalMatrix * tangentLocal);
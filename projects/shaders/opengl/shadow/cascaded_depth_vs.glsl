@@ -3,6 +3,7 @@
 #include "interface/shadow/cascade_common.h"
 
 #define BUFFERS_DEFINE_OBJECT_BUFFER 1
+#define BUFFERS_DEFINE_INSTANCE_BUFFER 1
 #include "interface/buffers.h"
 
 #ifndef BONE_ANIMATION
@@ -39,15 +40,16 @@ void main()
 {
 
 #if BONE_ANIMATION
-    mat4 boneTrafo = boneTrafos.trafos[boneId[0]] * boneWeight[0];
-    boneTrafo += boneTrafos.trafos[boneId[1]] * boneWeight[1];
-    boneTrafo += boneTrafos.trafos[boneId[2]] * boneWeight[2];
-    boneTrafo += boneTrafos.trafos[boneId[3]] * boneWeight[3];
+    const uint boneOffset = getObjectBoneOffset();
+    mat4 boneTrafo = boneTrafos.trafos[boneOffset + boneId[0]] * boneWeight[0];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[1]] * boneWeight[1];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[2]] * boneWeight[2];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[3]] * boneWeight[3];
     
     vec4 positionLocal = boneTrafo * vec4(position, 1.0f);
 #else 
     vec4 positionLocal = vec4(position, 1.0f);
 #endif
 
-    gl_Position = constants.cascadeData.lightViewProjectionMatrices[cascadeIdx] * objectData.model * positionLocal;
+    gl_Position = constants.cascadeData.lightViewProjectionMatrices[cascadeIdx] * getObjectModel() * positionLocal;
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ layout (location = 5) in vec4  boneWeight;
 #endif
 
 #define BUFFERS_DEFINE_OBJECT_BUFFER 1
+#define BUFFERS_DEFINE_INSTANCE_BUFFER 1
 #include "interface/buffers.h"
 
 
@@ -38,15 +39,16 @@ void main()
 {
 
 #if BONE_ANIMATION
-    mat4 boneTrafo = boneTrafos.trafos[boneId[0]] * boneWeight[0];
-    boneTrafo += boneTrafos.trafos[boneId[1]] * boneWeight[1];
-    boneTrafo += boneTrafos.trafos[boneId[2]] * boneWeight[2];
-    boneTrafo += boneTrafos.trafos[boneId[3]] * boneWeight[3];
+    const uint boneOffset = getObjectBoneOffset();
+    mat4 boneTrafo = boneTrafos.trafos[boneOffset + boneId[0]] * boneWeight[0];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[1]] * boneWeight[1];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[2]] * boneWeight[2];
+    boneTrafo += boneTrafos.trafos[boneOffset + boneId[3]] * boneWeight[3];
     
     vec4 positionLocal = boneTrafo * vec4(position, 1.0f);
 #else 
     vec4 positionLocal = vec4(position, 1.0f);
 #endif
 
-    gl_Position = objectData.transform * positionLocal;
+    gl_Position = getObjectTransform() * positionLocal;
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <nex/anim/BonePalette.hpp>
+#include <nex/null/NullStatistics.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+
+using namespace nex;
+
+namespace
+{
+	std::vector<glm::mat4> createPose(size_t boneCount, float id)
+	{
+		return std::vector<glm::mat4>(boneCount, glm::mat4(id));
+	}
+}
+
+TEST(BonePaletteTest, PosesAreWrittenContiguouslyIntoTheStreamingBuffer)
+{
+	StreamingBuffer buffer(1024 * sizeof(glm::mat4));
+	BonePalette palette(64);
+	palette.begin(buffer);
+	int owners[3];
+	unsigned offsets[3];
+
+	ASSERT_TRUE(palette.add(&owners[0], createPose(3, 1.0f), offsets[0]));
+	ASSERT_TRUE(palette.add(&owners[1], createPose(5, 2.0f), offsets[1]));
+	ASSERT_TRUE(palette.add(&owners[2], createPose(2, 3.0f), offsets[2]));
+	EXPECT_EQ(offsets[0], 0);
+	EXPECT_EQ(offsets[1], 3);
+	EXPECT_EQ(offsets[2], 8);
+
+	// the palette range is the only allocation of the frame
+	EXPECT_EQ(buffer.getHead(), 64 * sizeof(glm::mat4));
+
+	const auto* trafos = palette.getTrafos();
+	ASSERT_EQ(palette.getTrafoCount(), 10);
+	EXPECT_EQ(trafos[2], glm::mat4(1.0f));
+	EXPECT_EQ(trafos[3], glm::mat4(2.0f));
+	EXPECT_EQ(trafos[9], glm::mat4(3.0f));
+	EXPECT_EQ(palette.getPoseCount(), 3);
+}
+
+TEST(BonePaletteTest, PoseIsAddedOncePerFrame)
+{
+	StreamingBuffer buffer(1024 * sizeof(glm::mat4));
+	BonePalette palette(64);
+	palette.begin(buffer);
+	int owners[2];
+	unsigned offset;
+
+	palette.add(&owners[0], createPose(4, 1.0f), offset);
+	palette.add(&owners[1], createPose(4, 2.0f), offset);
+
+	// e.g. the vob is visible in a second view
+	ASSERT_TRUE(palette.add(&owners[0], createPose(4, 5.0f), offset));
+	EXPECT_EQ(offset, 0);
+	EXPECT_EQ(palette.getTrafoCount(), 8);
+	EXPECT_EQ(palette.getTrafos()[0], glm::mat4(1.0f));
+
+	buffer.markFrame();
+	palette.clear();
+	EXPECT_EQ(palette.getPoseCount(), 0);
+
+	palette.begin(buffer);
+	ASSERT_TRUE(palette.add(&owners[1], createPose(4, 2.0f), offset));
+	EXPECT_EQ(offset, 0);
+}
+
+TEST(BonePaletteTest, PosesThatDoNotFitAreRejected)
+{
+	StreamingBuffer buffer(1024 * sizeof(glm::mat4));
+	BonePalette palette(10);
+	int owners[3];
+	unsigned offset;
+
+	// without a palette range
+	EXPECT_FALSE(palette.add(&owners[0], createPose(4, 1.0f), offset));
+
+	palette.begin(buffer);
+	EXPECT_TRUE(palette.add(&owners[0], createPose(4, 1.0f), offset));
+	EXPECT_FALSE(palette.add(&owners[1], createPose(8, 2.0f), offset));
+	EXPECT_TRUE(palette.add(&owners[2], createPose(6, 3.0f), offset));
+	EXPECT_EQ(offset, 4);
+
+	EXPECT_EQ(palette.getTrafoCount(), 10);
+	EXPECT_EQ(palette.getPoseCount(), 2);
+	EXPECT_EQ(palette.getRejectedPoseCount(), 1);
+}
+
+TEST(BonePaletteTest, BindDoesNotUpload)
+{
+	StreamingBuffer buffer(1024 * sizeof(glm::mat4));
+	BonePalette palette(64);
+	auto* statistics = NullStatistics::get();
+	int owner;
+	unsigned offset;
+
+	palette.begin(buffer);
+	const auto head = buffer.getHead();
+
+	// nothing to bind
+	statistics->reset();
+	palette.bind(buffer, 0);
+	EXPECT_EQ(statistics->getValue(NullStatistics::Counter::STREAMED_RANGES), 0);
+
+	palette.add(&owner, createPose(4, 1.0f), offset);
+	for (int i = 0; i < 10; ++i) palette.bind(buffer, 0);
+
+	EXPECT_EQ(statistics->getValue(NullStatistics::Counter::STREAMED_RANGES), 10);
+	EXPECT_EQ(buffer.getHead(), head);
+}
+
+TEST(BonePaletteTest, ConcurrentAddsGetDisjointRanges)
+{
+	constexpr size_t threadCount = 4;
+	constexpr size_t ownersPerThread = 500;
+	constexpr size_t boneCount = 7;
+
+	std::vector<int> owners(threadCount * ownersPerThread);
+	std::vector<unsigned> offsets(owners.size());
+	std::vector<std::thread> threads;
+
+	StreamingBuffer buffer(owners.size() * boneCount * sizeof(glm::mat4));
+	BonePalette palette(owners.size() * boneCount);
+	palette.begin(buffer);
+
+	for (size_t t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t] {
+			for (size_t i = t * ownersPerThread; i < (t + 1) * ownersPerThread; ++i) {
+				palette.add(&owners[i], createPose(boneCount, static_cast<float>(i)), offsets[i]);
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	ASSERT_EQ(palette.getTrafoCount(), owners.size() * boneCount);
+
+	// each owner finds its own pose at its offset
+	for (size_t i = 0; i < owners.size(); ++i) {
+		EXPECT_EQ(palette.getTrafos()[offsets[i]], glm::mat4(static_cast<float>(i)));
+		EXPECT_EQ(palette.getTrafos()[offsets[i] + boneCount - 1], glm::mat4(static_cast<float>(i)));
+	}
+
+	auto sorted = offsets;
+	std::sort(sorted.begin(), sorted.end());
+	for (size_t i = 0; i < sorted.size(); ++i) EXPECT_EQ(sorted[i], i * boneCount);
+}
@@ -0,0 +1,123 @@
+#include <nex/buffer/StreamingBuffer.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <stdexcept>
+
+using namespace nex;
+
+/**
+ * Note: The null backend signals fences immediately, so waiting for a range never stalls. The tests check which ranges
+ * are fenced and retired by the allocator.
+ */
+
+TEST(StreamingBufferTest, CapacityHoldsAlignedFrames)
+{
+	StreamingBuffer buffer(1000, 3);
+	const auto alignment = buffer.getAlignment();
+	const auto alignedFrameSize = (1000 + alignment - 1) / alignment * alignment;
+
+	EXPECT_EQ(buffer.getCapacity(), 3 * alignedFrameSize);
+	EXPECT_EQ(buffer.getHead(), 0);
+}
+
+TEST(StreamingBufferTest, AllocationsAreAligned)
+{
+	StreamingBuffer buffer(4096);
+	const auto alignment = buffer.getAlignment();
+
+	const auto first = buffer.allocate(1);
+	const auto second = buffer.allocate(alignment + 1);
+	const auto third = buffer.allocate(alignment);
+
+	EXPECT_EQ(first.offset, 0);
+	EXPECT_EQ(first.size, 1);
+	EXPECT_EQ(second.offset, alignment);
+	EXPECT_EQ(second.size, alignment + 1);
+	EXPECT_EQ(third.offset, 3 * alignment);
+	EXPECT_EQ(buffer.getHead(), 4 * alignment);
+
+	// the memory of a range starts at its offset
+	EXPECT_EQ(static_cast<char*>(second.data) - static_cast<char*>(first.data), second.offset);
+}
+
+TEST(StreamingBufferTest, UploadCopiesData)
+{
+	StreamingBuffer buffer(1024);
+	const int data[] = { 1, 2, 3, 4 };
+
+	buffer.allocate(1);
+	const auto allocation = buffer.upload(data, sizeof(data));
+
+	EXPECT_EQ(allocation.size, sizeof(data));
+	EXPECT_EQ(std::memcmp(allocation.data, data, sizeof(data)), 0);
+}
+
+TEST(StreamingBufferTest, FramesAreFenced)
+{
+	StreamingBuffer buffer(1024);
+	const auto alignment = buffer.getAlignment();
+
+	buffer.allocate(1);
+	buffer.allocate(alignment);
+	buffer.markFrame();
+	EXPECT_EQ(buffer.getPendingRangeCount(), 1);
+	EXPECT_EQ(buffer.getLastFrameAllocatedBytes(), 2 * alignment);
+
+	// frames without allocations don't need a fence
+	buffer.markFrame();
+	EXPECT_EQ(buffer.getPendingRangeCount(), 1);
+	EXPECT_EQ(buffer.getLastFrameAllocatedBytes(), 0);
+}
+
+TEST(StreamingBufferTest, OverwrittenFramesAreRetired)
+{
+	StreamingBuffer buffer(256, 3);
+	const auto frameSize = buffer.getCapacity() / 3;
+
+	for (size_t frame = 0; frame < 3; ++frame) {
+		EXPECT_EQ(buffer.allocate(frameSize).offset, frame * frameSize);
+		buffer.markFrame();
+	}
+	EXPECT_EQ(buffer.getPendingRangeCount(), 3);
+
+	// the ring wraps around; only the oldest frame is overwritten
+	EXPECT_EQ(buffer.allocate(frameSize).offset, 0);
+	EXPECT_EQ(buffer.getPendingRangeCount(), 2);
+
+	// a larger allocation overwrites the remaining frames
+	EXPECT_EQ(buffer.allocate(2 * frameSize).offset, frameSize);
+	EXPECT_EQ(buffer.getPendingRangeCount(), 0);
+
+	buffer.markFrame();
+	EXPECT_EQ(buffer.getPendingRangeCount(), 1);
+	EXPECT_EQ(buffer.getStallCount(), 0);
+}
+
+TEST(StreamingBufferTest, WrapAroundFencesCurrentFrame)
+{
+	StreamingBuffer buffer(256, 3);
+	const auto frameSize = buffer.getCapacity() / 3;
+
+	buffer.allocate(frameSize);
+	buffer.markFrame();
+
+	// the current frame doesn't fit into the rest of the ring
+	buffer.allocate(frameSize);
+	buffer.allocate(frameSize);
+	const auto wrapped = buffer.allocate(frameSize);
+
+	// the ranges written before the wrap around are fenced; the first frame was overwritten
+	EXPECT_EQ(wrapped.offset, 0);
+	EXPECT_EQ(buffer.getPendingRangeCount(), 1);
+
+	buffer.markFrame();
+	EXPECT_EQ(buffer.getPendingRangeCount(), 2);
+	EXPECT_EQ(buffer.getLastFrameAllocatedBytes(), 3 * frameSize);
+}
+
+TEST(StreamingBufferTest, AllocationExceedingCapacityThrows)
+{
+	StreamingBuffer buffer(256, 2);
+	EXPECT_THROW(buffer.allocate(buffer.getCapacity() + 1), std::runtime_error);
+	EXPECT_NO_THROW(buffer.allocate(buffer.getCapacity()));
+}
@@ -0,0 +1,211 @@
+#include <nex/common/File.hpp>
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <fstream>
+#include <iterator>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * A file in the temp directory, that is removed when the test ends.
+	 */
+	class TempFile
+	{
+	public:
+		explicit TempFile(const std::string& name) :
+			mPath(std::filesystem::temp_directory_path() / "EngineTest" / name)
+		{
+			std::filesystem::create_directories(mPath.parent_path());
+		}
+
+		~TempFile()
+		{
+			std::error_code error;
+			std::filesystem::remove(mPath, error);
+		}
+
+		const std::filesystem::path& getPath() const
+		{
+			return mPath;
+		}
+
+	private:
+		std::filesystem::path mPath;
+	};
+
+	std::vector<char> readBytes(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	std::vector<glm::vec3> createPositions(size_t count)
+	{
+		std::vector<glm::vec3> positions(count);
+		for (size_t i = 0; i < count; ++i) positions[i] = glm::vec3(float(i), 2.0f * i, -1.0f * i);
+		return positions;
+	}
+}
+
+TEST(BinStreamTest, BulkVectorEncodingIsUnchanged)
+{
+	TempFile bulk("bulk.bin");
+	TempFile elementWise("element_wise.bin");
+	const auto positions = createPositions(1000);
+
+	{
+		BinStream file;
+		file.open(bulk.getPath(), std::ios::out | std::ios::trunc);
+		file << positions;
+	}
+
+	{
+		// the encoding of the element wise implementation: count, followed by the elements
+		BinStream file;
+		file.open(elementWise.getPath(), std::ios::out | std::ios::trunc);
+		file << positions.size();
+		for (const auto& position : positions) file << position;
+	}
+
+	EXPECT_EQ(readBytes(bulk.getPath()), readBytes(elementWise.getPath()));
+
+	std::vector<glm::vec3> result;
+	BinStream file;
+	file.open(elementWise.getPath(), std::ios::in);
+	file >> result;
+	EXPECT_EQ(result, positions);
+}
+
+TEST(BinStreamTest, NonBulkVectorsRoundTrip)
+{
+	TempFile temp("non_bulk.bin");
+	const std::vector<std::vector<glm::vec3>> channels = { createPositions(3), {}, createPositions(7) };
+	const std::vector<std::string> names = { "root", "", "a somewhat longer bone name" };
+
+	{
+		BinStream file;
+		file.open(temp.getPath(), std::ios::out | std::ios::trunc);
+		file << channels;
+		file << names;
+	}
+
+	std::vector<std::vector<glm::vec3>> channelsResult;
+	std::vector<std::string> namesResult;
+	BinStream file;
+	file.open(temp.getPath(), std::ios::in);
+	file >> channelsResult;
+	file >> namesResult;
+
+	EXPECT_EQ(channelsResult, channels);
+	EXPECT_EQ(namesResult, names);
+}
+
+TEST(BinStreamTest, RangeRoundTrip)
+{
+	TempFile temp("range.bin");
+	glm::quat rotations[64];
+	for (int i = 0; i < 64; ++i) rotations[i] = glm::quat(1.0f, float(i), 0.5f * i, -0.25f * i);
+
+	{
+		BinStream file;
+		file.open(temp.getPath(), std::ios::out | std::ios::trunc);
+		file.writeRange(rotations, 64);
+	}
+
+	EXPECT_EQ(std::filesystem::file_size(temp.getPath()), sizeof(rotations));
+
+	glm::quat result[64];
+	BinStream file;
+	file.open(temp.getPath(), std::ios::in);
+	file.readRange(result, 64);
+
+	for (int i = 0; i < 64; ++i) EXPECT_EQ(result[i], rotations[i]);
+}
+
+TEST(BinStreamTest, BufferSmallerThanData)
+{
+	TempFile temp("small_buffer.bin");
+	const auto positions = createPositions(10000);
+
+	{
+		BinStream file(16);
+		file.open(temp.getPath(), std::ios::out | std::ios::trunc);
+		file << positions;
+	}
+
+	std::vector<glm::vec3> result;
+	BinStream file(16);
+	file.open(temp.getPath(), std::ios::in);
+	file >> result;
+	EXPECT_EQ(result, positions);
+}
+
+TEST(BinStreamTest, MemoryAndMappedStreamsReadFileContent)
+{
+	TempFile temp("memory.bin");
+	const auto positions = createPositions(100);
+	const std::string name = "animation";
+
+	{
+		BinStream file;
+		file.open(temp.getPath(), std::ios::out | std::ios::trunc);
+		file << name;
+		file << positions;
+	}
+
+	const auto bytes = readBytes(temp.getPath());
+
+	{
+		BinStream memory;
+		memory.openMemory(bytes.data(), bytes.size());
+
+		std::string nameResult;
+		std::vector<glm::vec3> result;
+		memory >> nameResult;
+		memory >> result;
+		EXPECT_EQ(nameResult, name);
+		EXPECT_EQ(result, positions);
+
+		// seeking is supported, too
+		memory.seekg(0);
+		memory >> nameResult;
+		EXPECT_EQ(nameResult, name);
+	}
+
+	BinStream mapped;
+	mapped.openMapped(temp.getPath());
+
+	std::string nameResult;
+	std::vector<glm::vec3> result;
+	mapped >> nameResult;
+	mapped >> result;
+	EXPECT_EQ(nameResult, name);
+	EXPECT_EQ(result, positions);
+}
+
+TEST(BinStreamTest, ReadingBeyondMemoryThrows)
+{
+	const char data[4] = {};
+	BinStream memory;
+	memory.openMemory(data, sizeof(data));
+
+	uint64_t value = 0;
+	EXPECT_THROW(memory >> value, std::ios_base::failure);
+}
+
+TEST(BinStreamTest, DestructorFlushesUnclosedStream)
+{
+	TempFile temp("unclosed.bin");
+	const auto positions = createPositions(100);
+
+	{
+		BinStream file;
+		file.open(temp.getPath(), std::ios::out | std::ios::trunc);
+		file << positions;
+	}
+
+	EXPECT_EQ(std::filesystem::file_size(temp.getPath()), sizeof(size_t) + positions.size() * sizeof(glm::vec3));
+}
@@ -0,0 +1,155 @@
+#include <nex/common/Compression.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+using namespace nex;
+
+namespace
+{
+	std::vector<char> createRandom(size_t size, unsigned seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<int> byte(0, 255);
+
+		std::vector<char> data(size);
+		for (auto& value : data) value = static_cast<char>(byte(random));
+		return data;
+	}
+
+	/**
+	 * Random words, that are repeated with different distances: compresses well and contains long matches.
+	 */
+	std::vector<char> createText(size_t size, unsigned seed)
+	{
+		std::mt19937 random(seed);
+		const auto words = createRandom(256, seed);
+		std::uniform_int_distribution<size_t> word(0, 31);
+
+		std::vector<char> data;
+		data.reserve(size);
+		while (data.size() < size) {
+			const auto* begin = words.data() + word(random) * 8;
+			data.insert(data.end(), begin, begin + std::min<size_t>(8, size - data.size()));
+		}
+		return data;
+	}
+
+	std::vector<char> roundTrip(const std::vector<char>& data, uint32_t blockSize = Compression::DEFAULT_BLOCK_SIZE)
+	{
+		const auto compressed = Compression::compress(data.data(), data.size(), blockSize);
+		EXPECT_TRUE(Compression::isCompressed(compressed.data(), compressed.size()));
+
+		std::vector<char> result;
+		Compression::decompress(compressed.data(), compressed.size(), result);
+		return result;
+	}
+}
+
+TEST(CompressionTest, EmptyAndTinyDataRoundTrip)
+{
+	EXPECT_TRUE(roundTrip({}).empty());
+
+	for (size_t size : { 1, 4, 12, 13, 17 }) {
+		const auto data = createText(size, 1);
+		EXPECT_EQ(roundTrip(data), data) << "size " << size;
+	}
+}
+
+TEST(CompressionTest, RepeatedDataCompresses)
+{
+	const auto data = createText(1000000, 2);
+	const auto compressed = Compression::compress(data.data(), data.size());
+	EXPECT_LT(compressed.size(), data.size() / 2);
+
+	std::vector<char> result;
+	Compression::decompress(compressed.data(), compressed.size(), result);
+	EXPECT_EQ(result, data);
+}
+
+TEST(CompressionTest, ShortOffsetsRoundTrip)
+{
+	// a pattern with a period below 8 is encoded as a match that overlaps its own output
+	for (size_t period = 1; period <= 16; ++period) {
+		const auto pattern = createRandom(period, static_cast<unsigned>(period));
+		std::vector<char> data;
+		for (size_t i = 0; i < 5000; ++i) data.push_back(pattern[i % period]);
+
+		const auto compressed = Compression::compress(data.data(), data.size());
+		EXPECT_LT(compressed.size(), data.size() / 10) << "period " << period;
+
+		std::vector<char> result;
+		Compression::decompress(compressed.data(), compressed.size(), result);
+		EXPECT_EQ(result, data) << "period " << period;
+	}
+}
+
+TEST(CompressionTest, IncompressibleBlocksAreStored)
+{
+	const auto data = createRandom(100000, 3);
+	const auto compressed = Compression::compress(data.data(), data.size(), 4096);
+
+	// header, block table and the blocks themselves
+	const auto blockCount = (data.size() + 4095) / 4096;
+	EXPECT_EQ(compressed.size(), sizeof(Compression::Header) + blockCount * sizeof(uint32_t) + data.size());
+
+	std::vector<char> result;
+	Compression::decompress(compressed.data(), compressed.size(), result);
+	EXPECT_EQ(result, data);
+}
+
+TEST(CompressionTest, MixedBlocksRoundTrip)
+{
+	// compressible and incompressible blocks, the last block is partial
+	auto data = createText(70000, 4);
+	const auto random = createRandom(30000, 5);
+	data.insert(data.end(), random.begin(), random.end());
+
+	EXPECT_EQ(roundTrip(data, 8192), data);
+	EXPECT_EQ(roundTrip(data, 1000), data);
+}
+
+TEST(CompressionTest, BlockSizeIsValidated)
+{
+	const auto data = createText(100, 6);
+	EXPECT_THROW(Compression::compress(data.data(), data.size(), 0), std::invalid_argument);
+}
+
+TEST(CompressionTest, IsCompressedChecksMagic)
+{
+	const auto data = createText(1000, 7);
+	const auto compressed = Compression::compress(data.data(), data.size());
+
+	EXPECT_TRUE(Compression::isCompressed(compressed.data(), compressed.size()));
+	EXPECT_FALSE(Compression::isCompressed(compressed.data(), 3));
+	EXPECT_FALSE(Compression::isCompressed(data.data(), data.size()));
+}
+
+TEST(CompressionTest, CorruptDataThrows)
+{
+	const auto data = createText(100000, 8);
+	const auto compressed = Compression::compress(data.data(), data.size(), 16384);
+	std::vector<char> result;
+
+	// truncated
+	EXPECT_THROW(Compression::decompress(compressed.data(), compressed.size() - 100, result), std::runtime_error);
+	EXPECT_THROW(Compression::decompress(compressed.data(), sizeof(Compression::Header) - 1, result), std::runtime_error);
+
+	// wrong uncompressed size
+	auto wrongSize = compressed;
+	Compression::Header header;
+	std::memcpy(&header, wrongSize.data(), sizeof(header));
+	header.size += 1;
+	std::memcpy(wrongSize.data(), &header, sizeof(header));
+	EXPECT_THROW(Compression::decompress(wrongSize.data(), wrongSize.size(), result), std::runtime_error);
+
+	// a block, that ends in the middle of a sequence
+	const auto block = createText(4096, 9);
+	std::vector<char> compressedBlock(Compression::getBlockBound(block.size()));
+	const auto blockSize = Compression::compressBlock(block.data(), block.size(), compressedBlock.data(), compressedBlock.size());
+	ASSERT_GT(blockSize, 0);
+	result.resize(block.size());
+	EXPECT_THROW(Compression::decompressBlock(compressedBlock.data(), blockSize - 10, result.data(), block.size()),
+		std::runtime_error);
+}
@@ -0,0 +1,177 @@
+#include <nex/common/ConcurrentQueue.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace nex;
+
+TEST(ConcurrentQueueTest, FifoOrder)
+{
+	ConcurrentQueue<int> queue(8);
+
+	for (int i = 0; i < 5; ++i) queue.push(i);
+	EXPECT_EQ(queue.size(), 5);
+
+	for (int i = 0; i < 5; ++i) EXPECT_EQ(queue.pop(), i);
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentQueueTest, CapacityIsRoundedUpToPowerOfTwo)
+{
+	ConcurrentQueue<int> queue(5);
+	EXPECT_EQ(queue.capacity(), 8);
+}
+
+TEST(ConcurrentQueueTest, MoveOnlyElements)
+{
+	ConcurrentQueue<std::unique_ptr<int>> queue(4);
+	queue.push(std::make_unique<int>(42));
+
+	std::unique_ptr<int> result;
+	ASSERT_TRUE(queue.try_pop(result));
+	EXPECT_EQ(*result, 42);
+}
+
+TEST(ConcurrentQueueTest, PushToFullQueueDoesNotBlock)
+{
+	ConcurrentQueue<int> queue(4);
+	constexpr int count = 100;
+
+	// the consumer pushes to its own queue; with a blocking push this would never return
+	for (int i = 0; i < count; ++i) queue.push(i);
+	EXPECT_EQ(queue.size(), count);
+
+	for (int i = 0; i < count; ++i) EXPECT_EQ(queue.pop(), i);
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentQueueTest, OrderIsKeptWhileOverflowDrains)
+{
+	ConcurrentQueue<int> queue(4);
+	int next = 0;
+	int expected = 0;
+
+	// interleave pushes and pops, so that the ring buffer gets free slots while the overflow list isn't empty yet
+	for (int round = 0; round < 50; ++round) {
+		for (int i = 0; i < 7; ++i) queue.push(next++);
+		for (int i = 0; i < 5; ++i) EXPECT_EQ(queue.pop(), expected++);
+	}
+
+	int value;
+	while (queue.try_pop(value)) EXPECT_EQ(value, expected++);
+	EXPECT_EQ(expected, next);
+}
+
+TEST(ConcurrentQueueTest, TryPushFailsIfFull)
+{
+	ConcurrentQueue<int> queue(2);
+	EXPECT_TRUE(queue.try_push(1));
+	EXPECT_TRUE(queue.try_push(2));
+	EXPECT_FALSE(queue.try_push(3));
+
+	// elements in the overflow list are older, so try_push mustn't bypass them
+	queue.push(3);
+	EXPECT_EQ(queue.pop(), 1);
+	EXPECT_FALSE(queue.try_push(4));
+}
+
+TEST(ConcurrentQueueTest, PopBulk)
+{
+	ConcurrentQueue<int> queue(4);
+	for (int i = 0; i < 10; ++i) queue.push(i);
+
+	std::vector<int> result;
+	EXPECT_EQ(queue.pop_bulk(std::back_inserter(result), 6), 6);
+	EXPECT_EQ(queue.pop_bulk(std::back_inserter(result), 6), 4);
+	EXPECT_EQ(queue.pop_bulk(std::back_inserter(result), 6), 0);
+
+	for (int i = 0; i < 10; ++i) EXPECT_EQ(result[i], i);
+}
+
+TEST(ConcurrentQueueTest, ThrowingConsumerKeepsQueueConsistent)
+{
+	ConcurrentQueue<int> queue(4);
+	for (int i = 0; i < 4; ++i) queue.push(i);
+
+	struct ThrowingIterator {
+		using iterator_category = std::output_iterator_tag;
+		using value_type = void;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = void;
+
+		ThrowingIterator& operator*() { return *this; }
+		ThrowingIterator& operator=(int) { throw std::runtime_error("consumer failed"); }
+		ThrowingIterator& operator++() { return *this; }
+	};
+
+	EXPECT_THROW(queue.pop_bulk(ThrowingIterator(), 4), std::runtime_error);
+
+	// the element passed to the throwing consumer is gone, the slot is free again
+	EXPECT_EQ(queue.size(), 3);
+	for (int i = 0; i < 5; ++i) queue.push(10 + i);
+
+	std::vector<int> result;
+	queue.pop_bulk(std::back_inserter(result), 100);
+	EXPECT_EQ(result, (std::vector<int>{1, 2, 3, 10, 11, 12, 13, 14}));
+}
+
+TEST(ConcurrentQueueTest, ClearRemovesOverflow)
+{
+	ConcurrentQueue<std::shared_ptr<int>> queue(2);
+	auto element = std::make_shared<int>(1);
+
+	for (int i = 0; i < 5; ++i) queue.push(element);
+	EXPECT_EQ(element.use_count(), 6);
+
+	queue.clear();
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(element.use_count(), 1);
+}
+
+TEST(ConcurrentQueueTest, MultipleProducersAndConsumers)
+{
+	constexpr int producerCount = 4;
+	constexpr int consumerCount = 4;
+	constexpr int elementsPerProducer = 20000;
+
+	// small capacity, so that the overflow list is used, too
+	ConcurrentQueue<int> queue(64);
+	std::vector<std::vector<int>> consumed(consumerCount);
+	std::vector<std::thread> threads;
+
+	for (int p = 0; p < producerCount; ++p) {
+		threads.emplace_back([&, p] {
+			for (int i = 0; i < elementsPerProducer; ++i) queue.push(p * elementsPerProducer + i);
+		});
+	}
+
+	for (int c = 0; c < consumerCount; ++c) {
+		threads.emplace_back([&, c] {
+			for (int i = 0; i < producerCount * elementsPerProducer / consumerCount; ++i) {
+				consumed[c].push_back(queue.pop());
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+
+	std::vector<int> all;
+	for (const auto& values : consumed) {
+		// each consumer sees the elements of one producer in push order
+		std::vector<int> last(producerCount, -1);
+		for (int value : values) {
+			const int producer = value / elementsPerProducer;
+			EXPECT_GT(value, last[producer]);
+			last[producer] = value;
+		}
+		all.insert(all.end(), values.begin(), values.end());
+	}
+
+	std::sort(all.begin(), all.end());
+	ASSERT_EQ(all.size(), producerCount * elementsPerProducer);
+	for (int i = 0; i < static_cast<int>(all.size()); ++i) ASSERT_EQ(all[i], i);
+	EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,224 @@
+#include <nex/common/Future.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * Executor that collects continuations; they run when the test calls runAll().
+	 */
+	struct QueuedExecutor
+	{
+		std::vector<Continuation> continuations;
+
+		Executor get()
+		{
+			return [this](Continuation continuation) {
+				continuations.emplace_back(std::move(continuation));
+			};
+		}
+
+		void runAll()
+		{
+			auto current = std::move(continuations);
+			continuations.clear();
+			for (auto& continuation : current) continuation();
+		}
+	};
+}
+
+TEST(FutureTest, ThenReceivesReadyFuture)
+{
+	Promise<int> promise;
+	auto future = promise.get_future().then([](Future<int> f) {
+		return f.get() * 2;
+	});
+
+	EXPECT_FALSE(future.is_ready());
+	promise.set_value(21);
+
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_EQ(future.get(), 42);
+}
+
+TEST(FutureTest, ThenOnReadyFutureRunsImmediately)
+{
+	Promise<int> promise;
+	promise.set_value(1);
+
+	auto future = promise.get_future().then([](Future<int> f) {
+		return f.get() + 1;
+	});
+
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_EQ(future.get(), 2);
+}
+
+TEST(FutureTest, ThenUsesExecutor)
+{
+	QueuedExecutor executor;
+	Promise<void> promise;
+	bool called = false;
+
+	auto future = promise.get_future().then(executor.get(), [&](Future<void>) {
+		called = true;
+	});
+
+	promise.set();
+	EXPECT_FALSE(called);
+	EXPECT_FALSE(future.is_ready());
+
+	executor.runAll();
+	EXPECT_TRUE(called);
+	EXPECT_TRUE(future.is_ready());
+}
+
+TEST(FutureTest, StdExceptionInContinuationIsForwarded)
+{
+	Promise<int> promise;
+	auto future = promise.get_future().then([](Future<int>) -> int {
+		throw std::runtime_error("continuation failed");
+	});
+
+	promise.set_value(0);
+
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_TRUE(future.has_exception());
+}
+
+TEST(FutureTest, UnknownExceptionInContinuationIsForwarded)
+{
+	Promise<int> promise;
+	auto future = promise.get_future().then([](Future<int>) -> int {
+		throw 42;
+	});
+
+	promise.set_value(0);
+
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_TRUE(future.has_exception());
+}
+
+TEST(FutureTest, ExceptionPropagatesThroughChain)
+{
+	Promise<int> promise;
+	auto future = promise.get_future().then([](Future<int>) -> int {
+		throw 1;
+	}).then([](Future<int> f) {
+		return f.has_exception();
+	});
+
+	promise.set_value(0);
+
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_TRUE(future.get());
+}
+
+TEST(FutureTest, LongInlineChainDoesNotGrowStack)
+{
+	// Without trampolining each link nests a few frames; this depth overflows a 1 MB stack by far.
+	constexpr int chainLength = 200000;
+
+	Promise<int> promise;
+	auto future = promise.get_future();
+
+	for (int i = 0; i < chainLength; ++i) {
+		future = future.then([](Future<int> f) {
+			return f.get() + 1;
+		});
+	}
+
+	// Complete the chain on a fresh thread, so that the test doesn't depend on the stack size of the main thread.
+	std::thread([&] { promise.set_value(0); }).join();
+
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_EQ(future.get(), chainLength);
+}
+
+TEST(FutureTest, InlineContinuationsKeepOrder)
+{
+	Promise<void> promise;
+	std::vector<int> order;
+
+	auto first = promise.get_future().then([&](Future<void>) { order.push_back(1); });
+	first.then([&](Future<void>) { order.push_back(3); });
+	promise.get_future().then([&](Future<void>) { order.push_back(2); });
+
+	promise.set();
+
+	// a continuation scheduled by a running inline continuation runs right after the running one returned
+	EXPECT_EQ(order, (std::vector<int>{1, 3, 2}));
+}
+
+TEST(FutureTest, WhenAllEmptyIsReady)
+{
+	auto future = when_all(std::vector<Future<int>>());
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_TRUE(future.get().empty());
+}
+
+TEST(FutureTest, WhenAllWaitsForAll)
+{
+	Promise<int> a;
+	Promise<int> b;
+
+	auto all = when_all(std::vector<Future<int>>{a.get_future(), b.get_future()});
+
+	a.set_value(1);
+	EXPECT_FALSE(all.is_ready());
+	b.set_value(2);
+
+	ASSERT_TRUE(all.is_ready());
+	auto futures = all.get();
+	ASSERT_EQ(futures.size(), 2);
+	EXPECT_EQ(futures[0].get(), 1);
+	EXPECT_EQ(futures[1].get(), 2);
+}
+
+TEST(FutureTest, WhenAnyProvidesFirstReadyIndex)
+{
+	Promise<int> a;
+	Promise<int> b;
+
+	auto any = when_any(std::vector<Future<int>>{a.get_future(), b.get_future()});
+	EXPECT_FALSE(any.is_ready());
+
+	b.set_value(2);
+	a.set_value(1);
+
+	ASSERT_TRUE(any.is_ready());
+	EXPECT_EQ(any.get(), 1);
+}
+
+TEST(FutureTest, WhenAnyEmptyThrows)
+{
+	EXPECT_THROW(when_any(std::vector<Future<int>>()), std::invalid_argument);
+}
+
+TEST(FutureTest, ConcurrentCompletion)
+{
+	constexpr int count = 64;
+	std::vector<Promise<int>> promises(count);
+	std::vector<Future<int>> futures;
+
+	for (auto& promise : promises) {
+		futures.emplace_back(promise.get_future().then([](Future<int> f) { return f.get() + 1; }));
+	}
+
+	auto all = when_all(futures);
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < count; ++i) {
+		threads.emplace_back([&, i] { promises[i].set_value(i); });
+	}
+	for (auto& thread : threads) thread.join();
+
+	ASSERT_TRUE(all.is_ready());
+	auto results = all.get();
+	for (int i = 0; i < count; ++i) {
+		EXPECT_EQ(results[i].get(), i + 1);
+	}
+}
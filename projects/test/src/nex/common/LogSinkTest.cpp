@@ -0,0 +1,113 @@
+#include <nex/common/Log.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace nex;
+
+namespace
+{
+	std::vector<std::string> readLines(const std::stringstream& stream)
+	{
+		std::vector<std::string> lines;
+		std::istringstream input(stream.str());
+		std::string line;
+		while (std::getline(input, line)) lines.push_back(line);
+		return lines;
+	}
+}
+
+TEST(LogSinkTest, SynchronousWrite)
+{
+	std::stringstream stream;
+	LogSink sink;
+	sink.registerStream(&stream);
+
+	sink.write("first", Info);
+	sink.write("second", Info);
+
+	EXPECT_EQ(readLines(stream), (std::vector<std::string>{"first", "second"}));
+}
+
+TEST(LogSinkTest, AsyncKeepsOrderAcrossThreads)
+{
+	constexpr int count = 2000;
+
+	std::stringstream stream;
+	LogSink sink;
+	sink.registerStream(&stream);
+	sink.startAsync({ 64, LogSink::OverflowPolicy::BLOCK, 1 });
+
+	// Two threads log alternately, so each message happens after the previous one of the other thread.
+	std::atomic<int> turn = 0;
+	auto run = [&](int parity) {
+		for (int i = parity; i < count; i += 2) {
+			while (turn.load() != i) std::this_thread::yield();
+			sink.write(std::to_string(i).c_str(), Info);
+			turn.store(i + 1);
+		}
+	};
+
+	std::thread even(run, 0);
+	std::thread odd(run, 1);
+	even.join();
+	odd.join();
+	sink.stopAsync();
+
+	const auto lines = readLines(stream);
+	ASSERT_EQ(lines.size(), count);
+	for (int i = 0; i < count; ++i) ASSERT_EQ(lines[i], std::to_string(i));
+}
+
+TEST(LogSinkTest, StopAsyncDoesNotLoseMessages)
+{
+	constexpr int threadCount = 4;
+	constexpr int messagesPerThread = 5000;
+
+	std::stringstream stream;
+	LogSink sink;
+	sink.registerStream(&stream);
+	sink.startAsync({ 16, LogSink::OverflowPolicy::BLOCK, 1 });
+
+	std::atomic<int> started = 0;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&] {
+			++started;
+			for (int i = 0; i < messagesPerThread; ++i) sink.write("message", Info);
+		});
+	}
+
+	// stop while the threads are still logging; later messages are written synchronously
+	while (started.load() != threadCount) std::this_thread::yield();
+	sink.stopAsync();
+
+	for (auto& thread : threads) thread.join();
+
+	EXPECT_EQ(readLines(stream).size(), threadCount * messagesPerThread);
+	EXPECT_EQ(sink.getDroppedCount(), 0);
+}
+
+TEST(LogSinkTest, DropPolicyKeepsErrors)
+{
+	std::stringstream stream;
+	LogSink sink;
+	sink.registerStream(&stream);
+
+	// long flush interval, so that the buffer fills up
+	sink.startAsync({ 4, LogSink::OverflowPolicy::DROP, 10000 });
+
+	// The ring buffers are thread local; log from a fresh thread, so that no other test shares its buffer.
+	std::thread([&] {
+		for (int i = 0; i < 100; ++i) sink.write("info", Info);
+		sink.write("error", Error);
+	}).join();
+	sink.stopAsync();
+
+	const auto lines = readLines(stream);
+	EXPECT_GT(sink.getDroppedCount(), 0);
+	ASSERT_FALSE(lines.empty());
+	EXPECT_NE(std::find(lines.begin(), lines.end(), "error"), lines.end());
+}
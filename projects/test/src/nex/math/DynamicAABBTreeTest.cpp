@@ -0,0 +1,215 @@
+#include <nex/math/DynamicAABBTree.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * Random boxes in a cube; the tree results are compared against a linear scan over the exact boxes.
+	 */
+	struct TestScene
+	{
+		std::mt19937 random{ 7 };
+		float worldSize;
+		std::vector<AABB> boxes;
+		std::vector<int32_t> proxies;
+		DynamicAABBTree tree;
+
+		explicit TestScene(int count, float margin = 0.1f) : worldSize(std::cbrt(static_cast<float>(count)) * 10.0f), tree(margin)
+		{
+			for (int i = 0; i < count; ++i) {
+				boxes.push_back(createBox());
+				proxies.push_back(tree.createProxy(boxes.back(), reinterpret_cast<void*>(static_cast<intptr_t>(i))));
+			}
+		}
+
+		AABB createBox()
+		{
+			std::uniform_real_distribution<float> position(0.0f, worldSize);
+			std::uniform_real_distribution<float> size(0.2f, 2.0f);
+			const glm::vec3 center(position(random), position(random), position(random));
+			const glm::vec3 extent(size(random));
+			return AABB(center - extent, center + extent);
+		}
+
+		int getIndex(int32_t proxy) const
+		{
+			return static_cast<int>(reinterpret_cast<intptr_t>(tree.getUserData(proxy)));
+		}
+
+		template<class Query>
+		std::set<int> collect(Query&& query)
+		{
+			std::set<int> result;
+			query([&](int32_t proxy) { result.insert(getIndex(proxy)); });
+			return result;
+		}
+
+		template<class Predicate>
+		std::set<int> scan(Predicate&& predicate) const
+		{
+			std::set<int> result;
+			for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+				if (predicate(boxes[i])) result.insert(i);
+			}
+			return result;
+		}
+	};
+
+	bool overlaps(const AABB& a, const AABB& b)
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x
+			&& a.min.y <= b.max.y && a.max.y >= b.min.y
+			&& a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	bool includes(const std::set<int>& superset, const std::set<int>& subset)
+	{
+		return std::includes(superset.begin(), superset.end(), subset.begin(), subset.end());
+	}
+
+	/**
+	 * An axis aligned box as frustum (planes pointing inwards).
+	 */
+	Frustum createBoxFrustum(const glm::vec3& min, const glm::vec3& max)
+	{
+		Frustum frustum;
+		frustum.planes[0] = Plane(glm::vec3(0, 0, 1), -min.z);
+		frustum.planes[1] = Plane(glm::vec3(0, 0, -1), max.z);
+		frustum.planes[2] = Plane(glm::vec3(1, 0, 0), -min.x);
+		frustum.planes[3] = Plane(glm::vec3(-1, 0, 0), max.x);
+		frustum.planes[4] = Plane(glm::vec3(0, 1, 0), -min.y);
+		frustum.planes[5] = Plane(glm::vec3(0, -1, 0), max.y);
+		return frustum;
+	}
+}
+
+TEST(DynamicAABBTreeTest, EmptyTree)
+{
+	DynamicAABBTree tree;
+	int count = 0;
+	tree.queryAABB(AABB(glm::vec3(-1.0f), glm::vec3(1.0f)), [&](int32_t) { ++count; });
+
+	EXPECT_EQ(count, 0);
+	EXPECT_TRUE(tree.validate());
+	EXPECT_EQ(tree.getStats().proxyCount, 0);
+}
+
+TEST(DynamicAABBTreeTest, FatBoxContainsBox)
+{
+	DynamicAABBTree tree(0.5f);
+	const AABB box(glm::vec3(0.0f), glm::vec3(1.0f));
+	const auto proxy = tree.createProxy(box, nullptr);
+
+	const auto& fat = tree.getFatAABB(proxy);
+	EXPECT_LE(fat.min.x, -0.5f);
+	EXPECT_GE(fat.max.x, 1.5f);
+}
+
+TEST(DynamicAABBTreeTest, SmallMoveDoesNotReinsert)
+{
+	DynamicAABBTree tree(0.5f);
+	const auto proxy = tree.createProxy(AABB(glm::vec3(0.0f), glm::vec3(1.0f)), nullptr);
+
+	EXPECT_FALSE(tree.moveProxy(proxy, AABB(glm::vec3(0.1f), glm::vec3(1.1f))));
+	EXPECT_TRUE(tree.moveProxy(proxy, AABB(glm::vec3(10.0f), glm::vec3(11.0f))));
+	EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicAABBTreeTest, QueriesAreConservative)
+{
+	TestScene scene(5000);
+	const auto size = scene.worldSize;
+	const glm::vec3 min(size * 0.3f);
+	const glm::vec3 max(size * 0.5f);
+
+	const AABB box(min, max);
+	EXPECT_TRUE(includes(scene.collect([&](auto&& cb) { scene.tree.queryAABB(box, cb); }),
+		scene.scan([&](const AABB& b) { return overlaps(box, b); })));
+
+	const auto frustum = createBoxFrustum(min, max);
+	EXPECT_TRUE(includes(scene.collect([&](auto&& cb) { scene.tree.queryFrustum(frustum, cb); }),
+		scene.scan([&](const AABB& b) { return overlaps(box, b); })));
+
+	const Sphere sphere(glm::vec3(size * 0.5f), size * 0.1f);
+	EXPECT_TRUE(includes(scene.collect([&](auto&& cb) { scene.tree.querySphere(sphere, cb); }),
+		scene.scan([&](const AABB& b) { return sphere.intersects(b); })));
+
+	const Ray ray(glm::vec3(0.0f), glm::normalize(glm::vec3(1.0f, 0.9f, 1.1f)));
+	EXPECT_TRUE(includes(scene.collect([&](auto&& cb) { scene.tree.queryRay(ray, 1e30f, cb); }),
+		scene.scan([&](const AABB& b) {
+			const auto result = b.testRayIntersection(ray);
+			return result.intersected && result.secondIntersection >= 0;
+		})));
+}
+
+TEST(DynamicAABBTreeTest, QueriesStayCorrectAfterMovesAndRemovals)
+{
+	TestScene scene(2000);
+	std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+
+	for (int round = 0; round < 10; ++round) {
+		for (size_t i = 0; i < scene.boxes.size(); i += 3) {
+			const glm::vec3 delta(offset(scene.random), offset(scene.random), offset(scene.random));
+			scene.boxes[i].min += delta;
+			scene.boxes[i].max += delta;
+			scene.tree.moveProxy(scene.proxies[i], scene.boxes[i]);
+		}
+	}
+
+	// replace every 10th proxy
+	for (size_t i = 0; i < scene.boxes.size(); i += 10) {
+		scene.tree.destroyProxy(scene.proxies[i]);
+		scene.proxies[i] = scene.tree.createProxy(scene.boxes[i], reinterpret_cast<void*>(static_cast<intptr_t>(i)));
+	}
+
+	ASSERT_TRUE(scene.tree.validate());
+	EXPECT_EQ(scene.tree.getStats().proxyCount, scene.boxes.size());
+
+	const AABB box(glm::vec3(scene.worldSize * 0.2f), glm::vec3(scene.worldSize * 0.6f));
+	EXPECT_TRUE(includes(scene.collect([&](auto&& cb) { scene.tree.queryAABB(box, cb); }),
+		scene.scan([&](const AABB& b) { return overlaps(box, b); })));
+}
+
+TEST(DynamicAABBTreeTest, NearestMatchesLinearScan)
+{
+	constexpr int count = 3000;
+	constexpr size_t k = 4;
+
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> position(0.0f, 100.0f);
+	DynamicAABBTree tree(0.0f);
+	std::vector<glm::vec3> points;
+
+	for (int i = 0; i < count; ++i) {
+		points.emplace_back(position(random), position(random), position(random));
+		tree.createProxy(AABB(points.back(), points.back()), reinterpret_cast<void*>(static_cast<intptr_t>(i)));
+	}
+
+	for (int query = 0; query < 20; ++query) {
+		const glm::vec3 point(position(random), position(random), position(random));
+
+		// only even indices are valid candidates
+		std::vector<int32_t> result;
+		tree.queryNearest(point, k, [&](int32_t proxy) {
+			return reinterpret_cast<intptr_t>(tree.getUserData(proxy)) % 2 == 0;
+		}, result);
+
+		std::vector<int> expected;
+		for (int i = 0; i < count; i += 2) expected.push_back(i);
+		std::partial_sort(expected.begin(), expected.begin() + k, expected.end(), [&](int a, int b) {
+			const auto da = points[a] - point;
+			const auto db = points[b] - point;
+			return glm::dot(da, da) < glm::dot(db, db);
+		});
+
+		ASSERT_EQ(result.size(), k);
+		for (size_t i = 0; i < k; ++i) {
+			EXPECT_EQ(reinterpret_cast<intptr_t>(tree.getUserData(result[i])), expected[i]);
+		}
+	}
+}
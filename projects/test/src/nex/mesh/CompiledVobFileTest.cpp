@@ -0,0 +1,266 @@
+#include <nex/mesh/CompiledVobFile.hpp>
+#include <nex/common/File.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * A file in the temp directory, that is removed when the test ends.
+	 */
+	class TempFile
+	{
+	public:
+		explicit TempFile(const std::string& name) :
+			mPath(std::filesystem::temp_directory_path() / "EngineTest" / name)
+		{
+			std::filesystem::create_directories(mPath.parent_path());
+		}
+
+		~TempFile()
+		{
+			std::error_code error;
+			std::filesystem::remove(mPath, error);
+		}
+
+		const std::filesystem::path& getPath() const
+		{
+			return mPath;
+		}
+
+	private:
+		std::filesystem::path mPath;
+	};
+
+	std::vector<char> createData(size_t size, char seed)
+	{
+		std::vector<char> data(size);
+		for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>(seed + i * 7);
+		return data;
+	}
+
+	/**
+	 * Creates a mesh with a single vertex buffer (position only) and 32 bit indices.
+	 * The vertex and index counts are odd, so that unaligned data sizes are covered.
+	 */
+	MeshStore createMesh(size_t vertexCount, size_t indexCount, char seed)
+	{
+		MeshStore mesh;
+		mesh.indexType = IndexElementType::BIT_32;
+		mesh.layout.push<glm::vec3>(1, nullptr, false, false, true);
+		mesh.boundingBox.min = glm::vec3(-1.0f);
+		mesh.boundingBox.max = glm::vec3(1.0f);
+		mesh.topology = Topology::TRIANGLES;
+		mesh.material.albedoMap = "albedo_" + std::to_string(seed) + ".png";
+		mesh.indices = createData(indexCount * sizeof(uint32_t), seed);
+		mesh.verticesMap[nullptr] = createData(vertexCount * sizeof(glm::vec3), seed + 1);
+		mesh.useIndexBuffer = true;
+		mesh.arrayOffset = 0;
+		mesh.vertexCount = vertexCount;
+		mesh.isSkinned = false;
+		return mesh;
+	}
+
+	VobBaseStore createStore()
+	{
+		VobBaseStore store;
+		store.localToParentTrafo = glm::mat4(2.0f);
+		store.nodeName = "root";
+		store.meshes.push_back(createMesh(17, 33, 1));
+		store.meshes.push_back(createMesh(5, 9, 2));
+
+		VobBaseStore child;
+		child.localToParentTrafo = glm::mat4(1.0f);
+		child.nodeName = "child";
+		child.meshes.push_back(createMesh(31, 45, 3));
+		store.children.push_back(std::move(child));
+
+		return store;
+	}
+
+	std::vector<char> toVector(const MeshDataView& view)
+	{
+		return std::vector<char>(view.data, view.data + view.size);
+	}
+
+	void expectSameMesh(const MeshStore& actual, const MeshStore& expected)
+	{
+		EXPECT_EQ(toVector(actual.getIndexData()), expected.indices);
+
+		const auto vertices = actual.getVertexData();
+		ASSERT_EQ(vertices.size(), expected.verticesMap.size());
+		for (const auto& it : expected.verticesMap) {
+			ASSERT_EQ(vertices.count(it.first), 1);
+			EXPECT_EQ(toVector(vertices.at(it.first)), it.second);
+		}
+
+		EXPECT_EQ(actual.vertexCount, expected.vertexCount);
+		EXPECT_EQ(actual.indexType, expected.indexType);
+		EXPECT_EQ(actual.material.albedoMap, expected.material.albedoMap);
+		EXPECT_EQ(actual.layout.getLayout(nullptr)->stride, expected.layout.getLayout(nullptr)->stride);
+	}
+
+	void expectSameStore(const VobBaseStore& actual, const VobBaseStore& expected)
+	{
+		EXPECT_EQ(actual.nodeName, expected.nodeName);
+		EXPECT_EQ(actual.localToParentTrafo, expected.localToParentTrafo);
+
+		ASSERT_EQ(actual.meshes.size(), expected.meshes.size());
+		for (size_t i = 0; i < expected.meshes.size(); ++i) expectSameMesh(actual.meshes[i], expected.meshes[i]);
+
+		ASSERT_EQ(actual.children.size(), expected.children.size());
+		for (size_t i = 0; i < expected.children.size(); ++i) expectSameStore(actual.children[i], expected.children[i]);
+	}
+
+	bool isAligned(const char* data)
+	{
+		return reinterpret_cast<uintptr_t>(data) % CompiledVobFile::ALIGNMENT == 0;
+	}
+
+	/**
+	 * Writes a version 1 file, i.e. a plain BinStream encoded store.
+	 */
+	void writeVersion1(const std::filesystem::path& path, const VobBaseStore& store, bool compress = false)
+	{
+		BinStream file;
+		if (compress) {
+			file.openCompressed(path);
+		}
+		else {
+			file.open(path, std::ios::out | std::ios::trunc);
+		}
+		file << store;
+		file.close();
+	}
+}
+
+TEST(CompiledVobFileTest, MeshDataReferencesAlignedMapping)
+{
+	TempFile file("mapped.CVOB");
+	const auto expected = createStore();
+	CompiledVobFile::write(file.getPath(), expected);
+
+	VobBaseStore store;
+	CompiledVobFile compiled;
+	compiled.read(file.getPath(), store);
+
+	EXPECT_EQ(compiled.getVersion(), CompiledVobFile::VERSION);
+	EXPECT_FALSE(compiled.isCompressed());
+	EXPECT_EQ(compiled.getMappedSize(), std::filesystem::file_size(file.getPath()));
+	expectSameStore(store, expected);
+
+	for (const auto* vob : { &store, &store.children[0] }) {
+		for (const auto& mesh : vob->meshes) {
+			// nothing is copied out of the mapping
+			EXPECT_TRUE(mesh.usesDataViews);
+			EXPECT_TRUE(mesh.indices.empty());
+			EXPECT_TRUE(mesh.verticesMap.empty());
+
+			EXPECT_TRUE(isAligned(mesh.indicesView.data));
+			for (const auto& it : mesh.verticesViewMap) EXPECT_TRUE(isAligned(it.second.data));
+		}
+	}
+}
+
+TEST(CompiledVobFileTest, Version1FilesAreReadAndConverted)
+{
+	TempFile file("version1.CVOB");
+	const auto expected = createStore();
+	writeVersion1(file.getPath(), expected);
+
+	{
+		VobBaseStore store;
+		CompiledVobFile compiled;
+		compiled.read(file.getPath(), store);
+
+		EXPECT_EQ(compiled.getVersion(), 1);
+		EXPECT_EQ(compiled.getMappedSize(), 0);
+		EXPECT_FALSE(store.meshes[0].usesDataViews);
+		expectSameStore(store, expected);
+	}
+
+	// in place conversion
+	CompiledVobFile::convert(file.getPath(), file.getPath());
+
+	VobBaseStore store;
+	CompiledVobFile compiled;
+	compiled.read(file.getPath(), store);
+
+	EXPECT_EQ(compiled.getVersion(), CompiledVobFile::VERSION);
+	EXPECT_TRUE(store.meshes[0].usesDataViews);
+	expectSameStore(store, expected);
+}
+
+TEST(CompiledVobFileTest, CompressedFilesAreReadIntoMemory)
+{
+	TempFile file("compressed.CVOB");
+	const auto expected = createStore();
+	CompiledVobFile::write(file.getPath(), expected, true);
+
+	VobBaseStore store;
+	CompiledVobFile compiled;
+	compiled.read(file.getPath(), store);
+
+	EXPECT_EQ(compiled.getVersion(), CompiledVobFile::VERSION);
+	EXPECT_TRUE(compiled.isCompressed());
+	EXPECT_EQ(compiled.getMappedSize(), 0);
+	expectSameStore(store, expected);
+}
+
+TEST(CompiledVobFileTest, ConversionKeepsCompression)
+{
+	TempFile source("compressed_version1.CVOB");
+	TempFile destination("compressed_version2.CVOB");
+	const auto expected = createStore();
+	writeVersion1(source.getPath(), expected, true);
+
+	CompiledVobFile::convert(source.getPath(), destination.getPath());
+
+	VobBaseStore store;
+	CompiledVobFile compiled;
+	compiled.read(destination.getPath(), store);
+
+	EXPECT_EQ(compiled.getVersion(), CompiledVobFile::VERSION);
+	EXPECT_TRUE(compiled.isCompressed());
+	expectSameStore(store, expected);
+}
+
+TEST(CompiledVobFileTest, TruncatedFileThrows)
+{
+	TempFile file("truncated.CVOB");
+	CompiledVobFile::write(file.getPath(), createStore());
+	std::filesystem::resize_file(file.getPath(), std::filesystem::file_size(file.getPath()) - sizeof(CompiledVobFile::Section));
+
+	VobBaseStore store;
+	CompiledVobFile compiled;
+	EXPECT_THROW(compiled.read(file.getPath(), store), std::runtime_error);
+}
+
+TEST(CompiledVobFileTest, InvalidSectionThrows)
+{
+	TempFile file("invalid.CVOB");
+	CompiledVobFile::write(file.getPath(), createStore());
+
+	// move the section table entry of the first mesh data section to an unaligned offset
+	{
+		CompiledVobFile::Header header;
+		std::fstream stream(file.getPath(), std::ios::in | std::ios::out | std::ios::binary);
+		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+		CompiledVobFile::Section section;
+		const auto position = header.sectionTableOffset + sizeof(CompiledVobFile::Section);
+		stream.seekg(position);
+		stream.read(reinterpret_cast<char*>(&section), sizeof(section));
+		section.offset += 1;
+		stream.seekp(position);
+		stream.write(reinterpret_cast<const char*>(&section), sizeof(section));
+	}
+
+	VobBaseStore store;
+	CompiledVobFile compiled;
+	EXPECT_THROW(compiled.read(file.getPath(), store), std::runtime_error);
+}
@@ -0,0 +1,232 @@
+#include <nex/renderer/BatchCuller.hpp>
+#include <nex/camera/Camera.hpp>
+#include <nex/math/Sphere.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace nex;
+
+namespace
+{
+	using InstructionSet = BatchCuller::InstructionSet;
+
+	/**
+	 * The per box frustum test, that RenderCommandQueue used before batch culling.
+	 */
+	bool boxInFrustum(const Frustum& frustum, const AABB& box)
+	{
+		const unsigned char ALL_CORNERS = 8;
+		unsigned char out = 0;
+
+		for (const auto& plane : frustum.planes) {
+			const glm::vec4 planeAsVec(plane.mNormal, plane.mSignedDistance);
+			out = 0;
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.min.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.min.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.max.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.min.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.max.y, box.min.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.min.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.min.x, box.max.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			out += ((dot(planeAsVec, glm::vec4(box.max.x, box.max.y, box.max.z, 1.0f)) < 0.0) ? 1 : 0);
+			if (out == ALL_CORNERS) return false;
+		}
+
+		out = 0; for (const auto& c : frustum.corners) out += ((c.x > box.max.x) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.x < box.min.x) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.y > box.max.y) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.y < box.min.y) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.z > box.max.z) ? 1 : 0); if (out == ALL_CORNERS) return false;
+		out = 0; for (const auto& c : frustum.corners) out += ((c.z < box.min.z) ? 1 : 0); if (out == ALL_CORNERS) return false;
+
+		return true;
+	}
+
+	class RandomScene
+	{
+	public:
+		explicit RandomScene(unsigned seed) : mRandom(seed) {}
+
+		float get(float min, float max)
+		{
+			return std::uniform_real_distribution<float>(min, max)(mRandom);
+		}
+
+		unsigned getIndex(unsigned count)
+		{
+			return mRandom() % count;
+		}
+
+		/**
+		 * A perspective frustum with random position, direction, aspect and near/far planes; planes point inwards.
+		 */
+		Frustum createFrustum()
+		{
+			Frustum frustum;
+			const glm::vec3 origin(get(-20, 20), get(-20, 20), get(-20, 20));
+			const auto dir = glm::normalize(glm::vec3(get(-1, 1), get(-1, 1), get(-1, 1)) + glm::vec3(0.001f));
+			const auto right = glm::normalize(glm::cross(dir, glm::vec3(0, 1, 0)));
+			const auto up = glm::cross(right, dir);
+			const float nearDistance = get(0.1f, 2.0f);
+			const float farDistance = get(10.0f, 100.0f);
+			const float tan = get(0.3f, 1.2f);
+
+			auto corner = [&](float d, float sx, float sy) {
+				return origin + dir * d + right * (sx * d * tan * 1.5f) + up * (sy * d * tan);
+			};
+
+			frustum.corners[0] = corner(farDistance, -1, -1);
+			frustum.corners[1] = corner(farDistance, -1, 1);
+			frustum.corners[2] = corner(farDistance, 1, -1);
+			frustum.corners[3] = corner(farDistance, 1, 1);
+			frustum.corners[4] = corner(nearDistance, -1, -1);
+			frustum.corners[5] = corner(nearDistance, -1, 1);
+			frustum.corners[6] = corner(nearDistance, 1, -1);
+			frustum.corners[7] = corner(nearDistance, 1, 1);
+
+			const auto center = origin + dir * ((nearDistance + farDistance) * 0.5f);
+
+			auto plane = [&](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+				auto normal = glm::normalize(glm::cross(b - a, c - a));
+				if (glm::dot(normal, center - a) < 0) normal = -normal;
+				return Plane(normal, -glm::dot(normal, a));
+			};
+
+			const auto& c = frustum.corners;
+			frustum.planes[0] = plane(c[4], c[5], c[6]);
+			frustum.planes[1] = plane(c[0], c[1], c[2]);
+			frustum.planes[2] = plane(c[0], c[1], c[4]);
+			frustum.planes[3] = plane(c[2], c[3], c[6]);
+			frustum.planes[4] = plane(c[0], c[2], c[4]);
+			frustum.planes[5] = plane(c[1], c[3], c[5]);
+			return frustum;
+		}
+
+		AABB createBox()
+		{
+			const glm::vec3 center(get(-60, 60), get(-60, 60), get(-60, 60));
+			const glm::vec3 extent(get(0, 5), get(0, 5), get(0, 5));
+			return AABB(center - extent, center + extent);
+		}
+
+	private:
+		std::mt19937 mRandom;
+	};
+
+	bool isVisible(const std::vector<uint32_t>& visibility, size_t i)
+	{
+		return (visibility[i / 32] >> (i % 32)) & 1;
+	}
+
+	std::vector<InstructionSet> getTestedInstructionSets()
+	{
+		std::vector<InstructionSet> sets = { InstructionSet::SCALAR };
+		const auto supported = BatchCuller::getSupportedInstructionSet();
+		if (supported >= InstructionSet::SSE) sets.push_back(InstructionSet::SSE);
+		if (supported >= InstructionSet::AVX) sets.push_back(InstructionSet::AVX);
+		return sets;
+	}
+}
+
+TEST(BatchCullerTest, EmptyBatch)
+{
+	const AABBBatch boxes;
+	EXPECT_EQ(BatchCuller::getMaskWordCount(0), 0);
+
+	// mustn't write anything
+	uint32_t visibility = 0xDEADBEEF;
+	BatchCuller::cullFrustum(Frustum(), boxes, &visibility);
+	EXPECT_EQ(visibility, 0xDEADBEEF);
+}
+
+TEST(BatchCullerTest, MaskWordCount)
+{
+	EXPECT_EQ(BatchCuller::getMaskWordCount(1), 1);
+	EXPECT_EQ(BatchCuller::getMaskWordCount(32), 1);
+	EXPECT_EQ(BatchCuller::getMaskWordCount(33), 2);
+}
+
+TEST(BatchCullerTest, FrustumMatchesPerBoxTest)
+{
+	RandomScene scene(42);
+
+	for (int round = 0; round < 200; ++round) {
+		const auto frustum = scene.createFrustum();
+		const size_t count = 1 + scene.getIndex(1000);
+
+		std::vector<AABB> boxes;
+		AABBBatch batch;
+
+		for (size_t i = 0; i < count; ++i) {
+			auto box = scene.createBox();
+			// degenerated boxes exactly on a frustum corner
+			if (i % 7 == 0) box.min = box.max = frustum.corners[scene.getIndex(8)];
+			boxes.push_back(box);
+			batch.push(box);
+		}
+
+		for (auto set : getTestedInstructionSets()) {
+			std::vector<uint32_t> visibility(BatchCuller::getMaskWordCount(count));
+			BatchCuller::cullFrustum(frustum, batch, visibility.data(), set);
+
+			for (size_t i = 0; i < count; ++i) {
+				ASSERT_EQ(isVisible(visibility, i), boxInFrustum(frustum, boxes[i]))
+					<< "set " << static_cast<int>(set) << ", round " << round << ", box " << i;
+			}
+
+			// bits behind the last box are cleared
+			if (count % 32) {
+				EXPECT_EQ(visibility.back() >> (count % 32), 0);
+			}
+		}
+	}
+}
+
+TEST(BatchCullerTest, SphereMatchesPerBoxTest)
+{
+	RandomScene scene(7);
+
+	for (int round = 0; round < 200; ++round) {
+		const Sphere sphere(glm::vec3(scene.get(-20, 20), scene.get(-20, 20), scene.get(-20, 20)), scene.get(0, 30));
+		const size_t count = 1 + scene.getIndex(1000);
+
+		std::vector<AABB> boxes;
+		AABBBatch batch;
+
+		for (size_t i = 0; i < count; ++i) {
+			auto box = scene.createBox();
+			// degenerated boxes exactly on the sphere surface
+			if (i % 11 == 0) box.min = box.max = sphere.origin + glm::vec3(sphere.radius, 0, 0);
+			boxes.push_back(box);
+			batch.push(box);
+		}
+
+		for (auto set : getTestedInstructionSets()) {
+			std::vector<uint32_t> visibility(BatchCuller::getMaskWordCount(count));
+			BatchCuller::cullSphere(sphere, batch, visibility.data(), set);
+
+			for (size_t i = 0; i < count; ++i) {
+				ASSERT_EQ(isVisible(visibility, i), sphere.intersects(boxes[i]))
+					<< "set " << static_cast<int>(set) << ", round " << round << ", box " << i;
+			}
+
+			if (count % 32) {
+				EXPECT_EQ(visibility.back() >> (count % 32), 0);
+			}
+		}
+	}
+}
+
+TEST(BatchCullerTest, ClearKeepsBoxesOut)
+{
+	AABBBatch batch;
+	batch.push(AABB(glm::vec3(0.0f), glm::vec3(1.0f)));
+	batch.clear();
+	batch.push(AABB(glm::vec3(100.0f), glm::vec3(101.0f)));
+	ASSERT_EQ(batch.size(), 1);
+
+	const Sphere sphere(glm::vec3(0.0f), 2.0f);
+	uint32_t visibility = 0;
+	BatchCuller::cullSphere(sphere, batch, &visibility);
+	EXPECT_EQ(visibility, 0);
+}
@@ -0,0 +1,162 @@
+#include <nex/renderer/FinalizeScheduler.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace nex;
+
+namespace
+{
+	void sleepMillis(int millis)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+	}
+}
+
+TEST(FinalizeSchedulerTest, ExecutesByPriorityAndFifoWithinPriority)
+{
+	FinalizeScheduler scheduler(1000.0f);
+	std::vector<int> order;
+
+	scheduler.submit([&]() { order.push_back(3); }, FinalizeScheduler::Priority::Prefetch);
+	scheduler.submit([&]() { order.push_back(1); }, FinalizeScheduler::Priority::Normal);
+	scheduler.submit([&]() { order.push_back(0); }, FinalizeScheduler::Priority::VisibleNow);
+	scheduler.submit([&]() { order.push_back(2); }, FinalizeScheduler::Priority::Normal);
+
+	scheduler.execute();
+
+	EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2, 3 }));
+	EXPECT_EQ(scheduler.getFrameStats().completedTasks, 4);
+	EXPECT_TRUE(scheduler.isIdle());
+}
+
+TEST(FinalizeSchedulerTest, CommandQueueTasksHaveNormalPriority)
+{
+	FinalizeScheduler scheduler(1000.0f);
+	FinalizeScheduler::TaskQueue commandQueue(16);
+	std::vector<int> order;
+
+	scheduler.submit([&]() { order.push_back(2); }, FinalizeScheduler::Priority::Prefetch);
+	scheduler.submit([&]() { order.push_back(0); }, FinalizeScheduler::Priority::VisibleNow);
+	commandQueue.push([&]() { order.push_back(1); });
+
+	scheduler.execute(&commandQueue);
+
+	EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2 }));
+	EXPECT_TRUE(commandQueue.empty());
+}
+
+TEST(FinalizeSchedulerTest, BudgetDefersRemainingTasks)
+{
+	FinalizeScheduler scheduler(1.0f);
+	size_t executed = 0;
+
+	for (int i = 0; i < 4; ++i) {
+		scheduler.submit([&]() {
+			sleepMillis(5);
+			++executed;
+		});
+	}
+
+	scheduler.execute();
+
+	// the first task exceeds the budget; the others have to wait for the next frames
+	EXPECT_EQ(executed, 1);
+	EXPECT_EQ(scheduler.getFrameStats().completedTasks, 1);
+	EXPECT_EQ(scheduler.getFrameStats().deferredTasks, 3);
+	EXPECT_FALSE(scheduler.isIdle());
+
+	scheduler.executeAll();
+	EXPECT_EQ(executed, 4);
+	EXPECT_TRUE(scheduler.isIdle());
+}
+
+TEST(FinalizeSchedulerTest, SteppedTaskIsSpreadOverFrames)
+{
+	FinalizeScheduler scheduler(1.0f);
+	int steps = 0;
+
+	scheduler.submitStepped([&]() {
+		sleepMillis(5);
+		return ++steps == 3;
+	});
+
+	scheduler.execute();
+	EXPECT_EQ(steps, 1);
+	EXPECT_EQ(scheduler.getFrameStats().completedTasks, 0);
+	EXPECT_EQ(scheduler.getFrameStats().deferredTasks, 1);
+
+	scheduler.execute();
+	scheduler.execute();
+	EXPECT_EQ(steps, 3);
+	EXPECT_EQ(scheduler.getFrameStats().completedTasks, 1);
+	EXPECT_TRUE(scheduler.isIdle());
+}
+
+TEST(FinalizeSchedulerTest, HigherPriorityTaskOvertakesSteppedTask)
+{
+	FinalizeScheduler scheduler(1000.0f);
+	std::vector<int> order;
+	int steps = 0;
+
+	scheduler.submitStepped([&]() {
+		order.push_back(1);
+		if (steps++ == 0) {
+			scheduler.submit([&]() { order.push_back(0); }, FinalizeScheduler::Priority::VisibleNow);
+		}
+		return steps == 2;
+	}, FinalizeScheduler::Priority::Prefetch);
+
+	scheduler.executeAll();
+
+	EXPECT_EQ(order, (std::vector<int>{ 1, 0, 1 }));
+}
+
+TEST(FinalizeSchedulerTest, ThrowingTaskIsCompletedAndDoesNotStopExecution)
+{
+	FinalizeScheduler scheduler(1000.0f);
+	int calls = 0;
+	bool nextExecuted = false;
+
+	scheduler.submitStepped([&]() -> bool {
+		++calls;
+		throw std::runtime_error("finalization failed");
+	});
+	scheduler.submit([&]() { throw 42; });
+	scheduler.submit([&]() { nextExecuted = true; });
+
+	EXPECT_NO_THROW(scheduler.execute());
+
+	EXPECT_EQ(calls, 1);
+	EXPECT_TRUE(nextExecuted);
+	EXPECT_EQ(scheduler.getFrameStats().completedTasks, 3);
+	EXPECT_TRUE(scheduler.isIdle());
+}
+
+TEST(FinalizeSchedulerTest, ContinuationOfFailedFinalizationGetsReady)
+{
+	FinalizeScheduler scheduler(1000.0f);
+	Promise<void> finalized;
+
+	// the same pattern as VobBluePrint::finalizeAsync
+	scheduler.submitStepped([promise = finalized]() mutable {
+		try {
+			throw std::runtime_error("finalization failed");
+		}
+		catch (const std::exception& e) {
+			promise.set_exception(std::make_shared<std::runtime_error>(e.what()));
+		}
+		return true;
+	});
+
+	auto future = finalized.get_future().then(scheduler.getExecutor(), [](Future<void> f) {
+		return f.has_exception();
+	});
+
+	scheduler.executeAll();
+
+	ASSERT_TRUE(future.is_ready());
+	EXPECT_TRUE(future.get());
+}
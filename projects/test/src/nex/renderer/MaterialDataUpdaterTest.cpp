@@ -0,0 +1,162 @@
+#include <nex/renderer/MaterialDataUpdater.hpp>
+#include <nex/buffer/ShaderBuffer.hpp>
+#include <nex/scene/Vob.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace nex;
+
+namespace
+{
+	constexpr unsigned CAPACITY = 256;
+
+	std::vector<std::unique_ptr<Vob>> createVobs(MaterialDataUpdater& updater, size_t count)
+	{
+		std::vector<std::unique_ptr<Vob>> vobs;
+		for (size_t i = 0; i < count; ++i) {
+			vobs.emplace_back(std::make_unique<Vob>());
+			updater.attach(vobs.back().get());
+		}
+		return vobs;
+	}
+
+	PerObjectMaterialData createData(float emissionStrength)
+	{
+		PerObjectMaterialData data;
+		data.emissionStrength = emissionStrength;
+		return data;
+	}
+
+	float getUploadedEmission(const ShaderBuffer& buffer, unsigned slot)
+	{
+		const auto* data = static_cast<const PerObjectMaterialData*>(buffer.map(GpuBuffer::Access::READ_ONLY));
+		const auto emission = data[slot].emissionStrength;
+		buffer.unmap();
+		return emission;
+	}
+}
+
+TEST(MaterialDataUpdaterTest, SlotsAreStableAndReused)
+{
+	MaterialDataUpdater updater(CAPACITY);
+	auto vobs = createVobs(updater, 3);
+
+	for (unsigned i = 0; i < 3; ++i) EXPECT_EQ(vobs[i]->getPerObjectMaterialDataID(), i);
+
+	updater.detach(vobs[1].get());
+	EXPECT_EQ(updater.getUsedSlotCount(), 2);
+
+	auto added = createVobs(updater, 2);
+	EXPECT_EQ(added[0]->getPerObjectMaterialDataID(), 1);
+	EXPECT_EQ(added[1]->getPerObjectMaterialDataID(), 3);
+
+	// the remaining vobs keep their slots
+	EXPECT_EQ(vobs[0]->getPerObjectMaterialDataID(), 0);
+	EXPECT_EQ(vobs[2]->getPerObjectMaterialDataID(), 2);
+	EXPECT_EQ(updater.getUsedSlotCount(), 4);
+}
+
+TEST(MaterialDataUpdaterTest, OnlyVobsUsingMaterialDataHaveSlots)
+{
+	MaterialDataUpdater updater(CAPACITY);
+	Vob vob;
+	vob.usePerObjectMaterialData(false);
+	updater.attach(&vob);
+	EXPECT_EQ(updater.getUsedSlotCount(), 0);
+
+	vob.usePerObjectMaterialData(true);
+	EXPECT_EQ(updater.getUsedSlotCount(), 1);
+
+	vob.usePerObjectMaterialData(false);
+	EXPECT_EQ(updater.getUsedSlotCount(), 0);
+}
+
+TEST(MaterialDataUpdaterTest, DestroyedVobReleasesSlot)
+{
+	MaterialDataUpdater updater(CAPACITY);
+	auto vobs = createVobs(updater, 2);
+
+	vobs[0].reset();
+	EXPECT_EQ(updater.getUsedSlotCount(), 1);
+	EXPECT_EQ(createVobs(updater, 1)[0]->getPerObjectMaterialDataID(), 0);
+}
+
+TEST(MaterialDataUpdaterTest, VobsExceedingCapacityUseSlotZero)
+{
+	MaterialDataUpdater updater(2);
+	auto vobs = createVobs(updater, 3);
+
+	EXPECT_EQ(updater.getUsedSlotCount(), 2);
+	EXPECT_EQ(vobs[2]->getPerObjectMaterialDataID(), 0);
+
+	// the data of the vob owning slot 0 mustn't be overwritten
+	updater.markDirty(vobs[2].get());
+	ShaderStorageBuffer buffer(0, 0, nullptr, GpuBuffer::UsageHint::DYNAMIC_DRAW);
+	vobs[0]->setPerObjectMaterialData(createData(2.0f));
+	vobs[2]->setPerObjectMaterialData(createData(3.0f));
+	updater.upload(&buffer);
+	EXPECT_EQ(getUploadedEmission(buffer, 0), 2.0f);
+}
+
+TEST(MaterialDataUpdaterTest, FirstUploadIsFull)
+{
+	MaterialDataUpdater updater(CAPACITY);
+	auto vobs = createVobs(updater, 10);
+	ShaderStorageBuffer buffer(0, 0, nullptr, GpuBuffer::UsageHint::DYNAMIC_DRAW);
+
+	updater.upload(&buffer);
+	const auto& stats = updater.getStats();
+	EXPECT_TRUE(stats.fullUpload);
+	EXPECT_EQ(stats.dirtySlots, 10);
+	EXPECT_EQ(stats.uploads, 1);
+	EXPECT_EQ(stats.uploadedBytes, CAPACITY * sizeof(PerObjectMaterialData));
+	EXPECT_EQ(buffer.getSize(), CAPACITY * sizeof(PerObjectMaterialData));
+
+	// a different buffer gets a full upload, too
+	ShaderStorageBuffer other(0, 0, nullptr, GpuBuffer::UsageHint::DYNAMIC_DRAW);
+	updater.upload(&other);
+	EXPECT_TRUE(updater.getStats().fullUpload);
+}
+
+TEST(MaterialDataUpdaterTest, DirtyRangesAreCoalesced)
+{
+	MaterialDataUpdater updater(CAPACITY);
+	auto vobs = createVobs(updater, 200);
+	ShaderStorageBuffer buffer(0, 0, nullptr, GpuBuffer::UsageHint::DYNAMIC_DRAW);
+	updater.upload(&buffer);
+
+	// two runs: slots 3-5 and slot 130 (in another bitset word)
+	for (auto slot : { 5, 3, 4, 130 }) {
+		vobs[slot]->setPerObjectMaterialData(createData(static_cast<float>(slot)));
+	}
+
+	updater.upload(&buffer);
+	const auto& stats = updater.getStats();
+	EXPECT_FALSE(stats.fullUpload);
+	EXPECT_EQ(stats.dirtySlots, 4);
+	EXPECT_EQ(stats.uploads, 2);
+	EXPECT_EQ(stats.uploadedBytes, 4 * sizeof(PerObjectMaterialData));
+
+	for (auto slot : { 3, 4, 5, 130 }) {
+		EXPECT_EQ(getUploadedEmission(buffer, slot), static_cast<float>(slot));
+	}
+
+	// nothing changed since the last upload
+	updater.upload(&buffer);
+	EXPECT_EQ(updater.getStats().uploads, 0);
+	EXPECT_EQ(updater.getStats().uploadedBytes, 0);
+}
+
+TEST(MaterialDataUpdaterTest, NonConstAccessMarksDirty)
+{
+	MaterialDataUpdater updater(CAPACITY);
+	auto vobs = createVobs(updater, 2);
+	ShaderStorageBuffer buffer(0, 0, nullptr, GpuBuffer::UsageHint::DYNAMIC_DRAW);
+	updater.upload(&buffer);
+
+	vobs[1]->getPerObjectMaterialData().emissionStrength = 5.0f;
+
+	updater.upload(&buffer);
+	EXPECT_EQ(updater.getStats().dirtySlots, 1);
+	EXPECT_EQ(getUploadedEmission(buffer, 1), 5.0f);
+}
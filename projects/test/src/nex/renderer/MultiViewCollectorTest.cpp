@@ -0,0 +1,176 @@
+#include <nex/renderer/MultiViewCollector.hpp>
+#include <nex/renderer/TestBatches.hpp>
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * Random commands of one pbr mesh batch.
+	 */
+	class TestScene
+	{
+	public:
+
+		explicit TestScene(size_t count) : mBatch(mBatches.create(0))
+		{
+			std::mt19937 random(11);
+			std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> extent(0.1f, 3.0f);
+
+			mBoxes.reserve(count);
+
+			for (size_t i = 0; i < count; ++i) {
+				const glm::vec3 center(position(random), position(random), position(random));
+				mBoxes.emplace_back(center - glm::vec3(extent(random)), center + glm::vec3(extent(random)));
+
+				RenderCommand command;
+				command.batch = mBatch;
+				command.worldTrafo = &mTrafo;
+				command.prevWorldTrafo = &mTrafo;
+				command.boundingBox = &mBoxes.back();
+				mCommands.emplace_back(command);
+			}
+		}
+
+		/**
+		 * Pushes all commands to a queue with culling enabled, as Vob::collectRenderCommands does.
+		 */
+		void traverse(RenderCommandQueue& queue) const
+		{
+			for (const auto& command : mCommands) queue.push(command, true);
+		}
+
+	private:
+		test::TestBatches mBatches;
+		MeshBatch* mBatch;
+		glm::mat4 mTrafo = glm::mat4(1.0f);
+		std::vector<AABB> mBoxes;
+		std::vector<RenderCommand> mCommands;
+	};
+
+	PerspectiveCamera createCamera(const glm::vec3& position, const glm::vec3& target)
+	{
+		PerspectiveCamera camera(1920.0f, 1080.0f, glm::radians(60.0f), 0.1f, 80.0f);
+		camera.setPosition(position, true);
+		camera.lookAt(target);
+		camera.update();
+		return camera;
+	}
+
+	bool isVisible(const uint32_t* visibility, size_t i)
+	{
+		return (visibility[i / 32] >> (i % 32)) & 1;
+	}
+}
+
+TEST(MultiViewCollectorTest, ExtractedFrustumMatchesCameraFrustum)
+{
+	const auto camera = createCamera(glm::vec3(5.0f, 2.0f, 10.0f), glm::vec3(0.0f));
+	const auto frustum = extractFrustum(camera.getViewProj());
+	const auto& expected = camera.getFrustumWorld();
+
+	for (unsigned i = 0; i < 8; ++i) {
+		EXPECT_NEAR(glm::length(frustum.corners[i] - expected.corners[i]), 0.0f, 1e-2f) << "corner " << i;
+	}
+
+	// the planes point inwards: the center is inside, a point behind the camera is not
+	const glm::vec3 inside = camera.getPosition() + camera.getLook() * 10.0f;
+	const glm::vec3 behind = camera.getPosition() - camera.getLook() * 10.0f;
+	bool behindIsOutside = false;
+
+	for (const auto& plane : frustum.planes) {
+		EXPECT_GT(glm::dot(plane.mNormal, inside) + plane.mSignedDistance, 0.0f);
+		behindIsOutside = behindIsOutside || glm::dot(plane.mNormal, behind) + plane.mSignedDistance < 0.0f;
+	}
+
+	EXPECT_TRUE(behindIsOutside);
+}
+
+TEST(MultiViewCollectorTest, SingleTraversalMatchesPerViewCulling)
+{
+	TestScene scene(3000);
+	auto cameraA = createCamera(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+	auto cameraB = createCamera(glm::vec3(50.0f, 20.0f, 0.0f), glm::vec3(0.0f));
+	const Sphere sphereA(glm::vec3(10.0f, 0.0f, 10.0f), 25.0f);
+	const Sphere sphereB(glm::vec3(-60.0f, 30.0f, 0.0f), 10.0f);
+
+	MultiViewCollector collector;
+	collector.addView(cameraA.getFrustumWorld());
+	collector.addView(cameraB.getFrustumWorld());
+	collector.addView(sphereA);
+	collector.addView(sphereB);
+
+	size_t traversals = 0;
+	collector.collect([&](RenderCommandQueue& queue) {
+		++traversals;
+		scene.traverse(queue);
+	});
+
+	EXPECT_EQ(traversals, 1);
+	ASSERT_EQ(collector.getViewCount(), 4);
+	ASSERT_EQ(collector.getCommands().size(), 3000);
+
+	// reference: one traversal per view, culled by the view's queue
+	std::vector<RenderCommandQueue> references(4);
+	references[0].useCameraCulling(&cameraA);
+	references[1].useCameraCulling(&cameraB);
+	references[2].useSphereCulling(sphereA.origin, sphereA.radius);
+	references[3].useSphereCulling(sphereB.origin, sphereB.radius);
+
+	for (size_t view = 0; view < references.size(); ++view) {
+		auto& reference = references[view];
+		scene.traverse(reference);
+		reference.cull();
+
+		const auto& expected = reference.getDeferrablePbrCommands();
+		EXPECT_GT(expected.size(), 0) << "view " << view;
+		EXPECT_EQ(collector.getVisibleCount(view), expected.size()) << "view " << view;
+
+		// the commands keep their order, so the visible commands of the view are the expected commands
+		const auto* visibility = collector.getVisibility(view);
+		size_t next = 0;
+		for (size_t i = 0; i < collector.getCommands().size(); ++i) {
+			if (!isVisible(visibility, i)) continue;
+			ASSERT_LT(next, expected.size());
+			EXPECT_EQ(collector.getCommands()[i].boundingBox, expected[next++].boundingBox);
+		}
+		EXPECT_EQ(next, expected.size());
+	}
+}
+
+TEST(MultiViewCollectorTest, FillQueuePushesVisibleCommands)
+{
+	TestScene scene(500);
+	const Sphere sphere(glm::vec3(0.0f), 40.0f);
+
+	MultiViewCollector collector;
+	const auto view = collector.addView(sphere);
+	collector.collect([&](RenderCommandQueue& queue) { scene.traverse(queue); });
+
+	RenderCommandQueue queue;
+	queue.useSphereCulling(sphere.origin, sphere.radius);
+	collector.fillQueue(view, queue);
+
+	EXPECT_GT(collector.getVisibleCount(view), 0);
+	EXPECT_LT(collector.getVisibleCount(view), 500);
+	EXPECT_EQ(queue.getDeferrablePbrCommands().size(), collector.getVisibleCount(view));
+	EXPECT_TRUE(queue.getCullCandidates().empty());
+}
+
+TEST(MultiViewCollectorTest, ClearRemovesViewsAndCommands)
+{
+	TestScene scene(100);
+
+	MultiViewCollector collector;
+	collector.addView(Sphere(glm::vec3(0.0f), 1000.0f));
+	collector.collect([&](RenderCommandQueue& queue) { scene.traverse(queue); });
+	EXPECT_EQ(collector.getVisibleCount(0), 100);
+
+	collector.clear();
+	EXPECT_EQ(collector.getViewCount(), 0);
+	EXPECT_TRUE(collector.getCommands().empty());
+}
@@ -0,0 +1,147 @@
+#include <nex/renderer/RenderCommandBuffer.hpp>
+#include <nex/renderer/RenderCommand.hpp>
+#include <nex/renderer/RenderContext.hpp>
+#include <nex/renderer/Drawer.hpp>
+#include <nex/renderer/TestBatches.hpp>
+#include <gtest/gtest.h>
+
+using namespace nex;
+using nex::test::TestBatches;
+
+namespace
+{
+	/**
+	 * Operations recorded per command of a shader without transform instance data (and a single mesh without index
+	 * buffer): update instance, update material, bind vertex array and draw array.
+	 */
+	constexpr size_t OPERATIONS_PER_COMMAND = 4;
+
+	/**
+	 * Custom render function, that appends the index stored in the command data to the order vector of the test.
+	 */
+	std::vector<size_t>* calledOrder = nullptr;
+
+	void recordCall(const RenderCommand& command,
+		Shader**,
+		const RenderContext&,
+		const ShaderOverride<Shader>&,
+		const RenderState*)
+	{
+		calledOrder->push_back(reinterpret_cast<size_t>(command.data));
+	}
+
+	std::vector<RenderCommand> createCallCommands(size_t count)
+	{
+		std::vector<RenderCommand> commands(count);
+		for (size_t i = 0; i < count; ++i) {
+			commands[i].renderFunc = recordCall;
+			commands[i].data = reinterpret_cast<void*>(i);
+		}
+		return commands;
+	}
+
+	std::vector<RenderCommand> createDrawCommands(const std::vector<MeshBatch*>& batches, size_t commandsPerBatch)
+	{
+		std::vector<RenderCommand> commands;
+		for (auto* batch : batches) {
+			for (size_t i = 0; i < commandsPerBatch; ++i) {
+				RenderCommand command;
+				command.batch = batch;
+				commands.emplace_back(command);
+			}
+		}
+		return commands;
+	}
+}
+
+TEST(RenderCommandBufferTest, RedundantShaderBindsAreNotRecorded)
+{
+	TestBatches batches;
+	const auto commands = createDrawCommands({ batches.create(0), batches.create(0), batches.create(1) }, 10);
+
+	RenderCommandBuffer buffer;
+	buffer.record(commands.data(), commands.data() + commands.size(), RenderContext(), ShaderOverride<Shader>(), nullptr);
+
+	// one bind per shader
+	EXPECT_EQ(buffer.getOperationCount(), 2 + commands.size() * OPERATIONS_PER_COMMAND);
+}
+
+TEST(RenderCommandBufferTest, EachSliceBindsItsShader)
+{
+	TestBatches batches;
+	const auto commands = createDrawCommands({ batches.create(0) }, 10);
+	const auto* middle = commands.data() + commands.size() / 2;
+
+	RenderCommandBuffer first;
+	RenderCommandBuffer second;
+	first.record(commands.data(), middle, RenderContext(), ShaderOverride<Shader>(), nullptr);
+	second.record(middle, commands.data() + commands.size(), RenderContext(), ShaderOverride<Shader>(), nullptr);
+
+	// the bound shader is unknown at the start of a slice; replay skips the second bind
+	EXPECT_EQ(first.getOperationCount(), 1 + commands.size() / 2 * OPERATIONS_PER_COMMAND);
+	EXPECT_EQ(second.getOperationCount(), first.getOperationCount());
+}
+
+TEST(RenderCommandBufferTest, ClearRemovesOperations)
+{
+	TestBatches batches;
+	const auto commands = createDrawCommands({ batches.create(0) }, 10);
+
+	RenderCommandBuffer buffer;
+	buffer.record(commands.data(), commands.data() + commands.size(), RenderContext(), ShaderOverride<Shader>(), nullptr);
+	const auto size = buffer.getSize();
+	EXPECT_FALSE(buffer.empty());
+
+	buffer.clear();
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_EQ(buffer.getSize(), 0);
+
+	// clearing forgets the recorded shader, so it is bound again
+	buffer.record(commands.data(), commands.data() + commands.size(), RenderContext(), ShaderOverride<Shader>(), nullptr);
+	EXPECT_EQ(buffer.getSize(), size);
+}
+
+TEST(RenderCommandBufferTest, ReplayedSlicesKeepCommandOrder)
+{
+	constexpr size_t count = 1000;
+	constexpr size_t sliceCount = 7;
+	const auto commands = createCallCommands(count);
+
+	// record the slices in reverse order, as worker threads might do
+	std::vector<RenderCommandBuffer> buffers(sliceCount + 1);
+	const size_t sliceSize = (count + sliceCount - 1) / sliceCount;
+	for (size_t slice = sliceCount; slice-- > 0;) {
+		const auto* begin = commands.data() + std::min(slice * sliceSize, count);
+		const auto* end = commands.data() + std::min((slice + 1) * sliceSize, count);
+		buffers[slice].record(begin, end, RenderContext(), ShaderOverride<Shader>(), nullptr);
+	}
+
+	std::vector<size_t> order;
+	calledOrder = &order;
+	RenderCommandBuffer::replay(buffers, RenderContext(), ShaderOverride<Shader>(), nullptr);
+	calledOrder = nullptr;
+
+	ASSERT_EQ(order.size(), count);
+	for (size_t i = 0; i < count; ++i) EXPECT_EQ(order[i], i);
+}
+
+TEST(RenderCommandBufferTest, RecordParallelEqualsSerialRecording)
+{
+	constexpr size_t count = 20 * RenderCommandBuffer::MIN_SLICE_SIZE;
+	const auto commands = createCallCommands(count);
+
+	std::vector<RenderCommandBuffer> buffers;
+	RenderCommandBuffer::recordParallel(buffers, commands, RenderContext(), ShaderOverride<Shader>(), nullptr);
+
+	size_t operationCount = 0;
+	for (const auto& buffer : buffers) operationCount += buffer.getOperationCount();
+	EXPECT_EQ(operationCount, count);
+
+	std::vector<size_t> order;
+	calledOrder = &order;
+	RenderCommandBuffer::replay(buffers, RenderContext(), ShaderOverride<Shader>(), nullptr);
+	calledOrder = nullptr;
+
+	ASSERT_EQ(order.size(), count);
+	for (size_t i = 0; i < count; ++i) EXPECT_EQ(order[i], i);
+}
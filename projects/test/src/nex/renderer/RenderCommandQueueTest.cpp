@@ -0,0 +1,303 @@
+#include <nex/renderer/RenderCommandQueue.hpp>
+#include <nex/anim/BonePalette.hpp>
+#include <nex/renderer/TestBatches.hpp>
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <deque>
+
+using namespace nex;
+using nex::test::TestBatches;
+
+namespace
+{
+	/**
+	 * Render commands referencing transformations and bounding boxes owned by the scene.
+	 */
+	class TestCommands
+	{
+	public:
+
+		RenderCommand create(const MeshBatch* batch, const glm::vec3& position)
+		{
+			mTrafos.emplace_back(glm::translate(glm::mat4(1.0f), position));
+			mPrevTrafos.emplace_back(glm::translate(glm::mat4(1.0f), position - glm::vec3(1.0f)));
+			mBoxes.emplace_back(position - glm::vec3(0.5f), position + glm::vec3(0.5f));
+
+			RenderCommand command;
+			command.batch = batch;
+			command.worldTrafo = &mTrafos.back();
+			command.prevWorldTrafo = &mPrevTrafos.back();
+			command.boundingBox = &mBoxes.back();
+			return command;
+		}
+
+	private:
+		std::deque<glm::mat4> mTrafos;
+		std::deque<glm::mat4> mPrevTrafos;
+		std::deque<AABB> mBoxes;
+	};
+
+	RenderCommandQueue createQueue(bool instancing)
+	{
+		RenderCommandQueue queue;
+		queue.useSphereCulling(glm::vec3(0.0f), 1000.0f);
+		queue.useInstancing(instancing);
+		return queue;
+	}
+
+	const RenderCommand* findCommand(const RenderCommandQueue::Buffer& buffer, const MeshBatch* batch)
+	{
+		for (const auto& command : buffer) {
+			if (command.batch == batch) return &command;
+		}
+		return nullptr;
+	}
+}
+
+TEST(RenderCommandQueueTest, InstancingIsDisabledByDefault)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* batch = batches.create(0);
+
+	RenderCommandQueue queue;
+	queue.useSphereCulling(glm::vec3(0.0f), 1000.0f);
+	for (int i = 0; i < 4; ++i) queue.push(commands.create(batch, glm::vec3(i)));
+	queue.sort();
+
+	EXPECT_EQ(queue.getDeferrablePbrCommands().size(), 4);
+}
+
+TEST(RenderCommandQueueTest, InstancingMergesCommandsOfSameBatch)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* a = batches.create(0);
+	auto* b = batches.create(0);
+	auto* c = batches.create(1);
+
+	auto queue = createQueue(true);
+	for (int i = 0; i < 10; ++i) queue.push(commands.create(a, glm::vec3(i, 0, 0)));
+	for (int i = 0; i < 5; ++i) queue.push(commands.create(b, glm::vec3(0, i, 0)));
+	queue.push(commands.create(c, glm::vec3(0, 0, 5)));
+	queue.sort();
+
+	for (const auto* buffer : { &queue.getDeferrablePbrCommands(), &queue.getShadowCommands() }) {
+		ASSERT_EQ(buffer->size(), 3);
+
+		const auto* instancedA = findCommand(*buffer, a);
+		ASSERT_NE(instancedA, nullptr);
+		ASSERT_EQ(instancedA->instanceCount, 10);
+
+		// the instances keep the push order
+		for (int i = 0; i < 10; ++i) {
+			EXPECT_EQ(instancedA->instanceWorldTrafos[i][3], glm::vec4(i, 0, 0, 1));
+			EXPECT_EQ(instancedA->instancePrevWorldTrafos[i][3], glm::vec4(i - 1, -1, -1, 1));
+		}
+
+		// the bounding box covers all instances
+		EXPECT_EQ(instancedA->boundingBox->min, glm::vec3(-0.5f));
+		EXPECT_EQ(instancedA->boundingBox->max, glm::vec3(9.5f, 0.5f, 0.5f));
+
+		EXPECT_EQ(findCommand(*buffer, b)->instanceCount, 5);
+
+		// a single command isn't instanced
+		EXPECT_EQ(findCommand(*buffer, c)->instanceCount, 0);
+	}
+}
+
+TEST(RenderCommandQueueTest, InstancingKeepsMaterialIDsApart)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* batch = batches.create(0);
+
+	auto queue = createQueue(true);
+	for (int i = 0; i < 6; ++i) {
+		auto command = commands.create(batch, glm::vec3(i));
+		command.perObjectMaterialID = i % 2;
+		queue.push(command);
+	}
+	queue.sort();
+
+	const auto& buffer = queue.getDeferrablePbrCommands();
+	ASSERT_EQ(buffer.size(), 2);
+	EXPECT_EQ(buffer[0].instanceCount, 3);
+	EXPECT_EQ(buffer[1].instanceCount, 3);
+	EXPECT_NE(buffer[0].perObjectMaterialID, buffer[1].perObjectMaterialID);
+}
+
+TEST(RenderCommandQueueTest, CommandsWithCustomDataAreNotInstanced)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* batch = batches.create(0);
+	int data = 0;
+	const std::vector<glm::mat4> bones(4);
+
+	auto queue = createQueue(true);
+	for (int i = 0; i < 3; ++i) {
+		auto command = commands.create(batch, glm::vec3(i));
+		command.data = &data;
+		queue.push(command);
+	}
+	for (int i = 0; i < 3; ++i) {
+		auto command = commands.create(batch, glm::vec3(i));
+		command.isBoneAnimated = true;
+		command.bones = &bones;
+		queue.push(command);
+	}
+	queue.sort();
+
+	const auto& buffer = queue.getDeferrablePbrCommands();
+	ASSERT_EQ(buffer.size(), 6);
+	for (const auto& command : buffer) EXPECT_EQ(command.instanceCount, 0);
+}
+
+TEST(RenderCommandQueueTest, OnlyVisibleCommandsAddTheirPoseToTheBonePalette)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* batch = batches.create(0);
+	const std::vector<glm::mat4> visibleBones(4, glm::mat4(1.0f));
+	const std::vector<glm::mat4> culledBones(4, glm::mat4(2.0f));
+
+	StreamingBuffer streamingBuffer(1024 * sizeof(glm::mat4));
+	BonePalette palette(64);
+	palette.begin(streamingBuffer);
+
+	auto queue = createQueue(true);
+	queue.useBonePalette(&palette);
+
+	// e.g. two batches of one vob sharing the pose
+	for (int i = 0; i < 2; ++i) {
+		auto command = commands.create(batch, glm::vec3(i));
+		command.isBoneAnimated = true;
+		command.bones = &visibleBones;
+		queue.push(command, true);
+	}
+
+	auto culled = commands.create(batch, glm::vec3(5000.0f));
+	culled.isBoneAnimated = true;
+	culled.bones = &culledBones;
+	queue.push(culled, true);
+	queue.sort();
+
+	EXPECT_EQ(palette.getPoseCount(), 1);
+	ASSERT_EQ(palette.getTrafoCount(), 4);
+	EXPECT_EQ(palette.getTrafos()[0], glm::mat4(1.0f));
+
+	// the commands reference the pose in the palette, so they can be instanced
+	const auto& buffer = queue.getDeferrablePbrCommands();
+	ASSERT_EQ(buffer.size(), 1);
+	ASSERT_EQ(buffer[0].instanceCount, 2);
+	EXPECT_EQ(buffer[0].bones, nullptr);
+	EXPECT_EQ(buffer[0].instanceBoneOffsets[0], 0);
+	EXPECT_EQ(buffer[0].instanceBoneOffsets[1], 0);
+}
+
+TEST(RenderCommandQueueTest, CommandsKeepTheirBonesIfThePaletteIsFull)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* batch = batches.create(0);
+	const std::vector<glm::mat4> bones(8);
+
+	StreamingBuffer streamingBuffer(1024 * sizeof(glm::mat4));
+	BonePalette palette(4);
+	palette.begin(streamingBuffer);
+
+	auto queue = createQueue(true);
+	queue.useBonePalette(&palette);
+
+	auto command = commands.create(batch, glm::vec3(0.0f));
+	command.isBoneAnimated = true;
+	command.bones = &bones;
+	queue.push(command);
+	queue.sort();
+
+	const auto& buffer = queue.getDeferrablePbrCommands();
+	ASSERT_EQ(buffer.size(), 1);
+	EXPECT_EQ(buffer[0].bones, &bones);
+	EXPECT_EQ(palette.getRejectedPoseCount(), 1);
+}
+
+TEST(RenderCommandQueueTest, InstancingIsRepeatableOverFrames)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* batch = batches.create(0);
+
+	std::vector<RenderCommand> frameCommands;
+	for (int i = 0; i < 8; ++i) frameCommands.push_back(commands.create(batch, glm::vec3(i)));
+
+	auto queue = createQueue(true);
+
+	for (int frame = 0; frame < 3; ++frame) {
+		queue.clear();
+		for (const auto& command : frameCommands) queue.push(command);
+		queue.sort();
+
+		const auto& buffer = queue.getDeferrablePbrCommands();
+		ASSERT_EQ(buffer.size(), 1);
+		ASSERT_EQ(buffer[0].instanceCount, 8);
+		EXPECT_EQ(buffer[0].instanceWorldTrafos[7][3], glm::vec4(7, 7, 7, 1));
+	}
+}
+
+TEST(RenderCommandQueueTest, OpaqueCommandsAreGroupedByShader)
+{
+	TestBatches batches;
+	TestCommands commands;
+	std::vector<MeshBatch*> batchList;
+	for (size_t i = 0; i < 12; ++i) batchList.push_back(batches.create(i % 3));
+
+	auto queue = createQueue(false);
+	for (int i = 0; i < 300; ++i) {
+		auto command = commands.create(batchList[(i * 7) % batchList.size()], glm::vec3(i % 17, i % 5, i % 11));
+		// bone animated commands use another shader only in the shadow pass (shader overrides)
+		command.isBoneAnimated = i % 10 == 0;
+		command.boneOffset = i;
+		queue.push(command);
+	}
+	queue.sort();
+
+	auto countShaderChanges = [](const RenderCommandQueue::Buffer& buffer) {
+		size_t changes = 0;
+		for (size_t i = 1; i < buffer.size(); ++i) {
+			if (buffer[i].batch->getShader() != buffer[i - 1].batch->getShader()) ++changes;
+		}
+		return changes;
+	};
+
+	auto countLayerChanges = [](const RenderCommandQueue::Buffer& buffer) {
+		size_t changes = 0;
+		for (size_t i = 1; i < buffer.size(); ++i) {
+			if (buffer[i].isBoneAnimated != buffer[i - 1].isBoneAnimated) ++changes;
+		}
+		return changes;
+	};
+
+	EXPECT_EQ(countShaderChanges(queue.getDeferrablePbrCommands()), 2);
+	EXPECT_EQ(countLayerChanges(queue.getShadowCommands()), 1);
+}
+
+TEST(RenderCommandQueueTest, TransparentCommandsAreSortedBackToFront)
+{
+	TestBatches batches;
+	TestCommands commands;
+	auto* batch = batches.create(0, true);
+
+	auto queue = createQueue(false);
+	for (int i = 0; i < 50; ++i) {
+		queue.push(commands.create(batch, -glm::vec3(static_cast<float>((i * 37) % 50))));
+	}
+	queue.sort();
+
+	// the cull position is the origin, so the farthest command has the smallest coordinates
+	const auto& buffer = queue.getTransparentCommands();
+	ASSERT_EQ(buffer.size(), 50);
+	for (size_t i = 1; i < buffer.size(); ++i) {
+		EXPECT_LT(buffer[i - 1].boundingBox->min.x, buffer[i].boundingBox->min.x);
+	}
+}
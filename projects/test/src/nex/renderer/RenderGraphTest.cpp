@@ -0,0 +1,253 @@
+#include <nex/renderer/RenderGraph.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace nex;
+
+namespace
+{
+	using ID = RenderGraph::ResourceID;
+	using Barrier = RenderGraph::Barrier;
+
+	RenderGraph::TargetDesc createDesc(InternalFormat format = InternalFormat::RGBA8, unsigned width = 64)
+	{
+		RenderGraph::TargetDesc desc;
+		desc.width = width;
+		desc.height = width;
+		desc.format = format;
+		return desc;
+	}
+
+	/**
+	 * Imported targets are only referenced by address, so a dummy address is sufficient.
+	 */
+	RenderTarget* getScreen()
+	{
+		static char screen;
+		return reinterpret_cast<RenderTarget*>(&screen);
+	}
+
+	bool hasBarrier(const RenderGraph& graph, RenderGraph::PassID pass, Barrier::Type type, ID resource,
+		RenderGraph::PassID after)
+	{
+		for (const auto& barrier : graph.getBarriers(pass)) {
+			if (barrier.type == type && barrier.resource == resource && barrier.after == after) return true;
+		}
+		return false;
+	}
+}
+
+TEST(RenderGraphTest, UnusedPassesAreCulled)
+{
+	RenderGraph graph;
+	const auto depth = graph.createTarget("depth", createDesc(InternalFormat::DEPTH24));
+	const auto color = graph.createTarget("color", createDesc());
+	const auto debug = graph.createTarget("debug", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	const auto prepass = graph.addPass("prepass").write(depth).getID();
+	const auto lighting = graph.addPass("lighting").read(depth).write(color).getID();
+	const auto debugView = graph.addPass("debug").read(depth).write(debug).getID();
+	const auto present = graph.addPass("present").read(color).write(screen).getID();
+	const auto timer = graph.addPass("timer").sideEffect().getID();
+
+	graph.compile();
+
+	EXPECT_FALSE(graph.isCulled(prepass));
+	EXPECT_FALSE(graph.isCulled(lighting));
+	EXPECT_TRUE(graph.isCulled(debugView));
+	EXPECT_FALSE(graph.isCulled(present));
+	EXPECT_FALSE(graph.isCulled(timer));
+
+	// the target of a culled pass isn't allocated
+	EXPECT_EQ(graph.getPhysicalIndex(debug), RenderGraph::INVALID_ID);
+	EXPECT_EQ(graph.getStats().culledPasses, 1);
+	EXPECT_EQ(graph.getStats().declaredTargets, 3);
+	EXPECT_EQ(graph.getStats().transientTargets, 2);
+}
+
+TEST(RenderGraphTest, OutputsKeepTheirPasses)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc());
+	const auto b = graph.createTarget("b", createDesc());
+
+	const auto first = graph.addPass("first").write(a).getID();
+	const auto second = graph.addPass("second").read(a).write(b).getID();
+	graph.markOutput(b);
+
+	graph.compile();
+	EXPECT_FALSE(graph.isCulled(first));
+	EXPECT_FALSE(graph.isCulled(second));
+}
+
+TEST(RenderGraphTest, LifetimesIgnoreCulledPasses)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc());
+	const auto b = graph.createTarget("b", createDesc());
+	const auto unused = graph.createTarget("unused", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	graph.addPass("0").write(a);
+	graph.addPass("1").read(a).write(b);
+	graph.addPass("2 (culled)").read(a).write(unused);
+	graph.addPass("3").read(b).write(screen);
+
+	graph.compile();
+
+	EXPECT_EQ(graph.getFirstUse(a), 0);
+	EXPECT_EQ(graph.getLastUse(a), 1);
+	EXPECT_EQ(graph.getFirstUse(b), 1);
+	EXPECT_EQ(graph.getLastUse(b), 3);
+	EXPECT_EQ(graph.getFirstUse(unused), RenderGraph::INVALID_ID);
+	EXPECT_EQ(graph.getLastUse(unused), RenderGraph::INVALID_ID);
+}
+
+TEST(RenderGraphTest, DisjointLifetimesAreAliased)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc());
+	const auto b = graph.createTarget("b", createDesc());
+	const auto c = graph.createTarget("c", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	// a: 0-1, b: 1-2, c: 2-3; a and c don't overlap
+	graph.addPass("0").write(a);
+	graph.addPass("1").read(a).write(b);
+	graph.addPass("2").read(b).write(c);
+	graph.addPass("3").read(c).write(screen);
+
+	graph.compile();
+
+	EXPECT_EQ(graph.getPhysicalIndex(a), graph.getPhysicalIndex(c));
+	EXPECT_NE(graph.getPhysicalIndex(a), graph.getPhysicalIndex(b));
+	EXPECT_EQ(graph.getPhysicalIndex(screen), RenderGraph::INVALID_ID);
+
+	const auto& stats = graph.getStats();
+	const auto targetSize = createDesc().getByteSize();
+	EXPECT_EQ(stats.physicalTargets, 2);
+	EXPECT_EQ(stats.unaliasedBytes, 3 * targetSize);
+	EXPECT_EQ(stats.aliasedBytes, 2 * targetSize);
+}
+
+TEST(RenderGraphTest, OverlappingLifetimesAreNotAliased)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc());
+	const auto b = graph.createTarget("b", createDesc());
+	const auto c = graph.createTarget("c", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	// b is written by the pass reading a last time, so they overlap in pass 1
+	graph.addPass("0").write(a);
+	graph.addPass("1").read(a).write(b);
+	// c is written while b is still needed
+	graph.addPass("2").write(c);
+	graph.addPass("3").read(b).read(c).write(screen);
+
+	graph.compile();
+
+	EXPECT_NE(graph.getPhysicalIndex(a), graph.getPhysicalIndex(b));
+	EXPECT_NE(graph.getPhysicalIndex(b), graph.getPhysicalIndex(c));
+	// a is dead after pass 1
+	EXPECT_EQ(graph.getPhysicalIndex(a), graph.getPhysicalIndex(c));
+	EXPECT_EQ(graph.getStats().physicalTargets, 2);
+}
+
+TEST(RenderGraphTest, DifferentDescriptionsAreNotAliased)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc(InternalFormat::RGBA8));
+	const auto b = graph.createTarget("b", createDesc(InternalFormat::RGBA16F));
+	const auto c = graph.createTarget("c", createDesc(InternalFormat::RGBA8, 32));
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	graph.addPass("0").write(a);
+	graph.addPass("1").read(a).write(screen);
+	graph.addPass("2").write(b);
+	graph.addPass("3").read(b).write(screen);
+	graph.addPass("4").write(c);
+	graph.addPass("5").read(c).write(screen);
+
+	graph.compile();
+
+	EXPECT_EQ(graph.getStats().physicalTargets, 3);
+	EXPECT_EQ(graph.getStats().aliasedBytes, graph.getStats().unaliasedBytes);
+}
+
+TEST(RenderGraphTest, BarriersFollowPassOrder)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc());
+	const auto b = graph.createTarget("b", createDesc());
+	const auto c = graph.createTarget("c", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	graph.addPass("0").write(a);
+	graph.addPass("1").read(a).write(a); // in place update
+	graph.addPass("2").read(a).write(b);
+	graph.addPass("3").read(b).write(c); // c reuses the memory of a
+	graph.addPass("4").read(c).read(b).write(screen);
+
+	graph.compile();
+
+	// reads wait for the last writer, not the first one
+	EXPECT_TRUE(hasBarrier(graph, 1, Barrier::Type::READ_AFTER_WRITE, a, 0));
+	EXPECT_TRUE(hasBarrier(graph, 2, Barrier::Type::READ_AFTER_WRITE, a, 1));
+	EXPECT_FALSE(hasBarrier(graph, 2, Barrier::Type::READ_AFTER_WRITE, a, 0));
+
+	// the first writer of an aliased target waits for the last pass using the previous target
+	ASSERT_EQ(graph.getPhysicalIndex(a), graph.getPhysicalIndex(c));
+	EXPECT_TRUE(hasBarrier(graph, 3, Barrier::Type::ALIASING, a, 2));
+
+	EXPECT_TRUE(hasBarrier(graph, 4, Barrier::Type::READ_AFTER_WRITE, c, 3));
+	EXPECT_TRUE(hasBarrier(graph, 4, Barrier::Type::READ_AFTER_WRITE, b, 2));
+
+	// passes only wait for earlier passes, so the declaration order is a valid execution order
+	for (RenderGraph::PassID pass = 0; pass < 5; ++pass) {
+		for (const auto& barrier : graph.getBarriers(pass)) {
+			EXPECT_LT(barrier.after, pass);
+		}
+	}
+}
+
+TEST(RenderGraphTest, ReadBeforeWriteThrows)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	// a dependency on a later pass would be a cycle, as passes execute in declaration order
+	graph.addPass("0").read(a).write(screen);
+	graph.addPass("1").write(a);
+
+	EXPECT_THROW(graph.compile(), std::runtime_error);
+}
+
+TEST(RenderGraphTest, FirstWriteCannotReadItself)
+{
+	RenderGraph graph;
+	const auto a = graph.createTarget("a", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	graph.addPass("0").read(a).write(a);
+	graph.addPass("1").read(a).write(screen);
+
+	EXPECT_THROW(graph.compile(), std::runtime_error);
+}
+
+TEST(RenderGraphTest, ImportedTargetsCanBeReadFirst)
+{
+	RenderGraph graph;
+	const auto history = graph.importTarget("history", getScreen());
+	const auto a = graph.createTarget("a", createDesc());
+	const auto screen = graph.importTarget("screen", getScreen());
+
+	graph.addPass("0").read(history).write(a);
+	graph.addPass("1").read(a).write(history).write(screen);
+
+	EXPECT_NO_THROW(graph.compile());
+	EXPECT_TRUE(graph.getBarriers(0).empty());
+	EXPECT_EQ(graph.getTarget(history), getScreen());
+}
@@ -0,0 +1,116 @@
+#include <nex/renderer/StateShadow.hpp>
+#include <nex/renderer/StateChangeStatistics.hpp>
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+
+using namespace nex;
+
+namespace
+{
+	using Category = StateChangeStatistics::Category;
+
+	/**
+	 * Mimics a backend cache: issues a bind only if the shadowed value changes and counts it.
+	 */
+	struct TestCache
+	{
+		ShadowArray<unsigned> textureUnits;
+		std::vector<std::pair<size_t, unsigned>> issued;
+
+		void bindTexture(size_t unit, unsigned texture)
+		{
+			const bool issue = textureUnits.update(unit, texture);
+			StateChangeStatistics::add(Category::TEXTURE, issue);
+			if (issue) issued.emplace_back(unit, texture);
+		}
+	};
+}
+
+TEST(StateShadowTest, UnknownValueIsIssued)
+{
+	ShadowValue<int> value;
+	EXPECT_TRUE(value.update(0));
+	EXPECT_FALSE(value.update(0));
+	EXPECT_TRUE(value.update(1));
+	EXPECT_EQ(value.get(), 1);
+}
+
+TEST(StateShadowTest, KnownInitialValueIsFiltered)
+{
+	// e.g. a state queried from the driver at startup
+	ShadowValue<bool> value(true, true);
+	EXPECT_FALSE(value.update(true));
+	EXPECT_TRUE(value.update(false));
+}
+
+TEST(StateShadowTest, InvalidatedValueIsIssued)
+{
+	ShadowValue<glm::mat4> value;
+	EXPECT_TRUE(value.update(glm::mat4(1.0f)));
+	EXPECT_FALSE(value.update(glm::mat4(1.0f)));
+
+	value.invalidate();
+	EXPECT_TRUE(value.update(glm::mat4(1.0f)));
+}
+
+TEST(StateShadowTest, ArrayShadowsEachLocation)
+{
+	ShadowArray<glm::vec3> uniforms;
+
+	// locations are sparse; the array grows on demand
+	EXPECT_TRUE(uniforms.update(7, glm::vec3(1.0f)));
+	EXPECT_TRUE(uniforms.update(2, glm::vec3(1.0f)));
+	EXPECT_FALSE(uniforms.update(7, glm::vec3(1.0f)));
+	EXPECT_TRUE(uniforms.update(7, glm::vec3(2.0f)));
+
+	// locations below the highest updated one are unknown, even though the array has grown past them
+	EXPECT_TRUE(uniforms.update(0, glm::vec3(0.0f)));
+
+	uniforms.invalidate();
+	EXPECT_TRUE(uniforms.update(2, glm::vec3(1.0f)));
+	EXPECT_TRUE(uniforms.update(7, glm::vec3(2.0f)));
+}
+
+TEST(StateShadowTest, DeletedObjectIsRebound)
+{
+	TestCache cache;
+	cache.bindTexture(0, 5);
+	cache.bindTexture(1, 5);
+	cache.bindTexture(2, 6);
+
+	// a deleted texture name can be reused by a new texture, so the units using it must be bound again
+	cache.textureUnits.invalidateValue(5);
+	cache.bindTexture(0, 5);
+	cache.bindTexture(1, 5);
+	cache.bindTexture(2, 6);
+
+	const std::vector<std::pair<size_t, unsigned>> expected = { {0, 5}, {1, 5}, {2, 6}, {0, 5}, {1, 5} };
+	EXPECT_EQ(cache.issued, expected);
+}
+
+TEST(StateShadowTest, StatisticsAreCountedPerFrame)
+{
+	// start with a fresh frame; other tests might have counted state changes, too
+	StateChangeStatistics::markFrame();
+	StateChangeStatistics::markFrame();
+
+	TestCache cache;
+	for (unsigned i = 0; i < 10; ++i) cache.bindTexture(0, i % 2 == 0 ? 1 : 2);
+	for (unsigned i = 0; i < 10; ++i) cache.bindTexture(1, 3);
+	StateChangeStatistics::add(Category::UNIFORM, false);
+
+	// counts are only visible after the frame has finished
+	EXPECT_EQ(StateChangeStatistics::getLastFrameTotal().issued, 0);
+
+	StateChangeStatistics::markFrame();
+	const auto& textures = StateChangeStatistics::getLastFrameCounts(Category::TEXTURE);
+	EXPECT_EQ(textures.issued, 11);
+	EXPECT_EQ(textures.filtered, 9);
+
+	const auto total = StateChangeStatistics::getLastFrameTotal();
+	EXPECT_EQ(total.issued, 11);
+	EXPECT_EQ(total.filtered, 10);
+
+	StateChangeStatistics::markFrame();
+	EXPECT_EQ(StateChangeStatistics::getLastFrameTotal().issued, 0);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <nex/material/Material.hpp>
+#include <nex/mesh/Mesh.hpp>
+#include <nex/mesh/MeshGroup.hpp>
+#include <nex/shader/Shader.hpp>
+#include <nex/shader/ShaderProvider.hpp>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace nex::test
+{
+	/**
+	 * Mesh batches for render command tests. Each batch has its own material; batches created with the same shader index
+	 * share the shader. The shaders have no shader program, so commands can be sorted and recorded, but not rendered.
+	 */
+	class TestBatches
+	{
+	public:
+
+		MeshBatch* create(size_t shaderIndex, bool transparent = false)
+		{
+			// Note: a deque keeps the shaders, materials and batches at their memory location
+			while (mShaders.size() <= shaderIndex) mShaders.emplace_back();
+
+			mMaterials.emplace_back(std::make_unique<PbrMaterial>(std::make_shared<ShaderProvider>(&mShaders[shaderIndex])));
+			auto* material = mMaterials.back().get();
+			material->getRenderState().doBlend = transparent;
+
+			mBatches.emplace_back(material);
+			mBatches.back().add(&mMesh, material);
+			return &mBatches.back();
+		}
+
+	private:
+		std::deque<Shader> mShaders;
+		Mesh mMesh;
+		std::vector<std::unique_ptr<PbrMaterial>> mMaterials;
+		std::deque<MeshBatch> mBatches;
+	};
+}
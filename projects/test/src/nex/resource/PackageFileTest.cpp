@@ -0,0 +1,138 @@
+#include <nex/resource/PackageFile.hpp>
+#include <nex/common/Compression.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * A file in the temp directory, that is removed when the test ends.
+	 */
+	class TempFile
+	{
+	public:
+		explicit TempFile(const std::string& name) :
+			mPath(std::filesystem::temp_directory_path() / "EngineTest" / name)
+		{
+			std::filesystem::create_directories(mPath.parent_path());
+		}
+
+		~TempFile()
+		{
+			std::error_code error;
+			std::filesystem::remove(mPath, error);
+		}
+
+		const std::filesystem::path& getPath() const
+		{
+			return mPath;
+		}
+
+	private:
+		std::filesystem::path mPath;
+	};
+
+	std::vector<char> createData(size_t size)
+	{
+		std::vector<char> data(size);
+		for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>(i % 13);
+		return data;
+	}
+
+	void writeBytes(const std::filesystem::path& path, const std::vector<char>& data)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(data.data(), data.size());
+	}
+
+	std::vector<char> decompress(const PackageFile& package, const PackageFile::Entry& entry)
+	{
+		std::vector<char> result;
+		Compression::decompress(package.getData(entry), entry.size, result);
+		return result;
+	}
+}
+
+TEST(PackageFileTest, EntriesAreFoundByName)
+{
+	TempFile source("package_source.bin");
+	TempFile packageFile("entries.pak");
+	const auto data = createData(1000);
+	writeBytes(source.getPath(), data);
+
+	PackageFile::write(packageFile.getPath(), {
+		{ "textures/a.CTEX", source.getPath(), false },
+		{ "meshes/b.CVOB", source.getPath(), false },
+	});
+
+	PackageFile package(packageFile.getPath());
+	EXPECT_EQ(package.getEntryCount(), 2);
+	EXPECT_EQ(package.find("textures/c.CTEX"), nullptr);
+
+	const auto* entry = package.find("meshes/./b.CVOB");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_EQ(package.getName(*entry), "meshes/b.CVOB");
+	EXPECT_EQ(entry->flags & PackageFile::FLAG_COMPRESSED, 0);
+	EXPECT_EQ(entry->size, data.size());
+	EXPECT_EQ(entry->uncompressedSize, data.size());
+	EXPECT_EQ(entry->offset % PackageFile::ALIGNMENT, 0);
+	EXPECT_EQ(std::vector<char>(package.getData(*entry), package.getData(*entry) + entry->size), data);
+}
+
+TEST(PackageFileTest, CompressedEntriesRecordUncompressedSize)
+{
+	TempFile source("package_source.bin");
+	TempFile packageFile("compressed.pak");
+	const auto data = createData(100000);
+	writeBytes(source.getPath(), data);
+
+	const auto stats = PackageFile::write(packageFile.getPath(), { { "a.CTEX", source.getPath(), true } });
+	EXPECT_EQ(stats.compressedEntries, 1);
+
+	PackageFile package(packageFile.getPath());
+	const auto* entry = package.find("a.CTEX");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_NE(entry->flags & PackageFile::FLAG_COMPRESSED, 0);
+	EXPECT_LT(entry->size, data.size());
+	EXPECT_EQ(entry->uncompressedSize, data.size());
+	EXPECT_EQ(decompress(package, *entry), data);
+}
+
+TEST(PackageFileTest, CompressedSourcesAreStoredAsIs)
+{
+	TempFile source("package_source.NEXZ");
+	TempFile packageFile("precompressed.pak");
+	const auto data = createData(100000);
+	const auto compressed = Compression::compress(data.data(), data.size());
+	writeBytes(source.getPath(), compressed);
+
+	// compression is requested for one entry only; neither is compressed again
+	PackageFile::write(packageFile.getPath(), {
+		{ "a.CTEX", source.getPath(), false },
+		{ "b.CTEX", source.getPath(), true },
+	});
+
+	PackageFile package(packageFile.getPath());
+	for (const auto* name : { "a.CTEX", "b.CTEX" }) {
+		const auto* entry = package.find(name);
+		ASSERT_NE(entry, nullptr);
+		EXPECT_NE(entry->flags & PackageFile::FLAG_COMPRESSED, 0);
+		EXPECT_EQ(entry->size, compressed.size());
+		EXPECT_EQ(entry->uncompressedSize, data.size());
+		EXPECT_EQ(decompress(package, *entry), data);
+	}
+}
+
+TEST(PackageFileTest, DuplicateNamesThrow)
+{
+	TempFile source("package_source.bin");
+	TempFile packageFile("duplicates.pak");
+	writeBytes(source.getPath(), createData(10));
+
+	EXPECT_THROW(PackageFile::write(packageFile.getPath(), {
+		{ "a/b.CTEX", source.getPath(), false },
+		{ "a/../a/b.CTEX", source.getPath(), false },
+	}), std::runtime_error);
+}
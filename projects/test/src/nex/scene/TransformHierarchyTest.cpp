@@ -0,0 +1,361 @@
+#include <nex/scene/TransformHierarchy.hpp>
+#include <nex/scene/Vob.hpp>
+#include <gtest/gtest.h>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <functional>
+#include <random>
+
+using namespace nex;
+
+/**
+ * The transform hierarchy has to produce the same results as the recursive Vob::updateTrafo.
+ * Each test builds two identical vob forests: One is managed by a transform hierarchy, the other one is the reference
+ * that is updated recursively. All modifications are applied to both forests.
+ */
+
+namespace
+{
+	constexpr int TREE_COUNT = 3;
+	constexpr int TREE_DEPTH = 2; // 1 + 3 + 9 = 13 nodes per tree
+	constexpr int CHILD_COUNT = 3;
+	constexpr float EPSILON = 1e-3f;
+
+	/**
+	 * A vob with a fixed local bounding box (regular vobs get their bounding box from their meshes).
+	 */
+	class BoxVob : public Vob
+	{
+	public:
+		explicit BoxVob(const AABB& box) : mBox(box)
+		{
+		}
+
+		void recalculateLocalBoundingBox() override
+		{
+			mBoundingBoxLocal = mBox;
+		}
+
+	private:
+		AABB mBox;
+	};
+
+	struct Forest
+	{
+		std::vector<std::unique_ptr<Vob>> roots;
+		std::vector<Vob*> rootPtrs;
+
+		// all vobs in creation order; the same index refers to the same vob in both forests
+		std::vector<Vob*> vobs;
+
+		Forest()
+		{
+			std::mt19937 random(42);
+
+			for (int i = 0; i < TREE_COUNT; ++i) {
+				roots.emplace_back(createTree(TREE_DEPTH, random));
+				rootPtrs.push_back(roots.back().get());
+			}
+		}
+
+		std::unique_ptr<Vob> createTree(int depth, std::mt19937& random)
+		{
+			auto next = [&random]() {
+				return std::uniform_real_distribution<float>(-5.0f, 5.0f)(random);
+			};
+
+			const glm::vec3 halfExtent(std::abs(next()) + 0.5f);
+			auto vob = std::make_unique<BoxVob>(AABB(-halfExtent, halfExtent));
+			vobs.push_back(vob.get());
+
+			vob->setPositionLocalToParent(glm::vec3(next(), next(), next()));
+			vob->setRotationLocalToParent(glm::normalize(glm::quat(next(), next(), next(), next())));
+			vob->setScaleLocalToParent(glm::vec3(1.0f + std::abs(next()) * 0.1f));
+
+			if (depth > 0) {
+				for (int i = 0; i < CHILD_COUNT; ++i) vob->addChild(createTree(depth - 1, random));
+			}
+
+			return vob;
+		}
+
+		void removeVob(size_t index)
+		{
+			auto* vob = vobs[index];
+			vobs.erase(vobs.begin() + index);
+
+			// Note: the returned pointer is the last owner, so the vob (and its children) get destroyed
+			vob->getParent()->removeChild(vob);
+		}
+
+		void removeRoot(size_t rootIndex)
+		{
+			auto* root = rootPtrs[rootIndex];
+			std::vector<Vob*> subtree;
+			collect(root, subtree);
+			vobs.erase(std::remove_if(vobs.begin(), vobs.end(), [&](Vob* vob) {
+				return std::find(subtree.begin(), subtree.end(), vob) != subtree.end();
+			}), vobs.end());
+
+			rootPtrs.erase(rootPtrs.begin() + rootIndex);
+			roots.erase(roots.begin() + rootIndex);
+		}
+
+		static void collect(Vob* vob, std::vector<Vob*>& result)
+		{
+			result.push_back(vob);
+			for (auto& child : vob->getChildren()) collect(child.get(), result);
+		}
+	};
+
+	class TransformHierarchyTest : public ::testing::Test
+	{
+	protected:
+
+		Forest managed;
+		Forest reference;
+		TransformHierarchy hierarchy;
+
+		void SetUp() override
+		{
+			update();
+		}
+
+		/**
+		 * Applies a modification to both forests.
+		 */
+		void apply(const std::function<void(Forest&)>& func)
+		{
+			func(managed);
+			func(reference);
+		}
+
+		void update(bool resetPrevTrafos = false)
+		{
+			hierarchy.update(managed.rootPtrs, resetPrevTrafos);
+			for (auto* root : reference.rootPtrs) root->updateTrafo();
+		}
+
+		static void expectNear(const glm::mat4& a, const glm::mat4& b, size_t index, const char* what)
+		{
+			for (int column = 0; column < 4; ++column) {
+				for (int row = 0; row < 4; ++row) {
+					ASSERT_NEAR(a[column][row], b[column][row], EPSILON) << what << " of vob " << index;
+				}
+			}
+		}
+
+		static void expectNear(const glm::vec3& a, const glm::vec3& b, size_t index, const char* what)
+		{
+			for (int i = 0; i < 3; ++i) {
+				ASSERT_NEAR(a[i], b[i], EPSILON) << what << " of vob " << index;
+			}
+		}
+
+		void expectSameWorldData(bool comparePrevTrafos = true)
+		{
+			ASSERT_EQ(managed.vobs.size(), reference.vobs.size());
+
+			for (size_t i = 0; i < managed.vobs.size(); ++i) {
+				const auto* a = managed.vobs[i];
+				const auto* b = reference.vobs[i];
+				expectNear(a->getTrafoLocalToWorld(), b->getTrafoLocalToWorld(), i, "local to world");
+				expectNear(a->getTrafoMeshToWorld(), b->getTrafoMeshToWorld(), i, "mesh to world");
+				if (comparePrevTrafos) {
+					expectNear(a->getTrafoPrevMeshToWorld(), b->getTrafoPrevMeshToWorld(), i, "previous mesh to world");
+				}
+				expectNear(a->getBoundingBoxWorld().min, b->getBoundingBoxWorld().min, i, "bounding box min");
+				expectNear(a->getBoundingBoxWorld().max, b->getBoundingBoxWorld().max, i, "bounding box max");
+			}
+		}
+	};
+}
+
+TEST_F(TransformHierarchyTest, InitialUpdateMatchesRecursiveUpdate)
+{
+	EXPECT_TRUE(hierarchy.getStats().rebuilt);
+	EXPECT_EQ(hierarchy.getStats().nodeCount, managed.vobs.size());
+	EXPECT_EQ(hierarchy.getStats().levelCount, TREE_DEPTH + 1);
+	EXPECT_EQ(hierarchy.getStats().updatedCount, managed.vobs.size());
+	expectSameWorldData(false);
+}
+
+TEST_F(TransformHierarchyTest, UpdateWithoutChangesTouchesNothing)
+{
+	update();
+	EXPECT_FALSE(hierarchy.getStats().rebuilt);
+	EXPECT_EQ(hierarchy.getStats().updatedCount, 0);
+	EXPECT_TRUE(hierarchy.getBoundsChangedVobs().empty());
+	expectSameWorldData();
+}
+
+TEST_F(TransformHierarchyTest, PartialDirtySubtreeMatchesRecursiveUpdate)
+{
+	// the first child of the first root: an inner node with CHILD_COUNT leaves
+	const size_t inner = 1;
+	ASSERT_EQ(managed.vobs[inner]->getChildren().size(), CHILD_COUNT);
+
+	apply([&](Forest& forest) {
+		forest.vobs[inner]->setPositionLocalToParent(glm::vec3(3.0f, -2.0f, 7.0f));
+		forest.vobs[inner]->setRotationLocalToParent(glm::normalize(glm::quat(0.3f, 0.1f, 0.9f, 0.2f)));
+	});
+	update();
+
+	// only the moved node and its descendants are updated
+	EXPECT_EQ(hierarchy.getStats().updatedCount, 1 + CHILD_COUNT);
+	expectSameWorldData();
+
+	// a leaf only updates itself
+	const size_t leaf = managed.vobs.size() - 1;
+	ASSERT_TRUE(managed.vobs[leaf]->getChildren().empty());
+	apply([&](Forest& forest) {
+		forest.vobs[leaf]->setScaleLocalToParent(glm::vec3(2.0f));
+	});
+	update();
+
+	EXPECT_EQ(hierarchy.getStats().updatedCount, 1);
+	expectSameWorldData();
+}
+
+TEST_F(TransformHierarchyTest, SubtreeBoundsArePropagatedToTheRoot)
+{
+	const size_t leaf = 2; // a leaf of the first tree
+	ASSERT_TRUE(managed.vobs[leaf]->getChildren().empty());
+	auto* root = managed.rootPtrs[0];
+
+	apply([&](Forest& forest) {
+		forest.vobs[leaf]->setPositionLocalToParent(glm::vec3(1000.0f, 0.0f, 0.0f));
+	});
+	update();
+
+	expectSameWorldData();
+
+	// the bounding box of the root contains the moved leaf
+	const auto& rootBox = root->getBoundingBoxWorld();
+	const auto& leafBox = managed.vobs[leaf]->getBoundingBoxWorld();
+	EXPECT_LE(rootBox.min.x, leafBox.min.x);
+	EXPECT_GE(rootBox.max.x, leafBox.max.x);
+
+	// the leaf and all its ancestors have got new bounds; nothing else
+	const auto& changed = hierarchy.getBoundsChangedVobs();
+	std::vector<Vob*> expected;
+	for (auto* vob = managed.vobs[leaf]; vob; vob = vob->getParent()) expected.push_back(vob);
+	EXPECT_EQ(changed.size(), expected.size());
+	for (auto* vob : expected) {
+		EXPECT_NE(std::find(changed.begin(), changed.end(), vob), changed.end());
+	}
+}
+
+TEST_F(TransformHierarchyTest, ReparentingMatchesRecursiveUpdate)
+{
+	// move the first inner node of the first tree (with its children) below a leaf of the second tree
+	const size_t moved = 1;
+	const size_t newParent = managed.vobs.size() - 1;
+
+	apply([&](Forest& forest) {
+		auto* vob = forest.vobs[moved];
+		auto child = vob->getParent()->removeChild(vob);
+		forest.vobs[newParent]->addChild(std::move(child));
+	});
+	update();
+
+	EXPECT_TRUE(hierarchy.getStats().rebuilt);
+	EXPECT_EQ(hierarchy.getStats().levelCount, TREE_DEPTH + 3);
+	expectSameWorldData(false);
+
+	// the moved subtree still reacts to changes of its new ancestors
+	apply([&](Forest& forest) {
+		forest.rootPtrs.back()->setPositionLocalToParent(glm::vec3(-4.0f, 8.0f, 1.0f));
+	});
+	update();
+
+	EXPECT_FALSE(hierarchy.getStats().rebuilt);
+	expectSameWorldData();
+}
+
+TEST_F(TransformHierarchyTest, PrevTrafosFollowTheRecursiveUpdate)
+{
+	const size_t moved = 4;
+
+	apply([&](Forest& forest) {
+		forest.vobs[moved]->setPositionLocalToParent(glm::vec3(1.0f, 2.0f, 3.0f));
+	});
+	update();
+
+	// the previous trafo is the one before the movement
+	expectSameWorldData();
+	EXPECT_NE(managed.vobs[moved]->getTrafoPrevMeshToWorld(), managed.vobs[moved]->getTrafoMeshToWorld());
+
+	// one update after the vob has stopped, there is no movement anymore
+	update();
+	expectSameWorldData();
+	EXPECT_EQ(managed.vobs[moved]->getTrafoPrevMeshToWorld(), managed.vobs[moved]->getTrafoMeshToWorld());
+}
+
+TEST_F(TransformHierarchyTest, ResetPrevWorldTrafoSuppressesMotion)
+{
+	const size_t moved = 0; // a root, so that the whole tree moves
+
+	apply([&](Forest& forest) {
+		forest.vobs[moved]->setPositionLocalToParent(glm::vec3(20.0f, 0.0f, 0.0f));
+	});
+	update(true);
+
+	// Note: The recursive update doesn't reset the previous trafos to the new ones, so only the current ones are compared.
+	expectSameWorldData(false);
+
+	std::vector<Vob*> tree;
+	Forest::collect(managed.vobs[moved], tree);
+	ASSERT_EQ(hierarchy.getStats().updatedCount, tree.size());
+
+	for (auto* vob : tree) {
+		EXPECT_EQ(vob->getTrafoPrevMeshToWorld(), vob->getTrafoMeshToWorld());
+	}
+}
+
+TEST_F(TransformHierarchyTest, DeletedVobIsDetached)
+{
+	// the vob moves in one update and is deleted before the next one
+	const size_t deleted = 1;
+	auto* sibling = managed.vobs[deleted]->getParent()->getChildren().back().get();
+	const auto siblingIndex = std::find(managed.vobs.begin(), managed.vobs.end(), sibling) - managed.vobs.begin();
+
+	apply([&](Forest& forest) {
+		forest.vobs[deleted]->setPositionLocalToParent(glm::vec3(0.0f, 5.0f, 0.0f));
+	});
+	update();
+
+	apply([&](Forest& forest) {
+		forest.vobs[siblingIndex]->setPositionLocalToParent(glm::vec3(0.0f, -5.0f, 0.0f));
+		// removes the vob and its children
+		for (size_t i = 0; i < CHILD_COUNT; ++i) forest.vobs.erase(forest.vobs.begin() + deleted + 1);
+		forest.removeVob(deleted);
+	});
+	update();
+
+	EXPECT_TRUE(hierarchy.getStats().rebuilt);
+	EXPECT_EQ(hierarchy.getStats().nodeCount, managed.vobs.size());
+	expectSameWorldData(false);
+
+	update();
+	expectSameWorldData();
+}
+
+TEST_F(TransformHierarchyTest, DeletedRootIsDetached)
+{
+	apply([&](Forest& forest) {
+		forest.rootPtrs[0]->setPositionLocalToParent(glm::vec3(1.0f));
+	});
+	update();
+
+	apply([](Forest& forest) {
+		forest.removeRoot(0);
+	});
+	update();
+
+	EXPECT_EQ(hierarchy.getStats().nodeCount, managed.vobs.size());
+	expectSameWorldData(false);
+
+	update();
+	expectSameWorldData();
+}
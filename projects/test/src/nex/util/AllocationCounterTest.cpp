@@ -0,0 +1,97 @@
+#include <nex/util/AllocationCounter.hpp>
+#include <nex/util/FrameArena.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * Allocates from the heap in a way the compiler can't elide.
+	 */
+	void allocate(size_t count)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			auto ptr = std::make_unique<volatile int>(static_cast<int>(i));
+			*ptr = 0;
+		}
+	}
+}
+
+TEST(AllocationCounterTest, CountsHeapAllocationsIfEnabled)
+{
+	const auto totalBefore = AllocationCounter::getTotalCount();
+	const auto threadBefore = AllocationCounter::getThreadCount();
+
+	allocate(10);
+
+	if (AllocationCounter::isEnabled()) {
+		EXPECT_GE(AllocationCounter::getTotalCount() - totalBefore, 10);
+		EXPECT_GE(AllocationCounter::getThreadCount() - threadBefore, 10);
+	}
+	else {
+		// without EUCLID_ALLOCATION_COUNTING the global operator new isn't replaced
+		EXPECT_EQ(AllocationCounter::getTotalCount(), 0);
+		EXPECT_EQ(AllocationCounter::getThreadCount(), 0);
+	}
+}
+
+TEST(AllocationCounterTest, ThreadCountOnlyIncludesTheCallingThread)
+{
+	if (!AllocationCounter::isEnabled()) return;
+
+	const auto threadBefore = AllocationCounter::getThreadCount();
+	const auto totalBefore = AllocationCounter::getTotalCount();
+
+	std::thread worker([]() {
+		allocate(100);
+	});
+	worker.join();
+
+	EXPECT_GE(AllocationCounter::getTotalCount() - totalBefore, 100);
+	// std::thread itself might allocate its state on the calling thread
+	EXPECT_LT(AllocationCounter::getThreadCount() - threadBefore, 100);
+}
+
+TEST(AllocationCounterTest, MarkFrameReportsTheAllocationsOfTheLastFrame)
+{
+	AllocationCounter::markFrame();
+	allocate(5);
+	AllocationCounter::markFrame();
+
+	if (AllocationCounter::isEnabled()) {
+		EXPECT_GE(AllocationCounter::getLastFrameCount(), 5);
+		EXPECT_GE(AllocationCounter::getLastFrameThreadCount(), 5);
+	}
+	else {
+		EXPECT_EQ(AllocationCounter::getLastFrameCount(), 0);
+		EXPECT_EQ(AllocationCounter::getLastFrameThreadCount(), 0);
+	}
+
+	// a frame without allocations
+	AllocationCounter::markFrame();
+	AllocationCounter::markFrame();
+	EXPECT_EQ(AllocationCounter::getLastFrameThreadCount(), 0);
+}
+
+TEST(AllocationCounterTest, FrameArenaSteadyStateDoesNotAllocate)
+{
+	FrameArena arena(64);
+
+	auto frame = [&arena]() {
+		arena.beginFrame();
+		FrameVector<int> vec{ FrameAllocator<int>(&arena) };
+		for (int i = 0; i < 100; ++i) vec.push_back(i);
+	};
+
+	// the first frames grow both buffers
+	for (int i = 0; i < 4; ++i) frame();
+
+	const auto before = AllocationCounter::getThreadCount();
+	frame();
+	frame();
+	EXPECT_EQ(AllocationCounter::getThreadCount() - before, 0);
+	EXPECT_EQ(arena.getOverflowBytes(), 0);
+}
@@ -0,0 +1,134 @@
+#include <nex/util/FrameArena.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace nex;
+
+namespace
+{
+	bool isAligned(const void* ptr, size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+	}
+}
+
+TEST(FrameArenaTest, AllocationsAreAlignedAndDoNotOverlap)
+{
+	FrameArena arena(1024);
+
+	auto* a = static_cast<char*>(arena.allocate(3, 1));
+	auto* b = static_cast<char*>(arena.allocate(16, 16));
+	auto* c = static_cast<char*>(arena.allocate(8, 64));
+
+	EXPECT_TRUE(isAligned(b, 16));
+	EXPECT_TRUE(isAligned(c, 64));
+	EXPECT_LE(a + 3, b);
+	EXPECT_LE(b + 16, c);
+	EXPECT_GE(arena.getUsedBytes(), 3 + 16 + 8);
+	EXPECT_LE(arena.getUsedBytes(), arena.getCapacity());
+	EXPECT_EQ(arena.getOverflowBytes(), 0);
+}
+
+TEST(FrameArenaTest, MemoryStaysValidUntilTheFrameAfterNext)
+{
+	FrameArena arena(1024);
+
+	auto* first = static_cast<char*>(arena.allocate(16));
+	std::memset(first, 0xAB, 16);
+
+	// the next frame uses the other buffer
+	arena.beginFrame();
+	EXPECT_EQ(arena.getUsedBytes(), 0);
+	auto* second = static_cast<char*>(arena.allocate(16));
+	std::memset(second, 0xCD, 16);
+
+	EXPECT_NE(first, second);
+	EXPECT_TRUE(std::all_of(first, first + 16, [](char c) { return static_cast<unsigned char>(c) == 0xAB; }));
+
+	// the frame after next reuses the buffer of the first frame
+	arena.beginFrame();
+	EXPECT_EQ(arena.allocate(16), first);
+}
+
+TEST(FrameArenaTest, OverflowGrowsTheBufferOnReset)
+{
+	FrameArena arena(64);
+
+	arena.allocate(48);
+	auto* overflow = arena.allocate(100, 32);
+	EXPECT_TRUE(isAligned(overflow, 32));
+	EXPECT_GT(arena.getOverflowBytes(), 0);
+	EXPECT_EQ(arena.getUsedBytes(), 48);
+
+	// the same buffer is reset two frames later; then the allocations of the frame fit into it
+	arena.beginFrame();
+	arena.beginFrame();
+	EXPECT_GE(arena.getCapacity(), 148);
+	EXPECT_EQ(arena.getOverflowBytes(), 0);
+
+	arena.allocate(48);
+	arena.allocate(100, 32);
+	EXPECT_EQ(arena.getOverflowBytes(), 0);
+}
+
+TEST(FrameArenaTest, ConcurrentAllocationsAreDisjoint)
+{
+	constexpr size_t threadCount = 4;
+	constexpr size_t allocationsPerThread = 1000;
+	constexpr size_t allocationSize = 24;
+
+	// too small for all allocations, so that some of them overflow concurrently
+	FrameArena arena(threadCount * allocationsPerThread * allocationSize / 2);
+	std::vector<std::vector<char*>> results(threadCount);
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < allocationsPerThread; ++i) {
+				auto* ptr = static_cast<char*>(arena.allocate(allocationSize, 8));
+				std::memset(ptr, static_cast<int>(t), allocationSize);
+				results[t].push_back(ptr);
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+
+	std::vector<char*> all;
+	for (size_t t = 0; t < threadCount; ++t) {
+		for (auto* ptr : results[t]) {
+			// a thread would have overwritten memory of another one if allocations overlapped
+			EXPECT_TRUE(std::all_of(ptr, ptr + allocationSize, [t](char c) { return c == static_cast<char>(t); }));
+			all.push_back(ptr);
+		}
+	}
+
+	std::sort(all.begin(), all.end());
+	for (size_t i = 1; i < all.size(); ++i) {
+		ASSERT_LE(all[i - 1] + allocationSize, all[i]);
+	}
+}
+
+TEST(FrameArenaTest, FrameContainersAllocateFromTheArena)
+{
+	FrameArena arena(4096);
+
+	FrameVector<int> vec{ FrameAllocator<int>(&arena) };
+	vec.reserve(100);
+	EXPECT_GE(arena.getUsedBytes(), 100 * sizeof(int));
+
+	FrameQueue<int> queue{ FrameDeque<int>(FrameAllocator<int>(&arena)) };
+	for (int i = 0; i < 10; ++i) queue.push(i);
+	EXPECT_EQ(queue.front(), 0);
+	EXPECT_EQ(queue.size(), 10);
+
+	EXPECT_EQ(arena.getOverflowBytes(), 0);
+
+	FrameArena other(64);
+	EXPECT_TRUE(FrameAllocator<int>(&arena) == FrameAllocator<float>(&arena));
+	EXPECT_TRUE(FrameAllocator<int>(&arena) != FrameAllocator<int>(&other));
+}
@@ -0,0 +1,200 @@
+#include <nex/util/Profiler.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace nex;
+
+namespace
+{
+	/**
+	 * Provides the zones of the named thread within the last frame or nullptr, if the thread didn't record any zones.
+	 * Note: The profiler is a singleton; other tests might have registered threads as well.
+	 */
+	const Profiler::ThreadZones* findThread(const std::string& name)
+	{
+		const auto& threads = Profiler::get()->getLastFrame().threads;
+		auto it = std::find_if(threads.begin(), threads.end(), [&](const Profiler::ThreadZones& thread) {
+			return thread.threadName == name;
+		});
+		return it == threads.end() ? nullptr : &*it;
+	}
+
+	/**
+	 * Finishes the frame of previous tests, so that they don't leak zones into the next frame.
+	 */
+	void startFreshFrame()
+	{
+		Profiler::get()->setCapturing(false);
+		Profiler::get()->markFrame();
+	}
+}
+
+TEST(ProfilerTest, NestedZonesAreSortedByStartAndGetDepth)
+{
+	auto* profiler = Profiler::get();
+	profiler->setThreadName("ProfilerTest main");
+	startFreshFrame();
+
+	profiler->beginZone("outer");
+	profiler->beginZone("inner");
+	profiler->endZone();
+	profiler->endZone();
+	profiler->markFrame();
+
+	const auto* thread = findThread("ProfilerTest main");
+	ASSERT_NE(thread, nullptr);
+	ASSERT_EQ(thread->zones.size(), 2);
+	EXPECT_STREQ(thread->zones[0].name, "outer");
+	EXPECT_EQ(thread->zones[0].depth, 0);
+	EXPECT_STREQ(thread->zones[1].name, "inner");
+	EXPECT_EQ(thread->zones[1].depth, 1);
+	EXPECT_LE(thread->zones[0].start, thread->zones[1].start);
+	EXPECT_GE(thread->zones[0].end, thread->zones[1].end);
+	EXPECT_EQ(thread->droppedZones, 0);
+
+	// zones are only reported in the frame they have been finished in
+	profiler->markFrame();
+	thread = findThread("ProfilerTest main");
+	ASSERT_NE(thread, nullptr);
+	EXPECT_TRUE(thread->zones.empty());
+}
+
+TEST(ProfilerTest, EndZoneWithoutOpenZoneIsIgnored)
+{
+	auto* profiler = Profiler::get();
+	profiler->setThreadName("ProfilerTest main");
+	startFreshFrame();
+
+	profiler->endZone();
+	profiler->markFrame();
+
+	const auto* thread = findThread("ProfilerTest main");
+	ASSERT_NE(thread, nullptr);
+	EXPECT_TRUE(thread->zones.empty());
+}
+
+TEST(ProfilerTest, ZonesPerFrameAreBounded)
+{
+	auto* profiler = Profiler::get();
+	profiler->setThreadName("ProfilerTest main");
+	startFreshFrame();
+
+	const size_t dropped = 10;
+	for (size_t i = 0; i < Profiler::MAX_ZONES_PER_FRAME + dropped; ++i) {
+		profiler->beginZone("zone");
+		profiler->endZone();
+	}
+	profiler->markFrame();
+
+	const auto* thread = findThread("ProfilerTest main");
+	ASSERT_NE(thread, nullptr);
+	EXPECT_EQ(thread->zones.size(), Profiler::MAX_ZONES_PER_FRAME);
+	EXPECT_EQ(thread->droppedZones, dropped);
+
+	// the drop counter is reset per frame
+	profiler->markFrame();
+	thread = findThread("ProfilerTest main");
+	ASSERT_NE(thread, nullptr);
+	EXPECT_EQ(thread->droppedZones, 0);
+}
+
+TEST(ProfilerTest, BufferOfExitedThreadIsReleasedAfterCollection)
+{
+	auto* profiler = Profiler::get();
+	startFreshFrame();
+
+	std::thread worker([profiler]() {
+		profiler->setThreadName("ProfilerTest worker");
+		profiler->beginZone("work");
+		profiler->endZone();
+	});
+	worker.join();
+
+	// the zones of the exited thread are still reported
+	profiler->markFrame();
+	const auto* thread = findThread("ProfilerTest worker");
+	ASSERT_NE(thread, nullptr);
+	ASSERT_EQ(thread->zones.size(), 1);
+	EXPECT_STREQ(thread->zones[0].name, "work");
+
+	// afterwards its buffer is gone
+	profiler->markFrame();
+	EXPECT_EQ(findThread("ProfilerTest worker"), nullptr);
+}
+
+TEST(ProfilerTest, ThreadIDsAreNotReused)
+{
+	auto* profiler = Profiler::get();
+	startFreshFrame();
+
+	auto recordOnNewThread = [profiler](const std::string& name) {
+		std::thread worker([profiler, name]() {
+			profiler->setThreadName(name);
+			profiler->beginZone("work");
+			profiler->endZone();
+		});
+		worker.join();
+		profiler->markFrame();
+		const auto* thread = findThread(name);
+		return thread ? thread->threadID : ~0u;
+	};
+
+	const auto first = recordOnNewThread("ProfilerTest first");
+	const auto second = recordOnNewThread("ProfilerTest second");
+	EXPECT_NE(first, ~0u);
+	EXPECT_NE(second, ~0u);
+	EXPECT_NE(first, second);
+}
+
+TEST(ProfilerTest, CaptureKeepsNewestFrames)
+{
+	auto* profiler = Profiler::get();
+	startFreshFrame();
+
+	profiler->setCapturing(true, 3);
+	for (int i = 0; i < 5; ++i) profiler->markFrame();
+
+	EXPECT_TRUE(profiler->isCapturing());
+	EXPECT_EQ(profiler->getCapturedFrameCount(), 3);
+
+	// enabling the capture again discards the captured frames
+	profiler->setCapturing(false);
+	profiler->setCapturing(true, 3);
+	EXPECT_EQ(profiler->getCapturedFrameCount(), 0);
+
+	profiler->setCapturing(false);
+}
+
+TEST(ProfilerTest, ExportsChromeTrace)
+{
+	auto* profiler = Profiler::get();
+	profiler->setThreadName("ProfilerTest \"main\"");
+	startFreshFrame();
+
+	profiler->setCapturing(true);
+	profiler->beginZone("exported");
+	profiler->endZone();
+	profiler->markFrame();
+	profiler->setCapturing(false);
+
+	const auto path = std::filesystem::temp_directory_path() / "ProfilerTest_trace.json";
+	ASSERT_TRUE(profiler->exportChromeTrace(path));
+
+	std::ifstream in(path);
+	std::stringstream content;
+	content << in.rdbuf();
+	in.close();
+	std::filesystem::remove(path);
+
+	const auto json = content.str();
+	EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0);
+	EXPECT_NE(json.find("\"name\":\"exported\""), std::string::npos);
+	EXPECT_NE(json.find("ProfilerTest \\\"main\\\""), std::string::npos);
+
+	profiler->setThreadName("ProfilerTest main");
+}
@@ -0,0 +1,56 @@
+#include <nex/util/SortID.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace nex;
+
+namespace
+{
+	// Note: every test uses its own tag, so that ids of other tests don't interfere
+	struct DenseTag {};
+	struct ReuseTag {};
+	struct CopyTag {};
+}
+
+TEST(SortIDTest, IdsAreDenseAndNeverZero)
+{
+	std::vector<std::unique_ptr<SortID<DenseTag>>> ids;
+	for (int i = 0; i < 100; ++i) ids.emplace_back(std::make_unique<SortID<DenseTag>>());
+
+	std::vector<uint32_t> values;
+	for (const auto& id : ids) values.push_back(id->get());
+	std::sort(values.begin(), values.end());
+
+	for (uint32_t i = 0; i < values.size(); ++i) {
+		EXPECT_EQ(values[i], i + 1);
+	}
+}
+
+TEST(SortIDTest, IdsOfDestroyedObjectsAreReused)
+{
+	// objects created and destroyed every frame must not let the ids grow
+	uint32_t maxID = 0;
+	for (int frame = 0; frame < 1000; ++frame) {
+		std::vector<SortID<ReuseTag>> ids(10);
+		for (const auto& id : ids) maxID = std::max(maxID, id.get());
+	}
+
+	EXPECT_LE(maxID, 10u);
+}
+
+TEST(SortIDTest, CopiesGetOwnIdsAndAssignmentKeepsTheId)
+{
+	SortID<CopyTag> a;
+	SortID<CopyTag> b(a);
+	EXPECT_NE(a.get(), b.get());
+
+	const auto idOfB = b.get();
+	SortID<CopyTag> c(std::move(b));
+	EXPECT_NE(c.get(), a.get());
+	EXPECT_NE(c.get(), idOfB);
+
+	c = a;
+	EXPECT_NE(c.get(), a.get());
+}
@@ -0,0 +1,165 @@
+#include <nex/resource/PackageFile.hpp>
+#include <nex/resource/FileSystem.hpp>
+#include <nex/common/File.hpp>
+#include <nex/common/Log.hpp>
+#include <nex/util/ExceptionHandling.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Headless tool for creating and inspecting packages of compiled resources (see nex::PackageFile).
+ * Usage:
+ *  EuclidPacker <sourceDirectory> <package.pak> [--compress] [--compress-meshes]
+ *      Packs all files of the source directory (recursively); names are relative to the source directory.
+ *      --compress : compresses files (if they get smaller)
+ *      --compress-meshes : compresses .CVOB files, too. By default they are stored uncompressed, so that their mesh
+ *                          data can be used in place.
+ *  EuclidPacker --list <package.pak>
+ *  EuclidPacker --bench <sourceDirectory> <package.pak>
+ *      Compares looking up and reading all files of the package as loose files and from the mounted package.
+ */
+
+static bool isMesh(const std::filesystem::path& path)
+{
+	return path.extension() == ".CVOB";
+}
+
+static int pack(const std::filesystem::path& sourceDirectory, const std::filesystem::path& package, 
+	bool compress, bool compressMeshes)
+{
+	std::vector<nex::PackageFile::Source> sources;
+
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(sourceDirectory)) {
+		if (!entry.is_regular_file()) continue;
+		if (std::filesystem::equivalent(entry.path(), package)) continue;
+
+		nex::PackageFile::Source source;
+		source.name = entry.path().lexically_relative(sourceDirectory);
+		source.file = entry.path();
+		source.compress = compress && (compressMeshes || !isMesh(entry.path()));
+		sources.emplace_back(std::move(source));
+	}
+
+	const auto stats = nex::PackageFile::write(package, sources);
+
+	std::cout << "files: " << stats.entries << "\n"
+		<< "compressed files: " << stats.compressedEntries << "\n"
+		<< "source size (bytes): " << stats.sourceBytes << "\n"
+		<< "package size (bytes): " << stats.packageBytes << std::endl;
+
+	return EXIT_SUCCESS;
+}
+
+static int list(const std::filesystem::path& package)
+{
+	nex::PackageFile file(package);
+
+	for (size_t i = 0; i < file.getEntryCount(); ++i) {
+		const auto& entry = file.getEntries()[i];
+		std::cout << file.getName(entry) << " " << entry.size << " " << entry.uncompressedSize
+			<< ((entry.flags & nex::PackageFile::FLAG_COMPRESSED) ? " compressed" : "") << "\n";
+	}
+
+	std::cout << file.getEntryCount() << " files" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+static size_t readAll(const std::filesystem::path& root, const std::vector<std::string>& names)
+{
+	size_t bytes = 0;
+	std::vector<char> content;
+
+	for (const auto& name : names) {
+		const auto path = root / name;
+		if (!nex::FileSystem::fileExists(path)) {
+			nex::throw_with_trace(std::runtime_error("File doesn't exist: " + path.generic_string()));
+		}
+
+		nex::BinStream file;
+		nex::FileSystem::openForReading(file, path);
+		file.seekg(0, std::ios::end);
+		content.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0, std::ios::beg);
+		file.read(content.data(), content.size());
+		bytes += content.size();
+	}
+
+	return bytes;
+}
+
+static int bench(const std::filesystem::path& sourceDirectory, const std::filesystem::path& package)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	std::vector<std::string> names;
+
+	{
+		nex::PackageFile file(package);
+		for (size_t i = 0; i < file.getEntryCount(); ++i) {
+			names.emplace_back(file.getName(file.getEntries()[i]));
+		}
+	}
+
+	const auto measure = [&]() {
+		const auto start = Clock::now();
+		const auto bytes = readAll(sourceDirectory, names);
+		const auto millis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		return std::make_pair(millis, bytes);
+	};
+
+	// The first pass warms up the page cache, so that both variants read cached data
+	measure();
+	const auto loose = measure();
+
+	const auto mountStart = Clock::now();
+	nex::FileSystem::mountPackage(package, sourceDirectory);
+	const auto mountMillis = std::chrono::duration<double, std::milli>(Clock::now() - mountStart).count();
+	const auto packaged = measure();
+	nex::FileSystem::unmountPackages();
+
+	std::cout << "files: " << names.size() << "\n"
+		<< "loose files (ms): " << loose.first << " (" << loose.second << " bytes)\n"
+		<< "mount package (ms): " << mountMillis << "\n"
+		<< "package (ms): " << packaged.first << " (" << packaged.second << " bytes)" << std::endl;
+
+	return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+	nex::LogSink::get()->registerStream(&std::cout);
+	nex::LoggerManager::get()->setMinLogLevel(nex::Warning);
+
+	nex::Logger logger("EuclidPacker");
+	const std::vector<std::string> args(argv + 1, argv + argc);
+
+	try {
+		if (args.size() == 2 && args[0] == "--list") return list(args[1]);
+		if (args.size() == 3 && args[0] == "--bench") return bench(args[1], args[2]);
+
+		if (args.size() >= 2 && args[0].rfind("--", 0) != 0) {
+			bool compress = false;
+			bool compressMeshes = false;
+
+			for (size_t i = 2; i < args.size(); ++i) {
+				if (args[i] == "--compress") compress = true;
+				else if (args[i] == "--compress-meshes") compress = compressMeshes = true;
+				else nex::throw_with_trace(std::invalid_argument("Unknown option: " + args[i]));
+			}
+
+			return pack(args[0], args[1], compress, compressMeshes);
+		}
+
+		std::cout << "Usage:\n"
+			<< "  EuclidPacker <sourceDirectory> <package.pak> [--compress] [--compress-meshes]\n"
+			<< "  EuclidPacker --list <package.pak>\n"
+			<< "  EuclidPacker --bench <sourceDirectory> <package.pak>" << std::endl;
+
+	} catch (const std::exception& e)
+	{
+		nex::ExceptionHandling::logExceptionWithStackTrace(logger, e);
+	}
+
+	return EXIT_FAILURE;
+}